@@ -39,8 +39,11 @@
 
 
 #include <GigaMesh/printbuildinfo.h>
+#include <GigaMesh/getlocaltime.h>
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/mesh/batchprocessing.h>
 //#include "meshseed.h"
 
 // //#include "voxelcuboid.h"
@@ -123,11 +126,7 @@ bool convertMeshData(
 	cout << "[GigaMesh] Volume (dy):     " << volDXYZ[1]/1000.0 << " cm^3" << endl;
 	cout << "[GigaMesh] Volume (dz):     " << volDXYZ[2]/1000.0 << " cm^3" << endl;
 
-	time_t     rawtime;
-	struct tm* timeinfo;
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	cout << "[GigaMesh] Start date/time is: " << asctime( timeinfo );// << endl;
+	cout << "[GigaMesh] Start date/time is: " << getLocalTimeStr( time( nullptr ) );// << endl;
 	bool convertSuccess = someMesh.convertBordersToPolylines();
 	if( !convertSuccess ) {
 		cerr << "[GigaMesh] Error: Could not convert borders of mesh '" << rFileName << "'!" << endl;
@@ -140,7 +139,7 @@ bool convertMeshData(
 		return( false );
 	}
 
-	cout << "[GigaMesh] End date/time is: " << asctime( timeinfo );// << endl;
+	cout << "[GigaMesh] End date/time is: " << getLocalTimeStr( time( nullptr ) );// << endl;
 
 	return( true );
 }
@@ -161,10 +160,24 @@ void printHelp( const char* rExecName ) {
 	std::cout << "                                          not done by default to prevent" << std::endl;
 	std::cout << "                                          accidental data loss." << std::endl;
 	std::cout << std::endl;
+	std::cout << "Options for batch processing:" << std::endl;
+	std::cout << "    , --jobs <int>                        Number of files processed concurrently. Zero uses all cores. Default: 1" << std::endl;
+	std::cout << "                                          Reading a file overlaps with processing other files." << std::endl;
+	std::cout << "    , --memory-budget <MB>                Memory for the files processed concurrently, which is estimated" << std::endl;
+	std::cout << "                                          from the file sizes. Default: 75% of the physical memory." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for caching:" << std::endl;
+	std::cout << "    , --mesh-cache                        Use a native binary cache next to each mesh (<file>.gmcache), which" << std::endl;
+	std::cout << "                                          is written, when missing or outdated. Reopening a mesh is done" << std::endl;
+	std::cout << "                                          without parsing and without rebuilding its connectivity." << std::endl;
+	std::cout << std::endl;
 	std::cout << "Options for testing and debugging:" << std::endl;
 	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
 	             "                                          Higher numbers increases verbosity.\n"
 	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
 	//std::cout << "" << endl;
 }
 
@@ -179,6 +192,9 @@ int main( int argc, char *argv[] ) {
 	bool optWriteVertexId  = false;
 	bool optWriteNormals = false;
 
+	// Parameters for processing multiple files
+	BatchProcessing::sParams batchParams;
+
 	// PARSE command line options
 	//--------------------------------------------------------------------------
 	// https://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html#Getopt-Long-Option-Example
@@ -188,7 +204,11 @@ int main( int argc, char *argv[] ) {
 		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
 		{ "version",                      no_argument,       nullptr, 'v' },
 		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "jobs",                         required_argument, nullptr,  0  },
+		{ "memory-budget",                required_argument, nullptr,  0  },
 		{ "log-level",                    required_argument, nullptr,  0  },
+		{ "mesh-cache",                   no_argument,       nullptr,  0  },
+		{ "profile-trace",                required_argument, nullptr,  0  },
 		{ nullptr, 0, nullptr, 0 }
 	};
 
@@ -202,6 +222,22 @@ int main( int argc, char *argv[] ) {
 				// printf ("option %s", long_options[option_index].name);
 				// if (optarg) printf (" with arg %s", optarg);
 
+				if(std::string(longOptions[optionIndex].name) == "jobs")
+				{
+					batchParams.mJobs = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				}
+				if(std::string(longOptions[optionIndex].name) == "memory-budget")
+				{
+					batchParams.mMemoryBudget = static_cast<uint64_t>( std::max( std::atof( optarg ), 0.0 ) * 1024.0 * 1024.0 );
+				}
+				if(std::string(longOptions[optionIndex].name) == "mesh-cache")
+				{
+					MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+				}
+				if(std::string(longOptions[optionIndex].name) == "profile-trace")
+				{
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
 				if(std::string(longOptions[optionIndex].name) == "log-level")
 				{
 					unsigned int arg = optarg[0] - '0';
@@ -260,25 +296,36 @@ int main( int argc, char *argv[] ) {
 	// SHOW Build information
 	printBuildInfo();
 
-	// Process given files
-	unsigned long filesProcessed = 0;
+	// Collect given files
+	std::vector<std::filesystem::path> fileNames;
 	for( int nonOptionArgumentCount = optind;
 	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
 
-		std::filesystem::path filePath( argv[nonOptionArgumentCount] );
+		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
+
+		if( !nonOptionArgumentString.empty() ) {
+			fileNames.push_back( nonOptionArgumentString );
+		}
+	}
 
-		if( filePath.empty() ) {
-			std::cout << "[GigaMesh] Processing file " << filePath << "..." << std::endl;
+	// Process given files - concurrently, when requested by --jobs.
+	BatchProcessing::sStats batchStats;
+	const bool batchSuccess = BatchProcessing::run( fileNames, batchParams,
+	                                                [&]( uint64_t /*rFileIdx*/, const std::filesystem::path& rFileName ) {
+		std::cout << "[GigaMesh] Processing file " << rFileName << "..." << std::endl;
 
-			if( !convertMeshData( filePath, optWriteVertexId,
-					      optWriteNormals, optReplaceFiles ) ) {
-				std::cerr << "[GigaMesh] ERROR: convertMeshData failed!" << std::endl;
-				std::exit( EXIT_FAILURE );
-			}
-			filesProcessed++;
+		if( !convertMeshData( rFileName, optWriteVertexId,
+		                      optWriteNormals, optReplaceFiles ) ) {
+			std::cerr << "[GigaMesh] ERROR: convertMeshData failed!" << std::endl;
+			return( false );
 		}
+		return( true );
+	}, batchStats );
+	batchStats.print( std::cout );
+	if( !batchSuccess ) {
+		std::exit( EXIT_FAILURE );
 	}
 
-	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	std::cout << "[GigaMesh] Processed files: " << batchStats.mFilesProcessed << std::endl;
 	exit( EXIT_SUCCESS );
 }
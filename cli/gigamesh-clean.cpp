@@ -46,6 +46,8 @@
 
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/mesh/batchprocessing.h>
 
 bool cleanupGigaMeshData(
                 const  std::filesystem::path& fileNameIn,
@@ -253,10 +255,24 @@ void printHelp( const char* rExecName ) {
 	std::cout << "                                          Will be ignored if -i is not used." << std::endl;
 	std::cout << "  -o, --set-material-id-forced            Enforce id and material, even when NOT empty." << std::endl;
 	std::cout << std::endl;
+	std::cout << "Options for batch processing:" << std::endl;
+	std::cout << "    , --jobs <int>                        Number of files processed concurrently. Zero uses all cores. Default: 1" << std::endl;
+	std::cout << "                                          Reading a file overlaps with processing other files." << std::endl;
+	std::cout << "    , --memory-budget <MB>                Memory for the files processed concurrently, which is estimated" << std::endl;
+	std::cout << "                                          from the file sizes. Default: 75% of the physical memory." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for caching:" << std::endl;
+	std::cout << "    , --mesh-cache                        Use a native binary cache next to each mesh (<file>.gmcache), which" << std::endl;
+	std::cout << "                                          is written, when missing or outdated. Reopening a mesh is done" << std::endl;
+	std::cout << "                                          without parsing and without rebuilding its connectivity." << std::endl;
+	std::cout << std::endl;
 	std::cout << "Options for testing and debugging:" << std::endl;
 	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
 	             "                                          Higher numbers increases verbosity.\n"
 	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
 	//std::cout << "" << std::endl;
 }
 
@@ -285,6 +301,9 @@ int main( int argc, char* argv[] ) {
 	bool removeOnlyFlag = false;
 	bool keepLargestComponent = false;
 	bool skipLargestHole = false;
+
+	// Parameters for processing multiple files
+	BatchProcessing::sParams batchParams;
 	bool applyBorderErosion = true;
 	bool materialWhenEmptySet = false;
 	bool fileNameAsIdWhenEmpty = false;
@@ -307,7 +326,11 @@ int main( int argc, char* argv[] ) {
 		{ "set-material-id-forced",       no_argument,       nullptr, 'o' },
 		{ "version",                      no_argument,       nullptr, 'v' },
 		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "jobs",                         required_argument, nullptr,  0  },
+		{ "memory-budget",                required_argument, nullptr,  0  },
 		{ "log-level",                    required_argument, nullptr,  0  },
+		{ "mesh-cache",                   no_argument,       nullptr,  0  },
+		{ "profile-trace",                required_argument, nullptr,  0  },
 		{ nullptr, 0, nullptr, 0 }
 	};
 
@@ -319,6 +342,22 @@ int main( int argc, char* argv[] ) {
 		switch(character) {
 			case 0:
 
+				if(std::string(longOptions[optionIndex].name) == "jobs")
+				{
+					batchParams.mJobs = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				}
+				if(std::string(longOptions[optionIndex].name) == "memory-budget")
+				{
+					batchParams.mMemoryBudget = static_cast<uint64_t>( std::max( std::atof( optarg ), 0.0 ) * 1024.0 * 1024.0 );
+				}
+				if(std::string(longOptions[optionIndex].name) == "mesh-cache")
+				{
+					MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+				}
+				if(std::string(longOptions[optionIndex].name) == "profile-trace")
+				{
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
 				if(std::string(longOptions[optionIndex].name) == "log-level")
 				{
 					unsigned int arg = optarg[0] - '0';
@@ -417,29 +456,40 @@ int main( int argc, char* argv[] ) {
 	std::cout << "[GigaMesh] Surfaces with an area less than " << ( percentArea*100.0 ) << "% of the total surface will be removed." << std::endl;
 	std::cout << "[GigaMesh] ----------------------------------------------------------------------------------" << std::endl;
 
-	// Process given files
-	unsigned long filesProcessed = 0;
+	// Collect given files
+	std::vector<std::filesystem::path> fileNames;
 	for( int nonOptionArgumentCount = optind;
 	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
 
-		std::string nonOptionArgumentString = std::string( argv[nonOptionArgumentCount] );
+		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
 
 		if( !nonOptionArgumentString.empty() ) {
-			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
-
-			if( !cleanupGigaMeshData( nonOptionArgumentString, fileNameOutSuffix,
-			                          materialWhenEmpty, materialWhenEmptySet, fileNameAsIdWhenEmpty,
-			                          removeTrailingChars, enforceIdMaterial, percentArea, applyBorderErosion,
-			                          replaceFiles, removeOnlyFlag,
-			                          keepLargestComponent, skipLargestHole,
-			                          skipHolesLargerThan ) ) {
-				std::cerr << "[GigaMesh] ERROR: cleanupGigaMeshData failed!" << std::endl;
-				std::exit( EXIT_FAILURE );
-			}
-			filesProcessed++;
+			fileNames.push_back( nonOptionArgumentString );
 		}
 	}
 
-	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	// Process given files - concurrently, when requested by --jobs.
+	BatchProcessing::sStats batchStats;
+	const bool batchSuccess = BatchProcessing::run( fileNames, batchParams,
+	                                                [&]( uint64_t /*rFileIdx*/, const std::filesystem::path& rFileName ) {
+		std::cout << "[GigaMesh] Processing file " << rFileName << "..." << std::endl;
+
+		if( !cleanupGigaMeshData( rFileName.string(), fileNameOutSuffix,
+		                          materialWhenEmpty, materialWhenEmptySet, fileNameAsIdWhenEmpty,
+		                          removeTrailingChars, enforceIdMaterial, percentArea, applyBorderErosion,
+		                          replaceFiles, removeOnlyFlag,
+		                          keepLargestComponent, skipLargestHole,
+		                          skipHolesLargerThan ) ) {
+			std::cerr << "[GigaMesh] ERROR: cleanupGigaMeshData failed!" << std::endl;
+			return( false );
+		}
+		return( true );
+	}, batchStats );
+	batchStats.print( std::cout );
+	if( !batchSuccess ) {
+		std::exit( EXIT_FAILURE );
+	}
+
+	std::cout << "[GigaMesh] Processed files: " << batchStats.mFilesProcessed << std::endl;
 	std::exit( EXIT_SUCCESS );
 }
@@ -44,6 +44,7 @@
 #include <GigaMesh/printbuildinfo.h>
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
 //#include "meshseed.h"
 
 // //#include "voxelcuboid.h"
@@ -329,6 +330,11 @@ void printHelp( const char* rExecName ) {
         std::cout << "  -z, --z-rotation-angle <int>            Rotate the mesh about the z-axis with this angle in degree" << std::endl;
         std::cout << "                                          Default angle is 0." << std::endl;
         std::cout << "                                          if any rotation is used, then the file gets 'ANGLES:X<angle>Y<angle>Z<angle>' as suffix." << std::endl;
+        std::cout << std::endl;
+        std::cout << "Options for testing and debugging:" << std::endl;
+        std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+                     "                                          writes it as Chrome trace (JSON) to the given file.\n"
+                     "                                          A summary is shown on exit." << std::endl;
 }
 
 //! Main routine for loading a (binary) PLY and compute gaussian normal sphere supplied by GigaMesh
@@ -380,6 +386,7 @@ int main( int argc, char *argv[] ) {
                 { "clean-mesh",           no_argument,       nullptr, 'c' },
                 { "version",                      no_argument,       nullptr, 'v' },
                 { "help",                         no_argument,       nullptr, 'h' },
+                { "profile-trace",                required_argument, nullptr,  0  },
                 { nullptr, 0, nullptr, 0 }
         };
 
@@ -390,6 +397,13 @@ int main( int argc, char *argv[] ) {
 
                 switch(character) {
 
+                        case 0:
+                                if(std::string(longOptions[optionIndex].name) == "profile-trace")
+                                {
+                                        PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+                                }
+                                break;
+
                         case 'o': // output path
                                 optOutputPath = std::string( optarg );
                                 break;
@@ -20,6 +20,7 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <cstdio>
@@ -42,6 +43,8 @@
 
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/mesh/batchprocessing.h>
 
 bool infoGigaMeshData(
                 const std::filesystem::path&   rFileNameIn,    //!< Input - filename.
@@ -100,10 +103,24 @@ void printHelp( const char* rExecName ) {
 	std::cout << "                                          If not given only the stem of the filename is printed." << std::endl;
 	std::cout << "                                          Affects all types of output i.e. side car files and tabular." << std::endl;
 	std::cout << std::endl;
+	std::cout << "Options for batch processing:" << std::endl;
+	std::cout << "    , --jobs <int>                        Number of files processed concurrently. Zero uses all cores. Default: 1" << std::endl;
+	std::cout << "                                          Reading a file overlaps with processing other files." << std::endl;
+	std::cout << "    , --memory-budget <MB>                Memory for the files processed concurrently, which is estimated" << std::endl;
+	std::cout << "                                          from the file sizes. Default: 75% of the physical memory." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for caching:" << std::endl;
+	std::cout << "    , --mesh-cache                        Use a native binary cache next to each mesh (<file>.gmcache), which" << std::endl;
+	std::cout << "                                          is written, when missing or outdated. Reopening a mesh is done" << std::endl;
+	std::cout << "                                          without parsing and without rebuilding its connectivity." << std::endl;
+	std::cout << std::endl;
 	std::cout << "Options for testing and debugging:" << std::endl;
 	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
 	             "                                          Higher numbers increases verbosity.\n"
 	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
 	//std::cout << "" << std::endl;
 }
 
@@ -127,6 +144,9 @@ int main( int argc, char* argv[] ) {
 	bool optSideCarTTL   = false;
     bool optSuppressSelfIntersection = false;
 
+	// Parameters for processing multiple files
+	BatchProcessing::sParams batchParams;
+
 	// PARSE command line options
 	//--------------------------------------------------------------------------
 	// https://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html#Getopt-Long-Option-Example
@@ -142,7 +162,11 @@ int main( int argc, char* argv[] ) {
         { "quick",                        no_argument,       nullptr, 'q' },
 		{ "version",                      no_argument,       nullptr, 'v' },
 		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "jobs",                         required_argument, nullptr,  0  },
+		{ "memory-budget",                required_argument, nullptr,  0  },
 		{ "log-level",                    required_argument, nullptr,  0  },
+		{ "mesh-cache",                   no_argument,       nullptr,  0  },
+		{ "profile-trace",                required_argument, nullptr,  0  },
 		{ nullptr, 0, nullptr, 0 }
 	};
 
@@ -157,6 +181,22 @@ int main( int argc, char* argv[] ) {
 				// printf ("option %s", long_options[option_index].name);
                 //if (optarg) printf (" with arg %s", optarg);
 
+				if(std::string(longOptions[optionIndex].name) == "jobs")
+				{
+					batchParams.mJobs = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				}
+				if(std::string(longOptions[optionIndex].name) == "memory-budget")
+				{
+					batchParams.mMemoryBudget = static_cast<uint64_t>( std::max( std::atof( optarg ), 0.0 ) * 1024.0 * 1024.0 );
+				}
+				if(std::string(longOptions[optionIndex].name) == "mesh-cache")
+				{
+					MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+				}
+				if(std::string(longOptions[optionIndex].name) == "profile-trace")
+				{
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
 				if(std::string(longOptions[optionIndex].name) == "log-level")
 				{
 					unsigned int arg = optarg[0] - '0';
@@ -240,62 +280,73 @@ int main( int argc, char* argv[] ) {
 	// Show build info
 	printBuildInfo();
 
-	// Process given files
-	std::vector<MeshInfoData> fileInfosAll;
-	unsigned long filesProcessed = 0;
-	unsigned long filesMeshInfo = 0;
+	// Collect given files
+	std::vector<std::filesystem::path> fileNames;
 	for( int nonOptionArgumentCount = optind;
 	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
 
 		std::string nonOptionArgumentString = std::string( argv[nonOptionArgumentCount] );
 
 		if( !nonOptionArgumentString.empty() ) {
-			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
-
-			MeshInfoData fileInfoSingle;
-			if( !infoGigaMeshData( nonOptionArgumentString,
-                                   fileInfoSingle,
-                                   optSuppressSelfIntersection,
-                                   optAbsolutePath
-                                   ) ) {
-				std::cerr << "[GigaMesh] ERROR: infoGigaMeshData failed!" << std::endl;
-				std::exit( EXIT_FAILURE );
-			}
-			if( optSideCarHTML ) {
-				//! \todo integrate optReplaceFiles (bool)
-				// Determine filename for HTML sidecar file
-				std::filesystem::path htmlFileName = std::filesystem::path( nonOptionArgumentString ).replace_extension( ".html" );
-				if( fileInfoSingle.writeMeshInfo( htmlFileName ) ) {
-					filesMeshInfo++;
-				}
+			fileNames.push_back( nonOptionArgumentString );
+		}
+	}
+
+	// Process given files - concurrently, when requested by --jobs.
+	// The results are stored by index to keep the order of the given files.
+	std::vector<MeshInfoData> fileInfosAll( fileNames.size() );
+	std::atomic<unsigned long> filesMeshInfo( 0 );
+	BatchProcessing::sStats batchStats;
+	const bool batchSuccess = BatchProcessing::run( fileNames, batchParams,
+	                                                [&]( uint64_t rFileIdx, const std::filesystem::path& rFileName ) {
+		std::cout << "[GigaMesh] Processing file " << rFileName.string() << "..." << std::endl;
+
+		MeshInfoData& fileInfoSingle = fileInfosAll[rFileIdx];
+		if( !infoGigaMeshData( rFileName,
+		                       fileInfoSingle,
+		                       optSuppressSelfIntersection,
+		                       optAbsolutePath
+		                       ) ) {
+			std::cerr << "[GigaMesh] ERROR: infoGigaMeshData failed!" << std::endl;
+			return( false );
+		}
+		if( optSideCarHTML ) {
+			//! \todo integrate optReplaceFiles (bool)
+			// Determine filename for HTML sidecar file
+			std::filesystem::path htmlFileName = std::filesystem::path( rFileName ).replace_extension( ".html" );
+			if( fileInfoSingle.writeMeshInfo( htmlFileName ) ) {
+				filesMeshInfo++;
 			}
-			if( optSideCarXML ) {
-				//! \todo integrate optReplaceFiles (bool)
-				// Determine filename for XML sidecar file
-				std::filesystem::path xmlFileName = std::filesystem::path( nonOptionArgumentString ).replace_extension( ".xml" );
-				if( fileInfoSingle.writeMeshInfo( xmlFileName ) ) {
-					filesMeshInfo++;
-				}
+		}
+		if( optSideCarXML ) {
+			//! \todo integrate optReplaceFiles (bool)
+			// Determine filename for XML sidecar file
+			std::filesystem::path xmlFileName = std::filesystem::path( rFileName ).replace_extension( ".xml" );
+			if( fileInfoSingle.writeMeshInfo( xmlFileName ) ) {
+				filesMeshInfo++;
 			}
-			if( optSideCarJSON ) {
-				//! \todo integrate optReplaceFiles (bool)
-				// Determine filename for JSON sidecar file
-				std::filesystem::path jsonFileName = std::filesystem::path( nonOptionArgumentString ).replace_extension( ".json" );
-				if( fileInfoSingle.writeMeshInfo( jsonFileName ) ) {
-					filesMeshInfo++;
-				}
+		}
+		if( optSideCarJSON ) {
+			//! \todo integrate optReplaceFiles (bool)
+			// Determine filename for JSON sidecar file
+			std::filesystem::path jsonFileName = std::filesystem::path( rFileName ).replace_extension( ".json" );
+			if( fileInfoSingle.writeMeshInfo( jsonFileName ) ) {
+				filesMeshInfo++;
 			}
-			if( optSideCarTTL ) {
-				//! \todo integrate optReplaceFiles (bool)
-				// Determine filename for TTL sidecar file
-				std::filesystem::path ttlFileName = std::filesystem::path( nonOptionArgumentString ).replace_extension( ".ttl" );
-				if( fileInfoSingle.writeMeshInfo( ttlFileName ) ) {
-					filesMeshInfo++;
-				}
+		}
+		if( optSideCarTTL ) {
+			//! \todo integrate optReplaceFiles (bool)
+			// Determine filename for TTL sidecar file
+			std::filesystem::path ttlFileName = std::filesystem::path( rFileName ).replace_extension( ".ttl" );
+			if( fileInfoSingle.writeMeshInfo( ttlFileName ) ) {
+				filesMeshInfo++;
 			}
-			fileInfosAll.push_back( fileInfoSingle );
-			filesProcessed++;
 		}
+		return( true );
+	}, batchStats );
+	batchStats.print( std::cout );
+	if( !batchSuccess ) {
+		std::exit( EXIT_FAILURE );
 	}
 
 	// Prepare header
@@ -353,6 +404,6 @@ int main( int argc, char* argv[] ) {
 	}
 
 	std::cout << "[GigaMesh] Meshinfo sidecar files written: " << filesMeshInfo << std::endl;
-	std::cout << "[GigaMesh] Processed files:                " << filesProcessed << std::endl;
+	std::cout << "[GigaMesh] Processed files:                " << batchStats.mFilesProcessed << std::endl;
 	std::exit( EXIT_SUCCESS );
 }
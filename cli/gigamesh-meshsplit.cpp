@@ -44,6 +44,7 @@
 #include <GigaMesh/printbuildinfo.h>
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
 //#include "meshseed.h"
 
 // //#include "voxelcuboid.h"
@@ -114,65 +115,42 @@ bool splitMeshInComponents(
             std::cout << "[Mesh::" << __FUNCTION__ << "] labels import was succesful " << std::endl;
         }
 
-        //get label numbers
+        //write the components in one pass over the faces
         //--------------------------------------------------------------------------
         //TODO/idea: use only the labels with a minimum component size
         //someMesh.selectVertLabelAreaLT( 5000.0 );
 
-        std::set<uint64_t> labelNrs;
-        //ATTENTION METHOD: getMSelectedMVerts returns all mVerts
-        std::cout.setstate(std::ios_base::failbit); //needed for cout clear
-        if( !someMesh.getVertLabelIdFrom( someMesh.getVertices(), labelNrs ) ) {
-            std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVertLabelIdFrom failed!" << std::endl;
-            return( false );
-        }
-        std::cout.clear(); //clear the cout spam of Methdo getVertLabelIdFrom
-        std::cout << "[Mesh::" << __FUNCTION__ << "] Amount of labels: " << labelNrs.size() << std::endl;
+        std::vector<Mesh::sLabeledComponent> components;
+        someMesh.writeLabeledComponents( components, rExportInfo );
+        std::cout << "[Mesh::" << __FUNCTION__ << "] Amount of labels: " << components.size() << std::endl;
 
         // Inform the user if there are no connected components defined
-        if( labelNrs.size() == 0 ) {
+        if( components.size() == 0 ) {
             std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No connected components (labels) defined!";
             return( false );
         }
         uint fileError = 0;
         uint fileOkay = 0;
         uint infoFileError = 0;
-        for( auto const& labelNr: labelNrs ) {
-            std::set<Face*> facesWithLabel;
-            bool retVal = someMesh.getFaceHasVertLabelNo( labelNr, facesWithLabel );
-            if( retVal ) {
-                filesystem::path fileName = someMesh.getFullName();
-
-                // The following looks wired due to Windows build
-                std::string oriExtension = fileName.extension().string();
-                std::string suffixExtension = "comp.";
-                suffixExtension += std::to_string( labelNr );
-                suffixExtension += oriExtension;
-
-                fileName.replace_extension( filesystem::path( suffixExtension ) );
-                Mesh meshToWrite( &facesWithLabel );
-                meshToWrite.getModelMetaDataRef().setModelMeta( someMesh.getModelMetaDataRef() );
-                if( meshToWrite.writeFile( fileName ) ) {
-                    std::cout << "[Mesh::" << __FUNCTION__ << "] Connected component written to file: " << fileName.string() << std::endl;
-                    fileOkay++;
-                } else {
-                    std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Connected component NOT written to file " << fileName.string() << "!" << std::endl;
-                    fileError++;
-                }
+        for( Mesh::sLabeledComponent& component: components ) {
+            if( component.mWritten ) {
+                std::cout << "[Mesh::" << __FUNCTION__ << "] Connected component written to file: " << component.mFileName.string() << std::endl;
+                fileOkay++;
+            } else {
+                std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Connected component NOT written to file " << component.mFileName.string() << "!" << std::endl;
+                fileError++;
+            }
 
-                //write the information e.g. volume of the mesh component to json file
-                if( rExportInfo ){
-                    MeshInfoData meshInfoData;
-                    if( !meshToWrite.getMeshInfoData( meshInfoData, true ) ) {
-                        std::wcerr << "[GigaMesh] ERROR: Could not fetch mesh information about '" << fileName.wstring() << "'!" << std::endl;
-                        infoFileError++;
-                    }
-                    std::filesystem::path infoFileOutJSON = someMesh.getFullName();
-                    std::string suffixExtensionInfo = "comp.";
-                    suffixExtensionInfo += std::to_string( labelNr );
-                    suffixExtensionInfo += "_info.json";
-                    infoFileOutJSON.replace_extension( filesystem::path( suffixExtensionInfo ) );
-                    meshInfoData.writeMeshInfo(infoFileOutJSON);
+            //write the information e.g. volume of the mesh component to json file
+            if( rExportInfo ){
+                std::filesystem::path infoFileOutJSON = someMesh.getFullName();
+                std::string suffixExtensionInfo = "comp.";
+                suffixExtensionInfo += std::to_string( component.mLabelNr );
+                suffixExtensionInfo += "_info.json";
+                infoFileOutJSON.replace_extension( filesystem::path( suffixExtensionInfo ) );
+                if( !component.mMeshInfo.writeMeshInfo( infoFileOutJSON ) ) {
+                    std::wcerr << "[GigaMesh] ERROR: Could not write mesh information about '" << component.mFileName.wstring() << "'!" << std::endl;
+                    infoFileError++;
                 }
             }
         }
@@ -204,6 +182,11 @@ void printHelp( const char* rExecName ) {
         std::cout << "  -i, --info                              Write the mesh informations of the components in <filename>.comp.<label ID>_info.json" << std::endl;
         std::cout << "  -r, --recursive-iteration               Move through all subdirectories of the input path" << std::endl;
         std::cout << "                                          All '.ply' files will be used for the mesh split in components " << std::endl;
+        std::cout << std::endl;
+        std::cout << "Options for testing and debugging:" << std::endl;
+        std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+                     "                                          writes it as Chrome trace (JSON) to the given file.\n"
+                     "                                          A summary is shown on exit." << std::endl;
 }
 
 //! Main routine for loading a (binary) PLY and save the componentes in a separate file
@@ -226,6 +209,7 @@ int main( int argc, char *argv[] ) {
                 { "recursive-iteration",           no_argument,       nullptr, 'r' },
                 { "version",                      no_argument,       nullptr, 'v' },
                 { "help",                         no_argument,       nullptr, 'h' },
+                { "profile-trace",                required_argument, nullptr,  0  },
                 { nullptr, 0, nullptr, 0 }
         };
 
@@ -236,6 +220,13 @@ int main( int argc, char *argv[] ) {
 
                 switch(character) {
 
+                        case 0:
+                                if(std::string(longOptions[optionIndex].name) == "profile-trace")
+                                {
+                                        PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+                                }
+                                break;
+
                         case 'i': // optional info file suffix
                                 optExportInfos = true;
                                 break;
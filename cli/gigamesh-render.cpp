@@ -0,0 +1,375 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#ifdef _MSC_VER	//windows version for hostname and login
+#include "getoptwin.h"
+
+#else
+#include <unistd.h> // gethostname, getlogin_r
+
+#include <getopt.h>
+#endif
+#include <filesystem>
+
+#include <GigaMesh/printbuildinfo.h>
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/renderortho.h>
+#include <GigaMesh/mesh/ambientocclusion.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+//! Renders the six orthographic views of a mesh into PNG files.
+bool renderMeshViews(
+                const std::filesystem::path&   rFileName,      //!< Input - filename.
+                const std::filesystem::path&   rFileSuffix,    //!< Suffix for the images.
+                const RenderOrtho::sParams&    rParams,        //!< Parameters for rendering.
+                const bool                     rReplaceFiles   //!< Flag to replace existing files.
+) {
+	// Check: Input file exists?
+	if( !std::filesystem::exists( rFileName ) ) {
+		std::cerr << "[GigaMesh] Error: File " << rFileName << " not found!" << std::endl;
+		return( false );
+	}
+
+	// Output files: <stem><suffix>_<view>.png within the current directory as for the other tools.
+	const std::vector<RenderOrtho::sView> views = RenderOrtho::getSixViews();
+	std::vector<std::filesystem::path> fileNamesOut;
+	for( const RenderOrtho::sView& view : views ) {
+		std::filesystem::path fileNameOut = rFileName.stem();
+		fileNameOut += rFileSuffix;
+		fileNameOut += "_" + view.mName + ".png";
+		if( std::filesystem::exists( fileNameOut ) ) {
+			if( !rReplaceFiles ) {
+				std::cerr << "[GigaMesh] File " << fileNameOut << " already exists!" << std::endl;
+				return( false );
+			}
+			std::cout << "[GigaMesh] Warning: File " << fileNameOut << " will be replaced!" << std::endl;
+		}
+		fileNamesOut.push_back( fileNameOut );
+	}
+
+	bool readSucess;
+	Mesh someMesh( rFileName, readSucess );
+	if( !readSucess ) {
+		std::cerr << "[GigaMesh] Error: Could not open file " << rFileName << "!" << std::endl;
+		return( false );
+	}
+
+	RenderOrtho renderer( &someMesh );
+	RenderOrtho::sImage image;
+	for( size_t viewIdx = 0; viewIdx < views.size(); viewIdx++ ) {
+		if( !renderer.render( views[viewIdx], rParams, image ) ) {
+			std::cerr << "[GigaMesh] Error: Rendering view " << views[viewIdx].mName << " failed!" << std::endl;
+			return( false );
+		}
+		if( !image.writePNG( fileNamesOut[viewIdx] ) ) {
+			return( false );
+		}
+		std::cout << "[GigaMesh] File written: " << fileNamesOut[viewIdx] << " Size " << image.mWidth << " x " << image.mHeight
+		          << " pixels i.e. " << image.mWidth*25.4/rParams.mDPI << " x " << image.mHeight*25.4/rParams.mDPI << " mm (unit assumed)." << std::endl;
+	}
+	return( true );
+}
+
+//! Computes the ambient occlusion per vertex and writes the mesh with the values as function values.
+bool computeAmbientOcclusion(
+                const std::filesystem::path&      rFileName,      //!< Input - filename.
+                const std::filesystem::path&      rFileSuffix,    //!< Suffix for the mesh written.
+                const AmbientOcclusion::sParams&  rParams,        //!< Parameters for the ambient occlusion.
+                const bool                        rReplaceFiles   //!< Flag to replace existing files.
+) {
+	// Check: Input file exists?
+	if( !std::filesystem::exists( rFileName ) ) {
+		std::cerr << "[GigaMesh] Error: File " << rFileName << " not found!" << std::endl;
+		return( false );
+	}
+
+	// Output file: <stem><suffix>_AO.ply within the current directory.
+	std::filesystem::path fileNameOut = rFileName.stem();
+	fileNameOut += rFileSuffix;
+	fileNameOut += "_AO.ply";
+	if( std::filesystem::exists( fileNameOut ) ) {
+		if( !rReplaceFiles ) {
+			std::cerr << "[GigaMesh] File " << fileNameOut << " already exists!" << std::endl;
+			return( false );
+		}
+		std::cout << "[GigaMesh] Warning: File " << fileNameOut << " will be replaced!" << std::endl;
+	}
+
+	bool readSucess;
+	Mesh someMesh( rFileName, readSucess );
+	if( !readSucess ) {
+		std::cerr << "[GigaMesh] Error: Could not open file " << rFileName << "!" << std::endl;
+		return( false );
+	}
+
+	std::vector<double> ambientOcclusion;
+	const AmbientOcclusion occlusion( &someMesh );
+	if( !occlusion.compute( rParams, ambientOcclusion ) ) {
+		std::cerr << "[GigaMesh] Error: Computing the ambient occlusion failed!" << std::endl;
+		return( false );
+	}
+	for( uint64_t vertIdx = 0; vertIdx < someMesh.getVertexNr(); vertIdx++ ) {
+		someMesh.getVertexPos( vertIdx )->setFuncValue( ambientOcclusion[vertIdx] );
+	}
+	someMesh.changedVertFuncVal();
+	if( !someMesh.writeFile( fileNameOut ) ) {
+		return( false );
+	}
+	std::cout << "[GigaMesh] File written: " << fileNameOut << " Ambient occlusion of "
+	          << AmbientOcclusion::getDirections( rParams.mSubdivisions ).size() << " directions as function values." << std::endl;
+	return( true );
+}
+
+//! Help i.e. usage of paramters.
+void printHelp( const char* rExecName ) {
+	std::cout << "Usage: " << rExecName << " [options] (<file>)" << std::endl;
+	std::cout << "GigaMesh Software Framework RENDER 3D-data" << std::endl << std::endl;
+	std::cout << "Renders six orthographic views (top, left, front, right, bottom, back) of the given meshes into PNG files" << std::endl;
+	std::cout << "without OpenGL i.e. on hosts without GPU or display. The views and filenames match the screenshots" << std::endl;
+	std::cout << "of the GUI using horizontal rotation e.g. <file>_03_ha_front.png" << std::endl;
+	std::cout << std::endl << std::endl;
+	std::cout << "Options:" << std::endl;
+	std::cout << "  -h, --help                              Displays this help." << std::endl;
+	std::cout << "  -v, --version                           Displays version information." << std::endl << std::endl;
+	std::cout << "  -r, --resolution <float>                Resolution in DPI assuming the mesh is given in mm. Default: 300" << std::endl;
+	std::cout << "  -f, --function-value                    Color by function value using a grayscale ramp." << std::endl;
+	std::cout << "  -c, --vertex-color                      Color by the color per vertex." << std::endl;
+	std::cout << "  -n, --no-lighting                       Disable the shading i.e. render the plain colors." << std::endl;
+	std::cout << "  -t, --threads <int>                     Number of threads. Default: all cores." << std::endl;
+	std::cout << "    , --tile-size <int>                   Edge length of the tiles rendered in parallel. Default: 64" << std::endl;
+	std::cout << "  -a, --ambient-occlusion                 Compute the ambient occlusion per vertex instead of rendering the views" << std::endl;
+	std::cout << "                                          and write it as function values into <file>_AO.ply." << std::endl;
+	std::cout << "    , --ao-subdivisions <int>             Subdivisions of the icosphere providing the directions of the light" << std::endl;
+	std::cout << "                                          i.e. 0: 12, 1: 42, 2: 162, 3: 642, 4: 2562 directions. Default: 3" << std::endl;
+	std::cout << "    , --ao-resolution <int>               Resolution of the depth buffers per direction in pixels. Default: 512" << std::endl;
+	std::cout << "    , --ao-tolerance <float>              Tolerance of the depth test relative to the size of the mesh. Default: 0" << std::endl;
+	std::cout << "  -s, --output-suffix <string>            Write the images using the given <string> as suffix for their names." << std::endl;
+	std::cout << "  -k, --overwrite-existing                Overwrite exisitng files, which is not done by default" << std::endl;
+	std::cout << "                                          to prevent accidental data loss." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for testing and debugging:" << std::endl;
+	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
+	             "                                          Higher numbers increases verbosity.\n"
+	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
+}
+
+//! Main routine for rendering views of meshes without OpenGL.
+//==============================================================================================================================================================
+int main( int argc, char *argv[] ) {
+
+	LOG::initLogging();
+
+	// Default string parameter
+	std::filesystem::path optFileSuffix;
+
+	// Default flags
+	bool optReplaceFiles = false;
+
+	bool optAmbientOcclusion = false;
+
+	RenderOrtho::sParams renderParams;
+	AmbientOcclusion::sParams occlusionParams;
+
+	// PARSE command line options
+	//--------------------------------------------------------------------------
+	// https://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html#Getopt-Long-Option-Example
+	static struct option longOptions[] = {
+		{ "resolution",                   required_argument, nullptr, 'r' },
+		{ "function-value",               no_argument,       nullptr, 'f' },
+		{ "vertex-color",                 no_argument,       nullptr, 'c' },
+		{ "no-lighting",                  no_argument,       nullptr, 'n' },
+		{ "threads",                      required_argument, nullptr, 't' },
+		{ "ambient-occlusion",            no_argument,       nullptr, 'a' },
+		{ "output-suffix",                required_argument, nullptr, 's' },
+		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
+		{ "version",                      no_argument,       nullptr, 'v' },
+		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "tile-size",                    required_argument, nullptr,  0  },
+		{ "ao-subdivisions",              required_argument, nullptr,  0  },
+		{ "ao-resolution",                required_argument, nullptr,  0  },
+		{ "ao-tolerance",                 required_argument, nullptr,  0  },
+		{ "log-level",                    required_argument, nullptr,  0  },
+		{ "profile-trace",                required_argument, nullptr,  0  },
+		{ nullptr, 0, nullptr, 0 }
+	};
+
+	int character = 0;
+	int optionIndex = 0;
+
+	while( ( character = getopt_long_only( argc, argv, ":r:fcnt:as:kvh",
+	         longOptions, &optionIndex ) ) != -1 ) {
+		switch(character) {
+			case 0:
+				if(std::string(longOptions[optionIndex].name) == "tile-size")
+				{
+					const int tileSize = std::atoi( optarg );
+					if( tileSize <= 0 ) {
+						std::cerr << "[GigaMesh] ERROR: Tile size has to be positive!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+					renderParams.mTileSize = static_cast<unsigned int>( tileSize );
+					occlusionParams.mTileSize = renderParams.mTileSize;
+				}
+				if(std::string(longOptions[optionIndex].name) == "ao-subdivisions")
+				{
+					const int subdivisions = std::atoi( optarg );
+					if( subdivisions < 0 || subdivisions > 8 ) {
+						std::cerr << "[GigaMesh] ERROR: Subdivisions have to be within [0,8]!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+					occlusionParams.mSubdivisions = static_cast<unsigned int>( subdivisions );
+				}
+				if(std::string(longOptions[optionIndex].name) == "ao-resolution")
+				{
+					const int resolution = std::atoi( optarg );
+					if( resolution <= 0 ) {
+						std::cerr << "[GigaMesh] ERROR: Resolution of the depth buffers has to be positive!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+					occlusionParams.mResolution = static_cast<unsigned int>( resolution );
+				}
+				if(std::string(longOptions[optionIndex].name) == "ao-tolerance")
+				{
+					occlusionParams.mZTolerance = std::atof( optarg );
+					if( !( occlusionParams.mZTolerance >= 0.0 ) ) {
+						std::cerr << "[GigaMesh] ERROR: Tolerance must not be negative!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+				}
+				if(std::string(longOptions[optionIndex].name) == "profile-trace")
+				{
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
+				if(std::string(longOptions[optionIndex].name) == "log-level")
+				{
+					unsigned int arg = optarg[0] - '0';
+					if(arg <= 5)
+					{
+						LOG::setLogLevel(static_cast<LOG::LogLevel>(arg));
+					}
+					else
+					{
+						std::cerr << "[GigaMesh] WARNING: Log level is out of range [0-4]!" << std::endl;
+					}
+				}
+				break;
+
+			case 'r':
+				renderParams.mDPI = std::atof( optarg );
+				if( !( renderParams.mDPI > 0.0 ) ) {
+					std::cerr << "[GigaMesh] ERROR: Resolution has to be positive!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 'f':
+				renderParams.mColoring = RenderOrtho::COLOR_FUNCTION_VALUE;
+				break;
+
+			case 'c':
+				renderParams.mColoring = RenderOrtho::COLOR_VERTEX_RGB;
+				break;
+
+			case 'n':
+				renderParams.mLighting = false;
+				break;
+
+			case 't':
+				renderParams.mThreadCount = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				occlusionParams.mThreadCount = renderParams.mThreadCount;
+				break;
+
+			case 'a':
+				optAmbientOcclusion = true;
+				break;
+
+			case 's': // optional file suffix
+				optFileSuffix = std::string( optarg );
+				break;
+
+			case 'k': // replaces output files
+				std::cout << "[GigaMesh] Warning: files might be replaced!" << std::endl;
+				optReplaceFiles = true;
+				break;
+
+			case 'v':
+				std::cout << "GigaMesh Software Framework RENDER 3D-data " << VERSION_PACKAGE << std::endl;
+				std::cout << "Multi-threading with " << std::thread::hardware_concurrency() << " threads." << std::endl;
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			case 'h':
+				printHelp( argv[0] );
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			default: // Unknown option given
+				std::cerr << "[GigaMesh] ERROR: Unknown option '" << character << "'!" << std::endl;
+				std::cerr << "[GigaMesh]        See -h or --help for available options." << std::endl;
+				std::exit( EXIT_FAILURE );
+		}
+	}
+
+	// No files given i.e. wrong arguments
+	if( argc-optind <= 0 ) {
+		std::cerr << "[GigaMesh] ERROR: No files given!" << std::endl << std::endl;
+		printHelp( argv[0] );
+		std::exit( EXIT_FAILURE );
+	}
+
+	// SHOW Build information
+	printBuildInfo();
+
+	// Process given files
+	unsigned long filesProcessed = 0;
+	for( int nonOptionArgumentCount = optind;
+	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
+
+		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
+
+		if( !nonOptionArgumentString.empty() ) {
+			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
+
+			if( optAmbientOcclusion ) {
+				if( !computeAmbientOcclusion( nonOptionArgumentString, optFileSuffix, occlusionParams, optReplaceFiles ) ) {
+					std::cerr << "[GigaMesh] ERROR: computeAmbientOcclusion failed!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+			} else if( !renderMeshViews( nonOptionArgumentString, optFileSuffix, renderParams, optReplaceFiles ) ) {
+				std::cerr << "[GigaMesh] ERROR: renderMeshViews failed!" << std::endl;
+				std::exit( EXIT_FAILURE );
+			}
+			filesProcessed++;
+		}
+	}
+
+	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	std::exit( EXIT_SUCCESS );
+}
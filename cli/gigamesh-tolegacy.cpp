@@ -38,8 +38,12 @@
 
 
 #include <GigaMesh/printbuildinfo.h>
+#include <GigaMesh/getlocaltime.h>
 #include <GigaMesh/mesh/mesh.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/mesh/batchprocessing.h>
+#include <GigaMesh/mesh/MeshIO/PlyStreamConverter.h>
 //#include "meshseed.h"
 
 // //#include "voxelcuboid.h"
@@ -54,7 +58,9 @@ bool convertMeshData(
                 const filesystem::path&   rFileSuffix,
                 const bool      rWriteBinary,
                 const bool      rWriteNormals,
-                const bool      rReplaceFiles
+                const bool      rReplaceFiles,
+                const bool      rStreaming,
+                const uint64_t  rChunkSize
 ) {
 	if( rFileName.extension().wstring().size() != 4 ) {
 		cerr << "[GigaMesh] ERROR: File extension '" << rFileName.extension().string() << "' is faulty!" << endl;
@@ -86,6 +92,35 @@ bool convertMeshData(
 	cout << "[GigaMesh] File IN:         " << rFileName << endl;
 	cout << "[GigaMesh] File OUT/Prefix: " << fileNameOut << endl;
 
+	// Convert in chunks without building the mesh i.e. with constant memory.
+	if( rStreaming ) {
+		PlyStreamConverter::sParams streamParams;
+		streamParams.mWriteBinary  = rWriteBinary;
+		streamParams.mWriteNormals = rWriteNormals;
+		streamParams.mChunkSize    = rChunkSize;
+		PlyStreamConverter::sStats streamStats;
+		PlyStreamConverter streamConverter;
+		if( !streamConverter.convert( rFileName, fileNameOut3D, streamParams, streamStats ) ) {
+			cerr << "[GigaMesh] Error: Streaming conversion of '" << rFileName << "' failed!" << endl;
+			return( false );
+		}
+		double bbWdith  = 0.0;
+		double bbHeight = 0.0;
+		double bbThick  = 0.0;
+		if( streamStats.mVertexCount > 0 ) {
+			bbWdith  = round( streamStats.mMax[0] - streamStats.mMin[0] ) / 10.0;
+			bbHeight = round( streamStats.mMax[1] - streamStats.mMin[1] ) / 10.0;
+			bbThick  = round( streamStats.mMax[2] - streamStats.mMin[2] ) / 10.0;
+		}
+		cout << "[GigaMesh] Model ID:        " << streamConverter.getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_ID ) << endl;
+		cout << "[GigaMesh] Material:        " << streamConverter.getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_MATERIAL ) << endl;
+		cout << "[GigaMesh] Vertices:        " << streamStats.mVertexCount << endl;
+		cout << "[GigaMesh] Faces:           " << streamStats.mFaceCount << endl;
+		cout << "[GigaMesh] Bounding Box:    " << bbWdith << " x " << bbHeight << " x " << bbThick << " cm" << endl;
+		cout << "[GigaMesh] Bytes written:   " << streamStats.mBytesWritten << endl;
+		return( true );
+	}
+
 	// Prepare data structures
 	//--------------------------------------------------------------------------
 	bool readSucess;
@@ -120,11 +155,7 @@ bool convertMeshData(
 	cout << "[GigaMesh] Volume (dy):     " << volDXYZ[1]/1000.0 << " cm^3" << endl;
 	cout << "[GigaMesh] Volume (dz):     " << volDXYZ[2]/1000.0 << " cm^3" << endl;
 
-	time_t     rawtime;
-	struct tm* timeinfo;
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	cout << "[GigaMesh] Start date/time is: " << asctime( timeinfo );// << endl;
+	cout << "[GigaMesh] Start date/time is: " << getLocalTimeStr( time( nullptr ) );// << endl;
 	someMesh.setFlagExport( MeshIO::EXPORT_BINARY,        rWriteBinary );
 	someMesh.setFlagExport( MeshIO::EXPORT_VERT_NORMAL,   rWriteNormals );
 	someMesh.setFlagExport( MeshIO::EXPORT_VERT_FLAGS, false );
@@ -132,7 +163,7 @@ bool convertMeshData(
 	someMesh.setFlagExport( MeshIO::EXPORT_VERT_FTVEC, false );
 	someMesh.setFlagExport( MeshIO::EXPORT_POLYLINE,   false );
 	someMesh.writeFile( fileNameOut3D );
-	cout << "[GigaMesh] End date/time is: " << asctime( timeinfo );// << endl;
+	cout << "[GigaMesh] End date/time is: " << getLocalTimeStr( time( nullptr ) );// << endl;
 
 	return( true );
 }
@@ -154,11 +185,30 @@ void printHelp( const char* rExecName ) {
 	std::cout << "                                          Default suffices are '_ASCII' and '_Legacy'." << std::endl;
 	std::cout << "  -k, --overwrite-existing                Overwrite exisitng files, which is not done by default" << std::endl;
 	std::cout << "                                          to prevent accidental data loss." << std::endl;
+	std::cout << "    , --stream                            Convert PLYs in chunks with constant memory regardless of their size." << std::endl;
+	std::cout << "                                          Reading and writing are done by separate threads. No area and volume" << std::endl;
+	std::cout << "                                          are computed, polygons are written as given and normals can only be" << std::endl;
+	std::cout << "                                          written, when present in the input." << std::endl;
+	std::cout << "    , --chunk-size <int>                  Number of vertices or faces per chunk for --stream. Default: 65536" << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for batch processing:" << std::endl;
+	std::cout << "    , --jobs <int>                        Number of files processed concurrently. Zero uses all cores. Default: 1" << std::endl;
+	std::cout << "                                          Reading a file overlaps with processing other files." << std::endl;
+	std::cout << "    , --memory-budget <MB>                Memory for the files processed concurrently, which is estimated" << std::endl;
+	std::cout << "                                          from the file sizes. Default: 75% of the physical memory." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for caching:" << std::endl;
+	std::cout << "    , --mesh-cache                        Use a native binary cache next to each mesh (<file>.gmcache), which" << std::endl;
+	std::cout << "                                          is written, when missing or outdated. Reopening a mesh is done" << std::endl;
+	std::cout << "                                          without parsing and without rebuilding its connectivity." << std::endl;
 	std::cout << std::endl;
 	std::cout << "Options for testing and debugging:" << std::endl;
 	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
 	             "                                          Higher numbers increases verbosity.\n"
 	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
 	//std::cout << "" << endl;
 }
 
@@ -175,6 +225,11 @@ int main( int argc, char *argv[] ) {
 	bool optReplaceFiles = false;
 	bool optWriteBinary  = false;
 	bool optWriteNormals = false;
+	bool optStreaming    = false;
+	uint64_t optChunkSize = PlyStreamConverter::sParams().mChunkSize;
+
+	// Parameters for processing multiple files
+	BatchProcessing::sParams batchParams;
 
 	// PARSE command line options
 	//--------------------------------------------------------------------------
@@ -186,7 +241,13 @@ int main( int argc, char *argv[] ) {
 		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
 		{ "version",                      no_argument,       nullptr, 'v' },
 		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "stream",                       no_argument,       nullptr,  0  },
+		{ "chunk-size",                   required_argument, nullptr,  0  },
+		{ "jobs",                         required_argument, nullptr,  0  },
+		{ "memory-budget",                required_argument, nullptr,  0  },
 		{ "log-level",                    required_argument, nullptr,  0  },
+		{ "mesh-cache",                   no_argument,       nullptr,  0  },
+		{ "profile-trace",                required_argument, nullptr,  0  },
 		{ nullptr, 0, nullptr, 0 }
 	};
 
@@ -200,6 +261,35 @@ int main( int argc, char *argv[] ) {
 				// printf ("option %s", long_options[option_index].name);
 				// if (optarg) printf (" with arg %s", optarg);
 
+				if(std::string(longOptions[optionIndex].name) == "stream")
+				{
+					optStreaming = true;
+				}
+				if(std::string(longOptions[optionIndex].name) == "chunk-size")
+				{
+					const long long chunkSize = std::atoll( optarg );
+					if( chunkSize <= 0 ) {
+						std::cerr << "[GigaMesh] ERROR: Chunk size has to be positive!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+					optChunkSize = static_cast<uint64_t>( chunkSize );
+				}
+				if(std::string(longOptions[optionIndex].name) == "jobs")
+				{
+					batchParams.mJobs = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				}
+				if(std::string(longOptions[optionIndex].name) == "memory-budget")
+				{
+					batchParams.mMemoryBudget = static_cast<uint64_t>( std::max( std::atof( optarg ), 0.0 ) * 1024.0 * 1024.0 );
+				}
+				if(std::string(longOptions[optionIndex].name) == "mesh-cache")
+				{
+					MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+				}
+				if(std::string(longOptions[optionIndex].name) == "profile-trace")
+				{
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
 				if(std::string(longOptions[optionIndex].name) == "log-level")
 				{
 					unsigned int arg = optarg[0] - '0';
@@ -268,25 +358,37 @@ int main( int argc, char *argv[] ) {
 	// SHOW Build information
 	printBuildInfo();
 
-	// Process given files
-	unsigned long filesProcessed = 0;
+	// Collect given files
+	std::vector<std::filesystem::path> fileNames;
 	for( int nonOptionArgumentCount = optind;
 	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
 
 		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
 
 		if( !nonOptionArgumentString.empty() ) {
-			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
+			fileNames.push_back( nonOptionArgumentString );
+		}
+	}
 
-			if( !convertMeshData( nonOptionArgumentString, optFileSuffix,
-			                      optWriteBinary, optWriteNormals, optReplaceFiles ) ) {
-				std::cerr << "[GigaMesh] ERROR: convertMeshData failed!" << std::endl;
-				std::exit( EXIT_FAILURE );
-			}
-			filesProcessed++;
+	// Process given files - concurrently, when requested by --jobs.
+	BatchProcessing::sStats batchStats;
+	const bool batchSuccess = BatchProcessing::run( fileNames, batchParams,
+	                                                [&]( uint64_t /*rFileIdx*/, const std::filesystem::path& rFileName ) {
+		std::cout << "[GigaMesh] Processing file " << rFileName << "..." << std::endl;
+
+		if( !convertMeshData( rFileName, optFileSuffix,
+		                      optWriteBinary, optWriteNormals, optReplaceFiles,
+		                      optStreaming, optChunkSize ) ) {
+			std::cerr << "[GigaMesh] ERROR: convertMeshData failed!" << std::endl;
+			return( false );
 		}
+		return( true );
+	}, batchStats );
+	batchStats.print( std::cout );
+	if( !batchSuccess ) {
+		std::exit( EXIT_FAILURE );
 	}
 
-	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	std::cout << "[GigaMesh] Processed files: " << batchStats.mFilesProcessed << std::endl;
 	exit( EXIT_SUCCESS );
 }
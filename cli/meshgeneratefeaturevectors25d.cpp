@@ -40,6 +40,7 @@
 
 #include <GigaMesh/printbuildinfo.h>
 #include <GigaMesh/getuserandhostname.h>
+#include <GigaMesh/getlocaltime.h>
 #include <GigaMesh/mesh/compfeaturevecs.h>
 
 //#include "voxelcuboid.h"
@@ -47,6 +48,8 @@
 
 #include <sys/stat.h> // statistics for files
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/mesh/batchprocessing.h>
 
 
 #define _DEFAULT_FEATUREGEN_RADIUS_       1.0
@@ -66,6 +69,8 @@ bool generateFeatureVectors(
                 bool                           rNoAreaIntInv,
                 bool                           rNoNormalsFile,
                 bool                           rConcatResults,
+                bool                           rFeatureIndex,
+                FeatureVecMatrix::ePrecision   rFeaturePrecision,
                 const std::string&             rHostname,
                 const std::string&             rUsername
 ) {
@@ -187,10 +192,6 @@ bool generateFeatureVectors(
 	std::cout << std::setprecision( 2 ) << std::fixed;
 	fileStrOutMeta << std::setprecision( 2 ) << std::fixed;
 
-	time_t rawtime;
-
-	time( &rawtime );
-	struct tm * timeInfoMeshLoad = localtime( &rawtime );
 	time_t timeStampMeshLoad = time( nullptr ); // clock() is not multi-threading save (to measure the non-CPU or real time ;) )
 	int timeLoaded{-1};
 
@@ -202,6 +203,7 @@ bool generateFeatureVectors(
 		std::cerr << "[GigaMesh] Error: Could not open file '" << fileNameIn << "'!" << std::endl;
 		return( false );
 	}
+	someMesh.setFeatureVecPrecision( rFeaturePrecision );
 
 	timeLoaded = static_cast<int>( time( nullptr ) ) - static_cast<int>( timeStampMeshLoad );
 
@@ -308,13 +310,8 @@ bool generateFeatureVectors(
 		std::cout << "[GigaMesh] File to write concatenated V+S:      " << fileNameOutVS << std::endl;
 	}
 
-	struct tm * timeinfo;
-
 	// Header for the .mat files
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-
-	std::string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -380,15 +377,13 @@ bool generateFeatureVectors(
 	}
 	fileStrOutMeta << "Hostname:           " << rHostname << std::endl;
 	fileStrOutMeta << "Username:           " << rUsername << std::endl;
-	fileStrOutMeta << "Mesh loaded:        " << asctime( timeInfoMeshLoad ); // no endl required as asctime will add a linebreak
+	fileStrOutMeta << "Mesh loaded:        " << getLocalTimeStr( timeStampMeshLoad ); // no endl required as getLocalTimeStr will add a linebreak
 	fileStrOutMeta << "Load walltime:      " << timeLoaded << " seconds" << std::endl;
 	fileStrOutMeta << "Number of threads:  " << availableConcurrentThreads << std::endl;
 
 	// +++ Collect time for parallel processing
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
 	time_t timeStampParallel = time( nullptr ); // clock() is not multi-threading save (to measure the non-CPU or real time ;) )
-	fileStrOutMeta << "Compute start:      " << asctime( timeinfo ); // no endl required as asctime will add a linebreak
+	fileStrOutMeta << "Compute start:      " << getLocalTimeStr( timeStampParallel ); // no endl required as getLocalTimeStr will add a linebreak
 	// --- Collect time for parallel processing
 
 	// Pre-compute sparse filte:
@@ -415,9 +410,7 @@ bool generateFeatureVectors(
 	delete[] setMeshData;
 
 	// +++ Collect time for parallel processing
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	fileStrOutMeta << "Compute end:        " << asctime( timeinfo ); // no endl required as asctime will add a linebreak
+	fileStrOutMeta << "Compute end:        " << getLocalTimeStr( time( nullptr ) ); // no endl required as getLocalTimeStr will add a linebreak
 	// ... Collect walltimes of the threads
 	for( unsigned int threadCount = 0; threadCount < availableConcurrentThreads; threadCount++ ) {
 		fileStrOutMeta << "Walltime thread " << threadCount << ":  "
@@ -443,13 +436,11 @@ bool generateFeatureVectors(
 		} else {
 			filestrVol << std::fixed << std::setprecision( 10 );
 			filestrVol << strHeader.str();
+			if( !someMesh.assignFeatureVectors( descriptVolume, multiscaleRadiiSize ) ) {
+				std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
+				          << "to vertices failed!" << std::endl;
+			}
 			for( uint64_t i=0; i<someMesh.getVertexNr(); i++ ) {
-				Vertex* currVert = someMesh.getVertexPos( i );
-				if( !currVert->assignFeatureVec( &descriptVolume[i*multiscaleRadiiSize],
-				                                 multiscaleRadiiSize ) ) {
-					std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
-					          << "to vertices failed for Vertex No. " << i << "!" << std::endl;
-				}
 				// Index:
 				filestrVol << i;
 				// Scales or elements of the feature vector:
@@ -473,15 +464,13 @@ bool generateFeatureVectors(
 		} else {
 			filestrSurf << std::fixed << std::setprecision( 10 );
 			filestrSurf << strHeader.str();
-			for( uint64_t i=0; i<someMesh.getVertexNr(); i++ ) {
-				// Assign 2nd feature vector only in case the 1st is not present!
-				if( descriptVolume == NULL ) {
-					Vertex* currVert = someMesh.getVertexPos( i );
-					if( !currVert->assignFeatureVec( &descriptSurface[i*multiscaleRadiiSize],
-					                                 multiscaleRadiiSize ) ) {
-						std::cerr << "[GigaMesh] Assignment of area based feature vectors to vertices failed for Vertex No. " << i << "!" << std::endl;
-					}
+			// Assign 2nd feature vector only in case the 1st is not present!
+			if( descriptVolume == NULL ) {
+				if( !someMesh.assignFeatureVectors( descriptSurface, multiscaleRadiiSize ) ) {
+					std::cerr << "[GigaMesh] Assignment of area based feature vectors to vertices failed!" << std::endl;
 				}
+			}
+			for( uint64_t i=0; i<someMesh.getVertexNr(); i++ ) {
 				// Index:
 				filestrSurf << i;
 				// Scales:
@@ -521,6 +510,21 @@ bool generateFeatureVectors(
 		}
 	}
 
+	// Nearest neighbour index for the feature vectors assigned to the mesh stored next to their file.
+	if( rFeatureIndex && ( ( descriptVolume != NULL ) || ( descriptSurface != NULL ) ) ) {
+		std::filesystem::path fileNameOutIndex = FeatureVecIndex::getFileNameFor( ( descriptVolume != NULL ) ? fileNameOutVol : fileNameOutSurf );
+		if( std::filesystem::exists( fileNameOutIndex ) && !replaceFiles ) {
+			std::cerr << "[GigaMesh] File '" << fileNameOutIndex << "' already exists!" << std::endl;
+			retVal = false;
+		} else if( !someMesh.writeFeatureVecIndexFor( ( descriptVolume != NULL ) ? fileNameOutVol : fileNameOutSurf, true,
+		                                              FeatureVecIndex::sParams() ) ) {
+			std::cerr << "[GigaMesh] ERROR: Could not write the feature vector index '" << fileNameOutIndex << "'!" << std::endl;
+			retVal = false;
+		} else {
+			std::cout << "[GigaMesh] Feature vector index stored in:           " << fileNameOutIndex << std::endl;
+		}
+	}
+
 	// Feature vector file for BOTH descriptors (volume and surface)
 	if( (!fileNameOutVS.empty()) && ( descriptSurface != NULL ) && ( descriptVolume != NULL ) ) {
 		std::fstream filestrVS;
@@ -629,6 +633,13 @@ void printHelp( const char* rExecName )
 	std::cout << "                                          Has no effect, when only one integral invariant is computed." << std::endl;
 	std::cout << "    , --no-normals-file                   Do not write the file with the normal vectors averaged per vertex" << std::endl;
 	std::cout << "                                          of the triangles within the largest sphere." << std::endl;
+	std::cout << "    , --feature-index                     Write an index for searching similar feature vectors (.fvidx)" << std::endl;
+	std::cout << "                                          next to the volume or otherwise the surface descriptors." << std::endl;
+	std::cout << "                                          It is read together with the descriptors by the GUI." << std::endl;
+	std::cout << "    , --feature-precision <double|float|half>" << std::endl;
+	std::cout << "                                          Storage type of the feature vectors in memory and for the index." << std::endl;
+	std::cout << "                                          The index is used, when the descriptors are imported with the same" << std::endl;
+	std::cout << "                                          precision. The files are always written in full precision. Default: double" << std::endl;
 	std::cout << std::endl;
 	std::cout << "Options for MSII filtering:" << std::endl;
 	std::cout << "  -r, --radius SIZE                       Radius of the largest sphere/scale. Default is 1.0 (mm, unit assumed!)" << std::endl;
@@ -641,10 +652,24 @@ void printHelp( const char* rExecName )
 	std::cout << "  -1, --no-volume-integral                Skip the (1st) volume integral invariant." << std::endl;
 	std::cout << "  -2, --no-area-integral                  Skip the (2nd) patch area integral invariant." << std::endl;
 	std::cout << std::endl;
+	std::cout << "Options for batch processing:" << std::endl;
+	std::cout << "    , --jobs <int>                        Number of files processed concurrently. Zero uses all cores. Default: 1" << std::endl;
+	std::cout << "                                          Reading a file overlaps with processing other files." << std::endl;
+	std::cout << "    , --memory-budget <MB>                Memory for the files processed concurrently, which is estimated" << std::endl;
+	std::cout << "                                          from the file sizes. Default: 75% of the physical memory." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for caching:" << std::endl;
+	std::cout << "    , --mesh-cache                        Use a native binary cache next to each mesh (<file>.gmcache), which" << std::endl;
+	std::cout << "                                          is written, when missing or outdated. Reopening a mesh is done" << std::endl;
+	std::cout << "                                          without parsing and without rebuilding its connectivity." << std::endl;
+	std::cout << std::endl;
 	std::cout << "Options for testing and debugging:" << std::endl;
 	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
 	             "                                          Higher numbers increases verbosity.\n"
 	             "                                          (Default: 1)" << std::endl;
+	std::cout << "    , --profile-trace <file>              Records the wall-clock time of the processing steps and\n"
+	             "                                          writes it as Chrome trace (JSON) to the given file.\n"
+	             "                                          A summary is shown on exit." << std::endl;
 	//std::cout << "" << std::endl;
 }
 
@@ -666,6 +691,12 @@ int main( int argc, char *argv[] ) {
 	bool         noAreaIntegral{false};
 	bool         noNormalsFile{false};
 	bool         concatResults{false};
+	bool         featureIndex{false};
+	FeatureVecMatrix::ePrecision featurePrecision{FeatureVecMatrix::PRECISION_DOUBLE};
+
+	// Parameters for processing multiple files - a failed file does not stop the others.
+	BatchProcessing::sParams batchParams;
+	batchParams.mStopOnError = false;
 
 	static struct option longOptions[] = {
 		{ "radius"            , required_argument, nullptr, 'r' },
@@ -677,9 +708,15 @@ int main( int argc, char *argv[] ) {
 		{ "no-normals-file"   , no_argument      , nullptr,  0  },
 		{ "output-suffix"     , required_argument, nullptr, 's' },
 		{ "concat-results"    , no_argument      , nullptr,  0  },
+		{ "feature-index"     , no_argument      , nullptr,  0  },
+		{ "feature-precision" , required_argument, nullptr,  0  },
 		{ "version"           , no_argument,       nullptr, 'v' },
 		{ "help"              , no_argument      , nullptr, 'h' },
+		{ "jobs"              , required_argument, nullptr,  0  },
+		{ "memory-budget"     , required_argument, nullptr,  0  },
 		{ "log-level"         , required_argument, nullptr,  0  },
+		{ "mesh-cache"        , no_argument      , nullptr,  0  },
+		{ "profile-trace"     , required_argument, nullptr,  0  },
 		{ nullptr, 0, nullptr, 0 }
 	};
 
@@ -750,6 +787,18 @@ int main( int argc, char *argv[] ) {
 				break;
 			// Non-short options:
 			case 0:
+				if( std::string(longOptions[optionIndex].name) == "jobs" ) {
+					batchParams.mJobs = static_cast<unsigned int>( std::max( std::atoi( optarg ), 0 ) );
+				}
+				if( std::string(longOptions[optionIndex].name) == "memory-budget" ) {
+					batchParams.mMemoryBudget = static_cast<uint64_t>( std::max( std::atof( optarg ), 0.0 ) * 1024.0 * 1024.0 );
+				}
+				if( std::string(longOptions[optionIndex].name) == "mesh-cache" ) {
+					MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+				}
+				if( std::string(longOptions[optionIndex].name) == "profile-trace" ) {
+					PROFILE::setTraceFileAtExit( std::filesystem::path( optarg ) );
+				}
 				if( std::string(longOptions[optionIndex].name) == "log-level" ) {
 					unsigned int arg = optarg[0] - '0';
 					if(arg <= 5)
@@ -767,6 +816,22 @@ int main( int argc, char *argv[] ) {
 				if( std::string(longOptions[optionIndex].name) == "no-normals-file" ) {
 					noNormalsFile = true;
 				}
+				if( std::string(longOptions[optionIndex].name) == "feature-index" ) {
+					featureIndex = true;
+				}
+				if( std::string(longOptions[optionIndex].name) == "feature-precision" ) {
+					const std::string precision( optarg );
+					if( precision == "double" ) {
+						featurePrecision = FeatureVecMatrix::PRECISION_DOUBLE;
+					} else if( precision == "float" ) {
+						featurePrecision = FeatureVecMatrix::PRECISION_FLOAT;
+					} else if( precision == "half" ) {
+						featurePrecision = FeatureVecMatrix::PRECISION_HALF;
+					} else {
+						std::cerr << "[GigaMesh] Error: Unknown precision '" << precision << "' (option --feature-precision)!" << std::endl;
+						std::exit( EXIT_FAILURE );
+					}
+				}
 				break;
 			default:
 				std::cerr << "[GigaMesh] Error: Unknown option '" << c << "'!" << std::endl;
@@ -795,37 +860,48 @@ int main( int argc, char *argv[] ) {
 	std::string hostName( "unknown" );
 	getUserAndHostName( userName, hostName );
 
-	unsigned long filesProcessed = 0UL;
-	unsigned long filesFailed    = 0UL;
-
+	// Collect given files
+	std::vector<std::filesystem::path> fileNames;
 	for(auto nonOptionArgumentIndex = optind; nonOptionArgumentIndex < argc; ++nonOptionArgumentIndex)
 	{
 		std::filesystem::path nonOptionArgumentPath(argv[nonOptionArgumentIndex]);
 
 		if(std::filesystem::exists(nonOptionArgumentPath))
 		{
-			std::wcout << L"[GigaMesh] Processing file " << nonOptionArgumentPath.wstring() << L"..." << std::endl;
-
-			if( !generateFeatureVectors( nonOptionArgumentPath,
-			                             optFileSuffix,
-			                             radius,
-			                             xyzDim,
-			                             radiiCount,
-			                             replaceFiles,
-			                             noVolumeIntegral,
-			                             noAreaIntegral,
-			                             noNormalsFile,
-			                             concatResults,
-			                             hostName, userName
-			                           ) )
-			{
-				LOG::error() << "[GigaMesh] ERROR: generate featurevectors failed for: " << nonOptionArgumentPath.string() << " !\n";
-				filesFailed++;
-			}
-			++filesProcessed;
+			fileNames.push_back( nonOptionArgumentPath );
 		}
 	}
 
+	// Process given files - concurrently, when requested by --jobs.
+	BatchProcessing::sStats batchStats;
+	BatchProcessing::run( fileNames, batchParams,
+	                      [&]( uint64_t /*rFileIdx*/, const std::filesystem::path& rFileName ) {
+		std::wcout << L"[GigaMesh] Processing file " << rFileName.wstring() << L"..." << std::endl;
+
+		if( !generateFeatureVectors( rFileName,
+		                             optFileSuffix,
+		                             radius,
+		                             xyzDim,
+		                             radiiCount,
+		                             replaceFiles,
+		                             noVolumeIntegral,
+		                             noAreaIntegral,
+		                             noNormalsFile,
+		                             concatResults,
+		                             featureIndex,
+		                             featurePrecision,
+		                             hostName, userName
+		                           ) )
+		{
+			LOG::error() << "[GigaMesh] ERROR: generate featurevectors failed for: " << rFileName.string() << " !\n";
+			return( false );
+		}
+		return( true );
+	}, batchStats );
+	batchStats.print( std::cout );
+	const unsigned long filesProcessed = batchStats.mFilesProcessed + batchStats.mFilesFailed;
+	const unsigned long filesFailed    = batchStats.mFilesFailed;
+
 	// No file was processed:
 	if( filesProcessed == 0 ) {
 		std::cout << "[GigaMesh] !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
@@ -41,6 +41,7 @@
 #include <spherical_intersection/graph.h>
 #include <spherical_intersection/mesh_spherical.h>
 #include "timer.h"
+#include <GigaMesh/profiling/Profiling.h>
 
 namespace {
 bool help_is_requested = false;
@@ -67,6 +68,9 @@ bool thread_count_is_set = false;
 std::size_t max_thread_load;
 bool max_thread_load_is_set = false;
 
+std::string profile_trace_path;
+bool profile_trace_path_is_set = false;
+
 void set_parser_up(Input_Parser &input_parser) {
 	input_parser.add_flag(help_is_requested, "-help", "Displays help.");
 
@@ -139,6 +143,12 @@ void set_parser_up(Input_Parser &input_parser) {
 	    "Sets the maximum number of values to be calculated in each thread "
 	    "without notification.",
 	    &max_thread_load_is_set);
+
+	input_parser.add_value(
+	    profile_trace_path, "-profile_trace",
+	    "Records the wall-clock time of the processing steps and writes "
+	    "it as Chrome trace (JSON) to the given path.",
+	    &profile_trace_path_is_set);
 }
 
 bool arguments_are_valid() {
@@ -187,6 +197,7 @@ std::vector<double> compute_all_values(
     const spherical_intersection::Mesh &mesh, double radius,
     std::function<double(spherical_intersection::Graph &graph)> algorithm,
     std::size_t thread_count) {
+	PROFILE_SCOPE("compute_all_values");
 	const auto &vertices = mesh.get_vertices();
 	std::size_t vertex_count = vertices.size();
 	std::vector<double> values(vertex_count);
@@ -249,6 +260,10 @@ int main(int argc, char *argv[]) {
 	input_parser.parse(argc, argv);
 	bool args_are_valid = arguments_are_valid();
 
+	if (profile_trace_path_is_set) {
+		PROFILE::setTraceFileAtExit(profile_trace_path);
+	}
+
 	if (help_is_requested) {
 		std::cout << input_parser.get_help() << std::endl;
 	}
@@ -261,6 +276,7 @@ int main(int argc, char *argv[]) {
 
 	std::cout << "Loading mesh... " << std::flush;
 	auto object_information = [&] {
+		PROFILE_SCOPE("load");
 		switch (input_format) {
 		case obj:
 			return object_io::obj::load_obj(input_path);
@@ -21,13 +21,100 @@
 //
 
 #include <cstdio>
+#include <cstring>  // memcpy, memcmp
+#include <fstream>
+#include <filesystem>
 
 #include "voxelcuboid.h"
 
 #include "gmcommon.h" // for windows
 
+// The AVX2 kernel is compiled for x86 with GCC and Clang independent of the target flags
+// and chosen at runtime. Other compilers and CPUs use the scalar fallback.
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	#define VOXELCUBOID_AVX2
+	#include <immintrin.h>
+	#define TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#endif
+
 using namespace std;
 
+namespace {
+	//! Header of a cached filter kernel including the version of the format and of
+	//! VoxelCuboid::setFilterKernelSphere - increase it, when the rasterisation changes.
+	const char kernelCacheMagic[8] = { 'G', 'M', 'V', 'K', 'S', 'P', '0', '2' };
+
+	//! FNV-1a hash of a block of memory continuing from rHash.
+	uint64_t hashBytes( const void* rData, size_t rSize, uint64_t rHash = 14695981039346656037ULL ) {
+		const unsigned char* bytes = static_cast<const unsigned char*>( rData );
+		for( size_t i=0; i<rSize; i++ ) {
+			rHash ^= bytes[i];
+			rHash *= 1099511628211ULL;
+		}
+		return rHash;
+	}
+
+	//! Checksum of a cached filter kernel covering its volume, runs and densities.
+	uint64_t hashKernelSpans( double volume, const vector<uint32_t>& rowStart, const vector<uint32_t>& rowLength, const vector<unsigned char>& values ) {
+		uint64_t hash = hashBytes( &volume, sizeof( volume ) );
+		hash = hashBytes( rowStart.data(), rowStart.size() * sizeof( uint32_t ), hash );
+		hash = hashBytes( rowLength.data(), rowLength.size() * sizeof( uint32_t ), hash );
+		return hashBytes( values.data(), values.size(), hash );
+	}
+
+	//! Sum of the products of two runs of densities. Exact as integers are used.
+	uint64_t dotSpanScalar( const unsigned char* voxels, const unsigned char* kernel, uint length ) {
+		uint64_t sum = 0;
+		for( uint i=0; i<length; i++ ) {
+			sum += static_cast<uint32_t>( voxels[i] ) * static_cast<uint32_t>( kernel[i] );
+		}
+		return sum;
+	}
+
+#ifdef VOXELCUBOID_AVX2
+	bool hasAVX2() {
+		static const bool cpuSupportsAVX2 = __builtin_cpu_supports( "avx2" );
+		return cpuSupportsAVX2;
+	}
+
+	//! 32 voxels at once: widened to 16 bit and multiplied and added pairwise to 32 bit.
+	//! The remaining voxels are added by dotSpanScalar.
+	TARGET_AVX2 uint64_t dotSpanAVX2( const unsigned char* voxels, const unsigned char* kernel, uint length ) {
+		const __m256i zeros = _mm256_setzero_si256();
+		__m256i sums = zeros;
+		uint i = 0;
+		// Each 32 bit sum grows by at most 4*255*255 per step, which allows runs of far more than 100.000 voxels.
+		for( ; i+32 <= length; i+=32 ) {
+			const __m256i voxelBytes  = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( voxels + i ) );
+			const __m256i kernelBytes = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( kernel + i ) );
+			sums = _mm256_add_epi32( sums, _mm256_madd_epi16( _mm256_unpacklo_epi8( voxelBytes, zeros ), _mm256_unpacklo_epi8( kernelBytes, zeros ) ) );
+			sums = _mm256_add_epi32( sums, _mm256_madd_epi16( _mm256_unpackhi_epi8( voxelBytes, zeros ), _mm256_unpackhi_epi8( kernelBytes, zeros ) ) );
+		}
+		alignas( 32 ) uint32_t lanes[8];
+		_mm256_store_si256( reinterpret_cast<__m256i*>( lanes ), sums );
+		uint64_t sum = 0;
+		for( const uint32_t lane : lanes ) {
+			sum += lane;
+		}
+		return sum + dotSpanScalar( voxels + i, kernel + i, length - i );
+	}
+#endif
+}
+
+//! Default directory for caching filter kernels within the cache directory of the user
+//! i.e. $XDG_CACHE_HOME or ~/.cache. The cache is disabled, when neither is set.
+string VoxelCuboid::kernelCacheDir = []() {
+	const char* xdgCacheHome = getenv( "XDG_CACHE_HOME" );
+	if( ( xdgCacheHome != nullptr ) && ( xdgCacheHome[0] == '/' ) ) {
+		return ( filesystem::path( xdgCacheHome ) / "gigamesh" / "voxelkernels" ).string();
+	}
+	const char* homeDir = getenv( "HOME" );
+	if( ( homeDir != nullptr ) && ( homeDir[0] != '\0' ) ) {
+		return ( filesystem::path( homeDir ) / ".cache" / "gigamesh" / "voxelkernels" ).string();
+	}
+	return string();
+}();
+
 VoxelCuboid::VoxelCuboid( uint setXYZDim ) {
 	//! Constructor for a cubic Voxel grid.
 	xDim = setXYZDim;
@@ -56,13 +143,15 @@ VoxelCuboid::VoxelCuboid( uint setXYZDim, uint setFilterKernelNr, double* sphere
 
 	cout << setiosflags( ios_base::fixed );
 
-	// we attach spherical filters (and allocate memory);
+	// we attach spherical filters stored as runs of voxels (and allocate memory);
+	// the dense filters are expanded by applyFiltersDense on demand.
 	filterKernelNr      = setFilterKernelNr;
-	filterKernelArray   = static_cast<unsigned char**>(calloc( filterKernelNr, sizeof( unsigned char* ) ));
+	filterKernelArray   = nullptr;
 	filterKernelVolumes = static_cast<double*>(calloc( filterKernelNr, sizeof( double ) ));
+	filterKernelSpans.resize( filterKernelNr );
 	for( uint i=0; i<filterKernelNr; i++ ) {
-		filterKernelArray[i] = static_cast<unsigned char*>(calloc( xDim * yDim * zDim, sizeof( unsigned char ) ));
-		filterKernelVolumes[i] = setFilterKernelSphere( filterKernelArray[i], sphereRadii[i]*setXYZDim/2.0 );
+		setFilterKernelSpans( &filterKernelSpans[i], sphereRadii[i], silent );
+		filterKernelVolumes[i] = filterKernelSpans[i].volume;
 		double filterKernelVolumeIdeal = estVolumeIdealSphere( sphereRadii[i]*setXYZDim/2.0 );
 		if( !silent ) {
 			cout << "[VoxelCuboid::VoxelCuboid] Volume filter Kernel (r=" << setprecision( 1 ) << sphereRadii[i] << "): " << static_cast<int>(filterKernelVolumes[i]) << " (Ideal: " << static_cast<int>(filterKernelVolumeIdeal) << ") Error: " << setprecision( 5 ) << (filterKernelVolumes[i]-filterKernelVolumeIdeal)/filterKernelVolumeIdeal << " %" << endl;
@@ -171,10 +260,268 @@ double VoxelCuboid::setFilterKernelSphere( unsigned char* filterVoxels, float sp
 	return voxlesFilled;
 }
 
+bool VoxelCuboid::setFilterKernelSpans( voxelKernelSpans* kernelSpans, double sphereRadiusRel, bool silent ) {
+	//! Sets the runs of a spherical filter kernel with a radius relative to the cuboid.
+	//!
+	//! The kernel is read from the cache, when present. Otherwise it is rastered
+	//! by VoxelCuboid::setFilterKernelSphere and stored in the cache.
+	//!
+	//! Returns true, when the kernel was read from the cache.
+
+	string cacheFile = getKernelCacheFile( sphereRadiusRel );
+	if( !cacheFile.empty() && readKernelSpans( cacheFile, sphereRadiusRel, kernelSpans ) ) {
+		if( !silent ) {
+			cout << "[VoxelCuboid::" << __FUNCTION__ << "] Filter kernel read from " << cacheFile << endl;
+		}
+		return true;
+	}
+
+	unsigned char* filterVoxels = static_cast<unsigned char*>(calloc( xDim * yDim * zDim, sizeof( unsigned char ) ));
+	kernelSpans->volume = setFilterKernelSphere( filterVoxels, sphereRadiusRel*xDim/2.0 );
+	extractKernelSpans( filterVoxels, kernelSpans );
+	free( filterVoxels );
+
+	if( !cacheFile.empty() && !writeKernelSpans( cacheFile, sphereRadiusRel, *kernelSpans ) && !silent ) {
+		cerr << "[VoxelCuboid::" << __FUNCTION__ << "] ERROR: Could not write filter kernel to " << cacheFile << endl;
+	}
+	return false;
+}
+
+void VoxelCuboid::extractKernelSpans( const unsigned char* filterVoxels, voxelKernelSpans* kernelSpans ) {
+	//! Extracts the run from the first to the last non-zero voxel of each row of a dense filter kernel.
+	//! Zeros within a run are kept, so the runs hold the kernel exactly.
+
+	uint rowNr = yDim*zDim;
+	kernelSpans->rowStart.assign( rowNr, 0 );
+	kernelSpans->rowLength.assign( rowNr, 0 );
+	kernelSpans->rowValueOffset.assign( rowNr, 0 );
+	kernelSpans->values.clear();
+	for( uint row=0; row<rowNr; row++ ) {
+		const unsigned char* rowVoxels = &filterVoxels[static_cast<size_t>(row)*xDim];
+		uint first = 0;
+		while( first < xDim && rowVoxels[first] == 0 ) {
+			first++;
+		}
+		kernelSpans->rowValueOffset[row] = kernelSpans->values.size();
+		if( first == xDim ) {
+			continue;
+		}
+		uint last = xDim-1;
+		while( rowVoxels[last] == 0 ) {
+			last--;
+		}
+		kernelSpans->rowStart[row]  = first;
+		kernelSpans->rowLength[row] = last-first+1;
+		kernelSpans->values.insert( kernelSpans->values.end(), rowVoxels+first, rowVoxels+last+1 );
+	}
+}
+
+void VoxelCuboid::expandKernelSpans() {
+	//! Expands the runs of all filter kernels to dense voxel arrays as used by VoxelCuboid::applyFiltersDense.
+
+	if( filterKernelArray != nullptr ) {
+		return;
+	}
+	filterKernelArray = static_cast<unsigned char**>(calloc( filterKernelNr, sizeof( unsigned char* ) ));
+	uint rowNr = yDim*zDim;
+	for( uint fNr=0; fNr<filterKernelNr; fNr++ ) {
+		filterKernelArray[fNr] = static_cast<unsigned char*>(calloc( xDim * yDim * zDim, sizeof( unsigned char ) ));
+		const voxelKernelSpans& currentSpans = filterKernelSpans[fNr];
+		for( uint row=0; row<rowNr; row++ ) {
+			if( currentSpans.rowLength[row] == 0 ) {
+				continue;
+			}
+			memcpy( &filterKernelArray[fNr][static_cast<size_t>(row)*xDim+currentSpans.rowStart[row]],
+			        &currentSpans.values[currentSpans.rowValueOffset[row]], currentSpans.rowLength[row] );
+		}
+	}
+}
+
+// filter kernel cache --------------------------------------------------------
+
+void VoxelCuboid::setKernelCacheDir( const string& cacheDir ) {
+	//! Sets the directory for caching filter kernels. An empty string disables the cache.
+	kernelCacheDir = cacheDir;
+}
+
+string VoxelCuboid::getKernelCacheDir() {
+	//! Returns the directory for caching filter kernels.
+	return kernelCacheDir;
+}
+
+string VoxelCuboid::getKernelCacheFile( double sphereRadiusRel ) {
+	//! Returns the name of the cache file for a spherical filter kernel
+	//! or an empty string, when the cache is disabled or not accessible.
+
+	if( kernelCacheDir.empty() || !isCube() ) {
+		return string();
+	}
+	error_code errorCode;
+	if( filesystem::create_directories( kernelCacheDir, errorCode ) ) {
+		// Keep the kernels private to the user.
+		filesystem::permissions( kernelCacheDir, filesystem::perms::owner_all, errorCode );
+	}
+	if( errorCode ) {
+		return string();
+	}
+	char fileName[128];
+	snprintf( fileName, sizeof( fileName ), "sphere_%u_%.17g.vkernel", xDim, sphereRadiusRel );
+	return ( filesystem::path( kernelCacheDir ) / fileName ).string();
+}
+
+bool VoxelCuboid::readKernelSpans( const string& filename, double sphereRadiusRel, voxelKernelSpans* kernelSpans ) {
+	//! Reads the runs of a filter kernel written by VoxelCuboid::writeKernelSpans.
+	//!
+	//! Returns false, when the file is missing, does not match this cuboid and radius
+	//! or its checksum does not match the kernel.
+
+	ifstream fileStream( filename, ios::binary );
+	if( !fileStream.is_open() ) {
+		return false;
+	}
+	char     magic[sizeof( kernelCacheMagic )];
+	uint32_t fileDim;
+	double   fileRadiusRel;
+	double   fileVolume;
+	uint32_t fileRowNr;
+	fileStream.read( magic, sizeof( magic ) );
+	fileStream.read( reinterpret_cast<char*>( &fileDim ), sizeof( fileDim ) );
+	fileStream.read( reinterpret_cast<char*>( &fileRadiusRel ), sizeof( fileRadiusRel ) );
+	fileStream.read( reinterpret_cast<char*>( &fileVolume ), sizeof( fileVolume ) );
+	fileStream.read( reinterpret_cast<char*>( &fileRowNr ), sizeof( fileRowNr ) );
+	uint rowNr = yDim*zDim;
+	if( !fileStream || memcmp( magic, kernelCacheMagic, sizeof( magic ) ) != 0 ||
+	    fileDim != xDim || fileRadiusRel != sphereRadiusRel || fileRowNr != rowNr ) {
+		return false;
+	}
+
+	vector<uint32_t> rowStart( rowNr );
+	vector<uint32_t> rowLength( rowNr );
+	uint32_t valueNr;
+	fileStream.read( reinterpret_cast<char*>( rowStart.data() ), rowNr * sizeof( uint32_t ) );
+	fileStream.read( reinterpret_cast<char*>( rowLength.data() ), rowNr * sizeof( uint32_t ) );
+	fileStream.read( reinterpret_cast<char*>( &valueNr ), sizeof( valueNr ) );
+	if( !fileStream ) {
+		return false;
+	}
+
+	// Rebuild and check the offsets, so a damaged file can not cause reads beyond the cuboid.
+	vector<uint> rowValueOffset( rowNr );
+	uint64_t valueSum = 0;
+	for( uint row=0; row<rowNr; row++ ) {
+		if( static_cast<uint64_t>( rowStart[row] ) + rowLength[row] > xDim ) {
+			return false;
+		}
+		rowValueOffset[row] = valueSum;
+		valueSum += rowLength[row];
+	}
+	if( valueSum != valueNr ) {
+		return false;
+	}
+	vector<unsigned char> values( valueNr );
+	uint64_t fileChecksum;
+	fileStream.read( reinterpret_cast<char*>( values.data() ), valueNr );
+	fileStream.read( reinterpret_cast<char*>( &fileChecksum ), sizeof( fileChecksum ) );
+	if( !fileStream || fileChecksum != hashKernelSpans( fileVolume, rowStart, rowLength, values ) ) {
+		return false;
+	}
+
+	kernelSpans->rowStart.assign( rowStart.begin(), rowStart.end() );
+	kernelSpans->rowLength.assign( rowLength.begin(), rowLength.end() );
+	kernelSpans->rowValueOffset = move( rowValueOffset );
+	kernelSpans->values         = move( values );
+	kernelSpans->volume         = fileVolume;
+	return true;
+}
+
+bool VoxelCuboid::writeKernelSpans( const string& filename, double sphereRadiusRel, const voxelKernelSpans& kernelSpans ) {
+	//! Writes the runs of a filter kernel to a binary file:
+	//! magic, dimension, relative radius, volume, number of rows,
+	//! start and length of each run, number of densities, the densities and a checksum.
+	//!
+	//! The file is written to a temporary name and renamed, so concurrent
+	//! processes never read a partial kernel.
+
+	string tempName = filename + ".tmp" + to_string( chrono::steady_clock::now().time_since_epoch().count() );
+	ofstream fileStream( tempName, ios::binary );
+	if( !fileStream.is_open() ) {
+		return false;
+	}
+	uint32_t fileDim   = xDim;
+	uint32_t fileRowNr = yDim*zDim;
+	uint32_t valueNr   = kernelSpans.values.size();
+	vector<uint32_t> rowStart( kernelSpans.rowStart.begin(), kernelSpans.rowStart.end() );
+	vector<uint32_t> rowLength( kernelSpans.rowLength.begin(), kernelSpans.rowLength.end() );
+	fileStream.write( kernelCacheMagic, sizeof( kernelCacheMagic ) );
+	fileStream.write( reinterpret_cast<const char*>( &fileDim ), sizeof( fileDim ) );
+	fileStream.write( reinterpret_cast<const char*>( &sphereRadiusRel ), sizeof( sphereRadiusRel ) );
+	fileStream.write( reinterpret_cast<const char*>( &kernelSpans.volume ), sizeof( kernelSpans.volume ) );
+	fileStream.write( reinterpret_cast<const char*>( &fileRowNr ), sizeof( fileRowNr ) );
+	fileStream.write( reinterpret_cast<const char*>( rowStart.data() ), rowStart.size() * sizeof( uint32_t ) );
+	fileStream.write( reinterpret_cast<const char*>( rowLength.data() ), rowLength.size() * sizeof( uint32_t ) );
+	fileStream.write( reinterpret_cast<const char*>( &valueNr ), sizeof( valueNr ) );
+	fileStream.write( reinterpret_cast<const char*>( kernelSpans.values.data() ), kernelSpans.values.size() );
+	uint64_t checksum = hashKernelSpans( kernelSpans.volume, rowStart, rowLength, kernelSpans.values );
+	fileStream.write( reinterpret_cast<const char*>( &checksum ), sizeof( checksum ) );
+	fileStream.close();
+	error_code errorCode;
+	if( !fileStream ) {
+		filesystem::remove( tempName, errorCode );
+		return false;
+	}
+	filesystem::rename( tempName, filename, errorCode );
+	if( errorCode ) {
+		filesystem::remove( tempName, errorCode );
+		return false;
+	}
+	return true;
+}
+
 void VoxelCuboid::applyFilters( double* featureVec ) {
+	//! Apply the filter kernels and return the feature vector.
+	//!
+	//! All kernels are applied within a single pass over the rows of the cuboid
+	//! using the runs of non-zero voxels, so each row is loaded only once and
+	//! the voxels outside the kernels are skipped. The products are summed as
+	//! integers, so the result equals VoxelCuboid::applyFiltersDense.
+
+	double nominator = pow( UCHAR_MAX, 2.0 );
+	uint   rowNr     = yDim*zDim;
+
+#ifdef VOXELCUBOID_AVX2
+	uint64_t (*dotSpan)( const unsigned char*, const unsigned char*, uint ) = hasAVX2() ? dotSpanAVX2 : dotSpanScalar;
+#else
+	uint64_t (*dotSpan)( const unsigned char*, const unsigned char*, uint ) = dotSpanScalar;
+#endif
+
+	vector<uint64_t> featureSums( filterKernelNr, 0 );
+	for( uint row=0; row<rowNr; row++ ) {
+		const unsigned char* rowVoxels = &cuboidArray[static_cast<size_t>(row)*xDim];
+		for( uint fNr=0; fNr<filterKernelNr; fNr++ ) {
+			const voxelKernelSpans& currentSpans = filterKernelSpans[fNr];
+			const uint spanLength = currentSpans.rowLength[row];
+			if( spanLength == 0 ) {
+				continue;
+			}
+			featureSums[fNr] += dotSpan( rowVoxels + currentSpans.rowStart[row],
+			                             &currentSpans.values[currentSpans.rowValueOffset[row]], spanLength );
+		}
+	}
+	for( uint fNr=0; fNr<filterKernelNr; fNr++ ) {
+		featureVec[fNr] = ( static_cast<double>( featureSums[fNr] ) / nominator ) / filterKernelVolumes[fNr];
+	}
+}
+
+void VoxelCuboid::applyFiltersDense( double* featureVec ) {
 	//! Apply the filter kernels and return the feature vector
+	//! multiplying the full voxel array by each kernel.
+	//!
+	//! Former implementation of VoxelCuboid::applyFilters kept for comparison.
 
 	//double* featureVec = (double*) calloc( filterKernelNr, sizeof( double ) );
+	if( filterKernelArray == nullptr ) {
+		expandKernelSpans();
+	}
 
 	unsigned char* currentFilterKernel;
 	double nominator = pow( UCHAR_MAX, 2.0 );
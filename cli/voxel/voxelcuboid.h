@@ -33,6 +33,7 @@
 #include <cstdio>	// fopen, fwrite, fclose
 
 #include <chrono>
+#include <vector>
 
 // C++ includes:
 #include "voxelsphereparam.h"
@@ -50,6 +51,21 @@
 
 using uint = unsigned int;
 
+//!
+//! \brief Spherical filter kernel stored as runs of non-zero voxels. (Layer 0)
+//!
+//! As the kernels are convex, each row along the x-axis holds at most one run.
+//! The runs are indexed by row i.e. z*yDim+y, so all kernels can be applied
+//! within a single pass over the rows of the VoxelCuboid.
+//!
+struct voxelKernelSpans {
+	std::vector<uint>          rowStart;       //!< First voxel of the run within each row.
+	std::vector<uint>          rowLength;      //!< Number of voxels of the run within each row - zero for empty rows.
+	std::vector<uint>          rowValueOffset; //!< Index of the first density of each run within values.
+	std::vector<unsigned char> values;         //!< Densities of the voxels of all runs.
+	double                     volume = 0.0;   //!< Volume of the kernel (for normalization).
+};
+
 //!
 //! \brief VoxelCuboid for handling volume data. (Layer 0)
 //!
@@ -70,6 +86,11 @@ class VoxelCuboid {
 		// filters:
 		double  setFilterKernelSphere( unsigned char* filterVoxels, float sphereRadius );
 		void applyFilters( double* featureVec ); // double* applyFilters();
+		void applyFiltersDense( double* featureVec );
+
+		// filter kernel cache:
+		static void        setKernelCacheDir( const std::string& cacheDir );
+		static std::string getKernelCacheDir();
 
 		// getting data/information:
 		unsigned char* getCuboidArrayRef();
@@ -91,6 +112,13 @@ class VoxelCuboid {
 		int writeDat(const std::string& filename );
 
 	private:
+		bool   setFilterKernelSpans( voxelKernelSpans* kernelSpans, double sphereRadiusRel, bool silent );
+		void   extractKernelSpans( const unsigned char* filterVoxels, voxelKernelSpans* kernelSpans );
+		void   expandKernelSpans();
+		std::string getKernelCacheFile( double sphereRadiusRel );
+		bool   readKernelSpans( const std::string& filename, double sphereRadiusRel, voxelKernelSpans* kernelSpans );
+		bool   writeKernelSpans( const std::string& filename, double sphereRadiusRel, const voxelKernelSpans& kernelSpans );
+
 		double setEightVoxelsSymmetric( unsigned char* someCuboid, uint x, uint y, uint z, unsigned char value, int rasterMode=_RASTER_MODE_SET_ );
 		double setEightVoxelsSymmetric( uint x, uint y, uint z, unsigned char value, int rasterMode=_RASTER_MODE_SET_ );
 
@@ -100,9 +128,12 @@ class VoxelCuboid {
 		uint zDim;                           //!< number of voxles along the z-axis
 		unsigned char*  cuboidArray;         //!< array storing the voxels densities [0...255]
 		unsigned char*  cuboidArrayOriginal; //!< array storing the voxels original densities - can (and should not be) alterd! Required by VoxelCuboid::applyFilters, set by raster methods.
-		unsigned char** filterKernelArray;   //!< array storing the voxels densities [0...255]
+		unsigned char** filterKernelArray;   //!< array storing the voxels densities [0...255] - expanded from filterKernelSpans by VoxelCuboid::applyFiltersDense only.
 		double*         filterKernelVolumes; //!< Volume of each filter kernel (for normalization).
 		uint            filterKernelNr;      //!< number of filters
+		std::vector<voxelKernelSpans> filterKernelSpans; //!< Runs of non-zero voxels of each filter kernel.
+
+		static std::string kernelCacheDir;   //!< Directory for caching filter kernels - empty disables the cache.
 };
 
 #endif
@@ -138,10 +138,27 @@ int main(void) {
 		uint xyzDim = 256;
 		double multiscaleRadii[10] = { 1.0, 0.9, 0.8, 0.7, 0.6, 0.5, 0.4, 0.3, 0.2, 0.1 };
 		double featureVector[10];
+		double featureVectorDense[10];
 		VoxelCuboid someCube( xyzDim, 10, multiscaleRadii );
-		someCube.rasterSetTo( 255 );
-		// will return the same value only, but good for performance measurment:
+		VoxelSphereParam sphereParam;
+		sphereParam.sphereRadius = xyzDim/3;            // Radius of the sphere in voxel.
+		sphereParam.baseDensity  = 1.0;                 // Density offset multiplied with whatever density function used (use 1.0 for full voxels).
+		sphereParam.rasterMode   = _RASTER_MODE_OR_;    // Defines the operation with existing data in the grid.
+		sphereParam.radiusFunc   = _SPHERE_FUNC_SOLID_; // Defines the function used to estimate a voxels density as function of the radius.
+		someCube.rasterSphere( sphereParam );
+		// compare the runs of the filter kernels with the former dense filter kernels:
+		auto timeStart = chrono::steady_clock::now();
+		someCube.applyFiltersDense( featureVectorDense );
+		auto timeDense = chrono::steady_clock::now();
 		someCube.applyFilters( featureVector );
+		auto timeSpans = chrono::steady_clock::now();
+		double maxDiff = 0.0;
+		for( uint i=0; i<10; i++ ) {
+			maxDiff = max( maxDiff, fabs( featureVector[i] - featureVectorDense[i] ) );
+		}
+		cout << "applyFiltersDense took " << chrono::duration<double>( timeDense - timeStart ).count() << " seconds (including the expansion of the filter kernels)." << endl;
+		cout << "applyFilters took      " << chrono::duration<double>( timeSpans - timeDense ).count() << " seconds." << endl;
+		cout << "Maximum difference:    " << maxDiff << endl;
 	}
 
 	return 0;
@@ -0,0 +1,82 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PLYSTREAMCONVERTER_H
+#define PLYSTREAMCONVERTER_H
+
+#include <cstdint>
+#include <filesystem>
+
+#include "ModelMetaData.h"
+
+//!
+//! \brief Converts a PLY into a legacy PLY in chunks of fixed size. (Layer 0)
+//!
+//! Streaming alternative to reading a Mesh and writing it with PlyWriter for
+//! pure format conversion e.g. gigamesh-tolegacy. No topology is built, so the
+//! memory is constant regardless of the size of the mesh: a reader fills
+//! chunks of vertices and faces, which are encoded and written by a writer.
+//! Reader and writer run on separate threads, when requested.
+//!
+//! The output has the same properties as written by PlyWriter with colour and
+//! without flags, labels, feature vectors, polylines and texture coordinates.
+//! Faces are written as given i.e. polygons are not triangulated. Normals
+//! per vertex can only be written, when they are present in the input.
+//!
+//! Supports ASCII and binary PLYs of either byte order. The vertex element
+//! has to precede the face element. Other elements are skipped.
+//!
+//! Layer 0
+//!
+
+class PlyStreamConverter {
+
+	public:
+		//! Parameters for conversion.
+		struct sParams {
+			bool     mWriteBinary  = false;   //!< Write binary instead of ASCII.
+			bool     mWriteNormals = false;   //!< Write the normals per vertex - they have to be present in the input.
+			uint64_t mChunkSize    = 65536;   //!< Number of vertices or faces per chunk.
+			bool     mThreaded     = true;    //!< Read and write on separate threads.
+		};
+
+		//! Information gathered while converting.
+		struct sStats {
+			uint64_t mVertexCount  = 0;   //!< Number of vertices.
+			uint64_t mFaceCount    = 0;   //!< Number of faces.
+			double   mMin[3] { 0.0, 0.0, 0.0 };  //!< Minimum of the bounding box.
+			double   mMax[3] { 0.0, 0.0, 0.0 };  //!< Maximum of the bounding box.
+			uint64_t mBytesWritten = 0;   //!< Size of the output file.
+		};
+
+		PlyStreamConverter() = default;
+
+		bool convert( const std::filesystem::path& rFileIn, const std::filesystem::path& rFileOut,
+		              const sParams& rParams, sStats& rStats );
+
+		const ModelMetaData& getModelMetaDataRef() const { return( mModelMetaData ); }
+
+	private:
+		ModelMetaData mModelMetaData;  //!< Meta-data of the input, which is passed to the output.
+};
+
+#endif // PLYSTREAMCONVERTER_H
@@ -0,0 +1,74 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AMBIENTOCCLUSION_H
+#define AMBIENTOCCLUSION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "renderortho.h"
+#include "vector3d.h"
+
+class Mesh;
+
+//!
+//! \brief Headless CPU ambient occlusion of the vertices of a Mesh. (Layer 2)
+//!
+//! Replacement for MeshGL::funcVertAmbientOcclusion on hosts without OpenGL.
+//! For each direction given by the vertices of an IcoSphereTree an
+//! orthographic depth buffer is rendered by RenderOrtho i.e. with tiles
+//! rastered in parallel. Each vertex facing the direction and not hidden
+//! within the depth buffer receives the cosine between its normal and the
+//! direction as in Mesh::funcVertAddLight. The vertices are tested in
+//! parallel and the directions are accumulated in their order, so the
+//! result does not depend on the number of threads.
+//!
+//! The values range from 0 (occluded) to about a quarter of the number of
+//! directions (unoccluded plane), which matches the GUI.
+//!
+//! Layer 2
+//!
+
+class AmbientOcclusion {
+
+	public:
+		//! Parameters for compute - see MeshGL::funcVertAmbientOcclusion.
+		struct sParams {
+			unsigned int mResolution   = 512;  //!< Edge length of the depth buffers in pixels covering the diameter of the mesh.
+			unsigned int mSubdivisions = 3;    //!< Subdivisions of the IcoSphereTree providing the directions i.e. 12, 42, 162, 642, 2562, ...
+			double       mZTolerance   = 0.0;  //!< Tolerance of the depth test relative to the diameter of the mesh.
+			double       mDepthBias    = 1.0;  //!< Slope scaled offset of the depth test in pixels preventing self-occlusion - see glPolygonOffset.
+			unsigned int mTileSize     = 64;   //!< Edge length of a tile in pixels - see RenderOrtho::sParams.
+			unsigned int mThreadCount  = 0;    //!< Number of threads - zero uses all available cores.
+		};
+
+		explicit AmbientOcclusion( Mesh* rMesh );
+
+		bool compute( const sParams& rParams, std::vector<double>& rValues ) const;
+
+		static std::vector<Vector3D> getDirections( unsigned int rSubdivisions );
+
+	private:
+		RenderOrtho mRenderer; //!< Renderer holding the vertex data.
+};
+
+#endif // AMBIENTOCCLUSION_H
@@ -0,0 +1,82 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCHPROCESSING_H
+#define BATCHPROCESSING_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+//!
+//! \brief Worker pool processing files concurrently for the CLI tools. (Layer 0)
+//!
+//! Used by the --jobs option of the CLI tools. The files are processed by
+//! a fixed number of worker threads, which are kept for the whole batch.
+//! So reading the next file overlaps with processing the current one and
+//! the memory pools of the allocator per thread are reused.
+//!
+//! The memory required per file is estimated from its size. A file is only
+//! started, when the estimates of all running files fit into the memory
+//! budget. A single file is always started, even when it exceeds the budget.
+//!
+//! The function called per file has to be thread-safe i.e. must only
+//! modify data related to the given file index.
+//!
+//! Layer 0
+//!
+
+class BatchProcessing {
+
+	public:
+		//! Parameters of a batch.
+		struct sParams {
+			unsigned int mJobs              = 1;    //!< Number of files processed concurrently. Zero: all available cores.
+			uint64_t     mMemoryBudget      = 0;    //!< Memory in bytes for the files processed concurrently. Zero: 75% of the physical memory.
+			double       mMemoryPerFileByte = 16.0; //!< Estimated memory in bytes required per byte of the input file.
+			bool         mStopOnError       = true; //!< Do not start further files after a file failed.
+		};
+
+		//! Aggregated results of a batch.
+		struct sStats {
+			uint64_t     mFilesProcessed = 0;   //!< Files processed successfully.
+			uint64_t     mFilesFailed    = 0;   //!< Files, which failed.
+			uint64_t     mFilesSkipped   = 0;   //!< Files not started due to an error - see sParams::mStopOnError.
+			uint64_t     mBytesProcessed = 0;   //!< Sum of the file sizes of the processed files.
+			double       mSeconds        = 0.0; //!< Wall-clock time of the batch.
+			unsigned int mJobs           = 0;   //!< Number of worker threads used.
+
+			void print( std::ostream& rOutput ) const;
+		};
+
+		//! Function called per file. Returns false in case of an error.
+		using tFileFunc = std::function<bool( uint64_t rFileIdx, const std::filesystem::path& rFileName )>;
+
+		static bool     run( const std::vector<std::filesystem::path>& rFileNames, const sParams& rParams,
+		                     const tFileFunc& rFileFunc, sStats& rStats );
+
+		static uint64_t getPhysicalMemory();
+		static uint64_t getFileSize( const std::filesystem::path& rFileName );
+};
+
+#endif // BATCHPROCESSING_H
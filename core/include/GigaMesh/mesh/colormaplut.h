@@ -0,0 +1,91 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLORMAPLUT_H
+#define COLORMAPLUT_H
+
+#include <cstdint>
+#include <vector>
+
+//!
+//! \brief Colour map lookup table for function values. (Layer 0)
+//!
+//! Replaces the evaluation of the colour map formula per vertex - see
+//! shaders/funcval.vert. The range, inversion and the texture
+//! coordinate of the colour ramp are folded into a table of LUT_SIZE
+//! entries, which is built once per colour map or range change.
+//! Function values are then normalized, raised to the gamma and quantised
+//! to an index and the colour is gathered from the table.
+//!
+//! The ramp is given as RGB triplets e.g. one row of the colour map image
+//! of the GUI, so the table can be used without Qt e.g. for baking the
+//! colours of function values into vertex colours of an exported mesh.
+//!
+//! Contiguous arrays are processed in chunks on multiple threads - see
+//! ParallelFor. On x86 CPUs supporting AVX2 four values are processed at once
+//! for a gamma of one, otherwise a scalar fallback is used, which computes
+//! exactly the same.
+//!
+//! Not-a-number maps to the lowest colour as do values below the range.
+//!
+//! Layer 0
+//!
+
+class ColorMapLut {
+
+	public:
+		//! Number of entries of the table.
+		static constexpr uint64_t LUT_SIZE = 4096;
+
+		//! Parameters for build - see MeshGLParams.
+		struct sParams {
+			double mFuncValMin     = 0.0;   //!< Function value mapped to the lowest colour.
+			double mFuncValMax     = 1.0;   //!< Function value mapped to the highest colour.
+			double mGamma          = 1.0;   //!< Exponent applied to the normalized function value - ignored for mRepeat.
+			bool   mInvert         = false; //!< Reverse the colour ramp.
+			bool   mRepeat         = false; //!< Repeat the colour ramp back and forth with mRepeatInterval instead of using the range.
+			double mRepeatInterval = 1.0;   //!< Length of one repetition - has to be positive.
+		};
+
+		ColorMapLut() = default;
+
+		bool build( const uint8_t* rRampRGB, uint64_t rRampWidth, const sParams& rParams );
+
+		// Information
+		bool           isBuilt() const   { return( !mTable.empty() ); }
+		const sParams& getParams() const { return( mParams ); }
+
+		// Lookup
+		void getColor( double rFuncVal, uint8_t* rRGBA ) const;
+		bool apply( const double* rFuncVals, uint64_t rCount, uint8_t* rRGBA,
+		            unsigned int rThreadCount = 0, bool rAllowSIMD = true ) const;
+
+		//! @returns true, when the CPU supports the AVX2 kernel.
+		static bool hasAVX2();
+
+	private:
+		sParams               mParams;         //!< Parameters of the last build.
+		double                mOffset = 0.0;   //!< Subtracted from the function value before scaling - mFuncValMin.
+		double                mScale  = 0.0;   //!< Maps the range to [0,1] - or the reciprocal of mRepeatInterval.
+		std::vector<uint32_t> mTable;          //!< RGBA per entry - stored as bytes in this order.
+};
+
+#endif // COLORMAPLUT_H
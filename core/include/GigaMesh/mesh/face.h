@@ -30,6 +30,7 @@
 
 class Plane;
 class EdgeGeodesic;
+class VisitedSet;
 
 using uint = unsigned int;
 
@@ -61,7 +62,7 @@ class Face : public Primitive {
 
 	public:
 		// constructor and deconstructor:
-		Face( unsigned int rIndex, VertexOfFace *setA, VertexOfFace *setB, VertexOfFace *setC );
+		Face( unsigned int rIndex, VertexOfFace *setA, VertexOfFace *setB, VertexOfFace *setC, bool rConnectToVertices=true );
 		virtual ~Face();
 
 		// Element enumeration
@@ -96,6 +97,8 @@ class Face : public Primitive {
 		        void     getIndexOffsetBitEdge( int* bitOffset, int* bitNr, int edgeIdx );
 				bool     markVertsVisited( uint64_t* rVertBitArrayVisited );
 				bool     addAndTagUntaggedVerts( std::vector<Vertex*>* rSomeVerts, uint64_t* rVertBitArrayVisited );
+				bool     markVertsVisited( VisitedSet& rVertsVisited );
+				bool     addAndTagUntaggedVerts( std::vector<Vertex*>* rSomeVerts, VisitedSet& rVertsVisited );
 
 		// Information retrival:
 				double   getX() const override;
@@ -194,6 +197,8 @@ class Face : public Primitive {
 				bool     getFuncValVertRidge( std::set<Vertex*>* rRidgeVerts );
 		        bool     isOnFuncValIsoLine( double isoThres );
 				bool     getFuncValIsoPoint( double isoThres, Vector3D* isoPoint, Face** faceNext, bool searchForward, Face** faceVisited );
+		        bool     isOnIsoLine( double valA, double valB, double valC );
+		        bool     getIsoPoint( double funcValA, double funcValB, double funcValC, Vector3D* isoPoint, Face** faceNext, bool searchForward, Face** faceVisited );
 		// Feature vector related
 				bool     getFeatureVec1RingSector( const Vertex* rVert1RingCenter, const s1RingSectorPrecomp& r1RingSecPre,
 				                                    std::vector<double>& rFeatureVec1RingSector ) const;
@@ -214,6 +219,8 @@ class Face : public Primitive {
 		// mesh setup:
 		        void     reconnectToFaces();  // re-connects this face to its neighbouring faces
 		        void     connectToFaces();    // connects this face to its neighbouring faces
+		        void     getNeighbourFacesAll( std::vector<Face*>& rNeighbourFaces ) const;        // per edge and non-manifold - see MeshCache
+		        void     setNeighbourFacesAll( Face* const* rNeighbourFaces, unsigned short rCount ); // per edge and non-manifold - see MeshCache
 		        double   getAreaNormal();
 		        bool     getVolumeDivergence( double& rVolumeDX, double& rVolumeDY, double& rVolumeDZ );
 		        bool     getVolumeToPlane( double* rVolume, bool* rPlanePos, Plane* rPlane );
@@ -256,6 +263,7 @@ class Face : public Primitive {
 		        int  pointOfSphereEdgeIntersection( Vertex* vert1, Vertex* vert2, Vector3D positionVec, double radius, Vector3D* interSec1, Vector3D* interSec2 ); //! \todo make private?
 
 				Vertex* advanceInSphere( Vertex* fromVert, double* sphereCenter, double radius, uint64_t* bitArrayVisited, std::set<Vertex*>* nextArray );
+				Vertex* advanceInSphere( Vertex* fromVert, double* sphereCenter, double radius, VisitedSet& rVertsVisited, std::vector<Vertex*>* nextArray );
 
 		// plane
 				bool intersectsPlane(const Vector3D* planeHNF);
@@ -0,0 +1,164 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FACEREDUCTION_H
+#define FACEREDUCTION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <GigaMesh/mesh/parallelfor.h>
+
+//!
+//! \brief Compensated sum of doubles using the Kahan-Babuska algorithm by Neumaier. (Layer 0)
+//!
+//! The rounding error of each addition is collected separately and added to
+//! the sum, when it is requested. Sums of other instances can be added as well,
+//! which allows to merge partial sums without losing their compensation.
+//!
+//! Layer 0
+//!
+
+class CompensatedSum {
+
+	public:
+		void   add( double rValue );
+		void   add( const CompensatedSum& rOther );
+		double getSum() const;
+
+	private:
+		double mSum          = 0.0; //!< Sum of the values.
+		double mCompensation = 0.0; //!< Sum of the rounding errors.
+};
+
+//!
+//! \brief Deterministic parallel reductions over the faces of a mesh. (Layer 0)
+//!
+//! The faces are split into chunks of a fixed size independent of the number
+//! of threads. Each chunk is summed using CompensatedSum and the sums of the
+//! chunks are merged pairwise in the order of the chunks. Therefore the results
+//! are the same for any number of threads.
+//!
+//! The function called per face returns the state of the face. Degenerate faces
+//! e.g. having a zero area are counted instead of being reported one by one.
+//! Faces are identified by their index, so the caller maps indices to faces.
+//!
+//! Layer 0
+//!
+
+namespace FaceReduction {
+	//! State of a face returned by the function called per face.
+	enum eFaceState {
+		FACE_VALID,      //!< The values of the face are summed.
+		FACE_DEGENERATE, //!< The face e.g. having a zero area is counted, but not summed.
+		FACE_SKIPPED     //!< The face is ignored e.g. not within the region of interest.
+	};
+
+	//! Result of a reduction.
+	struct sResult {
+		std::vector<double> mSums;                //!< Sum of each value or bin.
+		uint64_t            mFacesValid      = 0; //!< Number of faces summed.
+		uint64_t            mFacesDegenerate = 0; //!< Number of degenerate faces.
+		uint64_t            mFacesSkipped    = 0; //!< Number of skipped faces.
+	};
+
+	//! Faces per chunk - fixed for results independent of the number of threads.
+	constexpr uint64_t CHUNK_SIZE = 16384;
+	//! Maximum number of bins a face can be added to by reduceBinned e.g. the labels of its three vertices.
+	constexpr unsigned int BINS_PER_FACE_MAX = 3;
+
+	void mergePairwise( std::vector<std::vector<CompensatedSum>>& rChunkSums, uint64_t rValueCount, std::vector<double>& rSums );
+	void countStates( const std::vector<uint64_t>& rChunkCounts, sResult& rResult );
+
+	//! Sums rValueCount values over the faces [0,rFaceCount).
+	//!
+	//! rFaceFunc( uint64_t rFaceIdx, double* rValues ) sets the rValueCount values
+	//! of a face, which are initialized with zero, and returns its eFaceState.
+	//! Faces of different chunks are processed in parallel, so rFaceFunc has to be
+	//! thread-safe for different faces.
+	template <typename tFaceFunc>
+	sResult reduce( uint64_t rFaceCount, unsigned int rValueCount, tFaceFunc rFaceFunc, unsigned int rThreadCount = 0 ) {
+		const uint64_t chunkCount = ParallelFor::getChunkCount( rFaceCount, CHUNK_SIZE );
+		std::vector<std::vector<CompensatedSum>> chunkSums( chunkCount, std::vector<CompensatedSum>( rValueCount ) );
+		std::vector<uint64_t> chunkCounts( chunkCount * 3, 0 );
+		ParallelFor::forEachChunk( chunkCount, ParallelFor::getThreadCount( rThreadCount ), [&]( uint64_t rChunkIdx ) {
+			std::vector<double> faceValues( rValueCount );
+			std::vector<CompensatedSum>& sums = chunkSums[rChunkIdx];
+			const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * CHUNK_SIZE, rFaceCount );
+			for( uint64_t faceIdx=rChunkIdx*CHUNK_SIZE; faceIdx<faceIdxEnd; faceIdx++ ) {
+				std::fill( faceValues.begin(), faceValues.end(), 0.0 );
+				const eFaceState faceState = rFaceFunc( faceIdx, faceValues.data() );
+				chunkCounts[rChunkIdx*3+faceState]++;
+				if( faceState != FACE_VALID ) {
+					continue;
+				}
+				for( unsigned int i=0; i<rValueCount; i++ ) {
+					sums[i].add( faceValues[i] );
+				}
+			}
+		} );
+		sResult result;
+		mergePairwise( chunkSums, rValueCount, result.mSums );
+		countStates( chunkCounts, result );
+		return( result );
+	}
+
+	//! Sums one value per face into rBinCount bins e.g. the area per label.
+	//!
+	//! rFaceFunc( uint64_t rFaceIdx, uint64_t* rBins, unsigned int& rBinNr, double& rValue )
+	//! sets the value of a face and up to BINS_PER_FACE_MAX distinct bins it is added to.
+	//! The bins are summed per chunk and merged like FaceReduction::reduce, so
+	//! the memory required grows with the number of chunks times the number of bins.
+	template <typename tFaceFunc>
+	sResult reduceBinned( uint64_t rFaceCount, uint64_t rBinCount, tFaceFunc rFaceFunc, unsigned int rThreadCount = 0 ) {
+		const uint64_t chunkCount = ParallelFor::getChunkCount( rFaceCount, CHUNK_SIZE );
+		std::vector<std::vector<CompensatedSum>> chunkSums( chunkCount );
+		std::vector<uint64_t> chunkCounts( chunkCount * 3, 0 );
+		ParallelFor::forEachChunk( chunkCount, ParallelFor::getThreadCount( rThreadCount ), [&]( uint64_t rChunkIdx ) {
+			std::vector<CompensatedSum>& sums = chunkSums[rChunkIdx];
+			sums.resize( rBinCount );
+			const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * CHUNK_SIZE, rFaceCount );
+			for( uint64_t faceIdx=rChunkIdx*CHUNK_SIZE; faceIdx<faceIdxEnd; faceIdx++ ) {
+				uint64_t     faceBins[BINS_PER_FACE_MAX];
+				unsigned int faceBinNr = 0;
+				double       faceValue = 0.0;
+				const eFaceState faceState = rFaceFunc( faceIdx, faceBins, faceBinNr, faceValue );
+				chunkCounts[rChunkIdx*3+faceState]++;
+				if( faceState != FACE_VALID ) {
+					continue;
+				}
+				for( unsigned int i=0; i<faceBinNr; i++ ) {
+					if( faceBins[i] < rBinCount ) {
+						sums[faceBins[i]].add( faceValue );
+					}
+				}
+			}
+		} );
+		sResult result;
+		mergePairwise( chunkSums, rBinCount, result.mSums );
+		countStates( chunkCounts, result );
+		return( result );
+	}
+}
+
+#endif // FACEREDUCTION_H
@@ -0,0 +1,76 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FEATUREVECDISTANCE_H
+#define FEATUREVECDISTANCE_H
+
+#include <cstdint>
+
+#include "featurevecmatrix.h"
+
+//!
+//! \brief Batched distances between a reference vector and all rows of a FeatureVecMatrix. (Layer 0)
+//!
+//! Replaces the loop calling the virtual Vertex::getFeatureDist*To per vertex.
+//! The rows are processed in chunks on multiple threads - see ParallelFor.
+//! On x86 CPUs supporting AVX2 four elements are processed at once,
+//! otherwise a scalar fallback is used, which computes exactly the same
+//! as the Vertex functions.
+//!
+//! Not-a-number elements propagate to the result as in the Vertex functions,
+//! except for the maximum norm, which ignores them, and the counting "norm",
+//! which counts them as non-zero - see Vertex::getFeatureVecPNorm.
+//!
+//! Layer 0
+//!
+
+namespace FeatureVecDistance {
+	//! Distance or similarity to compute.
+	enum eMetric {
+		METRIC_MANHATTAN,            //!< 1-norm - see Vertex::getFeatureDistManTo
+		METRIC_EUCLIDEAN,            //!< 2-norm - see Vertex::getFeatureDistEucTo
+		METRIC_EUCLIDEAN_NORMALIZED, //!< 2-norm divided by the standard deviation per element - see Vertex::getFeatureDistEucNormTo
+		METRIC_COSINE_SIMILARITY,    //!< Cosine similarity or its arccosine - see Vertex::getFeatureVecCosSim
+		METRIC_TANIMOTO,             //!< Tanimoto distance - see Vertex::getFeatureVecTanimotoDist
+		METRIC_PNORM                 //!< Weighted p-norm of the difference - see Vertex::getFeatureVecPNorm
+	};
+
+	//! Parameters for compute.
+	struct sParams {
+		eMetric       mMetric       = METRIC_EUCLIDEAN; //!< Distance to compute.
+		const double* mReference    = nullptr;          //!< Reference vector - required.
+		uint64_t      mReferenceLen = 0;                //!< Elements of mReference. Has to match the rows for METRIC_PNORM and must not be shorter otherwise.
+		const double* mStdDev       = nullptr;          //!< Standard deviation per element for METRIC_EUCLIDEAN_NORMALIZED.
+		const double* mWeights      = nullptr;          //!< Optional weight per element (numerator) for METRIC_PNORM.
+		double        mPNorm        = 2.0;              //!< p for METRIC_PNORM - infinity for the maximum norm and zero for counting non-zero elements.
+		bool          mApplyACos    = true;             //!< METRIC_COSINE_SIMILARITY returns the angle i.e. arccosine of the similarity.
+		unsigned int  mThreadCount  = 0;                //!< Number of threads - zero uses all available cores.
+		bool          mAllowSIMD    = true;             //!< Use AVX2, when supported by the CPU.
+	};
+
+	bool compute( const FeatureVecMatrix& rMatrix, const sParams& rParams, double* rDistances );
+
+	//! @returns true, when the CPU supports the AVX2 kernels.
+	bool hasAVX2();
+}
+
+#endif // FEATUREVECDISTANCE_H
@@ -0,0 +1,107 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FEATUREVECINDEX_H
+#define FEATUREVECINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "featurevecmatrix.h"
+
+//!
+//! \brief Approximate nearest neighbour index for the rows of a FeatureVecMatrix. (Layer 0)
+//!
+//! Inverted file (IVF) using the Euclidean distance: the rows are partitioned
+//! into lists by their nearest centroid. A query computes the distances to all
+//! centroids and scans only the rows of the nearest lists i.e. probes.
+//! More probes increase the recall at the cost of time.
+//!
+//! The centroids are trained by k-means on a random sample of the rows using
+//! a two level quantizer, so the build time grows with the square root of the
+//! number of lists instead of linear. Rows containing not-a-number are not indexed.
+//!
+//! The index stores only the centroids and the row numbers per list. The distances
+//! are computed using the matrix given to the queries, so they are exact and
+//! changes of the values reduce only the recall. The checksum stored within the
+//! file detects an index built for other feature vectors.
+//!
+//! Layer 0
+//!
+
+class FeatureVecIndex {
+
+	public:
+		//! Parameters for build.
+		struct sParams {
+			uint64_t     mListCount   = 0;      //!< Number of lists. Zero: square root of the number of rows.
+			unsigned int mIterations  = 8;      //!< Iterations of k-means.
+			uint64_t     mSampleCount = 65536;  //!< Rows used for training the centroids. Zero: all rows.
+			uint64_t     mSeed        = 5489;   //!< Seed for sampling - the same seed returns the same index.
+			unsigned int mThreadCount = 0;      //!< Number of threads - zero uses all available cores.
+		};
+
+		//! Row found by a query.
+		struct sResult {
+			uint64_t mRow;       //!< Row of the matrix.
+			double   mDistance;  //!< Euclidean distance to the reference.
+		};
+
+		FeatureVecIndex() = default;
+
+		void clear();
+		bool build( const FeatureVecMatrix& rMatrix, const sParams& rParams );
+
+		// Information
+		bool     isBuilt() const        { return( !mListOffsets.empty() ); }
+		bool     isBuiltFor( const FeatureVecMatrix& rMatrix ) const;
+		uint64_t getRowCount() const    { return( mRowCount ); }
+		uint64_t getColCount() const    { return( mColCount ); }
+		uint64_t getListCount() const   { return( mListOffsets.empty() ? 0 : mListOffsets.size() - 1 ); }
+		uint64_t getIndexedRowCount() const { return( mListRows.size() ); }
+		uint64_t getDefaultProbeCount() const;
+
+		// Queries - thread-safe.
+		bool queryKNN( const FeatureVecMatrix& rMatrix, const double* rReference, uint64_t rCount,
+		               uint64_t rProbeCount, std::vector<sResult>& rResults ) const;
+		bool queryRadius( const FeatureVecMatrix& rMatrix, const double* rReference, double rRadius,
+		                  uint64_t rProbeCount, std::vector<sResult>& rResults ) const;
+
+		// Persistence
+		bool writeFile( const std::filesystem::path& rFileName ) const;
+		bool readFile( const std::filesystem::path& rFileName, const FeatureVecMatrix& rMatrix );
+		static std::filesystem::path getFileNameFor( const std::filesystem::path& rFeatureVecFile );
+		static uint64_t computeChecksum( const FeatureVecMatrix& rMatrix, unsigned int rThreadCount = 0 );
+
+	private:
+		bool selectProbes( const double* rReference, uint64_t rProbeCount, std::vector<uint64_t>& rProbes ) const;
+
+		uint64_t              mRowCount = 0;  //!< Rows of the matrix used for building.
+		uint64_t              mColCount = 0;  //!< Columns of the matrix used for building.
+		uint64_t              mChecksum = 0;  //!< Checksum of the matrix used for building - see computeChecksum.
+		std::vector<double>   mCentroids;     //!< Centroid per list, row-major.
+		std::vector<uint64_t> mListOffsets;   //!< Begin of each list within mListRows plus the end of the last list.
+		std::vector<uint64_t> mListRows;      //!< Rows grouped by list, ascending within each list.
+};
+
+#endif // FEATUREVECINDEX_H
@@ -0,0 +1,152 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FEATUREVECMATRIX_H
+#define FEATUREVECMATRIX_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//!
+//! \brief Row-major matrix holding the feature vectors of all vertices. (Layer 0)
+//!
+//! Replaces the separate heap allocation per Vertex: each vertex refers to
+//! a row of this matrix, which is owned by the Mesh. All rows have the
+//! same length - shorter vectors are padded with not-a-number.
+//!
+//! For large datasets the elements can be stored with reduced precision
+//! i.e. float32 or float16 (IEEE 754 half), which reduces the memory by
+//! a factor of two or four. The values are converted to double on access,
+//! so the functions of the Vertex and Mesh classes work unchanged.
+//!
+//! Layer 0
+//!
+
+class FeatureVecMatrix {
+
+	public:
+		//! Storage type of the elements.
+		enum ePrecision {
+			PRECISION_DOUBLE, //!< 64-bit - default and lossless.
+			PRECISION_FLOAT,  //!< 32-bit - about 7 significant digits.
+			PRECISION_HALF    //!< 16-bit - about 3 significant digits and a maximum of 65504.
+		};
+
+		FeatureVecMatrix() = default;
+		explicit FeatureVecMatrix( ePrecision rPrecision );
+
+		// Setup:
+		void clear();
+		bool allocate( uint64_t rRowCount, uint64_t rColCount );
+		bool assign( const double* rValues, uint64_t rRowCount, uint64_t rColCount );
+		bool assign( std::vector<double>&& rValues, uint64_t rColCount );
+		bool setPrecision( ePrecision rPrecision );
+
+		// Information:
+		uint64_t   getRowCount() const  { return( mRowCount ); }
+		uint64_t   getColCount() const  { return( mColCount ); }
+		ePrecision getPrecision() const { return( mPrecision ); }
+		uint64_t   getMemorySize() const;
+
+		// Element access:
+		inline double get( uint64_t rRow, uint64_t rCol ) const;
+		inline void   set( uint64_t rRow, uint64_t rCol, double rValue );
+		bool          getRow( uint64_t rRow, double* rValues ) const;
+		bool          setRow( uint64_t rRow, const double* rValues, uint64_t rValueCount );
+		const double* getRowDouble( uint64_t rRow, std::vector<double>& rBuffer ) const;
+
+		// Raw data for bulk processing - only the one matching getPrecision() is non-empty:
+		const double*   getDataDouble() const { return( mDataDouble.data() ); }
+		const float*    getDataFloat() const  { return( mDataFloat.data() ); }
+		const uint16_t* getDataHalf() const   { return( mDataHalf.data() ); }
+
+		// Conversion of IEEE 754 half precision:
+		static inline float halfToFloat( uint16_t rHalf );
+		static uint16_t     floatToHalf( float rValue );
+
+	private:
+		ePrecision            mPrecision = PRECISION_DOUBLE; //!< Storage type - see ePrecision.
+		uint64_t              mRowCount  = 0;                //!< Number of rows i.e. vertices.
+		uint64_t              mColCount  = 0;                //!< Number of columns i.e. length of the feature vectors.
+		std::vector<double>   mDataDouble;                   //!< Elements for PRECISION_DOUBLE.
+		std::vector<float>    mDataFloat;                    //!< Elements for PRECISION_FLOAT.
+		std::vector<uint16_t> mDataHalf;                     //!< Elements for PRECISION_HALF.
+};
+
+//! Converts an IEEE 754 half to float including subnormals, infinity and not-a-number.
+inline float FeatureVecMatrix::halfToFloat( uint16_t rHalf ) {
+	const uint32_t sign     = static_cast<uint32_t>( rHalf & 0x8000 ) << 16;
+	const uint32_t exponent = ( rHalf >> 10 ) & 0x1F;
+	uint32_t       mantissa = rHalf & 0x03FF;
+	uint32_t bits;
+	if( exponent == 0x1F ) {
+		bits = sign | 0x7F800000 | ( mantissa << 13 ); // Infinity or not-a-number
+	} else if( exponent != 0 ) {
+		bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+	} else if( mantissa == 0 ) {
+		bits = sign; // Signed zero
+	} else {
+		// Subnormal half => normalized float
+		uint32_t shift = 0;
+		while( ( mantissa & 0x0400 ) == 0 ) {
+			mantissa <<= 1;
+			shift++;
+		}
+		bits = sign | ( ( 113 - shift ) << 23 ) | ( ( mantissa & 0x03FF ) << 13 );
+	}
+	float value;
+	std::memcpy( &value, &bits, sizeof( value ) );
+	return( value );
+}
+
+//! @returns the element at the given row and column. There is no range check.
+inline double FeatureVecMatrix::get( uint64_t rRow, uint64_t rCol ) const {
+	const uint64_t elementIdx = rRow * mColCount + rCol;
+	switch( mPrecision ) {
+		case PRECISION_FLOAT:
+			return( static_cast<double>( mDataFloat[elementIdx] ) );
+		case PRECISION_HALF:
+			return( static_cast<double>( halfToFloat( mDataHalf[elementIdx] ) ) );
+		default:
+			break;
+	}
+	return( mDataDouble[elementIdx] );
+}
+
+//! Sets the element at the given row and column. There is no range check.
+inline void FeatureVecMatrix::set( uint64_t rRow, uint64_t rCol, double rValue ) {
+	const uint64_t elementIdx = rRow * mColCount + rCol;
+	switch( mPrecision ) {
+		case PRECISION_FLOAT:
+			mDataFloat[elementIdx] = static_cast<float>( rValue );
+			return;
+		case PRECISION_HALF:
+			mDataHalf[elementIdx] = floatToHalf( static_cast<float>( rValue ) );
+			return;
+		default:
+			break;
+	}
+	mDataDouble[elementIdx] = rValue;
+}
+
+#endif // FEATUREVECMATRIX_H
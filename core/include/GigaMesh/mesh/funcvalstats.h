@@ -0,0 +1,86 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef FUNCVALSTATS_H
+#define FUNCVALSTATS_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+//!
+//! \brief Cached statistics of function values i.e. range, quantiles and histograms. (Layer 0)
+//!
+//! The finite values are packed into one array, when the statistics are built.
+//! Quantiles are selected without sorting by a parallel two-pass histogram:
+//! the first pass counts the values per bin to find the bin holding the
+//! requested rank and the second pass gathers only the values of this bin
+//! for std::nth_element. The result equals the element of the sorted values.
+//!
+//! Quantiles and histograms are cached, so repeated requests e.g. for the
+//! limits of a colour map are answered without touching the values again.
+//! The owner has to call clear(), when the values change.
+//!
+//! Not-a-number and infinite values are counted, but excluded from all statistics.
+//! Not thread-safe as the queries fill the caches.
+//!
+//! Layer 0
+//!
+
+class FuncValStats {
+
+	public:
+		FuncValStats() = default;
+
+		void clear();
+		bool build( const std::vector<double>& rValues, unsigned int rThreadCount = 0 );
+
+		// Information
+		bool     isBuilt() const          { return( mBuilt ); }
+		uint64_t getValueCount() const    { return( mValueCount ); }
+		uint64_t getFiniteCount() const   { return( mFiniteValues.size() ); }
+		uint64_t getNaNCount() const      { return( mNaNCount ); }
+		uint64_t getInfiniteCount() const { return( mValueCount - mFiniteValues.size() - mNaNCount ); }
+
+		// Statistics of the finite values
+		bool getMinMax( double& rMinVal, double& rMaxVal ) const;
+		bool getRank( uint64_t rRank, double& rValue );
+		bool getQuantile( double rQuantile, double& rValue, uint64_t* rRank = nullptr );
+		bool getHistogram( uint64_t rBinCount, std::vector<uint64_t>& rCounts );
+
+	private:
+		uint64_t getBin( double rValue, uint64_t rBinCount, double rBinLen ) const;
+
+		bool                mBuilt       = false;  //!< Flag set by build and cleared by clear.
+		unsigned int        mThreadCount = 0;      //!< Number of threads - zero uses all available cores.
+		uint64_t            mValueCount  = 0;      //!< Number of values given including not-a-number and infinite values.
+		uint64_t            mNaNCount    = 0;      //!< Number of not-a-number values.
+		std::vector<double> mFiniteValues;         //!< Finite values in the order given.
+		double              mMinVal      = 0.0;    //!< Minimum of the finite values.
+		double              mMaxVal      = 0.0;    //!< Maximum of the finite values.
+
+		std::map<uint64_t,double>                mRankCache;       //!< Value per rank requested.
+		std::map<uint64_t,std::vector<uint64_t>> mHistogramCache;  //!< Counts per number of bins requested.
+};
+
+#endif // FUNCVALSTATS_H
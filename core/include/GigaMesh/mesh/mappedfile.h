@@ -0,0 +1,66 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstdint>
+#include <filesystem>
+
+//!
+//! \brief Read-only memory mapping of a whole file. (Layer 0)
+//!
+//! The operating system loads the pages on demand, so large files can be
+//! parsed by multiple threads without copying them into a buffer first.
+//! Uses mmap on POSIX systems and a file mapping on Windows.
+//!
+//! Layer 0
+//!
+
+class MappedFile {
+
+	public:
+		MappedFile() = default;
+		explicit MappedFile( const std::filesystem::path& rFileName );
+		~MappedFile();
+
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+
+		bool open( const std::filesystem::path& rFileName );
+		void close();
+
+		bool        isOpen() const   { return( mIsOpen ); }
+		const char* getData() const  { return( mData ); }
+		uint64_t    getSize() const  { return( mSize ); }
+
+	private:
+		const char* mData   = nullptr;  //!< First byte of the file. Null for empty files.
+		uint64_t    mSize   = 0;        //!< Size of the file in bytes.
+		bool        mIsOpen = false;    //!< The file was opened - it may still be empty.
+#ifdef _WIN32
+		void*       mFileHandle    = nullptr;
+		void*       mMappingHandle = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
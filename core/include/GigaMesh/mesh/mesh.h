@@ -37,6 +37,14 @@
 #include <functional>
 
 #include "bitflagarray.h"
+#include "visitedset.h"
+#include "featurevecmatrix.h"
+#include "featurevecdistance.h"
+#include "featurevecindex.h"
+#include "funcvalstats.h"
+#include "meshcache.h"
+#include "unrollbatch.h"
+#include "colormaplut.h"
 #include "vertex.h"
 #include "face.h"
 #include "plane.h"
@@ -94,6 +102,8 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		// to be called after READING a file
 		void establishStructure( std::vector<sVertexProperties>& rVertexProps,
 		                         std::vector<sFaceProperties>& rFaceProps );
+		// to be called instead of READING a file, when a valid cache exists
+		bool establishStructureFromCache( const MeshCache& rMeshCache );
 
 	public:
 		// Octree
@@ -114,6 +124,17 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		// IO Operations - overloaded from MeshIO and MeshSeedExt
 		virtual bool     writeFile( const std::filesystem::path& rFileName );
 		        bool     writeFilesForConnectedComponents();
+		//! Result per component of Mesh::writeLabeledComponents.
+		struct sLabeledComponent {
+			uint64_t              mLabelNr     = 0;     //!< Label of the vertices of the component.
+			std::filesystem::path mFileName;            //!< Name of the file of the component.
+			uint64_t              mVertexCount = 0;     //!< Number of vertices written.
+			uint64_t              mFaceCount   = 0;     //!< Number of faces written.
+			bool                  mWritten     = false; //!< Flag set, when the file was written.
+			MeshInfoData          mMeshInfo;            //!< Information about the component - optional.
+		};
+		        bool     writeLabeledComponents( std::vector<sLabeledComponent>& rComponents, bool rWithMeshInfo );
+		        bool     writeMeshCache( const std::filesystem::path& rCacheFile );
 		virtual bool     importFeatureVectorsFromFile( const std::filesystem::path& rFileName );
 		virtual bool     exportFeatureVectors( const std::filesystem::path& rFileName );
 	private:
@@ -353,9 +374,14 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool    assignImportedNormalsToVertices( const std::vector<grVector3ID>& rNormals );
 		virtual bool    multiplyColorWithFuncVal();
 		virtual bool    multiplyColorWithFuncVal( const double rMin, const double rMax );
+				bool    setVertRGBFromFuncVal( const ColorMapLut& rColorMap );
 		virtual bool    assignAlphaToSelectedVertices(unsigned char alpha);
 
 		// feature vectors
+		        bool   assignFeatureVectors( const double* rFeatureVecs, uint64_t rMaxFeatVecLen );
+		        bool   assignFeatureVectors( FeatureVecMatrix&& rFeatureVecs );
+		        bool   setFeatureVecPrecision( FeatureVecMatrix::ePrecision rPrecision );
+		FeatureVecMatrix::ePrecision getFeatureVecPrecision() const;
 	protected:
 		virtual int    removeFeatureVectors();
 
@@ -385,6 +411,20 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool    estFeatureCosineSimToVertex( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount );
 				bool    estFeatureTanimotoDistTo( Primitive* rSomePrim, double** rFuncValues, Vertex*** rVertices, int* rVertCount );
 				bool    estFeatureTanimotoDistTo( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount );
+				bool    estFeatureVecDistances( const FeatureVecDistance::sParams& rParams, std::vector<double>& rDistances );
+		// Approximate nearest neighbours of a reference - see FeatureVecIndex
+				bool    buildFeatureVecIndex( const FeatureVecIndex::sParams& rParams );
+				bool    readFeatureVecIndex( const std::filesystem::path& rFileName );
+				bool    writeFeatureVecIndex( const std::filesystem::path& rFileName ) const;
+				bool    writeFeatureVecIndexFor( const std::filesystem::path& rFileNameFeatureVecs, bool rVertexIdInFirstCol,
+				                                 const FeatureVecIndex::sParams& rParams );
+				bool    estFeatureVecNeighbours( const std::vector<double>& rReference, uint64_t rMaxCount, double rMaxDistance,
+				                                 uint64_t rProbeCount, std::vector<std::pair<Vertex*,double>>& rNeighbours );
+				bool    selectVertsByFeatureVecSimilarity( const std::vector<double>& rReference, uint64_t rMaxCount, double rMaxDistance, uint64_t rProbeCount=0 );
+				bool    funcVertFeatureVecSimilarity( const std::vector<double>& rReference, uint64_t rMaxCount, double rMaxDistance, uint64_t rProbeCount=0 );
+	private:
+				bool    estFeatureVecDistancesToArray( FeatureVecDistance::sParams rParams, double** rFuncValues, Vertex*** rVertices, int* rVertCount );
+	public:
 		// Other feature vector related functions
 				bool    estFeatureAutoCorrelationVertex( double** funcValues, Vertex*** vertices, int* vertCount );
 				bool    estFeatureCorrelationVertex( Primitive* somePrim, double** funcValues, Vertex*** vertices, int* vertCount );
@@ -440,8 +480,8 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool         getPolyVertexCount( std::set<PolyLine*>* rSomePolyLines, unsigned int rMinNr, unsigned int rMaxNr );
 
 				std::set<Face*>   getNonManifoldFaces();
-				bool         getMeshVolumeDivergence( double& rVolumeDX, double& rVolumeDY, double& rVolumeDZ );
-				bool         compVolumePlane( double* rVolumePos, double* rVolumeNeg );
+				bool         getMeshVolumeDivergence( double& rVolumeDX, double& rVolumeDY, double& rVolumeDZ, uint64_t* rFacesDegenerate=nullptr );
+				bool         compVolumePlane( double* rVolumePos, double* rVolumeNeg, uint64_t* rFacesDegenerate=nullptr );
 
 		// Histogram:
 		virtual bool         getHistogramValues( eHistogramType rHistType, std::vector<unsigned int>* rNumArray, double* rValMin, double* rValMax );
@@ -483,15 +523,24 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool isolineToPolylineMultiple();
 		virtual bool isolineToPolyline();
 		virtual bool isolineToPolyline( double rIsoValue, Plane* rPlaneIntersect=nullptr );
+		virtual bool isolinesToPolylines( const std::vector<double>& rIsoValues, Plane* rPlaneIntersect=nullptr );
+		virtual bool planeIntersectionsToPolylines( const std::vector<Plane*>& rPlanes, const Vector3D* rAxisTop=nullptr, const Vector3D* rAxisBottom=nullptr );
+	private:
+		        bool tracePolylinesOfLevels( const std::vector<Plane*>& rPlanePerLevel,
+		                                     const std::function<void(uint64_t,std::vector<uint64_t>&)>& rGetCandidateFaces,
+		                                     const std::function<void(uint64_t,Face*,double*)>& rGetFaceValues );
+	public:
 		virtual bool extrudePolylines();
 				bool labelVertSurface( uint64_t& rlabelsNr, double** rArea );
 				bool labelFacesVert( std::set<Face*>** rLabelFaces, uint64_t& rlabelsNr );
+				bool labelFacesVertArea( std::vector<double>& rLabelAreas );
 		// -- Polylines --------------------------------------------------------------------------------------------------------------------------------
 		virtual void polyLinesChanged();
 		virtual bool removePolylinesAll();
 		virtual bool removePolylinesSelected();
 				void convertLabelBordersToPolylines();
 		virtual bool convertBordersToPolylines();
+				bool convertBordersToPolylinesParallel( uint64_t rChunkSize = 16384 );
 				void convertSelectedVerticesToPolyline();
 
 		// --- Function Values (FV, FuncVal ) ----------------------------------------------------------------------------------------------------------
@@ -569,6 +618,9 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		//! \todo source revision
 				bool   getFuncValuesMinMax( double& rMinVal, double& rMaxVal );
 				bool   getFuncValuesMinMaxQuantil( double rMinQuantil, double rMaxQuantil, double& rMinVal, double& rMaxVal );
+	private:
+				FuncValStats& getFuncValStats();
+	public:
 				bool   getFuncValuesMinMaxInfNanFail( double& rMinVal, double& rMaxVal, int& rInfCount, int& rNanCount, int& rFailCount );
 				bool   getFuncValuesMinMaxInfNanFail( double& rMinVal, double& rMaxVal, Vertex*& rVertMin, Vertex*& rVertMax, int& rInfCount, int& rNanCount, int& rFailCount, uint64_t& rFiniteCount );
 
@@ -576,6 +628,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool   changedMesh();
 		// --- Mesh manipulation - REMOVAL -------------------------------------------------------------------------------------------------------------
 		virtual bool   removeVertices( std::set<Vertex*>* verticesToRemove );    // removal of a list of vertices
+		        bool   removeVerticesMasked( const std::vector<uint8_t>& rRemoveMask ); // removal of flagged vertices
 		virtual bool   removeVerticesSelected();
 		        bool   removeUncleanSmall( const std::filesystem::path& rFileName, double rPercentArea, bool rApplyErosion );
 		private:
@@ -629,6 +682,8 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		        uint64_t getBitArrayVerts( uint64_t** rVertBitArray, eBitArrayFlags rInitFlags=BIT_ARRAY_MARK_NOTHING );
 				uint64_t getBitArrayFaces( uint64_t** rFaceBitArray, eBitArrayFlags rInitFlags=BIT_ARRAY_MARK_NOTHING );
 				uint64_t getBitArrayEdges( uint64_t** rEdgeBitArray );
+				void     getVisitedSetVerts( VisitedSet& rVertsVisited ) const;
+				void     getVisitedSetFaces( VisitedSet& rFacesVisited ) const;
 
 		// Estimate geodesic neighbourhood.
 		virtual bool       geodPatchVertSel(bool rWeightFuncVal, bool rGeodDistToFuncVal );
@@ -660,6 +715,12 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				                                  uint64_t rVertNrLongs, uint64_t* rVertBitArrayVisited,
 				                                  uint64_t rFaceNrLongs, uint64_t* rFaceBitArrayVisited,
 				                                  bool rOrderToFuncVal=false );
+				bool       fetchSphereBitArray( Vertex* rSeedVertex, std::vector<Face*>* rFacesInSphere, float rRadius,
+				                                VisitedSet& rVertsVisited, VisitedSet& rFacesVisited,
+				                                bool rOrderToFuncVal=false );
+				bool       fetchSphereBitArray1R( Vertex* rSeedVertex, std::vector<Face*>& rFacesInSphere, double rRadius,
+				                                  VisitedSet& rVertsVisited, VisitedSet& rFacesVisited,
+				                                  bool rOrderToFuncVal=false );
 
 			// Compute or estimate Multi-Scale Integral Invariants (MSII) ----------------------------------------------------------------------------------
 				double     fetchSphereCubeVolume25D( Vertex* seedVertex, std::set<Face*>*    facesInSphere, double radius, double* rasterArray, int cubeEdgeLengthInVoxels=256 );
@@ -688,6 +749,10 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		        Matrix4D rotateToZ( Vector3D directionVec );          // generate rotation matrix to transform mesh so that the given direction vector is paralllel to the z-axis
         virtual bool     applyTransformationToWholeMesh( Matrix4D rTrans, bool rResetNormals = true, bool rSaveTransMat = true );
         virtual bool     applyTransformation( Matrix4D rTrans, std::set<Vertex*>* rSomeVerts, bool rResetNormals = true, bool rSaveTransMat = true );
+    private:
+                bool     applyTransformationVerticesAll( const Matrix4D& rTrans, bool rResetNormals, bool rSaveTransMat );
+                bool     writeTransMatSideCar( Matrix4D rTrans );
+    public:
 		virtual bool     applyTransformationPlacement( eTranslate rType, Matrix4D* rAppliedMat=nullptr );
 		virtual bool     applyTransformationAxisToY( Matrix4D* rAppliedMat=nullptr );
 		virtual bool     applyTransformationDefaultViewMatrix( Matrix4D* rViewMatrix );
@@ -801,9 +866,13 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		//----------------------------------------------------------------------
 		std::vector<Face*>   mFaces;      //!< Faces of the Mesh.
 		// Optional pre-computed information:
-		//! \todo these values are only set, when a 3D-model is loaded, but NOT when feature vectors are added at a later time.
 		std::vector<double>        mVerticesFeatVecMean;   //!< Mean values of all the elements of feature std::vectors of the vertices.
 		std::vector<double>        mVerticesFeatVecStd;    //!< Standard deviation of all the elements of feature vectors of the vertices.
+		FeatureVecMatrix           mFeatureVecMatrix;      //!< Feature vectors of all vertices as one row-major matrix. The vertices refer to their rows.
+		FeatureVecIndex            mFeatureVecIndex;       //!< Nearest neighbour index of mFeatureVecMatrix. Built on demand.
+		FuncValStats               mFuncValStats;          //!< Statistics of the function values of the vertices. Built on demand - see getFuncValStats.
+		uint64_t                   mFuncValGeneration = 0;      //!< Incremented by the methods writing function values of the vertices and by changedVertFuncVal.
+		uint64_t                   mFuncValStatsGeneration = 0; //!< Generation of the function values used for mFuncValStats.
 
 		//----------------------------------------------------------------------
 		// Selection of points for a plane:
@@ -822,6 +891,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		coneStates  mConeStatus = CONE_UNDEFINED; //! Stores current status of cone selection
 
 	protected:
+		        uint64_t unrollVerticesBatch( const UnrollBatch& rUnrollBatch, std::vector<uint8_t>& rNotUnrolled );
 		virtual bool centerAroundCone( bool rResetNormals=true );
 		virtual bool unrollAroundCone( bool* rIsCylinderCase );
 		virtual bool unrollAroundCylinderRadius();
@@ -0,0 +1,137 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+
+//!
+//! \brief Native binary cache of a mesh for reloading without parsing. (Layer 0)
+//!
+//! Stores the arrays of a mesh as sections of a versioned binary file, which
+//! is memory-mapped for reading. Besides the per-vertex data (as structure of
+//! arrays) and the faces, the connectivity established by Mesh is stored:
+//! the faces adjacent to each vertex and the neighbours of each face, both
+//! in compressed sparse row (CSR) format. Therefore a Mesh can be set up
+//! without parsing and without searching for neighbouring faces.
+//!
+//! The cache is typically written as sidecar next to the source file - see
+//! getSidecarName. It is valid as long as the size and the modification time
+//! of the source match. When only the modification time differs, e.g. after
+//! copying, the hash of the contents of the source is compared instead.
+//!
+//! Sections are aligned to 64 bytes and stored in native byte order, which
+//! is part of the header, so caches of other systems are rejected.
+//!
+//! Layer 0
+//!
+
+class MeshCache {
+
+	public:
+		//! Usage of caches when meshes are constructed from files - see setMode.
+		enum eMode {
+			CACHE_OFF,         //!< Caches are neither read nor written.
+			CACHE_READ,        //!< Valid caches are used, but not written.
+			CACHE_READ_WRITE   //!< Valid caches are used. Otherwise they are written after reading the source.
+		};
+
+		//! Sections of the cache. The order is part of the format - append only and increase the version.
+		enum eSections {
+			SECTION_VERT_X,              //!< double per vertex.
+			SECTION_VERT_Y,              //!< double per vertex.
+			SECTION_VERT_Z,              //!< double per vertex.
+			SECTION_VERT_NORMAL_X,       //!< double per vertex.
+			SECTION_VERT_NORMAL_Y,       //!< double per vertex.
+			SECTION_VERT_NORMAL_Z,       //!< double per vertex.
+			SECTION_VERT_FUNCVAL,        //!< double per vertex.
+			SECTION_VERT_RGBA,           //!< Four uint8_t per vertex.
+			SECTION_VERT_LABEL,          //!< uint64_t per vertex.
+			SECTION_VERT_FLAGS,          //!< uint64_t per vertex.
+			SECTION_VERT_FTVEC,          //!< double times the feature vector length per vertex.
+			SECTION_VERT_FACES_OFFSET,   //!< uint64_t per vertex plus one: CSR offsets into SECTION_VERT_FACES.
+			SECTION_VERT_FACES,          //!< uint64_t indices of the faces adjacent to the vertices.
+			SECTION_FACE_VERTICES,       //!< Three uint64_t per face.
+			SECTION_FACE_FLAGS,          //!< uint64_t per face.
+			SECTION_FACE_NEIGHBOURS_OFFSET, //!< uint64_t per face plus one: CSR offsets into SECTION_FACE_NEIGHBOURS.
+			SECTION_FACE_NEIGHBOURS,     //!< int64_t indices of the neighbours per edge AB, BC, CA followed by non-manifold ones. -1 for none.
+			SECTION_META_STRINGS,        //!< Meta-data strings each as uint64_t length followed by the characters.
+			SECTION_COUNT                //!< Number of sections.
+		};
+
+		MeshCache() = default;
+
+		// Mode for constructing meshes
+		static void  setMode( eMode rMode );
+		static eMode getMode();
+		static std::filesystem::path getSidecarName( const std::filesystem::path& rSourceFile );
+
+		// Writing
+		void setCounts( uint64_t rVertexCount, uint64_t rFaceCount, uint64_t rFeatureVecLen );
+		void setSection( eSections rSection, const void* rData, uint64_t rByteCount );
+		bool write( const std::filesystem::path& rCacheFile, const std::filesystem::path& rSourceFile ) const;
+
+		// Reading
+		bool open( const std::filesystem::path& rCacheFile, const std::filesystem::path& rSourceFile );
+		void close();
+
+		uint64_t getVertexCount() const     { return( mVertexCount ); }
+		uint64_t getFaceCount() const       { return( mFaceCount ); }
+		uint64_t getFeatureVecLen() const   { return( mFeatureVecLen ); }
+
+		//! @returns the section as array of the given type and its number of elements. Null for empty sections.
+		template <typename T>
+		const T* getSection( eSections rSection, uint64_t& rCount ) const {
+			rCount = mSectionSizes[rSection] / sizeof( T );
+			return( reinterpret_cast<const T*>( mSectionData[rSection] ) );
+		}
+		//! @returns the section as array of the given type. rValid is cleared, when the number of elements is not as expected.
+		template <typename T>
+		const T* getSection( eSections rSection, uint64_t rCountExpected, bool& rValid ) const {
+			uint64_t elementCount = 0;
+			const T* sectionData = getSection<T>( rSection, elementCount );
+			rValid = rValid && ( elementCount == rCountExpected );
+			return( sectionData );
+		}
+
+	private:
+		static bool getSourceInfo( const std::filesystem::path& rSourceFile, uint64_t& rSize, int64_t& rModTime );
+		static bool getSourceHash( const std::filesystem::path& rSourceFile, uint64_t& rHash );
+
+		static std::atomic<int> mMode;                    //!< See eMode.
+
+		uint64_t    mVertexCount   = 0;                    //!< Number of vertices.
+		uint64_t    mFaceCount     = 0;                    //!< Number of faces.
+		uint64_t    mFeatureVecLen = 0;                    //!< Length of the feature vectors per vertex.
+		const void* mSectionData[SECTION_COUNT]  {};       //!< Data per section - either given for writing or within the mapped file.
+		uint64_t    mSectionSizes[SECTION_COUNT] {};       //!< Number of bytes per section.
+		MappedFile  mMappedFile;                           //!< Cache file, when opened.
+};
+
+#endif // MESHCACHE_H
@@ -26,6 +26,9 @@
 #include <GigaMesh/mesh/MeshIO/ModelMetaData.h>
 
 #include <list>
+#include <memory>
+
+class MeshWriter;
 
 //!
 //! \brief Class for handling file access. (Layer 0)
@@ -78,6 +81,10 @@ class MeshIO : public MeshSeedExt {
 		        bool writeFilePrimProps( const std::filesystem::path& rFileName,
 		                                 std::vector<sVertexProperties>& rVertexProps,
 		                                 std::vector<sFaceProperties>& rFaceProps );
+		        bool writeFilePrimPropsDetached( const std::filesystem::path& rFileName,
+		                                         const std::vector<sVertexProperties>& rVertexProps,
+		                                         const std::vector<sFaceProperties>& rFaceProps,
+		                                         MeshSeedExt& rMeshSeed ) const;
 
 	public:
 		ModelMetaData& getModelMetaDataRef();
@@ -90,6 +97,12 @@ class MeshIO : public MeshSeedExt {
 
 		virtual bool writeIcoNormalSphereData(const std::filesystem::path& rFilename, const std::list<sVertexProperties>& rVertexProps, int subdivisions, bool sphereCoordinates = false);
 
+	protected:
+		void setFileNameFull( const std::filesystem::path& rFileName );
+
+	private:
+		std::unique_ptr<MeshWriter> createWriter( const std::filesystem::path& rFileName ) const;
+
 	private:
 		std::array<bool, EXPORT_FLAG_COUNT>   mExportFlags; //!< Handles export options.
 		bool   mSystemIsBigEndian; //!< Flag for proper Byte ordering during write/read.
@@ -33,6 +33,8 @@
 // C++ includes:
 #include "gmcommon.h"
 
+class FeatureVecMatrix;
+
 struct PrimitiveInfo {
 	double mPosX;
 	double mPosY;
@@ -62,6 +64,7 @@ class MeshSeedExt {
 
 		// Import / Export - Feature Vectors
 		virtual bool importFeatureVectors( const std::filesystem::path& rFileName, uint64_t rNrVerticesMax, std::vector<double>& rFeatureVecs, uint64_t& rMaxFeatVecLen, bool rVertexIdInFirstCol );
+		        bool importFeatureVectors( const std::filesystem::path& rFileName, uint64_t rNrVerticesMax, FeatureVecMatrix& rFeatureVecs, bool rVertexIdInFirstCol );
 
 		// Feature std::vectors - STUB to be overloaded by Mesh
 		virtual uint64_t getFeatureVecLenMax( int rPrimitiveType );
@@ -0,0 +1,104 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NUMERICTABLE_H
+#define NUMERICTABLE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+class FeatureVecMatrix;
+
+//!
+//! \brief Multithreaded reader for ASCII tables of numbers. (Layer 0)
+//!
+//! Used for importing per-vertex data like function values, labels and
+//! feature vectors. The file is memory mapped (see MappedFile) and split into
+//! chunks at line breaks, which are parsed in parallel - see ParallelFor.
+//! Numbers are parsed independent of the locale i.e. the decimal separator is
+//! always a dot - see parseNumber.
+//!
+//! Lines starting with '#' are comments. Empty lines are ignored. The values
+//! are separated by spaces, tabs or commas. Lines may have different numbers
+//! of values - missing values are not-a-number. Tokens, which are not
+//! numbers, are not-a-number as well and counted - see getInvalidCount.
+//!
+//! The first column can hold an index e.g. of a vertex. For a given number of
+//! rows, the index determines the row, otherwise the index is stored per row.
+//! When an index occurs more than once, the last line of the file is used.
+//!
+//! Instead of the table of doubles, the values can be stored directly within
+//! a FeatureVecMatrix e.g. using float16, which avoids having all values in
+//! double precision in memory - see sParams::mMatrix.
+//!
+//! Layer 0
+//!
+
+class NumericTable {
+
+	public:
+		//! Parameters for read.
+		struct sParams {
+			bool              mFirstColIsIndex = false;   //!< The first column holds a non-negative integer index.
+			uint64_t          mRowCount        = 0;       //!< Rows of the table. Lines or indices outside are skipped. Zero: one row per line in the order of the file.
+			unsigned int      mThreadCount     = 0;       //!< Number of threads - zero uses all available cores.
+			FeatureVecMatrix* mMatrix          = nullptr; //!< Stores the values within this matrix using its precision instead of getValues.
+		};
+
+		NumericTable() = default;
+
+		void clear();
+		bool read( const std::filesystem::path& rFileName, const sParams& rParams );
+
+		// Table
+		uint64_t getRowCount() const       { return( mRowCount ); }
+		uint64_t getColCount() const       { return( mColCount ); }
+		uint64_t getColCountMin() const    { return( mColCountMin ); }
+		inline double get( uint64_t rRow, uint64_t rCol ) const { return( mValues[rRow*mColCount+rCol] ); }
+		const std::vector<double>& getValues() const { return( mValues ); }
+		void     swapValues( std::vector<double>& rValues );
+		bool     isRowGiven( uint64_t rRow ) const;
+		uint64_t getIndex( uint64_t rRow ) const;
+
+		// Statistics of the file
+		uint64_t getLineCount() const        { return( mLineCount ); }
+		uint64_t getInvalidCount() const     { return( mInvalidCount ); }
+		uint64_t getSkippedCount() const     { return( mSkippedCount ); }
+		uint64_t getFirstInvalidLine() const { return( mFirstInvalidLine ); }
+
+		static bool parseIndex( const char* rBegin, const char* rEnd, uint64_t& rIndex );
+
+	private:
+		uint64_t              mRowCount         = 0;  //!< Rows of the table.
+		uint64_t              mColCount         = 0;  //!< Maximum number of values per line excluding the index.
+		uint64_t              mColCountMin      = 0;  //!< Minimum number of values per line excluding the index.
+		std::vector<double>   mValues;                //!< Values, row-major. Not-a-number for missing and invalid values.
+		std::vector<uint8_t>  mRowGiven;              //!< Flag per row set by a line of the file - only for sParams::mRowCount larger zero.
+		std::vector<uint64_t> mIndices;               //!< Index per row - only for sParams::mFirstColIsIndex and sParams::mRowCount zero.
+		uint64_t              mLineCount        = 0;  //!< Lines of the file including comments.
+		uint64_t              mInvalidCount     = 0;  //!< Tokens, which are not numbers, including invalid indices.
+		uint64_t              mSkippedCount     = 0;  //!< Lines skipped because of an invalid index or outside of the rows.
+		uint64_t              mFirstInvalidLine = 0;  //!< Line number of the first invalid token starting with one. Zero: none.
+};
+
+#endif // NUMERICTABLE_H
@@ -0,0 +1,52 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstdint>
+#include <functional>
+
+//!
+//! \brief Minimal thread pool for loops over chunks of primitives. (Layer 0)
+//!
+//! The chunks are distributed dynamically to std::async workers using an
+//! atomic counter. The calling thread works as well. Results should be
+//! stored per chunk and merged in the order of the chunks afterwards,
+//! which keeps them independent of the number of threads.
+//!
+//! Layer 0
+//!
+
+namespace ParallelFor {
+	//! @returns the number of threads to use, when zero is given i.e. all available cores.
+	unsigned int getThreadCount( unsigned int rThreadCount = 0 );
+
+	//! @returns the number of chunks of the given size required to cover the given number of elements.
+	inline uint64_t getChunkCount( uint64_t rElementCount, uint64_t rChunkSize ) {
+		return( ( rElementCount + rChunkSize - 1 ) / rChunkSize );
+	}
+
+	void forEachChunk( uint64_t rChunkCount, unsigned int rThreadCount,
+	                   const std::function<void(uint64_t)>& rFunc );
+}
+
+#endif // PARALLELFOR_H
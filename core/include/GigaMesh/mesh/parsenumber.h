@@ -0,0 +1,86 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PARSENUMBER_H
+#define PARSENUMBER_H
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+//! Parses a number given as text independent of the locale i.e. the decimal separator is always a dot,
+//! so files can be read concurrently without changing the process-wide locale. Used by the readers of
+//! meshes, tables and feature vectors.
+//!
+//! The whole range has to be the number i.e. leading or trailing whitespace is not accepted.
+//! A single leading '+' is accepted as by strtod. Not-a-number and infinity are accepted for
+//! floating point values, which saturate like strtod, when out of range: infinity for large
+//! and zero for tiny magnitudes.
+//!
+//! @returns false, when the whole range is not a number.
+template<typename T>
+inline bool parseNumber( const char* rBegin, const char* rEnd, T& rValue ) {
+	const char* valueStart = rBegin;
+	if( ( valueStart < rEnd ) && ( *valueStart == '+' ) && ( ( valueStart + 1 == rEnd ) || ( valueStart[1] != '-' ) ) ) {
+		++valueStart;
+	}
+	if( valueStart >= rEnd ) {
+		return( false );
+	}
+	const std::from_chars_result result = std::from_chars( valueStart, rEnd, rValue );
+	if( result.ptr != rEnd ) {
+		return( false );
+	}
+	if constexpr( std::is_floating_point_v<T> ) {
+		if( result.ec == std::errc::result_out_of_range ) {
+			const char* exponent = std::find_if( valueStart, rEnd, []( char rChar ) { return( ( rChar == 'e' ) || ( rChar == 'E' ) ); } );
+			const bool  isTiny   = ( exponent != rEnd ) && ( exponent + 1 != rEnd ) && ( exponent[1] == '-' );
+			rValue = isTiny ? T( 0 ) : std::numeric_limits<T>::infinity();
+			if( *valueStart == '-' ) {
+				rValue = -rValue;
+			}
+			return( true );
+		}
+	}
+	return( result.ec == std::errc() );
+}
+
+//! Parses a whole string - see above.
+template<typename T>
+inline bool parseNumber( const std::string& rText, T& rValue ) {
+	return( parseNumber( rText.data(), rText.data() + rText.size(), rValue ) );
+}
+
+//! Parses a number like atof, i.e. zero is returned, when the text is not a number - see parseNumber.
+template<typename T>
+inline T parseNumberOrZero( const std::string& rText ) {
+	T value = T( 0 );
+	if( !parseNumber( rText, value ) ) {
+		return( T( 0 ) );
+	}
+	return( value );
+}
+
+#endif // PARSENUMBER_H
@@ -23,6 +23,7 @@
 #define POLYLINE_H
 
 #include <list>
+#include <deque>
 
 #include "primitive.h"
 #include "vertex.h"
@@ -132,7 +133,7 @@ class PolyLine : public Vertex {
 		void  dumpRunLenMat();
 
 	private:
-		std::vector<PolyEdge*> mEdgeList;     //!< List of Edgels of the polyline organized by a std::vector.
+		std::deque<PolyEdge*>  mEdgeList;     //!< List of Edgels of the polyline organized by a std::deque for constant time insertion at both ends.
 
 		Plane*            mPlaneUsed;    //!< For intersections i.e. profile lines: Rember the plane used to compute this polygonal line.
 };
@@ -0,0 +1,122 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RENDERORTHO_H
+#define RENDERORTHO_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gmcommon.h"
+#include "vector3d.h"
+
+class Mesh;
+
+//!
+//! \brief Headless CPU renderer for orthographic views of a Mesh. (Layer 2)
+//!
+//! Replacement for MeshWidget::screenshotViews on hosts without OpenGL.
+//! Uses the z-buffer approach of Mesh::rasterViewFromZ with a depth test:
+//! faces are binned into square tiles, which are rastered in parallel.
+//! One depth buffer of the size of the image is shared by all tiles. As each
+//! tile only writes its own region, no locking is required and the result
+//! does not depend on the number of threads.
+//!
+//! The per-vertex data (position, normal, colour) is fetched once within
+//! the constructor, so any number of views can be rendered afterwards.
+//! The mesh must not change in the meantime.
+//!
+//! Units are assumed to be millimeter as in MeshWidget::screenshotViews.
+//!
+//! Layer 2
+//!
+
+class RenderOrtho {
+
+	public:
+		//! Source of the colour per vertex.
+		enum eColoring {
+			COLOR_SOLID,         //!< Uniform colour - see sParams::mSolidRGB
+			COLOR_VERTEX_RGB,    //!< Colour per vertex e.g. from the 3D-scanner.
+			COLOR_FUNCTION_VALUE //!< Grayscale ramp of the function value per vertex.
+		};
+
+		//! Parameters for rendering.
+		struct sParams {
+			double       mDPI          = 300.0;            //!< Resolution in dots per inch assuming the mesh is given in mm.
+			unsigned int mTileSize     = 64;               //!< Edge length of a tile in pixels.
+			unsigned int mThreadCount  = 0;                //!< Number of threads - zero uses all available cores.
+			eColoring    mColoring     = COLOR_SOLID;      //!< Source of the colour.
+			bool         mLighting     = true;             //!< Lambertian shading with a light at the camera (headlight).
+			bool         mDepthOnly    = false;            //!< Render only the depth buffer e.g. for AmbientOcclusion - sImage::mRGB stays empty.
+			double       mFuncValMin   = _NOT_A_NUMBER_DBL_; //!< Lower limit for COLOR_FUNCTION_VALUE. Not-a-number: minimum of the mesh.
+			double       mFuncValMax   = _NOT_A_NUMBER_DBL_; //!< Upper limit for COLOR_FUNCTION_VALUE. Not-a-number: maximum of the mesh.
+			uint8_t      mSolidRGB[3]      { 200, 200, 200 }; //!< Colour for COLOR_SOLID and for vertices without finite function value.
+			uint8_t      mBackgroundRGB[3] { 255, 255, 255 }; //!< Colour of pixels not covered by the mesh.
+		};
+
+		//! Orthographic view defined by the direction towards the camera and the up vector.
+		struct sView {
+			std::string mName;       //!< Name used as part of the filename e.g. '03_ha_front'.
+			Vector3D    mToCamera;   //!< Direction from the mesh towards the camera.
+			Vector3D    mUp;         //!< Direction pointing upwards within the image.
+		};
+
+		//! Rendered image including its depth buffer and the mapping from world coordinates to pixels.
+		struct sImage {
+			uint64_t             mWidth  = 0;   //!< Width in pixels.
+			uint64_t             mHeight = 0;   //!< Height in pixels.
+			std::vector<uint8_t> mRGB;          //!< Colour per pixel, row major starting at the top left.
+			std::vector<float>   mDepth;        //!< Distance towards the camera per pixel. -Infinity for the background.
+			double               mDPI    = 0.0; //!< Resolution in dots per inch.
+			Vector3D             mAxisX;        //!< Direction of the image x-axis in world coordinates.
+			Vector3D             mAxisY;        //!< Direction of the image y-axis (upwards) in world coordinates.
+			Vector3D             mAxisZ;        //!< Direction towards the camera in world coordinates.
+			double               mMinX   = 0.0; //!< Left border along mAxisX in world coordinates.
+			double               mMaxY   = 0.0; //!< Top border along mAxisY in world coordinates.
+			double               mPixelsPerUnit = 0.0; //!< Scale from world coordinates to pixels.
+
+			bool project( const Vector3D& rPosition, double& rPixelX, double& rPixelY, double& rDepth ) const;
+			bool writePNG( const std::filesystem::path& rFileName ) const;
+		};
+
+		explicit RenderOrtho( Mesh* rMesh );
+
+		bool render( const sView& rView, const sParams& rParams, sImage& rImage ) const;
+
+		static std::vector<sView> getSixViews();
+
+		// Vertex data fetched by the constructor
+		const std::vector<double>& getPositions() const { return( mPositions ); }
+		const std::vector<float>&  getNormals() const   { return( mNormals ); }
+
+	private:
+		//! Vertex data in world coordinates fetched once.
+		std::vector<double>   mPositions;   //!< x, y, z per vertex.
+		std::vector<float>    mNormals;     //!< Normalized x, y, z per vertex.
+		std::vector<uint8_t>  mVertexRGB;   //!< Red, green, blue per vertex.
+		std::vector<double>   mFuncVals;    //!< Function value per vertex.
+		std::vector<uint64_t> mFaceVerts;   //!< Indices of the three vertices per face.
+};
+
+#endif // RENDERORTHO_H
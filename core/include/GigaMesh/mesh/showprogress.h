@@ -23,6 +23,7 @@
 #define SHOWPROGRESS_H
 
 #include <string>
+#include <chrono>
 
 class ShowProgress
 {
@@ -36,8 +37,8 @@ class ShowProgress
 
 	private:
 		std::string        mPrefix;              //!< Prefix for messages.
-		time_t             mProgressStarted;     //!< Timestamp, when the progress bar was started.
-		time_t             mLastTimeStamp;       //!< Timestamp of the last call of ShowProgress::showProgress;
+		std::chrono::steady_clock::time_point mProgressStarted;  //!< Timestamp, when the progress bar was started. Wall-clock, as clock() sums the CPU time of all threads.
+		std::chrono::steady_clock::time_point mLastTimeStamp;    //!< Timestamp of the last call of ShowProgress::showProgress;
 };
 
 #endif // SHOWPROGRESS_H
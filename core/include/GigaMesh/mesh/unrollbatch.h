@@ -0,0 +1,78 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef UNROLLBATCH_H
+#define UNROLLBATCH_H
+
+#include <cstdint>
+
+//!
+//! \brief Batch unrolling of positions around a cone, cylinder or sphere. (Layer 0)
+//!
+//! Applies the projections of Vertex::unrollAroundCone, Vertex::unrollAroundCylinderRadius
+//! and Vertex::unrollAroundSphere to contiguous coordinate arrays in parallel chunks.
+//! The constants of the surface are computed once by the factory methods, while the
+//! arithmetic per position is identical to the per-vertex methods, so both give the
+//! same coordinates.
+//!
+//! Positions, which can not be unrolled i.e. outside the cut heights of the cone,
+//! are left untouched and flagged within a byte mask.
+//!
+//! Layer 0
+//!
+
+class UnrollBatch {
+
+	public:
+		enum eSurface {
+			UNROLL_CONE,            //!< Truncated cone around the y-axis.
+			UNROLL_CYLINDER_RADIUS, //!< Infinite cylinder with a given radius around the y-axis.
+			UNROLL_SPHERE           //!< Sphere centered in the origin i.e. equirectangular projection.
+		};
+
+		static UnrollBatch cone( double rCutHeight1, double rCutHeight2, double rConeAngle, double rPrimeMeridian );
+		static UnrollBatch cylinderRadius( double rRadius, double rPrimeMeridian );
+		static UnrollBatch sphere( double rPrimeMeridian, double rSphereRadius );
+
+		eSurface getSurface() const { return( mSurface ); }
+
+		uint64_t apply( double* rPosX, double* rPosY, double* rPosZ, uint8_t* rFailed, uint64_t rCount, unsigned int rThreadCount = 0 ) const;
+
+	private:
+		explicit UnrollBatch( eSurface rSurface );
+
+		bool unrollCone( double& rPosX, double& rPosY, double& rPosZ ) const;
+		void unrollCylinderRadius( double& rPosX, double& rPosY, double& rPosZ ) const;
+		void unrollSphere( double& rPosX, double& rPosY, double& rPosZ ) const;
+
+		eSurface mSurface;                    //!< Type of surface to unroll around.
+		double   mPrimeMeridian        = 0.0; //!< Offset of the prime meridian defining the cutting position.
+		double   mRadius               = 0.0; //!< Radius of the cylinder or the sphere.
+		double   mHeightMin            = 0.0; //!< Lower clipping height of the cone.
+		double   mHeightMax            = 0.0; //!< Upper clipping height of the cone.
+		double   mHalfPiMinusConeAngle = 0.0; //!< Angle between the cone's surface and the xz-plane.
+		double   mSinConeAngle         = 0.0; //!< Sine of the cone's angle - zero for the degenerated cylinder case.
+};
+
+#endif // UNROLLBATCH_H
@@ -23,6 +23,7 @@
 #define VERTEX_H
 
 #include "primitive.h"
+#include "featurevecmatrix.h"
 
 #include <deque>
 #include <map>
@@ -33,6 +34,7 @@
 class Face;
 struct s1RingSectorPrecomp;
 class EdgeGeodesic;
+class VisitedSet;
 
 //!
 //! \brief Class for the most basic element of a mesh. (Layer 0)
@@ -52,6 +54,15 @@ class Vertex : public Primitive {
 			RGB_TO_GRAY_HSV_DECOMPOSITION,
 		};
 
+		//! Results of the mesh checks of the 1-ring - see get1RingChecks.
+		struct s1RingChecks {
+			bool mBorder         = false; //!< see isBorder
+			bool mNonManifold    = false; //!< see isNonManifold
+			bool mDoubleCone     = false; //!< see isDoubleCone
+			bool mPartOfZeroFace = false; //!< see isPartOfZeroFace
+			bool mInverse        = false; //!< see isInverse
+		};
+
 		// Const- & destructor:
 		Vertex();
 		Vertex( const int rSetIdx, const sVertexProperties& rSetProps );
@@ -70,6 +81,8 @@ class Vertex : public Primitive {
 		        bool     markVisited( uint64_t* rVertBitArrayVisited );
 				bool     unmarkVisited( uint64_t* rVertBitArrayVisited );
 				bool     isMarked(const uint64_t* rVertBitArrayVisited );
+		        bool     markVisited( VisitedSet& rVertsVisited );
+		        bool     isMarked( const VisitedSet& rVertsVisited ) const;
 
 		// Color managment:
 		bool     setRGB( unsigned char setTexR, unsigned char setTexG, unsigned char setTexB ) override;
@@ -144,6 +157,11 @@ virtual bool     setAlpha(unsigned char alpha);
 				                          uint64_t* faceBitArrayVisited, bool rOrderToFuncVal=false, double* rSeqNr=nullptr );
 		virtual bool     mark1RingVisited( uint64_t* rVertBitArrayVisited, uint64_t* rFaceBitArrayVisited, // ***
 		                                   bool           rOrderToFuncVal,      double*        rSeqNr );
+		virtual Vertex*  advanceInSphere( double* sphereCenter, double radius, // ***
+		                                  VisitedSet& rVertsVisited, std::vector<Vertex*>* nextArray,
+		                                  VisitedSet& rFacesVisited, bool rOrderToFuncVal=false, double* rSeqNr=nullptr );
+		virtual bool     mark1RingVisited( VisitedSet& rVertsVisited, VisitedSet& rFacesVisited, // ***
+		                                   bool        rOrderToFuncVal, double* rSeqNr );
 		// Function value:
 				bool     setFuncValue( double  setVal ) override;
 				bool     getFuncValue( double* rGetVal ) const override;
@@ -182,6 +200,7 @@ virtual bool     setAlpha(unsigned char alpha);
 		
 		// Transformation:
 		        bool     applyTransfrom( Matrix4D* transMat ) override;
+		        void     applyTransfromArray( const double* rTransMat );
 		        bool     applyMeltingSphere( double rRadius, double rRel=1.0 ) override;
         virtual Vertex*  applyNormalShift(float offsetDistance,int index);
 
@@ -193,6 +212,7 @@ virtual bool     setAlpha(unsigned char alpha);
 		virtual void     getNeighbourVertices( std::set<Vertex*>* someVertList ); // ***
 		        bool     getNeighbourVerticesExcluding( std::set<Vertex*>* neighboursSelected, std::set<Vertex*>* verticesToExclude );
 		virtual bool     getAdjacentVerticesExcluding( std::vector<Vertex*>* rSomeVerts, uint64_t* rVertBitArrayVisited ); // ***
+		virtual bool     getAdjacentVerticesExcluding( std::vector<Vertex*>* rSomeVerts, VisitedSet& rVertsVisited ); // ***
 		virtual Vertex*  getAdjacentNextBorderVertex( uint64_t* rVertBitArrayUnVisited ); // ***
 		virtual Vertex*  getConnection( std::set<Vertex*>* someVertList, bool reverse ); // ***
 
@@ -215,6 +235,7 @@ virtual bool     setAlpha(unsigned char alpha);
 		virtual bool     isDoubleCone();          // checks for a vertex as tip of two cones (as this annoys labeling) // ***
 		virtual bool     isPartOfZeroFace();      // checks if the vertex belongs to face having an area of zero // ***
 		virtual bool     isInverse();             // check if this vertex is part of an edge connecting faces with improper orientation // ***
+		virtual bool     get1RingChecks( s1RingChecks& rChecks ); // all of the above with a single pass of the 1-ring // ***
 		        int      getState();
 
 		// Distances
@@ -252,6 +273,8 @@ virtual bool     setAlpha(unsigned char alpha);
 				bool     assignFeatureVecValues( const std::vector<double>& newFeatureVec );
 				bool     copyFeatureVecTo( double* rFetchFeatureVec ) const override;
 				bool     getFeatureVectorElements( std::vector<double>& rFeatVec ) const override;
+				bool     setFeatureVecView( FeatureVecMatrix* rFeatureVecMatrix, uint64_t rRow );
+				bool     isFeatureVecView( const FeatureVecMatrix* rFeatureVecMatrix, uint64_t* rRow=nullptr ) const;
 		// Norm of the feature vector inlcuding related functions
 		virtual bool     getFeatureVecMeanStdDev( double* rFeatureVecMean, double* rFeatureVecStdDev ) const;
 		virtual bool     getFeatureVecLenMan( double* rFeatureVecLenMan );
@@ -310,8 +333,14 @@ private:
 		// Labeling:
 		uint64_t      mLabelNr;          //!< Number of a label of connected mesh part. Label 0 means background. Default: _PRIMITIVE_NOT_LABLED_
 		// Feature vector:
-		unsigned int  mFeatureVecLen;    //!< Length of the Feature vector (e.g. from multi-scale volume integral)
-		double*       mFeatureVec;       //!< Feature vector (e.g. from multi-scale volume integral)
+		FeatureVecMatrix* mFeatureVecMatrix; //!< Matrix holding the feature vector (e.g. from multi-scale volume integral). Typically owned by the Mesh.
+		uint64_t          mFeatureVecRow;    //!< Row of the feature vector within mFeatureVecMatrix.
+		bool              mFeatureVecOwned;  //!< True, when mFeatureVecMatrix was allocated for this vertex only i.e. it is not a view into the matrix of the Mesh.
+
+		// Feature vector helpers:
+		unsigned int  getFeatureVecLenFast() const;
+		const double* getFeatureVecDouble( std::vector<double>& rBuffer ) const;
+		void          releaseFeatureVec();
 };
 
 // GLOBAL Operators ------------------------------------------------------------
@@ -47,6 +47,11 @@ class VertexOfFace : public Vertex {
 		                                  uint64_t* faceBitArrayVisited, bool rOrderToFuncVal=false, double* rSeqNr=NULL );
 		virtual bool     mark1RingVisited( uint64_t* rVertBitArrayVisited, uint64_t* rFaceBitArrayVisited, // ***
 		                                   bool           rOrderToFuncVal,      double*        rSeqNr );
+		virtual Vertex*  advanceInSphere( double* sphereCenter, double radius, // ***
+		                                  VisitedSet& rVertsVisited, std::vector<Vertex*>* nextArray,
+		                                  VisitedSet& rFacesVisited, bool rOrderToFuncVal=false, double* rSeqNr=nullptr );
+		virtual bool     mark1RingVisited( VisitedSet& rVertsVisited, VisitedSet& rFacesVisited, // ***
+		                                   bool        rOrderToFuncVal, double* rSeqNr );
 
 		// Function value:
 		virtual bool     isFuncValLocalMinimum(); // ***
@@ -69,11 +74,13 @@ class VertexOfFace : public Vertex {
 		// Neighbourhood - related to labeling!
 		virtual void     getNeighbourVertices( std::set<Vertex*>* someVertList ); // ***
 		virtual bool     getAdjacentVerticesExcluding( std::vector<Vertex*>* rSomeVerts, uint64_t* rVertBitArrayVisited ); // ***
+		virtual bool     getAdjacentVerticesExcluding( std::vector<Vertex*>* rSomeVerts, VisitedSet& rVertsVisited ); // ***
 		virtual Vertex*  getAdjacentNextBorderVertex( uint64_t* rVertBitArrayUnVisited ); // ***
 		virtual Vertex*  getConnection( std::set<Vertex*>* someVertList, bool reverse ); // ***
 
 		// Mesh setup:
 		virtual void     connectToFace( Face* someFace ); // ***
+		        void     setAdjacentFaces( Face* const* rFaces, int rCount );
 		virtual void     disconnectFace( Face* someFace ); // ***
 		virtual bool     isAdjacent( Face* someFace ); // ***
 		virtual void     getFaces( Vertex* otherVert, std::set<Face*>* neighbourFaces, Face* callingFace ); // ***
@@ -90,6 +97,7 @@ class VertexOfFace : public Vertex {
 		virtual bool     isDoubleCone();          // checks for a vertex as tip of two cones (as this annoys labeling) // ***
 		virtual bool     isPartOfZeroFace();      // checks if the vertex belongs to face having an area of zero // ***
 		virtual bool     isInverse();             // check if this vertex is part of an edge connecting faces with improper orientation // ***
+		virtual bool     get1RingChecks( s1RingChecks& rChecks ); // all of the above with a single pass of the 1-ring // ***
 
 		// Debuging:
 		virtual void     dumpInfo(); // ***
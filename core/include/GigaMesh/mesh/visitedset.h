@@ -0,0 +1,92 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VISITEDSET_H
+#define VISITEDSET_H
+
+#include <cstdint>
+#include <vector>
+
+//!
+//! \brief Reusable set of visited primitives for local traversals. (Layer 0)
+//!
+//! Replacement for the bit arrays of Mesh::getBitArrayVerts and
+//! Mesh::getBitArrayFaces, when many small neighbourhoods are fetched
+//! one after another e.g. for MSII.
+//!
+//! Each element stores the generation (epoch) in which it was marked.
+//! VisitedSet::clear starts a new generation, which resets the set in
+//! O(1) instead of O(size). The indices marked within the current
+//! generation are kept in a sparse list, so the visited primitives can
+//! be enumerated in O(patch).
+//!
+//! Not thread-safe - use one instance per thread.
+//!
+//! Layer 0
+//!
+
+class VisitedSet {
+
+	public:
+		VisitedSet() = default;
+		explicit VisitedSet( uint64_t rElementCount );
+
+		        void     resize( uint64_t rElementCount );
+		        uint64_t size() const;
+		        void     clear();
+
+		//! Marks the element with the given index as visited.
+		//! @returns the previous state i.e. true, when it was already marked.
+		inline bool mark( uint64_t rIdx ) {
+			if( mStamps[rIdx] == mGeneration ) {
+				return( true );
+			}
+			mStamps[rIdx] = mGeneration;
+			mMarked.push_back( rIdx );
+			return( false );
+		}
+
+		//! Removes the mark of the element with the given index.
+		//! Remark: the index stays within VisitedSet::getMarked until the next clear.
+		//! @returns the previous state i.e. true, when it was marked.
+		inline bool unmark( uint64_t rIdx ) {
+			const bool wasMarked = ( mStamps[rIdx] == mGeneration );
+			mStamps[rIdx] = 0;
+			return( wasMarked );
+		}
+
+		//! @returns true, when the element with the given index is marked in the current generation.
+		inline bool isMarked( uint64_t rIdx ) const {
+			return( mStamps[rIdx] == mGeneration );
+		}
+
+		//! @returns the indices marked since the last clear in the order they were marked.
+		inline const std::vector<uint64_t>& getMarked() const {
+			return( mMarked );
+		}
+
+	private:
+		std::vector<uint32_t> mStamps;         //!< Generation an element was marked last. Zero is never a valid generation.
+		std::vector<uint64_t> mMarked;         //!< Sparse list of the elements marked within the current generation.
+		uint32_t              mGeneration = 1; //!< Current generation.
+};
+
+#endif // VISITEDSET_H
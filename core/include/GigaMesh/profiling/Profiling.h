@@ -0,0 +1,108 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+
+// Hierarchical wall-clock profiling of the core algorithms.
+// Recording is disabled by default. When disabled, a scoped timer costs a single relaxed atomic load.
+// Events are stored in per-thread buffers and can be written as Chrome trace JSON,
+// which can be viewed with chrome://tracing or https://ui.perfetto.dev
+//
+// Example usage:
+//     void Mesh::someAlgorithm() {
+//         PROFILE_SCOPE( "Mesh::someAlgorithm" );
+//         ...
+//         PROFILE::counter( "vertices processed", vertCount );
+//     }
+//
+// ATTENTION: names have to be string literals (or have static storage duration) as only the pointer is stored.
+
+namespace PROFILE {
+	//! Flag checked by the inline functions - use setEnabled() to change it.
+	extern std::atomic<bool> gEnabled;
+
+	//! @returns true, when events are recorded.
+	inline bool isEnabled() {
+		return gEnabled.load( std::memory_order_relaxed );
+	}
+
+	//! Enable or disable recording of events.
+	void setEnabled( bool rEnable );
+
+	//! Monotonic wall-clock in nanoseconds since the start of the program.
+	uint64_t nowNs();
+
+	//! Record a complete event (i.e. a span) for the calling thread.
+	void addSpan( const char* rName, uint64_t rStartNs, uint64_t rEndNs );
+
+	//! Record a counter value for the calling thread, when recording is enabled.
+	void counter( const char* rName, double rValue );
+
+	//! Removes all recorded events.
+	void clear();
+
+	//! Writes all recorded events as Chrome trace JSON.
+	//! @returns false in case of an error.
+	bool writeChromeTrace( const std::filesystem::path& rFileName );
+
+	//! Writes the total, count and maximum wall-clock time per span name in plain text.
+	void writeSummary( std::ostream& rOutput );
+
+	//! @returns the total wall-clock time of the recorded spans with the given name in nanoseconds.
+	//! Typically used by benchmarks to time a scope nested within a larger call.
+	uint64_t getSpanTotalNs( const char* rName );
+
+	//! Enables recording and writes the Chrome trace as well as a summary to std::cout,
+	//! when the program exits. Typically called for the --profile-trace option of the CLI tools.
+	void setTraceFileAtExit( const std::filesystem::path& rFileName );
+
+	//! Records the wall-clock time between construction and destruction as a span.
+	class ScopedTimer {
+		public:
+			explicit ScopedTimer( const char* rName )
+			    : mName( rName ), mStartNs( isEnabled() ? nowNs() : 0 ) {
+			}
+			~ScopedTimer() {
+				if( mStartNs != 0 ) {
+					addSpan( mName, mStartNs, nowNs() );
+				}
+			}
+			ScopedTimer( const ScopedTimer& ) = delete;
+			ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+		private:
+			const char* mName;     //!< Name of the span - string literal.
+			uint64_t    mStartNs;  //!< Start time or zero, when recording was disabled at construction.
+	};
+}
+
+#define PROFILE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+//! Times the enclosing scope - see PROFILE::ScopedTimer
+#define PROFILE_SCOPE( rName ) PROFILE::ScopedTimer PROFILE_CONCAT( profileScopedTimer, __LINE__ )( rName )
+
+#endif // PROFILING_H
@@ -22,6 +22,9 @@
 
 #include "MeshWriter.h"
 
+#include <algorithm>
+#include <GigaMesh/mesh/parallelfor.h>
+
 MeshWriter::MeshWriter()
 {
 
@@ -81,3 +84,47 @@ void MeshWriter::setExportVertFlags(bool exportVertFlags)
 {
 	mExportVertFlags = exportVertFlags;
 }
+
+//! Encodes elements as text in parallel chunks and writes them in the order of the elements.
+//!
+//! The chunks are processed in waves, so the text buffers are bounded by a few chunks
+//! per thread and are reused from wave to wave.
+//!
+//! @returns false in case of an error of the stream. True otherwise.
+bool MeshWriter::writeChunksOrdered(
+                std::ostream& rStream,                                              //!< Stream to write to.
+                uint64_t      rElementCount,                                        //!< Number of elements to encode.
+                const std::function<void(uint64_t,uint64_t,std::string&)>& rEncode  //!< Appends the text of the elements [begin,end) to the buffer.
+) {
+	const uint64_t     chunkSize     = 16384; // Elements per task.
+	const unsigned int threadCount   = ParallelFor::getThreadCount();
+	const uint64_t     chunkCount    = ParallelFor::getChunkCount( rElementCount, chunkSize );
+	const uint64_t     chunksPerWave = 4 * static_cast<uint64_t>( threadCount );
+	std::vector<std::string> chunkTexts( std::min( chunksPerWave, chunkCount ) );
+	for( uint64_t waveStart=0; waveStart<chunkCount; waveStart+=chunksPerWave ) {
+		const uint64_t waveChunks = std::min( chunksPerWave, chunkCount - waveStart );
+		ParallelFor::forEachChunk( waveChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			std::string& chunkText = chunkTexts[rChunkIdx];
+			chunkText.clear();
+			const uint64_t elementIdxBegin = ( waveStart + rChunkIdx ) * chunkSize;
+			rEncode( elementIdxBegin, std::min( elementIdxBegin + chunkSize, rElementCount ), chunkText );
+		} );
+		for( uint64_t chunkIdx=0; chunkIdx<waveChunks; chunkIdx++ ) {
+			rStream.write( chunkTexts[chunkIdx].data(), chunkTexts[chunkIdx].size() );
+		}
+	}
+	return( rStream.good() );
+}
+
+//! Path of a texture file relative to the directory of the mesh file to be written.
+//! Relative texture paths are considered relative to this directory.
+//!
+//! Does not change the current working directory, so meshes can be written concurrently.
+std::string MeshWriter::getTexturePathRelative(
+                const std::filesystem::path& rTextureFile,
+                const std::filesystem::path& rMeshFile
+) {
+	const std::filesystem::path meshDir = std::filesystem::absolute( rMeshFile ).parent_path();
+	const std::filesystem::path textureFile = rTextureFile.is_relative() ? ( meshDir / rTextureFile ) : rTextureFile;
+	return( std::filesystem::relative( textureFile, meshDir ).string() );
+}
@@ -22,7 +22,11 @@
 #ifndef MESHWRITER_H
 #define MESHWRITER_H
 
+#include <charconv>
+#include <functional>
+#include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <GigaMesh/mesh/meshseedext.h>
 #include <GigaMesh/mesh/MeshIO/ModelMetaData.h>
@@ -47,10 +51,31 @@ class MeshWriter
 		void setExportTextureCoordinates(bool exportTextureCoordinates);
 		void setExportVertFlags(bool exportVertFlags);
 
+		static std::string getTexturePathRelative( const std::filesystem::path& rTextureFile,
+		                                           const std::filesystem::path& rMeshFile );
+
+		//! Appends a number as text formatted like std::ostream with default settings,
+		//! i.e. %g with six significant digits for floating point values.
+		//! Independent of the locale - also used by PlyStreamConverter.
+		template<typename T>
+		static void appendNumber( std::string& rBuffer, const T rValue ) {
+			char digits[32];
+			std::to_chars_result result;
+			if constexpr( std::is_floating_point_v<T> ) {
+				result = std::to_chars( digits, digits + sizeof( digits ), rValue, std::chars_format::general, 6 );
+			} else {
+				result = std::to_chars( digits, digits + sizeof( digits ), rValue );
+			}
+			rBuffer.append( digits, result.ptr );
+		}
+
 	private:
 		ModelMetaData mModelMetaData;
 
 	protected:
+		static bool writeChunksOrdered( std::ostream& rStream, uint64_t rElementCount,
+		                                const std::function<void(uint64_t,uint64_t,std::string&)>& rEncode );
+
 		bool mExportVertColor = false;
 		bool mExportVertFeatureVector = false;
 		bool mExportBinary = false;
@@ -27,6 +27,7 @@
 #include <filesystem>
 
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/mesh/parsenumber.h>
 
 enum class MtlToken {
 	NEWMTL,
@@ -147,7 +148,7 @@ void parseColorValue(std::stringstream& sStream, std::array<float,3>& color)
 	else
 	{
 		//if no option is given, the first string is the r component
-		color[0] = std::stof(option);
+		color[0] = parseNumberOrZero<float>(option);
 		sStream >> color[1];
 		sStream >> color[2];
 	}
@@ -278,7 +279,7 @@ bool MtlParser::parseFile(const std::filesystem::path& fileName)
 					}
 					else
 					{
-						currentMaterial->d = std::stof(option);
+						currentMaterial->d = parseNumberOrZero<float>(option);
 					}
 				}
 					break;
@@ -26,13 +26,13 @@
 #include <sstream>
 #include <iterator>
 #include <algorithm>
-#include <clocale>
 #include <list>
 #include <filesystem>
 #include <map>
 
 #include "MtlParser.h"
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/mesh/parsenumber.h>
 using namespace std;
 
 struct ObjVertexPosition {
@@ -134,9 +134,9 @@ inline ObjVertexPosition parseVertexProperty(const std::vector<std::string>& tok
 	ObjVertexPosition vertex;
 	if(tokens.size() >= 4)
 	{
-		vertex.x = std::stod(tokens[1]);
-		vertex.y = std::stod(tokens[2]);
-		vertex.z = std::stod(tokens[3]);
+		vertex.x = parseNumberOrZero<double>(tokens[1]);
+		vertex.y = parseNumberOrZero<double>(tokens[2]);
+		vertex.z = parseNumberOrZero<double>(tokens[3]);
 	}
 	if(tokens.size() > 6)
 	{
@@ -146,7 +146,7 @@ inline ObjVertexPosition parseVertexProperty(const std::vector<std::string>& tok
 	}
 
 	if( ( tokens.size() == 5 ) || ( tokens.size() == 8 ) ) { // There is function value at the end of the line
-		vertex.funcVal = std::stod(tokens.back());
+		vertex.funcVal = parseNumberOrZero<double>(tokens.back());
 	}
 
 	return vertex;
@@ -157,9 +157,9 @@ inline ObjNormal parseNormalProperty(const std::vector<std::string>& tokens)
 	ObjNormal normal;
 	if(tokens.size() >= 4)
 	{
-		normal.x = std::stod(tokens[1]);
-		normal.y = std::stod(tokens[2]);
-		normal.z = std::stod(tokens[3]);
+		normal.x = parseNumberOrZero<double>(tokens[1]);
+		normal.y = parseNumberOrZero<double>(tokens[2]);
+		normal.z = parseNumberOrZero<double>(tokens[3]);
 	}
 
 	return normal;
@@ -170,8 +170,8 @@ inline ObjTexCoord parseTextureCoordinate(const std::vector<std::string>& tokens
 	ObjTexCoord texCoord;
 	if(tokens.size() >= 3)
 	{
-		texCoord.s = std::stof(tokens[1]);
-		texCoord.t = std::stof(tokens[2]);
+		texCoord.s = parseNumberOrZero<float>(tokens[1]);
+		texCoord.t = parseNumberOrZero<float>(tokens[2]);
 	}
 
 	return texCoord;
@@ -272,9 +272,6 @@ inline void copyObjToMeshProperties(const std::vector<ObjVertexPosition>& objVer
 //! see .OBJ specification: http://local.wasp.uwa.edu.au/~pbourke/dataformats/obj/
 bool ObjReader::readFile(const std::filesystem::path &rFilename, std::vector<sVertexProperties> &rVertexProps, std::vector<sFaceProperties> &rFaceProps, MeshSeedExt& rMeshSeed)
 {
-	char* oldLocale = std::setlocale( LC_NUMERIC, nullptr );
-	std::setlocale( LC_NUMERIC, "C" );
-
 	// commmon variables for internal use
 	string line;
 	string linePrefix;
@@ -295,15 +292,13 @@ bool ObjReader::readFile(const std::filesystem::path &rFilename, std::vector<sVe
 	ifstream fp( rFilename );
 	if( !fp.is_open() ) {
 		LOG::error() << "[ObjReader::" << __FUNCTION__ << "] Could not open file: '" << rFilename << "'.\n";
-		std::setlocale( LC_NUMERIC, oldLocale );
-
 		return false;
 	}
 
 	LOG::info() << "[ObjReader::" << __FUNCTION__ << "] File opened: '" << rFilename << "'.\n";
 
-	std::filesystem::path prevRootPath = std::filesystem::current_path();
-	std::filesystem::current_path(std::filesystem::absolute(rFilename).parent_path());
+	// Relative paths e.g. of material libraries refer to the directory of the file.
+	const std::filesystem::path fileDir = std::filesystem::absolute(rFilename).parent_path();
 
 	// determine the amount of data by parsing the data for a start:
 	while( fp >> linePrefix ) {
@@ -408,7 +403,7 @@ bool ObjReader::readFile(const std::filesystem::path &rFilename, std::vector<sVe
 
 				if(filePath.is_relative())
 				{
-					fileName = std::filesystem::absolute(filePath).string();
+					fileName = (fileDir / filePath).string();
 				}
 
 				MtlParser parser;
@@ -565,7 +560,5 @@ bool ObjReader::readFile(const std::filesystem::path &rFilename, std::vector<sVe
 
 	const auto timeStop  = clock();
 	LOG::debug() << "[ObjReader::" << __FUNCTION__ << "] fetch data from file:       " << static_cast<float>( timeStop - timeStart ) / CLOCKS_PER_SEC << " seconds."  << "\n";
-	std::setlocale( LC_NUMERIC, oldLocale );
-	std::filesystem::current_path(prevRootPath);
 	return true;
 }
@@ -26,7 +26,6 @@
 #include <locale>
 #include <filesystem>
 #include <map>
-#include <list>
 
 #include <GigaMesh/logging/Logging.h>
 
@@ -45,9 +44,6 @@ void writeMTL(const std::vector<std::filesystem::path>& textureFiles, const std:
 	}
 
 
-	auto prevPath = std::filesystem::current_path();
-	std::filesystem::current_path(std::filesystem::absolute(fileName).parent_path());
-
 	unsigned short texId = 0;
 	for(const auto& textureFile : textureFiles)
 	{
@@ -55,10 +51,9 @@ void writeMTL(const std::vector<std::filesystem::path>& textureFiles, const std:
 		filestr << "Kd 1.0 1.0 1.0\n";
 		filestr << "d 1.0\n";
 		filestr << "illum 1\n";
-		filestr << "map_Kd " << std::filesystem::relative(textureFile).string() << "\n\n";
+		filestr << "map_Kd " << MeshWriter::getTexturePathRelative( textureFile, fileName ) << "\n\n";
 	}
 
-	std::filesystem::current_path(prevPath);
 	filestr.close();
 }
 
@@ -143,10 +138,7 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 	{
 		for(const auto& texName : MeshWriter::getModelMetaDataRef().getTexturefilesRef())
 		{
-			auto prevPath = std::filesystem::current_path();
-			std::filesystem::current_path(std::filesystem::absolute(rFilename).parent_path());
-			filestr << "# TextureFile " << std::filesystem::relative(texName).string() << "\n";
-			std::filesystem::current_path(prevPath);
+			filestr << "# TextureFile " << getTexturePathRelative( texName, rFilename ) << "\n";
 		}
 
 		filestr << "mtllib " << rFilename.stem().string() << ".mtl\n";
@@ -157,17 +149,28 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 	filestr << "# Vertices: " << '\n';
 	filestr << "#-------------------------------------------------------------------------------" << '\n';
 
-	for( const auto& vertexProp : rVertexProps) {
-		filestr << "v ";
-		filestr << vertexProp.mCoordX  << " ";
-		filestr << vertexProp.mCoordY  << " ";
-		filestr << vertexProp.mCoordZ  << " ";
-		filestr << static_cast<unsigned short>( vertexProp.mColorRed ) << " ";
-		filestr << static_cast<unsigned short>( vertexProp.mColorGrn ) << " ";
-		filestr << static_cast<unsigned short>( vertexProp.mColorBle ) << " ";
-		filestr << vertexProp.mFuncVal << " ";
-		filestr << "\n";
-	}
+	// The lines of vertices and faces are formatted in parallel chunks using std::to_chars
+	// and written in order - see MeshWriter::writeChunksOrdered.
+	writeChunksOrdered( filestr, rVertexProps.size(), [&rVertexProps]( uint64_t rVertIdxBegin, uint64_t rVertIdxEnd, std::string& rText ) {
+		for( uint64_t vertIdx=rVertIdxBegin; vertIdx<rVertIdxEnd; vertIdx++ ) {
+			const sVertexProperties& vertexProp = rVertexProps[vertIdx];
+			rText += "v ";
+			appendNumber( rText, vertexProp.mCoordX );
+			rText += ' ';
+			appendNumber( rText, vertexProp.mCoordY );
+			rText += ' ';
+			appendNumber( rText, vertexProp.mCoordZ );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorRed ) );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorGrn ) );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorBle ) );
+			rText += ' ';
+			appendNumber( rText, vertexProp.mFuncVal );
+			rText += " \n";
+		}
+	} );
 
 	//!TODO: write texture coordinates as vec2 into set, to avoid duplicates
 	if(mExportTextureCoordinates)
@@ -176,15 +179,18 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 		filestr << "# TextureCoordinates: " << '\n';
 		filestr << "#-------------------------------------------------------------------------------" << '\n';
 
-		for(const auto& faceProp : rFaceProps)
-		{
-			for(size_t i = 0; i<faceProp.textureCoordinates.size(); i+=2)
-			{
-				filestr << "vt ";
-				filestr << faceProp.textureCoordinates[i * 2    ] << " ";
-				filestr << faceProp.textureCoordinates[i * 2 + 1] << "\n";
+		writeChunksOrdered( filestr, rFaceProps.size(), [&rFaceProps]( uint64_t rFaceIdxBegin, uint64_t rFaceIdxEnd, std::string& rText ) {
+			for( uint64_t faceIdx=rFaceIdxBegin; faceIdx<rFaceIdxEnd; faceIdx++ ) {
+				const std::vector<float>& texCoords = rFaceProps[faceIdx].textureCoordinates;
+				for( size_t i = 0; i+1<texCoords.size(); i+=2 ) {
+					rText += "vt ";
+					appendNumber( rText, texCoords[i] );
+					rText += ' ';
+					appendNumber( rText, texCoords[i + 1] );
+					rText += '\n';
+				}
 			}
-		}
+		} );
 	}
 
 	filestr << "#-------------------------------------------------------------------------------" << '\n';
@@ -195,34 +201,48 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 		filestr << "# NONE present i.e. point cloud" << '\n';
 	}
 
-	if(MeshWriter::getModelMetaDataRef().getTexturefilesRef().empty())
-	{
-		unsigned int texIndex = 1;
-		for(const auto & rFaceProp : rFaceProps) {
-			// OBJs start with ONE!
-			filestr << "f";
-
-			if(mExportTextureCoordinates)
-			{
-				for(auto vertIndex : rFaceProp.vertexIndices)
-				{
-					filestr << " " <<  vertIndex + 1 << "/" << texIndex++;
-				}
+	// Writes the faces in the given order. The texture coordinates are referenced
+	// per corner, so their index is the running count of the corners starting with ONE.
+	auto writeFaces = [this,&filestr]( const std::vector<const sFaceProperties*>& rFacesToWrite, const std::string& rFacePrefix ) {
+		std::vector<uint64_t> texIndexStart;
+		if( mExportTextureCoordinates ) {
+			texIndexStart.resize( rFacesToWrite.size() );
+			uint64_t texIndex = 1;
+			for( uint64_t i=0; i<rFacesToWrite.size(); i++ ) {
+				texIndexStart[i] = texIndex;
+				texIndex += rFacesToWrite[i]->vertexIndices.size();
 			}
-			else
-			{
-				for(auto vertIndex : rFaceProp.vertexIndices)
-				{
-					filestr << " " <<  vertIndex + 1;
+		}
+		writeChunksOrdered( filestr, rFacesToWrite.size(), [&]( uint64_t rFaceIdxBegin, uint64_t rFaceIdxEnd, std::string& rText ) {
+			for( uint64_t i=rFaceIdxBegin; i<rFaceIdxEnd; i++ ) {
+				// OBJs start with ONE!
+				rText += rFacePrefix;
+				uint64_t texIndex = mExportTextureCoordinates ? texIndexStart[i] : 0;
+				for( const uint64_t vertIndex : rFacesToWrite[i]->vertexIndices ) {
+					rText += ' ';
+					appendNumber( rText, vertIndex + 1 );
+					if( mExportTextureCoordinates ) {
+						rText += '/';
+						appendNumber( rText, texIndex++ );
+					}
 				}
+				rText += '\n';
 			}
-			filestr << "\n";
+		} );
+	};
+
+	if(MeshWriter::getModelMetaDataRef().getTexturefilesRef().empty())
+	{
+		std::vector<const sFaceProperties*> facesToWrite( rFaceProps.size() );
+		for( uint64_t faceIdx=0; faceIdx<rFaceProps.size(); faceIdx++ ) {
+			facesToWrite[faceIdx] = &rFaceProps[faceIdx];
 		}
+		writeFaces( facesToWrite, "f" );
 	}
 
 	else
 	{
-		std::map<unsigned short, std::list<const sFaceProperties*>> facesPerTextureLists;
+		std::map<unsigned short, std::vector<const sFaceProperties*>> facesPerTextureLists;
 
 		for(const auto& rFaceProp : rFaceProps)
 		{
@@ -232,28 +252,7 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 		for(const auto& textureListPair : facesPerTextureLists)
 		{
 			filestr << "usemtl Material_" << std::to_string(static_cast<unsigned short>(textureListPair.first)) << '\n';
-
-			unsigned int texIndex = 1;
-			for(const auto & rFaceProp : textureListPair.second) {
-				// OBJs start with ONE!
-				filestr << "f ";
-
-				if(mExportTextureCoordinates)
-				{
-					for(auto vertIndex : rFaceProp->vertexIndices)
-					{
-						filestr << " " <<  vertIndex + 1 << "/" << texIndex++;
-					}
-				}
-				else
-				{
-					for(auto vertIndex : rFaceProp->vertexIndices)
-					{
-						filestr << " " <<  vertIndex + 1;
-					}
-				}
-				filestr << "\n";
-			}
+			writeFaces( textureListPair.second, "f " );
 		}
 	}
 	filestr << "#-------------------------------------------------------------------------------" << '\n';
@@ -26,10 +26,10 @@
 #include <iterator>   // istream_iterator
 #include <algorithm>
 #include <cctype>
-#include <clocale>
 #include "PlyEnums.h"
 
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/mesh/parsenumber.h>
 
 using uint = unsigned int;
 
@@ -54,18 +54,6 @@ struct PlyContainer {
 
 ePlyPropertySize plyParseTypeStr( char* propType );
 
-/*
- * Helper class to set and restore locale in RAII fashion
- */
-class LocaleGuard {
-	public:
-		LocaleGuard() {mOldLocale = std::setlocale(LC_NUMERIC, nullptr); std::setlocale(LC_NUMERIC, "C");}
-		~LocaleGuard() {std::setlocale(LC_NUMERIC, mOldLocale.c_str());}
-
-	private:
-		std::string mOldLocale;
-};
-
 void copyVertexTexCoordsToFaces(const std::vector<float>& vertexTextureCoordinates, std::vector<sFaceProperties>& rFaceProps)
 {
 	for(auto & prop : rFaceProps)
@@ -118,30 +106,30 @@ bool parseAscii(const std::array<uint64_t, PLY_SECTIONS_COUNT>& plyElements, std
 			ePlyProperties currProperty = sectionProps[PLY_VERTEX].propertyType[ i ];
 			switch( currProperty ) {
 				case PLY_COORD_X:
-					rVertexProps[ verticesRead ].mCoordX = atof( lineElement.c_str() );
+					rVertexProps[ verticesRead ].mCoordX = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_COORD_Y:
-					rVertexProps[ verticesRead ].mCoordY = atof( lineElement.c_str() );
+					rVertexProps[ verticesRead ].mCoordY = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_COORD_Z:
-					rVertexProps[ verticesRead ].mCoordZ = atof( lineElement.c_str() );
+					rVertexProps[ verticesRead ].mCoordZ = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_VERTEX_NORMAL_X:
-					rVertexProps[ verticesRead ].mNormalX = atof(lineElement.c_str() );
+					rVertexProps[ verticesRead ].mNormalX = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_VERTEX_NORMAL_Y:
-					rVertexProps[ verticesRead ].mNormalY = atof(lineElement.c_str() );
+					rVertexProps[ verticesRead ].mNormalY = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_VERTEX_NORMAL_Z:
-					rVertexProps[ verticesRead ].mNormalZ = atof(lineElement.c_str() );
+					rVertexProps[ verticesRead ].mNormalZ = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_VERTEX_TEXCOORD_S:
 					if(!vertexTextureCoordinates.empty())
-						vertexTextureCoordinates[ verticesRead * 2] = static_cast<float>(atof(lineElement.c_str()));
+						vertexTextureCoordinates[ verticesRead * 2] = static_cast<float>(parseNumberOrZero<double>( lineElement ));
 					break;
 				case PLY_VERTEX_TEXCOORD_T:
 					if(!vertexTextureCoordinates.empty())
-						vertexTextureCoordinates[ verticesRead * 2 + 1] = static_cast<float>(atof(lineElement.c_str()));
+						vertexTextureCoordinates[ verticesRead * 2 + 1] = static_cast<float>(parseNumberOrZero<double>( lineElement ));
 					break;
 				case PLY_FLAGS:
 					rVertexProps[ verticesRead ].mFlags = static_cast<unsigned long>(atoi( lineElement.c_str() ));
@@ -150,7 +138,7 @@ bool parseAscii(const std::array<uint64_t, PLY_SECTIONS_COUNT>& plyElements, std
 					rVertexProps[ verticesRead ].mLabelId = static_cast<unsigned long>(atoi( lineElement.c_str() ));
 					break;
 				case PLY_VERTEX_QUALITY:
-					rVertexProps[ verticesRead ].mFuncVal = atof( lineElement.c_str() );
+					rVertexProps[ verticesRead ].mFuncVal = parseNumberOrZero<double>( lineElement );
 					break;
 				case PLY_VERTEX_INDEX:
 					break;
@@ -252,7 +240,7 @@ bool parseAscii(const std::array<uint64_t, PLY_SECTIONS_COUNT>& plyElements, std
 						rFaceProps[facesRead].textureCoordinates.shrink_to_fit();
 						for(int j = 0; j < elementCount; ++j)
 						{
-							rFaceProps[facesRead].textureCoordinates[j] = static_cast<float>(atof(tokens[++i].c_str()));
+							rFaceProps[facesRead].textureCoordinates[j] = static_cast<float>(parseNumberOrZero<double>( tokens[++i] ));
 						}
 				    } break;
 				case PLY_FACE_TEXNUMBER:
@@ -301,22 +289,22 @@ bool parseAscii(const std::array<uint64_t, PLY_SECTIONS_COUNT>& plyElements, std
             ePlyProperties currProperty = *currPropertyIt;
             switch( currProperty ) {
                 case PLY_COORD_X:
-                    primInfo.mPosX = atof( lineElement.c_str() );
+                    primInfo.mPosX = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_COORD_Y:
-                    primInfo.mPosY = atof( lineElement.c_str() );
+                    primInfo.mPosY = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_COORD_Z:
-                    primInfo.mPosZ = atof( lineElement.c_str() );
+                    primInfo.mPosZ = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_VERTEX_NORMAL_X:
-                    primInfo.mNormalX = atof( lineElement.c_str() );
+                    primInfo.mNormalX = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_VERTEX_NORMAL_Y:
-                    primInfo.mNormalY = atof( lineElement.c_str() );
+                    primInfo.mNormalY = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_VERTEX_NORMAL_Z:
-                    primInfo.mNormalZ = atof( lineElement.c_str() );
+                    primInfo.mNormalZ = parseNumberOrZero<double>( lineElement );
                     break;
                 case PLY_LABEL:
                     rMeshSeed.getPolyLabelIDRef().push_back( atoi( lineElement.c_str() ) );
@@ -756,8 +744,6 @@ bool PlyReader::readFile(const std::filesystem::path& rFilename,
 
 	bool    readASCII = false;
 
-	const LocaleGuard guard;
-
 	const auto timeStart = clock(); // for performance mesurement
 
 	std::cout << "[PlyReader::" << __FUNCTION__ << "] opening: '" << rFilename << "'\n";
@@ -0,0 +1,696 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/MeshIO/PlyStreamConverter.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PlyEnums.h"
+#include "PlyWriter.h"
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/parsenumber.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Data types of the PLY specification.
+	enum eDataType {
+		TYPE_UNDEF,
+		TYPE_INT8,
+		TYPE_UINT8,
+		TYPE_INT16,
+		TYPE_UINT16,
+		TYPE_INT32,
+		TYPE_UINT32,
+		TYPE_FLOAT32,
+		TYPE_FLOAT64
+	};
+
+	//! @returns the data type for a type string of the header - see also plyParseTypeStr of the PlyReader.
+	eDataType parseDataType( const string& rTypeStr ) {
+		if( rTypeStr == "int8"    || rTypeStr == "char"   ) { return( TYPE_INT8 );    }
+		if( rTypeStr == "uint8"   || rTypeStr == "uchar"  ) { return( TYPE_UINT8 );   }
+		if( rTypeStr == "int16"   || rTypeStr == "short"  ) { return( TYPE_INT16 );   }
+		if( rTypeStr == "uint16"  || rTypeStr == "ushort" ) { return( TYPE_UINT16 );  }
+		if( rTypeStr == "int32"   || rTypeStr == "int"    ) { return( TYPE_INT32 );   }
+		if( rTypeStr == "uint32"  || rTypeStr == "uint"   ) { return( TYPE_UINT32 );  }
+		if( rTypeStr == "float32" || rTypeStr == "float"  ) { return( TYPE_FLOAT32 ); }
+		if( rTypeStr == "float64" || rTypeStr == "double" ) { return( TYPE_FLOAT64 ); }
+		return( TYPE_UNDEF );
+	}
+
+	//! @returns the number of bytes of a data type within a binary PLY.
+	size_t getDataTypeSize( eDataType rType ) {
+		switch( rType ) {
+			case TYPE_INT8:
+			case TYPE_UINT8:   return( 1 );
+			case TYPE_INT16:
+			case TYPE_UINT16:  return( 2 );
+			case TYPE_INT32:
+			case TYPE_UINT32:
+			case TYPE_FLOAT32: return( 4 );
+			case TYPE_FLOAT64: return( 8 );
+			default:           return( 0 );
+		}
+	}
+
+	//! Property of an element as given by the header.
+	struct sProperty {
+		ePlyProperties mProperty  = PLY_UNSUPPORTED;  //!< Meaning - only the ones required for legacy PLYs are used.
+		eDataType      mType      = TYPE_UNDEF;       //!< Type of the value or of the list elements.
+		eDataType      mCountType = TYPE_UNDEF;       //!< Type of the number of list elements - undefined for single values.
+	};
+
+	//! Element as given by the header.
+	struct sElement {
+		ePlySections      mSection = PLY_SECTION_UNSUPPORTED;
+		uint64_t          mCount   = 0;
+		vector<sProperty> mProperties;
+	};
+
+	//! Vertex as written to a legacy PLY.
+	struct sVertex {
+		double  mPos[3]    { _NOT_A_NUMBER_DBL_, _NOT_A_NUMBER_DBL_, _NOT_A_NUMBER_DBL_ };
+		double  mQuality   = 0.0;                  // Default of the PlyReader.
+		double  mNormal[3] { 0.0, 0.0, 0.0 };
+		uint8_t mRGB[3]    { 187, 187, 187 };      // Default of the PlyReader.
+	};
+
+	//! Vertices or faces passed from the reader to the writer.
+	struct sChunk {
+		ePlySections     mSection = PLY_VERTEX;
+		vector<sVertex>  mVertices;
+		vector<uint8_t>  mFaceSizes;    //!< Number of vertices per face.
+		vector<uint32_t> mFaceIndices;  //!< Indices of the vertices of all faces.
+
+		void clear( ePlySections rSection ) {
+			mSection = rSection;
+			mVertices.clear();
+			mFaceSizes.clear();
+			mFaceIndices.clear();
+		}
+	};
+
+	//! Bounded queue of chunks. Blocks, when empty. Closed by the producer or aborted in case of an error.
+	class ChunkQueue {
+		public:
+			void push( sChunk* rChunk ) {
+				{
+					lock_guard<mutex> lock( mMutex );
+					mChunks.push_back( rChunk );
+				}
+				mCondition.notify_one();
+			}
+			//! @returns nullptr, when closed and empty or aborted.
+			sChunk* pop() {
+				unique_lock<mutex> lock( mMutex );
+				mCondition.wait( lock, [this]{ return( mAborted || mClosed || !mChunks.empty() ); } );
+				if( mAborted || mChunks.empty() ) {
+					return( nullptr );
+				}
+				sChunk* chunk = mChunks.front();
+				mChunks.pop_front();
+				return( chunk );
+			}
+			void close() {
+				{
+					lock_guard<mutex> lock( mMutex );
+					mClosed = true;
+				}
+				mCondition.notify_all();
+			}
+			void abort() {
+				{
+					lock_guard<mutex> lock( mMutex );
+					mAborted = true;
+				}
+				mCondition.notify_all();
+			}
+		private:
+			mutex              mMutex;
+			condition_variable mCondition;
+			deque<sChunk*>     mChunks;
+			bool               mClosed  = false;
+			bool               mAborted = false;
+	};
+
+	//! Reads the data section of a PLY in blocks.
+	class PlyDataReader {
+		public:
+			PlyDataReader( ifstream& rStream, bool rASCII, bool rReverseByteOrder, uint64_t rVertexCount )
+			    : mStream( rStream ), mASCII( rASCII ), mReverseByteOrder( rReverseByteOrder ), mVertexCount( rVertexCount ) {
+				mBuffer.resize( 1 << 20 );
+			}
+
+			//! Reads one element. Values of unused properties are skipped.
+			bool readElement( const sElement& rElement, sVertex* rVertex, vector<uint8_t>* rFaceSizes, vector<uint32_t>* rFaceIndices ) {
+				if( mASCII ) {
+					if( !nextLine() ) {
+						return( false );
+					}
+				}
+				for( const sProperty& currProp : rElement.mProperties ) {
+					if( currProp.mCountType != TYPE_UNDEF ) {
+						double listCount = 0.0;
+						if( !readValue( currProp.mCountType, listCount ) || !( listCount >= 0.0 ) || ( listCount != std::floor( listCount ) ) ) {
+							LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Invalid list length " << listCount << "!\n";
+							return( false );
+						}
+						const uint64_t listLen = static_cast<uint64_t>( listCount );
+						const bool     isFace  = ( rFaceSizes != nullptr ) && ( currProp.mProperty == PLY_LIST_VERTEX_INDICES );
+						if( isFace ) {
+							if( listLen > UINT8_MAX ) {
+								LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Face with " << listLen << " vertices!\n";
+								return( false );
+							}
+							rFaceSizes->push_back( static_cast<uint8_t>( listLen ) );
+						}
+						for( uint64_t i=0; i<listLen; i++ ) {
+							double listValue = 0.0;
+							if( !readValue( currProp.mType, listValue ) ) {
+								return( false );
+							}
+							if( isFace ) {
+								// Negative, fractional or not-a-number indices as well as indices beyond the vertices are rejected.
+								if( !( listValue >= 0.0 ) || ( listValue >= static_cast<double>( mVertexCount ) ) ||
+								    ( listValue != std::floor( listValue ) ) ) {
+									LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Invalid vertex index " << listValue
+									             << " for " << mVertexCount << " vertices!\n";
+									return( false );
+								}
+								rFaceIndices->push_back( static_cast<uint32_t>( listValue ) );
+							}
+						}
+						continue;
+					}
+					double value = 0.0;
+					if( !readValue( currProp.mType, value ) ) {
+						return( false );
+					}
+					if( rVertex == nullptr ) {
+						continue;
+					}
+					switch( currProp.mProperty ) {
+						case PLY_COORD_X:         rVertex->mPos[0]    = value; break;
+						case PLY_COORD_Y:         rVertex->mPos[1]    = value; break;
+						case PLY_COORD_Z:         rVertex->mPos[2]    = value; break;
+						case PLY_VERTEX_QUALITY:  rVertex->mQuality   = value; break;
+						case PLY_VERTEX_NORMAL_X: rVertex->mNormal[0] = value; break;
+						case PLY_VERTEX_NORMAL_Y: rVertex->mNormal[1] = value; break;
+						case PLY_VERTEX_NORMAL_Z: rVertex->mNormal[2] = value; break;
+						case PLY_COLOR_RED:       rVertex->mRGB[0] = static_cast<uint8_t>( value ); break;
+						case PLY_COLOR_GREEN:     rVertex->mRGB[1] = static_cast<uint8_t>( value ); break;
+						case PLY_COLOR_BLUE:      rVertex->mRGB[2] = static_cast<uint8_t>( value ); break;
+						default:
+							break;
+					}
+				}
+				return( true );
+			}
+
+		private:
+			//! Reads a single value. ASCII values are parsed independent of the locale.
+			bool readValue( eDataType rType, double& rValue ) {
+				if( mASCII ) {
+					const char* lineEnd = mLine.data() + mLine.size();
+					auto isSpace = []( char rChar ) { return( ( rChar == ' ' ) || ( rChar == '\t' ) || ( rChar == '\r' ) ); };
+					const char* valueStart = std::find_if_not( static_cast<const char*>( mLinePos ), lineEnd, isSpace );
+					const char* valueEnd   = std::find_if( valueStart, lineEnd, isSpace );
+					if( !parseNumber( valueStart, valueEnd, rValue ) ) {
+						LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Missing or invalid value in line: " << mLine << "\n";
+						return( false );
+					}
+					mLinePos = const_cast<char*>( valueEnd );
+					return( true );
+				}
+				const size_t valueSize = getDataTypeSize( rType );
+				unsigned char bytes[8];
+				if( ( valueSize == 0 ) || !readBytes( bytes, valueSize ) ) {
+					return( false );
+				}
+				if( mReverseByteOrder ) {
+					std::reverse( bytes, bytes + valueSize );
+				}
+				switch( rType ) {
+					case TYPE_INT8:    { int8_t   val; memcpy( &val, bytes, 1 ); rValue = val; } break;
+					case TYPE_UINT8:   { uint8_t  val; memcpy( &val, bytes, 1 ); rValue = val; } break;
+					case TYPE_INT16:   { int16_t  val; memcpy( &val, bytes, 2 ); rValue = val; } break;
+					case TYPE_UINT16:  { uint16_t val; memcpy( &val, bytes, 2 ); rValue = val; } break;
+					case TYPE_INT32:   { int32_t  val; memcpy( &val, bytes, 4 ); rValue = val; } break;
+					case TYPE_UINT32:  { uint32_t val; memcpy( &val, bytes, 4 ); rValue = val; } break;
+					case TYPE_FLOAT32: { float    val; memcpy( &val, bytes, 4 ); rValue = val; } break;
+					case TYPE_FLOAT64: { double   val; memcpy( &val, bytes, 8 ); rValue = val; } break;
+					default:
+						return( false );
+				}
+				return( true );
+			}
+
+			//! Copies bytes from the buffer, which is refilled when exhausted.
+			bool readBytes( unsigned char* rDest, size_t rCount ) {
+				for( size_t i=0; i<rCount; i++ ) {
+					if( mBufferPos >= mBufferLen ) {
+						mStream.read( mBuffer.data(), static_cast<streamsize>( mBuffer.size() ) );
+						mBufferLen = static_cast<size_t>( mStream.gcount() );
+						mBufferPos = 0;
+						if( mBufferLen == 0 ) {
+							LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Unexpected end of file!\n";
+							return( false );
+						}
+					}
+					rDest[i] = static_cast<unsigned char>( mBuffer[mBufferPos++] );
+				}
+				return( true );
+			}
+
+			//! Fetches the next non-empty line of an ASCII PLY.
+			bool nextLine() {
+				do {
+					if( !getline( mStream, mLine ) ) {
+						LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Unexpected end of file!\n";
+						return( false );
+					}
+				} while( mLine.find_first_not_of( " \t\r" ) == string::npos );
+				mLinePos = mLine.data();
+				return( true );
+			}
+
+			ifstream&    mStream;
+			bool         mASCII;
+			bool         mReverseByteOrder;
+			uint64_t     mVertexCount;      //!< Number of vertices for checking the indices of the faces.
+			vector<char> mBuffer;
+			size_t       mBufferPos = 0;
+			size_t       mBufferLen = 0;
+			string       mLine;
+			char*        mLinePos   = nullptr;
+	};
+
+	//! Appends a value in native byte order - little endian as within the header written by PlyWriter.
+	template <typename T>
+	inline void appendBinary( string& rOut, T rValue ) {
+		rOut.append( reinterpret_cast<const char*>( &rValue ), sizeof( T ) );
+	}
+
+	//! Encodes a chunk for a legacy PLY with the properties of PlyWriter.
+	void encodeChunk( const sChunk& rChunk, const PlyStreamConverter::sParams& rParams, string& rOut ) {
+		rOut.clear();
+		if( rChunk.mSection == PLY_VERTEX ) {
+			for( const sVertex& currVertex : rChunk.mVertices ) {
+				if( rParams.mWriteBinary ) {
+					appendBinary( rOut, static_cast<float>( currVertex.mPos[0] ) );
+					appendBinary( rOut, static_cast<float>( currVertex.mPos[1] ) );
+					appendBinary( rOut, static_cast<float>( currVertex.mPos[2] ) );
+					appendBinary( rOut, static_cast<float>( currVertex.mQuality ) );
+					rOut.append( reinterpret_cast<const char*>( currVertex.mRGB ), 3 );
+					if( rParams.mWriteNormals ) {
+						appendBinary( rOut, static_cast<float>( currVertex.mNormal[0] ) );
+						appendBinary( rOut, static_cast<float>( currVertex.mNormal[1] ) );
+						appendBinary( rOut, static_cast<float>( currVertex.mNormal[2] ) );
+					}
+					continue;
+				}
+				MeshWriter::appendNumber( rOut, currVertex.mPos[0] );  rOut += ' ';
+				MeshWriter::appendNumber( rOut, currVertex.mPos[1] );  rOut += ' ';
+				MeshWriter::appendNumber( rOut, currVertex.mPos[2] );  rOut += ' ';
+				MeshWriter::appendNumber( rOut, currVertex.mQuality ); rOut += ' ';
+				rOut += to_string( currVertex.mRGB[0] ); rOut += ' ';
+				rOut += to_string( currVertex.mRGB[1] ); rOut += ' ';
+				rOut += to_string( currVertex.mRGB[2] );
+				if( rParams.mWriteNormals ) {
+					rOut += ' '; MeshWriter::appendNumber( rOut, currVertex.mNormal[0] );
+					rOut += ' '; MeshWriter::appendNumber( rOut, currVertex.mNormal[1] );
+					rOut += ' '; MeshWriter::appendNumber( rOut, currVertex.mNormal[2] );
+				}
+				rOut += '\n';
+			}
+			return;
+		}
+		uint64_t indexPos = 0;
+		for( const uint8_t faceSize : rChunk.mFaceSizes ) {
+			if( rParams.mWriteBinary ) {
+				rOut += static_cast<char>( faceSize );
+				for( uint8_t i=0; i<faceSize; i++ ) {
+					appendBinary( rOut, rChunk.mFaceIndices[indexPos++] );
+				}
+				continue;
+			}
+			rOut += to_string( faceSize );
+			for( uint8_t i=0; i<faceSize; i++ ) {
+				rOut += ' ';
+				rOut += to_string( rChunk.mFaceIndices[indexPos++] );
+			}
+			rOut += '\n';
+		}
+	}
+}
+
+//! Converts a PLY into a legacy PLY.
+//!
+//! @returns false in case of an error. True otherwise.
+bool PlyStreamConverter::convert(
+                const filesystem::path& rFileIn,    //!< PLY to read.
+                const filesystem::path& rFileOut,   //!< Legacy PLY to write.
+                const sParams&          rParams,    //!< Parameters for writing and chunking.
+                sStats&                 rStats      //!< Number of primitives and bounding box.
+) {
+	PROFILE_SCOPE( "PlyStreamConverter::convert" );
+	rStats = sStats();
+	mModelMetaData.clearModelMetaStrings();
+
+	ifstream fileIn( rFileIn, ios::in | ios::binary );
+	if( !fileIn.is_open() ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Could not open file: " << rFileIn << "!\n";
+		return( false );
+	}
+
+	// Header -------------------------------------------------------------------------------------------------------------------------
+	string lineToParse;
+	getline( fileIn, lineToParse );
+	if( lineToParse.compare( 0, 3, "ply" ) != 0 ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: File " << rFileIn << " is not a PLY!\n";
+		return( false );
+	}
+	bool readASCII        = false;
+	bool fileIsBigEndian  = false;
+	bool endOfHeader      = false;
+	vector<sElement> elements;
+	while( !endOfHeader && getline( fileIn, lineToParse ) ) {
+		// Remove trailing '\r' e.g. from files provided from some low-cost scanners
+		if( !lineToParse.empty() && lineToParse.back() == '\r' ) {
+			lineToParse.pop_back();
+		}
+		istringstream lineStream( lineToParse );
+		string keyword;
+		lineStream >> keyword;
+		if( keyword == "end_header" ) {
+			endOfHeader = true;
+		} else if( keyword == "comment" ) {
+			// Meta-Data strings stored as comments
+			string possibleMetaDataName;
+			lineStream >> possibleMetaDataName;
+			ModelMetaData::eMetaStrings foundMetaId;
+			if( !possibleMetaDataName.empty() && ( possibleMetaDataName != "TextureFile" ) &&
+			    mModelMetaData.getModelMetaStringId( possibleMetaDataName, foundMetaId ) ) {
+				const uint64_t preMetaLen = 9 + possibleMetaDataName.size(); // 7 for 'comment' plus 2x space.
+				if( lineToParse.size() > preMetaLen ) {
+					mModelMetaData.setModelMetaString( foundMetaId, lineToParse.substr( preMetaLen ) );
+				}
+			}
+		} else if( keyword == "format" ) {
+			string formatName;
+			lineStream >> formatName;
+			readASCII       = ( formatName == "ascii" );
+			fileIsBigEndian = ( formatName == "binary_big_endian" );
+		} else if( keyword == "element" ) {
+			sElement newElement;
+			string   elementName;
+			lineStream >> elementName >> newElement.mCount;
+			if( elementName == "vertex" ) {
+				newElement.mSection = PLY_VERTEX;
+			} else if( elementName == "face" ) {
+				newElement.mSection = PLY_FACE;
+			}
+			elements.push_back( newElement );
+		} else if( keyword == "property" ) {
+			if( elements.empty() ) {
+				LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Property without element: " << lineToParse << "\n";
+				return( false );
+			}
+			sProperty newProperty;
+			string    typeStr;
+			string    propName;
+			lineStream >> typeStr;
+			if( typeStr == "list" ) {
+				string countTypeStr;
+				lineStream >> countTypeStr >> typeStr;
+				newProperty.mCountType = parseDataType( countTypeStr );
+				if( newProperty.mCountType == TYPE_UNDEF ) {
+					LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Unknown type: " << lineToParse << "\n";
+					return( false );
+				}
+			}
+			lineStream >> propName;
+			newProperty.mType = parseDataType( typeStr );
+			if( newProperty.mType == TYPE_UNDEF ) {
+				LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Unknown type: " << lineToParse << "\n";
+				return( false );
+			}
+			if( newProperty.mCountType != TYPE_UNDEF ) {
+				if( ( propName == "vertex_indices" ) || ( propName == "vertex_index" ) ) {
+					newProperty.mProperty = PLY_LIST_VERTEX_INDICES;
+				}
+			} else if( propName == "x" ) {
+				newProperty.mProperty = PLY_COORD_X;
+			} else if( propName == "y" ) {
+				newProperty.mProperty = PLY_COORD_Y;
+			} else if( propName == "z" ) {
+				newProperty.mProperty = PLY_COORD_Z;
+			} else if( propName == "nx" ) {
+				newProperty.mProperty = PLY_VERTEX_NORMAL_X;
+			} else if( propName == "ny" ) {
+				newProperty.mProperty = PLY_VERTEX_NORMAL_Y;
+			} else if( propName == "nz" ) {
+				newProperty.mProperty = PLY_VERTEX_NORMAL_Z;
+			} else if( propName == "quality" ) {
+				newProperty.mProperty = PLY_VERTEX_QUALITY;
+			} else if( ( propName == "red" ) || ( propName == "diffuse_red" ) ) {
+				newProperty.mProperty = PLY_COLOR_RED;
+			} else if( ( propName == "green" ) || ( propName == "diffuse_green" ) ) {
+				newProperty.mProperty = PLY_COLOR_GREEN;
+			} else if( ( propName == "blue" ) || ( propName == "diffuse_blue" ) ) {
+				newProperty.mProperty = PLY_COLOR_BLUE;
+			}
+			elements.back().mProperties.push_back( newProperty );
+		}
+	}
+	if( !endOfHeader ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: No end of header was found!\n";
+		return( false );
+	}
+
+	// Check the elements:
+	const sElement* vertexElement = nullptr;
+	const sElement* faceElement   = nullptr;
+	for( const sElement& currElement : elements ) {
+		if( ( currElement.mSection == PLY_VERTEX ) && ( vertexElement == nullptr ) ) {
+			vertexElement = &currElement;
+		} else if( ( currElement.mSection == PLY_FACE ) && ( faceElement == nullptr ) ) {
+			if( vertexElement == nullptr ) {
+				LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Faces before vertices are not supported for streaming!\n";
+				return( false );
+			}
+			faceElement = &currElement;
+		}
+	}
+	if( vertexElement == nullptr ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: No vertices!\n";
+		return( false );
+	}
+	if( rParams.mWriteNormals ) {
+		const bool hasNormals = std::any_of( vertexElement->mProperties.begin(), vertexElement->mProperties.end(),
+		                                     []( const sProperty& rProp ) { return( rProp.mProperty == PLY_VERTEX_NORMAL_X ); } );
+		if( !hasNormals ) {
+			LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Normals requested, but not present!\n";
+			return( false );
+		}
+	}
+	rStats.mVertexCount = vertexElement->mCount;
+	rStats.mFaceCount   = ( faceElement != nullptr ) ? faceElement->mCount : 0;
+
+	// Output header ------------------------------------------------------------------------------------------------------------------
+	ofstream fileOut( rFileOut, ios::out | ios::binary | ios::trunc );
+	if( !fileOut.is_open() ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Could not open file: " << rFileOut << "!\n";
+		return( false );
+	}
+	{
+		ostringstream headerOut;
+		headerOut.imbue( std::locale( "C" ) );
+		headerOut << "ply\n";
+		headerOut << ( rParams.mWriteBinary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n" );
+		PlyWriter headerWriter;
+		headerWriter.setModelMetaData( mModelMetaData );
+		headerWriter.writeHeaderComments( headerOut, rFileOut );
+		headerOut << "element vertex " << rStats.mVertexCount << "\n";
+		headerOut << "property float x\n";
+		headerOut << "property float y\n";
+		headerOut << "property float z\n";
+		headerOut << "property float quality\n";
+		headerOut << "property uint8 red\n";
+		headerOut << "property uint8 green\n";
+		headerOut << "property uint8 blue\n";
+		if( rParams.mWriteNormals ) {
+			headerOut << "property float nx\n";
+			headerOut << "property float ny\n";
+			headerOut << "property float nz\n";
+		}
+		if( rStats.mFaceCount > 0 ) {
+			headerOut << "element face " << rStats.mFaceCount << "\n";
+			headerOut << "property list uchar int32 vertex_indices\n";
+		}
+		headerOut << "end_header\n";
+		const string headerStr = headerOut.str();
+		fileOut.write( headerStr.data(), static_cast<streamsize>( headerStr.size() ) );
+	}
+
+	// Data ---------------------------------------------------------------------------------------------------------------------------
+	const uint16_t byteOrderProbe = 1;
+	const bool     systemIsBigEndian = ( *reinterpret_cast<const uint8_t*>( &byteOrderProbe ) == 0 );
+	PlyDataReader dataReader( fileIn, readASCII, !readASCII && ( fileIsBigEndian != systemIsBigEndian ), rStats.mVertexCount );
+	const uint64_t chunkSize = std::max<uint64_t>( rParams.mChunkSize, 1 );
+
+	// Fills a chunk with the next elements. Elements not written are skipped.
+	uint64_t elementIdx  = 0;
+	uint64_t elementRead = 0;
+	auto readChunk = [&]( sChunk& rChunk ) -> int {  // 1: chunk filled, 0: done, -1: error
+		while( elementIdx < elements.size() ) {
+			const sElement& currElement = elements[elementIdx];
+			if( elementRead >= currElement.mCount ) {
+				if( &currElement == faceElement ) {
+					return( 0 );
+				}
+				elementIdx++;
+				elementRead = 0;
+				continue;
+			}
+			const bool isVertex = ( &currElement == vertexElement );
+			const bool isFace   = ( &currElement == faceElement );
+			if( !isVertex && !isFace ) {
+				if( ( faceElement == nullptr ) && ( elementIdx > static_cast<uint64_t>( vertexElement - elements.data() ) ) ) {
+					return( 0 );
+				}
+				// Skip:
+				for( ; elementRead<currElement.mCount; elementRead++ ) {
+					if( !dataReader.readElement( currElement, nullptr, nullptr, nullptr ) ) {
+						return( -1 );
+					}
+				}
+				continue;
+			}
+			rChunk.clear( isVertex ? PLY_VERTEX : PLY_FACE );
+			const uint64_t chunkEnd = std::min( elementRead + chunkSize, currElement.mCount );
+			for( ; elementRead<chunkEnd; elementRead++ ) {
+				if( isVertex ) {
+					rChunk.mVertices.emplace_back();
+					if( !dataReader.readElement( currElement, &rChunk.mVertices.back(), nullptr, nullptr ) ) {
+						return( -1 );
+					}
+				} else if( !dataReader.readElement( currElement, nullptr, &rChunk.mFaceSizes, &rChunk.mFaceIndices ) ) {
+					return( -1 );
+				}
+			}
+			return( 1 );
+		}
+		return( 0 );
+	};
+
+	// Encodes and writes a chunk and updates the bounding box.
+	for( int i=0; i<3; i++ ) {
+		rStats.mMin[i] = +DBL_MAX;
+		rStats.mMax[i] = -DBL_MAX;
+	}
+	string outBuffer;
+	auto writeChunk = [&]( const sChunk& rChunk ) -> bool {
+		for( const sVertex& currVertex : rChunk.mVertices ) {
+			for( int i=0; i<3; i++ ) {
+				rStats.mMin[i] = std::min( rStats.mMin[i], currVertex.mPos[i] );
+				rStats.mMax[i] = std::max( rStats.mMax[i], currVertex.mPos[i] );
+			}
+		}
+		encodeChunk( rChunk, rParams, outBuffer );
+		fileOut.write( outBuffer.data(), static_cast<streamsize>( outBuffer.size() ) );
+		return( fileOut.good() );
+	};
+
+	bool readOk  = true;
+	bool writeOk = true;
+	if( rParams.mThreaded ) {
+		// Three chunks: one read, one written and one queued.
+		vector<sChunk> chunks( 3 );
+		ChunkQueue chunksFree;
+		ChunkQueue chunksFilled;
+		for( sChunk& currChunk : chunks ) {
+			chunksFree.push( &currChunk );
+		}
+		thread readerThread( [&]() {
+			PROFILE_SCOPE( "PlyStreamConverter::read" );
+			while( sChunk* currChunk = chunksFree.pop() ) {
+				const int readState = readChunk( *currChunk );
+				if( readState <= 0 ) {
+					readOk = ( readState == 0 );
+					break;
+				}
+				chunksFilled.push( currChunk );
+			}
+			chunksFilled.close();
+		} );
+		{
+			PROFILE_SCOPE( "PlyStreamConverter::write" );
+			while( sChunk* currChunk = chunksFilled.pop() ) {
+				if( !writeChunk( *currChunk ) ) {
+					writeOk = false;
+					chunksFree.abort();
+					break;
+				}
+				chunksFree.push( currChunk );
+			}
+		}
+		readerThread.join();
+	} else {
+		sChunk currChunk;
+		int readState = 0;
+		while( writeOk && ( readState = readChunk( currChunk ) ) > 0 ) {
+			writeOk = writeChunk( currChunk );
+		}
+		readOk = ( readState >= 0 );
+	}
+	rStats.mBytesWritten = static_cast<uint64_t>( fileOut.tellp() );
+	fileOut.close();
+
+	if( !readOk ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Reading " << rFileIn << " failed!\n";
+		return( false );
+	}
+	if( !writeOk || fileOut.fail() ) {
+		LOG::error() << "[PlyStreamConverter::" << __FUNCTION__ << "] ERROR: Writing " << rFileOut << " failed!\n";
+		return( false );
+	}
+	return( true );
+}
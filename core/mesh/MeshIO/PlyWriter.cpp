@@ -23,15 +23,30 @@
 #include "PlyWriter.h"
 #include <fstream>
 #include <chrono>
+#include <cstring>
 #include <locale>
+#include <memory>
+#include <new>
 #include <filesystem>
 #include <GigaMesh/mesh/primitive.h>
+#include <GigaMesh/mesh/parallelfor.h>
 #include "PlyEnums.h"
 
 #include <GigaMesh/logging/Logging.h>
 
 using namespace std;
 
+namespace {
+	constexpr uint64_t plyChunkSize = 16384; // Records per task.
+
+	//! Copies a value into a binary record and advances the position.
+	template<typename T>
+	inline void putBinary( char*& rPos, const T rValue ) {
+		std::memcpy( rPos, &rValue, sizeof( T ) );
+		rPos += sizeof( T );
+	}
+}
+
 
 PlyWriter::PlyWriter()
 {
@@ -83,77 +98,7 @@ bool PlyWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 	} else {
 		filestr << "format ascii 1.0\n";
 	}
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	filestr << "comment | PLY file generated by GigaMesh Software Framework                             |\n";
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	filestr << "comment | WebSite: https://gigamesh.eu                                                  |\n";
-	filestr << "comment | EMail:   info@gigamesh.eu                                                     |\n";
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	filestr << "comment | Contact: Hubert MARA <hubert.mara@iwr.uni-heidelberg.de>                      |\n";
-	filestr << "comment |          IWR - Heidelberg University, Germany                                 |\n";
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	filestr << "comment | GigaMesh compiled                                                             |\n";
-
-#ifdef COMP_USER
-	filestr << "comment | .... by: " << COMP_USER << "\n";
-#else
-	filestr << "comment | .... by: UNKNOWN                                                              |\n";
-#endif
-#ifdef COMP_DATE
-	filestr << "comment | .... at: " << COMP_DATE << "\n";
-#else
-	filestr << "comment | .... at: UNKNOWN                                                              |\n";
-#endif
-#ifdef COMP_EDIT
-	filestr << "comment | ... for: " << COMP_EDIT << "\n";
-#else
-	filestr << "comment | ... for: UNKNOWN                                                              |\n";
-#endif
-#ifdef COMP_GITHEAD
-	filestr << "comment | ... git-head: " << COMP_GITHEAD << "\n";
-#else
-	filestr << "comment | ... git-head: UNKNOWN                                                         |\n";
-#endif
-#ifdef VERSION_PACKAGE
-	filestr << "comment | .... Version: " << VERSION_PACKAGE << "\n";
-#else
-	filestr << "comment | .... Version: UNKNOWN                                                              |\n";
-#endif
-
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	filestr << "comment | Meta information:                                                             |\n";
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
-	for( uint64_t i=0; i<ModelMetaData::META_STRINGS_COUNT; i++ ) {
-		auto metaId = static_cast<ModelMetaData::eMetaStrings>( i );
-		if( metaId == ModelMetaData::META_FILENAME ) { // Ignore the filename!
-			continue;
-		}
-		string metaStr = MeshWriter::getModelMetaDataRef().getModelMetaString( metaId );
-		if( metaStr.empty()) { // Ignore empty strings!
-			continue;
-		}
-		string metaName;
-		if( MeshWriter::getModelMetaDataRef().getModelMetaStringName( metaId, metaName ) ) {
-			if(metaId == ModelMetaData::META_TEXTUREFILE)
-			{
-				continue;	//we use the textures stored in getTexturefilesRef instead
-			}
-
-			filestr << "comment " << metaName << " " << metaStr << "\n";
-		}
-	}
-
-	if(!MeshWriter::getModelMetaDataRef().getTexturefilesRef().empty())
-	{
-		for(const auto& texName : MeshWriter::getModelMetaDataRef().getTexturefilesRef())
-		{
-			auto prevPath = std::filesystem::current_path();
-			std::filesystem::current_path(std::filesystem::absolute(rFilename).parent_path());
-			filestr << "comment TextureFile " << std::filesystem::relative(texName).string() << "\n";
-			std::filesystem::current_path(prevPath);
-		}
-	}
-	filestr << "comment +-------------------------------------------------------------------------------+\n";
+	writeHeaderComments( filestr, rFilename );
 
 	filestr << "element vertex " << rVertexProps.size() << "\n";
 	//! .) Vertices: x, y and z coordinates.
@@ -222,75 +167,85 @@ bool PlyWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 	if( !mExportBinary ) {
 		//! \todo Test ASCII export with and without texture.
 		// === ASCII mode ===========================================================
+		// The records are formatted in parallel chunks using std::to_chars and
+		// written in order - see MeshWriter::writeChunksOrdered.
 		// --- Vertices -------------------------------------------------------------
-		uint64_t featureVecLenMax = rMeshSeed.getFeatureVecLenMax( Primitive::IS_VERTEX );
-
-		int currVertNum = 0;
-		for(const auto& vertexProp : rVertexProps)
-		{
-			filestr << vertexProp.mCoordX  << " ";   // x-coordinate
-			filestr << vertexProp.mCoordY  << " ";   // y-coordinate
-			filestr << vertexProp.mCoordZ  << " ";   // z-coordinate
-			filestr << vertexProp.mFuncVal;          // function value stored within PLY_QUALITY
-			if( mExportVertFlags ) {
-				filestr << " ";
-				filestr << static_cast<unsigned int>(vertexProp.mFlags); // flags lower half (int32 vs long64!)
-			}
-			if( mExportVertColor ) {
-				filestr << " ";
-				filestr << static_cast<unsigned int>(vertexProp.mColorRed)   << " ";
-				filestr << static_cast<unsigned int>(vertexProp.mColorGrn) << " ";
-				filestr << static_cast<unsigned int>(vertexProp.mColorBle);
-				//! \todo Alpha is ignored and not written to output.
-			}
-			if( mExportVertNormal ) {
-				filestr << " ";
-				filestr << vertexProp.mNormalX << " ";
-				filestr << vertexProp.mNormalY << " ";
-				filestr << vertexProp.mNormalZ;
-			}
-			if( mExportVertLabel ) {
-				filestr << " ";
-				filestr << vertexProp.mLabelId;
-			}
-			if( mExportVertFeatureVector ) {
-				//! \todo test: write ASCII PLY with features
-				filestr << " ";
-				filestr << featureVecLenMax << " ";
-				for( uint64_t j=0; j<rMeshSeed.getFeatureVecLenMax( Primitive::IS_VERTEX ); j++ ) {
-					auto featureToWrite = static_cast<float>(rMeshSeed.getFeatureVecVerticesRef().at( featureVecLenMax*currVertNum+j ));
-					//filestr << getFeatureVertex( i, j ) << " ";
-					filestr << featureToWrite << " ";
+		const uint64_t featureVecLenMax = mExportVertFeatureVector ? rMeshSeed.getFeatureVecLenMax( Primitive::IS_VERTEX ) : 0;
+		const double*  featureVecs      = rMeshSeed.getFeatureVecVerticesRef().data();
+		writeChunksOrdered( filestr, rVertexProps.size(), [&]( uint64_t rVertIdxBegin, uint64_t rVertIdxEnd, std::string& rText ) {
+			for( uint64_t vertIdx=rVertIdxBegin; vertIdx<rVertIdxEnd; vertIdx++ ) {
+				const sVertexProperties& vertexProp = rVertexProps[vertIdx];
+				appendNumber( rText, vertexProp.mCoordX ); // x-coordinate
+				rText += ' ';
+				appendNumber( rText, vertexProp.mCoordY ); // y-coordinate
+				rText += ' ';
+				appendNumber( rText, vertexProp.mCoordZ ); // z-coordinate
+				rText += ' ';
+				appendNumber( rText, vertexProp.mFuncVal ); // function value stored within PLY_QUALITY
+				if( mExportVertFlags ) {
+					rText += ' ';
+					appendNumber( rText, static_cast<unsigned int>(vertexProp.mFlags) ); // flags lower half (int32 vs long64!)
+				}
+				if( mExportVertColor ) {
+					rText += ' ';
+					appendNumber( rText, static_cast<unsigned int>(vertexProp.mColorRed) );
+					rText += ' ';
+					appendNumber( rText, static_cast<unsigned int>(vertexProp.mColorGrn) );
+					rText += ' ';
+					appendNumber( rText, static_cast<unsigned int>(vertexProp.mColorBle) );
+					//! \todo Alpha is ignored and not written to output.
 				}
+				if( mExportVertNormal ) {
+					rText += ' ';
+					appendNumber( rText, vertexProp.mNormalX );
+					rText += ' ';
+					appendNumber( rText, vertexProp.mNormalY );
+					rText += ' ';
+					appendNumber( rText, vertexProp.mNormalZ );
+				}
+				if( mExportVertLabel ) {
+					rText += ' ';
+					appendNumber( rText, vertexProp.mLabelId );
+				}
+				if( mExportVertFeatureVector ) {
+					//! \todo test: write ASCII PLY with features
+					rText += ' ';
+					appendNumber( rText, featureVecLenMax );
+					rText += ' ';
+					for( uint64_t j=0; j<featureVecLenMax; j++ ) {
+						appendNumber( rText, static_cast<float>( featureVecs[featureVecLenMax*vertIdx+j] ) );
+						rText += ' ';
+					}
+				}
+				rText += '\n';
 			}
-			filestr << "\n";
-			++currVertNum;
-		}
+		} );
 
 		// --- Faces ----------------------------------------------------------------
-		for(const auto & rFaceProp : rFaceProps) {
-			// PLYs start with ZERO! So no +1 needed (in contrast to OBJ)
-			filestr << rFaceProp.vertexIndices.size();
-
-			for(auto index : rFaceProp.vertexIndices)
-			{
-				filestr << " " << index;
-			}
-
-			if(mExportTextureCoordinates)
-			{
-				filestr << " " << rFaceProp.textureCoordinates.size();
-				for(auto texCoord : rFaceProp.textureCoordinates)
-				{
-					filestr << " " << texCoord;
+		writeChunksOrdered( filestr, rFaceProps.size(), [&]( uint64_t rFaceIdxBegin, uint64_t rFaceIdxEnd, std::string& rText ) {
+			for( uint64_t faceIdx=rFaceIdxBegin; faceIdx<rFaceIdxEnd; faceIdx++ ) {
+				const sFaceProperties& faceProp = rFaceProps[faceIdx];
+				// PLYs start with ZERO! So no +1 needed (in contrast to OBJ)
+				appendNumber( rText, faceProp.vertexIndices.size() );
+				for( const uint64_t index : faceProp.vertexIndices ) {
+					rText += ' ';
+					appendNumber( rText, index );
 				}
+				if( mExportTextureCoordinates ) {
+					rText += ' ';
+					appendNumber( rText, faceProp.textureCoordinates.size() );
+					for( const float texCoord : faceProp.textureCoordinates ) {
+						rText += ' ';
+						appendNumber( rText, texCoord );
+					}
+				}
+				if( exportTextureId ) {
+					rText += ' ';
+					appendNumber( rText, static_cast<unsigned short>(faceProp.textureId) );
+				}
+				rText += '\n';
 			}
-			if(exportTextureId)
-			{
-				filestr << " " << static_cast<unsigned short>(rFaceProp.textureId);
-			}
-			filestr << "\n";
-		}
+		} );
 		// ---- Polygonal lines -----------------------------------------------------
 		for( unsigned int i=0; i<rMeshSeed.getPolyLineNr(); i++ ) {
 			PrimitiveInfo primInfo = rMeshSeed.getPolyLinePrimInfo( i );
@@ -314,91 +269,131 @@ bool PlyWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 		}
 	} else {
 			// === Binary mode ===
+			// The size of the vertex and face records is known in advance, so they are
+			// encoded in parallel chunks into one buffer, which is written at once.
 			// --- Vertices -------------------------------------------------------------
-			high_resolution_clock::time_point tStartVertices = high_resolution_clock::now();
-			unsigned char texVal;
-			unsigned long featureVecLenMax = rMeshSeed.getFeatureVecLenMax( Primitive::IS_VERTEX );
-			int currVertNum = 0;
-			for( const auto& vertexProp : rVertexProps) {
-				float someFloat = static_cast<float>( vertexProp.mCoordX );
-				filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 ); // floats have 4 bytes in a binary PLY
-				someFloat = static_cast<float>( vertexProp.mCoordY );
-				filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 );
-				someFloat = static_cast<float>( vertexProp.mCoordZ );
-				filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 );
-				someFloat = static_cast<float>( vertexProp.mFuncVal );   // function value stored ...
-				filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 ); // ... within PLY_QUALITY
-				if( mExportVertFlags) {
-					int vertFlags = static_cast<int>(vertexProp.mFlags);
-					filestr.write( reinterpret_cast<char*>(&vertFlags), PLY_INT32 );
-				}
-				if( mExportVertColor ) {
-					texVal = vertexProp.mColorRed;
-					filestr.write( reinterpret_cast<char*>(&texVal), PLY_UINT8 );
-					texVal = vertexProp.mColorGrn;
-					filestr.write( reinterpret_cast<char*>(&texVal), PLY_UINT8 );
-					texVal = vertexProp.mColorBle;
-					filestr.write( reinterpret_cast<char*>(&texVal), PLY_UINT8 );
-					//! \todo Alpha is ignored and not written.
+			high_resolution_clock::time_point tStartEncode = high_resolution_clock::now();
+			const uint64_t featureVecLenMax = mExportVertFeatureVector ? rMeshSeed.getFeatureVecLenMax( Primitive::IS_VERTEX ) : 0;
+			const double*  featureVecs      = rMeshSeed.getFeatureVecVerticesRef().data();
+			uint64_t vertexStride = 4 * PLY_FLOAT32; // x, y, z and quality
+			if( mExportVertFlags ) {
+				vertexStride += PLY_INT32;
+			}
+			if( mExportVertColor ) {
+				vertexStride += 3 * PLY_UINT8;
+			}
+			if( mExportVertNormal ) {
+				vertexStride += 3 * PLY_FLOAT32;
+			}
+			if( mExportVertLabel ) {
+				vertexStride += PLY_UINT32;
+			}
+			if( mExportVertFeatureVector ) {
+				vertexStride += PLY_UCHAR + featureVecLenMax * PLY_FLOAT32;
+			}
+			const unsigned int threadCount  = ParallelFor::getThreadCount();
+			const uint64_t     vertexChunks = ParallelFor::getChunkCount( rVertexProps.size(), plyChunkSize );
+			const uint64_t     faceChunks   = ParallelFor::getChunkCount( rFaceProps.size(), plyChunkSize );
+
+			// --- Faces: size of the records per chunk ---------------------------------
+			auto faceRecordSize = [this,exportTextureId]( const sFaceProperties& rFaceProp ) {
+				uint64_t recordSize = PLY_UCHAR + rFaceProp.vertexIndices.size() * PLY_INT32;
+				if( mExportTextureCoordinates ) {
+					recordSize += PLY_UCHAR + rFaceProp.textureCoordinates.size() * PLY_FLOAT32;
 				}
-				if( mExportVertNormal ) {
-					float someFloat = static_cast<float>(vertexProp.mNormalX);
-					filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 ); // floats have 4 bytes in a binary PLY
-					someFloat = static_cast<float>(vertexProp.mNormalY);
-					filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 );
-					someFloat = static_cast<float>(vertexProp.mNormalZ);
-					filestr.write( reinterpret_cast<char*>(&someFloat), PLY_FLOAT32 );
+				if( exportTextureId ) {
+					recordSize += PLY_INT32;
 				}
-				if( mExportVertLabel ) {
-					unsigned int vertLabelID = vertexProp.mLabelId;
-					filestr.write( reinterpret_cast<char*>(&vertLabelID), PLY_UINT32 );
+				return( recordSize );
+			};
+			std::vector<uint64_t> faceChunkOffsets( faceChunks + 1, 0 );
+			ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+				const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * plyChunkSize, static_cast<uint64_t>( rFaceProps.size() ) );
+				uint64_t chunkBytes = 0;
+				for( uint64_t faceIdx=rChunkIdx*plyChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+					chunkBytes += faceRecordSize( rFaceProps[faceIdx] );
 				}
-				if( mExportVertFeatureVector ) {
-					filestr << static_cast<unsigned char>(featureVecLenMax);
-					for( uint64_t j=0; j<featureVecLenMax; j++ ) {
-						float featureToWrite = static_cast<float>(rMeshSeed.getFeatureVecVerticesRef().at( featureVecLenMax*currVertNum+j ));
-						filestr.write( reinterpret_cast<char*>(&(featureToWrite)), PLY_FLOAT32 );
+				faceChunkOffsets[rChunkIdx+1] = chunkBytes;
+			} );
+			faceChunkOffsets[0] = rVertexProps.size() * vertexStride;
+			for( uint64_t chunkIdx=0; chunkIdx<faceChunks; chunkIdx++ ) {
+				faceChunkOffsets[chunkIdx+1] += faceChunkOffsets[chunkIdx];
+			}
+			const uint64_t payloadSize = faceChunkOffsets[faceChunks];
+			std::unique_ptr<char[]> payload( new(std::nothrow) char[payloadSize] );
+			if( payload == nullptr ) {
+				LOG::error() << "[PlyWriter::" << __FUNCTION__ << "] ERROR: Could not allocate " << payloadSize << " bytes!\n";
+				filestr.close();
+				return false;
+			}
+
+			// --- Encode vertices and faces --------------------------------------------
+			ParallelFor::forEachChunk( vertexChunks + faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+				if( rChunkIdx < vertexChunks ) {
+					const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * plyChunkSize, static_cast<uint64_t>( rVertexProps.size() ) );
+					char* recordPos = payload.get() + rChunkIdx * plyChunkSize * vertexStride;
+					for( uint64_t vertIdx=rChunkIdx*plyChunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+						const sVertexProperties& vertexProp = rVertexProps[vertIdx];
+						putBinary( recordPos, static_cast<float>( vertexProp.mCoordX ) ); // floats have 4 bytes in a binary PLY
+						putBinary( recordPos, static_cast<float>( vertexProp.mCoordY ) );
+						putBinary( recordPos, static_cast<float>( vertexProp.mCoordZ ) );
+						putBinary( recordPos, static_cast<float>( vertexProp.mFuncVal ) ); // function value stored within PLY_QUALITY
+						if( mExportVertFlags ) {
+							putBinary( recordPos, static_cast<int32_t>( vertexProp.mFlags ) );
+						}
+						if( mExportVertColor ) {
+							putBinary( recordPos, vertexProp.mColorRed );
+							putBinary( recordPos, vertexProp.mColorGrn );
+							putBinary( recordPos, vertexProp.mColorBle );
+							//! \todo Alpha is ignored and not written.
+						}
+						if( mExportVertNormal ) {
+							putBinary( recordPos, static_cast<float>( vertexProp.mNormalX ) );
+							putBinary( recordPos, static_cast<float>( vertexProp.mNormalY ) );
+							putBinary( recordPos, static_cast<float>( vertexProp.mNormalZ ) );
+						}
+						if( mExportVertLabel ) {
+							putBinary( recordPos, static_cast<uint32_t>( vertexProp.mLabelId ) );
+						}
+						if( mExportVertFeatureVector ) {
+							putBinary( recordPos, static_cast<unsigned char>( featureVecLenMax ) );
+							for( uint64_t j=0; j<featureVecLenMax; j++ ) {
+								putBinary( recordPos, static_cast<float>( featureVecs[featureVecLenMax*vertIdx+j] ) );
+							}
+						}
 					}
+					return;
 				}
-				++currVertNum;
-			}
-			high_resolution_clock::time_point tEndVertices = high_resolution_clock::now();
-			duration<double> time_span_Vertices = duration_cast<duration<double>>( tEndVertices - tStartVertices );
-			LOG::info() << "[PlyWriter::" << __FUNCTION__ << "] write Vertices:         " << time_span_Vertices.count() << " seconds.\n";
-			// --- Faces ----------------------------------------------------------------
-			{
-				high_resolution_clock::time_point tStartFaces = high_resolution_clock::now();
-				for(const auto & rFaceProp : rFaceProps) {
-					const char numberOfVerticesPerFace = static_cast<char>(rFaceProp.vertexIndices.size());
+				const uint64_t faceChunkIdx = rChunkIdx - vertexChunks;
+				const uint64_t faceIdxEnd = std::min( ( faceChunkIdx + 1 ) * plyChunkSize, static_cast<uint64_t>( rFaceProps.size() ) );
+				char* recordPos = payload.get() + faceChunkOffsets[faceChunkIdx];
+				for( uint64_t faceIdx=faceChunkIdx*plyChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+					const sFaceProperties& faceProp = rFaceProps[faceIdx];
 					// PLYs start with ZERO!
-					filestr.write( &numberOfVerticesPerFace, PLY_UCHAR ); // uchar have 1 byte in a binary PLY
-
-					for(auto index : rFaceProp.vertexIndices)
-					{
-						uint32_t someIdx = static_cast<uint32_t>(index);
-						filestr.write( reinterpret_cast<char*>(&someIdx), PLY_INT32 ); // floats have 4 bytes in a binary PLY
+					putBinary( recordPos, static_cast<unsigned char>( faceProp.vertexIndices.size() ) ); // uchar have 1 byte in a binary PLY
+					for( const uint64_t index : faceProp.vertexIndices ) {
+						putBinary( recordPos, static_cast<uint32_t>( index ) );
 					}
-
-					if(mExportTextureCoordinates)
-					{
-						const char numberOfTexcoords = static_cast<char>(rFaceProp.textureCoordinates.size());
-						filestr.write(&numberOfTexcoords, PLY_UCHAR);
-
-						for(auto texCoord : rFaceProp.textureCoordinates)
-						{
-							filestr.write( reinterpret_cast<char*>(&texCoord), PLY_FLOAT32);
+					if( mExportTextureCoordinates ) {
+						putBinary( recordPos, static_cast<unsigned char>( faceProp.textureCoordinates.size() ) );
+						for( const float texCoord : faceProp.textureCoordinates ) {
+							putBinary( recordPos, texCoord );
 						}
 					}
-					if(exportTextureId)
-					{
-						int texID = rFaceProp.textureId;
-						filestr.write( reinterpret_cast<char*>(&texID), PLY_INT32);
+					if( exportTextureId ) {
+						putBinary( recordPos, static_cast<int32_t>( faceProp.textureId ) );
 					}
 				}
-				high_resolution_clock::time_point tEndFaces = high_resolution_clock::now();
-				duration<double> time_span_Faces = duration_cast<duration<double>>( tEndFaces - tStartFaces );
-				LOG::info() << "[PlyWriter::" << __FUNCTION__ << "] write Faces:            " << time_span_Faces.count() << " seconds.\n";
-			}
+			} );
+			high_resolution_clock::time_point tEndEncode = high_resolution_clock::now();
+			duration<double> time_span_Encode = duration_cast<duration<double>>( tEndEncode - tStartEncode );
+			LOG::info() << "[PlyWriter::" << __FUNCTION__ << "] encode Vertices+Faces: " << time_span_Encode.count() << " seconds.\n";
+
+			// --- Write vertices and faces ---------------------------------------------
+			filestr.write( payload.get(), payloadSize );
+			payload.reset();
+			duration<double> time_span_Write = duration_cast<duration<double>>( high_resolution_clock::now() - tEndEncode );
+			LOG::info() << "[PlyWriter::" << __FUNCTION__ << "] write Vertices+Faces:  " << time_span_Write.count() << " seconds.\n";
 			// ---- Polygonal lines -----------------------------------------------------
 			if( ( mExportPolyline ) && ( rMeshSeed.getPolyLineNr() > 0 ) ) {
 				high_resolution_clock::time_point tStartPolylines = high_resolution_clock::now();
@@ -446,3 +441,76 @@ bool PlyWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 
 	return true;
 }
+
+//! Writes the comments of the header i.e. information about GigaMesh and the meta-data.
+//! Shared with the streaming conversion - see PlyStreamConverter.
+void PlyWriter::writeHeaderComments( std::ostream& rStream, const std::filesystem::path& rFilename ) {
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	rStream << "comment | PLY file generated by GigaMesh Software Framework                             |\n";
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	rStream << "comment | WebSite: https://gigamesh.eu                                                  |\n";
+	rStream << "comment | EMail:   info@gigamesh.eu                                                     |\n";
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	rStream << "comment | Contact: Hubert MARA <hubert.mara@iwr.uni-heidelberg.de>                      |\n";
+	rStream << "comment |          IWR - Heidelberg University, Germany                                 |\n";
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	rStream << "comment | GigaMesh compiled                                                             |\n";
+
+#ifdef COMP_USER
+	rStream << "comment | .... by: " << COMP_USER << "\n";
+#else
+	rStream << "comment | .... by: UNKNOWN                                                              |\n";
+#endif
+#ifdef COMP_DATE
+	rStream << "comment | .... at: " << COMP_DATE << "\n";
+#else
+	rStream << "comment | .... at: UNKNOWN                                                              |\n";
+#endif
+#ifdef COMP_EDIT
+	rStream << "comment | ... for: " << COMP_EDIT << "\n";
+#else
+	rStream << "comment | ... for: UNKNOWN                                                              |\n";
+#endif
+#ifdef COMP_GITHEAD
+	rStream << "comment | ... git-head: " << COMP_GITHEAD << "\n";
+#else
+	rStream << "comment | ... git-head: UNKNOWN                                                         |\n";
+#endif
+#ifdef VERSION_PACKAGE
+	rStream << "comment | .... Version: " << VERSION_PACKAGE << "\n";
+#else
+	rStream << "comment | .... Version: UNKNOWN                                                              |\n";
+#endif
+
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	rStream << "comment | Meta information:                                                             |\n";
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+	for( uint64_t i=0; i<ModelMetaData::META_STRINGS_COUNT; i++ ) {
+		auto metaId = static_cast<ModelMetaData::eMetaStrings>( i );
+		if( metaId == ModelMetaData::META_FILENAME ) { // Ignore the filename!
+			continue;
+		}
+		string metaStr = MeshWriter::getModelMetaDataRef().getModelMetaString( metaId );
+		if( metaStr.empty()) { // Ignore empty strings!
+			continue;
+		}
+		string metaName;
+		if( MeshWriter::getModelMetaDataRef().getModelMetaStringName( metaId, metaName ) ) {
+			if(metaId == ModelMetaData::META_TEXTUREFILE)
+			{
+				continue;	//we use the textures stored in getTexturefilesRef instead
+			}
+
+			rStream << "comment " << metaName << " " << metaStr << "\n";
+		}
+	}
+
+	if(!MeshWriter::getModelMetaDataRef().getTexturefilesRef().empty())
+	{
+		for(const auto& texName : MeshWriter::getModelMetaDataRef().getTexturefilesRef())
+		{
+			rStream << "comment TextureFile " << getTexturePathRelative( texName, rFilename ) << "\n";
+		}
+	}
+	rStream << "comment +-------------------------------------------------------------------------------+\n";
+}
@@ -23,6 +23,7 @@
 #define PLYWRITER_H
 
 #include "MeshWriter.h"
+#include <ostream>
 
 class PlyWriter : public MeshWriter
 {
@@ -34,6 +35,8 @@ class PlyWriter : public MeshWriter
 	public:
 		bool writeFile(const std::filesystem::path& rFilename, const std::vector<sVertexProperties>& rVertexProps, const std::vector<sFaceProperties>& rFaceProps, MeshSeedExt& rMeshSeed) override;
 
+		void writeHeaderComments( std::ostream& rStream, const std::filesystem::path& rFilename );
+
 };
 
 #endif // PLYWRITER_H
@@ -23,20 +23,43 @@
 #include "TxtReader.h"
 #include <fstream>
 #include <string>
-#include <clocale>
+#include <sstream>
 #include <list>
 
+#include <GigaMesh/mesh/parsenumber.h>
+
 using namespace std;
 
 
+//! Parses a line with X, Y, Z and optional R, G, B like sscanf with "%f %f %f %f %f %f" or
+//! "%f %f %f %i %i %i", but independent of the locale - see parseNumber.
+//!
+//! @returns the number of values parsed before the first value, which is not a number.
+int parseTxtLine( const std::string& rLine, bool rRgbInt, float* rCoords, float* rColor, int* rColorInt ) {
+	std::istringstream lineStream( rLine );
+	std::string token;
+	int varsParsed = 0;
+	while( ( varsParsed < 6 ) && ( lineStream >> token ) ) {
+		bool parsed;
+		if( varsParsed < 3 ) {
+			parsed = parseNumber( token, rCoords[varsParsed] );
+		} else if( rRgbInt ) {
+			parsed = parseNumber( token, rColorInt[varsParsed - 3] );
+		} else {
+			parsed = parseNumber( token, rColor[varsParsed - 3] );
+		}
+		if( !parsed ) {
+			break;
+		}
+		varsParsed++;
+	}
+	return( varsParsed );
+}
+
 bool TxtReader::readFile(const std::filesystem::path& rFilename, std::vector<sVertexProperties>& rVertexProps, std::vector<sFaceProperties>& rFaceProps, MeshSeedExt& rMeshSeed)
 {
 	//! Reads a simple ASCII file having X,Y,Z and R,G,B per line.
 
-	auto oldLocale = std::setlocale(LC_NUMERIC,"");
-	std::setlocale(LC_NUMERIC,"C");
-
-
 	fstream filestr;
 	string  lineToParse;
 	int     linesRead     = 1;
@@ -48,19 +71,20 @@ bool TxtReader::readFile(const std::filesystem::path& rFilename, std::vector<sVe
 	timeStart = clock();
 	filestr.open( rFilename, fstream::in );
 
-	int   texR, texG, texB;
-	float texRf, texGf, texBf;
-	float someCoordX, someCoordY, someCoordZ; // for testing sscanf and nothing else.
+	int   texRGB[3];
+	float texRGBf[3];
+	float someCoord[3];
 	int  varsParsed;
 
 	getline( filestr, lineToParse );
-	varsParsed = sscanf( lineToParse.c_str(), "%f %f %f %i %i %i", &someCoordX, &someCoordY, &someCoordZ, &texR, &texG, &texB );
+	varsParsed = parseTxtLine( lineToParse, true, someCoord, texRGBf, texRGB );
 	if( varsParsed == 6 ) {
 		rgbFloat = false;
 		cout << "[TxtReader::readTXT] RGB is int." << endl;
 	} else {
 		cout << "[TxtReader::readTXT] RGB is float or not existing." << endl;
 	}
+	filestr.clear();
 	filestr.seekg( 0, ios::beg );
 
 	struct Pos{
@@ -80,22 +104,22 @@ bool TxtReader::readFile(const std::filesystem::path& rFilename, std::vector<sVe
 	std::list<Pos> positions;
 	std::list<Col> colors;
 
-	while( !filestr.eof() ) {
-		if( rgbFloat ) {
-			varsParsed = sscanf( lineToParse.c_str(), "%f %f %f %f %f %f", &someCoordX, &someCoordY, &someCoordZ, &texRf, &texGf, &texBf );
-			positions.emplace_back(Pos(someCoordX,someCoordY,someCoordZ));
-			colors.emplace_back(Col(texRf * 255.0f, texGf * 255.0f, texBf * 255.0f));
-		} else {
-			varsParsed = sscanf( lineToParse.c_str(), "%f %f %f %i %i %i", &someCoordX, &someCoordY, &someCoordZ, &texR, &texG, &texB );
-			positions.emplace_back(Pos(someCoordX,someCoordY,someCoordZ));
-			colors.emplace_back(Col(texR, texG, texB));
-		}
+	// Parse from the start, as the first line was only read to detect the type of RGB.
+	while( getline( filestr, lineToParse ) ) {
+		texRGBf[0] = texRGBf[1] = texRGBf[2] = 187.0f / 255.0f;
+		texRGB[0] = texRGB[1] = texRGB[2] = 187;
+		varsParsed = parseTxtLine( lineToParse, !rgbFloat, someCoord, texRGBf, texRGB );
 		if( ( varsParsed == 3 ) || ( varsParsed == 6 ) ) {
+			positions.emplace_back(Pos(someCoord[0],someCoord[1],someCoord[2]));
+			if( rgbFloat ) {
+				colors.emplace_back(Col(texRGBf[0] * 255.0f, texRGBf[1] * 255.0f, texRGBf[2] * 255.0f));
+			} else {
+				colors.emplace_back(Col(texRGB[0], texRGB[1], texRGB[2]));
+			}
 			linesVertices++;
 		} else {
 			cerr << "[TxtReader] Problem in line " << linesRead << " parsed: " << varsParsed << " - " << lineToParse << endl;
 		}
-		getline( filestr, lineToParse );
 		linesRead++;
 	}
 
@@ -141,6 +165,5 @@ bool TxtReader::readFile(const std::filesystem::path& rFilename, std::vector<sVe
 	timeStop  = clock();
 	std::cout << "[TxtReader] read XYZ/TXT 2nd parse:      " << static_cast<float>( timeStop - timeStart ) / CLOCKS_PER_SEC << " seconds. " << std::endl;
 
-	std::setlocale( LC_NUMERIC, oldLocale );
 	return( true );
 }
@@ -21,6 +21,9 @@
 //
 
 #include "TxtWriter.h"
+#include <fstream>
+
+#include <GigaMesh/logging/Logging.h>
 
 TxtWriter::TxtWriter()
 {
@@ -28,11 +31,46 @@ TxtWriter::TxtWriter()
 }
 
 
+//! Writes a simple ASCII file having X,Y,Z and R,G,B per line as read by TxtReader.
+//! Faces can not be stored and are ignored i.e. the vertices are written as point cloud.
 bool TxtWriter::writeFile(const std::filesystem::path& rFilename, const std::vector<sVertexProperties>& rVertexProps, const std::vector<sFaceProperties>& rFaceProps, MeshSeedExt& rMeshSeed)
 {
-	std::cerr << "[TxtWriter::" << __FUNCTION__ << "] NOT IMPLEMENTED - File " << rFilename << "not written!" << std::endl;
-	std::cerr << "[TxtWriter::" << __FUNCTION__ << "] Vertex count:  " << rVertexProps.size() << "not written!" << std::endl;
-	std::cerr << "[TxtWriter::" << __FUNCTION__ << "] Face count:  " << rFaceProps.size() << "not written!" << std::endl;
+	std::fstream filestr;
+	filestr.open( rFilename, std::fstream::out | std::fstream::binary );
+	if( !filestr.is_open() ) {
+		LOG::error() << "[TxtWriter::" << __FUNCTION__ << "] ERROR: Could not open file: '" << rFilename << "'!\n";
+		return false;
+	}
+	if( !rFaceProps.empty() ) {
+		LOG::warn() << "[TxtWriter::" << __FUNCTION__ << "] Faces can not be stored. " << rFaceProps.size() << " faces ignored.\n";
+	}
+	if( rMeshSeed.getPolyLineNr() > 0 ) {
+		LOG::warn() << "[TxtWriter::" << __FUNCTION__ << "] Polylines can not be stored. " << rMeshSeed.getPolyLineNr() << " polylines ignored.\n";
+	}
+
+	writeChunksOrdered( filestr, rVertexProps.size(), [&rVertexProps]( uint64_t rVertIdxBegin, uint64_t rVertIdxEnd, std::string& rText ) {
+		for( uint64_t vertIdx=rVertIdxBegin; vertIdx<rVertIdxEnd; vertIdx++ ) {
+			const sVertexProperties& vertexProp = rVertexProps[vertIdx];
+			appendNumber( rText, vertexProp.mCoordX );
+			rText += ' ';
+			appendNumber( rText, vertexProp.mCoordY );
+			rText += ' ';
+			appendNumber( rText, vertexProp.mCoordZ );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorRed ) );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorGrn ) );
+			rText += ' ';
+			appendNumber( rText, static_cast<unsigned short>( vertexProp.mColorBle ) );
+			rText += '\n';
+		}
+	} );
+	filestr.close();
+	if( filestr.fail() ) {
+		LOG::error() << "[TxtWriter::" << __FUNCTION__ << "] ERROR: Could not write file: '" << rFilename << "'!\n";
+		return false;
+	}
 
-	return false;
+	LOG::debug() << "[TxtWriter::" << __FUNCTION__ << "] " << rVertexProps.size() << " vertices written to '" << rFilename << "'.\n";
+	return true;
 }
@@ -0,0 +1,152 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/ambientocclusion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/icoSphereTree/IcoSphereTree.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Vertices per chunk processed by one thread.
+	constexpr uint64_t vertsPerChunk = 16384;
+
+	//! Limit of the slope used for the depth bias - faces seen at grazing angles would get an infinite bias.
+	constexpr double maxSlope = 16.0;
+}
+
+//! Constructor fetching the vertex and face data - see RenderOrtho.
+AmbientOcclusion::AmbientOcclusion( Mesh* rMesh ) : mRenderer( rMesh ) {
+}
+
+//! Computes the ambient occlusion per vertex.
+//! rValues gets one value per vertex in the order of the vertices.
+//!
+//! @returns false in case of an error.
+bool AmbientOcclusion::compute(
+                const sParams&  rParams,   //!< Resolution, directions and tolerances.
+                vector<double>& rValues    //!< Resulting value per vertex.
+) const {
+	PROFILE_SCOPE( "AmbientOcclusion::compute" );
+	const vector<double>& positions = mRenderer.getPositions();
+	const vector<float>&  normals   = mRenderer.getNormals();
+	const uint64_t vertexCount = positions.size() / 3;
+	if( vertexCount == 0 ) {
+		LOG::error() << "[AmbientOcclusion::" << __FUNCTION__ << "] ERROR: No vertices!\n";
+		return( false );
+	}
+	if( ( rParams.mResolution == 0 ) || ( rParams.mTileSize == 0 ) ) {
+		LOG::error() << "[AmbientOcclusion::" << __FUNCTION__ << "] ERROR: Resolution and tile size have to be positive!\n";
+		return( false );
+	}
+	if( !( rParams.mZTolerance >= 0.0 ) || !( rParams.mDepthBias >= 0.0 ) ) {
+		LOG::error() << "[AmbientOcclusion::" << __FUNCTION__ << "] ERROR: Tolerance and depth bias must not be negative!\n";
+		return( false );
+	}
+
+	// Diameter of the mesh i.e. diagonal of the bounding box, which limits the extent of any view.
+	double minPos[3] { +numeric_limits<double>::infinity(), +numeric_limits<double>::infinity(), +numeric_limits<double>::infinity() };
+	double maxPos[3] { -numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(), -numeric_limits<double>::infinity() };
+	for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+		for( int i = 0; i < 3; i++ ) {
+			if( isfinite( positions[vertIdx*3+i] ) ) {
+				minPos[i] = min( minPos[i], positions[vertIdx*3+i] );
+				maxPos[i] = max( maxPos[i], positions[vertIdx*3+i] );
+			}
+		}
+	}
+	const double diameter = sqrt( pow( maxPos[0] - minPos[0], 2.0 ) + pow( maxPos[1] - minPos[1], 2.0 ) + pow( maxPos[2] - minPos[2], 2.0 ) );
+	if( !isfinite( diameter ) || !( diameter > 0.0 ) ) {
+		LOG::error() << "[AmbientOcclusion::" << __FUNCTION__ << "] ERROR: Mesh has no extent!\n";
+		return( false );
+	}
+
+	RenderOrtho::sParams renderParams;
+	renderParams.mDPI         = 25.4 * static_cast<double>( rParams.mResolution ) / diameter; // RenderOrtho assumes mm.
+	renderParams.mTileSize    = rParams.mTileSize;
+	renderParams.mThreadCount = rParams.mThreadCount;
+	renderParams.mLighting    = false;
+	renderParams.mDepthOnly   = true;
+	const unsigned int threadCount = ParallelFor::getThreadCount( rParams.mThreadCount );
+	const double toleranceAbs = rParams.mZTolerance * diameter;
+	const double pixelSize    = diameter / static_cast<double>( rParams.mResolution );
+
+	rValues.assign( vertexCount, 0.0 );
+	const vector<Vector3D> directions = getDirections( rParams.mSubdivisions );
+	const uint64_t chunkCount = ParallelFor::getChunkCount( vertexCount, vertsPerChunk );
+	RenderOrtho::sImage image;
+	for( const Vector3D& direction : directions ) {
+		// Any up vector not parallel to the direction:
+		const Vector3D up = ( fabs( direction.getZ() ) < 0.9 ) ? Vector3D( 0.0, 0.0, 1.0 ) : Vector3D( 1.0, 0.0, 0.0 );
+		const RenderOrtho::sView view { "ambient_occlusion", direction, up };
+		if( !mRenderer.render( view, renderParams, image ) ) {
+			return( false );
+		}
+		ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+			const uint64_t vertIdxEnd = min( ( rChunkIdx + 1 ) * vertsPerChunk, vertexCount );
+			for( uint64_t vertIdx = rChunkIdx * vertsPerChunk; vertIdx < vertIdxEnd; vertIdx++ ) {
+				const float* normal = &normals[vertIdx*3];
+				const double cosAngle = normal[0]*direction.getX() + normal[1]*direction.getY() + normal[2]*direction.getZ();
+				if( !( cosAngle > 0.0 ) ) {
+					continue; // Facing away or without normal.
+				}
+				double pixelX = 0.0;
+				double pixelY = 0.0;
+				double depth  = 0.0;
+				if( !image.project( Vector3D( positions[vertIdx*3], positions[vertIdx*3+1], positions[vertIdx*3+2] ), pixelX, pixelY, depth ) ) {
+					continue;
+				}
+				const uint64_t column = min( static_cast<uint64_t>( max( pixelX, 0.0 ) ), image.mWidth - 1 );
+				const uint64_t row    = min( static_cast<uint64_t>( max( pixelY, 0.0 ) ), image.mHeight - 1 );
+				// The depth is sampled at the center of the pixel, so the offset depends on the slope of the surface:
+				const double slope = min( sqrt( max( 1.0 - cosAngle*cosAngle, 0.0 ) ) / cosAngle, maxSlope );
+				const double bias  = rParams.mDepthBias * pixelSize * ( 1.0 + slope );
+				if( depth + toleranceAbs + bias >= image.mDepth[row*image.mWidth+column] ) {
+					rValues[vertIdx] += min( cosAngle, 1.0 );
+				}
+			}
+		} );
+	}
+	return( true );
+}
+
+//! Directions towards the light given by the vertices of an IcoSphereTree.
+//! @returns unit vectors evenly distributed on the sphere.
+vector<Vector3D> AmbientOcclusion::getDirections( unsigned int rSubdivisions ) {
+	const IcoSphereTree icoSphere( rSubdivisions );
+	const vector<float> vertices = icoSphere.getVertices();
+	vector<Vector3D> directions;
+	directions.reserve( vertices.size() / 3 );
+	for( size_t i = 0; i + 2 < vertices.size(); i += 3 ) {
+		Vector3D direction( vertices[i], vertices[i+1], vertices[i+2] );
+		direction.normalize3();
+		directions.push_back( direction );
+	}
+	return( directions );
+}
@@ -0,0 +1,187 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <GigaMesh/mesh/batchprocessing.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h> // sysconf
+#endif
+
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+//! Processes the given files using rParams.mJobs worker threads.
+//! The files are started in the given order, but may finish in any order.
+//!
+//! @returns false, when at least one file failed. True otherwise.
+bool BatchProcessing::run(
+                const std::vector<std::filesystem::path>& rFileNames,
+                const sParams&                            rParams,
+                const tFileFunc&                          rFileFunc,
+                sStats&                                   rStats
+) {
+	PROFILE_SCOPE( "BatchProcessing::run" );
+	rStats = sStats();
+	const auto timeStart = std::chrono::steady_clock::now();
+
+	// Estimate the memory per file.
+	std::vector<uint64_t> fileSizes( rFileNames.size() );
+	std::vector<uint64_t> memoryEstimates( rFileNames.size() );
+	for( size_t fileIdx = 0; fileIdx < rFileNames.size(); fileIdx++ ) {
+		fileSizes[fileIdx]       = getFileSize( rFileNames[fileIdx] );
+		memoryEstimates[fileIdx] = static_cast<uint64_t>( static_cast<double>( fileSizes[fileIdx] ) * rParams.mMemoryPerFileByte );
+	}
+	uint64_t memoryBudget = rParams.mMemoryBudget;
+	if( memoryBudget == 0 ) {
+		memoryBudget = ( getPhysicalMemory() / 4 ) * 3;
+		if( memoryBudget == 0 ) {
+			memoryBudget = std::numeric_limits<uint64_t>::max();
+		}
+	}
+	rStats.mJobs = static_cast<unsigned int>( std::min<uint64_t>( ParallelFor::getThreadCount( rParams.mJobs ),
+	                                                                std::max<size_t>( rFileNames.size(), 1 ) ) );
+
+	// State shared by the workers:
+	std::mutex              stateMutex;
+	std::condition_variable stateChanged;
+	size_t                  nextFileIdx    = 0;
+	uint64_t                memoryInUse    = 0;
+	unsigned int            filesRunning   = 0;
+	bool                    errorOccurred  = false;
+
+	auto worker = [&]() {
+		while( true ) {
+			size_t fileIdx;
+			{
+				std::unique_lock<std::mutex> lock( stateMutex );
+				// Wait until the next file fits into the budget or nothing else is running.
+				stateChanged.wait( lock, [&]() {
+					return( ( nextFileIdx >= rFileNames.size() ) ||
+					        ( rParams.mStopOnError && errorOccurred ) ||
+					        ( filesRunning == 0 ) ||
+					        ( memoryEstimates[nextFileIdx] <= memoryBudget - std::min( memoryInUse, memoryBudget ) ) );
+				} );
+				if( nextFileIdx >= rFileNames.size() ) {
+					return;
+				}
+				if( rParams.mStopOnError && errorOccurred ) {
+					rStats.mFilesSkipped += rFileNames.size() - nextFileIdx;
+					nextFileIdx = rFileNames.size();
+					stateChanged.notify_all();
+					return;
+				}
+				fileIdx = nextFileIdx++;
+				memoryInUse += memoryEstimates[fileIdx];
+				filesRunning++;
+			}
+
+			bool fileSuccess = false;
+			try {
+				PROFILE_SCOPE( "BatchProcessing::file" );
+				fileSuccess = rFileFunc( fileIdx, rFileNames[fileIdx] );
+			} catch( const std::exception& rException ) {
+				LOG::error() << "[BatchProcessing::" << __FUNCTION__ << "] ERROR: " << rException.what()
+				             << " for " << rFileNames[fileIdx].string() << "!\n";
+			}
+
+			{
+				std::lock_guard<std::mutex> lock( stateMutex );
+				memoryInUse -= memoryEstimates[fileIdx];
+				filesRunning--;
+				if( fileSuccess ) {
+					rStats.mFilesProcessed++;
+					rStats.mBytesProcessed += fileSizes[fileIdx];
+				} else {
+					rStats.mFilesFailed++;
+					errorOccurred = true;
+				}
+			}
+			stateChanged.notify_all();
+		}
+	};
+
+	std::vector<std::future<void>> workerHandles;
+	for( unsigned int jobIdx = 1; jobIdx < rStats.mJobs; jobIdx++ ) {
+		workerHandles.push_back( std::async( std::launch::async, worker ) );
+	}
+	worker();
+	for( std::future<void>& workerHandle : workerHandles ) {
+		workerHandle.get();
+	}
+
+	rStats.mSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - timeStart ).count();
+	PROFILE::counter( "Batch files processed", static_cast<double>( rStats.mFilesProcessed ) );
+	return( rStats.mFilesFailed == 0 );
+}
+
+//! @returns the size of the physical memory in bytes or zero, when unknown.
+uint64_t BatchProcessing::getPhysicalMemory() {
+#ifdef _WIN32
+	MEMORYSTATUSEX memoryStatus;
+	memoryStatus.dwLength = sizeof( memoryStatus );
+	if( GlobalMemoryStatusEx( &memoryStatus ) ) {
+		return( static_cast<uint64_t>( memoryStatus.ullTotalPhys ) );
+	}
+	return( 0 );
+#else
+	const long pageCount = sysconf( _SC_PHYS_PAGES );
+	const long pageSize  = sysconf( _SC_PAGE_SIZE );
+	if( ( pageCount <= 0 ) || ( pageSize <= 0 ) ) {
+		return( 0 );
+	}
+	return( static_cast<uint64_t>( pageCount ) * static_cast<uint64_t>( pageSize ) );
+#endif
+}
+
+//! @returns the size of the given file in bytes or zero, when it can not be determined.
+uint64_t BatchProcessing::getFileSize( const std::filesystem::path& rFileName ) {
+	std::error_code errorCode;
+	const uintmax_t fileSize = std::filesystem::file_size( rFileName, errorCode );
+	if( errorCode ) {
+		return( 0 );
+	}
+	return( static_cast<uint64_t>( fileSize ) );
+}
+
+//! Shows the aggregated throughput of the batch.
+void BatchProcessing::sStats::print( std::ostream& rOutput ) const {
+	const double megaBytes = static_cast<double>( mBytesProcessed ) / ( 1024.0 * 1024.0 );
+	const double seconds   = std::max( mSeconds, std::numeric_limits<double>::min() );
+	rOutput << "[GigaMesh] Batch of " << ( mFilesProcessed + mFilesFailed + mFilesSkipped ) << " files using "
+	        << mJobs << " job(s):" << std::endl;
+	rOutput << "[GigaMesh]   Processed: " << mFilesProcessed << " Failed: " << mFilesFailed
+	        << " Skipped: " << mFilesSkipped << std::endl;
+	rOutput << std::fixed << std::setprecision( 3 );
+	rOutput << "[GigaMesh]   Throughput: " << static_cast<double>( mFilesProcessed ) / seconds << " files/s and "
+	        << megaBytes / seconds << " MB/s (" << megaBytes << " MB in " << mSeconds << " sec)" << std::endl;
+	rOutput << std::defaultfloat;
+}
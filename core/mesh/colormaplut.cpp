@@ -0,0 +1,250 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/colormaplut.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+// The AVX2 kernel is compiled for x86 with GCC and Clang independent of the target flags
+// and chosen at runtime. Other compilers and CPUs use the scalar fallback.
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	#define COLORMAPLUT_AVX2
+	#include <immintrin.h>
+	#define TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#endif
+
+using namespace std;
+
+namespace {
+	//! Values per chunk processed by one thread.
+	constexpr uint64_t valuesPerChunk = 65536;
+
+	//! Texture coordinates of the colour map image keep half a texel distance to the border - see shaders/funcval.vert.
+	constexpr double texCoordScale  = 511.0/512.0;
+	constexpr double texCoordOffset = 0.5/512.0;
+
+	//! Parameters derived once by ColorMapLut::build.
+	struct sKernel {
+		const uint32_t* mTable;    //!< RGBA per entry.
+		bool            mRepeat;   //!< Fold the values by the repetition interval.
+		double          mOffset;   //!< Subtracted before scaling.
+		double          mScale;    //!< Range to [0,1] or reciprocal of the interval.
+		double          mInterval; //!< Repetition interval.
+		double          mGamma;    //!< Exponent applied to the normalized value before quantisation - one for mRepeat.
+	};
+
+	//! Quantises one value using the same operations as the AVX2 kernel.
+	//! The comparisons are ordered as _mm256_min_pd and _mm256_max_pd,
+	//! which return the 2nd operand for not-a-number.
+	inline uint32_t lookupScalar( double rFuncVal, const sKernel& rKernel ) {
+		double normalized;
+		if( rKernel.mRepeat ) {
+			const double quotient  = trunc( rFuncVal * rKernel.mScale );
+			const double remainder = rFuncVal - quotient * rKernel.mInterval;
+			normalized = fabs( remainder + remainder ) * rKernel.mScale;
+			const double folded = 2.0 - normalized;
+			normalized = ( normalized < folded ) ? normalized : folded;
+		} else {
+			normalized = ( rFuncVal - rKernel.mOffset ) * rKernel.mScale;
+		}
+		normalized = ( normalized > 0.0 ) ? normalized : 0.0;
+		normalized = ( normalized < 1.0 ) ? normalized : 1.0;
+		if( rKernel.mGamma != 1.0 ) {
+			// Applied before quantisation as the low end collapses otherwise for a gamma below one.
+			normalized = pow( normalized, rKernel.mGamma );
+			normalized = ( normalized > 0.0 ) ? normalized : 0.0; // also for not-a-number e.g. by a negative gamma.
+			normalized = ( normalized < 1.0 ) ? normalized : 1.0;
+		}
+		const int32_t lutIdx = static_cast<int32_t>( normalized * static_cast<double>( ColorMapLut::LUT_SIZE - 1 ) + 0.5 );
+		return( rKernel.mTable[lutIdx] );
+	}
+
+	void applyScalar( const double* rFuncVals, uint64_t rStart, uint64_t rEnd, const sKernel& rKernel, uint8_t* rRGBA ) {
+		for( uint64_t i=rStart; i<rEnd; i++ ) {
+			const uint32_t color = lookupScalar( rFuncVals[i], rKernel );
+			memcpy( rRGBA + 4*i, &color, 4 );
+		}
+	}
+
+#ifdef COLORMAPLUT_AVX2
+	//! Four values at once - quantised and gathered. The remaining values are processed by lookupScalar.
+	//! Requires a gamma of one as there is no vectorized pow.
+	TARGET_AVX2 void applyAVX2( const double* rFuncVals, uint64_t rStart, uint64_t rEnd, const sKernel& rKernel, uint8_t* rRGBA ) {
+		const __m256d signMask = _mm256_set1_pd( -0.0 );
+		const __m256d zeros    = _mm256_setzero_pd();
+		const __m256d ones     = _mm256_set1_pd( 1.0 );
+		const __m256d twos     = _mm256_set1_pd( 2.0 );
+		const __m256d halfs    = _mm256_set1_pd( 0.5 );
+		const __m256d maxIdx   = _mm256_set1_pd( static_cast<double>( ColorMapLut::LUT_SIZE - 1 ) );
+		const __m256d offset   = _mm256_set1_pd( rKernel.mOffset );
+		const __m256d scale    = _mm256_set1_pd( rKernel.mScale );
+		const __m256d interval = _mm256_set1_pd( rKernel.mInterval );
+		const int*    table    = reinterpret_cast<const int*>( rKernel.mTable );
+		uint64_t i = rStart;
+		for( ; i+4 <= rEnd; i+=4 ) {
+			const __m256d funcVals = _mm256_loadu_pd( rFuncVals + i );
+			__m256d normalized;
+			if( rKernel.mRepeat ) {
+				const __m256d quotient  = _mm256_round_pd( _mm256_mul_pd( funcVals, scale ), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC );
+				const __m256d remainder = _mm256_sub_pd( funcVals, _mm256_mul_pd( quotient, interval ) );
+				normalized = _mm256_mul_pd( _mm256_andnot_pd( signMask, _mm256_add_pd( remainder, remainder ) ), scale );
+				normalized = _mm256_min_pd( normalized, _mm256_sub_pd( twos, normalized ) );
+			} else {
+				normalized = _mm256_mul_pd( _mm256_sub_pd( funcVals, offset ), scale );
+			}
+			normalized = _mm256_min_pd( _mm256_max_pd( normalized, zeros ), ones );
+			const __m128i lutIdx = _mm256_cvttpd_epi32( _mm256_add_pd( _mm256_mul_pd( normalized, maxIdx ), halfs ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( rRGBA + 4*i ), _mm_i32gather_epi32( table, lutIdx, 4 ) );
+		}
+		applyScalar( rFuncVals, i, rEnd, rKernel, rRGBA );
+	}
+#endif
+}
+
+//! Builds the table from a colour ramp.
+//!
+//! Each entry holds the colour of the texel of the ramp, which the shader
+//! samples for the normalized function value of the entry. The gamma is
+//! applied per function value before the lookup. Alpha is opaque.
+//! An empty or not finite range maps all values to the lowest colour.
+//!
+//! @returns false in case of an error. True otherwise.
+bool ColorMapLut::build(
+                const uint8_t* rRampRGB,     //!< Colour ramp as RGB triplets from low to high.
+                uint64_t       rRampWidth,   //!< Number of RGB triplets of the ramp.
+                const sParams& rParams       //!< Range and options.
+) {
+	if( rRampRGB == nullptr ) {
+		LOG::error() << "[ColorMapLut::" << __FUNCTION__ << "] ERROR: NULL pointer given!\n";
+		return( false );
+	}
+	if( rRampWidth == 0 ) {
+		LOG::error() << "[ColorMapLut::" << __FUNCTION__ << "] ERROR: Empty colour ramp given!\n";
+		return( false );
+	}
+	if( rParams.mRepeat && !( isfinite( rParams.mRepeatInterval ) && ( rParams.mRepeatInterval > 0.0 ) ) ) {
+		LOG::error() << "[ColorMapLut::" << __FUNCTION__ << "] ERROR: Invalid repetition interval " << rParams.mRepeatInterval << "!\n";
+		return( false );
+	}
+
+	mParams = rParams;
+	if( mParams.mRepeat ) {
+		mOffset = 0.0;
+		mScale  = 1.0 / mParams.mRepeatInterval;
+	} else {
+		const double range = mParams.mFuncValMax - mParams.mFuncValMin;
+		mOffset = isfinite( mParams.mFuncValMin ) ? mParams.mFuncValMin : 0.0;
+		mScale  = ( isfinite( range ) && ( range > 0.0 ) ) ? ( 1.0 / range ) : 0.0;
+		if( mScale == 0.0 ) {
+			LOG::warn() << "[ColorMapLut::" << __FUNCTION__ << "] Empty range [" << mParams.mFuncValMin
+			            << ", " << mParams.mFuncValMax << "] - using the lowest colour!\n";
+		}
+	}
+
+	const double rampWidth = static_cast<double>( rRampWidth );
+	mTable.resize( LUT_SIZE );
+	for( uint64_t lutIdx=0; lutIdx<LUT_SIZE; lutIdx++ ) {
+		const double normalized = static_cast<double>( lutIdx ) / static_cast<double>( LUT_SIZE - 1 );
+		double texCoord = texCoordScale * normalized + texCoordOffset;
+		if( mParams.mInvert ) {
+			texCoord = 1.0 - texCoord;
+		}
+		double texelPos = floor( rampWidth * texCoord );
+		texelPos = ( texelPos > 0.0 ) ? texelPos : 0.0;
+		const uint64_t texelIdx = min( static_cast<uint64_t>( min( texelPos, rampWidth ) ), rRampWidth - 1 );
+		const uint8_t rgba[4] = { rRampRGB[texelIdx*3], rRampRGB[texelIdx*3+1], rRampRGB[texelIdx*3+2], 255 };
+		memcpy( &mTable[lutIdx], rgba, 4 );
+	}
+	return( true );
+}
+
+//! Colour of a single function value.
+void ColorMapLut::getColor(
+                double   rFuncVal,   //!< Function value e.g. of a vertex.
+                uint8_t* rRGBA       //!< Four bytes: red, green, blue and alpha.
+) const {
+	if( mTable.empty() ) {
+		memset( rRGBA, 0, 4 );
+		return;
+	}
+	const sKernel kernel { mTable.data(), mParams.mRepeat, mOffset, mScale, mParams.mRepeatInterval,
+	                       mParams.mRepeat ? 1.0 : mParams.mGamma };
+	const uint32_t color = lookupScalar( rFuncVal, kernel );
+	memcpy( rRGBA, &color, 4 );
+}
+
+//! Colours of a contiguous array of function values.
+//! rRGBA has to hold four bytes - red, green, blue and alpha - per value.
+//!
+//! @returns false in case of an error. True otherwise.
+bool ColorMapLut::apply(
+                const double* rFuncVals,      //!< Function values e.g. one per vertex.
+                uint64_t      rCount,         //!< Number of function values.
+                uint8_t*      rRGBA,          //!< Colours in the order of the function values.
+                unsigned int  rThreadCount,   //!< Number of threads - zero uses all available cores.
+                bool          rAllowSIMD      //!< Use AVX2, when supported by the CPU.
+) const {
+	PROFILE_SCOPE( "ColorMapLut::apply" );
+	if( mTable.empty() ) {
+		LOG::error() << "[ColorMapLut::" << __FUNCTION__ << "] ERROR: Table not built!\n";
+		return( false );
+	}
+	if( rCount == 0 ) {
+		return( true );
+	}
+	if( ( rFuncVals == nullptr ) || ( rRGBA == nullptr ) ) {
+		LOG::error() << "[ColorMapLut::" << __FUNCTION__ << "] ERROR: NULL pointer given!\n";
+		return( false );
+	}
+
+	const sKernel kernel { mTable.data(), mParams.mRepeat, mOffset, mScale, mParams.mRepeatInterval,
+	                       mParams.mRepeat ? 1.0 : mParams.mGamma };
+	[[maybe_unused]] const bool useAVX2 = rAllowSIMD && ( kernel.mGamma == 1.0 ) && hasAVX2();
+	const uint64_t chunkCount = ParallelFor::getChunkCount( rCount, valuesPerChunk );
+	ParallelFor::forEachChunk( chunkCount, ParallelFor::getThreadCount( rThreadCount ), [&]( uint64_t rChunkIdx ) {
+		const uint64_t valueStart = rChunkIdx * valuesPerChunk;
+		const uint64_t valueEnd   = min( valueStart + valuesPerChunk, rCount );
+#ifdef COLORMAPLUT_AVX2
+		if( useAVX2 ) {
+			applyAVX2( rFuncVals, valueStart, valueEnd, kernel, rRGBA );
+			return;
+		}
+#endif
+		applyScalar( rFuncVals, valueStart, valueEnd, kernel, rRGBA );
+	} );
+	return( true );
+}
+
+bool ColorMapLut::hasAVX2() {
+#ifdef COLORMAPLUT_AVX2
+	static const bool cpuSupportsAVX2 = __builtin_cpu_supports( "avx2" );
+	return( cpuSupportsAVX2 );
+#else
+	return( false );
+#endif
+}
@@ -25,6 +25,8 @@
 #include <future>
 
 #include <GigaMesh/mesh/compfeaturevecs.h>
+#include <GigaMesh/profiling/Profiling.h>
+#include <GigaMesh/getlocaltime.h>
 
 // Multithreading (CPU):
 #define THREADS_VERTEX_BLOCK  5000
@@ -38,6 +40,7 @@ void compFeatureVectorsThread(
                 const size_t       rThreadOffset,
                 const size_t       rThreadVertexCount
 ) {
+	PROFILE_SCOPE( "MSII::compFeatureVectorsThread" );
 
 	const int threadID = rMeshData->threadID;
 
@@ -68,12 +71,11 @@ void compFeatureVectorsThread(
 	// Processing time
 	std::chrono::system_clock::time_point tStart = std::chrono::system_clock::now();
 
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited{nullptr};
-	const uint64_t vertNrLongs = rMeshData->meshToAnalyze->getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited{nullptr};
-	const uint64_t faceNrLongs = rMeshData->meshToAnalyze->getBitArrayFaces( &faceBitArrayVisited );
+	// Per-thread sets of visited vertices and faces - reset in O(1) per patch:
+	VisitedSet vertsVisited;
+	rMeshData->meshToAnalyze->getVisitedSetVerts( vertsVisited );
+	VisitedSet facesVisited;
+	rMeshData->meshToAnalyze->getVisitedSetFaces( facesVisited );
 
 	// Compute absolut radii (used to normalize the surface descriptor)
 	double* absolutRadii = new double[rMeshData->multiscaleRadiiSize];
@@ -103,9 +105,8 @@ void compFeatureVectorsThread(
 		//meshData->meshToAnalyze->fetchSphereMarching( currentVertex, &facesInSphere, meshData->radius, true );
 		//meshData->meshToAnalyze->fetchSphereMarchingDualFront( currentVertex, &facesInSphere, meshData->radius, true );
 		//meshData->meshToAnalyze->fetchSphereBitArray( currentVertex, &facesInSphere, meshData->radius, vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited );
-		rMeshData->meshToAnalyze->fetchSphereBitArray1R( currentVertex, facesInSphere, rMeshData->radius, 
-		                                                 vertNrLongs, vertBitArrayVisited, 
-		                                                 faceNrLongs, faceBitArrayVisited, false );
+		rMeshData->meshToAnalyze->fetchSphereBitArray1R( currentVertex, facesInSphere, rMeshData->radius,
+		                                                 vertsVisited, facesVisited, false );
 
 		// Fetch and store the normal used in fetchSphereCubeVolume25D as it is a quality measure
 		if( tNormalSurfacePatch ) {
@@ -162,7 +163,7 @@ void compFeatureVectorsThread(
 				std::cout << "[GigaMesh] Thread " << threadID << " | " << percentDone*100 << " percent done. Time elapsed: " << time_elapsed << " - ";
 				std::cout << "remaining: " << time_remaining << " seconds. ";
 				std::cout << vertexOriIdxInProgress/time_elapsed << " Vert/sec. ";
-				std::cout << "ETF: " << std::ctime(&ttp);
+				std::cout << "ETF: " << getLocalTimeStr( ttp );
 				std::cout << std::flush;
 			}
 		}
@@ -170,12 +171,11 @@ void compFeatureVectorsThread(
 
 	// Volume descriptor
 	delete[] rasterArray;
-	delete vertBitArrayVisited;
-	delete faceBitArrayVisited;
 	// Surface descriptor
 	delete[] absolutRadii;
 
 	rMeshData->mWallTimeThread = static_cast<int>( time( nullptr ) ) - static_cast<int>( timeStampThread ); // seconds
+	PROFILE::counter( "MSII vertices processed", static_cast<double>( rMeshData->ctrProcessed ) );
 
 	{
 		std::lock_guard<std::mutex> lock(stdoutMutex);
@@ -192,6 +192,7 @@ void compFeatureVectorsMain(
                 sMeshDataStruct*   rMeshData,
                 const unsigned int rThreadVertexCount
 ) {
+	PROFILE_SCOPE( "MSII::compFeatureVectorsMain" );
 	// Sanity check
 	if( rMeshData == nullptr ) {
 		std::cout << "[GigaMesh::" << __FUNCTION__ << "] ERROR: nullptr given!" << std::endl;
@@ -199,12 +200,8 @@ void compFeatureVectorsMain(
 	}
 
 	// +++ Time for parallel processing
-	time_t rawtime;
-	struct tm* timeinfo{nullptr};
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
 	time_t timeStampParallel = time( nullptr ); // clock() is not multi-threading save (to measure the non-CPU or real time ;) )
-	std::cout << "[GigaMesh] Time started: " << asctime( timeinfo );// << std::endl;
+	std::cout << "[GigaMesh] Time started: " << getLocalTimeStr( timeStampParallel );// << std::endl;
 	std::cout << "[GigaMesh] --------------------------------------------------" << std::endl;
 	// --- Time for parallel processing
 
@@ -272,9 +269,7 @@ void compFeatureVectorsMain(
 	std::cout << "[GigaMesh] --------------------------------------------------" << std::endl;
 
 	// +++ Time for parallel processing
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	std::cout << "[GigaMesh] Time finished:      " << asctime( timeinfo ); // << endl;
+	std::cout << "[GigaMesh] Time finished:      " << getLocalTimeStr( time( nullptr ) ); // << endl;
 	std::cout << "[GigaMesh] --------------------------------------------------" << std::endl;
 	std::cout << "[GigaMesh] Vertices processed: " << ctrProcessed << std::endl;
 	std::cout << "[GigaMesh] Vertices ignored:   " << ctrIgnored << std::endl;
@@ -32,6 +32,7 @@
 #include <GigaMesh/mesh/vertexofface.h>
 #include <GigaMesh/mesh/edgegeodesic.h>
 #include <GigaMesh/mesh/plane.h>
+#include <GigaMesh/mesh/visitedset.h>
 
 #include <GigaMesh/logging/Logging.h>
 
@@ -58,7 +59,9 @@
 using namespace std;
 
 //! Constructor - see also Primitive::Primitive
-Face::Face( unsigned int rIndex, VertexOfFace* setA, VertexOfFace* setB, VertexOfFace* setC )
+//! The vertices are not told about this face, when rConnectToVertices is false,
+//! which requires VertexOfFace::setAdjacentFaces e.g. when loading a MeshCache.
+Face::Face( unsigned int rIndex, VertexOfFace* setA, VertexOfFace* setB, VertexOfFace* setC, bool rConnectToVertices )
      : FACEINITDEFAULTS {
 
 	// Check for valid references.
@@ -108,9 +111,11 @@ Face::Face( unsigned int rIndex, VertexOfFace* setA, VertexOfFace* setB, VertexO
 	}
 
 	// now we have to tell the vertices whom they belong to:
-	vertA->connectToFace( this );
-	vertB->connectToFace( this );
-	vertC->connectToFace( this );
+	if( rConnectToVertices ) {
+		vertA->connectToFace( this );
+		vertB->connectToFace( this );
+		vertC->connectToFace( this );
+	}
 
 	// normal vector:
 	getAreaNormal(); // will also set FLAG_NORMAL_SET
@@ -336,6 +341,28 @@ bool Face::addAndTagUntaggedVerts( vector<Vertex*>* rSomeVerts, uint64_t* rVertB
 	return true;
 }
 
+bool Face::markVertsVisited( VisitedSet& rVertsVisited ) {
+	//! Marks the faces vertices within a VisitedSet.
+	vertA->markVisited( rVertsVisited );
+	vertB->markVisited( rVertsVisited );
+	vertC->markVisited( rVertsVisited );
+	return true;
+}
+
+bool Face::addAndTagUntaggedVerts( vector<Vertex*>* rSomeVerts, VisitedSet& rVertsVisited ) {
+	//! Marks the faces vertices as visited and adds those not visited before to rSomeVerts.
+	if( !vertA->markVisited( rVertsVisited ) ) {
+		rSomeVerts->push_back( vertA );
+	}
+	if( !vertB->markVisited( rVertsVisited ) ) {
+		rSomeVerts->push_back( vertB );
+	}
+	if( !vertC->markVisited( rVertsVisited ) ) {
+		rSomeVerts->push_back( vertC );
+	}
+	return true;
+}
+
 // Information retrival ---------------------------------------------------------------------------
 
 double Face::getX() const {
@@ -2329,27 +2356,31 @@ bool Face::isOnFuncValIsoLine( double isoThres ) {
 	double funcValB = _NOT_A_NUMBER_DBL_;
 	double funcValC = _NOT_A_NUMBER_DBL_;
 	vertA->getFuncValue( &funcValA );
-	funcValA -= isoThres;
-	if( funcValA == 0.0 ) {
+	vertB->getFuncValue( &funcValB );
+	vertC->getFuncValue( &funcValC );
+	return isOnIsoLine( funcValA - isoThres, funcValB - isoThres, funcValC - isoThres );
+}
+
+//! Checks if the Face lies on the isoline of zero for the given values of its vertices
+//! e.g. function values minus the isovalue or signed distances to a plane.
+//! Show a warning, when the isoline intersects thru a vertex.
+bool Face::isOnIsoLine( double valA, double valB, double valC ) {
+	if( valA == 0.0 ) {
 		LOG::debug() << "[Face::" << __FUNCTION__ << "] Warning: Iso Line intersects Vertex A.\n";
 		return true;
 	}
-	vertB->getFuncValue( &funcValB );
-	funcValB -= isoThres;
-	if( funcValB == 0.0 ) {
+	if( valB == 0.0 ) {
 		LOG::debug() << "[Face::" << __FUNCTION__ << "] Warning: Iso Line intersects Vertex B.\n";
 		return true;
 	}
-	vertC->getFuncValue( &funcValC );
-	funcValC -= isoThres;
-	if( funcValC == 0.0 ) {
+	if( valC == 0.0 ) {
 		LOG::debug() << "[Face::" << __FUNCTION__ << "] Warning: Iso Line intersects Vertex C.\n";
 		return true;
 	}
 
-	return funcValA * funcValB <= 0.0 ||
-	       funcValB * funcValC <= 0.0 ||
-	       funcValC * funcValA <= 0.0;
+	return valA * valB <= 0.0 ||
+	       valB * valC <= 0.0 ||
+	       valC * valA <= 0.0;
 }
 
 //! Get next point to trace IsoLine
@@ -2365,17 +2396,29 @@ bool Face::getFuncValIsoPoint( double    isoThres,
 						   bool      searchForward,
 						   Face**    faceVisited
 ) {
-	//! Estimates the centroid shifted by function values - returned as isoPoint.
 	double funcValA = _NOT_A_NUMBER_DBL_;
 	double funcValB = _NOT_A_NUMBER_DBL_;
 	double funcValC = _NOT_A_NUMBER_DBL_;
 	vertA->getFuncValue( &funcValA );
 	vertB->getFuncValue( &funcValB );
 	vertC->getFuncValue( &funcValC );
-	funcValA -= isoThres;
-	funcValB -= isoThres;
-	funcValC -= isoThres;
+	return getIsoPoint( funcValA - isoThres, funcValB - isoThres, funcValC - isoThres,
+	                    isoPoint, faceNext, searchForward, faceVisited );
+}
 
+//! Get next point to trace the isoline of zero for the given values of the vertices
+//! e.g. function values minus the isovalue or signed distances to a plane.
+//! See getFuncValIsoPoint for the parameters.
+//! @return true, if a valid next point was found. false otherwise
+bool Face::getIsoPoint( double    funcValA,
+                        double    funcValB,
+                        double    funcValC,
+                        Vector3D* isoPoint,
+                        Face**    faceNext,
+                        bool      searchForward,
+                        Face**    faceVisited
+) {
+	//! Estimates the centroid shifted by the values - returned as isoPoint.
 	*faceNext    = nullptr;
 	*faceVisited = nullptr;
 
@@ -2840,6 +2883,27 @@ void Face::connectToFaces() {
 	//vertC->getFaces( vertA, &neighbourFaces, this );
 }
 
+//! Fetches the neighbours per edge AB, BC and CA followed by the non-manifold ones.
+//! Edges without neighbour are represented by nullptr.
+void Face::getNeighbourFacesAll( std::vector<Face*>& rNeighbourFaces ) const {
+	rNeighbourFaces.assign( mNeighbourFaces, mNeighbourFaces + 3 + mNeighbourFacesNonManifold );
+}
+
+//! Replaces the neighbours as fetched by getNeighbourFacesAll i.e. without searching
+//! the 1-ring as connectToFaces. Used when a Mesh is loaded from a MeshCache.
+void Face::setNeighbourFacesAll( Face* const* rNeighbourFaces, //!< Neighbours per edge AB, BC and CA followed by the non-manifold ones.
+                                 unsigned short rCount         //!< Number of neighbours given - at least three.
+                                ) {
+	if( rCount < 3 ) {
+		cerr << "[Face::" << __FUNCTION__ << "] ERROR: at least three neighbours have to be given!" << endl;
+		return;
+	}
+	delete[] mNeighbourFaces;
+	mNeighbourFaces = new Face*[rCount];
+	std::copy( rNeighbourFaces, rNeighbourFaces + rCount, mNeighbourFaces );
+	mNeighbourFacesNonManifold = rCount - 3;
+}
+
 //! Used during setup of the Mesh: adds non-manifold neighbour to mNeighbourFaces.
 //! Additionally used when holes are filled e.g. during mesh polishing.
 void Face::addNonManifold( Face* rExtraFace,           //!< Face to be added.
@@ -3935,6 +3999,26 @@ Vertex* Face::advanceInSphere( Vertex* fromVert, double* sphereCenter, double ra
 	return nextVert;
 }
 
+Vertex* Face::advanceInSphere( Vertex* fromVert, double* sphereCenter, double radius, VisitedSet& rVertsVisited, vector<Vertex*>* nextArray ) {
+	//! relates to Mesh::fetchSphereBitArray - same as the bit array variant, but using a VisitedSet.
+	//! Remark: fromVert has to be NOT NULL and should be one of the faces vertices - we don't check this for performance reasons.
+	Vertex* nextVert = nullptr;
+	for( Vertex* currVert : { vertA, vertB, vertC } ) {
+		if( currVert == fromVert ) {
+			continue;
+		}
+		// only when the vertex is within the sphere and it has not been visited, we can add it to the front
+		if( currVert->distanceToCoord( sphereCenter ) > radius ) {
+			continue;
+		}
+		if( !currVert->markVisited( rVertsVisited ) ) {
+			nextArray->push_back( currVert );
+			nextVert = currVert;
+		}
+	}
+	return nextVert;
+}
+
 // rasterization / voxelization => volume integral ------------------------------------------------
 
 void Face::rasterViewFromZ( double *rasterArray, //!< array to write z-values
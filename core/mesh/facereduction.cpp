@@ -0,0 +1,87 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <GigaMesh/mesh/facereduction.h>
+
+#include <cmath>
+
+//! Adds a value to the sum and its rounding error to the compensation.
+void CompensatedSum::add( double rValue ) {
+	const double sum = mSum + rValue;
+	if( std::fabs( mSum ) >= std::fabs( rValue ) ) {
+		mCompensation += ( mSum - sum ) + rValue;
+	} else {
+		mCompensation += ( rValue - sum ) + mSum;
+	}
+	mSum = sum;
+}
+
+//! Adds the sum and the compensation of another instance.
+void CompensatedSum::add( const CompensatedSum& rOther ) {
+	add( rOther.mSum );
+	mCompensation += rOther.mCompensation;
+}
+
+//! @returns the compensated sum.
+double CompensatedSum::getSum() const {
+	return( mSum + mCompensation );
+}
+
+namespace FaceReduction {
+
+	//! Merges the sums of the chunks pairwise i.e. as a binary tree over the
+	//! chunks in their order and returns the final sums in rSums.
+	void mergePairwise(
+	                std::vector<std::vector<CompensatedSum>>& rChunkSums,
+	                uint64_t                                  rValueCount,
+	                std::vector<double>&                      rSums
+	) {
+		uint64_t chunkCount = rChunkSums.size();
+		for( uint64_t stride=1; stride<chunkCount; stride*=2 ) {
+			for( uint64_t chunkIdx=0; chunkIdx+stride<chunkCount; chunkIdx+=2*stride ) {
+				std::vector<CompensatedSum>& sums = rChunkSums[chunkIdx];
+				const std::vector<CompensatedSum>& sumsOther = rChunkSums[chunkIdx+stride];
+				for( uint64_t i=0; i<sums.size(); i++ ) {
+					sums[i].add( sumsOther[i] );
+				}
+			}
+		}
+		rSums.assign( rValueCount, 0.0 );
+		if( chunkCount == 0 ) {
+			return;
+		}
+		for( uint64_t i=0; i<rValueCount; i++ ) {
+			rSums[i] = rChunkSums.front()[i].getSum();
+		}
+	}
+
+	//! Adds the number of faces per eFaceState counted per chunk to the result.
+	void countStates(
+	                const std::vector<uint64_t>& rChunkCounts,
+	                sResult&                     rResult
+	) {
+		for( uint64_t i=0; i<rChunkCounts.size(); i+=3 ) {
+			rResult.mFacesValid      += rChunkCounts[i+FACE_VALID];
+			rResult.mFacesDegenerate += rChunkCounts[i+FACE_DEGENERATE];
+			rResult.mFacesSkipped    += rChunkCounts[i+FACE_SKIPPED];
+		}
+	}
+}
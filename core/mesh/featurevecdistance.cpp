@@ -0,0 +1,322 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/featurevecdistance.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+// AVX2 kernels are compiled for x86 with GCC and Clang independent of the target flags
+// and chosen at runtime. Other compilers and CPUs use the scalar fallback.
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	#define FEATUREVECDISTANCE_AVX2
+	#include <immintrin.h>
+	#define TARGET_AVX2 __attribute__(( target( "avx2,f16c" ) ))
+#endif
+
+using namespace std;
+
+namespace FeatureVecDistance {
+
+namespace {
+	//! Rows per chunk processed by one thread.
+	constexpr uint64_t rowsPerChunk = 4096;
+
+	//! Parameters derived once for all rows.
+	struct sKernel {
+		const sParams& mParams;
+		const double*  mStdDevSquared; //!< Squared standard deviation for METRIC_EUCLIDEAN_NORMALIZED.
+		bool           mMaxNorm;       //!< METRIC_PNORM with p = infinity.
+		bool           mCountNorm;     //!< METRIC_PNORM with p = 0.
+	};
+
+	//! Accumulated values of one row - their meaning depends on the metric.
+	struct sSums {
+		double mSum    = 0.0; //!< Sum of the distances per element or the nominator.
+		double mDenomA = 0.0; //!< Squared length of the reference.
+		double mDenomB = 0.0; //!< Squared length of the row.
+	};
+
+	inline double toDouble( double rValue )   { return( rValue ); }
+	inline double toDouble( float rValue )    { return( static_cast<double>( rValue ) ); }
+	inline double toDouble( uint16_t rValue ) { return( static_cast<double>( FeatureVecMatrix::halfToFloat( rValue ) ) ); }
+
+	//! Adds one element using the same operations as the Vertex functions.
+	template<typename T>
+	inline void accumulateScalar( const T* rRow, uint64_t rIdx, const sKernel& rKernel, sSums& rSums ) {
+		const double elementValue = toDouble( rRow[rIdx] );
+		const double refValue     = rKernel.mParams.mReference[rIdx];
+		switch( rKernel.mParams.mMetric ) {
+			case METRIC_MANHATTAN:
+				rSums.mSum += abs( refValue - elementValue );
+				break;
+			case METRIC_EUCLIDEAN:
+				rSums.mSum += pow( refValue - elementValue, 2.0 );
+				break;
+			case METRIC_EUCLIDEAN_NORMALIZED:
+				rSums.mSum += pow( refValue - elementValue, 2.0 ) / rKernel.mStdDevSquared[rIdx];
+				break;
+			case METRIC_COSINE_SIMILARITY:
+			case METRIC_TANIMOTO:
+				rSums.mSum    += refValue * elementValue;
+				rSums.mDenomA += refValue * refValue;
+				rSums.mDenomB += elementValue * elementValue;
+				break;
+			case METRIC_PNORM: {
+				double currElement = elementValue - refValue;
+				if( rKernel.mParams.mWeights != nullptr ) {
+					currElement *= rKernel.mParams.mWeights[rIdx];
+				}
+				currElement = abs( currElement );
+				if( rKernel.mMaxNorm ) {
+					rSums.mSum = max( rSums.mSum, currElement );
+				} else if( rKernel.mCountNorm ) {
+					if( currElement != 0.0 ) {
+						rSums.mSum += 1.0;
+					}
+				} else {
+					rSums.mSum += pow( currElement, rKernel.mParams.mPNorm );
+				}
+			} break;
+		}
+	}
+
+	//! @returns the distance computed from the accumulated values.
+	inline double finish( const sKernel& rKernel, const sSums& rSums ) {
+		switch( rKernel.mParams.mMetric ) {
+			case METRIC_MANHATTAN:
+				return( rSums.mSum );
+			case METRIC_EUCLIDEAN:
+			case METRIC_EUCLIDEAN_NORMALIZED:
+				return( sqrt( rSums.mSum ) );
+			case METRIC_COSINE_SIMILARITY: {
+				const double dist = rSums.mSum / ( sqrt( rSums.mDenomA ) * sqrt( rSums.mDenomB ) );
+				return( rKernel.mParams.mApplyACos ? acos( dist ) : dist );
+			}
+			case METRIC_TANIMOTO:
+				return( rSums.mSum / ( sqrt( rSums.mDenomA ) + sqrt( rSums.mDenomB ) - rSums.mSum ) );
+			case METRIC_PNORM:
+				if( rKernel.mMaxNorm || rKernel.mCountNorm ) {
+					return( rSums.mSum );
+				}
+				return( pow( rSums.mSum, 1.0/rKernel.mParams.mPNorm ) );
+		}
+		return( _NOT_A_NUMBER_DBL_ );
+	}
+
+	template<typename T>
+	double distanceScalar( const T* rRow, uint64_t rColCount, const sKernel& rKernel ) {
+		sSums sums;
+		for( uint64_t i=0; i<rColCount; i++ ) {
+			accumulateScalar( rRow, i, rKernel, sums );
+		}
+		return( finish( rKernel, sums ) );
+	}
+
+#ifdef FEATUREVECDISTANCE_AVX2
+	TARGET_AVX2 inline __m256d load4( const double* rValues ) {
+		return( _mm256_loadu_pd( rValues ) );
+	}
+	TARGET_AVX2 inline __m256d load4( const float* rValues ) {
+		return( _mm256_cvtps_pd( _mm_loadu_ps( rValues ) ) );
+	}
+	TARGET_AVX2 inline __m256d load4( const uint16_t* rValues ) {
+		return( _mm256_cvtps_pd( _mm_cvtph_ps( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( rValues ) ) ) ) );
+	}
+	TARGET_AVX2 inline double sum4( __m256d rValues ) {
+		__m128d lowHigh = _mm_add_pd( _mm256_castpd256_pd128( rValues ), _mm256_extractf128_pd( rValues, 1 ) );
+		return( _mm_cvtsd_f64( _mm_add_sd( lowHigh, _mm_unpackhi_pd( lowHigh, lowHigh ) ) ) );
+	}
+	TARGET_AVX2 inline double max4( __m256d rValues ) {
+		__m128d lowHigh = _mm_max_pd( _mm256_castpd256_pd128( rValues ), _mm256_extractf128_pd( rValues, 1 ) );
+		return( _mm_cvtsd_f64( _mm_max_sd( lowHigh, _mm_unpackhi_pd( lowHigh, lowHigh ) ) ) );
+	}
+
+	//! Four elements at once. The remaining elements are added by accumulateScalar.
+	//! METRIC_PNORM is supported for p = 0, 1, 2 and infinity.
+	template<typename T>
+	TARGET_AVX2 double distanceAVX2( const T* rRow, uint64_t rColCount, const sKernel& rKernel ) {
+		const sParams& params   = rKernel.mParams;
+		const __m256d  signMask = _mm256_set1_pd( -0.0 );
+		const __m256d  zeros    = _mm256_setzero_pd();
+		const __m256d  ones     = _mm256_set1_pd( 1.0 );
+		__m256d accSum    = zeros;
+		__m256d accDenomA = zeros;
+		__m256d accDenomB = zeros;
+		uint64_t i = 0;
+		for( ; i+4 <= rColCount; i+=4 ) {
+			const __m256d elementValues = load4( rRow + i );
+			const __m256d refValues     = _mm256_loadu_pd( params.mReference + i );
+			switch( params.mMetric ) {
+				case METRIC_MANHATTAN:
+					accSum = _mm256_add_pd( accSum, _mm256_andnot_pd( signMask, _mm256_sub_pd( refValues, elementValues ) ) );
+					break;
+				case METRIC_EUCLIDEAN: {
+					const __m256d diff = _mm256_sub_pd( refValues, elementValues );
+					accSum = _mm256_add_pd( accSum, _mm256_mul_pd( diff, diff ) );
+				} break;
+				case METRIC_EUCLIDEAN_NORMALIZED: {
+					const __m256d diff = _mm256_sub_pd( refValues, elementValues );
+					accSum = _mm256_add_pd( accSum, _mm256_div_pd( _mm256_mul_pd( diff, diff ),
+					                                               _mm256_loadu_pd( rKernel.mStdDevSquared + i ) ) );
+				} break;
+				case METRIC_COSINE_SIMILARITY:
+				case METRIC_TANIMOTO:
+					accSum    = _mm256_add_pd( accSum,    _mm256_mul_pd( refValues, elementValues ) );
+					accDenomA = _mm256_add_pd( accDenomA, _mm256_mul_pd( refValues, refValues ) );
+					accDenomB = _mm256_add_pd( accDenomB, _mm256_mul_pd( elementValues, elementValues ) );
+					break;
+				case METRIC_PNORM: {
+					__m256d currElements = _mm256_sub_pd( elementValues, refValues );
+					if( params.mWeights != nullptr ) {
+						currElements = _mm256_mul_pd( currElements, _mm256_loadu_pd( params.mWeights + i ) );
+					}
+					currElements = _mm256_andnot_pd( signMask, currElements );
+					if( rKernel.mMaxNorm ) {
+						// Returns the 2nd operand for not-a-number as std::max( sum, element ) does.
+						accSum = _mm256_max_pd( currElements, accSum );
+					} else if( rKernel.mCountNorm ) {
+						// Not-a-number is unequal to zero.
+						accSum = _mm256_add_pd( accSum, _mm256_and_pd( _mm256_cmp_pd( currElements, zeros, _CMP_NEQ_UQ ), ones ) );
+					} else if( params.mPNorm == 1.0 ) {
+						accSum = _mm256_add_pd( accSum, currElements );
+					} else {
+						accSum = _mm256_add_pd( accSum, _mm256_mul_pd( currElements, currElements ) );
+					}
+				} break;
+			}
+		}
+		sSums sums;
+		sums.mSum    = rKernel.mMaxNorm ? max4( accSum ) : sum4( accSum );
+		sums.mDenomA = sum4( accDenomA );
+		sums.mDenomB = sum4( accDenomB );
+		for( ; i<rColCount; i++ ) {
+			accumulateScalar( rRow, i, rKernel, sums );
+		}
+		return( finish( rKernel, sums ) );
+	}
+#endif
+
+	//! Computes the distances for the rows [rRowStart,rRowEnd).
+	template<typename T>
+	void computeRows( const T* rData, uint64_t rColCount, uint64_t rRowStart, uint64_t rRowEnd,
+	                  const sKernel& rKernel, [[maybe_unused]] bool rUseAVX2, double* rDistances ) {
+#ifdef FEATUREVECDISTANCE_AVX2
+		if( rUseAVX2 ) {
+			for( uint64_t rowIdx=rRowStart; rowIdx<rRowEnd; rowIdx++ ) {
+				rDistances[rowIdx] = distanceAVX2( rData + rowIdx*rColCount, rColCount, rKernel );
+			}
+			return;
+		}
+#endif
+		for( uint64_t rowIdx=rRowStart; rowIdx<rRowEnd; rowIdx++ ) {
+			rDistances[rowIdx] = distanceScalar( rData + rowIdx*rColCount, rColCount, rKernel );
+		}
+	}
+}
+
+//! Computes the distance of the reference vector to each row of the matrix.
+//! rDistances has to hold rMatrix.getRowCount() elements.
+//!
+//! For METRIC_PNORM a reference of different length results in not-a-number
+//! as Vertex::getFeatureVecPNorm fails in this case.
+//!
+//! @returns false in case of an error. True otherwise.
+bool compute( const FeatureVecMatrix& rMatrix, const sParams& rParams, double* rDistances ) {
+	PROFILE_SCOPE( "FeatureVecDistance::compute" );
+	const uint64_t rowCount = rMatrix.getRowCount();
+	const uint64_t colCount = rMatrix.getColCount();
+	if( rowCount == 0 ) {
+		return( true );
+	}
+	if( ( rDistances == nullptr ) || ( rParams.mReference == nullptr ) ) {
+		LOG::error() << "[FeatureVecDistance::" << __FUNCTION__ << "] ERROR: NULL pointer given!\n";
+		return( false );
+	}
+	if( rParams.mMetric == METRIC_PNORM ) {
+		if( rParams.mPNorm < 0.0 ) {
+			LOG::error() << "[FeatureVecDistance::" << __FUNCTION__ << "] ERROR: Negative p=" << rParams.mPNorm << " is not defined!\n";
+			return( false );
+		}
+		if( rParams.mReferenceLen != colCount ) {
+			std::fill( rDistances, rDistances + rowCount, _NOT_A_NUMBER_DBL_ );
+			return( true );
+		}
+	} else if( rParams.mReferenceLen < colCount ) {
+		LOG::error() << "[FeatureVecDistance::" << __FUNCTION__ << "] ERROR: Reference vector is shorter than the feature vectors!\n";
+		return( false );
+	}
+	vector<double> stdDevSquared;
+	if( rParams.mMetric == METRIC_EUCLIDEAN_NORMALIZED ) {
+		if( rParams.mStdDev == nullptr ) {
+			LOG::error() << "[FeatureVecDistance::" << __FUNCTION__ << "] ERROR: No standard deviation given!\n";
+			return( false );
+		}
+		stdDevSquared.resize( colCount );
+		for( uint64_t i=0; i<colCount; i++ ) {
+			stdDevSquared[i] = pow( rParams.mStdDev[i], 2.0 );
+		}
+	}
+
+	const bool maxNorm   = ( rParams.mMetric == METRIC_PNORM ) && ( rParams.mPNorm == std::numeric_limits<double>::infinity() );
+	const bool countNorm = ( rParams.mMetric == METRIC_PNORM ) && ( rParams.mPNorm == 0.0 );
+	const sKernel kernel { rParams, stdDevSquared.data(), maxNorm, countNorm };
+	const bool useAVX2 = rParams.mAllowSIMD && hasAVX2() &&
+	                     ( ( rParams.mMetric != METRIC_PNORM ) || maxNorm || countNorm ||
+	                       ( rParams.mPNorm == 1.0 ) || ( rParams.mPNorm == 2.0 ) );
+
+	const uint64_t chunkCount = ParallelFor::getChunkCount( rowCount, rowsPerChunk );
+	ParallelFor::forEachChunk( chunkCount, rParams.mThreadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t rowStart = rChunkIdx * rowsPerChunk;
+		const uint64_t rowEnd   = std::min( rowStart + rowsPerChunk, rowCount );
+		switch( rMatrix.getPrecision() ) {
+			case FeatureVecMatrix::PRECISION_FLOAT:
+				computeRows( rMatrix.getDataFloat(), colCount, rowStart, rowEnd, kernel, useAVX2, rDistances );
+				break;
+			case FeatureVecMatrix::PRECISION_HALF:
+				computeRows( rMatrix.getDataHalf(), colCount, rowStart, rowEnd, kernel, useAVX2, rDistances );
+				break;
+			default:
+				computeRows( rMatrix.getDataDouble(), colCount, rowStart, rowEnd, kernel, useAVX2, rDistances );
+				break;
+		}
+	} );
+	return( true );
+}
+
+bool hasAVX2() {
+#ifdef FEATUREVECDISTANCE_AVX2
+	static const bool cpuSupportsAVX2 = __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "f16c" );
+	return( cpuSupportsAVX2 );
+#else
+	return( false );
+#endif
+}
+
+}
@@ -0,0 +1,507 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/featurevecindex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <utility>
+
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Rows per chunk processed by one thread.
+	constexpr uint64_t rowsPerChunk = 4096;
+
+	//! Identifies the file format. Numbers are stored in native byte order.
+	constexpr char fileMagic[8] = { 'G', 'M', 'F', 'V', 'I', 'D', 'X', '1' };
+
+	//! @returns the squared Euclidean distance of two vectors.
+	inline double distanceSquared( const double* rVecA, const double* rVecB, uint64_t rLen ) {
+		double sum = 0.0;
+		for( uint64_t i=0; i<rLen; i++ ) {
+			const double diff = rVecA[i] - rVecB[i];
+			sum += diff * diff;
+		}
+		return( sum );
+	}
+
+	//! @returns the index of the centroid within [rFirst, rLast) nearest to the given vector.
+	uint64_t nearestCentroid( const double* rVec, const vector<double>& rCentroids, uint64_t rColCount,
+	                          uint64_t rFirst, uint64_t rLast ) {
+		uint64_t nearest     = rFirst;
+		double   nearestDist = numeric_limits<double>::infinity();
+		for( uint64_t centroidIdx=rFirst; centroidIdx<rLast; centroidIdx++ ) {
+			const double dist = distanceSquared( rVec, &rCentroids[centroidIdx*rColCount], rColCount );
+			if( dist < nearestDist ) {
+				nearestDist = dist;
+				nearest     = centroidIdx;
+			}
+		}
+		return( nearest );
+	}
+
+	//! Lloyd's k-means for a subset of the samples. Appends the centroids to rCentroids
+	//! and returns the cluster per sample of the subset relative to the first appended centroid.
+	//! The result does not depend on the number of threads.
+	void kMeans( const vector<double>&   rSamples,      //!< All samples, row-major.
+	             const vector<uint64_t>& rSubset,       //!< Samples to cluster - must not be empty.
+	             uint64_t                rColCount,
+	             uint64_t                rClusterCount,
+	             unsigned int            rIterations,
+	             mt19937_64&             rRandom,
+	             unsigned int            rThreadCount,
+	             vector<double>&         rCentroids,
+	             vector<uint64_t>&       rLabels
+	) {
+		const uint64_t subsetCount  = rSubset.size();
+		const uint64_t clusterCount = std::clamp<uint64_t>( rClusterCount, 1, subsetCount );
+		const uint64_t firstCluster = rCentroids.size() / rColCount;
+
+		// Initial centroids: distinct random samples.
+		vector<uint64_t> order( subsetCount );
+		iota( order.begin(), order.end(), 0 );
+		for( uint64_t clusterIdx=0; clusterIdx<clusterCount; clusterIdx++ ) {
+			swap( order[clusterIdx], order[clusterIdx + rRandom() % ( subsetCount - clusterIdx )] );
+			const double* sample = &rSamples[rSubset[order[clusterIdx]]*rColCount];
+			rCentroids.insert( rCentroids.end(), sample, sample + rColCount );
+		}
+
+		rLabels.assign( subsetCount, 0 );
+		vector<double>   sums;
+		vector<uint64_t> counts;
+		for( unsigned int iteration=0; iteration<=rIterations; iteration++ ) {
+			ParallelFor::forEachChunk( ParallelFor::getChunkCount( subsetCount, rowsPerChunk ), rThreadCount, [&]( uint64_t rChunk ) {
+				const uint64_t subsetEnd = min( ( rChunk + 1 ) * rowsPerChunk, subsetCount );
+				for( uint64_t subsetIdx=rChunk*rowsPerChunk; subsetIdx<subsetEnd; subsetIdx++ ) {
+					rLabels[subsetIdx] = nearestCentroid( &rSamples[rSubset[subsetIdx]*rColCount], rCentroids, rColCount,
+					                                      firstCluster, firstCluster + clusterCount ) - firstCluster;
+				}
+			} );
+			if( iteration == rIterations ) {
+				break;
+			}
+			// Update sequentially, so the sums do not depend on the number of threads.
+			sums.assign( clusterCount * rColCount, 0.0 );
+			counts.assign( clusterCount, 0 );
+			for( uint64_t subsetIdx=0; subsetIdx<subsetCount; subsetIdx++ ) {
+				const uint64_t clusterIdx = rLabels[subsetIdx];
+				const double*  sample     = &rSamples[rSubset[subsetIdx]*rColCount];
+				counts[clusterIdx]++;
+				for( uint64_t col=0; col<rColCount; col++ ) {
+					sums[clusterIdx*rColCount+col] += sample[col];
+				}
+			}
+			for( uint64_t clusterIdx=0; clusterIdx<clusterCount; clusterIdx++ ) {
+				double* centroid = &rCentroids[( firstCluster + clusterIdx ) * rColCount];
+				if( counts[clusterIdx] == 0 ) {
+					// Empty cluster: restart at a random sample.
+					const double* sample = &rSamples[rSubset[rRandom() % subsetCount]*rColCount];
+					copy( sample, sample + rColCount, centroid );
+					continue;
+				}
+				for( uint64_t col=0; col<rColCount; col++ ) {
+					centroid[col] = sums[clusterIdx*rColCount+col] / static_cast<double>( counts[clusterIdx] );
+				}
+			}
+		}
+	}
+}
+
+//! Removes the index.
+void FeatureVecIndex::clear() {
+	mRowCount = 0;
+	mColCount = 0;
+	mChecksum = 0;
+	mCentroids.clear();
+	mListOffsets.clear();
+	mListRows.clear();
+}
+
+//! Builds the index for the given matrix using multiple threads.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecIndex::build(
+                const FeatureVecMatrix& rMatrix,  //!< Feature vectors to index.
+                const sParams&          rParams   //!< Parameters e.g. the number of lists.
+) {
+	PROFILE_SCOPE( "FeatureVecIndex::build" );
+	clear();
+	const uint64_t rowCount = rMatrix.getRowCount();
+	const uint64_t colCount = rMatrix.getColCount();
+	if( ( rowCount == 0 ) || ( colCount == 0 ) ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: No feature vectors given!\n";
+		return( false );
+	}
+	const unsigned int threadCount = ParallelFor::getThreadCount( rParams.mThreadCount );
+	const uint64_t     chunkCount  = ParallelFor::getChunkCount( rowCount, rowsPerChunk );
+
+	// Rows containing not-a-number can not be found by a query, so they are not indexed.
+	vector<uint8_t> rowFinite( rowCount, 0 );
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunk ) {
+		vector<double> buffer;
+		const uint64_t rowEnd = min( ( rChunk + 1 ) * rowsPerChunk, rowCount );
+		for( uint64_t row=rChunk*rowsPerChunk; row<rowEnd; row++ ) {
+			const double* vec = rMatrix.getRowDouble( row, buffer );
+			rowFinite[row] = all_of( vec, vec + colCount, []( double rValue ) { return( isfinite( rValue ) ); } );
+		}
+	} );
+	vector<uint64_t> indexRows;
+	for( uint64_t row=0; row<rowCount; row++ ) {
+		if( rowFinite[row] ) {
+			indexRows.push_back( row );
+		}
+	}
+	if( indexRows.empty() ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: No finite feature vectors given!\n";
+		return( false );
+	}
+	const uint64_t indexCount = indexRows.size();
+
+	// Training sample.
+	mt19937_64 random( rParams.mSeed );
+	vector<uint64_t> sampleRows;
+	if( ( rParams.mSampleCount == 0 ) || ( indexCount <= rParams.mSampleCount ) ) {
+		sampleRows = indexRows;
+	} else {
+		sampleRows.resize( rParams.mSampleCount );
+		for( uint64_t& sampleRow : sampleRows ) {
+			sampleRow = indexRows[random() % indexCount];
+		}
+		sort( sampleRows.begin(), sampleRows.end() );
+	}
+	const uint64_t sampleCount = sampleRows.size();
+	vector<double> samples( sampleCount * colCount );
+	for( uint64_t sampleIdx=0; sampleIdx<sampleCount; sampleIdx++ ) {
+		rMatrix.getRow( sampleRows[sampleIdx], &samples[sampleIdx*colCount] );
+	}
+	uint64_t listCount = rParams.mListCount;
+	if( listCount == 0 ) {
+		listCount = static_cast<uint64_t>( llround( sqrt( static_cast<double>( indexCount ) ) ) );
+	}
+	listCount = std::clamp<uint64_t>( listCount, 1, sampleCount );
+
+	// Coarse level: square root of the number of lists.
+	vector<uint64_t> allSamples( sampleCount );
+	iota( allSamples.begin(), allSamples.end(), 0 );
+	vector<double>   coarseCentroids;
+	vector<uint64_t> coarseLabels;
+	kMeans( samples, allSamples, colCount, static_cast<uint64_t>( ceil( sqrt( static_cast<double>( listCount ) ) ) ),
+	        rParams.mIterations, random, threadCount, coarseCentroids, coarseLabels );
+	const uint64_t coarseCount = coarseCentroids.size() / colCount;
+
+	// Fine level i.e. the lists: per coarse cell proportional to its samples.
+	vector<vector<uint64_t>> coarseSamples( coarseCount );
+	for( uint64_t sampleIdx=0; sampleIdx<sampleCount; sampleIdx++ ) {
+		coarseSamples[coarseLabels[sampleIdx]].push_back( sampleIdx );
+	}
+	vector<uint64_t> coarseListBegin( coarseCount + 1, 0 );
+	for( uint64_t coarseIdx=0; coarseIdx<coarseCount; coarseIdx++ ) {
+		const vector<uint64_t>& cellSamples = coarseSamples[coarseIdx];
+		if( !cellSamples.empty() ) {
+			const uint64_t cellLists = static_cast<uint64_t>( llround( static_cast<double>( listCount * cellSamples.size() ) /
+			                                                           static_cast<double>( sampleCount ) ) );
+			vector<uint64_t> cellLabels;
+			kMeans( samples, cellSamples, colCount, cellLists, rParams.mIterations, random, threadCount, mCentroids, cellLabels );
+		}
+		coarseListBegin[coarseIdx+1] = mCentroids.size() / colCount;
+	}
+	listCount = mCentroids.size() / colCount;
+
+	// Assign all rows to the nearest list of their coarse cell.
+	vector<uint64_t> rowLists( indexCount );
+	ParallelFor::forEachChunk( ParallelFor::getChunkCount( indexCount, rowsPerChunk ), threadCount, [&]( uint64_t rChunk ) {
+		vector<double> buffer;
+		const uint64_t indexEnd = min( ( rChunk + 1 ) * rowsPerChunk, indexCount );
+		for( uint64_t indexIdx=rChunk*rowsPerChunk; indexIdx<indexEnd; indexIdx++ ) {
+			const double*  vec       = rMatrix.getRowDouble( indexRows[indexIdx], buffer );
+			const uint64_t coarseIdx = nearestCentroid( vec, coarseCentroids, colCount, 0, coarseCount );
+			uint64_t listFirst = coarseListBegin[coarseIdx];
+			uint64_t listLast  = coarseListBegin[coarseIdx+1];
+			if( listFirst == listLast ) {
+				// Coarse cell without samples.
+				listFirst = 0;
+				listLast  = listCount;
+			}
+			rowLists[indexIdx] = nearestCentroid( vec, mCentroids, colCount, listFirst, listLast );
+		}
+	} );
+
+	// Group the rows by list keeping their order.
+	mListOffsets.assign( listCount + 1, 0 );
+	for( const uint64_t listIdx : rowLists ) {
+		mListOffsets[listIdx+1]++;
+	}
+	partial_sum( mListOffsets.begin(), mListOffsets.end(), mListOffsets.begin() );
+	vector<uint64_t> listPos( mListOffsets.begin(), mListOffsets.end() - 1 );
+	mListRows.resize( indexCount );
+	for( uint64_t indexIdx=0; indexIdx<indexCount; indexIdx++ ) {
+		mListRows[listPos[rowLists[indexIdx]]++] = indexRows[indexIdx];
+	}
+
+	mRowCount = rowCount;
+	mColCount = colCount;
+	mChecksum = computeChecksum( rMatrix, threadCount );
+	LOG::info() << "[FeatureVecIndex::" << __FUNCTION__ << "] " << indexCount << " of " << rowCount
+	            << " feature vectors in " << listCount << " lists.\n";
+	return( true );
+}
+
+//! @returns true, when the index was built for a matrix having the same size as the given one.
+//! The values are not compared - see readFile.
+bool FeatureVecIndex::isBuiltFor( const FeatureVecMatrix& rMatrix ) const {
+	return( isBuilt() && ( mRowCount == rMatrix.getRowCount() ) && ( mColCount == rMatrix.getColCount() ) );
+}
+
+//! @returns the number of lists scanned, when zero is given to a query.
+uint64_t FeatureVecIndex::getDefaultProbeCount() const {
+	return( min( getListCount(), max<uint64_t>( 8, getListCount() / 32 ) ) );
+}
+
+//! Finds the lists having the nearest centroids.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecIndex::selectProbes(
+                const double*     rReference,
+                uint64_t          rProbeCount,
+                vector<uint64_t>& rProbes
+) const {
+	const uint64_t listCount  = getListCount();
+	const uint64_t probeCount = min( ( rProbeCount == 0 ) ? getDefaultProbeCount() : rProbeCount, listCount );
+	vector<pair<double,uint64_t>> centroidDists( listCount );
+	for( uint64_t listIdx=0; listIdx<listCount; listIdx++ ) {
+		centroidDists[listIdx] = { distanceSquared( rReference, &mCentroids[listIdx*mColCount], mColCount ), listIdx };
+		if( isnan( centroidDists[listIdx].first ) ) {
+			LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Reference contains not-a-number!\n";
+			return( false );
+		}
+	}
+	partial_sort( centroidDists.begin(), centroidDists.begin() + probeCount, centroidDists.end() );
+	rProbes.resize( probeCount );
+	for( uint64_t probeIdx=0; probeIdx<probeCount; probeIdx++ ) {
+		rProbes[probeIdx] = centroidDists[probeIdx].second;
+	}
+	return( true );
+}
+
+//! Finds the rows nearest to the reference.
+//! The results are sorted by distance.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecIndex::queryKNN(
+                const FeatureVecMatrix& rMatrix,       //!< Matrix used for building.
+                const double*           rReference,    //!< Reference having at least the columns of the matrix.
+                uint64_t                rCount,        //!< Maximum number of rows to find.
+                uint64_t                rProbeCount,   //!< Lists to scan. Zero: see getDefaultProbeCount.
+                vector<sResult>&        rResults       //!< Rows found.
+) const {
+	rResults.clear();
+	if( !isBuiltFor( rMatrix ) || ( rReference == nullptr ) ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Index not built for the given matrix or no reference!\n";
+		return( false );
+	}
+	vector<uint64_t> probes;
+	if( !selectProbes( rReference, rProbeCount, probes ) ) {
+		return( false );
+	}
+	if( rCount == 0 ) {
+		return( true );
+	}
+	// Max-heap of the nearest rows found so far.
+	priority_queue<pair<double,uint64_t>> nearest;
+	vector<double> buffer;
+	for( const uint64_t listIdx : probes ) {
+		for( uint64_t pos=mListOffsets[listIdx]; pos<mListOffsets[listIdx+1]; pos++ ) {
+			const uint64_t row  = mListRows[pos];
+			const double   dist = distanceSquared( rReference, rMatrix.getRowDouble( row, buffer ), mColCount );
+			if( nearest.size() < rCount ) {
+				nearest.emplace( dist, row );
+			} else if( make_pair( dist, row ) < nearest.top() ) {
+				nearest.pop();
+				nearest.emplace( dist, row );
+			}
+		}
+	}
+	rResults.resize( nearest.size() );
+	for( auto result = rResults.rbegin(); result != rResults.rend(); ++result ) {
+		*result = { nearest.top().second, sqrt( nearest.top().first ) };
+		nearest.pop();
+	}
+	return( true );
+}
+
+//! Finds the rows within the given distance of the reference.
+//! The results are sorted by distance.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecIndex::queryRadius(
+                const FeatureVecMatrix& rMatrix,       //!< Matrix used for building.
+                const double*           rReference,    //!< Reference having at least the columns of the matrix.
+                double                  rRadius,       //!< Maximum Euclidean distance.
+                uint64_t                rProbeCount,   //!< Lists to scan. Zero: see getDefaultProbeCount.
+                vector<sResult>&        rResults       //!< Rows found.
+) const {
+	rResults.clear();
+	if( !isBuiltFor( rMatrix ) || ( rReference == nullptr ) ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Index not built for the given matrix or no reference!\n";
+		return( false );
+	}
+	vector<uint64_t> probes;
+	if( !selectProbes( rReference, rProbeCount, probes ) ) {
+		return( false );
+	}
+	const double radiusSquared = rRadius * rRadius;
+	vector<pair<double,uint64_t>> found;
+	vector<double> buffer;
+	for( const uint64_t listIdx : probes ) {
+		for( uint64_t pos=mListOffsets[listIdx]; pos<mListOffsets[listIdx+1]; pos++ ) {
+			const uint64_t row  = mListRows[pos];
+			const double   dist = distanceSquared( rReference, rMatrix.getRowDouble( row, buffer ), mColCount );
+			if( dist <= radiusSquared ) {
+				found.emplace_back( dist, row );
+			}
+		}
+	}
+	sort( found.begin(), found.end() );
+	rResults.resize( found.size() );
+	for( uint64_t resultIdx=0; resultIdx<found.size(); resultIdx++ ) {
+		rResults[resultIdx] = { found[resultIdx].second, sqrt( found[resultIdx].first ) };
+	}
+	return( true );
+}
+
+//! Writes the index as binary file - see getFileNameFor.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecIndex::writeFile( const filesystem::path& rFileName ) const {
+	PROFILE_SCOPE( "FeatureVecIndex::writeFile" );
+	if( !isBuilt() ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Index not built!\n";
+		return( false );
+	}
+	ofstream fileOut( rFileName, ios::binary );
+	if( !fileOut.is_open() ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Could not open " << rFileName << " for writing!\n";
+		return( false );
+	}
+	const uint64_t header[5] = { mRowCount, mColCount, mChecksum, getListCount(), getIndexedRowCount() };
+	fileOut.write( fileMagic, sizeof( fileMagic ) );
+	fileOut.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+	fileOut.write( reinterpret_cast<const char*>( mCentroids.data() ), static_cast<streamsize>( mCentroids.size() * sizeof( double ) ) );
+	fileOut.write( reinterpret_cast<const char*>( mListOffsets.data() ), static_cast<streamsize>( mListOffsets.size() * sizeof( uint64_t ) ) );
+	fileOut.write( reinterpret_cast<const char*>( mListRows.data() ), static_cast<streamsize>( mListRows.size() * sizeof( uint64_t ) ) );
+	if( !fileOut.good() ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Writing " << rFileName << " failed!\n";
+		return( false );
+	}
+	return( true );
+}
+
+//! Reads an index written by writeFile, which has to belong to the given matrix.
+//! @returns false in case of an error or an index of other feature vectors. True otherwise.
+bool FeatureVecIndex::readFile(
+                const filesystem::path& rFileName,   //!< Index file.
+                const FeatureVecMatrix& rMatrix      //!< Feature vectors, which were indexed.
+) {
+	PROFILE_SCOPE( "FeatureVecIndex::readFile" );
+	clear();
+	ifstream fileIn( rFileName, ios::binary );
+	if( !fileIn.is_open() ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: Could not open " << rFileName << " for reading!\n";
+		return( false );
+	}
+	char     magic[sizeof( fileMagic )];
+	uint64_t header[5];
+	fileIn.read( magic, sizeof( magic ) );
+	fileIn.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+	if( !fileIn.good() || ( memcmp( magic, fileMagic, sizeof( fileMagic ) ) != 0 ) ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: " << rFileName << " is not a feature vector index!\n";
+		return( false );
+	}
+	const uint64_t listCount       = header[3];
+	const uint64_t indexedRowCount = header[4];
+	if( ( header[0] != rMatrix.getRowCount() ) || ( header[1] != rMatrix.getColCount() ) ||
+	    ( listCount == 0 ) || ( listCount > indexedRowCount ) || ( indexedRowCount > header[0] ) ||
+	    ( header[2] != computeChecksum( rMatrix ) ) ) {
+		LOG::warn() << "[FeatureVecIndex::" << __FUNCTION__ << "] Index " << rFileName << " belongs to other feature vectors!\n";
+		return( false );
+	}
+	mCentroids.resize( listCount * header[1] );
+	mListOffsets.resize( listCount + 1 );
+	mListRows.resize( indexedRowCount );
+	fileIn.read( reinterpret_cast<char*>( mCentroids.data() ), static_cast<streamsize>( mCentroids.size() * sizeof( double ) ) );
+	fileIn.read( reinterpret_cast<char*>( mListOffsets.data() ), static_cast<streamsize>( mListOffsets.size() * sizeof( uint64_t ) ) );
+	fileIn.read( reinterpret_cast<char*>( mListRows.data() ), static_cast<streamsize>( mListRows.size() * sizeof( uint64_t ) ) );
+	const bool listsValid = fileIn.good() && ( mListOffsets.front() == 0 ) && ( mListOffsets.back() == indexedRowCount ) &&
+	                        is_sorted( mListOffsets.begin(), mListOffsets.end() ) &&
+	                        all_of( mListRows.begin(), mListRows.end(), [&header]( uint64_t rRow ) { return( rRow < header[0] ); } );
+	if( !listsValid ) {
+		LOG::error() << "[FeatureVecIndex::" << __FUNCTION__ << "] ERROR: " << rFileName << " is corrupt!\n";
+		clear();
+		return( false );
+	}
+	mRowCount = header[0];
+	mColCount = header[1];
+	mChecksum = header[2];
+	return( true );
+}
+
+//! @returns the name of the index file stored next to the given file of feature vectors e.g. 'mesh.volume.mat' becomes 'mesh.volume.fvidx'.
+filesystem::path FeatureVecIndex::getFileNameFor( const filesystem::path& rFeatureVecFile ) {
+	filesystem::path fileName( rFeatureVecFile );
+	fileName.replace_extension( ".fvidx" );
+	return( fileName );
+}
+
+//! @returns the FNV-1a hash of the size and the values of the matrix, which detects outdated index files.
+//! The hash is computed per chunk, so it does not depend on the number of threads.
+uint64_t FeatureVecIndex::computeChecksum( const FeatureVecMatrix& rMatrix, unsigned int rThreadCount ) {
+	PROFILE_SCOPE( "FeatureVecIndex::computeChecksum" );
+	constexpr uint64_t fnvOffset = 14695981039346656037ULL;
+	constexpr uint64_t fnvPrime  = 1099511628211ULL;
+	auto hashBytes = []( uint64_t rHash, const void* rData, size_t rSize ) {
+		const unsigned char* bytes = static_cast<const unsigned char*>( rData );
+		for( size_t i=0; i<rSize; i++ ) {
+			rHash = ( rHash ^ bytes[i] ) * fnvPrime;
+		}
+		return( rHash );
+	};
+	const uint64_t rowCount   = rMatrix.getRowCount();
+	const uint64_t colCount   = rMatrix.getColCount();
+	const uint64_t chunkCount = ParallelFor::getChunkCount( rowCount, rowsPerChunk );
+	vector<uint64_t> chunkHashes( chunkCount, fnvOffset );
+	ParallelFor::forEachChunk( chunkCount, ParallelFor::getThreadCount( rThreadCount ), [&]( uint64_t rChunk ) {
+		vector<double> buffer;
+		const uint64_t rowEnd = min( ( rChunk + 1 ) * rowsPerChunk, rowCount );
+		for( uint64_t row=rChunk*rowsPerChunk; row<rowEnd; row++ ) {
+			chunkHashes[rChunk] = hashBytes( chunkHashes[rChunk], rMatrix.getRowDouble( row, buffer ), colCount * sizeof( double ) );
+		}
+	} );
+	uint64_t checksum = hashBytes( fnvOffset, &rowCount, sizeof( rowCount ) );
+	checksum = hashBytes( checksum, &colCount, sizeof( colCount ) );
+	return( hashBytes( checksum, chunkHashes.data(), chunkHashes.size() * sizeof( uint64_t ) ) );
+}
@@ -0,0 +1,253 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/featurevecmatrix.h>
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/logging/Logging.h>
+
+//! Constructor for an empty matrix using the given precision for the elements to be assigned.
+FeatureVecMatrix::FeatureVecMatrix( ePrecision rPrecision )
+    : mPrecision( rPrecision ) {
+}
+
+//! Removes all elements and frees the memory. The precision is kept.
+void FeatureVecMatrix::clear() {
+	mRowCount = 0;
+	mColCount = 0;
+	std::vector<double>().swap( mDataDouble );
+	std::vector<float>().swap( mDataFloat );
+	std::vector<uint16_t>().swap( mDataHalf );
+}
+
+//! Reserves memory for the given number of rows and columns.
+//! Existing elements are discarded and all elements are set to not-a-number.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecMatrix::allocate( uint64_t rRowCount, uint64_t rColCount ) {
+	clear();
+	if( ( rRowCount == 0 ) || ( rColCount == 0 ) ) {
+		return( true );
+	}
+	const uint64_t elementCount = rRowCount * rColCount;
+	if( elementCount / rColCount != rRowCount ) {
+		LOG::error() << "[FeatureVecMatrix::" << __FUNCTION__ << "] ERROR: Size of " << rRowCount << " x " << rColCount << " overflows!\n";
+		return( false );
+	}
+	switch( mPrecision ) {
+		case PRECISION_FLOAT:
+			mDataFloat.assign( elementCount, std::numeric_limits<float>::quiet_NaN() );
+			break;
+		case PRECISION_HALF:
+			mDataHalf.assign( elementCount, floatToHalf( std::numeric_limits<float>::quiet_NaN() ) );
+			break;
+		default:
+			mDataDouble.assign( elementCount, _NOT_A_NUMBER_DBL_ );
+			break;
+	}
+	mRowCount = rRowCount;
+	mColCount = rColCount;
+	return( true );
+}
+
+//! Copies a row-major table of rRowCount x rColCount elements into the matrix.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecMatrix::assign( const double* rValues, uint64_t rRowCount, uint64_t rColCount ) {
+	if( ( rValues == nullptr ) && ( rRowCount * rColCount > 0 ) ) {
+		LOG::error() << "[FeatureVecMatrix::" << __FUNCTION__ << "] ERROR: NULL pointer given!\n";
+		return( false );
+	}
+	clear();
+	if( ( rRowCount == 0 ) || ( rColCount == 0 ) ) {
+		return( true );
+	}
+	const uint64_t elementCount = rRowCount * rColCount;
+	switch( mPrecision ) {
+		case PRECISION_FLOAT:
+			mDataFloat.resize( elementCount );
+			for( uint64_t i=0; i<elementCount; i++ ) {
+				mDataFloat[i] = static_cast<float>( rValues[i] );
+			}
+			break;
+		case PRECISION_HALF:
+			mDataHalf.resize( elementCount );
+			for( uint64_t i=0; i<elementCount; i++ ) {
+				mDataHalf[i] = floatToHalf( static_cast<float>( rValues[i] ) );
+			}
+			break;
+		default:
+			mDataDouble.assign( rValues, rValues + elementCount );
+			break;
+	}
+	mRowCount = rRowCount;
+	mColCount = rColCount;
+	return( true );
+}
+
+//! Takes a row-major table with rColCount columns. In double precision the memory
+//! is taken over without a copy, which avoids having the feature vectors twice in memory.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecMatrix::assign( std::vector<double>&& rValues, uint64_t rColCount ) {
+	if( ( rColCount == 0 ) || ( rValues.size() % rColCount != 0 ) ) {
+		LOG::error() << "[FeatureVecMatrix::" << __FUNCTION__ << "] ERROR: " << rValues.size()
+		             << " elements do not fit " << rColCount << " columns!\n";
+		return( false );
+	}
+	if( mPrecision != PRECISION_DOUBLE ) {
+		const bool retVal = assign( rValues.data(), rValues.size() / rColCount, rColCount );
+		std::vector<double>().swap( rValues );
+		return( retVal );
+	}
+	clear();
+	mRowCount = rValues.size() / rColCount;
+	mColCount = rColCount;
+	mDataDouble.swap( rValues );
+	std::vector<double>().swap( rValues );
+	return( true );
+}
+
+//! Changes the storage type. Existing elements are converted in place.
+//! Reducing the precision is lossy.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecMatrix::setPrecision( ePrecision rPrecision ) {
+	if( rPrecision == mPrecision ) {
+		return( true );
+	}
+	const uint64_t elementCount = mRowCount * mColCount;
+	std::vector<double>   dataDouble;
+	std::vector<float>    dataFloat;
+	std::vector<uint16_t> dataHalf;
+	switch( rPrecision ) {
+		case PRECISION_FLOAT:
+			dataFloat.resize( elementCount );
+			for( uint64_t i=0; i<elementCount; i++ ) {
+				dataFloat[i] = static_cast<float>( get( 0, i ) );
+			}
+			break;
+		case PRECISION_HALF:
+			dataHalf.resize( elementCount );
+			for( uint64_t i=0; i<elementCount; i++ ) {
+				dataHalf[i] = floatToHalf( static_cast<float>( get( 0, i ) ) );
+			}
+			break;
+		case PRECISION_DOUBLE:
+			dataDouble.resize( elementCount );
+			for( uint64_t i=0; i<elementCount; i++ ) {
+				dataDouble[i] = get( 0, i );
+			}
+			break;
+		default:
+			LOG::error() << "[FeatureVecMatrix::" << __FUNCTION__ << "] ERROR: Unknown precision " << rPrecision << "!\n";
+			return( false );
+	}
+	mDataDouble.swap( dataDouble );
+	mDataFloat.swap( dataFloat );
+	mDataHalf.swap( dataHalf );
+	mPrecision = rPrecision;
+	return( true );
+}
+
+//! @returns the memory used by the elements in bytes.
+uint64_t FeatureVecMatrix::getMemorySize() const {
+	return( mDataDouble.capacity() * sizeof( double ) +
+	        mDataFloat.capacity()  * sizeof( float ) +
+	        mDataHalf.capacity()   * sizeof( uint16_t ) );
+}
+
+//! Copies a row into the given array, which has to have getColCount() elements.
+//! @returns false in case of an error. True otherwise.
+bool FeatureVecMatrix::getRow( uint64_t rRow, double* rValues ) const {
+	if( ( rValues == nullptr ) || ( rRow >= mRowCount ) ) {
+		return( false );
+	}
+	if( mPrecision == PRECISION_DOUBLE ) {
+		std::memcpy( rValues, &mDataDouble[rRow * mColCount], mColCount * sizeof( double ) );
+		return( true );
+	}
+	for( uint64_t i=0; i<mColCount; i++ ) {
+		rValues[i] = get( rRow, i );
+	}
+	return( true );
+}
+
+//! Sets a row to the given values. Missing values are set to not-a-number.
+//! @returns false in case of an error e.g. too many values. True otherwise.
+bool FeatureVecMatrix::setRow( uint64_t rRow, const double* rValues, uint64_t rValueCount ) {
+	if( ( rRow >= mRowCount ) || ( rValueCount > mColCount ) ||
+	    ( ( rValues == nullptr ) && ( rValueCount > 0 ) ) ) {
+		return( false );
+	}
+	for( uint64_t i=0; i<mColCount; i++ ) {
+		set( rRow, i, ( i < rValueCount ) ? rValues[i] : _NOT_A_NUMBER_DBL_ );
+	}
+	return( true );
+}
+
+//! @returns a pointer to the elements of a row in double precision. For PRECISION_DOUBLE
+//! this is the matrix itself. Otherwise the row is converted into the given buffer.
+const double* FeatureVecMatrix::getRowDouble( uint64_t rRow, std::vector<double>& rBuffer ) const {
+	if( mPrecision == PRECISION_DOUBLE ) {
+		return( &mDataDouble[rRow * mColCount] );
+	}
+	rBuffer.resize( mColCount );
+	getRow( rRow, rBuffer.data() );
+	return( rBuffer.data() );
+}
+
+//! Converts a float to IEEE 754 half using round to nearest even.
+//! Values beyond the range of half are converted to infinity.
+uint16_t FeatureVecMatrix::floatToHalf( float rValue ) {
+	uint32_t bits;
+	std::memcpy( &bits, &rValue, sizeof( bits ) );
+	const uint16_t sign    = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+	const uint32_t absBits = bits & 0x7FFFFFFF;
+	if( absBits >= 0x7F800000 ) {
+		// Infinity or not-a-number, which keeps a quiet bit.
+		return( sign | 0x7C00 | ( ( absBits > 0x7F800000 ) ? 0x0200 : 0x0000 ) );
+	}
+	if( absBits >= 0x477FF000 ) {
+		// 65520 and above rounds to infinity.
+		return( sign | 0x7C00 );
+	}
+	if( absBits < 0x38800000 ) {
+		// Below the smallest normal half i.e. 2^-14
+		if( absBits < 0x33000000 ) {
+			return( sign ); // Below 2^-25 rounds to zero.
+		}
+		const uint32_t exponent = absBits >> 23;
+		const uint32_t mantissa = ( absBits & 0x007FFFFF ) | 0x00800000;
+		const uint32_t shift    = 126 - exponent;
+		uint32_t halfMantissa   = mantissa >> shift;
+		const uint32_t remainder = mantissa & ( ( 1U << shift ) - 1 );
+		const uint32_t halfway   = 1U << ( shift - 1 );
+		if( ( remainder > halfway ) || ( ( remainder == halfway ) && ( halfMantissa & 1 ) ) ) {
+			halfMantissa++;
+		}
+		return( sign | static_cast<uint16_t>( halfMantissa ) );
+	}
+	// Normal: rebias the exponent from 127 to 15 and round the mantissa from 23 to 10 bits.
+	uint32_t halfBits = ( absBits >> 13 ) - ( 112U << 10 );
+	const uint32_t remainder = absBits & 0x1FFF;
+	if( ( remainder > 0x1000 ) || ( ( remainder == 0x1000 ) && ( halfBits & 1 ) ) ) {
+		halfBits++;
+	}
+	return( sign | static_cast<uint16_t>( halfBits ) );
+}
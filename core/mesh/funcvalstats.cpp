@@ -0,0 +1,294 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/funcvalstats.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Values per chunk processed by one thread.
+	constexpr uint64_t valuesPerChunk = 65536;
+
+	//! Maximum number of bins used for selecting a rank.
+	constexpr uint64_t selectBinCount = 4096;
+}
+
+//! Removes the values and all cached results.
+void FuncValStats::clear() {
+	mBuilt       = false;
+	mValueCount  = 0;
+	mNaNCount    = 0;
+	mFiniteValues.clear();
+	mFiniteValues.shrink_to_fit();
+	mMinVal      = 0.0;
+	mMaxVal      = 0.0;
+	mRankCache.clear();
+	mHistogramCache.clear();
+}
+
+//! Packs the finite values and determines their range.
+//! The order of the values is kept, so the result does not depend on the number of threads.
+//!
+//! @returns false in case of an error. True otherwise - also when there are no finite values.
+bool FuncValStats::build(
+                const vector<double>& rValues,       //!< Values e.g. one per vertex.
+                unsigned int          rThreadCount   //!< Number of threads - zero uses all available cores.
+) {
+	PROFILE_SCOPE( "FuncValStats::build" );
+	clear();
+	mThreadCount = rThreadCount;
+	const uint64_t valueCount = rValues.size();
+	const uint64_t chunkCount = ParallelFor::getChunkCount( valueCount, valuesPerChunk );
+	const unsigned int threadCount = ParallelFor::getThreadCount( mThreadCount );
+
+	// Count and range per chunk:
+	struct sChunkInfo {
+		uint64_t mFiniteCount = 0;
+		uint64_t mNaNCount    = 0;
+		double   mMinVal      = +DBL_MAX;
+		double   mMaxVal      = -DBL_MAX;
+	};
+	vector<sChunkInfo> chunkInfos( chunkCount );
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+		sChunkInfo& chunkInfo = chunkInfos[rChunkIdx];
+		const uint64_t valueEnd = min( ( rChunkIdx + 1 ) * valuesPerChunk, valueCount );
+		for( uint64_t valueIdx=rChunkIdx*valuesPerChunk; valueIdx<valueEnd; valueIdx++ ) {
+			const double currVal = rValues[valueIdx];
+			if( !isfinite( currVal ) ) {
+				chunkInfo.mNaNCount += isnan( currVal ) ? 1 : 0;
+				continue;
+			}
+			chunkInfo.mFiniteCount++;
+			chunkInfo.mMinVal = min( chunkInfo.mMinVal, currVal );
+			chunkInfo.mMaxVal = max( chunkInfo.mMaxVal, currVal );
+		}
+	} );
+
+	// Merge in the order of the chunks:
+	vector<uint64_t> chunkOffsets( chunkCount, 0 );
+	uint64_t finiteCount = 0;
+	mMinVal = +DBL_MAX;
+	mMaxVal = -DBL_MAX;
+	for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+		chunkOffsets[chunkIdx] = finiteCount;
+		finiteCount += chunkInfos[chunkIdx].mFiniteCount;
+		mNaNCount   += chunkInfos[chunkIdx].mNaNCount;
+		mMinVal = min( mMinVal, chunkInfos[chunkIdx].mMinVal );
+		mMaxVal = max( mMaxVal, chunkInfos[chunkIdx].mMaxVal );
+	}
+	if( finiteCount == 0 ) {
+		mMinVal = _NOT_A_NUMBER_DBL_;
+		mMaxVal = _NOT_A_NUMBER_DBL_;
+	}
+
+	// Pack the finite values:
+	mFiniteValues.resize( finiteCount );
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+		uint64_t packedIdx = chunkOffsets[rChunkIdx];
+		const uint64_t valueEnd = min( ( rChunkIdx + 1 ) * valuesPerChunk, valueCount );
+		for( uint64_t valueIdx=rChunkIdx*valuesPerChunk; valueIdx<valueEnd; valueIdx++ ) {
+			if( isfinite( rValues[valueIdx] ) ) {
+				mFiniteValues[packedIdx++] = rValues[valueIdx];
+			}
+		}
+	} );
+
+	mValueCount = valueCount;
+	mBuilt      = true;
+	return( true );
+}
+
+//! Minimum and maximum of the finite values.
+//!
+//! @returns false, when there are no finite values. True otherwise.
+bool FuncValStats::getMinMax( double& rMinVal, double& rMaxVal ) const {
+	rMinVal = mMinVal;
+	rMaxVal = mMaxVal;
+	return( !mFiniteValues.empty() );
+}
+
+//! Value at the given position of the finite values in ascending order i.e. the
+//! element std::sort would place there. Uses a parallel two-pass histogram
+//! instead of sorting and caches the result.
+//!
+//! @returns false in case of an error e.g. rank out of range. True otherwise.
+bool FuncValStats::getRank( uint64_t rRank, double& rValue ) {
+	if( rRank >= mFiniteValues.size() ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: Rank " << rRank << " out of range of "
+		             << mFiniteValues.size() << " values!\n";
+		return( false );
+	}
+	const auto cached = mRankCache.find( rRank );
+	if( cached != mRankCache.end() ) {
+		rValue = cached->second;
+		return( true );
+	}
+	PROFILE_SCOPE( "FuncValStats::getRank" );
+
+	// Single bin i.e. plain std::nth_element of a copy for a constant or tiny range:
+	const uint64_t valueCount = mFiniteValues.size();
+	uint64_t binCount = min( selectBinCount, valueCount );
+	double   binLen   = ( mMaxVal - mMinVal ) / static_cast<double>( binCount );
+	if( !( binLen > 0.0 ) ) {
+		binCount = 1;
+		binLen   = _INFINITE_DBL_;
+	}
+	const uint64_t chunkCount  = ParallelFor::getChunkCount( valueCount, valuesPerChunk );
+	const unsigned int threadCount = ParallelFor::getThreadCount( mThreadCount );
+
+	// First pass: count per bin to find the bin holding the rank.
+	uint64_t selectedBin  = 0;
+	uint64_t rankInBin    = rRank;
+	if( binCount > 1 ) {
+		vector<uint64_t> chunkBinCounts( chunkCount * binCount, 0 );
+		ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+			uint64_t* binCounts = &chunkBinCounts[rChunkIdx*binCount];
+			const uint64_t valueEnd = min( ( rChunkIdx + 1 ) * valuesPerChunk, valueCount );
+			for( uint64_t valueIdx=rChunkIdx*valuesPerChunk; valueIdx<valueEnd; valueIdx++ ) {
+				binCounts[getBin( mFiniteValues[valueIdx], binCount, binLen )]++;
+			}
+		} );
+		uint64_t valuesBelow = 0;
+		for( selectedBin=0; selectedBin<binCount; selectedBin++ ) {
+			uint64_t binTotal = 0;
+			for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+				binTotal += chunkBinCounts[chunkIdx*binCount+selectedBin];
+			}
+			if( rRank < valuesBelow + binTotal ) {
+				break;
+			}
+			valuesBelow += binTotal;
+		}
+		rankInBin = rRank - valuesBelow;
+	}
+
+	// Second pass: gather the values of the bin and select.
+	vector<vector<double>> chunkBinValues( chunkCount );
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t valueEnd = min( ( rChunkIdx + 1 ) * valuesPerChunk, valueCount );
+		for( uint64_t valueIdx=rChunkIdx*valuesPerChunk; valueIdx<valueEnd; valueIdx++ ) {
+			if( getBin( mFiniteValues[valueIdx], binCount, binLen ) == selectedBin ) {
+				chunkBinValues[rChunkIdx].push_back( mFiniteValues[valueIdx] );
+			}
+		}
+	} );
+	vector<double> binValues;
+	for( const vector<double>& currValues : chunkBinValues ) {
+		binValues.insert( binValues.end(), currValues.begin(), currValues.end() );
+	}
+	if( rankInBin >= binValues.size() ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: Inconsistent bin counts!\n";
+		return( false );
+	}
+	nth_element( binValues.begin(), binValues.begin() + rankInBin, binValues.end() );
+	rValue = binValues[rankInBin];
+	mRankCache[rRank] = rValue;
+	return( true );
+}
+
+//! Value of the given quantile of the finite values i.e. the value at the rank
+//! round( rQuantile * ( number of finite values - 1 ) ) as Mesh::getFuncValuesMinMaxQuantil.
+//!
+//! @returns false in case of an error e.g. no finite values. True otherwise.
+bool FuncValStats::getQuantile(
+                double    rQuantile,    //!< Quantile within [0.0, 1.0].
+                double&   rValue,       //!< Value of the quantile.
+                uint64_t* rRank         //!< Optional: rank of the value.
+) {
+	if( !( rQuantile >= 0.0 ) || ( rQuantile > 1.0 ) ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: Quantile " << rQuantile << " out of range!\n";
+		return( false );
+	}
+	if( mFiniteValues.empty() ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: No finite values!\n";
+		return( false );
+	}
+	const uint64_t rank = static_cast<uint64_t>( round( rQuantile * static_cast<double>( mFiniteValues.size() - 1 ) ) );
+	if( rRank != nullptr ) {
+		(*rRank) = rank;
+	}
+	return( getRank( rank, rValue ) );
+}
+
+//! Number of finite values per bin of equal length between the minimum and the maximum.
+//! The maximum is counted within the last bin. The result is cached per number of bins.
+//!
+//! @returns false in case of an error e.g. no range. True otherwise.
+bool FuncValStats::getHistogram(
+                uint64_t          rBinCount,   //!< Number of bins.
+                vector<uint64_t>& rCounts      //!< Number of values per bin.
+) {
+	const auto cached = mHistogramCache.find( rBinCount );
+	if( cached != mHistogramCache.end() ) {
+		rCounts = cached->second;
+		return( true );
+	}
+	if( ( rBinCount == 0 ) || mFiniteValues.empty() ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: No bins or no finite values!\n";
+		return( false );
+	}
+	const double binLen = ( mMaxVal - mMinVal ) / static_cast<double>( rBinCount );
+	if( !( binLen > 0.0 ) ) {
+		LOG::error() << "[FuncValStats::" << __FUNCTION__ << "] ERROR: Values have no range!\n";
+		return( false );
+	}
+	PROFILE_SCOPE( "FuncValStats::getHistogram" );
+	const uint64_t valueCount = mFiniteValues.size();
+	const uint64_t chunkCount = ParallelFor::getChunkCount( valueCount, valuesPerChunk );
+	vector<uint64_t> chunkBinCounts( chunkCount * rBinCount, 0 );
+	ParallelFor::forEachChunk( chunkCount, ParallelFor::getThreadCount( mThreadCount ), [&]( uint64_t rChunkIdx ) {
+		uint64_t* binCounts = &chunkBinCounts[rChunkIdx*rBinCount];
+		const uint64_t valueEnd = min( ( rChunkIdx + 1 ) * valuesPerChunk, valueCount );
+		for( uint64_t valueIdx=rChunkIdx*valuesPerChunk; valueIdx<valueEnd; valueIdx++ ) {
+			binCounts[getBin( mFiniteValues[valueIdx], rBinCount, binLen )]++;
+		}
+	} );
+	rCounts.assign( rBinCount, 0 );
+	for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+		for( uint64_t binIdx=0; binIdx<rBinCount; binIdx++ ) {
+			rCounts[binIdx] += chunkBinCounts[chunkIdx*rBinCount+binIdx];
+		}
+	}
+	mHistogramCache[rBinCount] = rCounts;
+	return( true );
+}
+
+//! @returns the bin of a finite value. Values beyond the last bin e.g. the maximum are put into the last bin.
+uint64_t FuncValStats::getBin( double rValue, uint64_t rBinCount, double rBinLen ) const {
+	const double binPos = floor( ( rValue - mMinVal ) / rBinLen );
+	if( !( binPos < static_cast<double>( rBinCount ) ) ) {
+		return( rBinCount - 1 );
+	}
+	if( binPos < 0.0 ) {
+		return( 0 );
+	}
+	return( static_cast<uint64_t>( binPos ) );
+}
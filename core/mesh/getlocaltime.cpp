@@ -0,0 +1,58 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <GigaMesh/getlocaltime.h>
+
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+//! Thread-safe replacement of std::localtime, which returns a pointer to a static buffer
+//! shared by all threads e.g. when meshes are processed in parallel by the commandline tools.
+//!
+//! @returns false in case of an error.
+bool getLocalTime(
+        std::time_t rTime,
+        std::tm&    rLocalTime
+) {
+#ifdef WIN32
+	return( localtime_s( &rLocalTime, &rTime ) == 0 );
+#else
+	return( localtime_r( &rTime, &rLocalTime ) != nullptr );
+#endif
+}
+
+//! Thread-safe replacement of std::asctime( std::localtime( ... ) ) and std::ctime
+//! e.g. "Mon Oct 19 06:37:33 2026" including the trailing line break.
+//!
+//! @returns the local time as string, which is empty in case of an error.
+std::string getLocalTimeStr(
+        std::time_t rTime
+) {
+	std::tm localTime;
+	if( !getLocalTime( rTime, localTime ) ) {
+		return( std::string() );
+	}
+	std::ostringstream timeStr;
+	timeStr.imbue( std::locale::classic() );
+	timeStr << std::put_time( &localTime, "%a %b %e %H:%M:%S %Y\n" );
+	return( timeStr.str() );
+}
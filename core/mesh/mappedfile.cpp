@@ -0,0 +1,127 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/mappedfile.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <GigaMesh/logging/Logging.h>
+
+//! Constructor mapping the given file - see isOpen.
+MappedFile::MappedFile( const std::filesystem::path& rFileName ) {
+	open( rFileName );
+}
+
+//! Destructor unmapping the file.
+MappedFile::~MappedFile() {
+	close();
+}
+
+//! Maps the given file read-only. A previously mapped file is closed.
+//! @returns false in case of an error. True otherwise.
+bool MappedFile::open( const std::filesystem::path& rFileName ) {
+	close();
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileW( rFileName.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+	                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+	if( fileHandle == INVALID_HANDLE_VALUE ) {
+		LOG::error() << "[MappedFile::" << __FUNCTION__ << "] ERROR: Could not open " << rFileName << "!\n";
+		return( false );
+	}
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx( fileHandle, &fileSize ) ) {
+		CloseHandle( fileHandle );
+		LOG::error() << "[MappedFile::" << __FUNCTION__ << "] ERROR: Could not determine the size of " << rFileName << "!\n";
+		return( false );
+	}
+	mFileHandle = fileHandle;
+	mSize       = static_cast<uint64_t>( fileSize.QuadPart );
+	mIsOpen     = true;
+	if( mSize == 0 ) {
+		return( true );
+	}
+	mMappingHandle = CreateFileMappingW( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if( mMappingHandle != nullptr ) {
+		mData = static_cast<const char*>( MapViewOfFile( mMappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+	}
+#else
+	const int fileDescriptor = ::open( rFileName.c_str(), O_RDONLY );
+	if( fileDescriptor < 0 ) {
+		LOG::error() << "[MappedFile::" << __FUNCTION__ << "] ERROR: Could not open " << rFileName << "!\n";
+		return( false );
+	}
+	struct stat fileStat;
+	if( fstat( fileDescriptor, &fileStat ) != 0 ) {
+		::close( fileDescriptor );
+		LOG::error() << "[MappedFile::" << __FUNCTION__ << "] ERROR: Could not determine the size of " << rFileName << "!\n";
+		return( false );
+	}
+	mSize   = static_cast<uint64_t>( fileStat.st_size );
+	mIsOpen = true;
+	if( mSize > 0 ) {
+		void* mappedData = mmap( nullptr, mSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+		if( mappedData != MAP_FAILED ) {
+			madvise( mappedData, mSize, MADV_SEQUENTIAL );
+			mData = static_cast<const char*>( mappedData );
+		}
+	}
+	// The mapping remains valid after closing the descriptor.
+	::close( fileDescriptor );
+#endif
+	if( ( mSize > 0 ) && ( mData == nullptr ) ) {
+		LOG::error() << "[MappedFile::" << __FUNCTION__ << "] ERROR: Could not map " << rFileName << " into memory!\n";
+		close();
+		return( false );
+	}
+	return( true );
+}
+
+//! Unmaps the file.
+void MappedFile::close() {
+#ifdef _WIN32
+	if( mData != nullptr ) {
+		UnmapViewOfFile( mData );
+	}
+	if( mMappingHandle != nullptr ) {
+		CloseHandle( mMappingHandle );
+	}
+	if( mFileHandle != nullptr ) {
+		CloseHandle( mFileHandle );
+	}
+	mMappingHandle = nullptr;
+	mFileHandle    = nullptr;
+#else
+	if( mData != nullptr ) {
+		munmap( const_cast<char*>( mData ), mSize );
+	}
+#endif
+	mData   = nullptr;
+	mSize   = 0;
+	mIsOpen = false;
+}
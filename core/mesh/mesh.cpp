@@ -32,6 +32,9 @@
 #include <algorithm> // std::find_if
 #include <iomanip>
 #include <regex>
+#include <numeric> // std::iota
+#include <atomic>
+#include <unordered_map>
 
 #include <cstdlib>
 
@@ -58,7 +61,12 @@
 #include <GigaMesh/mesh/compfeaturevecs.h>
 
 #include <GigaMesh/mesh/ellipsedisc.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/mesh/facereduction.h>
+#include <GigaMesh/mesh/numerictable.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/getlocaltime.h>
+#include <GigaMesh/profiling/Profiling.h>
 
 
 extern "C"
@@ -86,6 +94,63 @@ extern "C"
 
 using namespace std;
 
+namespace {
+	//! Increments the generation of the function values of the vertices, when a method writing
+	//! them returns, so the cached statistics are rebuilt - see Mesh::getFuncValStats.
+	//! Nothing is done, when the method already called Mesh::changedVertFuncVal.
+	class FuncValWriteScope {
+		public:
+			explicit FuncValWriteScope( uint64_t& rGeneration ) : mGeneration( rGeneration ), mGenerationStart( rGeneration ) {}
+			~FuncValWriteScope() {
+				if( mGeneration == mGenerationStart ) {
+					mGeneration++;
+				}
+			}
+		private:
+			uint64_t&      mGeneration;
+			const uint64_t mGenerationStart;
+	};
+
+	//! Positions of primitives within a vector of the Mesh without changing their indices.
+	//! The index is used, when it matches the position, which is the typical case.
+	//! Otherwise the position is looked up in a copy sorted by address.
+	template <typename T>
+	class PrimitivePositions {
+		public:
+			explicit PrimitivePositions( const std::vector<T*>& rPrimitives ) : mPrimitives( rPrimitives ) {
+				bool indicesMatch = true;
+				for( uint64_t pos=0; pos<rPrimitives.size() && indicesMatch; pos++ ) {
+					indicesMatch = ( rPrimitives[pos]->getIndex() == static_cast<int>( pos ) );
+				}
+				if( indicesMatch ) {
+					return;
+				}
+				mSorted.reserve( rPrimitives.size() );
+				for( uint64_t pos=0; pos<rPrimitives.size(); pos++ ) {
+					mSorted.emplace_back( rPrimitives[pos], pos );
+				}
+				std::sort( mSorted.begin(), mSorted.end() );
+			}
+
+			//! @returns the position of the primitive or the size of the vector, when it is not part of it.
+			uint64_t get( const T* rPrimitive ) const {
+				const int index = rPrimitive->getIndex();
+				if( ( index >= 0 ) && ( static_cast<uint64_t>( index ) < mPrimitives.size() ) && ( mPrimitives[index] == rPrimitive ) ) {
+					return( index );
+				}
+				const auto found = std::lower_bound( mSorted.begin(), mSorted.end(), std::make_pair( rPrimitive, uint64_t( 0 ) ) );
+				if( ( found == mSorted.end() ) || ( found->first != rPrimitive ) ) {
+					return( mPrimitives.size() );
+				}
+				return( found->second );
+			}
+
+		private:
+			const std::vector<T*>&                       mPrimitives;
+			std::vector<std::pair<const T*,uint64_t>> mSorted;    //!< Empty, when all indices match the positions.
+	};
+} // anonymous namespace
+
 #ifdef THREADS
 const auto NUM_THREADS = std::thread::hardware_concurrency() * 2;
 
@@ -130,24 +195,6 @@ const auto NUM_THREADS = std::thread::hardware_concurrency() * 2;
 	}
 #endif
 
-#define FUNCTION_VALUES_STASH \
-	uint64_t nrOfVertices = getVertexNr(); \
-	vector<double> funcValStash; \
-	funcValStash.assign( nrOfVertices, _NOT_A_NUMBER_DBL_ ); \
-	for( uint64_t vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) { \
-	    Vertex* currVertex = getVertexPos( vertIdx ); \
-	    double currFuncValue; \
-	    currVertex->getFuncValue( &currFuncValue ); \
-	    funcValStash.at( vertIdx ) = currFuncValue; \
-	}
-
-#define FUNCTION_VALUES_STASH_RETRIEVE \
-	for( uint64_t vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) { \
-	    Vertex* currVertex = getVertexPos( vertIdx ); \
-	    currVertex->setFuncValue( funcValStash.at( vertIdx ) ); \
-	} \
-	funcValStash.clear();
-
 #define MESHINITDEFAULTS                        \
 	ShowProgress( "[Mesh]" )
 
@@ -170,10 +217,25 @@ Mesh::Mesh( const std::filesystem::path& rFileName, bool& rReadSuccess )
 #else
     LOG::debug() << "[Mesh::" << __FUNCTION__ << "] constructed from Faces - NOT THREAD SAFE.\n";
 #endif
+	// Native cache next to the file - see MeshCache::setMode
+	const MeshCache::eMode cacheMode = MeshCache::getMode();
+	if( cacheMode != MeshCache::CACHE_OFF ) {
+		MeshCache meshCache;
+		if( meshCache.open( MeshCache::getSidecarName( rFileName ), rFileName ) &&
+		    establishStructureFromCache( meshCache ) ) {
+			setFileNameFull( rFileName );
+			rReadSuccess = true;
+			showProgressStop( string( "Construct Mesh" ) );
+			return;
+		}
+	}
 	std::vector<sVertexProperties> vertexProps;
 	std::vector<sFaceProperties> faceProps;
 	rReadSuccess = readFile( rFileName, vertexProps, faceProps );
 	establishStructure( vertexProps, faceProps );
+	if( rReadSuccess && ( cacheMode == MeshCache::CACHE_READ_WRITE ) ) {
+		writeMeshCache( MeshCache::getSidecarName( rFileName ) );
+	}
 	showProgressStop( string( "Construct Mesh" ) );
 }
 
@@ -876,6 +938,7 @@ void Mesh::establishStructure(
                 std::vector<sVertexProperties>& rVertexProps,
                 std::vector<sFaceProperties>& rFaceProps
 ) {
+	PROFILE_SCOPE( "Mesh::establishStructure" );
 	int timeStart = clock(); // for performance mesurement
 
     #ifdef SHOW_MALLOC_STATS
@@ -905,12 +968,16 @@ void Mesh::establishStructure(
 	mMaxY = -DBL_MAX;
 	mMinZ = +DBL_MAX;
 	mMaxZ = -DBL_MAX;
-	double* featureVecVerticesPtr = mFeatureVecVertices.data();
+	// Move the feature vectors into the matrix of the mesh, which is done without copy in double precision:
+	mFeatureVecMatrix.clear();
+	if( ( mFeatureVecVerticesLen > 0 ) && ( !mFeatureVecVertices.empty() ) ) {
+		mFeatureVecMatrix.assign( std::move( mFeatureVecVertices ), mFeatureVecVerticesLen );
+	}
 	for(size_t i=0; i<rVertexProps.size(); ++i ) {
 		VertexOfFace* newVert = new VertexOfFace( i, rVertexProps[i] );
 		// Assign feature vectors, when present:
-		if( mFeatureVecVerticesLen > 0 ) {
-			newVert->assignFeatureVec( featureVecVerticesPtr+(i*mFeatureVecVerticesLen), mFeatureVecVerticesLen );
+		if( i < mFeatureVecMatrix.getRowCount() ) {
+			newVert->setFeatureVecView( &mFeatureVecMatrix, i );
 		}
 		// Bounding Box:
 		if( mMinX > rVertexProps.at( i ).mCoordX ) {
@@ -937,7 +1004,7 @@ void Mesh::establishStructure(
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
 	// Initalize storage for precomuted information about the feature vectors
 	changedVertFeatureVectors();
-	mFeatureVecVertices.clear(); // Can be clearad, because of newVert->assignFeatureVec (see above)
+	std::vector<double>().swap( mFeatureVecVertices ); // Can be cleared, because of mFeatureVecMatrix (see above)
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
 
     #ifdef SHOW_MALLOC_STATS
@@ -1194,6 +1261,211 @@ void Mesh::establishStructure(
 	//cout << "[Mesh::" << __FUNCTION__ << "] OCTREE done in " << (float)( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
 }
 
+//! Establish our Mesh structure from a native cache instead of reading a file.
+//! Vertices and faces are created from the memory-mapped arrays and connected
+//! using the stored adjacency, so the neighbourhood is not searched again.
+//! The steps after the connectivity equal establishStructure.
+//!
+//! @returns false in case of an inconsistent cache, which leaves an empty Mesh. True otherwise.
+bool Mesh::establishStructureFromCache(
+                const MeshCache& rMeshCache
+) {
+	PROFILE_SCOPE( "Mesh::establishStructureFromCache" );
+	const uint64_t vertexCount   = rMeshCache.getVertexCount();
+	const uint64_t faceCount     = rMeshCache.getFaceCount();
+	const uint64_t featureVecLen = rMeshCache.getFeatureVecLen();
+
+	// Fetch and check the sections:
+	bool sectionsValid = true;
+	const double*   vertX         = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_X, vertexCount, sectionsValid );
+	const double*   vertY         = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_Y, vertexCount, sectionsValid );
+	const double*   vertZ         = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_Z, vertexCount, sectionsValid );
+	const double*   vertNormalX   = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_NORMAL_X, vertexCount, sectionsValid );
+	const double*   vertNormalY   = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_NORMAL_Y, vertexCount, sectionsValid );
+	const double*   vertNormalZ   = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_NORMAL_Z, vertexCount, sectionsValid );
+	const double*   vertFuncVal   = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_FUNCVAL, vertexCount, sectionsValid );
+	const uint8_t*  vertRGBA      = rMeshCache.getSection<uint8_t>( MeshCache::SECTION_VERT_RGBA, vertexCount*4, sectionsValid );
+	const uint64_t* vertLabel     = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_VERT_LABEL, vertexCount, sectionsValid );
+	const uint64_t* vertFlags     = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_VERT_FLAGS, vertexCount, sectionsValid );
+	const double*   vertFtVec     = rMeshCache.getSection<double>( MeshCache::SECTION_VERT_FTVEC, vertexCount*featureVecLen, sectionsValid );
+	const uint64_t* vertFacesOffs = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_VERT_FACES_OFFSET, vertexCount+1, sectionsValid );
+	const uint64_t* faceVerts     = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_FACE_VERTICES, faceCount*3, sectionsValid );
+	const uint64_t* faceFlags     = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_FACE_FLAGS, faceCount, sectionsValid );
+	const uint64_t* faceNeighOffs = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_FACE_NEIGHBOURS_OFFSET, faceCount+1, sectionsValid );
+	uint64_t vertFacesCount = 0;
+	uint64_t faceNeighCount = 0;
+	const uint64_t* vertFaces  = rMeshCache.getSection<uint64_t>( MeshCache::SECTION_VERT_FACES, vertFacesCount );
+	const int64_t*  faceNeighs = rMeshCache.getSection<int64_t>( MeshCache::SECTION_FACE_NEIGHBOURS, faceNeighCount );
+	if( sectionsValid ) {
+		// The indices are checked, so a broken cache can not lead to invalid references.
+		sectionsValid = ( vertFacesOffs[vertexCount] == vertFacesCount ) && ( faceNeighOffs[faceCount] == faceNeighCount ) &&
+		                std::is_sorted( vertFacesOffs, vertFacesOffs + vertexCount + 1 ) &&
+		                std::is_sorted( faceNeighOffs, faceNeighOffs + faceCount + 1 ) &&
+		                std::all_of( faceVerts, faceVerts + faceCount*3, [vertexCount]( uint64_t rIdx ) { return( rIdx < vertexCount ); } ) &&
+		                std::all_of( vertFaces, vertFaces + vertFacesCount, [faceCount]( uint64_t rIdx ) { return( rIdx < faceCount ); } ) &&
+		                std::all_of( faceNeighs, faceNeighs + faceNeighCount, [faceCount]( int64_t rIdx ) {
+		                    return( ( rIdx >= -1 ) && ( rIdx < static_cast<int64_t>( faceCount ) ) ); } );
+		for( uint64_t faceIdx=0; sectionsValid && ( faceIdx<faceCount ); faceIdx++ ) {
+			const uint64_t neighCount = faceNeighOffs[faceIdx+1] - faceNeighOffs[faceIdx];
+			sectionsValid = ( neighCount >= 3 ) && ( neighCount <= USHRT_MAX );
+		}
+	}
+	if( !sectionsValid ) {
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] Cache is inconsistent and will be ignored!\n";
+		return( false );
+	}
+
+	// Prepare arrays as establishStructure:
+	for( auto& face : mFaces ) {
+		delete face;
+	}
+	mFaces.clear();
+	for( auto& vertex : mVertices ) {
+		delete vertex;
+	}
+	mVertices.clear();
+	mFeatureVecMatrix.clear();
+	if( featureVecLen > 0 ) {
+		mFeatureVecMatrix.assign( std::vector<double>( vertFtVec, vertFtVec + vertexCount*featureVecLen ), featureVecLen );
+	}
+
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize   = 16384; // Primitives per task.
+
+	// Vertices including the bounding box:
+	mVertices.resize( vertexCount );
+	const uint64_t vertChunks = ParallelFor::getChunkCount( vertexCount, chunkSize );
+	std::vector<std::array<double,6>> chunkBoundingBoxes( vertChunks, { +DBL_MAX, -DBL_MAX, +DBL_MAX, -DBL_MAX, +DBL_MAX, -DBL_MAX } );
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::array<double,6>& boundingBox = chunkBoundingBoxes[rChunkIdx];
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			sVertexProperties vertexProps;
+			vertexProps.mCoordX   = vertX[vertIdx];
+			vertexProps.mCoordY   = vertY[vertIdx];
+			vertexProps.mCoordZ   = vertZ[vertIdx];
+			vertexProps.mNormalX  = vertNormalX[vertIdx];
+			vertexProps.mNormalY  = vertNormalY[vertIdx];
+			vertexProps.mNormalZ  = vertNormalZ[vertIdx];
+			vertexProps.mFuncVal  = vertFuncVal[vertIdx];
+			vertexProps.mColorRed = vertRGBA[vertIdx*4];
+			vertexProps.mColorGrn = vertRGBA[vertIdx*4+1];
+			vertexProps.mColorBle = vertRGBA[vertIdx*4+2];
+			vertexProps.mColorAlp = vertRGBA[vertIdx*4+3];
+			vertexProps.mLabelId  = vertLabel[vertIdx];
+			vertexProps.mFlags    = vertFlags[vertIdx];
+			VertexOfFace* newVert = new VertexOfFace( vertIdx, vertexProps );
+			if( vertIdx < mFeatureVecMatrix.getRowCount() ) {
+				newVert->setFeatureVecView( &mFeatureVecMatrix, vertIdx );
+			}
+			mVertices[vertIdx] = newVert;
+			boundingBox[0] = std::min( boundingBox[0], vertexProps.mCoordX );
+			boundingBox[1] = std::max( boundingBox[1], vertexProps.mCoordX );
+			boundingBox[2] = std::min( boundingBox[2], vertexProps.mCoordY );
+			boundingBox[3] = std::max( boundingBox[3], vertexProps.mCoordY );
+			boundingBox[4] = std::min( boundingBox[4], vertexProps.mCoordZ );
+			boundingBox[5] = std::max( boundingBox[5], vertexProps.mCoordZ );
+		}
+	} );
+	mMinX = +DBL_MAX;
+	mMaxX = -DBL_MAX;
+	mMinY = +DBL_MAX;
+	mMaxY = -DBL_MAX;
+	mMinZ = +DBL_MAX;
+	mMaxZ = -DBL_MAX;
+	for( const std::array<double,6>& boundingBox : chunkBoundingBoxes ) {
+		mMinX = std::min( mMinX, boundingBox[0] );
+		mMaxX = std::max( mMaxX, boundingBox[1] );
+		mMinY = std::min( mMinY, boundingBox[2] );
+		mMaxY = std::max( mMaxY, boundingBox[3] );
+		mMinZ = std::min( mMinZ, boundingBox[4] );
+		mMaxZ = std::max( mMaxZ, boundingBox[5] );
+	}
+	changedVertFeatureVectors();
+	std::vector<double>().swap( mFeatureVecVertices );
+
+	// Faces - not connected to the vertices, which is done using the stored adjacency:
+	mFaces.resize( faceCount );
+	const uint64_t faceChunks = ParallelFor::getChunkCount( faceCount, chunkSize );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			Face* newFace = new Face( faceIdx,
+			                          static_cast<VertexOfFace*>( mVertices[faceVerts[faceIdx*3]] ),
+			                          static_cast<VertexOfFace*>( mVertices[faceVerts[faceIdx*3+1]] ),
+			                          static_cast<VertexOfFace*>( mVertices[faceVerts[faceIdx*3+2]] ),
+			                          false );
+			newFace->setFlagAll( faceFlags[faceIdx] );
+			mFaces[faceIdx] = newFace;
+		}
+	} );
+	LOG::info() << "[Mesh::" << __FUNCTION__ << "] Faces set: " << mFaces.size() << "\n";
+	if( faceCount == 0 ) {
+		LOG::info() << "[Mesh::" << __FUNCTION__ << "] Point cloud dedected - no further Mesh-setup possible!\n";
+		return( true );
+	}
+
+	// Connectivity:
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::vector<Face*> adjacentFaces;
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			adjacentFaces.clear();
+			for( uint64_t i=vertFacesOffs[vertIdx]; i<vertFacesOffs[vertIdx+1]; i++ ) {
+				adjacentFaces.push_back( mFaces[vertFaces[i]] );
+			}
+			static_cast<VertexOfFace*>( mVertices[vertIdx] )->setAdjacentFaces( adjacentFaces.data(), static_cast<int>( adjacentFaces.size() ) );
+		}
+	} );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::vector<Face*> neighbourFaces;
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			neighbourFaces.clear();
+			for( uint64_t i=faceNeighOffs[faceIdx]; i<faceNeighOffs[faceIdx+1]; i++ ) {
+				neighbourFaces.push_back( ( faceNeighs[i] < 0 ) ? nullptr : mFaces[faceNeighs[i]] );
+			}
+			mFaces[faceIdx]->setNeighbourFacesAll( neighbourFaces.data(), static_cast<unsigned short>( neighbourFaces.size() ) );
+		}
+	} );
+
+	// Meta-data:
+	uint64_t metaBytes = 0;
+	const char* metaData = rMeshCache.getSection<char>( MeshCache::SECTION_META_STRINGS, metaBytes );
+	uint64_t metaPos = 0;
+	for( int metaIdx=0; metaIdx<ModelMetaData::META_STRINGS_COUNT; metaIdx++ ) {
+		uint64_t metaLen = 0;
+		if( metaPos + sizeof( metaLen ) > metaBytes ) {
+			break;
+		}
+		std::memcpy( &metaLen, metaData + metaPos, sizeof( metaLen ) );
+		metaPos += sizeof( metaLen );
+		if( metaLen > metaBytes - metaPos ) {
+			break;
+		}
+		getModelMetaDataRef().setModelMetaString( static_cast<ModelMetaData::eMetaStrings>( metaIdx ), std::string( metaData + metaPos, metaLen ) );
+		metaPos += metaLen;
+	}
+
+	// Remaining steps of establishStructure:
+	removePolylinesAll();
+	MeshSeedExt::clear();
+	deSelMVertsAll();
+	for( auto const& currVertex: mVertices ) {
+		if( currVertex->getFlag( FLAG_SELECTED ) ) {
+			mSelectedMVerts.insert( currVertex );
+		}
+		currVertex->isFuncValLocalMinimum();
+		currVertex->isFuncValLocalMaximum();
+	}
+	Vector3D zAxis( 0.0, 0.0, 1.0, -getZ() );
+	mPlane.setPlaneHNF( &zAxis );
+	dumpMeshInfo( true );
+	delete mOctree;
+	mOctree = nullptr;
+	return( true );
+}
+
 //! Generates Octree(s)
 //! @param[in] vertexmaxnr maximum number of vertices per cube
 //!            if vertexmaxnr==-1 no new octree vertex will be constructed
@@ -1278,6 +1550,7 @@ double Mesh::getMaxZ() const {
 bool Mesh::writeFile(
                 const filesystem::path& rFileName
 ) {
+	PROFILE_SCOPE( "Mesh::writeFile" );
 	//! 1. Clear anr Re-Create arrays
 	MeshSeedExt::clear();
 
@@ -1321,6 +1594,140 @@ bool Mesh::writeFile(
 	return retVal;
 }
 
+//! Write the native cache holding the arrays and the connectivity of the Mesh - see MeshCache.
+//! The source is the file the Mesh was read from, which is typically done right after reading.
+//! Meshes with texture coordinates or polylines are not supported.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::writeMeshCache(
+                const std::filesystem::path& rCacheFile
+) {
+	PROFILE_SCOPE( "Mesh::writeMeshCache" );
+	if( getModelMetaDataRef().hasTextureCoordinates() || getModelMetaDataRef().hasTextureFiles() || !mPolyLines.empty() ) {
+		LOG::info() << "[Mesh::" << __FUNCTION__ << "] Textures and polylines are not supported by the cache.\n";
+		return( false );
+	}
+	const std::filesystem::path sourceFile = getFullName();
+	if( sourceFile.empty() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Mesh was not read from a file!\n";
+		return( false );
+	}
+	const uint64_t vertexCount   = getVertexNr();
+	const uint64_t faceCount     = getFaceNr();
+	const uint64_t featureVecLen = getFeatureVecLenMax( Primitive::IS_VERTEX );
+
+	// The connectivity refers to the positions within the vectors:
+	const PrimitivePositions<Vertex> vertexPositions( mVertices );
+	const PrimitivePositions<Face>   facePositions( mFaces );
+
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize   = 16384; // Primitives per task.
+
+	// Vertices as structure of arrays:
+	std::vector<double>   vertCoords[7];   // x, y, z, nx, ny, nz, function value.
+	std::vector<uint8_t>  vertRGBA( vertexCount*4 );
+	std::vector<uint64_t> vertLabel( vertexCount );
+	std::vector<uint64_t> vertFlags( vertexCount );
+	std::vector<double>   vertFtVec( vertexCount*featureVecLen, _NOT_A_NUMBER_DBL_ );
+	std::vector<uint64_t> vertFacesOffs( vertexCount+1, 0 );
+	for( std::vector<double>& vertCoord : vertCoords ) {
+		vertCoord.resize( vertexCount );
+	}
+	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
+		vertFacesOffs[vertIdx+1] = vertFacesOffs[vertIdx] + getVertexPos( vertIdx )->get1RingFaceCount();
+	}
+	std::vector<uint64_t> vertFaces( vertFacesOffs[vertexCount] );
+	std::atomic<uint64_t> errorCtr( 0 );
+	const uint64_t vertChunks = ParallelFor::getChunkCount( vertexCount, chunkSize );
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::vector<Face*> adjacentFaces;
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			Vertex* currVertex = getVertexPos( vertIdx );
+			sVertexProperties vertexProps;
+			if( !currVertex->copyVertexPropsTo( vertexProps ) ) {
+				errorCtr++;
+			}
+			vertCoords[0][vertIdx] = vertexProps.mCoordX;
+			vertCoords[1][vertIdx] = vertexProps.mCoordY;
+			vertCoords[2][vertIdx] = vertexProps.mCoordZ;
+			vertCoords[3][vertIdx] = vertexProps.mNormalX;
+			vertCoords[4][vertIdx] = vertexProps.mNormalY;
+			vertCoords[5][vertIdx] = vertexProps.mNormalZ;
+			vertCoords[6][vertIdx] = vertexProps.mFuncVal;
+			vertRGBA[vertIdx*4]    = vertexProps.mColorRed;
+			vertRGBA[vertIdx*4+1]  = vertexProps.mColorGrn;
+			vertRGBA[vertIdx*4+2]  = vertexProps.mColorBle;
+			vertRGBA[vertIdx*4+3]  = vertexProps.mColorAlp;
+			vertLabel[vertIdx]     = vertexProps.mLabelId;
+			vertFlags[vertIdx]     = vertexProps.mFlags;
+			if( featureVecLen > 0 ) {
+				currVertex->copyFeatureVecTo( &vertFtVec[vertIdx*featureVecLen] );
+			}
+			adjacentFaces.clear();
+			currVertex->getFaces( &adjacentFaces );
+			for( uint64_t i=0; i<adjacentFaces.size(); i++ ) {
+				vertFaces[vertFacesOffs[vertIdx]+i] = facePositions.get( adjacentFaces[i] );
+			}
+		}
+	} );
+
+	// Faces including their neighbours:
+	std::vector<uint64_t> faceVerts( faceCount*3 );
+	std::vector<uint64_t> faceFlags( faceCount );
+	std::vector<uint64_t> faceNeighOffs( faceCount+1, 0 );
+	std::vector<int64_t>  faceNeighs;
+	std::vector<Face*>    neighbourFaces;
+	for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+		Face* currFace = getFacePos( faceIdx );
+		faceVerts[faceIdx*3]   = vertexPositions.get( currFace->getVertA() );
+		faceVerts[faceIdx*3+1] = vertexPositions.get( currFace->getVertB() );
+		faceVerts[faceIdx*3+2] = vertexPositions.get( currFace->getVertC() );
+		if( !currFace->getFlagAll( &faceFlags[faceIdx] ) ) {
+			errorCtr++;
+		}
+		currFace->getNeighbourFacesAll( neighbourFaces );
+		for( Face* neighbourFace : neighbourFaces ) {
+			faceNeighs.push_back( ( neighbourFace == nullptr ) ? -1 : static_cast<int64_t>( facePositions.get( neighbourFace ) ) );
+		}
+		faceNeighOffs[faceIdx+1] = faceNeighs.size();
+	}
+	if( errorCtr > 0 ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Fetching the flags failed " << errorCtr << " times!\n";
+		return( false );
+	}
+
+	// Meta-data:
+	std::vector<char> metaStrings;
+	for( int metaIdx=0; metaIdx<ModelMetaData::META_STRINGS_COUNT; metaIdx++ ) {
+		const std::string metaString = getModelMetaDataRef().getModelMetaString( static_cast<ModelMetaData::eMetaStrings>( metaIdx ) );
+		const uint64_t    metaLen    = metaString.size();
+		metaStrings.insert( metaStrings.end(), reinterpret_cast<const char*>( &metaLen ), reinterpret_cast<const char*>( &metaLen ) + sizeof( metaLen ) );
+		metaStrings.insert( metaStrings.end(), metaString.begin(), metaString.end() );
+	}
+
+	MeshCache meshCache;
+	meshCache.setCounts( vertexCount, faceCount, featureVecLen );
+	const MeshCache::eSections coordSections[7] { MeshCache::SECTION_VERT_X, MeshCache::SECTION_VERT_Y, MeshCache::SECTION_VERT_Z,
+	                                              MeshCache::SECTION_VERT_NORMAL_X, MeshCache::SECTION_VERT_NORMAL_Y, MeshCache::SECTION_VERT_NORMAL_Z,
+	                                              MeshCache::SECTION_VERT_FUNCVAL };
+	for( int i=0; i<7; i++ ) {
+		meshCache.setSection( coordSections[i], vertCoords[i].data(), vertexCount*sizeof( double ) );
+	}
+	meshCache.setSection( MeshCache::SECTION_VERT_RGBA,  vertRGBA.data(),  vertRGBA.size() );
+	meshCache.setSection( MeshCache::SECTION_VERT_LABEL, vertLabel.data(), vertLabel.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_VERT_FLAGS, vertFlags.data(), vertFlags.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_VERT_FTVEC, vertFtVec.data(), vertFtVec.size()*sizeof( double ) );
+	meshCache.setSection( MeshCache::SECTION_VERT_FACES_OFFSET, vertFacesOffs.data(), vertFacesOffs.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_VERT_FACES, vertFaces.data(), vertFaces.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_FACE_VERTICES, faceVerts.data(), faceVerts.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_FACE_FLAGS, faceFlags.data(), faceFlags.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_FACE_NEIGHBOURS_OFFSET, faceNeighOffs.data(), faceNeighOffs.size()*sizeof( uint64_t ) );
+	meshCache.setSection( MeshCache::SECTION_FACE_NEIGHBOURS, faceNeighs.data(), faceNeighs.size()*sizeof( int64_t ) );
+	meshCache.setSection( MeshCache::SECTION_META_STRINGS, metaStrings.data(), metaStrings.size() );
+	return( meshCache.write( rCacheFile, sourceFile ) );
+}
+
 //! Write connected components into one file per component.
 //!
 //! @returns false in case of an error. True otherwise.
@@ -1399,6 +1806,9 @@ bool Mesh::writeFilesForConnectedComponents() {
 
 //! Import AND assign feature vectors - overloaded from MeshSeedExt.
 //!
+//! The values are stored with the precision of the feature vectors of this mesh,
+//! which is set by setFeatureVecPrecision. They are converted, while the file is parsed.
+//!
 //! @returns false in case of an error or user cancel. True otherwise.
 bool Mesh::importFeatureVectorsFromFile(
     const filesystem::path& rFileName //!< Name of the file for import.
@@ -1411,21 +1821,25 @@ bool Mesh::importFeatureVectorsFromFile(
 		return( false );
 	}
 
-	// Fetch vectors into array.
-	uint64_t maxFeatVecLen;
-	vector<double> featureVecs;
-	if( !MeshSeedExt::importFeatureVectors( rFileName, getVertexNr(), featureVecs,
-	                                        maxFeatVecLen, hasVertexIndex ) ) {
+	// Fetch vectors into a matrix.
+	FeatureVecMatrix featureVecs( getFeatureVecPrecision() );
+	if( !MeshSeedExt::importFeatureVectors( rFileName, getVertexNr(), featureVecs, hasVertexIndex ) ) {
 		std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Import failed!" << std::endl;
 		return( false );
 	}
-	cout << "[Mesh::" << __FUNCTION__ << "] mFeatureVecVerticesLen: " << maxFeatVecLen << endl;
+	cout << "[Mesh::" << __FUNCTION__ << "] mFeatureVecVerticesLen: " << featureVecs.getColCount() << endl;
 
-	if( !assignFeatureVectors( featureVecs, maxFeatVecLen ) ) {
+	if( !assignFeatureVectors( std::move( featureVecs ) ) ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: during assignment of the feature vectors!" << endl;
 		return( false );
 	}
 
+	// Nearest neighbour index stored next to the file e.g. by gigamesh-featurevectors
+	const filesystem::path fileNameIndex = FeatureVecIndex::getFileNameFor( rFileName );
+	if( filesystem::exists( fileNameIndex ) && readFeatureVecIndex( fileNameIndex ) ) {
+		LOG::info() << "[Mesh::" << __FUNCTION__ << "] Feature vector index read from " << fileNameIndex << "\n";
+	}
+
 	return( true );
 }
 
@@ -1452,12 +1866,7 @@ bool Mesh::exportFeatureVectors(const filesystem::path& rFileName)
 	filestr.imbue(std::locale("C"));
 
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	std::string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -1516,23 +1925,79 @@ bool Mesh::assignFeatureVectors(
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No feature vectors found!" << endl;
 		return( false );
 	}
-	const double* featureVecVerticesPtr = rFeatureVecs.data();
-	if( featureVecVerticesPtr == nullptr ) {
+	if( rFeatureVecs.size() < getVertexNr() * rMaxFeatVecLen ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Less feature vectors than vertices!" << endl;
+		return( false );
+	}
+	return( assignFeatureVectors( rFeatureVecs.data(), rMaxFeatVecLen ) );
+}
+
+//! Copies a row-major table holding rMaxFeatVecLen elements for each vertex into
+//! the feature vector matrix of the mesh. The vertices refer to the rows of this matrix.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::assignFeatureVectors(
+        const double*   rFeatureVecs,
+        uint64_t        rMaxFeatVecLen
+) {
+	if( rFeatureVecs == nullptr ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No pointer to feature vectors!" << endl;
 		return( false );
 	}
-	Vertex* curVertex;
-	bool assignOk = true;
+	// Detach the vertices, before the matrix is replaced:
+	for( Vertex* curVertex : mVertices ) {
+		if( curVertex->isFeatureVecView( &mFeatureVecMatrix ) ) {
+			curVertex->setFeatureVecView( nullptr, 0 );
+		}
+	}
+	mFeatureVecIndex.clear();
 	uint64_t vertexCount = getVertexNr();
-	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
-		curVertex = getVertexPos( vertIdx );
-		//cout << featureVecVertices[featureVecVerticesLen*vertIdx] << endl;
-		const double* nextFeatureVecPtr = &(featureVecVerticesPtr[rMaxFeatVecLen*vertIdx]);
-		if( !curVertex->assignFeatureVec( nextFeatureVecPtr, rMaxFeatVecLen ) ) {
+	if( !mFeatureVecMatrix.assign( rFeatureVecs, vertexCount, rMaxFeatVecLen ) ) {
+		return( false );
+	}
+	bool assignOk = true;
+	for( uint64_t vertIdx=0; vertIdx<mFeatureVecMatrix.getRowCount(); vertIdx++ ) {
+		if( !getVertexPos( vertIdx )->setFeatureVecView( &mFeatureVecMatrix, vertIdx ) ) {
+			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Could not assign feature vector!" << endl;
+			assignOk = false;
+		}
+	}
+	changedVertFeatureVectors();
+	return( assignOk );
+}
+
+//! Takes over a matrix having one row per vertex e.g. read by MeshSeedExt::importFeatureVectors.
+//! The precision of the given matrix is kept.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::assignFeatureVectors(
+        FeatureVecMatrix&& rFeatureVecs
+) {
+	if( rFeatureVecs.getColCount() == 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No feature vectors found!" << endl;
+		return( false );
+	}
+	if( rFeatureVecs.getRowCount() != getVertexNr() ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: " << rFeatureVecs.getRowCount() << " feature vectors for "
+		     << getVertexNr() << " vertices!" << endl;
+		return( false );
+	}
+	// Detach the vertices, before the matrix is replaced:
+	for( Vertex* curVertex : mVertices ) {
+		if( curVertex->isFeatureVecView( &mFeatureVecMatrix ) ) {
+			curVertex->setFeatureVecView( nullptr, 0 );
+		}
+	}
+	mFeatureVecIndex.clear();
+	mFeatureVecMatrix = std::move( rFeatureVecs );
+	bool assignOk = true;
+	for( uint64_t vertIdx=0; vertIdx<mFeatureVecMatrix.getRowCount(); vertIdx++ ) {
+		if( !getVertexPos( vertIdx )->setFeatureVecView( &mFeatureVecMatrix, vertIdx ) ) {
 			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Could not assign feature vector!" << endl;
 			assignOk = false;
 		}
 	}
+	changedVertFeatureVectors();
 	return( assignOk );
 }
 
@@ -2764,6 +3229,7 @@ bool Mesh::getSurroundingVerticesInOrder (list<Vertex*> &adjacentVertsInOrder, V
 
 //groups the current helperList and writes the vertices directly into adjacentVertsInOrder
 bool Mesh::groupListMerge(list<pair<Vertex*, int>> &helperList, list<Vertex*> &adjacentVertsInOrder, bool printDebug) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 
 	int count = std::distance( helperList.begin(), helperList.end() );
 
@@ -3336,13 +3802,12 @@ bool Mesh::selectFaceZeroArea() {
 bool Mesh::selectFaceInSphere( Vertex* rSeed, double rRadius ) {
 	//! Select all faces within a sphere using Mesh::fetchSphereBitArray()
 	vector<Face*> facesInSphere;
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	int vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	uint64_t faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
-	if( !fetchSphereBitArray( rSeed, &facesInSphere, rRadius,  vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited ) ) {
+	// Sets of visited vertices and faces:
+	VisitedSet vertsVisited;
+	getVisitedSetVerts( vertsVisited );
+	VisitedSet facesVisited;
+	getVisitedSetFaces( facesVisited );
+	if( !fetchSphereBitArray( rSeed, &facesInSphere, rRadius, vertsVisited, facesVisited ) ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: fetchSphereBitArray failed!" << endl;
 		return false;
 	}
@@ -3352,9 +3817,6 @@ bool Mesh::selectFaceInSphere( Vertex* rSeed, double rRadius ) {
 		mFacesSelected.insert( (*itFace) );
 	}
 	selectedMFacesChanged();
-	// Free bit arrays:
-	delete vertBitArrayVisited;
-	delete faceBitArrayVisited;
 	return true;
 }
 
@@ -4714,6 +5176,47 @@ bool Mesh::calcConeAngle( double* rAngle ) {
 	return true;
 }
 
+//! Unrolls all vertices using the batch engine: the positions are copied into contiguous
+//! arrays, unrolled in parallel and written back.
+//!
+//! @returns the number of vertices not unrolled, which are flagged within rNotUnrolled by their position.
+uint64_t Mesh::unrollVerticesBatch(
+                const UnrollBatch&    rUnrollBatch, //!< Surface and its constants.
+                std::vector<uint8_t>& rNotUnrolled  //!< Byte mask of vertices not unrolled.
+) {
+	PROFILE_SCOPE( "Mesh::unrollVerticesBatch" );
+	const uint64_t     vertexCount = getVertexNr();
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize   = 16384; // Vertices per task.
+	const uint64_t     vertChunks  = ParallelFor::getChunkCount( vertexCount, chunkSize );
+
+	std::vector<double> posX( vertexCount );
+	std::vector<double> posY( vertexCount );
+	std::vector<double> posZ( vertexCount );
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			const Vertex* currVertex = mVertices[vertIdx];
+			posX[vertIdx] = currVertex->getX();
+			posY[vertIdx] = currVertex->getY();
+			posZ[vertIdx] = currVertex->getZ();
+		}
+	} );
+
+	rNotUnrolled.assign( vertexCount, 0 );
+	const uint64_t notUnrolledCount = rUnrollBatch.apply( posX.data(), posY.data(), posZ.data(), rNotUnrolled.data(), vertexCount, threadCount );
+
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			if( rNotUnrolled[vertIdx] == 0 ) {
+				mVertices[vertIdx]->setPosition( posX[vertIdx], posY[vertIdx], posZ[vertIdx] );
+			}
+		}
+	} );
+	return( notUnrolledCount );
+}
+
 //! Unrolls the mesh around the cone. Requires that the mesh is already centered
 //! around the cone. If this is not the case, the mesh is centered.
 //!
@@ -4766,26 +5269,19 @@ bool Mesh::unrollAroundCone( bool* rIsCylinderCase ) {
 	// and return the info about cone or cylinder
 	(*rIsCylinderCase) = ( coneAngle == 0.0 );
 
-	// project all vertices
-	Vertex* currVertex;
-	std::set<Vertex*> notUnrolled;
-	// cout << "[Mesh::" << __FUNCTION__ << "] Cone Angle: " << mConeAngle * 180.0 / M_PI << endl;
-	for( uint64_t vertIdx = 0; vertIdx < getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos(vertIdx);
-		bool res = currVertex->unrollAroundCone( y0, y1, coneAngle, primeMeridian );
-		// stores vertices that could not be unrolled
-		if(!res) {
-			notUnrolled.insert(currVertex);
-		}
-	}
-	cout << "[Mesh::" << __FUNCTION__ << "] Vertices not unrolled: " << notUnrolled.size() << endl;
+	// project all vertices - vertices that could not be unrolled are flagged.
+	std::vector<uint8_t> notUnrolled;
+	const uint64_t notUnrolledCount = unrollVerticesBatch( UnrollBatch::cone( y0, y1, coneAngle, primeMeridian ), notUnrolled );
+	cout << "[Mesh::" << __FUNCTION__ << "] Vertices not unrolled: " << notUnrolledCount << endl;
 
 	// Clean-Up: remove intermediate selection.
 	mFacesSelected.clear();
 	selectedMFacesChanged();
 	deSelMVertsAll();
 
-	Mesh::removeVertices(&notUnrolled);
+	if( notUnrolledCount > 0 ) {
+		removeVerticesMasked( notUnrolled );
+	}
 	setConeStatus(CONE_UNROLLED); // this disables cone selection and stops drawing the cone
 
 	// Determine processing time - STOP
@@ -4847,6 +5343,7 @@ bool Mesh::unrollAroundCone( bool* rIsCylinderCase ) {
 //! Requires that the mesh is already centered around the axis.
 //! If this is not the case, the mesh is centered.
 bool Mesh::unrollAroundCylinderRadius() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool noRedraw          = true;
 	bool duplicateVertices = true;
 	bool resetNormals      = false;
@@ -4888,11 +5385,9 @@ bool Mesh::unrollAroundCylinderRadius() {
 	double cylinderRadius;
 	getParamFloatMesh( CYLINDER_RADIUS, &cylinderRadius );
 
-	// transform all vertices
-	for( uint64_t vertIdx = 0; vertIdx < getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos(vertIdx);
-		currVertex->unrollAroundCylinderRadius( cylinderRadius, primeMeridian ); // bool res = ... | primeMeridian IS 0.0
-	}
+	// transform all vertices - primeMeridian IS 0.0
+	std::vector<uint8_t> notUnrolled;
+	unrollVerticesBatch( UnrollBatch::cylinderRadius( cylinderRadius, primeMeridian ), notUnrolled );
 
 	// Position the mesh plane to compute the distance to the cone:
 	Vector3D newMeshPlane( 0.0, 0.0, 1.0, 0.0 );
@@ -5116,11 +5611,8 @@ bool Mesh::unrollAroundSphere() {
 	this->selectFacesOppositeToPlane( cos(primeMeridian), 0.0, sin(primeMeridian), 0.0 );
 	this->splitByPlane( Vector3D( sin(primeMeridian), 0.0, -cos(primeMeridian), 0.0 ), duplicateVertices, noRedraw );
 
-	Vertex* currVertex;
-	for( uint64_t vertIdx = 0; vertIdx < getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos(vertIdx);
-		currVertex->unrollAroundSphere( primeMeridian, mSphereRadius );
-	}
+	std::vector<uint8_t> notUnrolled;
+	unrollVerticesBatch( UnrollBatch::sphere( primeMeridian, mSphereRadius ), notUnrolled );
 
 	// Re-compute the normal vectors:
 	resetFaceNormals();
@@ -5277,6 +5769,41 @@ bool Mesh::multiplyColorWithFuncVal( const double rMin, const double rMax ) {
 }
 
 
+//! Sets the colour of each vertex to the colour of its function value - see ColorMapLut.
+//! Vertices without a function value get the colour of not-a-number.
+//! @returns false in case of an error. True otherwise.
+bool Mesh::setVertRGBFromFuncVal( const ColorMapLut& rColorMap ) {
+	PROFILE_SCOPE( "Mesh::setVertRGBFromFuncVal" );
+	const uint64_t vertexCount = getVertexNr();
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t chunkSize  = 16384; // Vertices per task.
+	const uint64_t vertChunks = ParallelFor::getChunkCount( vertexCount, chunkSize );
+
+	// Pack the values for the lookup:
+	vector<double> funcValues( vertexCount, _NOT_A_NUMBER_DBL_ );
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			if( !getVertexPos( vertIdx )->getFuncValue( &funcValues[vertIdx] ) ) {
+				funcValues[vertIdx] = _NOT_A_NUMBER_DBL_;
+			}
+		}
+	} );
+
+	vector<uint8_t> vertRGBA( vertexCount * 4 );
+	if( !rColorMap.apply( funcValues.data(), vertexCount, vertRGBA.data(), threadCount ) ) {
+		return( false );
+	}
+
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			getVertexPos( vertIdx )->setRGB( vertRGBA[vertIdx*4], vertRGBA[vertIdx*4+1], vertRGBA[vertIdx*4+2] );
+		}
+	} );
+	return( true );
+}
+
 //! Sets alpha values to selected vertices. If none is selected, set alpha to all vertices
 bool Mesh::assignAlphaToSelectedVertices(unsigned char alpha)
 {
@@ -5317,9 +5844,31 @@ int Mesh::removeFeatureVectors() {
 			vertNotAssigned++;
 		}
 	}
+	mFeatureVecMatrix.clear();
+	mFeatureVecIndex.clear();
 	return vertNotAssigned;
 }
 
+//! Changes the storage type of the feature vectors held by the mesh.
+//! Float32 or float16 reduce the memory for large datasets at the cost of precision.
+//! Feature vectors assigned or imported later use the same storage type.
+//! Feature vectors assigned to single vertices are not converted.
+//! @returns false in case of an error. True otherwise.
+bool Mesh::setFeatureVecPrecision( FeatureVecMatrix::ePrecision rPrecision ) {
+	if( !mFeatureVecMatrix.setPrecision( rPrecision ) ) {
+		return( false );
+	}
+	mFeatureVecIndex.clear();
+	LOG::info() << "[Mesh::" << __FUNCTION__ << "] Feature vectors use " << mFeatureVecMatrix.getMemorySize() << " bytes.\n";
+	changedVertFeatureVectors();
+	return( true );
+}
+
+//! @returns the storage type of the feature vectors held by the mesh.
+FeatureVecMatrix::ePrecision Mesh::getFeatureVecPrecision() const {
+	return( mFeatureVecMatrix.getPrecision() );
+}
+
 // --- Feature vectors -----------------------------------------------------------------------------------------------------------------------------
 
 //! Apply MSII filtering using default parameters.
@@ -5385,14 +5934,10 @@ bool Mesh::computeMSIIQuick(
 	compFeatureVectorsMain( setMeshData, availableConcurrentThreads );
 
 	// Assing computed feature vectors to vertices
-	for( uint64_t i=0; i<this->getVertexNr(); i++ ) {
-		Vertex* currVert = this->getVertexPos( i );
-		if( !currVert->assignFeatureVec( &descriptVolume[i*multiscaleRadiiSize],
-		                                 multiscaleRadiiSize ) ) {
-			std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
-			          << "to vertices failed for Vertex No. " << i << "!" << std::endl;
-			retVal |= false;
-		}
+	if( !assignFeatureVectors( descriptVolume, multiscaleRadiiSize ) ) {
+		std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
+		          << "to vertices failed!" << std::endl;
+		retVal |= false;
 	}
 
 	// Compute a function value per vertex using the feature vectors
@@ -5628,34 +6173,23 @@ bool Mesh::estFeatureDistManToVertex( Primitive* rSomePrim, double** funcValues,
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Reference feature vector: ";
-	double* referenceFeature = new double[featureVecLenRef];
+	// Padded to the length of the vertices' feature vectors:
+	vector<double> referenceFeature( std::max<uint64_t>( featureVecLenRef, getFeatureVecLenMax( Primitive::IS_VERTEX ) ), _NOT_A_NUMBER_DBL_ );
 	for( int i=0; i<featureVecLenRef; i++ ) {
 		rSomePrim->getFeatureElement( i, &referenceFeature[i] );
 		cout << " " << referenceFeature[i];
 	}
 	cout << endl;
-	bool retVal = estFeatureDistManToVertex( referenceFeature, funcValues, vertices, vertCount );
-	delete[] referenceFeature;
-	return retVal;
+	return( estFeatureDistManToVertex( referenceFeature.data(), funcValues, vertices, vertCount ) );
 }
 
 //! Computes the manhattan distances of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistManToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
-	*vertices   = new Vertex*[getVertexNr()];
-	*funcValues = new double[getVertexNr()];
-	*vertCount  = getVertexNr();
-
-	Vertex* currVertex;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		(*vertices)[vertIdx] = currVertex;
-		(*funcValues)[vertIdx] = _NOT_A_NUMBER_DBL_;
-		if( currVertex->getFeatureVectorLen() > 0 ) {
-			(*funcValues)[vertIdx] = currVertex->getFeatureDistManTo( someFeatureVector );
-		}
-	}
-	return true;
+	FeatureVecDistance::sParams params;
+	params.mMetric    = FeatureVecDistance::METRIC_MANHATTAN;
+	params.mReference = someFeatureVector;
+	return( estFeatureVecDistancesToArray( params, funcValues, vertices, vertCount ) );
 }
 
 //! Computes the distances of a the feature vector of a given primitive to the feature vectors of all Vertices.
@@ -5672,34 +6206,23 @@ bool Mesh::estFeatureDistEucToVertex( Primitive* rSomePrim, double** rFuncValues
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Reference feature vector: ";
-	double* referenceFeature = new double[featureVecLenRef];
+	// Padded to the length of the vertices' feature vectors:
+	vector<double> referenceFeature( std::max<uint64_t>( featureVecLenRef, getFeatureVecLenMax( Primitive::IS_VERTEX ) ), _NOT_A_NUMBER_DBL_ );
 	for( int i=0; i<featureVecLenRef; i++ ) {
 		rSomePrim->getFeatureElement( i, &referenceFeature[i] );
 		cout << " " << referenceFeature[i];
 	}
 	cout << endl;
-	bool retVal = estFeatureDistEucToVertex( referenceFeature, rFuncValues, rVertices, rVertCount );
-	delete[] referenceFeature;
-	return retVal;
+	return( estFeatureDistEucToVertex( referenceFeature.data(), rFuncValues, rVertices, rVertCount ) );
 }
 
 //! Computes the distances of a the given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistEucToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
-	*vertices   = new Vertex*[getVertexNr()];
-	*funcValues = new double[getVertexNr()];
-	*vertCount  = getVertexNr();
-
-	Vertex* currVertex;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		(*vertices)[vertIdx] = currVertex;
-		(*funcValues)[vertIdx] = _NOT_A_NUMBER_DBL_;
-		if( currVertex->getFeatureVectorLen() > 0 ) {
-			(*funcValues)[vertIdx] = currVertex->getFeatureDistEucTo( someFeatureVector );
-		}
-	}
-	return true;
+	FeatureVecDistance::sParams params;
+	params.mMetric    = FeatureVecDistance::METRIC_EUCLIDEAN;
+	params.mReference = someFeatureVector;
+	return( estFeatureVecDistancesToArray( params, funcValues, vertices, vertCount ) );
 }
 
 //! Computes the distances of a the feature vector of a given primitive to the feature vectors of all Vertices.
@@ -5716,34 +6239,28 @@ bool Mesh::estFeatureDistEucNormToVertex( Primitive* rSomePrim, double** rFuncVa
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Reference feature vector: ";
-	double* referenceFeature = new double[featureVecLenRef];
+	// Padded to the length of the vertices' feature vectors:
+	vector<double> referenceFeature( std::max<uint64_t>( featureVecLenRef, getFeatureVecLenMax( Primitive::IS_VERTEX ) ), _NOT_A_NUMBER_DBL_ );
 	for( int i=0; i<featureVecLenRef; i++ ) {
 		rSomePrim->getFeatureElement( i, &referenceFeature[i] );
 		cout << " " << referenceFeature[i];
 	}
 	cout << endl;
-	bool retVal = estFeatureDistEucNormToVertex( referenceFeature, rFuncValues, rVertices, rVertCount );
-	delete[] referenceFeature;
-	return retVal;
+	return( estFeatureDistEucNormToVertex( referenceFeature.data(), rFuncValues, rVertices, rVertCount ) );
 }
 
 //! Computes the distances of a the given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistEucNormToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
-	*vertices   = new Vertex*[getVertexNr()];
-	*funcValues = new double[getVertexNr()];
-	*vertCount  = getVertexNr();
-
-	Vertex* currVertex;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		(*vertices)[vertIdx] = currVertex;
-		(*funcValues)[vertIdx] = _NOT_A_NUMBER_DBL_;
-		if( currVertex->getFeatureVectorLen() > 0 ) {
-			(*funcValues)[vertIdx] = currVertex->getFeatureDistEucNormTo( someFeatureVector, &mVerticesFeatVecStd );
-		}
+	if( mVerticesFeatVecStd.size() < getFeatureVecLenMax( Primitive::IS_VERTEX ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No standard deviation of the feature vectors present!" << endl;
+		return false;
 	}
-	return true;
+	FeatureVecDistance::sParams params;
+	params.mMetric    = FeatureVecDistance::METRIC_EUCLIDEAN_NORMALIZED;
+	params.mReference = someFeatureVector;
+	params.mStdDev    = mVerticesFeatVecStd.data();
+	return( estFeatureVecDistancesToArray( params, funcValues, vertices, vertCount ) );
 }
 
 //! Computes the cosine similarity of a given feature vector of a primitive to the feature vectors of all Vertices.
@@ -5760,35 +6277,24 @@ bool Mesh::estFeatureCosineSimToVertex( Primitive* rSomePrim, double** rFuncValu
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Reference feature vector: ";
-	double* referenceFeature = new double[featureVecLenRef];
+	// Padded to the length of the vertices' feature vectors:
+	vector<double> referenceFeature( std::max<uint64_t>( featureVecLenRef, getFeatureVecLenMax( Primitive::IS_VERTEX ) ), _NOT_A_NUMBER_DBL_ );
 	for( int i=0; i<featureVecLenRef; i++ ) {
 		rSomePrim->getFeatureElement( i, &referenceFeature[i] );
 		cout << " " << referenceFeature[i];
 	}
 	cout << endl;
-	bool retVal = estFeatureCosineSimToVertex( referenceFeature, rFuncValues, rVertices, rVertCount );
-	delete[] referenceFeature;
-	return retVal;
+	return( estFeatureCosineSimToVertex( referenceFeature.data(), rFuncValues, rVertices, rVertCount ) );
 }
 
 //! Computes the cosine similarity of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureCosineSimToVertex( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount ) {
-	*rVertices   = new Vertex*[getVertexNr()];
-	*rFuncValues = new double[getVertexNr()];
-	*rVertCount  = getVertexNr();
-
-	int vertIdx=0;
-	vector<Vertex*>::iterator itVertex;
-	for( itVertex = mVertices.begin(); itVertex != mVertices.end(); itVertex++ ) {
-		(*rVertices)[vertIdx] = (*itVertex);
-		(*rFuncValues)[vertIdx] = _NOT_A_NUMBER_DBL_;
-		if( (*itVertex)->getFeatureVectorLen() > 0 ) {
-			(*rFuncValues)[vertIdx] = (*itVertex)->getFeatureVecCosSim( rSomeFeatureVector, true );
-		}
-		vertIdx++;
-	}
-	return true;
+	FeatureVecDistance::sParams params;
+	params.mMetric    = FeatureVecDistance::METRIC_COSINE_SIMILARITY;
+	params.mReference = rSomeFeatureVector;
+	params.mApplyACos = true;
+	return( estFeatureVecDistancesToArray( params, rFuncValues, rVertices, rVertCount ) );
 }
 
 //! Computes the cosine similarity of a given feature vector of a primitive to the feature vectors of all Vertices.
@@ -5805,40 +6311,286 @@ bool Mesh::estFeatureTanimotoDistTo( Primitive* rSomePrim, double** rFuncValues,
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Reference feature vector: ";
-	double* referenceFeature = new double[featureVecLenRef];
+	// Padded to the length of the vertices' feature vectors:
+	vector<double> referenceFeature( std::max<uint64_t>( featureVecLenRef, getFeatureVecLenMax( Primitive::IS_VERTEX ) ), _NOT_A_NUMBER_DBL_ );
 	for( int i=0; i<featureVecLenRef; i++ ) {
 		rSomePrim->getFeatureElement( i, &referenceFeature[i] );
 		cout << " " << referenceFeature[i];
 	}
 	cout << endl;
-	bool retVal = estFeatureTanimotoDistTo( referenceFeature, rFuncValues, rVertices, rVertCount );
-	delete[] referenceFeature;
-	return retVal;
+	return( estFeatureTanimotoDistTo( referenceFeature.data(), rFuncValues, rVertices, rVertCount ) );
 }
 
 //! Computes the cosine similarity of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureTanimotoDistTo( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount ) {
-	*rVertices   = new Vertex*[getVertexNr()];
-	*rFuncValues = new double[getVertexNr()];
-	*rVertCount  = getVertexNr();
-
-	int vertIdx=0;
-	vector<Vertex*>::iterator itVertex;
-	for( itVertex = mVertices.begin(); itVertex != mVertices.end(); itVertex++ ) {
-		(*rVertices)[vertIdx] = (*itVertex);
-		(*rFuncValues)[vertIdx] = _NOT_A_NUMBER_DBL_;
-		if( (*itVertex)->getFeatureVectorLen() > 0 ) {
-			(*rFuncValues)[vertIdx] = (*itVertex)->getFeatureVecTanimotoDist( rSomeFeatureVector );
-		}
-		vertIdx++;
-	}
-	return true;
+	FeatureVecDistance::sParams params;
+	params.mMetric    = FeatureVecDistance::METRIC_TANIMOTO;
+	params.mReference = rSomeFeatureVector;
+	return( estFeatureVecDistancesToArray( params, rFuncValues, rVertices, rVertCount ) );
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------------------------------------
-// --- Other feature vector related functions ------------------------------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+//! Computes the distances of a reference vector to the feature vectors of all vertices
+//! using the batched and multithreaded kernels - see FeatureVecDistance.
+//! Vertices having no feature vector get not-a-number.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::estFeatureVecDistances(
+                const FeatureVecDistance::sParams& rParams,    //!< Metric and reference vector.
+                vector<double>&                    rDistances  //!< Distance per vertex.
+) {
+	vector<double> rowDistances( mFeatureVecMatrix.getRowCount() );
+	if( !FeatureVecDistance::compute( mFeatureVecMatrix, rParams, rowDistances.data() ) ) {
+		return( false );
+	}
+
+	// Feature vectors assigned to single vertices use the Vertex functions with the same arguments.
+	vector<double> referenceVec;
+	vector<double> stdDevVec;
+	vector<double> weightVec;
+	if( rParams.mReference != nullptr ) {
+		referenceVec.assign( rParams.mReference, rParams.mReference + rParams.mReferenceLen );
+	}
+	if( rParams.mStdDev != nullptr ) {
+		stdDevVec.assign( rParams.mStdDev, rParams.mStdDev + rParams.mReferenceLen );
+	}
+	if( rParams.mWeights != nullptr ) {
+		weightVec.assign( rParams.mWeights, rParams.mWeights + rParams.mReferenceLen );
+	}
+
+	const uint64_t vertexCount = getVertexNr();
+	rDistances.resize( vertexCount );
+	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
+		Vertex* currVertex = getVertexPos( vertIdx );
+		uint64_t featureVecRow;
+		if( currVertex->isFeatureVecView( &mFeatureVecMatrix, &featureVecRow ) ) {
+			rDistances[vertIdx] = rowDistances[featureVecRow];
+			continue;
+		}
+		rDistances[vertIdx] = _NOT_A_NUMBER_DBL_;
+		const uint64_t featureVecLen = currVertex->getFeatureVectorLen();
+		if( ( featureVecLen == 0 ) || ( featureVecLen > referenceVec.size() ) ) {
+			continue;
+		}
+		switch( rParams.mMetric ) {
+			case FeatureVecDistance::METRIC_MANHATTAN:
+				rDistances[vertIdx] = currVertex->getFeatureDistManTo( referenceVec.data() );
+				break;
+			case FeatureVecDistance::METRIC_EUCLIDEAN:
+				rDistances[vertIdx] = currVertex->getFeatureDistEucTo( referenceVec.data() );
+				break;
+			case FeatureVecDistance::METRIC_EUCLIDEAN_NORMALIZED:
+				if( stdDevVec.size() >= featureVecLen ) {
+					rDistances[vertIdx] = currVertex->getFeatureDistEucNormTo( referenceVec.data(), &stdDevVec );
+				}
+				break;
+			case FeatureVecDistance::METRIC_COSINE_SIMILARITY:
+				rDistances[vertIdx] = currVertex->getFeatureVecCosSim( referenceVec.data(), rParams.mApplyACos );
+				break;
+			case FeatureVecDistance::METRIC_TANIMOTO:
+				rDistances[vertIdx] = currVertex->getFeatureVecTanimotoDist( referenceVec.data() );
+				break;
+			case FeatureVecDistance::METRIC_PNORM: {
+				double pNormValue;
+				if( currVertex->getFeatureVecPNorm( &pNormValue, rParams.mPNorm, &referenceVec, nullptr, &weightVec ) ) {
+					rDistances[vertIdx] = pNormValue;
+				}
+			} break;
+		}
+	}
+	return( true );
+}
+
+//! Builds the nearest neighbour index for the feature vectors held by the mesh.
+//! Otherwise the index is built with default parameters by the first query.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::buildFeatureVecIndex( const FeatureVecIndex::sParams& rParams ) {
+	return( mFeatureVecIndex.build( mFeatureVecMatrix, rParams ) );
+}
+
+//! Reads the nearest neighbour index written by writeFeatureVecIndex.
+//!
+//! @returns false in case of an error or an index of other feature vectors. True otherwise.
+bool Mesh::readFeatureVecIndex( const filesystem::path& rFileName ) {
+	return( mFeatureVecIndex.readFile( rFileName, mFeatureVecMatrix ) );
+}
+
+//! Writes the nearest neighbour index, so it has not to be built again.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::writeFeatureVecIndex( const filesystem::path& rFileName ) const {
+	return( mFeatureVecIndex.writeFile( rFileName ) );
+}
+
+//! Builds the nearest neighbour index for the feature vectors stored in a text file and writes it
+//! next to this file, where importFeatureVectorsFromFile looks for it.
+//! The index is built from the values as parsed from the file and not from the values in memory,
+//! because the limited precision of the text file would change the checksum of the feature vectors.
+//! The values are stored with the precision of the feature vectors of this mesh, so the index
+//! matches, when the file is imported with the same precision - see setFeatureVecPrecision.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::writeFeatureVecIndexFor(
+                const filesystem::path&         rFileNameFeatureVecs,  //!< File with feature vectors e.g. written by gigamesh-featurevectors.
+                bool                            rVertexIdInFirstCol,   //!< The first column contains the vertex index.
+                const FeatureVecIndex::sParams& rParams                //!< Parameters for building the index.
+) {
+	FeatureVecMatrix featureVecMatrix( getFeatureVecPrecision() );
+	if( !MeshSeedExt::importFeatureVectors( rFileNameFeatureVecs, getVertexNr(), featureVecMatrix, rVertexIdInFirstCol ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Import of " << rFileNameFeatureVecs << " failed!\n";
+		return( false );
+	}
+	if( featureVecMatrix.getRowCount() < getVertexNr() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Less feature vectors than vertices!\n";
+		return( false );
+	}
+	FeatureVecIndex featureVecIndex;
+	if( !featureVecIndex.build( featureVecMatrix, rParams ) ) {
+		return( false );
+	}
+	return( featureVecIndex.writeFile( FeatureVecIndex::getFileNameFor( rFileNameFeatureVecs ) ) );
+}
+
+//! Finds the vertices having feature vectors with the smallest Euclidean distance to the reference
+//! using the approximate nearest neighbour index, which is built when missing.
+//! Vertices having feature vectors not stored within the mesh's matrix are ignored.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::estFeatureVecNeighbours(
+                const vector<double>&           rReference,    //!< Reference vector having the maximum length of the feature vectors.
+                uint64_t                        rMaxCount,     //!< Maximum number of vertices. Zero: no limit i.e. search by distance only.
+                double                          rMaxDistance,  //!< Maximum distance. Infinity: search by count only.
+                uint64_t                        rProbeCount,   //!< Lists of the index to scan. Zero: see FeatureVecIndex::getDefaultProbeCount.
+                vector<pair<Vertex*,double>>&   rNeighbours    //!< Vertices found with their distances sorted by distance.
+) {
+	PROFILE_SCOPE( "Mesh::estFeatureVecNeighbours" );
+	rNeighbours.clear();
+	if( rReference.size() < mFeatureVecMatrix.getColCount() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Reference vector has " << rReference.size() << " instead of "
+		             << mFeatureVecMatrix.getColCount() << " elements!\n";
+		return( false );
+	}
+	if( ( rMaxCount == 0 ) && !isfinite( rMaxDistance ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Neither count nor distance given!\n";
+		return( false );
+	}
+	if( !mFeatureVecIndex.isBuiltFor( mFeatureVecMatrix ) ) {
+		if( !mFeatureVecIndex.build( mFeatureVecMatrix, FeatureVecIndex::sParams() ) ) {
+			return( false );
+		}
+	}
+
+	vector<FeatureVecIndex::sResult> results;
+	bool queryOk;
+	if( rMaxCount > 0 ) {
+		queryOk = mFeatureVecIndex.queryKNN( mFeatureVecMatrix, rReference.data(), rMaxCount, rProbeCount, results );
+		results.erase( find_if( results.begin(), results.end(), [rMaxDistance]( const FeatureVecIndex::sResult& rResult ) {
+			return( rResult.mDistance > rMaxDistance );
+		} ), results.end() );
+	} else {
+		queryOk = mFeatureVecIndex.queryRadius( mFeatureVecMatrix, rReference.data(), rMaxDistance, rProbeCount, results );
+	}
+	if( !queryOk ) {
+		return( false );
+	}
+
+	// Rows correspond to the vertex indices, unless vertices were removed after assigning the feature vectors.
+	vector<Vertex*> rowVertices;
+	for( const FeatureVecIndex::sResult& result : results ) {
+		Vertex*  currVertex = ( result.mRow < getVertexNr() ) ? getVertexPos( result.mRow ) : nullptr;
+		uint64_t featureVecRow;
+		if( ( currVertex == nullptr ) || !currVertex->isFeatureVecView( &mFeatureVecMatrix, &featureVecRow ) ||
+		    ( featureVecRow != result.mRow ) ) {
+			if( rowVertices.empty() ) {
+				rowVertices.resize( mFeatureVecMatrix.getRowCount(), nullptr );
+				for( Vertex* vertex : mVertices ) {
+					if( vertex->isFeatureVecView( &mFeatureVecMatrix, &featureVecRow ) ) {
+						rowVertices[featureVecRow] = vertex;
+					}
+				}
+			}
+			currVertex = rowVertices[result.mRow];
+		}
+		if( currVertex != nullptr ) {
+			rNeighbours.emplace_back( currVertex, result.mDistance );
+		}
+	}
+	return( true );
+}
+
+//! Adds the vertices having feature vectors similar to the reference to the selection - see estFeatureVecNeighbours.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::selectVertsByFeatureVecSimilarity(
+                const vector<double>& rReference,
+                uint64_t              rMaxCount,
+                double                rMaxDistance,
+                uint64_t              rProbeCount
+) {
+	vector<pair<Vertex*,double>> neighbours;
+	if( !estFeatureVecNeighbours( rReference, rMaxCount, rMaxDistance, rProbeCount, neighbours ) ) {
+		return( false );
+	}
+	set<Vertex*> vertsToAdd;
+	for( const auto& neighbour : neighbours ) {
+		vertsToAdd.insert( neighbour.first );
+	}
+	LOG::info() << "[Mesh::" << __FUNCTION__ << "] " << vertsToAdd.size() << " vertices found.\n";
+	return( addToSelection( vertsToAdd ) );
+}
+
+//! Sets the function value to the distance of the feature vectors similar to the reference - see estFeatureVecNeighbours.
+//! All other vertices get not-a-number.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::funcVertFeatureVecSimilarity(
+                const vector<double>& rReference,
+                uint64_t              rMaxCount,
+                double                rMaxDistance,
+                uint64_t              rProbeCount
+) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
+	vector<pair<Vertex*,double>> neighbours;
+	if( !estFeatureVecNeighbours( rReference, rMaxCount, rMaxDistance, rProbeCount, neighbours ) ) {
+		return( false );
+	}
+	for( Vertex* currVertex : mVertices ) {
+		currVertex->setFuncValue( _NOT_A_NUMBER_DBL_ );
+	}
+	for( const auto& neighbour : neighbours ) {
+		neighbour.first->setFuncValue( neighbour.second );
+	}
+	changedVertFuncVal();
+	return( true );
+}
+
+//! Wrapper of estFeatureVecDistances for the arrays used by the GUI, which has to delete[] them.
+//! The reference vector is expected to have the maximum length of the feature vectors.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::estFeatureVecDistancesToArray(
+                FeatureVecDistance::sParams rParams,
+                double**                    rFuncValues,
+                Vertex***                   rVertices,
+                int*                        rVertCount
+) {
+	rParams.mReferenceLen = getFeatureVecLenMax( Primitive::IS_VERTEX );
+	vector<double> distances;
+	if( !estFeatureVecDistances( rParams, distances ) ) {
+		return( false );
+	}
+	*rVertices   = new Vertex*[getVertexNr()];
+	*rFuncValues = new double[getVertexNr()];
+	*rVertCount  = getVertexNr();
+	std::copy( mVertices.begin(), mVertices.end(), *rVertices );
+	std::copy( distances.begin(), distances.end(), *rFuncValues );
+	return( true );
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+// --- Other feature vector related functions ------------------------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 //! Computes the auto correlation of Vertex features.
 //! @returns false in case of an error (e.g. ALGLIB not defined/included).
@@ -6044,6 +6796,7 @@ bool Mesh::estFeatureCorrelationVertex( Primitive* somePrim, double** funcValues
 }
 
 bool Mesh::estFeatureAutoCorrelationVertex( Primitive* somePrim, double** funcValues, Vertex*** vertices, int* vertCount ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Estimates autocorrelation and correlation to selection: log(|Autocrr|*100000) + |FTcorr| + 0.5 cutting of below 0.0 and above 1.0
 	//! Returns false in case of an error (e.g. ALGLIB not defined/included).
 
@@ -6758,6 +7511,8 @@ bool Mesh::labelVertices(
         const set<Vertex*>&   rVerticesToLabel,        //!< Selection of vertices to be labeled.
               set<Vertex*>&   rVerticesSeeds           //!< Seed vertices
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
+	PROFILE_SCOPE( "Mesh::labelVertices" );
 	//cout << "[Mesh::" << __FUNCTION__ << "]"<< endl;
 
 	if( rVerticesSeeds.size() <= 0 ) {
@@ -7255,35 +8010,20 @@ bool Mesh::setPolylinesNormalToVert() {
 
 //! Compute polylines using the mesh plane i.e. profile line.
 //!
-//! Note: Function values are not changed as they are
-//! stashed and restored.
+//! Note: Function values are not changed - see planeIntersectionsToPolylines.
 //!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::planeIntersectionToPolyline() {
-	// Stash function values
-	FUNCTION_VALUES_STASH
-
-	bool absolutDistance   = false; // Parameter for the function value computation.
-	bool silentComputation = true;  // Parameter for the function value computation.
-	// Set function values using distance to plane
-	Vector3D rPlaneHNF;
-	mPlane.getPlaneHNF( &rPlaneHNF );
-	funcVertDistanceToPlane( rPlaneHNF, absolutDistance, silentComputation );
-	// Compute polyline using iso-value of zero.
 	// The plane will be copied/attached to the polylines.
-	isolineToPolyline( 0.0, &mPlane );
-
-	// Retrieve stashed values
-	FUNCTION_VALUES_STASH_RETRIEVE
-
-	return( true );
+	const std::vector<Plane*> planes { &mPlane };
+	return( planeIntersectionsToPolylines( planes ) );
 }
 
 //! Compute polylines using the axis and the selected positons
 //! i.e. multiple profile line.
 //!
 //! Note:
-//! (i) Function values are not changed as they are stashed and restored.
+//! (i) Function values are not changed - see planeIntersectionsToPolylines.
 //! (ii) The mesh plane will not be changed.
 //!
 //! @returns false in case of an error. True otherwise.
@@ -7305,29 +8045,17 @@ bool Mesh::planeIntersectionsAxisAndPositions() {
 		return( false );
 	}
 
-	// Stash function values
-	FUNCTION_VALUES_STASH
-
-	bool absolutDistance   = false; // Parameter for the function value computation.
-	bool silentComputation = true;  // Parameter for the function value computation.
-	for( auto const& currPosTuple: mSelectedPositions ) {
-		Vector3D currPos( std::get<0>( currPosTuple ) );
-		Plane currPlane;
-		currPlane.setPlaneByAxisAndPosition( axisTop, axisBottom, currPos );
-
-		// Set function values using distance to plane
-		Vector3D rPlaneHNF;
-		currPlane.getPlaneHNF( &rPlaneHNF );
-		funcVertDistanceToPlane( rPlaneHNF, absolutDistance, silentComputation );
-		// Compute polyline using iso-value of zero.
-		// The plane will be copied/attached to the polylines.
-		isolineToPolyline( 0.0, &currPlane );
+	// One plane per position - all of them are rotated around the axis.
+	std::vector<Plane>  planesByPosition( mSelectedPositions.size() );
+	std::vector<Plane*> planes;
+	for( size_t posIdx=0; posIdx<mSelectedPositions.size(); posIdx++ ) {
+		Vector3D currPos( std::get<0>( mSelectedPositions[posIdx] ) );
+		planesByPosition[posIdx].setPlaneByAxisAndPosition( axisTop, axisBottom, currPos );
+		planes.push_back( &planesByPosition[posIdx] );
 	}
 
-	// Retrieve stashed values
-	FUNCTION_VALUES_STASH_RETRIEVE
-
-	return( true );
+	// The planes will be copied/attached to the polylines.
+	return( planeIntersectionsToPolylines( planes, &axisTop, &axisBottom ) );
 }
 
 //! Compute isolines using multiple function values entered by user interaction.
@@ -7338,11 +8066,7 @@ bool Mesh::isolineToPolylineMultiple() {
 	if( !showEnterText( multipleIsoValues, "Enter multiple isovalues" ) ) {
 		return( false );
 	}
-	bool retVal = true;
-	for( auto const& isoValue: multipleIsoValues ) {
-		retVal |= isolineToPolyline( isoValue );
-	}
-	return( retVal );
+	return( isolinesToPolylines( multipleIsoValues ) );
 }
 
 //! Compute isolines using the function values using the stored threshold.
@@ -7384,19 +8108,445 @@ bool Mesh::isolineToPolyline() {
 //! Optional: plane, which is typically stored with isolines based on distances to planes
 //!           and used for projection to 2D during SVG export.
 //!
+//! See isolinesToPolylines
+//!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::isolineToPolyline(
     double     rIsoValue,          //!< Isovalue to compute the isolines.
     Plane*     rPlaneIntersect     //!< Optional plane for intersections. Will be stored with the isolines.
 ) {
+	const std::vector<double> isoValues { rIsoValue };
+	return( isolinesToPolylines( isoValues, rPlaneIntersect ) );
+}
+
+namespace {
+	//! Interval of values per face e.g. function values or positions projected onto a plane normal.
+	//! Used to find the faces, which may be intersected by an isoline, without visiting all faces.
+	//! For more than one query the faces are sorted by the lower and by the upper limit.
+	class FaceIntervals {
+		public:
+			std::vector<double> mLow;   //!< Lower limit per face.
+			std::vector<double> mHigh;  //!< Upper limit per face.
+
+			//! Sort the faces by their limits - only worth for multiple queries.
+			void sortLimits() {
+				const uint64_t faceCount = mLow.size();
+				mByLow.resize( faceCount );
+				mByHigh.resize( faceCount );
+				for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+					mByLow[faceIdx]  = std::make_pair( mLow[faceIdx],  faceIdx );
+					mByHigh[faceIdx] = std::make_pair( mHigh[faceIdx], faceIdx );
+				}
+				std::sort( mByLow.begin(), mByLow.end() );
+				std::sort( mByHigh.begin(), mByHigh.end() );
+			}
+
+			//! Indices of the faces having the value within their interval - in ascending order.
+			void getFaces( double rValue, std::vector<uint64_t>& rFaceIndices ) const {
+				rFaceIndices.clear();
+				if( mByLow.empty() ) {
+					for( uint64_t faceIdx=0; faceIdx<mLow.size(); faceIdx++ ) {
+						if( mLow[faceIdx] <= rValue && rValue <= mHigh[faceIdx] ) {
+							rFaceIndices.push_back( faceIdx );
+						}
+					}
+					return;
+				}
+				// Use the smaller of both sets of faces i.e. low <= value or high >= value.
+				const auto lowEnd = std::upper_bound( mByLow.begin(), mByLow.end(), rValue,
+				                                      []( double rVal, const std::pair<double,uint64_t>& rEntry ) { return( rVal < rEntry.first ); } );
+				const auto highBegin = std::lower_bound( mByHigh.begin(), mByHigh.end(), rValue,
+				                                         []( const std::pair<double,uint64_t>& rEntry, double rVal ) { return( rEntry.first < rVal ); } );
+				if( lowEnd - mByLow.begin() <= mByHigh.end() - highBegin ) {
+					for( auto itFace=mByLow.begin(); itFace!=lowEnd; ++itFace ) {
+						if( rValue <= mHigh[itFace->second] ) {
+							rFaceIndices.push_back( itFace->second );
+						}
+					}
+				} else {
+					for( auto itFace=highBegin; itFace!=mByHigh.end(); ++itFace ) {
+						if( mLow[itFace->second] <= rValue ) {
+							rFaceIndices.push_back( itFace->second );
+						}
+					}
+				}
+				std::sort( rFaceIndices.begin(), rFaceIndices.end() );
+			}
+
+		private:
+			std::vector<std::pair<double,uint64_t>> mByLow;   //!< Faces sorted by their lower limit.
+			std::vector<std::pair<double,uint64_t>> mByHigh;  //!< Faces sorted by their upper limit.
+	};
+}
+
+//! Compute isolines for multiple thresholds of the function values within one pass.
+//!
+//! The function value interval of the faces is determined once. For more than
+//! one isovalue the faces are sorted by the lower and the upper limit of their
+//! interval, so that only the faces along an isoline have to be visited per isovalue.
+//! See tracePolylinesOfLevels for tracing.
+//!
+//! Optional: plane, which is typically stored with isolines based on distances to planes
+//!           and used for projection to 2D during SVG export.
+//!
+//! @returns false in case of an error e.g. non-finite isovalues, which are skipped. True otherwise.
+bool Mesh::isolinesToPolylines(
+    const std::vector<double>& rIsoValues,        //!< Isovalues to compute the isolines.
+    Plane*                     rPlaneIntersect    //!< Optional plane for intersections. Will be stored with the isolines.
+) {
+	PROFILE_SCOPE( "Mesh::isolinesToPolylines" );
+
 	// Sanity check
-	if( !isfinite( rIsoValue ) ) {
-		std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Given iso-value is not finite!" << std::endl;
+	bool retVal = true;
+	std::vector<double> isoValues;
+	isoValues.reserve( rIsoValues.size() );
+	for( const double isoValue : rIsoValues ) {
+		if( !isfinite( isoValue ) ) {
+			std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Given iso-value is not finite!" << std::endl;
+			retVal = false;
+			continue;
+		}
+		isoValues.push_back( isoValue );
+	}
+	if( isoValues.empty() ) {
+		return( false );
+	}
+
+	const uint64_t     faceCount      = getFaceNr();
+	const unsigned int threadCount    = ParallelFor::getThreadCount();
+	const uint64_t     faceChunkSize  = 16384; // Faces per task.
+
+	// Function value interval per face.
+	// The limits are widened by a margin, because the products within Face::isOnIsoLine
+	// may underflow to zero for tiny differences to the isovalue. Faces within the
+	// interval are candidates, which are checked using Face::isOnIsoLine.
+	// Faces having a not-a-number function value are always candidates.
+	const double isoMargin = std::sqrt( std::numeric_limits<double>::min() );
+	FaceIntervals faceIntervals;
+	faceIntervals.mLow.resize( faceCount );
+	faceIntervals.mHigh.resize( faceCount );
+	const uint64_t faceChunks = ParallelFor::getChunkCount( faceCount, faceChunkSize );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * faceChunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*faceChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			double funcVals[3] { _NOT_A_NUMBER_DBL_, _NOT_A_NUMBER_DBL_, _NOT_A_NUMBER_DBL_ };
+			currFace->getVertA()->getFuncValue( &funcVals[0] );
+			currFace->getVertB()->getFuncValue( &funcVals[1] );
+			currFace->getVertC()->getFuncValue( &funcVals[2] );
+			if( std::isnan( funcVals[0] ) || std::isnan( funcVals[1] ) || std::isnan( funcVals[2] ) ) {
+				faceIntervals.mLow[faceIdx]  = -std::numeric_limits<double>::infinity();
+				faceIntervals.mHigh[faceIdx] = +std::numeric_limits<double>::infinity();
+				continue;
+			}
+			faceIntervals.mLow[faceIdx]  = std::min( { funcVals[0], funcVals[1], funcVals[2] } ) - isoMargin;
+			faceIntervals.mHigh[faceIdx] = std::max( { funcVals[0], funcVals[1], funcVals[2] } ) + isoMargin;
+		}
+	} );
+	if( isoValues.size() > 1 ) {
+		faceIntervals.sortLimits();
+	}
+
+	auto getCandidateFaces = [&isoValues, &faceIntervals]( uint64_t rLevelIdx, std::vector<uint64_t>& rFaceIndices ) {
+		faceIntervals.getFaces( isoValues[rLevelIdx], rFaceIndices );
+	};
+	auto getFaceValues = [&isoValues]( uint64_t rLevelIdx, Face* rFace, double* rValues ) {
+		double funcValA = _NOT_A_NUMBER_DBL_;
+		double funcValB = _NOT_A_NUMBER_DBL_;
+		double funcValC = _NOT_A_NUMBER_DBL_;
+		rFace->getVertA()->getFuncValue( &funcValA );
+		rFace->getVertB()->getFuncValue( &funcValB );
+		rFace->getVertC()->getFuncValue( &funcValC );
+		rValues[0] = funcValA - isoValues[rLevelIdx];
+		rValues[1] = funcValB - isoValues[rLevelIdx];
+		rValues[2] = funcValC - isoValues[rLevelIdx];
+	};
+	const std::vector<Plane*> planePerLevel( isoValues.size(), rPlaneIntersect );
+	tracePolylinesOfLevels( planePerLevel, getCandidateFaces, getFaceValues );
+	return( retVal );
+}
+
+//! Compute the intersections of multiple planes with the mesh as polylines within one pass
+//! i.e. multiple profile lines. The function values are neither used nor changed.
+//!
+//! The candidate faces per plane are determined by bucketing:
+//! (i) Planes sharing the same normal (i.e. parallel planes) use the interval of the
+//!     faces projected onto this normal, which is computed and sorted once.
+//! (ii) Planes containing the optional axis (i.e. rotated around the axis) use the angular
+//!      interval of the faces around the axis, which is binned once.
+//! (iii) Any other plane has to check all faces.
+//! See tracePolylinesOfLevels for tracing.
+//!
+//! The planes will be copied/attached to the polylines.
+//!
+//! @returns false in case of an error e.g. invalid planes, which are skipped. True otherwise.
+bool Mesh::planeIntersectionsToPolylines(
+    const std::vector<Plane*>& rPlanes,        //!< Planes to intersect with.
+    const Vector3D*            rAxisTop,       //!< Optional: top of the axis of planes rotated around this axis.
+    const Vector3D*            rAxisBottom     //!< Optional: bottom of the axis of planes rotated around this axis.
+) {
+	PROFILE_SCOPE( "Mesh::planeIntersectionsToPolylines" );
+
+	// Sanity check and fetch the Hessian normal forms in the same way as funcVertDistanceToPlane.
+	bool retVal = true;
+	std::vector<Plane*>   planes;
+	std::vector<Vector3D> planeHNFs;
+	for( Plane* currPlane : rPlanes ) {
+		Vector3D planeHNF;
+		if( currPlane == nullptr || !currPlane->getPlaneHNF( &planeHNF ) || !isnormal( planeHNF.getLength3() ) ) {
+			LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Invalid plane given!\n";
+			retVal = false;
+			continue;
+		}
+		planes.push_back( currPlane );
+		planeHNFs.push_back( planeHNF );
+	}
+	if( planes.empty() ) {
 		return( false );
 	}
 
+	const uint64_t     faceCount      = getFaceNr();
+	const uint64_t     vertexCount    = getVertexNr();
+	const unsigned int threadCount    = ParallelFor::getThreadCount();
+	const uint64_t     faceChunkSize  = 16384; // Faces per task.
+	const uint64_t     faceChunks     = ParallelFor::getChunkCount( faceCount, faceChunkSize );
+
+	// Extent of the coordinates used for the tolerances of the bucketing.
+	// Candidates are checked using the exact signed distances and Face::isOnIsoLine.
+	double coordScale = 0.0;
+	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
+		const double vertDist = getVertexPos( vertIdx )->getPositionVector().getLength3();
+		if( isfinite( vertDist ) ) {
+			coordScale = std::max( coordScale, vertDist );
+		}
+	}
+	for( const Vector3D& planeHNF : planeHNFs ) {
+		if( isfinite( planeHNF.getH() ) ) {
+			coordScale = std::max( coordScale, std::abs( planeHNF.getH() ) );
+		}
+	}
+	coordScale = std::max( coordScale, std::numeric_limits<double>::min() );
+
+	enum ePlaneBucketing {
+		BUCKET_NONE,       //!< Check all faces.
+		BUCKET_PARALLEL,   //!< Use the projected interval of the faces.
+		BUCKET_AXIS        //!< Use the angular interval of the faces around the axis.
+	};
+	std::vector<ePlaneBucketing> planeBucketing( planes.size(), BUCKET_NONE );
+	std::vector<uint64_t>        planeGroup( planes.size(), 0 );
+
+	// (i) Group planes having the same normal:
+	std::map<std::tuple<double,double,double>,uint64_t> normalToGroup;
+	std::vector<Vector3D> groupNormals;
+	std::vector<uint64_t> groupSizes;
+	for( uint64_t planeIdx=0; planeIdx<planes.size(); planeIdx++ ) {
+		const Vector3D& planeHNF = planeHNFs[planeIdx];
+		const auto normalKey = std::make_tuple( planeHNF.getX(), planeHNF.getY(), planeHNF.getZ() );
+		auto itGroup = normalToGroup.find( normalKey );
+		if( itGroup == normalToGroup.end() ) {
+			itGroup = normalToGroup.emplace( normalKey, groupNormals.size() ).first;
+			groupNormals.push_back( Vector3D( planeHNF.getX(), planeHNF.getY(), planeHNF.getZ(), 0.0 ) );
+			groupSizes.push_back( 0 );
+		}
+		planeGroup[planeIdx] = itGroup->second;
+		groupSizes[itGroup->second]++;
+	}
+	std::vector<FaceIntervals> groupIntervals( groupNormals.size() );
+	const double projectMargin = 1e-9 * coordScale;
+	for( uint64_t groupIdx=0; groupIdx<groupNormals.size(); groupIdx++ ) {
+		if( groupSizes[groupIdx] < 2 ) {
+			continue;
+		}
+		FaceIntervals& faceIntervals = groupIntervals[groupIdx];
+		faceIntervals.mLow.resize( faceCount );
+		faceIntervals.mHigh.resize( faceCount );
+		const Vector3D& groupNormal = groupNormals[groupIdx];
+		ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * faceChunkSize, faceCount );
+			for( uint64_t faceIdx=rChunkIdx*faceChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+				Face* currFace = getFacePos( faceIdx );
+				const double projA = dot3( groupNormal, currFace->getVertA()->getPositionVector() );
+				const double projB = dot3( groupNormal, currFace->getVertB()->getPositionVector() );
+				const double projC = dot3( groupNormal, currFace->getVertC()->getPositionVector() );
+				if( !isfinite( projA ) || !isfinite( projB ) || !isfinite( projC ) ) {
+					faceIntervals.mLow[faceIdx]  = -std::numeric_limits<double>::infinity();
+					faceIntervals.mHigh[faceIdx] = +std::numeric_limits<double>::infinity();
+					continue;
+				}
+				faceIntervals.mLow[faceIdx]  = std::min( { projA, projB, projC } ) - projectMargin;
+				faceIntervals.mHigh[faceIdx] = std::max( { projA, projB, projC } ) + projectMargin;
+			}
+		} );
+		faceIntervals.sortLimits();
+	}
+	for( uint64_t planeIdx=0; planeIdx<planes.size(); planeIdx++ ) {
+		if( groupSizes[planeGroup[planeIdx]] >= 2 ) {
+			planeBucketing[planeIdx] = BUCKET_PARALLEL;
+		}
+	}
+
+	// (ii) Planes rotated around the axis:
+	// Positions relative to the axis are given in polar coordinates (radius, angle) within
+	// the orthonormal base (axisBase0, axisBase1). A plane containing the axis intersects
+	// a face, when the direction of the plane perpendicular to the axis is within the angular
+	// interval of the face modulo pi. The angular intervals are binned.
+	const uint64_t         angleBinCount    = 1024;
+	const double           angleBinWidth    = M_PI / static_cast<double>( angleBinCount );
+	const double           angleMargin      = 1e-3;               // Radiant - covers the tolerance of planes containing the axis.
+	const double           axisTolerance    = 1e-10 * coordScale; // Maximum distance of the axis to a plane.
+	const double           axisRadiusMin    = 1e-6 * coordScale;  // Faces closer to the axis are always candidates.
+	Vector3D               axisBase0;
+	Vector3D               axisBase1;
+	Vector3D               axisDirection;
+	std::vector<uint64_t>  angleBinOffsets;   // Faces per bin as compressed rows.
+	std::vector<uint64_t>  angleBinFaces;
+	std::vector<uint64_t>  angleAlwaysFaces;  // Faces intersected by (or close to) the axis.
+	bool axisUsed = false;
+	if( rAxisTop != nullptr && rAxisBottom != nullptr ) {
+		axisDirection = (*rAxisTop) - (*rAxisBottom);
+		axisDirection.setH( 0.0 );
+		if( !isnormal( axisDirection.getLength3() ) ) {
+			LOG::warn() << "[Mesh::" << __FUNCTION__ << "] WARNING: Axis of zero length ignored!\n";
+		} else {
+			axisDirection.normalize3();
+			for( uint64_t planeIdx=0; planeIdx<planes.size(); planeIdx++ ) {
+				if( planeBucketing[planeIdx] != BUCKET_NONE ) {
+					continue;
+				}
+				// The plane has to contain the axis within the extent of the mesh.
+				const Vector3D& planeHNF = planeHNFs[planeIdx];
+				const Vector3D  axisFar  = (*rAxisBottom) + axisDirection * coordScale;
+				const Vector3D  axisNear = (*rAxisBottom) - axisDirection * coordScale;
+				if( std::abs( dot3( planeHNF, axisFar ) + planeHNF.getH() ) <= axisTolerance &&
+				    std::abs( dot3( planeHNF, axisNear ) + planeHNF.getH() ) <= axisTolerance ) {
+					planeBucketing[planeIdx] = BUCKET_AXIS;
+					axisUsed = true;
+				}
+			}
+		}
+	}
+	if( axisUsed ) {
+		// Orthonormal base perpendicular to the axis:
+		axisBase0 = std::abs( axisDirection.getX() ) < 0.9 ? Vector3D( 1.0, 0.0, 0.0, 0.0 ) : Vector3D( 0.0, 1.0, 0.0, 0.0 );
+		axisBase0 = axisBase0 - axisDirection * dot3( axisBase0, axisDirection );
+		axisBase0.normalize3();
+		axisBase1 = axisDirection % axisBase0;
+		axisBase1.normalize3();
+		// First and last bin per face or angleBinCount for faces, which are always candidates.
+		std::vector<uint64_t> faceBinFirst( faceCount );
+		std::vector<uint64_t> faceBinCount( faceCount );
+		ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * faceChunkSize, faceCount );
+			for( uint64_t faceIdx=rChunkIdx*faceChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+				Face* currFace = getFacePos( faceIdx );
+				const Vertex* faceVerts[3] { currFace->getVertA(), currFace->getVertB(), currFace->getVertC() };
+				double angles[3];
+				bool   alwaysCandidate = false;
+				for( unsigned int i=0; i<3; i++ ) {
+					const Vector3D relPos = faceVerts[i]->getPositionVector() - (*rAxisBottom);
+					const double   posX   = dot3( relPos, axisBase0 );
+					const double   posY   = dot3( relPos, axisBase1 );
+					if( !( std::hypot( posX, posY ) >= axisRadiusMin ) ) {
+						alwaysCandidate = true; // includes not-a-number
+						break;
+					}
+					angles[i] = std::atan2( posY, posX );
+				}
+				if( !alwaysCandidate ) {
+					// Smallest arc covering all three angles is the complement of the largest gap.
+					std::sort( angles, angles+3 );
+					const double gaps[3] { angles[1] - angles[0], angles[2] - angles[1], angles[0] + 2.0*M_PI - angles[2] };
+					const unsigned int gapLargest = std::max_element( gaps, gaps+3 ) - gaps;
+					const double arcWidth = 2.0*M_PI - gaps[gapLargest] + 2.0*angleMargin;
+					double arcStart = angles[( gapLargest + 1 ) % 3] - angleMargin;
+					arcStart = std::fmod( arcStart + 4.0*M_PI, M_PI );
+					const uint64_t binFirst = std::min( static_cast<uint64_t>( arcStart / angleBinWidth ), angleBinCount-1 );
+					const uint64_t binLast  = static_cast<uint64_t>( ( arcStart + arcWidth ) / angleBinWidth );
+					if( arcWidth < M_PI && binLast - binFirst + 1 <= angleBinCount / 4 ) {
+						faceBinFirst[faceIdx] = binFirst;
+						faceBinCount[faceIdx] = binLast - binFirst + 1;
+						continue;
+					}
+				}
+				faceBinFirst[faceIdx] = angleBinCount;
+				faceBinCount[faceIdx] = 0;
+			}
+		} );
+		// Faces per bin in ascending order of their index:
+		angleBinOffsets.assign( angleBinCount + 1, 0 );
+		for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+			if( faceBinFirst[faceIdx] == angleBinCount ) {
+				angleAlwaysFaces.push_back( faceIdx );
+				continue;
+			}
+			for( uint64_t i=0; i<faceBinCount[faceIdx]; i++ ) {
+				angleBinOffsets[( faceBinFirst[faceIdx] + i ) % angleBinCount + 1]++;
+			}
+		}
+		for( uint64_t binIdx=0; binIdx<angleBinCount; binIdx++ ) {
+			angleBinOffsets[binIdx+1] += angleBinOffsets[binIdx];
+		}
+		angleBinFaces.resize( angleBinOffsets.back() );
+		std::vector<uint64_t> binFill( angleBinOffsets.begin(), angleBinOffsets.end()-1 );
+		for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+			for( uint64_t i=0; i<faceBinCount[faceIdx]; i++ ) {
+				angleBinFaces[binFill[( faceBinFirst[faceIdx] + i ) % angleBinCount]++] = faceIdx;
+			}
+		}
+	}
+
+	// (iii) and the candidates per plane:
+	auto getCandidateFaces = [&]( uint64_t rLevelIdx, std::vector<uint64_t>& rFaceIndices ) {
+		rFaceIndices.clear();
+		const Vector3D& planeHNF = planeHNFs[rLevelIdx];
+		switch( planeBucketing[rLevelIdx] ) {
+			case BUCKET_PARALLEL:
+				groupIntervals[planeGroup[rLevelIdx]].getFaces( -planeHNF.getH(), rFaceIndices );
+				break;
+			case BUCKET_AXIS: {
+				// Direction of the plane perpendicular to the axis:
+				const Vector3D planeDirection = axisDirection % Vector3D( planeHNF.getX(), planeHNF.getY(), planeHNF.getZ(), 0.0 );
+				double planeAngle = std::atan2( dot3( planeDirection, axisBase1 ), dot3( planeDirection, axisBase0 ) );
+				planeAngle = std::fmod( planeAngle + 4.0*M_PI, M_PI );
+				const uint64_t binIdx = std::min( static_cast<uint64_t>( planeAngle / angleBinWidth ), angleBinCount-1 );
+				rFaceIndices.resize( angleBinOffsets[binIdx+1] - angleBinOffsets[binIdx] + angleAlwaysFaces.size() );
+				std::merge( angleBinFaces.begin() + angleBinOffsets[binIdx], angleBinFaces.begin() + angleBinOffsets[binIdx+1],
+				            angleAlwaysFaces.begin(), angleAlwaysFaces.end(), rFaceIndices.begin() );
+				} break;
+			case BUCKET_NONE:
+				rFaceIndices.resize( faceCount );
+				std::iota( rFaceIndices.begin(), rFaceIndices.end(), 0 );
+				break;
+		}
+	};
+	auto getFaceValues = [&planeHNFs]( uint64_t rLevelIdx, Face* rFace, double* rValues ) {
+		const Vector3D& planeHNF = planeHNFs[rLevelIdx];
+		rValues[0] = rFace->getVertA()->estDistanceToPlane( planeHNF, false );
+		rValues[1] = rFace->getVertB()->estDistanceToPlane( planeHNF, false );
+		rValues[2] = rFace->getVertC()->estDistanceToPlane( planeHNF, false );
+	};
+	tracePolylinesOfLevels( planes, getCandidateFaces, getFaceValues );
+	return( retVal );
+}
+
+//! Traces the isolines of zero for multiple levels in parallel and adds them as polylines.
+//!
+//! Each level has its own bit array of visited faces. The candidate faces, which may be
+//! intersected, are given per level in ascending order. Faces not along the isoline are not
+//! marked visited in advance as by a scan of all faces. This does not change the result,
+//! because Face::getIsoPoint fails for these faces, which stops the tracing as well.
+//!
+//! Finally the polylines are added in the order of the levels and within the order of
+//! their first face - i.e. the result does not depend on the number of threads.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::tracePolylinesOfLevels(
+    const std::vector<Plane*>&                                   rPlanePerLevel,      //!< Plane per level stored with the polylines. May contain nullptr. Determines the number of levels.
+    const std::function<void(uint64_t,std::vector<uint64_t>&)>& rGetCandidateFaces,  //!< Indices of faces along the isoline of a level in ascending order.
+    const std::function<void(uint64_t,Face*,double*)>&           rGetFaceValues       //!< Values of the three vertices of a face for a level. Zero is the isovalue.
+) {
 	//! \todo Fetching the label related information, makes only sense for outlines of connected components. Therefore optimizations might be possible at this point.
-	// Fetch label normals first.
+	// Fetch label normals first - once for all levels.
 	vector<Vector3D> labelCenters;
 	vector<Vector3D> labelNormals;
 	estLabelNormalSizeCenterVert( &labelCenters, &labelNormals );
@@ -7405,96 +8555,101 @@ bool Mesh::isolineToPolyline(
 		labelCenter /= labelCenter.getH();
 	}
 
-	// Bit array:
-	      uint64_t* facesVisitedBitArray;
-	const uint64_t  faceBlocksNr = getBitArrayFaces( &facesVisitedBitArray );
-
-	auto setFaceVisited = [&facesVisitedBitArray] (Face* face) {
-		uint64_t  bOffset;
-		uint64_t  bNr;
-		face->getIndexOffsetBit(&bOffset, &bNr);
-		facesVisitedBitArray[bOffset] |= static_cast<uint64_t>(1) << bNr;
-	};
-
-	auto traceIsoLine = [&setFaceVisited, &facesVisitedBitArray] (Face* startFace, bool forward, double rIsoValue, PolyLine* isoLine)
-	{
-		Vector3D  isoPoint;
-		Face*     nextFace = nullptr;
-		Face*     excludeFace = nullptr;
-		uint64_t  bitOffset;
-		uint64_t  bitNr;
+	const uint64_t     faceBlocksNr   = getFaceNr() / ( 8*sizeof( uint64_t ) ) + 1; // see getBitArrayFaces
+	const unsigned int threadCount    = ParallelFor::getThreadCount();
 
-		// Trace in forward direction:
-		//----------------------------
-		if(!startFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
-		{
-			return; //skip face, because it only touches the isoLine on its vertices
-		}
-		if(excludeFace != nullptr)
-		{
-			setFaceVisited(excludeFace);
-		}
-		// ... add to polyline with normal ....
-		Vector3D normalPos = startFace->getNormal( true );
+	// Polylines per level.
+	std::vector<std::vector<PolyLine*>> isoLinesPerLevel( rPlanePerLevel.size() );
 
-		forward ? isoLine->addFront( isoPoint, normalPos, startFace )
-		        : isoLine->addBack ( isoPoint, normalPos, startFace );
+	ParallelFor::forEachChunk( rPlanePerLevel.size(), threadCount, [&]( uint64_t rLevelIdx ) {
+		std::vector<PolyLine*>& isoLines = isoLinesPerLevel[rLevelIdx];
+		const Plane* planeIntersect = rPlanePerLevel[rLevelIdx];
 
-		Face* checkFace = nextFace;
-		while( checkFace != nullptr ) {
-			checkFace->getIndexOffsetBit( &bitOffset, &bitNr );
+		// Bit array:
+		std::vector<uint64_t> facesVisitedBitArray( faceBlocksNr, 0 );
 
-			// check if we have been there to prevent infinite loops:
-			if( facesVisitedBitArray[bitOffset] & static_cast<uint64_t>(1)<<bitNr ) {
-				break;
-			}
-			// set visited
-			facesVisitedBitArray[bitOffset] |= static_cast<uint64_t>(1)<<bitNr;
+		auto setFaceVisited = [&facesVisitedBitArray] (Face* face) {
+			uint64_t  bOffset;
+			uint64_t  bNr;
+			face->getIndexOffsetBit(&bOffset, &bNr);
+			facesVisitedBitArray[bOffset] |= static_cast<uint64_t>(1) << bNr;
+		};
 
-			// get the point ...
-			if(!checkFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
+		auto traceIsoLine = [&setFaceVisited, &facesVisitedBitArray, &rGetFaceValues, rLevelIdx] (Face* startFace, bool forward, PolyLine* isoLine)
+		{
+			Vector3D  isoPoint;
+			Face*     nextFace = nullptr;
+			Face*     excludeFace = nullptr;
+			uint64_t  bitOffset;
+			uint64_t  bitNr;
+			double    faceValues[3];
+
+			// Trace in forward direction:
+			//----------------------------
+			rGetFaceValues( rLevelIdx, startFace, faceValues );
+			if(!startFace->getIsoPoint( faceValues[0], faceValues[1], faceValues[2], &isoPoint, &nextFace, forward, &excludeFace ))
 			{
-				nextFace = nullptr;
-				continue;
+				return; //skip face, because it only touches the isoLine on its vertices
 			}
 			if(excludeFace != nullptr)
 			{
 				setFaceVisited(excludeFace);
 			}
-			// ... add to polyline with normal ...
-			normalPos = checkFace->getNormal( true );
+			// ... add to polyline with normal ....
+			Vector3D normalPos = startFace->getNormal( true );
 
-			forward ? isoLine->addFront( isoPoint, normalPos, checkFace )
-			        : isoLine->addBack ( isoPoint, normalPos, checkFace );
+			forward ? isoLine->addFront( isoPoint, normalPos, startFace )
+			        : isoLine->addBack ( isoPoint, normalPos, startFace );
 
-			// .... move on:
-			checkFace = nextFace;
-		}
-	};
+			Face* checkFace = nextFace;
+			while( checkFace != nullptr ) {
+				checkFace->getIndexOffsetBit( &bitOffset, &bitNr );
 
-	const uint64_t numBits = sizeof(uint64_t) * 8;
+				// check if we have been there to prevent infinite loops:
+				if( facesVisitedBitArray[bitOffset] & static_cast<uint64_t>(1)<<bitNr ) {
+					break;
+				}
+				// set visited
+				facesVisitedBitArray[bitOffset] |= static_cast<uint64_t>(1)<<bitNr;
 
-	for( uint64_t i=0; i<faceBlocksNr; ++i ) {
-		if( facesVisitedBitArray[i] == 0xFFFFFFFFFFFFFFFF ) {
-			// whole block visited.
-			continue;
-		}
-		for( uint64_t j=0; j<numBits; ++j ) {
-			const uint64_t currFaceIndex = i*numBits+j;
+				// get the point ...
+				rGetFaceValues( rLevelIdx, checkFace, faceValues );
+				if(!checkFace->getIsoPoint( faceValues[0], faceValues[1], faceValues[2], &isoPoint, &nextFace, forward, &excludeFace ))
+				{
+					nextFace = nullptr;
+					continue;
+				}
+				if(excludeFace != nullptr)
+				{
+					setFaceVisited(excludeFace);
+				}
+				// ... add to polyline with normal ...
+				normalPos = checkFace->getNormal( true );
 
-			// skip unused bits within the last block:
-			if( ( i==faceBlocksNr-1 ) && ( currFaceIndex >= getFaceNr() ) ) {
-				break;
+				forward ? isoLine->addFront( isoPoint, normalPos, checkFace )
+				        : isoLine->addBack ( isoPoint, normalPos, checkFace );
+
+				// .... move on:
+				checkFace = nextFace;
 			}
+		};
+
+		std::vector<uint64_t> candidateFaces;
+		rGetCandidateFaces( rLevelIdx, candidateFaces );
+
+		const uint64_t numBits = sizeof(uint64_t) * 8;
 
-			uint64_t currentBit = static_cast<uint64_t>(1) << j;
+		for( const uint64_t currFaceIndex : candidateFaces ) {
+			const uint64_t i = currFaceIndex / numBits;
+			const uint64_t currentBit = static_cast<uint64_t>(1) << ( currFaceIndex - i*numBits );
 			if( facesVisitedBitArray[i] & currentBit ) {
 				// face already visited.
 				continue;
 			}
-			//cout << "[Mesh::isolineToPolyline] Check Face in Block No. " << i << " Bit No. " << j << endl;
 			Face* checkFace = getFacePos( currFaceIndex );
-			if( !checkFace->isOnFuncValIsoLine( rIsoValue ) ) {
+			double faceValues[3];
+			rGetFaceValues( rLevelIdx, checkFace, faceValues );
+			if( !checkFace->isOnIsoLine( faceValues[0], faceValues[1], faceValues[2] ) ) {
 				// when the face is not along the isoline, we mark it visited and move on:
 				facesVisitedBitArray[i] |= currentBit;
 				continue;
@@ -7522,8 +8677,8 @@ bool Mesh::isolineToPolyline(
 				                        labelNormals.at( labelFromBorder-1 ),
 				                        labelFromBorder );
 			} else {
-				if( rPlaneIntersect != nullptr ) {
-					isoLine = new PolyLine( *rPlaneIntersect );
+				if( planeIntersect != nullptr ) {
+					isoLine = new PolyLine( *planeIntersect );
 				} else {
 					isoLine = new PolyLine();
 				}
@@ -7533,17 +8688,21 @@ bool Mesh::isolineToPolyline(
 
 			// Trace in forward and backward direction:
 			//----------------------------
-			traceIsoLine(checkFaceFirst, true , rIsoValue, isoLine);
-			traceIsoLine(checkFaceFirst, false, rIsoValue, isoLine);
+			traceIsoLine(checkFaceFirst, true , isoLine);
+			traceIsoLine(checkFaceFirst, false, isoLine);
 
-			// Add vertices of the polyline:
+			isoLines.push_back( isoLine );
+		}
+	} );
+
+	// Add the polylines and their vertices in the order of the levels:
+	for( const std::vector<PolyLine*>& isoLines : isoLinesPerLevel ) {
+		for( PolyLine* isoLine : isoLines ) {
 			isoLine->addVerticesTo( &mVertices );
-			// Add polyline:
 			mPolyLines.push_back( isoLine );
 		}
 	}
-    polyLinesChanged();
-	delete[] facesVisitedBitArray;
+	polyLinesChanged();
 	return( true );
 }
 
@@ -7604,30 +8763,20 @@ bool Mesh::labelVertSurface( uint64_t& rlabelsNr, double** rArea ) {
 		return false;
 	}
 
-	// One set of faces per label:
-	set<Face*>* labelFaces;
-	if( !labelFacesVert( &labelFaces, rlabelsNr ) ) {
+	// Area per label:
+	std::vector<double> labelAreas;
+	if( !labelFacesVertArea( labelAreas ) ) {
 		rlabelsNr = 0;
 		(*rArea)  = nullptr;
 		return false;
 	}
+	rlabelsNr = labelAreas.size();
 	// Allocate memory for area:
 	(*rArea) = new double[rlabelsNr];
-
-	// Estimate area and clear memory.
 	for( uint64_t i=0; i<rlabelsNr; i++ ) {
-		(*rArea)[i] = 0.0;
-		for( Face* face : labelFaces[i] ) {
-			(*rArea)[i] += face->getAreaNormal();
-		}
+		(*rArea)[i] = labelAreas[i];
 		cout << "[Mesh::" << __FUNCTION__ << "] Label " << i << " area: " << (*rArea)[i] << endl;
-		labelFaces[i].clear();
 	}
-	// Clear allocated memory
-	//! \todo check why delete causes a segmentation fault, when used.
-	//delete labelFaces;
-
-	delete[] labelFaces;
 
 	return true;
 }
@@ -7660,6 +8809,47 @@ bool Mesh::labelFacesVert(
 	return true;
 }
 
+//! Sums the area of the faces per vertex based label.
+//! A face is added to each label of its vertices i.e. the same faces as
+//! given by Mesh::labelFacesVert. The areas are summed in parallel by
+//! FaceReduction::reduceBinned independent of the number of threads.
+//!
+//! @returns false, when no labels were found. True otherwise.
+bool Mesh::labelFacesVertArea(
+                std::vector<double>& rLabelAreas  //!< Area per label i.e. index label no. - 1 (return value).
+) {
+	uint64_t labelsNr;
+	if( !labelCount( Primitive::IS_VERTEX, labelsNr ) ) {
+		rLabelAreas.clear();
+		return false;
+	}
+	PROFILE_SCOPE( "Mesh::labelFacesVertArea" );
+	const FaceReduction::sResult labelAreas = FaceReduction::reduceBinned( getFaceNr(), labelsNr,
+	                [this]( uint64_t rFaceIdx, uint64_t* rLabelIdxs, unsigned int& rLabelNr, double& rArea ) {
+		Face* currFace = mFaces[rFaceIdx];
+		for( const Vertex* currVertex : { currFace->getVertA(), currFace->getVertB(), currFace->getVertC() } ) {
+			uint64_t currLabel;
+			if( !currVertex->getLabel( currLabel ) ) {
+				// Not labeled - or background =>
+				continue;
+			}
+			if( std::find( rLabelIdxs, rLabelIdxs+rLabelNr, currLabel-1 ) == rLabelIdxs+rLabelNr ) {
+				rLabelIdxs[rLabelNr++] = currLabel-1;
+			}
+		}
+		if( rLabelNr == 0 ) {
+			return( FaceReduction::FACE_SKIPPED );
+		}
+		rArea = currFace->getAreaNormal();
+		if( !isfinite( rArea ) || ( rArea == 0.0 ) ) {
+			return( FaceReduction::FACE_DEGENERATE );
+		}
+		return( FaceReduction::FACE_VALID );
+	} );
+	rLabelAreas = labelAreas.mSums;
+	return true;
+}
+
 // Polylines ---------------------------------------------------------------------------------------------------------------------------------------------------
 
 //! Stub for higher levels.
@@ -7797,6 +8987,7 @@ void Mesh::convertLabelBordersToPolylines() {
 
 //! Convertes triangle edges along mesh border to a polyline, e.g. for hole filling.
 bool Mesh::convertBordersToPolylines() {
+	PROFILE_SCOPE( "Mesh::convertBordersToPolylines" );
 	// Progress bar
 	showProgressStart( "Convert Mesh Borders to Polylines" );
 	// Bit array:
@@ -7875,6 +9066,206 @@ bool Mesh::convertBordersToPolylines() {
 	return true;
 }
 
+//! Parallel variant of Mesh::convertBordersToPolylines producing the same polylines in the same order.
+//!
+//! The successor of each border vertex is determined in parallel. Then each chunk of vertices
+//! walks the parts of the border loops within its own range of indices: a chain starts at a
+//! vertex entering the chunk and ends, when the border leaves the chunk. Loops within a single
+//! chunk form one chain. The chains are independent of the number of threads and are stitched
+//! together afterwards and rotated to start at their smallest vertex index, which is the vertex
+//! the sequential conversion starts with.
+//!
+//! Borders with singular vertices i.e. more than one border edge leaving or entering a vertex
+//! depend on the order of traversal and are therefore passed to Mesh::convertBordersToPolylines.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::convertBordersToPolylinesParallel(
+                uint64_t rChunkSize   //!< Vertices per task.
+) {
+	PROFILE_SCOPE( "Mesh::convertBordersToPolylinesParallel" );
+	showProgressStart( "Convert Mesh Borders to Polylines" );
+	// Bit array - read only from here on:
+	uint64_t* vertBitArrayBorder;
+	getBitArrayVerts( &vertBitArrayBorder, BIT_ARRAY_MARK_BORDER );
+
+	const uint64_t     vertexCount = getVertexNr();
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize   = std::max<uint64_t>( rChunkSize, 1 );
+	const uint64_t     vertChunks  = ParallelFor::getChunkCount( vertexCount, chunkSize );
+
+	// (1) Next vertex along the border, number of predecessors and singularities:
+	std::vector<Vertex*>               borderNext( vertexCount, nullptr );
+	std::vector<std::atomic<uint32_t>> borderPrevCount( vertexCount );
+	std::vector<std::atomic<uint8_t>>  borderEntersChunk( vertexCount ); // Predecessor within another chunk.
+	std::vector<uint8_t>               borderSingular( vertexCount, 0 );
+	std::atomic<bool>                  borderIrregular( false );
+	ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::vector<Face*> adjacentFaces;
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			Vertex* currVert = getVertexPos( vertIdx );
+			if( !currVert->isMarked( vertBitArrayBorder ) ) {
+				continue;
+			}
+			adjacentFaces.clear();
+			currVert->getFaces( &adjacentFaces );
+			unsigned int borderEdgesLeaving = 0;
+			for( Face* adjacentFace : adjacentFaces ) {
+				Vertex* nextVert = adjacentFace->getNextBorderVertex( currVert, vertBitArrayBorder );
+				if( nextVert == nullptr ) {
+					continue;
+				}
+				if( borderEdgesLeaving == 0 ) {
+					borderNext[vertIdx] = nextVert;
+				}
+				borderEdgesLeaving++;
+			}
+			if( borderEdgesLeaving != 1 ) {
+				borderIrregular = true;
+				continue;
+			}
+			const uint64_t nextIdx = borderNext[vertIdx]->getIndex();
+			borderPrevCount[nextIdx]++;
+			if( nextIdx / chunkSize != rChunkIdx ) {
+				borderEntersChunk[nextIdx] = 1;
+			}
+			borderSingular[vertIdx] = currVert->isDoubleCone();
+		}
+	} );
+
+	// (2) Walk the border within each chunk:
+	struct sBorderChain {
+		std::vector<Vertex*> mVertices; //!< Vertices walked from the head of the chain.
+		uint64_t             mNextHead; //!< Index of the vertex the walk stopped at, which is the head of a chain.
+	};
+	std::vector<uint8_t>                   vertClaimed( vertexCount, false ); // Written only by the chunk of the vertex.
+	std::vector<std::vector<sBorderChain>> chunkChains( vertChunks );
+	if( !borderIrregular ) {
+		ParallelFor::forEachChunk( vertChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			const uint64_t vertIdxStart = rChunkIdx * chunkSize;
+			const uint64_t vertIdxEnd   = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+			// Walks from a head, until the border leaves the chunk or returns to the head:
+			auto walkChain = [&]( uint64_t rHeadIdx ) {
+				sBorderChain borderChain;
+				uint64_t currIdx = rHeadIdx;
+				do {
+					vertClaimed[currIdx] = true;
+					borderChain.mVertices.push_back( getVertexPos( currIdx ) );
+					currIdx = borderNext[currIdx]->getIndex();
+				} while( ( currIdx >= vertIdxStart ) && ( currIdx < vertIdxEnd ) && !vertClaimed[currIdx] );
+				borderChain.mNextHead = currIdx;
+				chunkChains[rChunkIdx].push_back( std::move( borderChain ) );
+			};
+			// Chains entering the chunk:
+			for( uint64_t vertIdx=vertIdxStart; vertIdx<vertIdxEnd; vertIdx++ ) {
+				if( borderNext[vertIdx] == nullptr ) {
+					continue;
+				}
+				if( borderPrevCount[vertIdx] != 1 ) {
+					borderIrregular = true;
+					return;
+				}
+				if( borderEntersChunk[vertIdx] ) {
+					walkChain( vertIdx );
+				}
+			}
+			// Remaining loops are entirely within the chunk:
+			for( uint64_t vertIdx=vertIdxStart; vertIdx<vertIdxEnd; vertIdx++ ) {
+				if( ( borderNext[vertIdx] != nullptr ) && !vertClaimed[vertIdx] ) {
+					walkChain( vertIdx );
+				}
+			}
+		} );
+	}
+	delete[] vertBitArrayBorder;
+	if( borderIrregular ) {
+		showProgressStop( "Convert Mesh Borders to Polylines" );
+		LOG::info() << "[Mesh::" << __FUNCTION__ << "] Borders are not simple loops - using sequential conversion.\n";
+		return( Mesh::convertBordersToPolylines() );
+	}
+	showProgress( 0.5, "Convert Mesh Borders to Polylines" );
+
+	// (3) Stitch the chains to loops starting at their smallest vertex index:
+	std::vector<sBorderChain*> borderChains;
+	std::unordered_map<uint64_t,uint64_t> chainOfHead;
+	for( std::vector<sBorderChain>& chains : chunkChains ) {
+		for( sBorderChain& borderChain : chains ) {
+			chainOfHead[borderChain.mVertices.front()->getIndex()] = borderChains.size();
+			borderChains.push_back( &borderChain );
+		}
+	}
+	std::vector<std::vector<Vertex*>> borderLoops;
+	std::vector<bool> chainUsed( borderChains.size(), false );
+	for( uint64_t chainIdx=0; chainIdx<borderChains.size(); chainIdx++ ) {
+		if( chainUsed[chainIdx] ) {
+			continue;
+		}
+		std::vector<Vertex*> borderLoop;
+		uint64_t currChain = chainIdx;
+		while( !chainUsed[currChain] ) {
+			chainUsed[currChain] = true;
+			borderLoop.insert( borderLoop.end(), borderChains[currChain]->mVertices.begin(), borderChains[currChain]->mVertices.end() );
+			currChain = chainOfHead[borderChains[currChain]->mNextHead];
+		}
+		const auto vertFirst = std::min_element( borderLoop.begin(), borderLoop.end(), []( Vertex* rVertA, Vertex* rVertB ) {
+			return( rVertA->getIndex() < rVertB->getIndex() );
+		} );
+		std::rotate( borderLoop.begin(), vertFirst, borderLoop.end() );
+		borderLoops.push_back( std::move( borderLoop ) );
+	}
+	std::sort( borderLoops.begin(), borderLoops.end(), []( const std::vector<Vertex*>& rLoopA, const std::vector<Vertex*>& rLoopB ) {
+		return( rLoopA.front()->getIndex() < rLoopB.front()->getIndex() );
+	} );
+
+	// (4) Polylines in the vertex order of Mesh::convertBordersToPolylines, which prepends each vertex:
+	std::vector<PolyLine*> borderLines( borderLoops.size(), nullptr );
+	ParallelFor::forEachChunk( borderLoops.size(), threadCount, [&]( uint64_t rLoopIdx ) {
+		const std::vector<Vertex*>& borderLoop = borderLoops[rLoopIdx];
+		PolyLine* borderLine = new PolyLine();
+		borderLine->addBack( borderLoop.front() );
+		for( auto itVert = borderLoop.rbegin(); itVert != borderLoop.rend(); itVert++ ) {
+			borderLine->addBack( *itVert );
+		}
+		borderLines[rLoopIdx] = borderLine;
+	} );
+
+	// Add polylines and debug info:
+	unsigned int ctrContainsSingular = 0;
+	unsigned int ctrBordersOne  = 0;
+	unsigned int ctrBordersTwo  = 0;
+	unsigned int ctrBordersTri  = 0;
+	unsigned int ctrBordersQuad = 0;
+	for( uint64_t loopIdx=0; loopIdx<borderLoops.size(); loopIdx++ ) {
+		const std::vector<Vertex*>& borderLoop = borderLoops[loopIdx];
+		const bool containsSingular = std::any_of( borderLoop.begin(), borderLoop.end(), [&borderSingular]( Vertex* rVert ) {
+			return( borderSingular[rVert->getIndex()] != 0 );
+		} );
+		if( containsSingular ) {
+			ctrContainsSingular++;
+		}
+		switch( borderLoop.size() ) { // +1 because the start/end vertex is added twice for closed lines.
+			case 1: ctrBordersOne++;  break;
+			case 2: ctrBordersTwo++;  break;
+			case 3: ctrBordersTri++;  break;
+			case 4: ctrBordersQuad++; break;
+			default: break;
+		}
+		mPolyLines.push_back( borderLines[loopIdx] );
+	}
+	polyLinesChanged();
+	showProgressStop( "Convert Mesh Borders to Polylines" );
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders added: " << borderLoops.size() << endl;
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders length 1: " << ctrBordersOne << " (>0 indicates an error)" << endl;
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders length 2: " << ctrBordersTwo << " (>0 indicates an error)" << endl;
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders triangle: " << ctrBordersTri << endl;
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders quadtriangle: " << ctrBordersQuad << endl;
+	cout << "[Mesh::" << __FUNCTION__  << "] Borders may be wrong due to singularities: " << ctrContainsSingular << endl;
+	if( ctrContainsSingular > 0 ) {
+		showWarning( "[Mesh::" + string( __FUNCTION__ ) + "]", "Borders may be wrong due to singularities: " + to_string( ctrContainsSingular ) );
+	}
+	return true;
+}
+
 void Mesh::convertSelectedVerticesToPolyline() {
 	//! Converts selected vertices to polylines.
 
@@ -8009,6 +9400,7 @@ bool Mesh::setFaceFuncValMarchRadiusIdx(
                 Primitive* rSeed,  //!< Seed primitive, which can only be a vertex in the current implementation.
                 double rRadius     //!< Radius i.e. maximum distance to the seed as stop criteria for the marching front.
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Sanity
 	if( rSeed == nullptr ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No primitve given!" << endl;
@@ -8032,16 +9424,14 @@ bool Mesh::setFaceFuncValMarchRadiusIdx(
 		return( false );
 	}
 
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	uint64_t vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	uint64_t faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
+	// Sets of visited vertices and faces:
+	VisitedSet vertsVisited;
+	getVisitedSetVerts( vertsVisited );
+	VisitedSet facesVisited;
+	getVisitedSetFaces( facesVisited );
 	vector<Face*> facesInSphere;
 	fetchSphereBitArray1R( seedVert, facesInSphere, rRadius,
-	                       vertNrLongs, vertBitArrayVisited,
-	                       faceNrLongs, faceBitArrayVisited, true );
+	                       vertsVisited, facesVisited, true );
 
 // Can not be visualized
 //	changedFaceFuncVal();
@@ -8066,6 +9456,7 @@ bool Mesh::setFaceFuncValMarchRadiusIdx(
 //! Angle is set in radiant.
 //! @returns true, when a new function value was set for all vertices. False otherwise or in case of an error.
 bool Mesh::setVertFuncValSlope() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	Vector3D planeHNF;
 	if( !mPlane.getPlaneHNF( &planeHNF ) ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] Fetching mesh plane failed!" << endl;
@@ -8099,6 +9490,7 @@ bool Mesh::setVertFuncValSlope() {
 //! Unsigned angle is set in radian.
 //! @returns true, when a new function value was set for all vertices. False otherwise or in case of an error.
 bool Mesh::setVertFuncValAngleToRadial() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	Vector3D axisTop;
 	Vector3D axisBottom;
 	if( !getConeAxis(&axisTop, &axisBottom ) ) {
@@ -8124,6 +9516,7 @@ bool Mesh::setVertFuncValAngleToRadial() {
 //! Unsigned angle is set in radian.
 //! @returns true, when a new function value was set for all vertices. False otherwise or in case of an error.
 bool Mesh::setVertFuncValAxisAngleToRadial() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	Vector3D axisTop;
 	Vector3D axisBottom;
 	if( !getConeAxis( &axisTop, &axisBottom ) ) {
@@ -8149,6 +9542,7 @@ bool Mesh::setVertFuncValAxisAngleToRadial() {
 //! Unsigned angle is set in radian.
 //! @returns true, when a new function value was set for all vertices. False otherwise or in case of an error.
 bool Mesh::setVertFuncValOrthogonalAxisAngleToRadial() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	Vector3D axisTop;
 	Vector3D axisBottom;
 	if( !getConeAxis( &axisTop, &axisBottom ) ) {
@@ -8174,6 +9568,7 @@ bool Mesh::setVertFuncValOrthogonalAxisAngleToRadial() {
 //! See Vertex::getGraylevel and Vertex::eGrayLevelConversion
 //! @returns true, when a new function value was set for all vertices. False otherwise.
 bool Mesh::setVertFuncValGraylevel( Vertex::eGrayLevelConversion rGrayLevelConvMethod ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 	Vertex* currVertex;
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
@@ -8218,6 +9613,7 @@ bool Mesh::setVertFuncValDistanceToLinePosDir(
     const Vector3D* rPos,  //!< Position vector
     const Vector3D* rDir   //!< Direction vector
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool retVal = true;
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
 		Vertex* currVertex = getVertexPos( vertIdx );
@@ -8268,6 +9664,7 @@ bool Mesh::setVertFuncValDistanceToAxis() {
 //! See Vertex::angleInLineCoord which is a(n inefficent) variant in this case.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::setVertFuncValAngleBasedOnAxis( Vector3D* rPosBottom, Vector3D* rPosTop ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
 	// Sanity checks
 	if( ( rPosBottom == nullptr ) || ( rPosTop == nullptr ) ) {
@@ -8302,6 +9699,7 @@ bool Mesh::setVertFuncValAngleBasedOnAxis( Vector3D* rPosBottom, Vector3D* rPosT
 }
 
 bool Mesh::setVertFuncVal( double rVal ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Sets all vertex function values to a given value.
 	//! Returns true, when all vertices function value could be set.
 	bool allSet = true;
@@ -8317,6 +9715,7 @@ bool Mesh::setVertFuncVal( double rVal ) {
 }
 
 bool Mesh::setVertFuncValCutOff( double minVal, double maxVal, bool setToNotANumber ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Cuts of function values (of vertices).
 	//! When setToNotANumber is false, the values lower than minVal will be set to minVal.
 	//! When setToNotANumber is true, the values lower minVal will be set to not-a-number.
@@ -8363,6 +9762,7 @@ bool Mesh::setVertFuncValCutOff( double minVal, double maxVal, bool setToNotANum
 }
 
 bool Mesh::setVertFuncValNormalize() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Normalization of the function values to [0.0 ... 1.0].
 	//! Typically used for weighting other functions like the geodesic distance.
 
@@ -8405,6 +9805,7 @@ bool Mesh::setVertFuncValNormalize() {
 }
 
 bool Mesh::setVertFuncValAbs() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Compute and set the absolute function value.
 	//! Returns true, when all vertices function value could be set.
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
@@ -8425,6 +9826,7 @@ bool Mesh::setVertFuncValAbs() {
 }
 
 bool Mesh::setVertFuncValAdd( double rVal ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Add a given constant to the vertices function values.
 	//! Returns true, when all vertices function value could be set.
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
@@ -8455,6 +9857,7 @@ bool Mesh::setVertFuncValMult() {
 //! Multiple a given scalar value to the vertices function values.
 //! @returns true, when all vertices function value were set.
 bool Mesh::setVertFuncValMult( double rVal ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
 	bool allSet = true;
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
@@ -8477,6 +9880,7 @@ bool Mesh::setVertFuncValMult( double rVal ) {
 //!
 //! @returns true, when all vertices function value were set.
 bool Mesh::setVertFuncValToOrder() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
 
 	vector<Vertex*> verticesSorted;
@@ -8503,6 +9907,7 @@ bool Mesh::setVertFuncValToOrder() {
 //! Calculates distance from each vertex to the cone given by an axis and two radii -- an upper radius
 //! and a lower radius
 bool Mesh::setVertFuncValDistanceToCone( bool rAbsDist ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 
 	Vector3D axisTop;
 	Vector3D axisBot;
@@ -8538,6 +9943,7 @@ bool Mesh::setVertFuncValDistanceToCone( bool rAbsDist ) {
 
 //! Calculates distance from each vertex to the sphere given by a center and a radius
 bool Mesh::setVertFuncValDistanceToSphere() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 
 	Vector3D center;
 	double radius;
@@ -8560,6 +9966,7 @@ bool Mesh::setVertFuncValDistanceToSphere() {
 //! Only the angle at the vertex is added!
 //! See Vertex::get1RingSumAngles
 bool Mesh::setVertFuncVal1RSumAngles() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	showProgressStart( "1-ring angle sum" );
 	uint64_t vertexCount = getVertexNr();
 	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
@@ -8578,6 +9985,7 @@ bool Mesh::setVertFuncVal1RSumAngles() {
 //!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::setVertFuncValOctreeIdx( double rEdgeLen ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	if( rEdgeLen <= 0.0 ) {
 		std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: zero and negative value not allowed!" << std::endl;
 		return( false );
@@ -8605,14 +10013,14 @@ bool Mesh::setVertFuncValOctreeIdx( double rEdgeLen ) {
 }
 
 bool Mesh::setVertFuncValFaceSphereAngleMax( double rRadius ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Compute the maximum face angle to the vertex normal within a spherical neighbourhood and store it as function value
 
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	int vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	int faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
+	// Sets of visited vertices and faces - reset in O(1) per vertex:
+	VisitedSet vertsVisited;
+	getVisitedSetVerts( vertsVisited );
+	VisitedSet facesVisited;
+	getVisitedSetFaces( facesVisited );
 
 	vector<Face*> facesInSphere;
 	vector<Face*>::iterator itFace;
@@ -8620,7 +10028,7 @@ bool Mesh::setVertFuncValFaceSphereAngleMax( double rRadius ) {
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
 		currVertex = getVertexPos( vertIdx );
 		Vector3D vertNorm = currVertex->getNormal();
-		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited, false );
+		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertsVisited, facesVisited, false );
 		double maxAngle = -DBL_MAX;
 		for( itFace=facesInSphere.begin(); itFace!=facesInSphere.end(); itFace++ ) {
 			Vector3D faceNorm = (*itFace)->getNormal();
@@ -8633,29 +10041,26 @@ bool Mesh::setVertFuncValFaceSphereAngleMax( double rRadius ) {
 		facesInSphere.clear();
 	}
 
-	delete[] vertBitArrayVisited;
-	delete[] faceBitArrayVisited;
-
 	changedVertFuncVal();
 	return true;
 }
 
 bool Mesh::setVertFuncValFaceSphereMeanAngleMax( double rRadius ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	//! Compute the maximum face angle to the faces mean normal normal within a spherical neighbourhood and store it as function value per vertex.
 
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	int vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	int faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
+	// Sets of visited vertices and faces - reset in O(1) per vertex:
+	VisitedSet vertsVisited;
+	getVisitedSetVerts( vertsVisited );
+	VisitedSet facesVisited;
+	getVisitedSetFaces( facesVisited );
 
 	vector<Face*> facesInSphere;
 	vector<Face*>::iterator itFace;
 	Vertex* currVertex;
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
 		currVertex = getVertexPos( vertIdx );
-		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited, false );
+		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertsVisited, facesVisited, false );
 		//! .) Compute weighted mean normal of the faces.
 		Vector3D vertFaceMean( 0.0, 0.0, 0.0, 0.0 );
 		for( itFace=facesInSphere.begin(); itFace!=facesInSphere.end(); itFace++ ) {
@@ -8674,9 +10079,6 @@ bool Mesh::setVertFuncValFaceSphereMeanAngleMax( double rRadius ) {
 		facesInSphere.clear();
 	}
 
-	delete[] vertBitArrayVisited;
-	delete[] faceBitArrayVisited;
-
 	changedVertFuncVal();
 	return true;
 }
@@ -8684,6 +10086,7 @@ bool Mesh::setVertFuncValFaceSphereMeanAngleMax( double rRadius ) {
 //! Compute 1-ring area for all vertices.
 //! @returns false in case of an error. True otherwise
 bool Mesh::setVertFuncVal1RingArea() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	showProgressStart( "1-ring area" );
 	uint64_t vertexCount = getVertexNr();
 	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
@@ -8745,6 +10148,7 @@ bool Mesh::funcVertMedianOneRing(
     bool         rPreferMeanOverMedian,    //!< Compute mean value instead of the median.
     bool         rStoreDiffAsFeatureVec    //!< Option to store the changes as feature vectors.
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// 0a. Pre-Compute the minimum face altitude length
 	// double minDist = getAltitudeMin();
 	// cout << "[Mesh::" << __FUNCTION__ << "] Minimal altitude: " << minDist << " mm (unit assumed)." << endl;
@@ -8846,8 +10250,7 @@ bool Mesh::funcVertMedianOneRing(
 	if( rStoreDiffAsFeatureVec ) {
 		removeFeatureVectors();
 		mFeatureVecVerticesLen = rIterations;
-		mFeatureVecVertices.swap( diffFlowFTVec );
-		if( !assignFeatureVectors( mFeatureVecVertices, mFeatureVecVerticesLen ) ) {
+		if( !assignFeatureVectors( diffFlowFTVec, mFeatureVecVerticesLen ) ) {
 			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: during assignment of the feature vectors!" << endl;
 			retVal = false;
 		}
@@ -8862,6 +10265,7 @@ bool Mesh::funcVertMedianOneRing(
 //! Compute the number of adjacent faces and store it as function value.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::funcVertAdjacentFaces() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool retVal = true;
 	string funcName = "Number of adjacent faces.";
 
@@ -8885,6 +10289,7 @@ bool Mesh::funcVertAdjacentFaces() {
 //! Compute r_min_i for 1-ring neighborhoods.
 //! See Vertex::get1RingEdgeLenMin.
 bool Mesh::funcVert1RingRMin() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	string funcName = "r_min for 1-ring";
 	time_t timeStart = clock();
 	Vertex* currVertex;
@@ -8904,6 +10309,7 @@ bool Mesh::funcVert1RingRMin() {
 
 //! Compute volume integral for a 1-ring, which is equivalent to V(r->0)
 bool Mesh::funcVert1RingVolInt() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Find smallest radius within the mesh:
 	double rMin = getAltitudeMin();
 	cout << "[Mesh::" << __FUNCTION__ << "] Rmin: " << rMin << endl;
@@ -8946,6 +10352,7 @@ bool Mesh::funcVert1RingVolInt() {
 //! This implementation has a O(n^2), which is very bad!
 //! \todo Faster implementation, e.g, using BSP (Binary Space Partitioning).
 bool Mesh::funcVertDistancesMax() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	std::string funcName = "Max. distances";
 	time_t timeStart = clock();
 	Vertex* currVertex;
@@ -8978,6 +10385,7 @@ bool Mesh::funcVertDistancesMax() {
 //!
 //! @returns true, when all vertices got a new function value. False otherwise i.e. in case of an error.
 bool Mesh::funcVertFeatureElementsStdDev() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 
 	string funcName = "Compute standard deviation of the feature vectors' elements.";
@@ -9006,6 +10414,7 @@ bool Mesh::funcVertFeatureElementsStdDev() {
 //!
 //! @returns true, when all vertices got a new function value. False otherwise i.e. in case of an error.
 bool Mesh::funcVertFeatureVecMin() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 
 	string funcName = "Determine minimal value of the feature vectors' elements.";
@@ -9034,6 +10443,7 @@ bool Mesh::funcVertFeatureVecMin() {
 //!
 //! @returns true, when all vertices got a new function value. False otherwise i.e. in case of an error.
 bool Mesh::funcVertFeatureVecMax() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 
 	string funcName = "Determine maximum value of the feature vectors' elements.";
@@ -9061,6 +10471,7 @@ bool Mesh::funcVertFeatureVecMax() {
 //!
 //! @returns true, when all vertices got a new function value. False otherwise i.e. in case of an error.
 bool Mesh::funcVertFeatureVecMinSigned() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 
 	string funcName = "Determine minimal positve or negative value of the feature vectors' elements.";
@@ -9089,6 +10500,7 @@ bool Mesh::funcVertFeatureVecMinSigned() {
 //!
 //! @returns true, when all vertices got a new function value. False otherwise i.e. in case of an error.
 bool Mesh::funcVertFeatureVecMaxSigned() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool allSet = true;
 
 	string funcName = "Determine maximal positve or negative value of the feature vectors' elements.";
@@ -9117,6 +10529,7 @@ bool Mesh::funcVertFeatureVecMaxSigned() {
 //!       in the current implementation (06/2017).
 //! @returns false in case of an error e.g. Alglib not present. True otherwise.
 bool Mesh::funcVertFeatureVecMahalDist() {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 #ifndef ALGLIB
 	cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: ALGLIB is missing and required for this method!" << endl;
 	return false;
@@ -9357,6 +10770,7 @@ bool Mesh::funcVertFeatureVecPNorm(
                 const double&                rpNorm,
                 eFuncFeatureVecPNormWeigth   rWeigthType
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Sanity check
 	if( rReferenceVector.size() == 0 ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] No reference vector given!" << endl;
@@ -9393,17 +10807,21 @@ bool Mesh::funcVertFeatureVecPNorm(
 	}
 	cout << "[Mesh::" << __FUNCTION__ << "] checkSum: " << checkSum << endl;
 
-	int nrOfVertices = getVertexNr();
 	showProgressStart( funcName );
-	for( int vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertIdx );
-		double newFuncValue;
-		if( currVertex->getFeatureVecPNorm( &newFuncValue, rpNorm, &rReferenceVector, nullptr, &volumeIntInvWeight ) ) {
-			currVertex->setFuncValue( newFuncValue );
-		} else {
-			currVertex->setFuncValue( _NOT_A_NUMBER_DBL_ );
-		}
-		showProgress( static_cast<double>(vertIdx+1)/static_cast<double>(nrOfVertices), funcName );
+	FeatureVecDistance::sParams params;
+	params.mMetric       = FeatureVecDistance::METRIC_PNORM;
+	params.mReference    = rReferenceVector.data();
+	params.mReferenceLen = rReferenceVector.size();
+	params.mWeights      = volumeIntInvWeight.data();
+	params.mPNorm        = rpNorm;
+	vector<double> newFuncValues;
+	if( !estFeatureVecDistances( params, newFuncValues ) ) {
+		showProgressStop( funcName );
+		return( false );
+	}
+	showProgress( 0.5, funcName );
+	for( uint64_t vertIdx=0; vertIdx<newFuncValues.size(); vertIdx++ ) {
+		getVertexPos( vertIdx )->setFuncValue( newFuncValues[vertIdx] );
 	}
 	cout << "[Mesh::" << __FUNCTION__ << "] took " << static_cast<float>( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
 	showProgressStop( funcName );
@@ -9415,6 +10833,7 @@ bool Mesh::funcVertFeatureVecPNorm(
 //! Set the function value to an element of the feature vector.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::funcVertFeatureVecElementByIndex( unsigned int rElementNr ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Sanity checks
 	/*
 	//TODO: check which should actually be done here. rElementNr cannot be nan, because its an unsigned int
@@ -9449,6 +10868,7 @@ bool Mesh::funcVertDistanceToPlane(
     bool     rAbsDist,   //!< Compute absolut distance
     bool     rSilent     //!< Supress progress and function value update e.g. for temporary use.
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Sanity checks
 	if( !isnormal( rPlaneHNF.getLength3() ) ) {
 		return( false );
@@ -9488,6 +10908,7 @@ bool Mesh::funcVertDistanceToPlane(
 //! @warning The function does not notify the mesh about these changes (i.e. Mesh::changedVertFuncVal() is not called)!
 //! @returns False in case of an error. True otherwise.
 bool Mesh::funcVertAddLight( Matrix4D &rTransformMat, unsigned int rArrayWidth, unsigned int rArrayHeight, const vector<float>& rDepths, float rZTolerance ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	unsigned int nrOfVertices = getVertexNr();
 
 	for( unsigned int vertIdx = 0; vertIdx < nrOfVertices; vertIdx++ ) {
@@ -9906,6 +11327,7 @@ bool Mesh::funcValToFeatureVector(unsigned int dim)
 
 //! Compute the correlation of the vertices feature vector and store it as their function value.
 bool Mesh::setVertFuncValCorrTo( vector<double>* rFeatVector ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	cout << "[Mesh::" << __FUNCTION__ << "] Start" << endl;
 	// Sanity checks:
 	if( rFeatVector == nullptr ) {
@@ -10037,6 +11459,7 @@ bool Mesh::setVertFuncValDistanceToSelPrim() {
 //!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::setVertFuncValDistanceTo( const Vector3D& rPos ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	Vertex* currVertex;
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
 		currVertex = getVertexPos( vertIdx );
@@ -10058,6 +11481,8 @@ void Mesh::changedFaceFuncVal() {
 void Mesh::changedVertFuncVal() {
 	int timeStartSub = clock(); // for performance mesurement
 	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Begin.\n";
+	mFuncValStats.clear();
+	mFuncValGeneration++;
 	for( auto const& currVertex: mVertices ) {
 		// Set flags by calling the according method.
 		currVertex->isFuncValLocalMinimum();
@@ -10068,51 +11493,51 @@ void Mesh::changedVertFuncVal() {
 
 //! To be called, when the feature vectors were manipulated.
 void Mesh::changedVertFeatureVectors() {
-	//! \todo compute for feature vectors stored within the vertices.
-	//! \bug mFeatureVecVertices seems to hold bad values.
-	if( mFeatureVecVertices.size() == 0 ) {
+	const uint64_t featureVecLen = getFeatureVecLenMax( Primitive::IS_VERTEX );
+	if( featureVecLen == 0 ) {
 		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] ERROR: No feature vectors found!\n";
 		return;
 	}
 	auto timeStartSub = clock(); // for performance mesurement
 	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Begin.\n";
-	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] mFeatureVecVertices.size: " << mFeatureVecVertices.size() << "\n";
+	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector length: " << featureVecLen << "\n";
 	mVerticesFeatVecMean.clear();
 	mVerticesFeatVecStd.clear();
-	mVerticesFeatVecMean.resize(mFeatureVecVerticesLen,0.0);
-	mVerticesFeatVecStd.resize(mFeatureVecVerticesLen,0.0);
-	vector<uint64_t> verticesFeatVecNormal(mFeatureVecVerticesLen,0); // Number of elements having normal values of the feature vectors of the vertices. See std::isnormal()
+	mVerticesFeatVecMean.resize(featureVecLen,0.0);
+	mVerticesFeatVecStd.resize(featureVecLen,0.0);
+	vector<uint64_t> verticesFeatVecNormal(featureVecLen,0); // Number of elements having normal values of the feature vectors of the vertices. See std::isnormal()
 
 	// Accumulate values for the mean values:
+	vector<double> featureVec;
 	for( uint64_t i=0; i<getVertexNr(); i++ ) {
-		Vertex* currVert = getVertexPos( i );
-		for( uint64_t j=0; j<currVert->getFeatureVectorLen(); j++ ) {
-			double elementValue = _NOT_A_NUMBER_DBL_;
-			currVert->getFeatureElement( j, &elementValue );
-			if( isnormal( elementValue ) ) {
-				mVerticesFeatVecMean[j] += elementValue;
+		featureVec.clear();
+		getVertexPos( i )->getFeatureVectorElements( featureVec );
+		for( uint64_t j=0; j<featureVec.size(); j++ ) {
+			if( isnormal( featureVec[j] ) ) {
+				mVerticesFeatVecMean[j] += featureVec[j];
 				verticesFeatVecNormal[j]++;
 			}
 		}
 	}
 
 	// Compute and show mean values:
-	for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
+	for( uint64_t j=0; j<featureVecLen; j++ ) {
 		mVerticesFeatVecMean[j] /= static_cast<double>(verticesFeatVecNormal[j]);
 		LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector mean [" << j << "]: " << mVerticesFeatVecMean[j] << '\n';
 		LOG::debug() << " using " << verticesFeatVecNormal[j] << " values.\n";
 	}
 	// Accumulate values for the standard deviations:
 	for( uint64_t i=0; i<getVertexNr(); i++ ) {
-		for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
-			double val = mFeatureVecVertices.at( i*mFeatureVecVerticesLen+j );
-			if( isnormal( val ) ) {
-				mVerticesFeatVecStd[j] += pow( val - mVerticesFeatVecMean[j], 2.0 );
+		featureVec.clear();
+		getVertexPos( i )->getFeatureVectorElements( featureVec );
+		for( uint64_t j=0; j<featureVec.size(); j++ ) {
+			if( isnormal( featureVec[j] ) ) {
+				mVerticesFeatVecStd[j] += pow( featureVec[j] - mVerticesFeatVecMean[j], 2.0 );
 			}
 		}
 	}
 	// Compute and show standard deviations:
-	for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
+	for( uint64_t j=0; j<featureVecLen; j++ ) {
 		mVerticesFeatVecStd[j] /= static_cast<double>(verticesFeatVecNormal[j]);
 		mVerticesFeatVecStd[j] = sqrt( mVerticesFeatVecStd[j] );
 		LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector standard deviation [" << j << "]: " << mVerticesFeatVecStd[j] << "\n";
@@ -10154,48 +11579,20 @@ bool Mesh::getVertFuncValAverage( double* rAverage ) {
 
 //! Returns the minimum of the vertices' function value.
 //!
-//! Remark: Do not use this method too often (e.g. in a loop) as it may slow down the calling method/function.
+//! The range is taken from the statistics, which are cached until changedVertFuncVal is called.
 //!
 //! @return false in case of an error (e.g. no values set). True otherwise.
 bool Mesh::getFuncValuesMinMax( double& rMinVal, double& rMaxVal ) {
-	// Check if there is any valid number
-	bool valueSet = false;
-	rMinVal = +DBL_MAX;
-	rMaxVal = -DBL_MAX;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertIdx );
-		double  currFuncVal;
-		if( !currVertex->getFuncValue( &currFuncVal ) ) {
-			continue;
-		}
-		if( std::isnan( currFuncVal ) ) {
-			continue;
-		}
-		if( std::isinf( currFuncVal ) ) {
-			continue;
-		}
-		valueSet = true;
-		if( rMinVal > currFuncVal ) {
-			rMinVal = currFuncVal;
-		}
-		if( rMaxVal < currFuncVal ) {
-			rMaxVal = currFuncVal;
-		}
-	}
-
-	// Typical for meshs without a quality field:
-	if( !valueSet ) {
-		rMinVal = _NOT_A_NUMBER_DBL_;
-		rMaxVal = _NOT_A_NUMBER_DBL_;
-	}
-
+	// Typical for meshs without a quality field, which returns not-a-number:
+	const bool valueSet = getFuncValStats().getMinMax( rMinVal, rMaxVal );
 	cout << "[Mesh::" << __FUNCTION__ << "] min: " << rMinVal << " max: " << rMaxVal << " valueSet: " << valueSet << endl;
 	return( valueSet );
 }
 
 //! Returns the vertices' function values for the given quantiles.
 //!
-//! Remark: Do not use this method too often (e.g. in a loop) as it may slow down the calling method/function.
+//! The quantiles are selected without sorting and cached until changedVertFuncVal is called
+//! - see FuncValStats::getRank.
 //!
 //! @return false in case of an error (e.g. no values set). True otherwise.
 bool Mesh::getFuncValuesMinMaxQuantil( double  rMinQuantil,
@@ -10213,40 +11610,23 @@ bool Mesh::getFuncValuesMinMaxQuantil( double  rMinQuantil,
 		return( false );
 	}
 
-	// Fetch all vertices with finite values:
-	vector<Vertex*> verticesSortedAndSelected;
-	getVertexListValidFuncVal( &verticesSortedAndSelected );
-	if( verticesSortedAndSelected.empty() ) {
+	// Valid numbers for the quantil exclude NaN, +Inf and - Inf:
+	FuncValStats& funcValStats = getFuncValStats();
+	if( funcValStats.getFiniteCount() == 0 ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: No vertices!" << endl;
 		return( false );
 	}
 
-	// Sort:
-	sort( verticesSortedAndSelected.begin(), verticesSortedAndSelected.end(), Vertex::funcValLower );
-	// valid numbers for the quantil exclude NaN, +Inf and - Inf
-	// because the first vertices will have -Inf after sorting we need to add their number as an offset:
-	long quantilIdxLow  = round( rMinQuantil*static_cast<double>(verticesSortedAndSelected.size()-1) );
-	long quantilIdxHigh = round( rMaxQuantil*static_cast<double>(verticesSortedAndSelected.size()-1) );
-
 	// Fetch values:
-	double valCur;
-	if( !verticesSortedAndSelected.at( quantilIdxLow )->getFuncValue( &valCur ) ) {
+	uint64_t quantilIdxLow  = 0;
+	uint64_t quantilIdxHigh = 0;
+	if( !funcValStats.getQuantile( rMinQuantil, rMinVal, &quantilIdxLow ) ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: UNEXPECTED minimum Value (Quantile)!" << endl;
 		return( false );
-	} else if( !std::isfinite(valCur) ) {
-		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: INFINITE minimum Value (Quantile)!" << endl;
-		return( false );
-	} else {
-		rMinVal = valCur;
 	}
-	if( !verticesSortedAndSelected.at( quantilIdxHigh )->getFuncValue( &valCur ) ) {
+	if( !funcValStats.getQuantile( rMaxQuantil, rMaxVal, &quantilIdxHigh ) ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: UNEXPECTED maximum Value (Quantile)!" << endl;
 		return( false );
-	} else if( !std::isfinite(valCur) ) {
-		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: INFINITE maximum Value (Quantile)!" << endl;
-		return( false );
-	} else {
-		rMaxVal = valCur;
 	}
 
 	// Done:
@@ -10255,6 +11635,36 @@ bool Mesh::getFuncValuesMinMaxQuantil( double  rMinQuantil,
 	return( true );
 }
 
+//! Statistics of the function values of the vertices. Built, when not present,
+//! the number of vertices has changed or the function values were changed since - see mFuncValGeneration.
+//!
+//! @returns reference to the statistics, which is valid until a function value is changed.
+FuncValStats& Mesh::getFuncValStats() {
+	const uint64_t vertexCount = getVertexNr();
+	if( mFuncValStats.isBuilt() && ( mFuncValStats.getValueCount() == vertexCount ) &&
+	    ( mFuncValStatsGeneration == mFuncValGeneration ) ) {
+		return( mFuncValStats );
+	}
+	PROFILE_SCOPE( "Mesh::getFuncValStats" );
+	// Pack the values, so the vertices are visited only once:
+	vector<double> funcValues( vertexCount, _NOT_A_NUMBER_DBL_ );
+	const uint64_t chunkSize  = 16384; // Vertices per task.
+	const uint64_t vertChunks = ParallelFor::getChunkCount( vertexCount, chunkSize );
+	ParallelFor::forEachChunk( vertChunks, ParallelFor::getThreadCount(), [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			if( !getVertexPos( vertIdx )->getFuncValue( &funcValues[vertIdx] ) ) {
+				funcValues[vertIdx] = _NOT_A_NUMBER_DBL_;
+			}
+		}
+	} );
+	mFuncValStats.build( funcValues );
+	mFuncValStatsGeneration = mFuncValGeneration;
+	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Finite: " << mFuncValStats.getFiniteCount()
+	             << " Infinite: " << mFuncValStats.getInfiniteCount() << " NaN: " << mFuncValStats.getNaNCount() << "\n";
+	return( mFuncValStats );
+}
+
 //! Returns the minimum of the feature function value.
 //! Returns false in case of an error (e.g. no values set).
 //!
@@ -10351,6 +11761,7 @@ bool Mesh::getFuncValuesMinMaxInfNanFail( double& rMinVal,
 //! Stub to handle higher level tasks. Typically re-compute OpenGL VBos.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::changedMesh() {
+	mFuncValStats.clear();
 	return( true );
 }
 
@@ -10405,6 +11816,51 @@ bool Mesh::removeVertices( set<Vertex*>* verticesToRemove ) {
 	return true;
 }
 
+//! Removes all vertices (and their related faces) flagged within a byte mask
+//! indexed by the position of the vertices. Compared to Mesh::removeVertices
+//! the vertex list is compacted in one pass without lookups.
+//! @returns false in case of an error or when no vertices were removed.
+bool Mesh::removeVerticesMasked( const std::vector<uint8_t>& rRemoveMask ) {
+	if( rRemoveMask.size() != getVertexNr() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Mask has " << rRemoveMask.size() << " entries for " << getVertexNr() << " vertices!\n";
+		return( false );
+	}
+
+	// Faces of the vertices have to be removed first to keep the references consistent.
+	set<Face*> facesToRemove;
+	for( uint64_t vertIdx=0; vertIdx<rRemoveMask.size(); vertIdx++ ) {
+		if( rRemoveMask[vertIdx] != 0 ) {
+			mVertices[vertIdx]->getFaces( &facesToRemove );
+		}
+	}
+	const uint64_t facesBefore = getFaceNr();
+	removeFaces( &facesToRemove );
+	cout << "[Mesh::" << __FUNCTION__ << "] " << facesBefore-getFaceNr() << " Faces removed." << endl;
+
+	// Compaction:
+	uint64_t vertIdxNew = 0;
+	for( uint64_t vertIdx=0; vertIdx<rRemoveMask.size(); vertIdx++ ) {
+		if( rRemoveMask[vertIdx] != 0 ) {
+			delete mVertices[vertIdx];
+			continue;
+		}
+		mVertices[vertIdxNew] = mVertices[vertIdx];
+		vertIdxNew++;
+	}
+	const uint64_t verticesRemoved = mVertices.size() - vertIdxNew;
+	mVertices.resize( vertIdxNew );
+	cout << "[Mesh::" << __FUNCTION__ << "] " << verticesRemoved << " Vertices removed." << endl;
+	if( verticesRemoved == 0 ) {
+		return( false );
+	}
+
+	mPrimSelected = nullptr;
+	estBoundingBox();
+	delete mOctree;
+	mOctree = nullptr;
+	return( true );
+}
+
 //! Removes all vertices (and their related faces) stored in mSelectedMVerts.
 //! @returns false in case of an error or when no vertices were removed.
 bool Mesh::removeVerticesSelected() {
@@ -10428,6 +11884,7 @@ bool Mesh::removeUncleanSmall(
         double                    rPercentArea,   //!< Area relative to the whole mesh.
         bool                      rApplyErosion   //!< Add extra border cleaning.
 ) {
+	PROFILE_SCOPE( "Mesh::removeUncleanSmall" );
 	bool retVal = false;
 
 	// Track changes for meta-data
@@ -10730,6 +12187,7 @@ bool Mesh::completeRestore(
         string*                 rResultMsg,           //!< Returns string for display in e.g. a messagebox.
         uint64_t&               rIterationCount       //!< Returns number of iterations.
 ) {
+	PROFILE_SCOPE( "Mesh::completeRestore" );
 	// Measure compute time
 	//----------------------------------------------------------
 	std::chrono::system_clock::time_point tStart = std::chrono::system_clock::now();
@@ -10758,7 +12216,7 @@ bool Mesh::completeRestore(
 		oldFaceNr = getFaceNr();
 		uint64_t subIterationCount = 0;
 		removeUncleanSmallCore( rFilename, rPercentArea, rApplyErosion, subIterationCount );
-		convertBordersToPolylines();
+		convertBordersToPolylinesParallel();
 
 		if( rPrevent ) {
 			selectPolyLongest();
@@ -11209,22 +12667,16 @@ bool Mesh::getVertLabelAreaLargest(
 ) {
 	double      largestArea    = -_INFINITE_DBL_;
 	long        largestLabelId = -1;
-	set<Face*>* labelFaces;
-	uint64_t labelsNr;
+	std::vector<double> labelAreas;
 
-	// Fetch faces grouped by
-	if( !labelFacesVert( &labelFaces, labelsNr ) ) {
-		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: labelFacesVert failed!" << endl;
+	// Estimate area per label
+	if( !labelFacesVertArea( labelAreas ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: labelFacesVertArea failed!" << endl;
 		return( false );
 	}
 
-	// Estimate area, and select vertices and clear memory.
-	set<Face*>::iterator itFace;
-	for( uint64_t i=0; i<labelsNr; i++ ) {
-		double labelArea = 0.0;
-		for( itFace=labelFaces[i].begin(); itFace!=labelFaces[i].end(); itFace++ ) {
-			labelArea += (*itFace)->getAreaNormal();
-		}
+	for( uint64_t i=0; i<labelAreas.size(); i++ ) {
+		const double labelArea = labelAreas[i];
 		cout << "[Mesh::" << __FUNCTION__ << "] Label " << i+1 << " area: " << labelArea << endl;
 		if( labelArea >= largestArea ) {
 			// New largest label found.
@@ -11237,8 +12689,6 @@ bool Mesh::getVertLabelAreaLargest(
 	// Write back the result
 	rLargestLabelId = largestLabelId;
 
-	delete[] labelFaces;
-
 	return( true );
 }
 
@@ -11250,19 +12700,22 @@ bool Mesh::getVertLabelAreaLT( double rAreaMax, set<Vertex*>* rSomeVerts ) {
 
 	set<Face*>*   labelFaces;
 	uint64_t labelsNr;
+	std::vector<double> labelAreas;
 
 	// Fetch faces grouped by
 	if( !labelFacesVert( &labelFaces, labelsNr ) ) {
 		return false;
 	}
+	if( !labelFacesVertArea( labelAreas ) || ( labelAreas.size() != labelsNr ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: labelFacesVertArea failed!" << endl;
+		delete[] labelFaces;
+		return false;
+	}
 
-	// Estimate area, and select vertices and clear memory.
+	// Select vertices and clear memory.
 	set<Face*>::iterator itFace;
 	for( uint64_t i=0; i<labelsNr; i++ ) {
-		double labelArea = 0.0;
-		for( itFace=labelFaces[i].begin(); itFace!=labelFaces[i].end(); itFace++ ) {
-			labelArea += (*itFace)->getAreaNormal();
-		}
+		double labelArea = labelAreas[i];
 		cout << "[Mesh::" << __FUNCTION__ << "] Label " << i << " area: " << labelArea << endl;
 		if( labelArea >= rAreaMax ) {
 			// We don't need the faces anymore and jump to the next label.
@@ -11295,11 +12748,6 @@ bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts
 	set<Face*>*   labelFaces;
 	uint64_t labelsNr;
 
-	// Fetch faces grouped by
-	if( !labelFacesVert( &labelFaces, labelsNr ) ) {
-		cout << "[Mesh::" << __FUNCTION__ << "] No labels found." << endl;
-		return false;
-	}
 	if( rPercent <= 0.0 ) {
 		cout << "[Mesh::" << __FUNCTION__ << "] negative or zero value given: " << rPercent << endl;
 		return false;
@@ -11308,18 +12756,24 @@ bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts
 		cout << "[Mesh::" << __FUNCTION__ << "] value equal or greater then 1.0 given: " << rPercent << endl;
 		return false;
 	}
+	// Fetch faces grouped by
+	if( !labelFacesVert( &labelFaces, labelsNr ) ) {
+		cout << "[Mesh::" << __FUNCTION__ << "] No labels found." << endl;
+		return false;
+	}
 
 	const uint64_t labelsNrConst = labelsNr;
 
 	// Estimate area
 	double labelAreaTotal = 0.0;
-	double* labelAreas = new double[labelsNrConst];
+	std::vector<double> labelAreas;
+	if( !labelFacesVertArea( labelAreas ) || ( labelAreas.size() != labelsNrConst ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: labelFacesVertArea failed!" << endl;
+		delete[] labelFaces;
+		return false;
+	}
 	set<Face*>::iterator itFace;
 	for( uint64_t i=0; i<labelsNrConst; i++ ) {
-		labelAreas[i] = 0.0;
-		for( itFace=labelFaces[i].begin(); itFace!=labelFaces[i].end(); itFace++ ) {
-			labelAreas[i] += (*itFace)->getAreaNormal();
-		}
 		cout << "[Mesh::" << __FUNCTION__ << "] Label " << i << " area: " << labelAreas[i] << endl;
 		labelAreaTotal += labelAreas[i];
 	}
@@ -11345,7 +12799,6 @@ bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts
 	}
 
 	delete[] labelFaces;
-	delete[] labelAreas;
 
 	cout << "[Mesh::" << __FUNCTION__ << "] " << labelsRemoved << " out of " << labelsNrConst << " labels selected." << endl;
 	// Clear allocated memory
@@ -11952,55 +13405,74 @@ set<Face*> Mesh::getNonManifoldFaces() {
 //! Computes the volume within the 3D-Model using the divergence theorem.
 //! Remark: for a proper result the surface has to be closed (no holes/borders) and manifold.
 //!
+//! The faces are summed in parallel by FaceReduction::reduce, so the result
+//! does not depend on the number of threads. Faces having a zero area are
+//! skipped and counted.
+//!
 //! See also: Face::getVolumeDivergence
 //!
 //! @returns false in case of an error, which are caused by zero area faces.
 bool Mesh::getMeshVolumeDivergence(
-                double& rVolumeDX, //!< Volume estimated in x-direction.
-                double& rVolumeDY, //!< Volume estimated in y-direction.
-                double& rVolumeDZ  //!< Volume estimated in z-direction.
+                double&   rVolumeDX,        //!< Volume estimated in x-direction.
+                double&   rVolumeDY,        //!< Volume estimated in y-direction.
+                double&   rVolumeDZ,        //!< Volume estimated in z-direction.
+                uint64_t* rFacesDegenerate  //!< Optional number of faces skipped due to a zero area (return value).
 ) {
-	bool retVal = true;
-
-	rVolumeDX = 0.0;
-	rVolumeDY = 0.0;
-	rVolumeDZ = 0.0;
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		if( !currFace->getVolumeDivergence( rVolumeDX, rVolumeDY, rVolumeDZ ) ) {
-			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVolumeDivergence did not return a result. Probably a zero area face was encountered!" << endl;
-			retVal = false;
-		}
+	PROFILE_SCOPE( "Mesh::getMeshVolumeDivergence" );
+	const FaceReduction::sResult volumes = FaceReduction::reduce( getFaceNr(), 3, [this]( uint64_t rFaceIdx, double* rVolumeDXYZ ) {
+		if( !mFaces[rFaceIdx]->getVolumeDivergence( rVolumeDXYZ[0], rVolumeDXYZ[1], rVolumeDXYZ[2] ) ) {
+			return( FaceReduction::FACE_DEGENERATE );
+		}
+		return( FaceReduction::FACE_VALID );
+	} );
+	rVolumeDX = volumes.mSums[0];
+	rVolumeDY = volumes.mSums[1];
+	rVolumeDZ = volumes.mSums[2];
+	if( rFacesDegenerate != nullptr ) {
+		(*rFacesDegenerate) = volumes.mFacesDegenerate;
+	}
+	if( volumes.mFacesDegenerate > 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVolumeDivergence did not return a result for " << volumes.mFacesDegenerate << " faces. Probably zero area faces were encountered!" << endl;
+		return( false );
 	}
-	return( retVal );
+	return( true );
 }
 
 //! Compute the volume below the Mesh's faces to the Mesh plane.
+//!
+//! The faces are summed in parallel by FaceReduction::reduce. Faces having
+//! a zero area are skipped and counted.
+//!
 //! @returns false in case of an error, which are caused by zero area faces.
-bool Mesh::compVolumePlane( double* rVolumePos, double* rVolumeNeg ) {
-	bool retVal = true;
+bool Mesh::compVolumePlane(
+                double*   rVolumePos,       //!< Volume of the faces on the positive side of the plane (return value).
+                double*   rVolumeNeg,       //!< Volume of the faces on the negative side of the plane (return value).
+                uint64_t* rFacesDegenerate  //!< Optional number of faces skipped due to a zero area (return value).
+) {
 	if( ( rVolumePos == nullptr ) || ( rVolumeNeg == nullptr ) ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Null pointer given!" << endl;
 		return false;
 	}
-	(*rVolumePos) = 0.0;
-	(*rVolumeNeg) = 0.0;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		Face* currFace = getFacePos( faceIdx );
+	PROFILE_SCOPE( "Mesh::compVolumePlane" );
+	const FaceReduction::sResult volumes = FaceReduction::reduce( getFaceNr(), 2, [this]( uint64_t rFaceIdx, double* rVolumePosNeg ) {
 		double faceVolume = 0.0;
 		bool   planePos;
-		if( !currFace->getVolumeToPlane( &faceVolume, &planePos, &mPlane ) ) {
-			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVolumeToPlane did not return a result. Probably a zero area face was encountered!" << endl;
-			retVal = false;
-		}
-		if( planePos ) {
-			(*rVolumePos) += faceVolume;
-		} else {
-			(*rVolumeNeg) += faceVolume;
-		}
+		if( !mFaces[rFaceIdx]->getVolumeToPlane( &faceVolume, &planePos, &mPlane ) ) {
+			return( FaceReduction::FACE_DEGENERATE );
+		}
+		rVolumePosNeg[planePos ? 0 : 1] = faceVolume;
+		return( FaceReduction::FACE_VALID );
+	} );
+	(*rVolumePos) = volumes.mSums[0];
+	(*rVolumeNeg) = volumes.mSums[1];
+	if( rFacesDegenerate != nullptr ) {
+		(*rFacesDegenerate) = volumes.mFacesDegenerate;
+	}
+	if( volumes.mFacesDegenerate > 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVolumeToPlane did not return a result for " << volumes.mFacesDegenerate << " faces. Probably zero area faces were encountered!" << endl;
+		return false;
 	}
-	return retVal;
+	return true;
 }
 
 // Histogram (NEW) ---------------------------------------------------------------------------------------------------------------------------------------------
@@ -12018,6 +13490,33 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		return false;
 	}
 
+	// Function values are counted using the cached statistics:
+	if( rHistType == HISTOGRAM_FUNCTION_VALUES_VERTEX ) {
+		FuncValStats& funcValStats = getFuncValStats();
+		cout << "[Mesh::" << __FUNCTION__ << "] Histogram value cardinality: " << funcValStats.getValueCount() << endl;
+		funcValStats.getMinMax( (*rValMin), (*rValMax) );
+		cout << "[Mesh::" << __FUNCTION__ << "] Histogram value range from " << (*rValMin) << " to " << (*rValMax) << "" << endl;
+		cout << "[Mesh::" << __FUNCTION__ << "] Ignored " << funcValStats.getValueCount() - funcValStats.getFiniteCount() << " values (Infinite, NaN)" << endl;
+		const double histRange = (*rValMax) - (*rValMin);
+		if( !( histRange > DBL_EPSILON ) ) {
+			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Histogram values have no range!" << endl;
+			return false;
+		}
+		if( rNumArray->empty() || !( histRange / rNumArray->size() > DBL_EPSILON ) ) {
+			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Numeric Error: Zero interval length for histogram!" << endl;
+			return false;
+		}
+		vector<uint64_t> binCounts;
+		if( !funcValStats.getHistogram( rNumArray->size(), binCounts ) ) {
+			return false;
+		}
+		for( uint64_t binIdx=0; binIdx<binCounts.size(); binIdx++ ) {
+			rNumArray->at( binIdx ) += binCounts[binIdx];
+		}
+		cout << "[Mesh::" << __FUNCTION__ << "] Histogram # " << rHistType << " successful." << endl;
+		return true;
+	}
+
 	// Fetch values
 	unsigned int histValuesNr = 0;
 	double*      histValues = nullptr;
@@ -12056,15 +13555,6 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 				currVertex->getFeatureElement( dimNr, &histValues[vertIdx] );
 			}
 		} break;
-		case HISTOGRAM_FUNCTION_VALUES_VERTEX: {
-			histValuesNr = getVertexNr();
-			histValues   = new double[histValuesNr];
-			Vertex* currVertex;
-			for( unsigned int vertIdx=0; vertIdx<histValuesNr; vertIdx++ ) {
-				currVertex = getVertexPos( vertIdx );
-				currVertex->getFuncValue( &histValues[vertIdx] );
-			}
-		} break;
 		case HISTOGRAM_FUNCTION_VALUES_VERTEX_LOCAL_MINIMA: {
 			histValuesNr = getVertexNr();
 			histValues   = new double[histValuesNr];
@@ -12298,6 +13788,24 @@ uint64_t Mesh::getBitArrayEdges(
 	return edgeNrLongs;
 }
 
+//! Prepares a VisitedSet for vertices. To be used instead of Mesh::getBitArrayVerts,
+//! when many local neighbourhoods are fetched, as the VisitedSet is reset in O(1).
+//! Typically one VisitedSet per thread.
+void Mesh::getVisitedSetVerts(
+                VisitedSet& rVertsVisited
+) const {
+	rVertsVisited.resize( getVertexNr() );
+}
+
+//! Prepares a VisitedSet for faces. To be used instead of Mesh::getBitArrayFaces,
+//! when many local neighbourhoods are fetched, as the VisitedSet is reset in O(1).
+//! Typically one VisitedSet per thread.
+void Mesh::getVisitedSetFaces(
+                VisitedSet& rFacesVisited
+) const {
+	rFacesVisited.resize( getFaceNr() );
+}
+
 // Estimate geodesic neighbourhood -----------------------------------------------------
 
 //! Estimate a geodesic patch for the selected vertices (SelMVerts) -- in sequential order.
@@ -12530,6 +14038,7 @@ bool Mesh::estGeodesicPatchRelabel( map<Vertex*,GeodEntry*>* geoDistList ) {
 bool Mesh::estGeodesicPatchFuncVal(
                 map<Vertex*,GeodEntry*>* rGeoDistList
 ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	bool     storeAngle = false;
 	getParamFlagMesh( MeshParams::GEODESIC_STORE_DIRECTION, &storeAngle );
 
@@ -13202,7 +14711,7 @@ bool Mesh::fetchSphereBitArray( Vertex*        rSeedVertex,          //!< point
 	int  currIdx = rSeedVertex->getIndex();
 	double seqNr = 0.0; // Only used, when rOrderToFuncVal is setS
 	rSeedVertex->getIndexOffsetBit( &bitOffset, &bitNr );
-	rVertBitArrayVisited[bitOffset] = 1U <<bitNr;
+	rVertBitArrayVisited[bitOffset] |= static_cast<uint64_t>(1)<<bitNr;
 	nextArray.insert( rSeedVertex );
 	//! While there are vertices at the front:
 	while( nextArray.size() > 0 ) {
@@ -13315,27 +14824,126 @@ bool Mesh::fetchSphereBitArray1R(
 	return( true );
 }
 
-// Compute or estimate Multi-Scale Integral Invariants (MSII) --------------------------------------------------------------------------------------------------
-
-double Mesh::fetchSphereCubeVolume25D( Vertex*     seedVertex,            //!< equals sphere center
-                                      set<Face*>* facesInSphere,         //!< pre-selected list of faces
-                                      double      radius,                //!< radius_max of our spheres
-                                      double*     rasterArray,           //!< pre-allocated depth-map array of size cubeEdgeLengthInVoxels^2.
-                                      int         cubeEdgeLengthInVoxels //!< equals xDim equals yDim equals zDim for our sparse 2.5D voxel cube as well as the sqrt( size of rasterAray )
+//! Fetch all Faces within a sphere plus 1-ring neighbourhood using VisitedSets.
+//! Same result as the bit array variant, but the cost is proportional to the size of the patch
+//! instead of the size of the mesh.
+//! ATTENTION: Requires that the vertex and face indices are set properly!
+//! @returns false in case of an error.
+bool Mesh::fetchSphereBitArray(
+                Vertex*        rSeedVertex,      //!< point of origin of our search
+                vector<Face*>* rFacesInSphere,   //!< reference to a(n empty) pre-allocated face list
+                float          rRadius,          //!< maximum radius of our multi-scale spheres
+                VisitedSet&    rVertsVisited,    //!< VisitedSet for vertices - see Mesh::getVisitedSetVerts
+                VisitedSet&    rFacesVisited,    //!< VisitedSet for faces - see Mesh::getVisitedSetFaces
+                bool           rOrderToFuncVal   //!< When set, the method will write the access order of the faces as face function value.
 ) {
-	//! Returns a 2 1/2 D voxel array, which is virtually a cube large enough to hold a sphere with the given radius.
-	//!
-	//! The float array returned is of size cubeEdgeLengthInVoxels x cubeEdgeLengthInVoxels.
-	//!
-	//! Returns the area of the total area of the faces, when successfull.
-	//! Returns _NOT_A_NUMBER_ otherwise.
-
-	if( seedVertex->isSolo() ) {
-		return _NOT_A_NUMBER_DBL_;
+	if( rVertsVisited.size() < getVertexNr() || rFacesVisited.size() < getFaceNr() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: VisitedSet too small!\n";
+		return( false );
 	}
+	// Get the coordinates
+	double seedXYZ[3];
+	rSeedVertex->copyCoordsTo( seedXYZ );
 
-	// in theory to fetch everything in the cube:
-	//---------------------------------------------
+	double seqNr = 0.0; // Only used, when rOrderToFuncVal is set
+	// queue for next:
+	vector<Vertex*> nextArray;
+	rSeedVertex->markVisited( rVertsVisited );
+	nextArray.push_back( rSeedVertex );
+	size_t arrPos = 0;
+	while( arrPos < nextArray.size() ) {
+		//! -> Add all adjacent faces of the next vertex at the front
+		nextArray.at( arrPos )->advanceInSphere( seedXYZ, rRadius, rVertsVisited, &nextArray, rFacesVisited, rOrderToFuncVal, &seqNr );
+		arrPos++;
+	}
+
+	//! Faces are returned ordered by index just like the bit array variant.
+	vector<uint64_t> faceIndices( rFacesVisited.getMarked() );
+	sort( faceIndices.begin(), faceIndices.end() );
+	rFacesInSphere->reserve( rFacesInSphere->size() + faceIndices.size() );
+	for( uint64_t const faceIdx : faceIndices ) {
+		rFacesInSphere->push_back( getFacePos( faceIdx ) );
+	}
+
+	//! Clears the VisitedSets, when finished.
+	rVertsVisited.clear();
+	rFacesVisited.clear();
+	return( true );
+}
+
+//! Fetch all Faces within a sphere plus 1-ring neighbourhood using VisitedSets.
+//! Same result as the bit array variant, but the cost is proportional to the size of the patch
+//! instead of the size of the mesh.
+//! ATTENTION: Requires that the vertex and face indices are set properly!
+//! @returns false in case of an error.
+bool Mesh::fetchSphereBitArray1R(
+                Vertex*        rSeedVertex,      //!< point of origin of our search
+                vector<Face*>& rFacesInSphere,   //!< reference to a(n empty) pre-allocated face list
+                double         rRadius,          //!< maximum radius of our multi-scale spheres
+                VisitedSet&    rVertsVisited,    //!< VisitedSet for vertices - see Mesh::getVisitedSetVerts
+                VisitedSet&    rFacesVisited,    //!< VisitedSet for faces - see Mesh::getVisitedSetFaces
+                bool           rOrderToFuncVal   //!< When set, the method will write the access order of the faces as face function value.
+) {
+	if( rVertsVisited.size() < getVertexNr() || rFacesVisited.size() < getFaceNr() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: VisitedSet too small!\n";
+		return( false );
+	}
+	// queue for next:
+	vector<Vertex*> nextArray;
+
+	double seqNr = 0.0; // Only used, when rOrderToFuncVal is set
+	rSeedVertex->markVisited( rVertsVisited );
+	nextArray.push_back( rSeedVertex );
+	//! While there are vertices at the front:
+	size_t arrPos = 0;
+	while( arrPos < nextArray.size() ) {
+		//! -> Fetch the next vertex from the front.
+		Vertex* currVert = nextArray.at( arrPos );
+		//! -> Add 1-ring vertex neighbours at the end of the front vector, when the vertex is within the sphere.
+		const double currDistance = currVert->estDistanceTo( rSeedVertex );
+		if( currDistance <= rRadius ) {
+			currVert->getAdjacentVerticesExcluding( &nextArray, rVertsVisited );
+		}
+		//! -> Add all its adjacent faces and vertices.
+		currVert->mark1RingVisited( rVertsVisited, rFacesVisited, rOrderToFuncVal, &seqNr );
+		arrPos++;
+	}
+
+	//! Faces are returned ordered by index just like the bit array variant.
+	vector<uint64_t> faceIndices( rFacesVisited.getMarked() );
+	sort( faceIndices.begin(), faceIndices.end() );
+	rFacesInSphere.reserve( rFacesInSphere.size() + faceIndices.size() );
+	for( uint64_t const faceIdx : faceIndices ) {
+		rFacesInSphere.push_back( getFacePos( faceIdx ) );
+	}
+
+	//! Clears the VisitedSets, when finished.
+	rVertsVisited.clear();
+	rFacesVisited.clear();
+	return( true );
+}
+
+// Compute or estimate Multi-Scale Integral Invariants (MSII) --------------------------------------------------------------------------------------------------
+
+double Mesh::fetchSphereCubeVolume25D( Vertex*     seedVertex,            //!< equals sphere center
+                                      set<Face*>* facesInSphere,         //!< pre-selected list of faces
+                                      double      radius,                //!< radius_max of our spheres
+                                      double*     rasterArray,           //!< pre-allocated depth-map array of size cubeEdgeLengthInVoxels^2.
+                                      int         cubeEdgeLengthInVoxels //!< equals xDim equals yDim equals zDim for our sparse 2.5D voxel cube as well as the sqrt( size of rasterAray )
+) {
+	//! Returns a 2 1/2 D voxel array, which is virtually a cube large enough to hold a sphere with the given radius.
+	//!
+	//! The float array returned is of size cubeEdgeLengthInVoxels x cubeEdgeLengthInVoxels.
+	//!
+	//! Returns the area of the total area of the faces, when successfull.
+	//! Returns _NOT_A_NUMBER_ otherwise.
+
+	if( seedVertex->isSolo() ) {
+		return _NOT_A_NUMBER_DBL_;
+	}
+
+	// in theory to fetch everything in the cube:
+	//---------------------------------------------
 	// Radius of the outer sphere enclosing the cube, which encloses the
 	// inner sphere used for voxelization:
 	// float sphereRadius = radius * sqrt(3);
@@ -13803,14 +15411,8 @@ bool Mesh::applyTransformationToWholeMesh( Matrix4D rTrans, bool rResetNormals,
 		return false;
 	}
 
-	// Apply to ALL vertices:
-	set<Vertex*> allVertices;
-	for( auto const& currVertex: mVertices ) {
-		allVertices.insert( currVertex );
-	}
-
 	//!\todo Apply to all cone paramters, the sphere and the mesh plane.
-    if(applyTransformation(rTrans, &allVertices, rResetNormals, rSaveTransMat))
+    if(applyTransformationVerticesAll(rTrans, rResetNormals, rSaveTransMat))
 	{
 		//! .) Apply to (cone/cylinder) axis
 		mConeAxisPoints[0] *= rTrans;
@@ -13966,6 +15568,129 @@ bool Mesh::applyTransformationDefaultViewMatrix( Matrix4D* rViewMatrix ) {
 	return( retVal );
 }
 
+//! Apply a given transformation matrix Matrix4D to all vertices of the mesh.
+//!
+//! Fast path of applyTransformation for the whole mesh: the vertices are
+//! processed in parallel chunks of the vertex array without virtual calls and
+//! the bounding box is estimated within the same sweep. The face normals and
+//! the area are recomputed within a second parallel sweep over the faces.
+//! Vertices without a normal get their normal estimated before the transformation.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::applyTransformationVerticesAll( const Matrix4D& rTrans, bool rResetNormals, bool rSaveTransMat ) {
+	PROFILE_SCOPE( "Mesh::applyTransformationVerticesAll" );
+	showProgressStart( "Apply Transformation" );
+	showProgress( 0.0, "Apply Transformation" );
+
+	const unsigned int threadCount    = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize      = 16384; // Primitives per task.
+	const uint64_t     vertexCount    = getVertexNr();
+	const uint64_t     faceCount      = getFaceNr();
+	const uint64_t     vertexChunks   = ParallelFor::getChunkCount( vertexCount, chunkSize );
+	const uint64_t     faceChunks     = ParallelFor::getChunkCount( faceCount, chunkSize );
+
+	//! .) Estimate missing vertex normals using the untransformed positions,
+	//!    which is otherwise done on demand by Vertex::applyTransfrom.
+	std::vector<uint64_t> chunkNormalsMissing( vertexChunks, 0 );
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			if( !getVertexPos( vertIdx )->getFlag( FLAG_NORMAL_SET ) ) {
+				chunkNormalsMissing[rChunkIdx]++;
+			}
+		}
+	} );
+	if( std::accumulate( chunkNormalsMissing.begin(), chunkNormalsMissing.end(), static_cast<uint64_t>( 0 ) ) > 0 ) {
+		// Face normals first, as they are otherwise computed on demand by multiple vertices:
+		ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+			for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+				getFacePos( faceIdx )->getAreaNormal();
+			}
+		} );
+		ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+			if( chunkNormalsMissing[rChunkIdx] == 0 ) {
+				return;
+			}
+			const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+			for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+				Vertex* currVertex = getVertexPos( vertIdx );
+				if( !currVertex->getFlag( FLAG_NORMAL_SET ) ) {
+					currVertex->estNormalAvgAdjacentFaces();
+				}
+			}
+		} );
+	}
+
+	//! .) Apply transformation matrix to each vertex and estimate the bounding box.
+	double transMat[16];
+	for( int i=0; i<4; i++ ) {
+		transMat[i]    = rTrans.getX( i );
+		transMat[4+i]  = rTrans.getY( i );
+		transMat[8+i]  = rTrans.getZ( i );
+		transMat[12+i] = rTrans.getH( i );
+	}
+	struct sChunkBoundingBox {
+		double mMin[3] = { +DBL_MAX, +DBL_MAX, +DBL_MAX };
+		double mMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	};
+	std::vector<sChunkBoundingBox> chunkBoundingBoxes( vertexChunks );
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		sChunkBoundingBox& boundingBox = chunkBoundingBoxes[rChunkIdx];
+		double vertXYZ[3];
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, vertexCount );
+		for( uint64_t vertIdx=rChunkIdx*chunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			Vertex* currVertex = getVertexPos( vertIdx );
+			currVertex->applyTransfromArray( transMat );
+			currVertex->copyXYZTo( vertXYZ );
+			for( int i=0; i<3; i++ ) {
+				if( boundingBox.mMin[i] > vertXYZ[i] ) {
+					boundingBox.mMin[i] = vertXYZ[i];
+				}
+				if( boundingBox.mMax[i] < vertXYZ[i] ) {
+					boundingBox.mMax[i] = vertXYZ[i];
+				}
+			}
+		}
+	} );
+	showProgress( 0.5, "Apply Transformation" );
+
+	//! .) Merge the bounding box - see estBoundingBox
+	sChunkBoundingBox boundingBox;
+	for( const sChunkBoundingBox& chunkBoundingBox : chunkBoundingBoxes ) {
+		for( int i=0; i<3; i++ ) {
+			boundingBox.mMin[i] = std::min( boundingBox.mMin[i], chunkBoundingBox.mMin[i] );
+			boundingBox.mMax[i] = std::max( boundingBox.mMax[i], chunkBoundingBox.mMax[i] );
+		}
+	}
+	mMinX = boundingBox.mMin[0];
+	mMaxX = boundingBox.mMax[0];
+	mMinY = boundingBox.mMin[1];
+	mMaxY = boundingBox.mMax[1];
+	mMinZ = boundingBox.mMin[2];
+	mMaxZ = boundingBox.mMax[2];
+	changedBoundingBox();
+	cout << "[Mesh::" << __FUNCTION__ << "] Bounding box is now: " << mMaxX-mMinX << " x "  << mMaxY-mMinY << " x "  << mMaxZ-mMinZ << " mm (unit assumed)." << endl;
+
+	//! .) Reset face normals and sum up the area - see resetFaceNormals
+	if( rResetNormals ) {
+		double meshArea;
+		resetFaceNormals( &meshArea );
+		cout << "[Mesh::" << __FUNCTION__ << "] Area of the mesh is now: " << meshArea << " mm² (unit assumed)." << endl;
+	}
+	showProgress( 1.0, "Apply Transformation" );
+
+	//! .) Can also affect the polylines - reset them too:
+	polyLinesChanged();
+
+	//! .) Write the transformation to the side-car file.
+	if( rSaveTransMat ) {
+		writeTransMatSideCar( rTrans );
+	}
+	showProgressStop( "Apply Transformation" );
+	return( true );
+}
+
 //! Apply a given transformation matrix Matrix4D all given Vertices.
 //!
 //! As this function uses the coordinate-vertex-array instead the Vertex
@@ -14027,37 +15752,47 @@ bool Mesh::applyTransformation( Matrix4D rTrans, set<Vertex*>* rSomeVerts, bool
 	polyLinesChanged();
 
 	//! .) Write the transformation to the side-car file, because HiWis tend to forget this.
-    if (rSaveTransMat){
-        std::filesystem::path transMatFName = getFileLocation().wstring() + getBaseName().wstring() + L"_transmat.txt";
-        ofstream transMatFile;
-        transMatFile.open( transMatFName, ios::app );
-        if( transMatFile.is_open() ) {
-            // Fetch time and date as string
-            std::time_t t = std::time(nullptr);
-            char mbstr[100];
-            std::strftime( mbstr, sizeof( mbstr ), "%A %c", std::localtime( &t ) );
-            // Fetch matrix as text
-            string matStr;
-            rTrans.getTextMatrix( &matStr );
-            // Write matrix
-            transMatFile << "#------------------------------------------------------" << endl;
-            transMatFile << "# Transformation applied to " << getBaseName() << endl;
-            transMatFile << "#......................................................" << endl;
-            transMatFile << matStr;
-            transMatFile << "#......................................................" << endl;
-            transMatFile << "# on " << mbstr << endl;
-            transMatFile << "#------------------------------------------------------" << endl;
-            transMatFile << endl;
-            transMatFile.close();
-            wcout << L"[Mesh::" << __FUNCTION__ << "] Transformation matrix written to: " << transMatFName << endl;
-        } else {
-            wcerr << L"[Mesh::" << __FUNCTION__ << "] ERROR: writing transformation matrix to: " << transMatFName << "!" << endl;
-        }
-    }
+	if( rSaveTransMat ) {
+		writeTransMatSideCar( rTrans );
+	}
 	showProgressStop("Apply Transformation");
 	return ( errCtr == 0 );
 }
 
+//! Appends the transformation matrix with date and time to the side-car file <basename>_transmat.txt
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::writeTransMatSideCar( Matrix4D rTrans ) {
+	std::filesystem::path transMatFName = getFileLocation().wstring() + getBaseName().wstring() + L"_transmat.txt";
+	ofstream transMatFile;
+	transMatFile.open( transMatFName, ios::app );
+	if( !transMatFile.is_open() ) {
+		wcerr << L"[Mesh::" << __FUNCTION__ << "] ERROR: writing transformation matrix to: " << transMatFName << "!" << endl;
+		return( false );
+	}
+	// Fetch time and date as string
+	std::time_t t = std::time(nullptr);
+	char mbstr[100];
+	std::tm localTime {};
+	getLocalTime( t, localTime );
+	std::strftime( mbstr, sizeof( mbstr ), "%A %c", &localTime );
+	// Fetch matrix as text
+	string matStr;
+	rTrans.getTextMatrix( &matStr );
+	// Write matrix
+	transMatFile << "#------------------------------------------------------" << endl;
+	transMatFile << "# Transformation applied to " << getBaseName() << endl;
+	transMatFile << "#......................................................" << endl;
+	transMatFile << matStr;
+	transMatFile << "#......................................................" << endl;
+	transMatFile << "# on " << mbstr << endl;
+	transMatFile << "#------------------------------------------------------" << endl;
+	transMatFile << endl;
+	transMatFile.close();
+	wcout << L"[Mesh::" << __FUNCTION__ << "] Transformation matrix written to: " << transMatFName << endl;
+	return( true );
+}
+
 //! Apply melting with sqrt(r^2-x^2-y^2) -- see also Vertex::applyMeltingSphere
 bool Mesh::applyMeltingSphere( double rRadius, double rRel ) {
 	cout << "[Mesh::" << __FUNCTION__ << "]" << endl;
@@ -14137,18 +15872,27 @@ bool Mesh::normalsVerticesChanged() {
 //! Resets all face normals and calculates them based on the current positions
 //! of the face vertices.
 //!
+//! The faces are processed in parallel by FaceReduction::reduce, so the area
+//! equals the one of Mesh::getFaceSurfSum.
+//!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::resetFaceNormals(
     double* rAreaTotal   //!< Optional pointer to double to retrieve the total area of the mesh.
 ) {
-	bool retVal = true;
-	double meshArea = 0.0;
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		retVal &= currFace->clearFlag( FLAG_NORMAL_SET );
-		meshArea += currFace->getAreaNormal();
-	}
+	PROFILE_SCOPE( "Mesh::resetFaceNormals" );
+	std::atomic<bool> retVal( true );
+	const FaceReduction::sResult areas = FaceReduction::reduce( getFaceNr(), 1, [this,&retVal]( uint64_t rFaceIdx, double* rArea ) {
+		Face* currFace = mFaces[rFaceIdx];
+		if( !currFace->clearFlag( FLAG_NORMAL_SET ) ) {
+			retVal = false;
+		}
+		rArea[0] = currFace->getAreaNormal();
+		if( !isfinite( rArea[0] ) || ( rArea[0] == 0.0 ) ) {
+			return( FaceReduction::FACE_DEGENERATE );
+		}
+		return( FaceReduction::FACE_VALID );
+	} );
+	const double meshArea = areas.mSums[0];
 	if( rAreaTotal != nullptr ) {
 		(*rAreaTotal) = meshArea;
 	}
@@ -14161,17 +15905,34 @@ bool Mesh::resetFaceNormals(
 //!
 //! @returns true, when all normals were (re)set. False otherwise.
 bool Mesh::resetVertexNormals() {
+	PROFILE_SCOPE( "Mesh::resetVertexNormals" );
 	bool retVal(true);
 	showProgressStart( __FUNCTION__ );
-	uint64_t errorCtr = 0;
-	uint64_t nrOfVertices = getVertexNr();
-	for( uint64_t vertexIdx = 0; vertexIdx < nrOfVertices; vertexIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertexIdx );
-		if( !currVertex->estNormalAvgAdjacentFaces() ) {
-			errorCtr++;
+	const unsigned int threadCount  = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize    = 16384; // Primitives per task.
+	// Face normals are computed on demand, which has to be done first
+	// as the faces are shared by the vertices processed in parallel.
+	const uint64_t faceCount  = getFaceNr();
+	const uint64_t faceChunks = ParallelFor::getChunkCount( faceCount, chunkSize );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			getFacePos( faceIdx )->getAreaNormal();
+		}
+	} );
+	showProgress( 0.5, __FUNCTION__ );
+	const uint64_t nrOfVertices = getVertexNr();
+	const uint64_t vertexChunks = ParallelFor::getChunkCount( nrOfVertices, chunkSize );
+	std::vector<uint64_t> chunkErrorCtrs( vertexChunks, 0 );
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, nrOfVertices );
+		for( uint64_t vertexIdx=rChunkIdx*chunkSize; vertexIdx<vertIdxEnd; vertexIdx++ ) {
+			if( !getVertexPos( vertexIdx )->estNormalAvgAdjacentFaces() ) {
+				chunkErrorCtrs[rChunkIdx]++;
+			}
 		}
-		showProgress( static_cast<double>(vertexIdx+1)/static_cast<double>(nrOfVertices), __FUNCTION__ );
-	}
+	} );
+	const uint64_t errorCtr = std::accumulate( chunkErrorCtrs.begin(), chunkErrorCtrs.end(), static_cast<uint64_t>( 0 ) );
 	showProgressStop( __FUNCTION__ );
 
 	if( errorCtr > 0 ) {
@@ -14718,6 +16479,7 @@ bool Mesh::fillPolyLines(
         uint64_t&         rFail,            //!< Returns number of holes failed to fill by libpsalm.
         uint64_t&         rSkipped          //!< Returns number of holes skipped.
 ) {
+	PROFILE_SCOPE( "Mesh::fillPolyLines" );
 #ifndef LIBPSALM
 	rFilled = 0;
 	rFail   = mPolyLines.size();
@@ -14994,12 +16756,7 @@ bool Mesh::exportPolyLinesCoords( filesystem::path rFileName, bool rWithNormals,
 		cout << "[Mesh::" << __FUNCTION__ << "] File open for writing: '" << rFileName << "'." << endl;
 	}
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -15116,12 +16873,7 @@ bool Mesh::exportPolyLinesCoordsProjected( filesystem::path rFileName, bool rWit
 	// Add extra rotation, e.g. from OpenGL
 	transMat *= Matrix4D( Vector3D( 0.0, 0.0, 0.0, 1.0 ), Vector3D( 0.0, 0.0, 1.0, 0.0 ), rAngleRot );
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -15219,12 +16971,7 @@ bool Mesh::exportPolyLinesFuncVals( filesystem::path rFileName ) {
 		cout << "[Mesh::" << __FUNCTION__ << "] File open for writing: '" << rFileName << "'." << endl;
 	}
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -15305,12 +17052,7 @@ bool Mesh::exportFuncVals( filesystem::path rFileName, bool rWithVertIdx ) {
 		cout << "[Mesh::" << __FUNCTION__ << "] File open for writing: '" << rFileName << "'." << endl;
 	}
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	std::stringstream strHeader;
@@ -15356,88 +17098,43 @@ bool Mesh::exportFuncVals( filesystem::path rFileName, bool rWithVertIdx ) {
 //! File extension: .txt or .mat
 //! assumes that the files are either single column with the functionValue, or double column with index + functionValue
 //! lines starting with # are treated as comments
+//! The file is parsed by multiple threads - see NumericTable.
 bool Mesh::importFuncValsFromFile(const filesystem::path& rFileName, bool withVertIdx)
 {
-	ifstream filestr(rFileName);
-
-	filestr.imbue(std::locale("C"));
-
-	if(!filestr.is_open())
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
+	PROFILE_SCOPE( "Mesh::importFuncValsFromFile" );
+	NumericTable table;
+	NumericTable::sParams params;
+	params.mFirstColIsIndex = withVertIdx;
+	params.mRowCount        = getVertexNr();
+	if( !table.read( rFileName, params ) )
 	{
 		LOG::error() << "[Mesh::" << __FUNCTION__ << "] Could not open file: '" << rFileName << "'.\n";
 		return false;
 	}
-
-	auto numVerts = getVertexNr();
-	std::string line;
-	double funcVal = 0.0;
-
-	//importing with index
-	if(withVertIdx)
+	if( table.getInvalidCount() > 0 )
 	{
-		uint64_t currIndex = 0;
-		while(std::getline(filestr, line))
-		{
-			if(!line.empty())
-			{
-				if(line[0] == '#')
-				{
-					continue;
-				}
-
-				std::stringstream lineStream(line);
-				if(!(lineStream >> currIndex >> funcVal))
-				{
-					LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains invalid values!\n";
-					continue;
-				}
-
-				if(currIndex < numVerts)
-				{
-					mVertices[currIndex]->setFuncValue(funcVal);
-				}
-				else
-				{
-					LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: function value out of range: " << currIndex << "\n";
-				}
-			}
-		}
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains " << table.getInvalidCount()
+		            << " invalid values e.g. in line " << table.getFirstInvalidLine() << "!\n";
 	}
-	//importing without index
-	else
+	if( table.getSkippedCount() > 0 )
 	{
-		uint64_t currIndex = 0;
-		while(std::getline(filestr, line))
-		{
-			if(!line.empty())
-			{
-				if(line[0] == '#')
-				{
-					continue;
-				}
-
-				if(currIndex > numVerts)
-				{
-					LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: function value out of range: " << currIndex - 1 << "\n";
-					break;
-				}
-				try {
-					funcVal = std::stod(line);
-				}
-				catch (std::exception& e)
-				{
-					LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains invalid values!\n";
-					mVertices[currIndex++]->setFuncValue(0);
-					continue;
-				}
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: " << table.getSkippedCount() << " function values out of range!\n";
+	}
+	if( table.getColCount() == 0 )
+	{
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains no function values!\n";
+		return false;
+	}
 
-				mVertices[currIndex++]->setFuncValue(funcVal);
-			}
+	for( uint64_t vertIdx = 0; vertIdx < table.getRowCount(); vertIdx++ )
+	{
+		if( table.isRowGiven( vertIdx ) )
+		{
+			mVertices[vertIdx]->setFuncValue( table.get( vertIdx, 0 ) );
 		}
 	}
 
-	filestr.close();
-
 	changedVertFuncVal();
 	return true;
 }
@@ -15447,88 +17144,51 @@ bool Mesh::importFuncValsFromFile(const filesystem::path& rFileName, bool withVe
 //! assumes that the files are either single column with the labels, or double column with index + label
 //! lines starting with # are treated as comments
 //! labels are expected to be integers
+//! The file is parsed by multiple threads - see NumericTable.
 bool Mesh::importLabelsFromFile(const filesystem::path& rFileName, bool withVertIdx)
 {
-    ifstream filestr(rFileName);
-
-    filestr.imbue(std::locale("C"));
-
-    if(!filestr.is_open())
-    {
-        LOG::error() << "[Mesh::" << __FUNCTION__ << "] Could not open file: '" << rFileName << "'.\n";
-        return false;
-    }
-
-    auto numVerts = getVertexNr();
-    std::string line;
-    uint64_t labelNr = 0;
-
-    //importing with index
-    if(withVertIdx)
-    {
-        uint64_t currIndex = 0;
-        while(std::getline(filestr, line))
-        {
-            if(!line.empty())
-            {
-                if(line[0] == '#')
-                {
-                    continue;
-                }
-
-                std::stringstream lineStream(line);
-                if(!(lineStream >> currIndex >> labelNr))
-                {
-                    LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains invalid values!\n";
-                    continue;
-                }
-                if(currIndex < numVerts)
-                {
-                    mVertices[currIndex]->setLabel(labelNr);
-                }
-                else
-                {
-                    LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: function value out of range: " << currIndex << "\n";
-                }
-            }
-        }
-    }
-    //importing without index
-    else
-    {
-        uint64_t currIndex = 0;
-        while(std::getline(filestr, line))
-        {
-            if(!line.empty())
-            {
-                if(line[0] == '#')
-                {
-                    continue;
-                }
-
-                if(currIndex > numVerts)
-                {
-                    LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: function value out of range: " << currIndex - 1 << "\n";
-                    break;
-                }
-                try {
-                    labelNr = std::stod(line);
-                }
-                catch (std::exception& e)
-                {
-                    LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains invalid values!\n";
-                    mVertices[currIndex++]->setLabel(0);
-                    continue;
-                }
+	PROFILE_SCOPE( "Mesh::importLabelsFromFile" );
+	NumericTable table;
+	NumericTable::sParams params;
+	params.mFirstColIsIndex = withVertIdx;
+	params.mRowCount        = getVertexNr();
+	if( !table.read( rFileName, params ) )
+	{
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] Could not open file: '" << rFileName << "'.\n";
+		return false;
+	}
+	if( table.getSkippedCount() > 0 )
+	{
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] warning: " << table.getSkippedCount() << " labels out of range!\n";
+	}
+	if( table.getColCount() == 0 )
+	{
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains no labels!\n";
+		return false;
+	}
 
-                mVertices[currIndex++]->setLabel(labelNr);
-            }
-        }
-    }
+	uint64_t labelsInvalid = 0;
+	for( uint64_t vertIdx = 0; vertIdx < table.getRowCount(); vertIdx++ )
+	{
+		if( !table.isRowGiven( vertIdx ) )
+		{
+			continue;
+		}
+		const double labelNr = table.get( vertIdx, 0 );
+		if( !( labelNr >= 0.0 ) || !isfinite( labelNr ) )
+		{
+			labelsInvalid++;
+			continue;
+		}
+		mVertices[vertIdx]->setLabel( static_cast<uint64_t>( labelNr ) );
+	}
+	if( labelsInvalid > 0 )
+	{
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] File: '" << rFileName << "' contains " << labelsInvalid << " invalid labels!\n";
+	}
 
-    filestr.close();
-    labelsChanged();
-    return true;
+	labelsChanged();
+	return true;
 }
 
 //! Imports the polylines coordinates from file
@@ -15733,12 +17393,7 @@ bool Mesh::exportFaceNormalAngles( filesystem::path filename ) {
 		cout << "[Mesh::exportFaceNormalAngles] File open for writing: '" << filename << "'." << endl;
 	}
 
-	time_t rawtime;
-	struct tm * timeinfo;
-
-	time( &rawtime );
-	timeinfo = localtime( &rawtime );
-	string timeInfoStr( asctime( timeinfo ) );
+	std::string timeInfoStr = getLocalTimeStr( time( nullptr ) );
 	timeInfoStr = timeInfoStr.substr( 0, timeInfoStr.length()-1 );
 
 	filestr << "# " << getFaceNr() << " Face normals from Mesh " << getBaseName() << endl;
@@ -15781,15 +17436,20 @@ void Mesh::cuneiformFigureLaTeX() {
 
 bool Mesh::getFaceSurfSum( double* rSurfSum ) {
 	//! Returns the sum of all the faces areas.
+	//! Summed in parallel by FaceReduction::reduce independent of the number of threads.
+	//! Faces having a zero or not-a-number area are skipped.
 	if( rSurfSum == nullptr ) {
 		return false;
 	}
-	(*rSurfSum) = 0.0;
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		(*rSurfSum) += currFace->getAreaNormal();
-	}
+	PROFILE_SCOPE( "Mesh::getFaceSurfSum" );
+	const FaceReduction::sResult areas = FaceReduction::reduce( getFaceNr(), 1, [this]( uint64_t rFaceIdx, double* rArea ) {
+		rArea[0] = mFaces[rFaceIdx]->getAreaNormal();
+		if( !isfinite( rArea[0] ) || ( rArea[0] == 0.0 ) ) {
+			return( FaceReduction::FACE_DEGENERATE );
+		}
+		return( FaceReduction::FACE_VALID );
+	} );
+	(*rSurfSum) = areas.mSums[0];
 	return true;
 }
 
@@ -16039,185 +17699,249 @@ bool Mesh::showInfoMeshHTML() {
 
 }
 
-//! Fetch mesh information as Numbers.
-//!
-//! See Mesh::dumpMeshInfo for plain text.
-//! See Mesh::getMeshInfoHTML for HTML.
-//!
-//! @returns false in case of an error. True otherwise.
-bool Mesh::getMeshInfoData(
-        MeshInfoData& rMeshInfos,
-        const bool    rAbsolutePath,
-        bool rWithSelfIntersectedFaces
-) {
-	// Initialize
-	rMeshInfos.reset();
-
-	// String data
-	if( rAbsolutePath ) {
-		rMeshInfos.mStrings[MeshInfoData::FILENAME]       = this->getFullName().string();
-	} else {
-		rMeshInfos.mStrings[MeshInfoData::FILENAME]       = this->getBaseName().string();
-	}
-	rMeshInfos.mStrings[MeshInfoData::MODEL_ID]           = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_ID );
-	rMeshInfos.mStrings[MeshInfoData::MODEL_MATERIAL]     = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_MATERIAL );
-	rMeshInfos.mStrings[MeshInfoData::MODEL_WEBREFERENCE] = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_REFERENCE_WEB );
-
-	// Primitive count
-	rMeshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL] = this->getVertexNr();
-	rMeshInfos.mCountULong[MeshInfoData::FACES_TOTAL]    = this->getFaceNr();
-
-	// Area and average resolution
-	double areaAcq = 0.0;
-	this->getFaceSurfSum( &areaAcq );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] = std::round( areaAcq );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] /= 100.0; // cm^2
-	
-	// Fetch Bounding Box
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_X]  = static_cast<double>( std::round( mMinX*10000.0 ) )/10000.0;
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_Y]  = static_cast<double>( std::round( mMinY*10000.0 ) )/10000.0;
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_Z]  = static_cast<double>( std::round( mMinZ*10000.0 ) )/10000.0;
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_X]  = static_cast<double>( std::round( mMaxX*10000.0 ) )/10000.0;
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_Y]  = static_cast<double>( std::round( mMaxY*10000.0 ) )/10000.0;
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_Z]  = static_cast<double>( std::round( mMaxZ*10000.0 ) )/10000.0;
-	Vector3D bbDim;
-	this->getBoundingBoxSize( bbDim );
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_WIDTH]  = static_cast<double>( std::round( bbDim.getX()*1.0 ) )/10.0; // cm
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_HEIGHT] = static_cast<double>( std::round( bbDim.getY()*1.0 ) )/10.0; // cm
-	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_THICK]  = static_cast<double>( std::round( bbDim.getZ()*1.0 ) )/10.0; // cm
-
-	// Volume
-	double volDXYZ[3];
-	this->getMeshVolumeDivergence( volDXYZ[0], volDXYZ[1], volDXYZ[2] );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DX] = volDXYZ[0];
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DY] = volDXYZ[1];
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DZ] = volDXYZ[2];
+namespace {
+	//! Counters of Mesh::getMeshInfoData accumulated per chunk or per part of a mesh.
+	struct sMeshInfoCounts {
+		uint64_t mCountULong[MeshInfoData::ULONG_COUNT] = { 0 };
+		double   mAreaSmallest = std::numeric_limits<double>::infinity();
+		double   mAreaLargest  = 0.0;
+
+		//! Adds the counters of another chunk.
+		void merge( const sMeshInfoCounts& rOther ) {
+			for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+				mCountULong[i] += rOther.mCountULong[i];
+			}
+			mAreaSmallest = std::min( mAreaSmallest, rOther.mAreaSmallest );
+			mAreaLargest  = std::max( mAreaLargest,  rOther.mAreaLargest );
+		}
 
-	double progressSteps = static_cast<double>( getVertexNr() + getFaceNr() );
-	showProgressStart( "Mesh information" );
+		//! Adds the counters and sets the area range of the mesh information.
+		void copyTo( MeshInfoData& rMeshInfos ) const {
+			for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+				rMeshInfos.mCountULong[i] += mCountULong[i];
+			}
+			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = mAreaSmallest;
+			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST]  = mAreaLargest;
+		}
+	};
 
-	Vertex* currVertex;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		if( currVertex->isNotANumber() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NAN]++;
+	//! Counts the properties of a vertex for Mesh::getMeshInfoData - one fused pass of the 1-ring.
+	//! @returns true, when the vertex is along a border.
+	bool countMeshInfoVertex( Vertex* rVertex, sMeshInfoCounts& rCounts ) {
+		uint64_t* counts = rCounts.mCountULong;
+		if( rVertex->isNotANumber() ) {
+			counts[MeshInfoData::VERTICES_NAN]++;
 		}
-		double vertexNormalLen = currVertex->getNormalLen();
+		double vertexNormalLen = rVertex->getNormalLen();
 		if( !isnormal( vertexNormalLen ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NORMAL_LEN_NORMAL]++;
+			counts[MeshInfoData::VERTICES_NORMAL_LEN_NORMAL]++;
 		}
 		// Mesh structure:
-		if( currVertex->isSolo() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SOLO]++;
-		}
-		if( currVertex->isBorder() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_BORDER]++;
-		}
-		if( currVertex->isNonManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NONMANIFOLD]++;
-		}
-		if( currVertex->isDoubleCone() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SINGULAR]++;
-		}
-		if( currVertex->isPartOfZeroFace() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_PART_OF_ZERO_FACE]++;
-		}
-		if( currVertex->isInverse() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_ON_INVERTED_EDGE]++;
-		}
+		if( rVertex->isSolo() ) {
+			counts[MeshInfoData::VERTICES_SOLO]++;
+		}
+		Vertex::s1RingChecks ringChecks;
+		rVertex->get1RingChecks( ringChecks );
+		counts[MeshInfoData::VERTICES_BORDER]            += ringChecks.mBorder;
+		counts[MeshInfoData::VERTICES_NONMANIFOLD]       += ringChecks.mNonManifold;
+		counts[MeshInfoData::VERTICES_SINGULAR]          += ringChecks.mDoubleCone;
+		counts[MeshInfoData::VERTICES_PART_OF_ZERO_FACE] += ringChecks.mPartOfZeroFace;
+		counts[MeshInfoData::VERTICES_ON_INVERTED_EDGE]  += ringChecks.mInverse;
 		// Special flags and conditions:
-		if( currVertex->getFlag( FLAG_BELONGS_TO_POLYLINE ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_POLYLINE]++;
+		if( rVertex->getFlag( Primitive::FLAG_BELONGS_TO_POLYLINE ) ) {
+			counts[MeshInfoData::VERTICES_POLYLINE]++;
 		}
-		if( currVertex->getFlag( FLAG_SYNTHETIC ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SYNTHETIC]++;
+		if( rVertex->getFlag( Primitive::FLAG_SYNTHETIC ) ) {
+			counts[MeshInfoData::VERTICES_SYNTHETIC]++;
 		}
-		if( currVertex->getFlag( FLAG_MANUAL ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_MANUAL]++;
+		if( rVertex->getFlag( Primitive::FLAG_MANUAL ) ) {
+			counts[MeshInfoData::VERTICES_MANUAL]++;
 		}
-		if( currVertex->getFlag( FLAG_CIRCLE_CENTER ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_CIRCLE_CENTER]++;
+		if( rVertex->getFlag( Primitive::FLAG_CIRCLE_CENTER ) ) {
+			counts[MeshInfoData::VERTICES_CIRCLE_CENTER]++;
 		}
-		if( currVertex->getFlag( FLAG_SELECTED ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SELECTED]++;
+		if( rVertex->getFlag( Primitive::FLAG_SELECTED ) ) {
+			counts[MeshInfoData::VERTICES_SELECTED]++;
 		}
-		// Function value related:
-		if( currVertex->isFuncValFinite() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_FINITE]++;
+		// Function value related - sets the flags of this vertex only:
+		if( rVertex->isFuncValFinite() ) {
+			counts[MeshInfoData::VERTICES_FUNCVAL_FINITE]++;
 		}
-		if( currVertex->isFuncValLocalMinimum() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MIN]++;
+		if( rVertex->isFuncValLocalMinimum() ) {
+			counts[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MIN]++;
 		}
-		if( currVertex->isFuncValLocalMaximum() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MAX]++;
+		if( rVertex->isFuncValLocalMaximum() ) {
+			counts[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MAX]++;
 		}
-		showProgress( static_cast<double>(vertIdx)/progressSteps, "Mesh information" );
+		return( ringChecks.mBorder );
 	}
 
-	// Set initial values
-	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = std::numeric_limits<double>::infinity();
-	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST]  = 0.0;
-
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		if( currFace->isBorder() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER]++;
+	//! Counts the properties of a face for Mesh::getMeshInfoData.
+	//! The border state of the vertices is given by their position within the vector of the Mesh.
+	void countMeshInfoFace( Face* rFace, const std::vector<uint8_t>& rVertexIsBorder, const PrimitivePositions<Vertex>& rVertexPositions, sMeshInfoCounts& rCounts ) {
+		uint64_t* counts = rCounts.mCountULong;
+		if( rFace->isBorder() ) {
+			counts[MeshInfoData::FACES_BORDER]++;
 		}
 		// Special border configurations
 		unsigned int nrEdgesBorder = 0;
-		currFace->hasBorderEdges( nrEdgesBorder );
-		if( nrEdgesBorder == 3 ) { // Same as: if( currFace->isSolo() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_SOLO]++;
+		rFace->hasBorderEdges( nrEdgesBorder );
+		if( nrEdgesBorder == 3 ) { // Same as: if( rFace->isSolo() ) {
+			counts[MeshInfoData::FACES_SOLO]++;
 		}
+		// Same as: rFace->hasBorderVertex( nrVerticesBorder );
 		unsigned int nrVerticesBorder = 0;
-		currFace->hasBorderVertex( nrVerticesBorder );
+		for( const Vertex* vertex : { rFace->getVertA(), rFace->getVertB(), rFace->getVertC() } ) {
+			const uint64_t vertexPos = rVertexPositions.get( vertex );
+			if( ( vertexPos < rVertexIsBorder.size() ) && rVertexIsBorder[vertexPos] ) {
+				nrVerticesBorder++;
+			}
+		}
 		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 0 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_BRDIGE_TRICONN]++;
+			counts[MeshInfoData::FACES_BORDER_BRDIGE_TRICONN]++;
 		}
 		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 1 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_BRDIGE]++;
+			counts[MeshInfoData::FACES_BORDER_BRDIGE]++;
 		}
 		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 2 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_DANGLING]++;
+			counts[MeshInfoData::FACES_BORDER_DANGLING]++;
 		}
 		if( nrVerticesBorder == 3 ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_THREE_VERTICES]++;
+			counts[MeshInfoData::FACES_BORDER_THREE_VERTICES]++;
 		}
 		// ...
-		if( currFace->isManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_MANIFOLD]++;
+		if( rFace->isManifold() ) {
+			counts[MeshInfoData::FACES_MANIFOLD]++;
 		}
-		if( currFace->isNonManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_NONMANIFOLD]++;
+		if( rFace->isNonManifold() ) {
+			counts[MeshInfoData::FACES_NONMANIFOLD]++;
 		}
-		if( currFace->getFlag( FLAG_FACE_STICKY ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_STICKY]++;
+		if( rFace->getFlag( Primitive::FLAG_FACE_STICKY ) ) {
+			counts[MeshInfoData::FACES_STICKY]++;
 		}
-		if( currFace->getFlag( FLAG_FACE_ZERO_AREA ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_ZEROAREA]++;
+		if( rFace->getFlag( Primitive::FLAG_FACE_ZERO_AREA ) ) {
+			counts[MeshInfoData::FACES_ZEROAREA]++;
 		}
-		if( currFace->isInverse() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_INVERTED]++;
+		if( rFace->isInverse() ) {
+			counts[MeshInfoData::FACES_INVERTED]++;
 		}
 		unsigned int synthVerticesNr = _NOT_A_NUMBER_UINT_;
-		currFace->hasSyntheticVertex( synthVerticesNr );
+		rFace->hasSyntheticVertex( synthVerticesNr );
 		if( synthVerticesNr >= 3 ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_WITH_SYNTH_VERTICES]++;
+			counts[MeshInfoData::FACES_WITH_SYNTH_VERTICES]++;
 		}
-		if( currFace->getFlag( FLAG_SELECTED ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_SELECTED]++;
+		if( rFace->getFlag( Primitive::FLAG_SELECTED ) ) {
+			counts[MeshInfoData::FACES_SELECTED]++;
 		}
 		// floating point properties
-		double faceArea = currFace->getAreaNormal();
-		if( faceArea < rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] ) {
-			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = faceArea;
+		double faceArea = rFace->getAreaNormal();
+		if( faceArea < rCounts.mAreaSmallest ) {
+			rCounts.mAreaSmallest = faceArea;
 		}
-		if( faceArea > rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST] ) {
-			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST] = faceArea;
+		if( faceArea > rCounts.mAreaLargest ) {
+			rCounts.mAreaLargest = faceArea;
 		}
-		showProgress( static_cast<double>( faceIdx+getVertexNr() )/progressSteps, "Mesh information" );
 	}
+
+	//! Sets the rounded area, bounding box and volume of the mesh information.
+	void setMeshInfoGeometry( MeshInfoData& rMeshInfos, double rArea, const std::array<double,6>& rBoundingBox, const double* rVolumeDXYZ ) {
+		rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] = std::round( rArea );
+		rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] /= 100.0; // cm^2
+
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_X]  = static_cast<double>( std::round( rBoundingBox[0]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_Y]  = static_cast<double>( std::round( rBoundingBox[1]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_Z]  = static_cast<double>( std::round( rBoundingBox[2]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_X]  = static_cast<double>( std::round( rBoundingBox[3]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_Y]  = static_cast<double>( std::round( rBoundingBox[4]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MAX_Z]  = static_cast<double>( std::round( rBoundingBox[5]*10000.0 ) )/10000.0;
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_WIDTH]  = static_cast<double>( std::round( ( rBoundingBox[3] - rBoundingBox[0] )*1.0 ) )/10.0; // cm
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_HEIGHT] = static_cast<double>( std::round( ( rBoundingBox[4] - rBoundingBox[1] )*1.0 ) )/10.0; // cm
+		rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_THICK]  = static_cast<double>( std::round( ( rBoundingBox[5] - rBoundingBox[2] )*1.0 ) )/10.0; // cm
+
+		rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DX] = rVolumeDXYZ[0];
+		rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DY] = rVolumeDXYZ[1];
+		rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DZ] = rVolumeDXYZ[2];
+	}
+}
+
+//! Fetch mesh information as Numbers.
+//!
+//! See Mesh::dumpMeshInfo for plain text.
+//! See Mesh::getMeshInfoHTML for HTML.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::getMeshInfoData(
+        MeshInfoData& rMeshInfos,
+        const bool    rAbsolutePath,
+        bool rWithSelfIntersectedFaces
+) {
+	PROFILE_SCOPE( "Mesh::getMeshInfoData" );
+	// Initialize
+	rMeshInfos.reset();
+
+	// String data
+	if( rAbsolutePath ) {
+		rMeshInfos.mStrings[MeshInfoData::FILENAME]       = this->getFullName().string();
+	} else {
+		rMeshInfos.mStrings[MeshInfoData::FILENAME]       = this->getBaseName().string();
+	}
+	rMeshInfos.mStrings[MeshInfoData::MODEL_ID]           = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_ID );
+	rMeshInfos.mStrings[MeshInfoData::MODEL_MATERIAL]     = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_MATERIAL );
+	rMeshInfos.mStrings[MeshInfoData::MODEL_WEBREFERENCE] = this->getModelMetaDataRef().getModelMetaString( ModelMetaData::META_REFERENCE_WEB );
+
+	// Primitive count
+	rMeshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL] = this->getVertexNr();
+	rMeshInfos.mCountULong[MeshInfoData::FACES_TOTAL]    = this->getFaceNr();
+
+	// Area, bounding box and volume
+	double areaAcq = 0.0;
+	this->getFaceSurfSum( &areaAcq );
+	double volDXYZ[3];
+	this->getMeshVolumeDivergence( volDXYZ[0], volDXYZ[1], volDXYZ[2] );
+	setMeshInfoGeometry( rMeshInfos, areaAcq, { mMinX, mMinY, mMinZ, mMaxX, mMaxY, mMaxZ }, volDXYZ );
+
+	showProgressStart( "Mesh information" );
+
+	// Required to look up the border flag of the vertices of a face.
+	const PrimitivePositions<Vertex> vertexPositions( mVertices );
+
+	// Counters are accumulated per chunk and merged afterwards.
+	// Integer sums, minimum and maximum do not depend on the order of merging.
+	const unsigned int threadCount   = ParallelFor::getThreadCount();
+	const uint64_t     infoChunkSize = 16384; // Primitives per task.
+
+	// Vertices - one fused pass of the 1-ring per vertex:
+	const uint64_t vertexChunks = ParallelFor::getChunkCount( getVertexNr(), infoChunkSize );
+	std::vector<sMeshInfoCounts> vertexChunkCounts( vertexChunks );
+	std::vector<uint8_t> vertexIsBorder( getVertexNr(), false );
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min( ( rChunkIdx + 1 ) * infoChunkSize, getVertexNr() );
+		for( uint64_t vertIdx=rChunkIdx*infoChunkSize; vertIdx<vertIdxEnd; vertIdx++ ) {
+			vertexIsBorder[vertIdx] = countMeshInfoVertex( getVertexPos( vertIdx ), vertexChunkCounts[rChunkIdx] );
+		}
+	} );
+	showProgress( 0.5, "Mesh information" );
+
+	// Faces - the border state of the vertices is taken from the pass above:
+	const uint64_t faceChunks = ParallelFor::getChunkCount( getFaceNr(), infoChunkSize );
+	std::vector<sMeshInfoCounts> faceChunkCounts( faceChunks );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * infoChunkSize, getFaceNr() );
+		for( uint64_t faceIdx=rChunkIdx*infoChunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			countMeshInfoFace( getFacePos( faceIdx ), vertexIsBorder, vertexPositions, faceChunkCounts[rChunkIdx] );
+		}
+	} );
+
+	// Merge the counters of the chunks
+	sMeshInfoCounts meshCounts;
+	for( const std::vector<sMeshInfoCounts>* chunkCountsAll : { &vertexChunkCounts, &faceChunkCounts } ) {
+		for( const sMeshInfoCounts& chunkCounts : *chunkCountsAll ) {
+			meshCounts.merge( chunkCounts );
+		}
+	}
+	meshCounts.copyTo( rMeshInfos );
+	showProgress( 1.0, "Mesh information" );
+
     //detect self itersection
     if(rWithSelfIntersectedFaces){
         // Octree required - time consuming
@@ -16244,6 +17968,227 @@ bool Mesh::getMeshInfoData(
 }
 
 
+//! Write the labeled connected components into one file per label named
+//! <file>.comp.<label>.<extension> with optional information per component.
+//!
+//! Faces having vertices with the same label are bucketed in one counting-sort pass.
+//! The components are written concurrently from the buckets with vertex indices
+//! mapped to each bucket, so neither the faces are searched per label nor a Mesh
+//! is built per component. The information is computed from the same buckets using
+//! the connectivity of this Mesh, which equals the connectivity of the component,
+//! when all faces adjacent to its vertices belong to the component. Otherwise e.g.
+//! for labels imported from a file, the information is fetched from a Mesh built
+//! for the component.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::writeLabeledComponents(
+                std::vector<sLabeledComponent>& rComponents,   //!< Components written in ascending order of the labels.
+                bool                            rWithMeshInfo  //!< Compute the information per component.
+) {
+	PROFILE_SCOPE( "Mesh::writeLabeledComponents" );
+	rComponents.clear();
+	const uint64_t     vertexCount = getVertexNr();
+	const uint64_t     faceCount   = getFaceNr();
+	const unsigned int threadCount = ParallelFor::getThreadCount();
+	const uint64_t     chunkSize   = 16384; // Primitives per task.
+	const uint64_t     faceChunks  = ParallelFor::getChunkCount( faceCount, chunkSize );
+	const uint64_t     noBucket    = std::numeric_limits<uint64_t>::max();
+
+	// Indices have to match the positions for the remapping and the border flags:
+	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
+		mVertices[vertIdx]->setIndex( vertIdx );
+	}
+	for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+		mFaces[faceIdx]->setIndex( faceIdx );
+	}
+	const PrimitivePositions<Vertex> vertexPositions( mVertices );
+
+	// (1) Labels of the faces and the labels present:
+	std::vector<uint64_t> faceBucket( faceCount, noBucket );
+	std::vector<std::vector<uint64_t>> chunkLabels( faceChunks );
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		std::vector<uint64_t>& labelsInChunk = chunkLabels[rChunkIdx];
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			uint64_t labelNr;
+			if( mFaces[faceIdx]->getLabel( labelNr ) ) {
+				faceBucket[faceIdx] = labelNr;
+				labelsInChunk.push_back( labelNr );
+			}
+		}
+		std::sort( labelsInChunk.begin(), labelsInChunk.end() );
+		labelsInChunk.erase( std::unique( labelsInChunk.begin(), labelsInChunk.end() ), labelsInChunk.end() );
+	} );
+	std::vector<uint64_t> labelNrs;
+	for( const std::vector<uint64_t>& labelsInChunk : chunkLabels ) {
+		labelNrs.insert( labelNrs.end(), labelsInChunk.begin(), labelsInChunk.end() );
+	}
+	std::vector<std::vector<uint64_t>>().swap( chunkLabels );
+	std::sort( labelNrs.begin(), labelNrs.end() );
+	labelNrs.erase( std::unique( labelNrs.begin(), labelNrs.end() ), labelNrs.end() );
+	const uint64_t bucketCount = labelNrs.size();
+	if( bucketCount == 0 ) {
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] No faces with labeled vertices present!\n";
+		return( false );
+	}
+
+	// (2) Counting sort of the faces by the index of their label:
+	ParallelFor::forEachChunk( faceChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t faceIdxEnd = std::min( ( rChunkIdx + 1 ) * chunkSize, faceCount );
+		for( uint64_t faceIdx=rChunkIdx*chunkSize; faceIdx<faceIdxEnd; faceIdx++ ) {
+			if( faceBucket[faceIdx] != noBucket ) {
+				faceBucket[faceIdx] = std::lower_bound( labelNrs.begin(), labelNrs.end(), faceBucket[faceIdx] ) - labelNrs.begin();
+			}
+		}
+	} );
+	std::vector<uint64_t> bucketOffsets( bucketCount + 1, 0 );
+	for( const uint64_t bucketIdx : faceBucket ) {
+		if( bucketIdx != noBucket ) {
+			bucketOffsets[bucketIdx+1]++;
+		}
+	}
+	for( uint64_t bucketIdx=0; bucketIdx<bucketCount; bucketIdx++ ) {
+		bucketOffsets[bucketIdx+1] += bucketOffsets[bucketIdx];
+	}
+	std::vector<uint64_t> bucketFaces( bucketOffsets[bucketCount] );
+	{
+		std::vector<uint64_t> bucketFill( bucketOffsets.begin(), bucketOffsets.end()-1 );
+		for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+			if( faceBucket[faceIdx] != noBucket ) {
+				bucketFaces[bucketFill[faceBucket[faceIdx]]++] = faceIdx;
+			}
+		}
+	}
+
+	// (3) Write the components in parallel:
+	rComponents.resize( bucketCount );
+	std::vector<uint8_t> vertexIsBorder( rWithMeshInfo ? vertexCount : 0, false );
+	std::vector<uint8_t> bucketIsClosed( bucketCount, false );
+	ParallelFor::forEachChunk( bucketCount, threadCount, [&]( uint64_t rBucketIdx ) {
+		sLabeledComponent& component = rComponents[rBucketIdx];
+		component.mLabelNr = labelNrs[rBucketIdx];
+		component.mFileName = getFullName();
+		// The following looks wired due to Windows build
+		const std::string oriExtension = component.mFileName.extension().string();
+		component.mFileName.replace_extension( std::filesystem::path( "comp." + std::to_string( component.mLabelNr ) + oriExtension ) );
+
+		// Vertices in the order of this Mesh:
+		const uint64_t* facesInBucket = bucketFaces.data() + bucketOffsets[rBucketIdx];
+		const uint64_t  facesInBucketNr = bucketOffsets[rBucketIdx+1] - bucketOffsets[rBucketIdx];
+		std::vector<uint64_t> vertsInBucket;
+		vertsInBucket.reserve( facesInBucketNr * 3 );
+		for( uint64_t i=0; i<facesInBucketNr; i++ ) {
+			const Face* currFace = mFaces[facesInBucket[i]];
+			vertsInBucket.push_back( currFace->getVertA()->getIndex() );
+			vertsInBucket.push_back( currFace->getVertB()->getIndex() );
+			vertsInBucket.push_back( currFace->getVertC()->getIndex() );
+		}
+		std::sort( vertsInBucket.begin(), vertsInBucket.end() );
+		vertsInBucket.erase( std::unique( vertsInBucket.begin(), vertsInBucket.end() ), vertsInBucket.end() );
+		auto mapVertIdx = [&vertsInBucket]( uint64_t rVertIdx ) {
+			return( static_cast<uint64_t>( std::lower_bound( vertsInBucket.begin(), vertsInBucket.end(), rVertIdx ) - vertsInBucket.begin() ) );
+		};
+
+		std::vector<sVertexProperties> vertexProps( vertsInBucket.size() );
+		for( uint64_t i=0; i<vertsInBucket.size(); i++ ) {
+			mVertices[vertsInBucket[i]]->copyVertexPropsTo( vertexProps[i] );
+		}
+		std::vector<sFaceProperties> faceProps( facesInBucketNr );
+		for( uint64_t i=0; i<facesInBucketNr; i++ ) {
+			mFaces[facesInBucket[i]]->copyFacePropsTo( faceProps[i] );
+			for( uint64_t& vertIdx : faceProps[i].vertexIndices ) {
+				vertIdx = mapVertIdx( vertIdx );
+			}
+		}
+		component.mVertexCount = vertexProps.size();
+		component.mFaceCount   = faceProps.size();
+		MeshSeedExt componentSeed;
+		component.mWritten = writeFilePrimPropsDetached( component.mFileName, vertexProps, faceProps, componentSeed );
+		if( !rWithMeshInfo ) {
+			return;
+		}
+
+		// Information, when the component is closed with respect to the faces of its vertices:
+		std::vector<Face*> adjacentFaces;
+		for( const uint64_t vertIdx : vertsInBucket ) {
+			adjacentFaces.clear();
+			mVertices[vertIdx]->getFaces( &adjacentFaces );
+			for( const Face* adjacentFace : adjacentFaces ) {
+				if( faceBucket[adjacentFace->getIndex()] != rBucketIdx ) {
+					return;
+				}
+			}
+		}
+		bucketIsClosed[rBucketIdx] = true;
+		MeshInfoData& meshInfos = component.mMeshInfo;
+		meshInfos.reset();
+		meshInfos.mStrings[MeshInfoData::FILENAME]           = component.mFileName.string();
+		meshInfos.mStrings[MeshInfoData::MODEL_ID]           = getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_ID );
+		meshInfos.mStrings[MeshInfoData::MODEL_MATERIAL]     = getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_MATERIAL );
+		meshInfos.mStrings[MeshInfoData::MODEL_WEBREFERENCE] = getModelMetaDataRef().getModelMetaString( ModelMetaData::META_REFERENCE_WEB );
+		meshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL]  = vertexProps.size();
+		meshInfos.mCountULong[MeshInfoData::FACES_TOTAL]     = faceProps.size();
+		std::array<double,6> boundingBox = { +DBL_MAX, +DBL_MAX, +DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_MAX };
+		sMeshInfoCounts componentCounts;
+		for( const uint64_t vertIdx : vertsInBucket ) {
+			Vertex* currVertex = mVertices[vertIdx];
+			vertexIsBorder[vertIdx] = countMeshInfoVertex( currVertex, componentCounts );
+			boundingBox[0] = std::min( boundingBox[0], currVertex->getX() );
+			boundingBox[1] = std::min( boundingBox[1], currVertex->getY() );
+			boundingBox[2] = std::min( boundingBox[2], currVertex->getZ() );
+			boundingBox[3] = std::max( boundingBox[3], currVertex->getX() );
+			boundingBox[4] = std::max( boundingBox[4], currVertex->getY() );
+			boundingBox[5] = std::max( boundingBox[5], currVertex->getZ() );
+		}
+		for( uint64_t i=0; i<facesInBucketNr; i++ ) {
+			countMeshInfoFace( mFaces[facesInBucket[i]], vertexIsBorder, vertexPositions, componentCounts );
+		}
+		// Area and volume summed like Mesh::getFaceSurfSum and Mesh::getMeshVolumeDivergence,
+		// but with one thread as the components are already processed in parallel.
+		const FaceReduction::sResult areaVolume = FaceReduction::reduce( facesInBucketNr, 4, [this,facesInBucket]( uint64_t rFaceIdx, double* rAreaVolume ) {
+			Face* currFace = mFaces[facesInBucket[rFaceIdx]];
+			rAreaVolume[0] = currFace->getAreaNormal();
+			if( !currFace->getVolumeDivergence( rAreaVolume[1], rAreaVolume[2], rAreaVolume[3] ) ) {
+				return( FaceReduction::FACE_DEGENERATE );
+			}
+			return( FaceReduction::FACE_VALID );
+		}, 1 );
+		const double areaAcq = areaVolume.mSums[0];
+		double volDXYZ[3] = { areaVolume.mSums[1], areaVolume.mSums[2], areaVolume.mSums[3] };
+		componentCounts.copyTo( meshInfos );
+		setMeshInfoGeometry( meshInfos, areaAcq, boundingBox, volDXYZ );
+		meshInfos.mCountULong[MeshInfoData::FACES_SELFINTERSECTED] = -1;
+		meshInfos.mCountULong[MeshInfoData::CONNECTED_COMPONENTS]  = component.mLabelNr;
+	} );
+
+	// (4) Information of components sharing vertices with other faces:
+	if( rWithMeshInfo ) {
+		for( uint64_t bucketIdx=0; bucketIdx<bucketCount; bucketIdx++ ) {
+			if( bucketIsClosed[bucketIdx] ) {
+				continue;
+			}
+			std::set<Face*> facesWithLabel;
+			for( uint64_t i=bucketOffsets[bucketIdx]; i<bucketOffsets[bucketIdx+1]; i++ ) {
+				facesWithLabel.insert( mFaces[bucketFaces[i]] );
+			}
+			Mesh componentMesh( &facesWithLabel );
+			componentMesh.getModelMetaDataRef().setModelMeta( getModelMetaDataRef() );
+			componentMesh.getMeshInfoData( rComponents[bucketIdx].mMeshInfo, true );
+			rComponents[bucketIdx].mMeshInfo.mStrings[MeshInfoData::FILENAME] = rComponents[bucketIdx].mFileName.string();
+		}
+		// Restore the indices changed by the construction of the meshes.
+		for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
+			mVertices[vertIdx]->setIndex( vertIdx );
+		}
+	}
+
+	const uint64_t componentsWritten = std::count_if( rComponents.begin(), rComponents.end(), []( const sLabeledComponent& rComponent ) {
+		return( rComponent.mWritten );
+	} );
+	LOG::info() << "[Mesh::" << __FUNCTION__ << "] Components written: " << componentsWritten << " of " << bucketCount << "\n";
+	return( componentsWritten == bucketCount );
+}
+
 //! Dump information about the mesh to stdout.
 void Mesh::dumpMeshInfo( bool avoidSlow //!< discards some information requiring a lot of computing time.
     ) {
@@ -16540,6 +18485,7 @@ bool Mesh::getSelectedPositionDistancesHTML( std::string &rDistanceText ) {
 //!     Label Id ............... Corresponds to the line segment of the positions (TODO!)
 //! @returns false in case of an error. True otherwise.
 bool Mesh::getSelectedPositionCircleCenters( vector<Vertex*>* rCenterVertices ) {
+	const FuncValWriteScope funcValWriteScope( mFuncValGeneration );
 	// Sanity check
 	if( rCenterVertices == nullptr ) {
 		return false;
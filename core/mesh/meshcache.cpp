@@ -0,0 +1,282 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/meshcache.h>
+
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+namespace {
+	const char     gCacheMagic[8]   { 'G', 'M', 'C', 'A', 'C', 'H', 'E', '\0' };
+	const uint32_t gCacheVersion    = 1;
+	const uint32_t gByteOrderMark   = 0x01020304;  //!< Rejects caches written on systems with different byte order.
+	const uint64_t gSectionAlign    = 64;
+
+	//! Header at the beginning of the file.
+	struct sFileHeader {
+		char     mMagic[8];
+		uint32_t mVersion;
+		uint32_t mByteOrderMark;
+		uint64_t mSourceSize;
+		int64_t  mSourceModTime;
+		uint64_t mSourceHash;
+		uint64_t mVertexCount;
+		uint64_t mFaceCount;
+		uint64_t mFeatureVecLen;
+		uint64_t mSectionCount;
+		uint64_t mSectionOffsets[MeshCache::SECTION_COUNT];
+		uint64_t mSectionSizes[MeshCache::SECTION_COUNT];
+	};
+
+	//! @returns the given offset rounded up to the alignment of the sections.
+	uint64_t alignOffset( uint64_t rOffset ) {
+		return( ( rOffset + gSectionAlign - 1 ) / gSectionAlign * gSectionAlign );
+	}
+}
+
+std::atomic<int> MeshCache::mMode( MeshCache::CACHE_OFF );
+
+//! Sets the usage of caches for all meshes constructed from files afterwards.
+void MeshCache::setMode( eMode rMode ) {
+	mMode.store( rMode );
+}
+
+//! @returns the usage of caches for meshes constructed from files.
+MeshCache::eMode MeshCache::getMode() {
+	return( static_cast<eMode>( mMode.load() ) );
+}
+
+//! @returns the name of the cache next to the given source file e.g. 'mesh.ply.gmcache'.
+std::filesystem::path MeshCache::getSidecarName( const std::filesystem::path& rSourceFile ) {
+	std::filesystem::path sidecarName( rSourceFile );
+	sidecarName += ".gmcache";
+	return( sidecarName );
+}
+
+//! Sets the number of primitives for writing.
+void MeshCache::setCounts( uint64_t rVertexCount, uint64_t rFaceCount, uint64_t rFeatureVecLen ) {
+	mVertexCount   = rVertexCount;
+	mFaceCount     = rFaceCount;
+	mFeatureVecLen = rFeatureVecLen;
+}
+
+//! Sets the data of a section for writing. The data is not copied and has to be kept until write is called.
+void MeshCache::setSection( eSections rSection, const void* rData, uint64_t rByteCount ) {
+	mSectionData[rSection]  = rData;
+	mSectionSizes[rSection] = rByteCount;
+}
+
+//! Writes the sections given by setSection together with the size, the modification
+//! time and the hash of the source. The file is replaced atomically, so concurrent
+//! readers see either the old or the new cache.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshCache::write(
+                const std::filesystem::path& rCacheFile,
+                const std::filesystem::path& rSourceFile
+) const {
+	PROFILE_SCOPE( "MeshCache::write" );
+	sFileHeader fileHeader {};
+	std::memcpy( fileHeader.mMagic, gCacheMagic, sizeof( gCacheMagic ) );
+	fileHeader.mVersion       = gCacheVersion;
+	fileHeader.mByteOrderMark = gByteOrderMark;
+	if( !getSourceInfo( rSourceFile, fileHeader.mSourceSize, fileHeader.mSourceModTime ) ||
+	    !getSourceHash( rSourceFile, fileHeader.mSourceHash ) ) {
+		return( false );
+	}
+	fileHeader.mVertexCount   = mVertexCount;
+	fileHeader.mFaceCount     = mFaceCount;
+	fileHeader.mFeatureVecLen = mFeatureVecLen;
+	fileHeader.mSectionCount  = SECTION_COUNT;
+	uint64_t currOffset = alignOffset( sizeof( sFileHeader ) );
+	for( int sectionIdx=0; sectionIdx<SECTION_COUNT; sectionIdx++ ) {
+		fileHeader.mSectionOffsets[sectionIdx] = currOffset;
+		fileHeader.mSectionSizes[sectionIdx]   = mSectionSizes[sectionIdx];
+		currOffset = alignOffset( currOffset + mSectionSizes[sectionIdx] );
+	}
+
+	std::filesystem::path fileNameTemp( rCacheFile );
+	fileNameTemp += ".tmp";
+	{
+		std::ofstream fileOut( fileNameTemp, std::ios::binary | std::ios::trunc );
+		if( !fileOut.is_open() ) {
+			LOG::error() << "[MeshCache::" << __FUNCTION__ << "] ERROR: Could not open " << fileNameTemp << " for writing!\n";
+			return( false );
+		}
+		const char padding[gSectionAlign] {};
+		fileOut.write( reinterpret_cast<const char*>( &fileHeader ), sizeof( sFileHeader ) );
+		uint64_t writtenBytes = sizeof( sFileHeader );
+		for( int sectionIdx=0; sectionIdx<SECTION_COUNT; sectionIdx++ ) {
+			fileOut.write( padding, static_cast<std::streamsize>( fileHeader.mSectionOffsets[sectionIdx] - writtenBytes ) );
+			if( mSectionSizes[sectionIdx] > 0 ) {
+				fileOut.write( static_cast<const char*>( mSectionData[sectionIdx] ), static_cast<std::streamsize>( mSectionSizes[sectionIdx] ) );
+			}
+			writtenBytes = fileHeader.mSectionOffsets[sectionIdx] + mSectionSizes[sectionIdx];
+		}
+		if( !fileOut.good() ) {
+			LOG::error() << "[MeshCache::" << __FUNCTION__ << "] ERROR: Writing " << fileNameTemp << " failed!\n";
+			fileOut.close();
+			std::filesystem::remove( fileNameTemp );
+			return( false );
+		}
+	}
+	std::error_code errorCode;
+	std::filesystem::rename( fileNameTemp, rCacheFile, errorCode );
+	if( errorCode ) {
+		LOG::error() << "[MeshCache::" << __FUNCTION__ << "] ERROR: Could not rename " << fileNameTemp << ": " << errorCode.message() << "!\n";
+		std::filesystem::remove( fileNameTemp, errorCode );
+		return( false );
+	}
+	LOG::info() << "[MeshCache::" << __FUNCTION__ << "] Cache written: " << rCacheFile << "\n";
+	return( true );
+}
+
+//! Maps the cache and checks it against the source file. Outdated or broken caches are rejected.
+//!
+//! @returns false in case of an error or an invalid cache. True otherwise.
+bool MeshCache::open(
+                const std::filesystem::path& rCacheFile,
+                const std::filesystem::path& rSourceFile
+) {
+	PROFILE_SCOPE( "MeshCache::open" );
+	close();
+	std::error_code errorCode;
+	if( !std::filesystem::exists( rCacheFile, errorCode ) ) {
+		return( false );
+	}
+	if( !mMappedFile.open( rCacheFile ) ) {
+		return( false );
+	}
+	sFileHeader fileHeader {};
+	if( mMappedFile.getSize() < sizeof( sFileHeader ) ) {
+		LOG::warn() << "[MeshCache::" << __FUNCTION__ << "] Cache " << rCacheFile << " is truncated!\n";
+		close();
+		return( false );
+	}
+	std::memcpy( &fileHeader, mMappedFile.getData(), sizeof( sFileHeader ) );
+	if( ( std::memcmp( fileHeader.mMagic, gCacheMagic, sizeof( gCacheMagic ) ) != 0 ) ||
+	    ( fileHeader.mVersion != gCacheVersion ) || ( fileHeader.mByteOrderMark != gByteOrderMark ) ||
+	    ( fileHeader.mSectionCount != SECTION_COUNT ) ) {
+		LOG::warn() << "[MeshCache::" << __FUNCTION__ << "] Cache " << rCacheFile << " has an unsupported format!\n";
+		close();
+		return( false );
+	}
+	for( int sectionIdx=0; sectionIdx<SECTION_COUNT; sectionIdx++ ) {
+		const uint64_t sectionOffset = fileHeader.mSectionOffsets[sectionIdx];
+		const uint64_t sectionSize   = fileHeader.mSectionSizes[sectionIdx];
+		if( ( sectionOffset % gSectionAlign != 0 ) || ( sectionOffset > mMappedFile.getSize() ) ||
+		    ( sectionSize > mMappedFile.getSize() - sectionOffset ) ) {
+			LOG::warn() << "[MeshCache::" << __FUNCTION__ << "] Cache " << rCacheFile << " is truncated!\n";
+			close();
+			return( false );
+		}
+		mSectionData[sectionIdx]  = ( sectionSize > 0 ) ? mMappedFile.getData() + sectionOffset : nullptr;
+		mSectionSizes[sectionIdx] = sectionSize;
+	}
+
+	// Check the source: same size and either the same modification time or the same contents.
+	uint64_t sourceSize    = 0;
+	int64_t  sourceModTime = 0;
+	if( !getSourceInfo( rSourceFile, sourceSize, sourceModTime ) || ( sourceSize != fileHeader.mSourceSize ) ) {
+		LOG::info() << "[MeshCache::" << __FUNCTION__ << "] Cache " << rCacheFile << " is outdated.\n";
+		close();
+		return( false );
+	}
+	if( sourceModTime != fileHeader.mSourceModTime ) {
+		uint64_t sourceHash = 0;
+		if( !getSourceHash( rSourceFile, sourceHash ) || ( sourceHash != fileHeader.mSourceHash ) ) {
+			LOG::info() << "[MeshCache::" << __FUNCTION__ << "] Cache " << rCacheFile << " is outdated.\n";
+			close();
+			return( false );
+		}
+	}
+	mVertexCount   = fileHeader.mVertexCount;
+	mFaceCount     = fileHeader.mFaceCount;
+	mFeatureVecLen = fileHeader.mFeatureVecLen;
+	return( true );
+}
+
+//! Unmaps the cache and clears all sections.
+void MeshCache::close() {
+	mMappedFile.close();
+	mVertexCount   = 0;
+	mFaceCount     = 0;
+	mFeatureVecLen = 0;
+	for( int sectionIdx=0; sectionIdx<SECTION_COUNT; sectionIdx++ ) {
+		mSectionData[sectionIdx]  = nullptr;
+		mSectionSizes[sectionIdx] = 0;
+	}
+}
+
+//! Fetches the size and the modification time of the source file.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshCache::getSourceInfo(
+                const std::filesystem::path& rSourceFile,
+                uint64_t&                    rSize,
+                int64_t&                     rModTime
+) {
+	std::error_code errorCode;
+	rSize = std::filesystem::file_size( rSourceFile, errorCode );
+	if( errorCode ) {
+		LOG::error() << "[MeshCache::" << __FUNCTION__ << "] ERROR: Could not determine the size of " << rSourceFile << "!\n";
+		return( false );
+	}
+	const std::filesystem::file_time_type modTime = std::filesystem::last_write_time( rSourceFile, errorCode );
+	if( errorCode ) {
+		LOG::error() << "[MeshCache::" << __FUNCTION__ << "] ERROR: Could not determine the modification time of " << rSourceFile << "!\n";
+		return( false );
+	}
+	rModTime = static_cast<int64_t>( modTime.time_since_epoch().count() );
+	return( true );
+}
+
+//! Computes the 64-bit FNV-1a hash of the contents of the source file using 8-byte words.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshCache::getSourceHash(
+                const std::filesystem::path& rSourceFile,
+                uint64_t&                    rHash
+) {
+	PROFILE_SCOPE( "MeshCache::getSourceHash" );
+	MappedFile sourceFile;
+	if( !sourceFile.open( rSourceFile ) ) {
+		return( false );
+	}
+	const uint64_t fnvPrime = 0x100000001b3ULL;
+	rHash = 0xcbf29ce484222325ULL;
+	const char*    sourceData = sourceFile.getData();
+	const uint64_t wordCount  = sourceFile.getSize() / sizeof( uint64_t );
+	for( uint64_t wordIdx=0; wordIdx<wordCount; wordIdx++ ) {
+		uint64_t currWord;
+		std::memcpy( &currWord, sourceData + wordIdx * sizeof( uint64_t ), sizeof( uint64_t ) );
+		rHash = ( rHash ^ currWord ) * fnvPrime;
+	}
+	for( uint64_t byteIdx=wordCount*sizeof( uint64_t ); byteIdx<sourceFile.getSize(); byteIdx++ ) {
+		rHash = ( rHash ^ static_cast<unsigned char>( sourceData[byteIdx] ) ) * fnvPrime;
+	}
+	return( true );
+}
@@ -37,6 +37,7 @@
 #include <GigaMesh/mesh/gmcommon.h>
 #include <GigaMesh/logging/Logging.h>
 #include <GigaMesh/getuserandhostname.h>
+#include <GigaMesh/getlocaltime.h>
 
 //! Constructer calls MeshInfoData::reset() and sets the names for the enumerators.
 MeshInfoData::MeshInfoData() {
@@ -348,8 +349,8 @@ bool MeshInfoData::writeMeshInfoProcess(
 	fileStrOutMeta << "Faces synthetic (in):        " << rMeshInfoPrevious.mCountULong[MeshInfoData::FACES_WITH_SYNTH_VERTICES] << std::endl;
 	fileStrOutMeta << "Faces synthetic (out):       " << mCountULong[MeshInfoData::FACES_WITH_SYNTH_VERTICES] << std::endl;
 	fileStrOutMeta << "Iterations:                  " << rIterationCount << std::endl;
-	fileStrOutMeta << "Start time:                  " << std::ctime( &startTime );
-	fileStrOutMeta << "Finish time:                 " << std::ctime( &endTime );
+	fileStrOutMeta << "Start time:                  " << getLocalTimeStr( startTime );
+	fileStrOutMeta << "Finish time:                 " << getLocalTimeStr( endTime );
 	fileStrOutMeta << "# Timespan (sec):            " << timeElapsed << std::endl;
 	fileStrOutMeta.close();
 	std::wcout << "[MeshInfoData::" << __FUNCTION__ << "] Wrote meta-data to: " << fileNameOutMeta << std::endl;
@@ -358,7 +359,7 @@ bool MeshInfoData::writeMeshInfoProcess(
     std::size_t pos = indidnotencoded.find_last_of("/");
     std::string indname = indidnotencoded.substr(pos+1,indidnotencoded.size());
     std::string funcid=urlEncode(rFunctionExecuted);    
-    std::string starttime=urlEncode(std::ctime( &startTime ));   
+    std::string starttime=urlEncode(getLocalTimeStr( startTime ));   
     std::string actid=funcid+"_"+generate_UUID();           
     std::string newindid=generate_UUID(); 
     std::string personid="person"; 
@@ -470,12 +471,14 @@ bool MeshInfoData::writeMeshInfoProcess(
     ttlmeta+="giga:"+actid+" giga:connectedComponentCountDifference \""+std::to_string(mCountULong[CONNECTED_COMPONENTS]-rMeshInfoPrevious.mCountULong[CONNECTED_COMPONENTS])+"\"^^xsd:integer .\n";
     ttlmeta+="giga:"+actid+" giga:cputhreads \""+std::to_string(std::thread::hardware_concurrency() - 1)+"\"^^xsd:integer .\n";
     char startTimeBuf[256];
-    const std::tm * startptm = std::localtime(&startTime);
-    strftime(startTimeBuf, sizeof(startTimeBuf), "%Y-%m-%dT%H:%M:%S", startptm);
+    std::tm startLocalTime {};
+    getLocalTime(startTime, startLocalTime);
+    strftime(startTimeBuf, sizeof(startTimeBuf), "%Y-%m-%dT%H:%M:%S", &startLocalTime);
     ttlmeta+="giga:"+actid+" prov:startedAtTime \""+std::string(startTimeBuf)+"\"^^xsd:dateTime .\n";
     char endTimeBuf[256];
-    const std::tm * endptm = std::localtime(&endTime);
-    strftime(endTimeBuf, sizeof(endTimeBuf), "%Y-%m-%dT%H:%M:%S", endptm);
+    std::tm endLocalTime {};
+    getLocalTime(endTime, endLocalTime);
+    strftime(endTimeBuf, sizeof(endTimeBuf), "%Y-%m-%dT%H:%M:%S", &endLocalTime);
     ttlmeta+="giga:"+actid+" prov:endedAtTime \""+std::string(endTimeBuf)+"\"^^xsd:dateTime .\n";
     ttlmeta+="giga:"+actid+" prov:used giga:"+indid+" .\n";
     ttlmeta+="giga:"+newindid+" rdf:type giga:Mesh .\n";
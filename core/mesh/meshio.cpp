@@ -58,6 +58,7 @@
 #include "util/triangulation.h"
 
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
 
 using namespace std;
 
@@ -172,6 +173,7 @@ bool MeshIO::readFile(
                 std::vector<sVertexProperties>& rVertexProps,
                 std::vector<sFaceProperties>& rFaceProps
 ) {
+	PROFILE_SCOPE( "MeshIO::readFile" );
 	// Extension - lower case and without dot
 	std::string fileExtension = rFileName.extension().string();
 	for( char& character : fileExtension ) {
@@ -229,20 +231,16 @@ bool MeshIO::readFile(
 
 	if(mModelMetaData.hasTextureFiles())
 	{
-		auto prevPath = std::filesystem::current_path();
-		std::filesystem::current_path(std::filesystem::absolute(rFileName).parent_path());
-
-		std::filesystem::path texturePath(mModelMetaData.getModelMetaString(ModelMetaData::META_TEXTUREFILE));
-
+		// Relative texture paths refer to the directory of the file.
+		const std::filesystem::path fileDir = std::filesystem::absolute(rFileName).parent_path();
 		for(auto& textureFileString : mModelMetaData.getTexturefilesRef())
 		{
 			std::filesystem::path texturePath(textureFileString);
 			if(texturePath.is_relative())
 			{
-				textureFileString = std::filesystem::absolute(texturePath).string();
+				textureFileString = (fileDir / texturePath).string();
 			}
 		}
-		std::filesystem::current_path(prevPath);
 	}
 
 	mExportFlags[EXPORT_TEXTURE_COORDINATES] = mModelMetaData.hasTextureCoordinates();
@@ -399,19 +397,17 @@ bool MeshIO::writeFileUserInteract() {
 	return( false );
 }
 
-//! Write a Mesh to a file. The file type is automatically determined by the file
-//! extension. See methods like: MeshIO::writeOBJ, MeshIO::writePLY and MeshIO::writeVRML
-bool MeshIO::writeFilePrimProps(
-                const filesystem::path& rFileName,
-                std::vector<sVertexProperties>& rVertexProps,
-                std::vector<sFaceProperties>& rFaceProps
-) {
+//! Creates the writer for the type of file given by its extension and passes the
+//! export settings and the meta-data.
+//!
+//! @returns nullptr in case of an unknown extension.
+std::unique_ptr<MeshWriter> MeshIO::createWriter( const filesystem::path& rFileName ) const {
 	string fileExtension = rFileName.extension().string();
 
 	if(fileExtension.empty())
 	{
 		LOG::error() << "[MeshIO::" << __FUNCTION__ << "] No extension/type for file '" << rFileName << "' specified!\n";
-		return false;
+		return nullptr;
 	}
 
 	for(char& character : fileExtension)
@@ -432,7 +428,6 @@ bool MeshIO::writeFilePrimProps(
 
 	std::unique_ptr<MeshWriter> writer = nullptr;
 
-	bool fileWriteOk = false;
 	if( fileExtension == "obj" ) {
 		writer = std::make_unique<ObjWriter>();
 	}
@@ -449,10 +444,37 @@ bool MeshIO::writeFilePrimProps(
 		writer = std::make_unique<PlyWriter>();
 	}
 
+	if( writer == nullptr ) {
+		LOG::error() << "[MeshIO::" << __FUNCTION__ << "] Unknown extension/type '" << fileExtension << "' specified!\n";
+		return nullptr;
+	}
+
+	writer->setModelMetaData(mModelMetaData);
+	writer->setIsBigEndian(mSystemIsBigEndian);
+	writer->setExportBinary(mExportFlags[EXPORT_BINARY]);
+	writer->setExportVertColor(mExportFlags[EXPORT_VERT_COLOR]);
+	writer->setExportVertNormal(mExportFlags[EXPORT_VERT_NORMAL]);
+	writer->setExportVertFlags(mExportFlags[EXPORT_VERT_FLAGS]);
+	writer->setExportVertLabel(mExportFlags[EXPORT_VERT_LABEL]);
+	writer->setExportVertFeatureVector(mExportFlags[EXPORT_VERT_FTVEC]);
+	writer->setExportPolyline(mExportFlags[EXPORT_POLYLINE]);
+	writer->setExportTextureCoordinates(mExportFlags[EXPORT_TEXTURE_COORDINATES]);
+	return writer;
+}
+
+//! Write a Mesh to a file. The file type is automatically determined by the file
+//! extension. See methods like: MeshIO::writeOBJ, MeshIO::writePLY and MeshIO::writeVRML
+bool MeshIO::writeFilePrimProps(
+                const filesystem::path& rFileName,
+                std::vector<sVertexProperties>& rVertexProps,
+                std::vector<sFaceProperties>& rFaceProps
+) {
+	PROFILE_SCOPE( "MeshIO::writeFilePrimProps" );
+	std::unique_ptr<MeshWriter> writer = createWriter( rFileName );
+
+	bool fileWriteOk = false;
 	if(writer != nullptr)
 	{
-		writer->setModelMetaData(mModelMetaData);
-
 		if(mExportFlags[EXPORT_TEXTURE_FILE] && mModelMetaData.hasTextureFiles())
 		{
 			for(size_t i = 0; i<mModelMetaData.getTexturefilesRef().size(); ++i)
@@ -463,21 +485,10 @@ bool MeshIO::writeFilePrimProps(
 			}
 		}
 
-		writer->setIsBigEndian(mSystemIsBigEndian);
-		writer->setExportBinary(mExportFlags[EXPORT_BINARY]);
-		writer->setExportVertColor(mExportFlags[EXPORT_VERT_COLOR]);
-		writer->setExportVertNormal(mExportFlags[EXPORT_VERT_NORMAL]);
-		writer->setExportVertFlags(mExportFlags[EXPORT_VERT_FLAGS]);
-		writer->setExportVertLabel(mExportFlags[EXPORT_VERT_LABEL]);
-		writer->setExportVertFeatureVector(mExportFlags[EXPORT_VERT_FTVEC]);
-		writer->setExportPolyline(mExportFlags[EXPORT_POLYLINE]);
-		writer->setExportTextureCoordinates(mExportFlags[EXPORT_TEXTURE_COORDINATES]);
-
 		fileWriteOk = writer->writeFile(rFileName, rVertexProps, rFaceProps, *this);
 	}
 
 	if( !fileWriteOk ) {
-		LOG::error() << "[MeshIO::" << __FUNCTION__ << "] Unknown extension/type '" << fileExtension << "' specified!\n";
 		return false;
 	}
 
@@ -504,6 +515,28 @@ bool MeshIO::writeFilePrimProps(
 	return true;
 }
 
+//! Write arrays to a file using the export settings and the meta-data of this MeshIO.
+//! In contrast to MeshIO::writeFilePrimProps the state i.e. the file name is not
+//! changed and the feature vectors and polylines are taken from the given seed.
+//! Texture files are not copied.
+//!
+//! Thread-safe for different files and seeds, which is used to write multiple parts
+//! of a mesh concurrently.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshIO::writeFilePrimPropsDetached(
+                const filesystem::path&               rFileName,
+                const std::vector<sVertexProperties>& rVertexProps,
+                const std::vector<sFaceProperties>&   rFaceProps,
+                MeshSeedExt&                          rMeshSeed
+) const {
+	std::unique_ptr<MeshWriter> writer = createWriter( rFileName );
+	if( writer == nullptr ) {
+		return( false );
+	}
+	return( writer->writeFile( rFileName, rVertexProps, rFaceProps, rMeshSeed ) );
+}
+
 ModelMetaData &MeshIO::getModelMetaDataRef()
 {
 	return mModelMetaData;
@@ -542,6 +575,11 @@ filesystem::path MeshIO::getFullName() const {
 	return mFileNameFull;
 }
 
+//! Sets the name of the current file, when the data was not read by readFile e.g. from a MeshCache.
+void MeshIO::setFileNameFull( const filesystem::path& rFileName ) {
+	mFileNameFull = std::filesystem::absolute( rFileName );
+}
+
 bool MeshIO::writeIcoNormalSphereData(const filesystem::path& rFilename, const std::list<sVertexProperties>& rVertexProps, int subdivisions, bool sphereCoordinates)
 {
 	fstream filestr;
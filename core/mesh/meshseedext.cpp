@@ -26,12 +26,41 @@
 #include <ctime>
 #include <string>
 
+#include <GigaMesh/mesh/featurevecmatrix.h>
+#include <GigaMesh/mesh/numerictable.h>
 #include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
 
 using namespace std;
 
 using uint = unsigned int;
 
+namespace {
+	//! Reads a file with feature vectors for MeshSeedExt::importFeatureVectors and reports invalid and skipped lines.
+	//! @returns false in case of an error. True otherwise.
+	bool readFeatureVecTable( const filesystem::path& rFileName, uint64_t rNrVertices, bool rVertexIdInFirstCol,
+	                          FeatureVecMatrix* rMatrix, NumericTable& rTable ) {
+		NumericTable::sParams params;
+		params.mFirstColIsIndex = rVertexIdInFirstCol;
+		params.mRowCount        = rNrVertices;
+		params.mMatrix          = rMatrix;
+		if( !rTable.read( rFileName, params ) ) {
+			LOG::error() << "[MeshSeedExt::importFeatureVectors] Could not open file: '" << rFileName << "'.\n";
+			return( false );
+		}
+		LOG::debug() << "[MeshSeedExt::importFeatureVectors] " << rTable.getLineCount() << " lines parsed.\n";
+		if( rTable.getInvalidCount() > 0 ) {
+			LOG::error() << "[MeshSeedExt::importFeatureVectors] ERROR: Conversion to floating point failed for "
+			             << rTable.getInvalidCount() << " values e.g. in line " << rTable.getFirstInvalidLine() << "!\n";
+		}
+		if( rTable.getSkippedCount() > 0 ) {
+			LOG::warn() << "[MeshSeedExt::importFeatureVectors] ERROR: " << rTable.getSkippedCount()
+			            << " lines with vertex ID larger than vertex count OR negative!\n";
+		}
+		return( true );
+	}
+} // anonymous namespace
+
 #define MESHSEEDEXTINITDEFAULTS                      \
 	mFeatureVecVerticesLen( 0 )                  \
 
@@ -67,10 +96,11 @@ void MeshSeedExt::clear() {
 //! Imports feature vectors to be mapped to the Vertex objects.
 //!
 //! Expected format ASCII: VertexOriginalIndex featureElement_1 ... featureElement_N (N will be vectorArraySize)
-//! The expected delimiter is one space.
+//! The expected delimiter is one space. Lines starting with '#' are comments.
+//! The file is parsed by multiple threads - see NumericTable.
 //!
-//! Returns an array of the vertices indicies of length nrLines.
-//! and the feature vectors as vectorArray by size nrLines*vectorArraySize
+//! Returns the feature vectors as vectorArray by size rNrVertices*vectorArraySize
+//! Elements not given within the file are not-a-number.
 //!
 //! @returns false in case of an error. True otherwise.
 bool MeshSeedExt::importFeatureVectors(
@@ -80,130 +110,34 @@ bool MeshSeedExt::importFeatureVectors(
                 uint64_t&                 rMaxFeatVecLen,       //!< Length of the longest vector.
                 bool                      rVertexIdInFirstCol   //!< Does the feature vector file have a vertex id within the first column?
 ) {
-	// LOCALE .... because of "." vs ","
-	const char* oldLocale = setlocale( LC_NUMERIC, "" );
-	setlocale( LC_NUMERIC, "C" );
-
-	ifstream fp( rFileName );
-	if( !fp.is_open() ) {
-		LOG::error() << "[MeshSeedExt::" << __FUNCTION__ << "] Could not open file: '" << rFileName << "'.\n";
-		setlocale(LC_NUMERIC, oldLocale);
+	PROFILE_SCOPE( "MeshSeedExt::importFeatureVectors" );
+	NumericTable table;
+	if( !readFeatureVecTable( rFileName, rNrVertices, rVertexIdInFirstCol, nullptr, table ) ) {
 		return( false );
 	}
-	LOG::debug() << "[MeshSeedExt::" << __FUNCTION__ << "] File opened: '" << rFileName << "'.\n";
-
-	// Determine the amount of data by parsing the data for a start
-	int    lineNr = 0;
-	string line;
-	char   nextByte;
-	rMaxFeatVecLen = _NOT_A_NUMBER_UINT_;
-	uint64_t vertID = 0;
-
-	while( fp.good() ) {
-		line.clear();
-		nextByte = fp.peek();
-		lineNr++;
-		// Comment line:
-		if( nextByte == '#' ) {
-			getline( fp, line );
-			continue;
-		}
-		// Empty line:
-		if( ( nextByte == '\n' ) || ( nextByte == '\r' ) || ( nextByte == -1 ) ) {
-			getline( fp, line );
-			continue;
-		}
-		// Optional vertex ID (1/2):
-		if( rVertexIdInFirstCol ) {
-			fp >> vertID;
-		}
-		nextByte = fp.peek();
-		uint64_t valuesPerID = 0;
-		while( ( nextByte != '\n' ) && ( nextByte != '\r' ) && ( nextByte != -1 ) ) {
-			fp.get();
-			string valueAsStr;
-			fp >> valueAsStr;
-			// double valueAsDouble = stod( valueAsStr );
-			nextByte = fp.peek();
-			valuesPerID++;
-		}
-		if( rMaxFeatVecLen < valuesPerID ) {
-			rMaxFeatVecLen = valuesPerID;
-		}
-		// Optional vertex ID (2/2):
-		if( !rVertexIdInFirstCol ) {
-			vertID++;
-		}
-		// Fetch the rest of the line
-		getline( fp, line );
-	}
-	LOG::debug() << "[MeshSeedExt::" << __FUNCTION__ << "] nextByte: '" << hex << nextByte << dec << "'\n";
-	LOG::debug() << "[MeshSeedExt::" << __FUNCTION__ << "] " << lineNr << " lines parsed.\n";
-
-	// Allocate memory
-	rFeatureVecs.clear();
-	// and set elements to not-a-number in case there are empty fields
-	rFeatureVecs.assign( rMaxFeatVecLen*rNrVertices, _NOT_A_NUMBER_DBL_ );
-
-	// Fetch data
-	fp.clear();
-	fp.seekg( ios_base::beg );
-	vertID = 0;
-	while( fp.good() ) {
-		nextByte = fp.peek();
-		// Comment line:
-		if( nextByte == '#' ) {
-			getline( fp, line );
-			LOG::debug() << "[MeshSeedExt::" << __FUNCTION__ << "] Comment: " << line << "\n";
-			continue;
-		}
-		// Empty line:
-		if( ( nextByte == '\n' ) || ( nextByte == '\r' ) || ( nextByte == -1 ) ) {
-			getline( fp, line );
-			LOG::debug() << "[MeshSeedExt::" << __FUNCTION__ << "] Empty line.\n";
-			continue;
-		}
-		// Optional vertex ID (1/2):
-		if( rVertexIdInFirstCol ) {
-			fp >> vertID;
-		}
-		// ... which should be within range
-		if( vertID >= rNrVertices ) {
-			LOG::warn() << "[MeshSeedExt::" << __FUNCTION__ << "] ERROR: Vertex ID larger than vertex count OR negative!\n";
-			getline( fp, line );
-			continue;
-		}
-		nextByte = fp.peek();
-		int featElementNr = 0;
-		while( ( nextByte != '\n' ) && ( nextByte != '\r' ) && ( nextByte != -1 ) ) {
-			string valueAsStr;
-			fp >> valueAsStr;
-			double valueAsDouble = _NOT_A_NUMBER_DBL_;
-			try{
-				valueAsDouble = stod( valueAsStr );
-			} catch( const std::invalid_argument& ia ) {
-				LOG::error() << "[MeshSeedExt::" << __FUNCTION__ << "] ERROR: Conversion to floating point failed for string '" << valueAsStr << "'!\n";
-				LOG::error() << "[MeshSeedExt::" << __FUNCTION__ << "]        Invalid argument: " << ia.what() << "\n";
-			}
-			rFeatureVecs.at( vertID*rMaxFeatVecLen+featElementNr ) = valueAsDouble;
-			nextByte = fp.peek();
-			featElementNr++;
-		}
-		// Optional vertex ID (2/2):
-		if( !rVertexIdInFirstCol ) {
-			vertID++;
-		}
-		// Fetch the rest of the line
-		getline( fp, line );
-	}
-	fp.close();
-
-	// LOCALE .... because of "." vs ","
-	setlocale( LC_NUMERIC, oldLocale );
-
+	rMaxFeatVecLen = table.getColCount();
+	table.swapValues( rFeatureVecs );
 	return( true );
 }
 
+//! Imports feature vectors into a matrix with one row per vertex - see above for the format.
+//!
+//! The values are converted to the precision of the given matrix, while the
+//! file is parsed. So for float32 and float16 the feature vectors are never
+//! held in double precision.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshSeedExt::importFeatureVectors(
+                const filesystem::path&   rFileName,            //!< Filename to parse.
+                uint64_t                  rNrVertices,          //!< Maximum number of vertices within the Mesh.
+                FeatureVecMatrix&         rFeatureVecs,         //!< Feature vectors using the precision of this matrix.
+                bool                      rVertexIdInFirstCol   //!< Does the feature vector file have a vertex id within the first column?
+) {
+	PROFILE_SCOPE( "MeshSeedExt::importFeatureVectors" );
+	NumericTable table;
+	return( readFeatureVecTable( rFileName, rNrVertices, rVertexIdInFirstCol, &rFeatureVecs, table ) );
+}
+
 // Feature Vectors - STUB to be overloaded by Mesh -------------------------------------------------------------------------------------------------------------
 
 //! Returns 0 (zero) as there are no feature vectors.
@@ -0,0 +1,340 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/numerictable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/featurevecmatrix.h>
+#include <GigaMesh/mesh/mappedfile.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/mesh/parsenumber.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Bytes per chunk parsed by one thread. Chunks are extended to the next line break.
+	constexpr uint64_t bytesPerChunk = 1024 * 1024;
+
+	//! @returns true for characters separating values. Carriage returns of Windows line ends are ignored this way.
+	inline bool isDelimiter( char rChar ) {
+		return( ( rChar == ' ' ) || ( rChar == '\t' ) || ( rChar == ',' ) || ( rChar == '\r' ) );
+	}
+
+	//! Moves rPos to the next token and rTokenEnd behind it.
+	//! @returns false, when the line has no more tokens.
+	inline bool nextToken( const char*& rPos, const char* rLineEnd, const char*& rTokenEnd ) {
+		while( ( rPos < rLineEnd ) && isDelimiter( *rPos ) ) {
+			++rPos;
+		}
+		if( rPos >= rLineEnd ) {
+			return( false );
+		}
+		rTokenEnd = rPos;
+		while( ( rTokenEnd < rLineEnd ) && !isDelimiter( *rTokenEnd ) ) {
+			++rTokenEnd;
+		}
+		return( true );
+	}
+
+	//! Counts and results of one chunk.
+	struct sChunk {
+		const char* mBegin            = nullptr;
+		const char* mEnd              = nullptr;
+		uint64_t    mLineCount        = 0;  //!< All lines.
+		uint64_t    mRowCount         = 0;  //!< Lines with values and a valid index.
+		uint64_t    mColCountMax      = 0;
+		uint64_t    mColCountMin      = numeric_limits<uint64_t>::max();
+		uint64_t    mInvalidCount     = 0;
+		uint64_t    mSkippedCount     = 0;
+		uint64_t    mFirstInvalidLine = 0;  //!< Relative to the chunk starting with one. Zero: none.
+		std::vector<uint64_t> mIndices;     //!< Valid indices in the order of the lines - only for a given number of rows.
+	};
+
+	//! Calls rFunc( lineNr, lineBegin, lineEnd ) for each line, which is neither empty nor a comment.
+	//! The line numbers are relative to the chunk starting with one.
+	//! @returns the number of lines within the chunk.
+	template<typename tFunc>
+	uint64_t forEachDataLine( const char* rBegin, const char* rEnd, tFunc&& rFunc ) {
+		uint64_t    lineNr = 0;
+		const char* lineBegin = rBegin;
+		while( lineBegin < rEnd ) {
+			const char* lineEnd = static_cast<const char*>( memchr( lineBegin, '\n', static_cast<size_t>( rEnd - lineBegin ) ) );
+			if( lineEnd == nullptr ) {
+				lineEnd = rEnd;
+			}
+			lineNr++;
+			const char* firstChar = lineBegin;
+			while( ( firstChar < lineEnd ) && isDelimiter( *firstChar ) ) {
+				++firstChar;
+			}
+			if( ( firstChar < lineEnd ) && ( *firstChar != '#' ) ) {
+				rFunc( lineNr, firstChar, lineEnd );
+			}
+			lineBegin = lineEnd + 1;
+		}
+		return( lineNr );
+	}
+}
+
+//! Removes all values.
+void NumericTable::clear() {
+	mRowCount         = 0;
+	mColCount         = 0;
+	mColCountMin      = 0;
+	mValues.clear();
+	mRowGiven.clear();
+	mIndices.clear();
+	mLineCount        = 0;
+	mInvalidCount     = 0;
+	mSkippedCount     = 0;
+	mFirstInvalidLine = 0;
+}
+
+//! Reads a table from an ASCII file using multiple threads.
+//! When a matrix is given by the parameters, getValues remains empty.
+//! @returns false in case of an error. True otherwise i.e. also for files with invalid values.
+bool NumericTable::read(
+                const filesystem::path& rFileName,  //!< File to read.
+                const sParams&          rParams     //!< Index column and rows.
+) {
+	PROFILE_SCOPE( "NumericTable::read" );
+	clear();
+	MappedFile file;
+	if( !file.open( rFileName ) ) {
+		return( false );
+	}
+	const char*    data     = file.getData();
+	const uint64_t fileSize = file.getSize();
+
+	// Split at line breaks.
+	const uint64_t chunkCount = max<uint64_t>( 1, ParallelFor::getChunkCount( fileSize, bytesPerChunk ) );
+	vector<sChunk> chunks( chunkCount );
+	for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+		if( chunkIdx == 0 ) {
+			chunks[chunkIdx].mBegin = data;
+		} else {
+			const char* searchBegin = max( data + chunkIdx * bytesPerChunk, chunks[chunkIdx-1].mBegin );
+			const char* lineBreak   = static_cast<const char*>( memchr( searchBegin, '\n', static_cast<size_t>( data + fileSize - searchBegin ) ) );
+			chunks[chunkIdx].mBegin = ( lineBreak == nullptr ) ? data + fileSize : lineBreak + 1;
+			chunks[chunkIdx-1].mEnd = chunks[chunkIdx].mBegin;
+		}
+	}
+	chunks.back().mEnd = data + fileSize;
+	const unsigned int threadCount = ParallelFor::getThreadCount( rParams.mThreadCount );
+	const bool indexIsRow = rParams.mFirstColIsIndex && ( rParams.mRowCount > 0 );
+
+	// Pass 1: count lines, rows and values.
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunk ) {
+		sChunk& chunk = chunks[rChunk];
+		chunk.mLineCount = forEachDataLine( chunk.mBegin, chunk.mEnd, [&]( uint64_t rLineNr, const char* rPos, const char* rLineEnd ) {
+			const char* tokenEnd = nullptr;
+			if( rParams.mFirstColIsIndex ) {
+				uint64_t index;
+				nextToken( rPos, rLineEnd, tokenEnd );
+				if( !parseIndex( rPos, tokenEnd, index ) ) {
+					chunk.mInvalidCount++;
+					chunk.mSkippedCount++;
+					if( chunk.mFirstInvalidLine == 0 ) {
+						chunk.mFirstInvalidLine = rLineNr;
+					}
+					return;
+				}
+				if( indexIsRow ) {
+					chunk.mIndices.push_back( index );
+				}
+				rPos = tokenEnd;
+			}
+			uint64_t colCount = 0;
+			while( nextToken( rPos, rLineEnd, tokenEnd ) ) {
+				colCount++;
+				rPos = tokenEnd;
+			}
+			chunk.mRowCount++;
+			chunk.mColCountMax = max( chunk.mColCountMax, colCount );
+			chunk.mColCountMin = min( chunk.mColCountMin, colCount );
+		} );
+	} );
+
+	// Rows and lines before each chunk.
+	vector<uint64_t> chunkRowStart( chunkCount, 0 );
+	vector<uint64_t> chunkLineStart( chunkCount, 0 );
+	uint64_t fileRowCount = 0;
+	mColCountMin = numeric_limits<uint64_t>::max();
+	for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+		const sChunk& chunk = chunks[chunkIdx];
+		chunkRowStart[chunkIdx]  = fileRowCount;
+		chunkLineStart[chunkIdx] = mLineCount;
+		fileRowCount += chunk.mRowCount;
+		mLineCount   += chunk.mLineCount;
+		mColCount     = max( mColCount, chunk.mColCountMax );
+		mColCountMin  = min( mColCountMin, chunk.mColCountMin );
+	}
+	if( fileRowCount == 0 ) {
+		mColCountMin = 0;
+	}
+
+	// Allocate
+	mRowCount = ( rParams.mRowCount > 0 ) ? rParams.mRowCount : fileRowCount;
+	if( rParams.mMatrix != nullptr ) {
+		if( !rParams.mMatrix->allocate( mRowCount, mColCount ) ) {
+			return( false );
+		}
+	} else {
+		mValues.assign( mRowCount * mColCount, _NOT_A_NUMBER_DBL_ );
+	}
+	if( rParams.mRowCount > 0 ) {
+		mRowGiven.assign( mRowCount, 0 );
+	} else if( rParams.mFirstColIsIndex ) {
+		mIndices.resize( mRowCount );
+	}
+
+	// The last line of the file wins for indices occurring more than once.
+	// Merged in the order of the file, so pass 2 stores exactly one line per row.
+	vector<uint64_t> rowLine;
+	if( indexIsRow ) {
+		rowLine.assign( mRowCount, numeric_limits<uint64_t>::max() );
+		for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+			uint64_t fileRow = chunkRowStart[chunkIdx];
+			for( const uint64_t index : chunks[chunkIdx].mIndices ) {
+				if( index < mRowCount ) {
+					rowLine[index] = fileRow;
+				}
+				fileRow++;
+			}
+			vector<uint64_t>().swap( chunks[chunkIdx].mIndices );
+		}
+	}
+
+	// Pass 2: parse the values.
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunk ) {
+		sChunk&  chunk   = chunks[rChunk];
+		uint64_t fileRow = chunkRowStart[rChunk];
+		forEachDataLine( chunk.mBegin, chunk.mEnd, [&]( uint64_t rLineNr, const char* rPos, const char* rLineEnd ) {
+			const char* tokenEnd = nullptr;
+			uint64_t    index    = 0;
+			if( rParams.mFirstColIsIndex ) {
+				nextToken( rPos, rLineEnd, tokenEnd );
+				if( !parseIndex( rPos, tokenEnd, index ) ) {
+					return; // counted in pass 1.
+				}
+				rPos = tokenEnd;
+			}
+			const uint64_t lineRow = fileRow++;
+			uint64_t row = lineRow;
+			bool     superseded = false; // by a later line with the same index - parsed only for the counts.
+			if( rParams.mRowCount > 0 ) {
+				if( rParams.mFirstColIsIndex ) {
+					row = index;
+				}
+				if( row >= mRowCount ) {
+					chunk.mSkippedCount++;
+					return;
+				}
+				superseded = indexIsRow && ( rowLine[row] != lineRow );
+				if( !superseded ) {
+					mRowGiven[row] = 1;
+				}
+			} else if( rParams.mFirstColIsIndex ) {
+				mIndices[row] = index;
+			}
+			uint64_t col = 0;
+			while( nextToken( rPos, rLineEnd, tokenEnd ) ) {
+				double value;
+				if( !parseNumber( rPos, tokenEnd, value ) ) {
+					value = _NOT_A_NUMBER_DBL_;
+					chunk.mInvalidCount++;
+					if( ( chunk.mFirstInvalidLine == 0 ) || ( rLineNr < chunk.mFirstInvalidLine ) ) {
+						chunk.mFirstInvalidLine = rLineNr;
+					}
+				}
+				if( !superseded ) {
+					if( rParams.mMatrix != nullptr ) {
+						rParams.mMatrix->set( row, col, value );
+					} else {
+						mValues[row*mColCount+col] = value;
+					}
+				}
+				col++;
+				rPos = tokenEnd;
+			}
+		} );
+	} );
+
+	for( uint64_t chunkIdx=0; chunkIdx<chunkCount; chunkIdx++ ) {
+		const sChunk& chunk = chunks[chunkIdx];
+		mInvalidCount += chunk.mInvalidCount;
+		mSkippedCount += chunk.mSkippedCount;
+		if( ( mFirstInvalidLine == 0 ) && ( chunk.mFirstInvalidLine > 0 ) ) {
+			mFirstInvalidLine = chunkLineStart[chunkIdx] + chunk.mFirstInvalidLine;
+		}
+	}
+	LOG::debug() << "[NumericTable::" << __FUNCTION__ << "] " << rFileName << ": " << mLineCount << " lines, "
+	             << mRowCount << " x " << mColCount << " values.\n";
+	return( true );
+}
+
+//! Exchanges the values with the given vector e.g. to avoid a copy of a large table.
+//! The table is cleared.
+void NumericTable::swapValues( vector<double>& rValues ) {
+	rValues.swap( mValues );
+	clear();
+}
+
+//! @returns true, when a line of the file was stored within the given row.
+//! Always true for tables read without a given number of rows.
+bool NumericTable::isRowGiven( uint64_t rRow ) const {
+	if( mRowGiven.empty() ) {
+		return( rRow < mRowCount );
+	}
+	return( ( rRow < mRowCount ) && ( mRowGiven[rRow] != 0 ) );
+}
+
+//! @returns the index of the given row, when the first column holds the index and no number of rows was given.
+//! Otherwise the row itself.
+uint64_t NumericTable::getIndex( uint64_t rRow ) const {
+	if( mIndices.empty() ) {
+		return( rRow );
+	}
+	return( mIndices[rRow] );
+}
+
+//! Parses a non-negative integer index. Floating point numbers without fraction e.g. '12.0' are accepted as well.
+//! @returns false, when the whole range is not an index.
+bool NumericTable::parseIndex( const char* rBegin, const char* rEnd, uint64_t& rIndex ) {
+	if( parseNumber( rBegin, rEnd, rIndex ) ) {
+		return( true );
+	}
+	double indexAsDouble;
+	if( !parseNumber( rBegin, rEnd, indexAsDouble ) || !( indexAsDouble >= 0.0 ) ||
+	    ( indexAsDouble >= 18446744073709551616.0 ) || ( indexAsDouble != floor( indexAsDouble ) ) ) {
+		return( false );
+	}
+	rIndex = static_cast<uint64_t>( indexAsDouble );
+	return( true );
+}
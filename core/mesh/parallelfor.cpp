@@ -0,0 +1,62 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <GigaMesh/mesh/parallelfor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace ParallelFor {
+
+	unsigned int getThreadCount( unsigned int rThreadCount ) {
+		if( rThreadCount > 0 ) {
+			return( rThreadCount );
+		}
+		return( std::max( std::thread::hardware_concurrency(), 1U ) );
+	}
+
+	//! Calls rFunc for all chunks [0,rChunkCount) distributed dynamically to the given number of threads.
+	//! Zero threads uses all available cores.
+	void forEachChunk(
+	                uint64_t                             rChunkCount,
+	                unsigned int                         rThreadCount,
+	                const std::function<void(uint64_t)>& rFunc
+	) {
+		std::atomic<uint64_t> nextChunk( 0 );
+		auto worker = [&nextChunk, rChunkCount, &rFunc]() {
+			for( uint64_t chunkIdx = nextChunk++; chunkIdx < rChunkCount; chunkIdx = nextChunk++ ) {
+				rFunc( chunkIdx );
+			}
+		};
+		const uint64_t threadCount = std::min<uint64_t>( getThreadCount( rThreadCount ), rChunkCount );
+		std::vector<std::future<void>> threadFutureHandles;
+		for( uint64_t threadIdx = 1; threadIdx < threadCount; threadIdx++ ) {
+			threadFutureHandles.push_back( std::async( std::launch::async, worker ) );
+		}
+		worker();
+		for( std::future<void>& threadFutureHandle : threadFutureHandles ) {
+			threadFutureHandle.get();
+		}
+	}
+}
@@ -57,7 +57,7 @@ PolyLine::PolyLine( const Plane& rPlaneIntersecting )
 
 //! Destructor
 PolyLine::~PolyLine() {
-	vector<PolyEdge*>::iterator itEdge;
+	deque<PolyEdge*>::iterator itEdge;
 	for ( itEdge=mEdgeList.begin(); itEdge != mEdgeList.end(); itEdge++ ) {
 		delete (*itEdge);
 	}
@@ -181,7 +181,7 @@ bool PolyLine::vertLabelGet( int* getLabelNr ) {
 		return false;
 	}
 
-	vector<PolyEdge*>::iterator itEdge;
+	deque<PolyEdge*>::iterator itEdge;
 	itEdge = mEdgeList.begin();
 
 	Vertex* currVert = (*itEdge)->mVertPoly;
@@ -879,7 +879,7 @@ void PolyLine::addFront( Vertex* rNewFrontVert, Face* rFromFace, Face::eEdgeName
 	//! Faster than PolyLine::addFrontNoDupe, because no check about dupes is peformed.
 	//! Usually used, when Mesh::convertSelectedVerticesToPolyline is in reverse mode.
 	PolyEdge* newEdge = new PolyEdge( rNewFrontVert, rFromFace, rFromEdge );
-	mEdgeList.insert( mEdgeList.begin(), newEdge );
+	mEdgeList.push_front( newEdge );
 }
 
 void PolyLine::addBack( Vertex* rNewBackVert, Face* rFromFace, Face::eEdgeNames rFromEdge ) {
@@ -902,7 +902,7 @@ bool PolyLine::addFrontNoDupes( Vertex* rNewFrontVert, Face* rFromFace, Face::eE
 		}
 	}
 	PolyEdge* newEdge = new PolyEdge( rNewFrontVert, rFromFace, rFromEdge );
-	mEdgeList.insert( mEdgeList.begin(), newEdge );
+	mEdgeList.push_front( newEdge );
 	return true;
 }
 
@@ -930,7 +930,7 @@ size_t PolyLine::compileLine( set<labelLine*>* unsortedLines ) {
 	Vertex* vertFront = (*itLine)->vertB;
 	Vertex* vertBack  = (*itLine)->vertA;
 	newEdge = new PolyEdge( vertFront, (*itLine)->mFromFace, (*itLine)->mFromEdge );
-	mEdgeList.insert( mEdgeList.begin(), newEdge );
+	mEdgeList.push_front( newEdge );
 	newEdge = new PolyEdge( vertBack, (*itLine)->mFromFace, (*itLine)->mFromEdge );
 	mEdgeList.push_back( newEdge );
 	unsortedLines->erase( itLine );
@@ -1277,7 +1277,7 @@ bool PolyLine::getBoundingBox(
 	}
 
 	// Iteration
-	vector<PolyEdge*>::iterator currPolyEdge;
+	deque<PolyEdge*>::iterator currPolyEdge;
 	for( currPolyEdge=mEdgeList.begin(); currPolyEdge != mEdgeList.end(); currPolyEdge++ ) {
 		Vector3D currPos;
 		(*currPolyEdge)->getPositionTransformed( &currPos, matBaseChange );
@@ -1372,7 +1372,7 @@ bool PolyLine::getVertexNormalsFuncVal( vector<double>* rNormals, double rScale,
 	// pre-allocate memory
 	rNormals->reserve( mEdgeList.size()*3 );
 	// fetch normals
-	vector<PolyEdge*>::iterator itPolyEdge;
+	deque<PolyEdge*>::iterator itPolyEdge;
 	for( itPolyEdge=mEdgeList.begin(); itPolyEdge!=mEdgeList.end(); itPolyEdge++ ) {
 		double normalXYZ[3];
 		double currCurv;
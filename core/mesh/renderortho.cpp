@@ -0,0 +1,488 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/renderortho.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+#ifdef LIBZLIB
+    #include <zlib.h>
+#endif
+
+#define RENDERORTHO_VERTEX_BLOCK   65536   //!< Number of vertices projected per task.
+#define RENDERORTHO_MAX_PIXELS     ( static_cast<uint64_t>(1) << 31 ) //!< Limit to prevent accidental allocation of huge images.
+#define RENDERORTHO_PNG_IDAT_SIZE  ( 1 << 20 ) //!< Maximum size of an IDAT chunk written.
+#define RENDERORTHO_AMBIENT        0.2     //!< Ambient part of the lighting.
+
+namespace {
+	//! Projected vertex and its shaded colour.
+	struct sScreenVertex {
+		double mX;     //!< Column in pixels.
+		double mY;     //!< Row in pixels.
+		double mZ;     //!< Distance towards the camera.
+		float  mRGB[3];
+	};
+
+	//! Twice the signed area of the triangle (rA,rB,rC) - edge function of the rasterizer.
+	inline double edgeFunction( double rAx, double rAy, double rBx, double rBy, double rCx, double rCy ) {
+		return( ( rBx - rAx ) * ( rCy - rAy ) - ( rBy - rAy ) * ( rCx - rAx ) );
+	}
+
+	//! CRC as required for PNG chunks.
+	uint32_t crc32PNG( const uint8_t* rData, size_t rSize, uint32_t rCRC = 0 ) {
+		static const std::array<uint32_t,256> crcTable = []() {
+			std::array<uint32_t,256> table{};
+			for( uint32_t n = 0; n < 256; n++ ) {
+				uint32_t c = n;
+				for( int k = 0; k < 8; k++ ) {
+					c = ( c & 1 ) ? ( 0xEDB88320U ^ ( c >> 1 ) ) : ( c >> 1 );
+				}
+				table[n] = c;
+			}
+			return( table );
+		}();
+		uint32_t crc = rCRC ^ 0xFFFFFFFFU;
+		for( size_t i = 0; i < rSize; i++ ) {
+			crc = crcTable[( crc ^ rData[i] ) & 0xFF] ^ ( crc >> 8 );
+		}
+		return( crc ^ 0xFFFFFFFFU );
+	}
+
+	void appendUInt32BE( std::vector<uint8_t>& rBuffer, uint32_t rValue ) {
+		rBuffer.push_back( static_cast<uint8_t>( rValue >> 24 ) );
+		rBuffer.push_back( static_cast<uint8_t>( rValue >> 16 ) );
+		rBuffer.push_back( static_cast<uint8_t>( rValue >>  8 ) );
+		rBuffer.push_back( static_cast<uint8_t>( rValue ) );
+	}
+
+	//! Writes a PNG chunk i.e. length, type, data and CRC.
+	void writeChunkPNG( std::ofstream& rFile, const char* rType, const uint8_t* rData, size_t rSize ) {
+		std::vector<uint8_t> header;
+		appendUInt32BE( header, static_cast<uint32_t>( rSize ) );
+		header.insert( header.end(), rType, rType + 4 );
+		uint32_t crc = crc32PNG( &header[4], 4 );
+		crc = crc32PNG( rData, rSize, crc );
+		std::vector<uint8_t> footer;
+		appendUInt32BE( footer, crc );
+		rFile.write( reinterpret_cast<const char*>( header.data() ), static_cast<std::streamsize>( header.size() ) );
+		rFile.write( reinterpret_cast<const char*>( rData ), static_cast<std::streamsize>( rSize ) );
+		rFile.write( reinterpret_cast<const char*>( footer.data() ), static_cast<std::streamsize>( footer.size() ) );
+	}
+}
+
+//! Constructor fetching positions, normals, colours and function values of all vertices
+//! as well as the vertex indices of all faces.
+RenderOrtho::RenderOrtho( Mesh* rMesh ) {
+	PROFILE_SCOPE( "RenderOrtho::RenderOrtho" );
+	if( rMesh == nullptr ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: NULL pointer given!\n";
+		return;
+	}
+	const uint64_t vertexCount = rMesh->getVertexNr();
+	mPositions.resize( vertexCount * 3 );
+	mNormals.resize( vertexCount * 3 );
+	mVertexRGB.resize( vertexCount * 3 );
+	mFuncVals.resize( vertexCount );
+	// Single-threaded, because missing normals are estimated on demand.
+	for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+		Vertex* currVertex = rMesh->getVertexPos( vertIdx );
+		mPositions[vertIdx*3]   = currVertex->getX();
+		mPositions[vertIdx*3+1] = currVertex->getY();
+		mPositions[vertIdx*3+2] = currVertex->getZ();
+		currVertex->copyNormalXYZTo( &mNormals[vertIdx*3], true );
+		currVertex->copyRGBTo( &mVertexRGB[vertIdx*3] );
+		if( !currVertex->getFuncValue( &mFuncVals[vertIdx] ) ) {
+			mFuncVals[vertIdx] = _NOT_A_NUMBER_DBL_;
+		}
+	}
+	const uint64_t faceCount = rMesh->getFaceNr();
+	mFaceVerts.resize( faceCount * 3 );
+	for( uint64_t faceIdx = 0; faceIdx < faceCount; faceIdx++ ) {
+		Face* currFace = rMesh->getFacePos( faceIdx );
+		mFaceVerts[faceIdx*3]   = static_cast<uint64_t>( currFace->getVertA()->getIndex() );
+		mFaceVerts[faceIdx*3+1] = static_cast<uint64_t>( currFace->getVertB()->getIndex() );
+		mFaceVerts[faceIdx*3+2] = static_cast<uint64_t>( currFace->getVertC()->getIndex() );
+	}
+}
+
+//! Renders an orthographic view of the mesh.
+//!
+//! 1. Vertices are projected and shaded in parallel.
+//! 2. Faces are binned into tiles - each thread bins a contiguous range of faces.
+//! 3. Tiles are rastered in parallel. Within a tile the faces are processed
+//!    in ascending order, so the image is independent of the number of threads.
+//!
+//! @returns false in case of an error.
+bool RenderOrtho::render(
+                const sView&   rView,     //!< Direction of the view.
+                const sParams& rParams,   //!< Resolution, colours, etc.
+                sImage&        rImage     //!< Resulting image.
+) const {
+	PROFILE_SCOPE( "RenderOrtho::render" );
+	if( mPositions.empty() ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: No vertices!\n";
+		return( false );
+	}
+	if( !( rParams.mDPI > 0.0 ) || ( rParams.mTileSize == 0 ) ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: DPI and tile size have to be positive!\n";
+		return( false );
+	}
+	const unsigned int threadCount = ParallelFor::getThreadCount( rParams.mThreadCount );
+
+	// Orthonormal base of the view:
+	Vector3D axisZ = rView.mToCamera;
+	Vector3D axisX = rView.mUp % rView.mToCamera;
+	if( !( axisZ.normalize3() > 0.0 ) || !( axisX.normalize3() > 0.0 ) ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: Invalid view " << rView.mName << " - up vector parallel to the direction of the view!\n";
+		return( false );
+	}
+	Vector3D axisY = axisZ % axisX;
+	const double pixelsPerUnit = rParams.mDPI / 25.4; // mm assumed
+
+	// Function value range:
+	double funcValMin = rParams.mFuncValMin;
+	double funcValMax = rParams.mFuncValMax;
+	if( rParams.mColoring == COLOR_FUNCTION_VALUE && ( !std::isfinite( funcValMin ) || !std::isfinite( funcValMax ) ) ) {
+		double minFound = +std::numeric_limits<double>::infinity();
+		double maxFound = -std::numeric_limits<double>::infinity();
+		for( const double funcVal : mFuncVals ) {
+			if( std::isfinite( funcVal ) ) {
+				minFound = std::min( minFound, funcVal );
+				maxFound = std::max( maxFound, funcVal );
+			}
+		}
+		if( !std::isfinite( funcValMin ) ) {
+			funcValMin = minFound;
+		}
+		if( !std::isfinite( funcValMax ) ) {
+			funcValMax = maxFound;
+		}
+	}
+	const double funcValRange = ( funcValMax > funcValMin ) ? ( funcValMax - funcValMin ) : 1.0;
+
+	// 1. Project and shade vertices
+	//----------------------------------------------------------
+	const uint64_t vertexCount = mFuncVals.size();
+	std::vector<sScreenVertex> screenVerts( vertexCount );
+	const uint64_t vertexChunks = ( vertexCount + RENDERORTHO_VERTEX_BLOCK - 1 ) / RENDERORTHO_VERTEX_BLOCK;
+	std::vector<double> chunkMinX( vertexChunks, +std::numeric_limits<double>::infinity() );
+	std::vector<double> chunkMaxX( vertexChunks, -std::numeric_limits<double>::infinity() );
+	std::vector<double> chunkMinY( vertexChunks, +std::numeric_limits<double>::infinity() );
+	std::vector<double> chunkMaxY( vertexChunks, -std::numeric_limits<double>::infinity() );
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min<uint64_t>( ( rChunkIdx + 1 ) * RENDERORTHO_VERTEX_BLOCK, vertexCount );
+		for( uint64_t vertIdx = rChunkIdx * RENDERORTHO_VERTEX_BLOCK; vertIdx < vertIdxEnd; vertIdx++ ) {
+			const double* pos = &mPositions[vertIdx*3];
+			sScreenVertex& screenVert = screenVerts[vertIdx];
+			// World coordinates along the axis of the view - converted to pixels below.
+			screenVert.mX = pos[0]*axisX.getX() + pos[1]*axisX.getY() + pos[2]*axisX.getZ();
+			screenVert.mY = pos[0]*axisY.getX() + pos[1]*axisY.getY() + pos[2]*axisY.getZ();
+			screenVert.mZ = pos[0]*axisZ.getX() + pos[1]*axisZ.getY() + pos[2]*axisZ.getZ();
+			if( std::isfinite( screenVert.mX ) && std::isfinite( screenVert.mY ) ) {
+				chunkMinX[rChunkIdx] = std::min( chunkMinX[rChunkIdx], screenVert.mX );
+				chunkMaxX[rChunkIdx] = std::max( chunkMaxX[rChunkIdx], screenVert.mX );
+				chunkMinY[rChunkIdx] = std::min( chunkMinY[rChunkIdx], screenVert.mY );
+				chunkMaxY[rChunkIdx] = std::max( chunkMaxY[rChunkIdx], screenVert.mY );
+			}
+			if( rParams.mDepthOnly ) {
+				continue;
+			}
+			// Base colour
+			float rgb[3] { rParams.mSolidRGB[0] / 255.0f, rParams.mSolidRGB[1] / 255.0f, rParams.mSolidRGB[2] / 255.0f };
+			if( rParams.mColoring == COLOR_VERTEX_RGB ) {
+				for( int i = 0; i < 3; i++ ) {
+					rgb[i] = mVertexRGB[vertIdx*3+i] / 255.0f;
+				}
+			} else if( rParams.mColoring == COLOR_FUNCTION_VALUE && std::isfinite( mFuncVals[vertIdx] ) ) {
+				const double gray = std::clamp( ( mFuncVals[vertIdx] - funcValMin ) / funcValRange, 0.0, 1.0 );
+				rgb[0] = rgb[1] = rgb[2] = static_cast<float>( gray );
+			}
+			// Headlight - two-sided as the orientation of the faces is not necessarily consistent.
+			float intensity = 1.0f;
+			if( rParams.mLighting ) {
+				const float* normal = &mNormals[vertIdx*3];
+				double cosAngle = std::fabs( normal[0]*axisZ.getX() + normal[1]*axisZ.getY() + normal[2]*axisZ.getZ() );
+				if( !std::isfinite( cosAngle ) ) {
+					cosAngle = 1.0;
+				}
+				intensity = static_cast<float>( RENDERORTHO_AMBIENT + ( 1.0 - RENDERORTHO_AMBIENT ) * std::min( cosAngle, 1.0 ) );
+			}
+			for( int i = 0; i < 3; i++ ) {
+				screenVert.mRGB[i] = rgb[i] * intensity;
+			}
+		}
+	} );
+	const double minX = *std::min_element( chunkMinX.begin(), chunkMinX.end() );
+	const double maxX = *std::max_element( chunkMaxX.begin(), chunkMaxX.end() );
+	const double minY = *std::min_element( chunkMinY.begin(), chunkMinY.end() );
+	const double maxY = *std::max_element( chunkMaxY.begin(), chunkMaxY.end() );
+	if( !std::isfinite( minX ) || !std::isfinite( minY ) ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: No finite vertex coordinates!\n";
+		return( false );
+	}
+
+	// Setup image
+	const double imageWidth  = std::floor( ( maxX - minX ) * pixelsPerUnit ) + 1.0;
+	const double imageHeight = std::floor( ( maxY - minY ) * pixelsPerUnit ) + 1.0;
+	if( imageWidth * imageHeight > static_cast<double>( RENDERORTHO_MAX_PIXELS ) ) {
+		LOG::error() << "[RenderOrtho::" << __FUNCTION__ << "] ERROR: Image of " << imageWidth << " x " << imageHeight
+		             << " pixels is too large! Reduce the DPI.\n";
+		return( false );
+	}
+	rImage.mWidth         = static_cast<uint64_t>( imageWidth );
+	rImage.mHeight        = static_cast<uint64_t>( imageHeight );
+	rImage.mDPI           = rParams.mDPI;
+	rImage.mAxisX         = axisX;
+	rImage.mAxisY         = axisY;
+	rImage.mAxisZ         = axisZ;
+	rImage.mMinX          = minX;
+	rImage.mMaxY          = maxY;
+	rImage.mPixelsPerUnit = pixelsPerUnit;
+	if( rParams.mDepthOnly ) {
+		rImage.mRGB.clear();
+	} else {
+		rImage.mRGB.resize( rImage.mWidth * rImage.mHeight * 3 );
+		for( uint64_t pixelIdx = 0; pixelIdx < rImage.mWidth * rImage.mHeight; pixelIdx++ ) {
+			std::copy( rParams.mBackgroundRGB, rParams.mBackgroundRGB + 3, &rImage.mRGB[pixelIdx*3] );
+		}
+	}
+	rImage.mDepth.assign( rImage.mWidth * rImage.mHeight, -std::numeric_limits<float>::infinity() );
+
+	// Convert to pixels - row zero is at the top.
+	ParallelFor::forEachChunk( vertexChunks, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t vertIdxEnd = std::min<uint64_t>( ( rChunkIdx + 1 ) * RENDERORTHO_VERTEX_BLOCK, vertexCount );
+		for( uint64_t vertIdx = rChunkIdx * RENDERORTHO_VERTEX_BLOCK; vertIdx < vertIdxEnd; vertIdx++ ) {
+			screenVerts[vertIdx].mX = ( screenVerts[vertIdx].mX - minX ) * pixelsPerUnit;
+			screenVerts[vertIdx].mY = ( maxY - screenVerts[vertIdx].mY ) * pixelsPerUnit;
+		}
+	} );
+
+	// 2. Bin faces into tiles
+	//----------------------------------------------------------
+	const uint64_t tileSize   = rParams.mTileSize;
+	const uint64_t tilesX     = ( rImage.mWidth  + tileSize - 1 ) / tileSize;
+	const uint64_t tilesY     = ( rImage.mHeight + tileSize - 1 ) / tileSize;
+	const uint64_t faceCount  = mFaceVerts.size() / 3;
+	const uint64_t binRanges  = std::max<uint64_t>( std::min<uint64_t>( threadCount, faceCount ), 1 );
+	// One set of bins per contiguous range of faces, so the order of the faces is kept.
+	std::vector<std::vector<std::vector<uint64_t>>> tileBins( binRanges, std::vector<std::vector<uint64_t>>( tilesX * tilesY ) );
+	ParallelFor::forEachChunk( binRanges, threadCount, [&]( uint64_t rRangeIdx ) {
+		const uint64_t faceIdxEnd = faceCount * ( rRangeIdx + 1 ) / binRanges;
+		for( uint64_t faceIdx = faceCount * rRangeIdx / binRanges; faceIdx < faceIdxEnd; faceIdx++ ) {
+			const sScreenVertex& vertA = screenVerts[mFaceVerts[faceIdx*3]];
+			const sScreenVertex& vertB = screenVerts[mFaceVerts[faceIdx*3+1]];
+			const sScreenVertex& vertC = screenVerts[mFaceVerts[faceIdx*3+2]];
+			const double faceMinX = std::min( { vertA.mX, vertB.mX, vertC.mX } );
+			const double faceMaxX = std::max( { vertA.mX, vertB.mX, vertC.mX } );
+			const double faceMinY = std::min( { vertA.mY, vertB.mY, vertC.mY } );
+			const double faceMaxY = std::max( { vertA.mY, vertB.mY, vertC.mY } );
+			if( !std::isfinite( faceMinX + faceMaxX + faceMinY + faceMaxY ) ) {
+				continue;
+			}
+			const uint64_t tileX0 = std::min( static_cast<uint64_t>( std::max( faceMinX, 0.0 ) ) / tileSize, tilesX - 1 );
+			const uint64_t tileX1 = std::min( static_cast<uint64_t>( std::max( faceMaxX, 0.0 ) ) / tileSize, tilesX - 1 );
+			const uint64_t tileY0 = std::min( static_cast<uint64_t>( std::max( faceMinY, 0.0 ) ) / tileSize, tilesY - 1 );
+			const uint64_t tileY1 = std::min( static_cast<uint64_t>( std::max( faceMaxY, 0.0 ) ) / tileSize, tilesY - 1 );
+			for( uint64_t tileY = tileY0; tileY <= tileY1; tileY++ ) {
+				for( uint64_t tileX = tileX0; tileX <= tileX1; tileX++ ) {
+					tileBins[rRangeIdx][tileY*tilesX+tileX].push_back( faceIdx );
+				}
+			}
+		}
+	} );
+
+	// 3. Raster tiles
+	//----------------------------------------------------------
+	// Tiles cover disjoint parts of the image, so they write directly into the image and its depth buffer.
+	ParallelFor::forEachChunk( tilesX * tilesY, threadCount, [&]( uint64_t rTileIdx ) {
+		const int64_t tilePixelX0 = static_cast<int64_t>( ( rTileIdx % tilesX ) * tileSize );
+		const int64_t tilePixelY0 = static_cast<int64_t>( ( rTileIdx / tilesX ) * tileSize );
+		const int64_t tilePixelX1 = std::min<int64_t>( tilePixelX0 + tileSize, rImage.mWidth  ) - 1;
+		const int64_t tilePixelY1 = std::min<int64_t>( tilePixelY0 + tileSize, rImage.mHeight ) - 1;
+		for( uint64_t rangeIdx = 0; rangeIdx < binRanges; rangeIdx++ ) {
+			for( const uint64_t faceIdx : tileBins[rangeIdx][rTileIdx] ) {
+				const sScreenVertex& vertA = screenVerts[mFaceVerts[faceIdx*3]];
+				const sScreenVertex& vertB = screenVerts[mFaceVerts[faceIdx*3+1]];
+				const sScreenVertex& vertC = screenVerts[mFaceVerts[faceIdx*3+2]];
+				const double area = edgeFunction( vertA.mX, vertA.mY, vertB.mX, vertB.mY, vertC.mX, vertC.mY );
+				if( area == 0.0 || !std::isfinite( area ) ) {
+					continue;
+				}
+				const double areaInv = 1.0 / area;
+				// Pixels with their center inside the bounding box of the face:
+				const int64_t pixelX0 = std::max<int64_t>( tilePixelX0, static_cast<int64_t>( std::ceil(  std::min( { vertA.mX, vertB.mX, vertC.mX } ) - 0.5 ) ) );
+				const int64_t pixelX1 = std::min<int64_t>( tilePixelX1, static_cast<int64_t>( std::floor( std::max( { vertA.mX, vertB.mX, vertC.mX } ) - 0.5 ) ) );
+				const int64_t pixelY0 = std::max<int64_t>( tilePixelY0, static_cast<int64_t>( std::ceil(  std::min( { vertA.mY, vertB.mY, vertC.mY } ) - 0.5 ) ) );
+				const int64_t pixelY1 = std::min<int64_t>( tilePixelY1, static_cast<int64_t>( std::floor( std::max( { vertA.mY, vertB.mY, vertC.mY } ) - 0.5 ) ) );
+				for( int64_t pixelY = pixelY0; pixelY <= pixelY1; pixelY++ ) {
+					const double centerY = static_cast<double>( pixelY ) + 0.5;
+					for( int64_t pixelX = pixelX0; pixelX <= pixelX1; pixelX++ ) {
+						const double centerX = static_cast<double>( pixelX ) + 0.5;
+						// Barycentric coordinates - normalized by the signed area, so the orientation does not matter.
+						const double weightA = edgeFunction( vertB.mX, vertB.mY, vertC.mX, vertC.mY, centerX, centerY ) * areaInv;
+						const double weightB = edgeFunction( vertC.mX, vertC.mY, vertA.mX, vertA.mY, centerX, centerY ) * areaInv;
+						const double weightC = 1.0 - weightA - weightB;
+						if( weightA < 0.0 || weightB < 0.0 || weightC < 0.0 ) {
+							continue;
+						}
+						const float depth = static_cast<float>( weightA*vertA.mZ + weightB*vertB.mZ + weightC*vertC.mZ );
+						const uint64_t pixelIdx = static_cast<uint64_t>( pixelY ) * rImage.mWidth + static_cast<uint64_t>( pixelX );
+						if( !( depth > rImage.mDepth[pixelIdx] ) ) {
+							continue;
+						}
+						rImage.mDepth[pixelIdx] = depth;
+						if( rParams.mDepthOnly ) {
+							continue;
+						}
+						for( int i = 0; i < 3; i++ ) {
+							const double channel = weightA*vertA.mRGB[i] + weightB*vertB.mRGB[i] + weightC*vertC.mRGB[i];
+							rImage.mRGB[pixelIdx*3+i] = static_cast<uint8_t>( std::clamp( std::round( channel * 255.0 ), 0.0, 255.0 ) );
+						}
+					}
+				}
+			}
+		}
+	} );
+
+	return( true );
+}
+
+//! Six views as written by MeshWidget::screenshotViews using horizontal rotation (cuneiform style).
+//! The names match the files written by the GUI e.g. '01_ha_top'.
+std::vector<RenderOrtho::sView> RenderOrtho::getSixViews() {
+	return( std::vector<sView> {
+	        { "01_ha_top",    Vector3D(  0.0,  1.0,  0.0 ), Vector3D( 0.0,  0.0, -1.0 ) },
+	        { "02_ha_left",   Vector3D( -1.0,  0.0,  0.0 ), Vector3D( 0.0,  1.0,  0.0 ) },
+	        { "03_ha_front",  Vector3D(  0.0,  0.0,  1.0 ), Vector3D( 0.0,  1.0,  0.0 ) },
+	        { "04_ha_right",  Vector3D(  1.0,  0.0,  0.0 ), Vector3D( 0.0,  1.0,  0.0 ) },
+	        { "05_ha_bottom", Vector3D(  0.0, -1.0,  0.0 ), Vector3D( 0.0,  0.0,  1.0 ) },
+	        { "06_ha_back",   Vector3D(  0.0,  0.0, -1.0 ), Vector3D( 0.0, -1.0,  0.0 ) }
+	} );
+}
+
+//! Projects a position in world coordinates into the image.
+//! @returns false, when the position is not finite.
+bool RenderOrtho::sImage::project(
+                const Vector3D& rPosition,
+                double&         rPixelX,     //!< Column - pixel centers are at x.5
+                double&         rPixelY,     //!< Row - pixel centers are at y.5
+                double&         rDepth       //!< Distance towards the camera as stored in mDepth.
+) const {
+	rPixelX = ( dot3( rPosition, mAxisX ) - mMinX ) * mPixelsPerUnit;
+	rPixelY = ( mMaxY - dot3( rPosition, mAxisY ) ) * mPixelsPerUnit;
+	rDepth  = dot3( rPosition, mAxisZ );
+	return( std::isfinite( rPixelX ) && std::isfinite( rPixelY ) && std::isfinite( rDepth ) );
+}
+
+//! Writes the image as RGB PNG including the resolution (pHYs).
+//! The image data is compressed with the default level of zlib.
+//! Without zlib it is stored uncompressed (deflate type 0).
+//! @returns false in case of an error.
+bool RenderOrtho::sImage::writePNG( const std::filesystem::path& rFileName ) const {
+	PROFILE_SCOPE( "RenderOrtho::sImage::writePNG" );
+	if( mWidth == 0 || mHeight == 0 || mRGB.size() != mWidth * mHeight * 3 ) {
+		LOG::error() << "[RenderOrtho::sImage::" << __FUNCTION__ << "] ERROR: Empty image!\n";
+		return( false );
+	}
+	std::ofstream filePNG( rFileName, std::ios::binary );
+	if( !filePNG.is_open() ) {
+		LOG::error() << "[RenderOrtho::sImage::" << __FUNCTION__ << "] ERROR: Could not open " << rFileName << " for writing!\n";
+		return( false );
+	}
+	const uint8_t signature[8] { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	filePNG.write( reinterpret_cast<const char*>( signature ), 8 );
+
+	// Header: 8 bit RGB, no interlace.
+	std::vector<uint8_t> chunkData;
+	appendUInt32BE( chunkData, static_cast<uint32_t>( mWidth ) );
+	appendUInt32BE( chunkData, static_cast<uint32_t>( mHeight ) );
+	chunkData.insert( chunkData.end(), { 8, 2, 0, 0, 0 } );
+	writeChunkPNG( filePNG, "IHDR", chunkData.data(), chunkData.size() );
+
+	// Resolution in pixels per meter.
+	chunkData.clear();
+	const uint32_t pixelsPerMeter = static_cast<uint32_t>( std::round( mDPI / 0.0254 ) );
+	appendUInt32BE( chunkData, pixelsPerMeter );
+	appendUInt32BE( chunkData, pixelsPerMeter );
+	chunkData.push_back( 1 );
+	writeChunkPNG( filePNG, "pHYs", chunkData.data(), chunkData.size() );
+
+	// zlib stream. Each row is prefixed with filter type 0.
+	const uint64_t rowSize = mWidth * 3 + 1;
+	std::vector<uint8_t> rawData( rowSize * mHeight );
+	for( uint64_t row = 0; row < mHeight; row++ ) {
+		rawData[row*rowSize] = 0;
+		std::copy( &mRGB[row*mWidth*3], &mRGB[row*mWidth*3] + mWidth*3, &rawData[row*rowSize+1] );
+	}
+#ifdef LIBZLIB
+	uLongf zlibSize = compressBound( rawData.size() );
+	std::vector<uint8_t> zlibData( zlibSize );
+	if( compress2( zlibData.data(), &zlibSize, rawData.data(), rawData.size(), Z_DEFAULT_COMPRESSION ) != Z_OK ) {
+		LOG::error() << "[RenderOrtho::sImage::" << __FUNCTION__ << "] ERROR: Compressing the image data failed!\n";
+		return( false );
+	}
+	zlibData.resize( zlibSize );
+#else
+	std::vector<uint8_t> zlibData { 0x78, 0x01 };
+	zlibData.reserve( rawData.size() + rawData.size() / 65535 * 5 + 16 );
+	uint32_t adlerA = 1;
+	uint32_t adlerB = 0;
+	for( uint64_t offset = 0; offset < rawData.size() || offset == 0; offset += 65535 ) {
+		const uint16_t blockSize = static_cast<uint16_t>( std::min<uint64_t>( 65535, rawData.size() - offset ) );
+		const bool     lastBlock = ( offset + blockSize >= rawData.size() );
+		zlibData.push_back( lastBlock ? 1 : 0 );
+		zlibData.push_back( static_cast<uint8_t>( blockSize & 0xFF ) );
+		zlibData.push_back( static_cast<uint8_t>( blockSize >> 8 ) );
+		zlibData.push_back( static_cast<uint8_t>( ~blockSize & 0xFF ) );
+		zlibData.push_back( static_cast<uint8_t>( ( ~blockSize >> 8 ) & 0xFF ) );
+		zlibData.insert( zlibData.end(), rawData.begin() + offset, rawData.begin() + offset + blockSize );
+		for( uint64_t i = offset; i < offset + blockSize; i++ ) {
+			adlerA = ( adlerA + rawData[i] ) % 65521;
+			adlerB = ( adlerB + adlerA ) % 65521;
+		}
+		if( lastBlock ) {
+			break;
+		}
+	}
+	appendUInt32BE( zlibData, ( adlerB << 16 ) | adlerA );
+#endif
+	for( uint64_t offset = 0; offset < zlibData.size(); offset += RENDERORTHO_PNG_IDAT_SIZE ) {
+		writeChunkPNG( filePNG, "IDAT", &zlibData[offset],
+		               std::min<uint64_t>( RENDERORTHO_PNG_IDAT_SIZE, zlibData.size() - offset ) );
+	}
+	writeChunkPNG( filePNG, "IEND", nullptr, 0 );
+
+	if( !filePNG.good() ) {
+		LOG::error() << "[RenderOrtho::sImage::" << __FUNCTION__ << "] ERROR: Writing " << rFileName << " failed!\n";
+		return( false );
+	}
+	return( true );
+}
@@ -42,7 +42,7 @@ ShowProgress::ShowProgress(
 void ShowProgress::showProgressStart(
                 const std::string& rMsg
 ) {
-	mProgressStarted = clock();
+	mProgressStarted = std::chrono::steady_clock::now();
 	mLastTimeStamp = mProgressStarted;
 	std::cout << mPrefix << rMsg << " --- Begin." << std::endl;
 }
@@ -59,17 +59,17 @@ bool ShowProgress::showProgress(
                 const std::string& rMsg
 ) {
 	// Fetch timestamp from last update.
-	double lastSignal = mLastTimeStamp;
-	if( ( ( clock() - lastSignal ) / CLOCKS_PER_SEC ) < 2.0 ) { // Wait between firing signals.
+	const auto timeStampNow = std::chrono::steady_clock::now();
+	if( std::chrono::duration<double>( timeStampNow - mLastTimeStamp ).count() < 2.0 ) { // Wait between firing signals.
 		// Do nothing to prevent a DOS by sending to many signals.
 		return( false );
 	}
 	// Set timestamp
-	mLastTimeStamp = clock();
+	mLastTimeStamp = timeStampNow;
 
 	//! \todo there are certainly more elegant ways to format time into useful/readable units.
 	// Compute progress on the console:
-	double timeElapsed = static_cast<double>( mLastTimeStamp - mProgressStarted ) / CLOCKS_PER_SEC;
+	double timeElapsed = std::chrono::duration<double>( mLastTimeStamp - mProgressStarted ).count();
 	double timeRemaining = round( 10.0 * (( timeElapsed / rVal ) - ( timeElapsed )) ) / 10.0;
 	std::string timeRemainingUnit = "sec";
 	if( timeRemaining > ( 24.0 * 3600.0 ) ) {
@@ -95,7 +95,7 @@ bool ShowProgress::showProgress(
 void ShowProgress::showProgressStop(
                 const std::string& rMsg
 ) {
-	double timeElapsed = ( static_cast<double>(clock()) - mProgressStarted ) / CLOCKS_PER_SEC;
+	double timeElapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - mProgressStarted ).count();
 	std::cout << mPrefix << rMsg << " --- Done."
 	             " Processing took " << timeElapsed << " seconds." << std::endl;
 }
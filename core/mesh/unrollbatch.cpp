@@ -0,0 +1,204 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/unrollbatch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+using namespace std;
+
+namespace {
+	//! Positions per chunk processed by one thread.
+	constexpr uint64_t positionsPerChunk = 16384;
+}
+
+//! Constructor - use the factory methods.
+UnrollBatch::UnrollBatch( eSurface rSurface ) : mSurface( rSurface ) {
+	// Nothing else to do.
+}
+
+//! Truncated cone around the y-axis - see Vertex::unrollAroundCone.
+UnrollBatch UnrollBatch::cone(
+                double rCutHeight1,   //!< Lower clipping plane defined by the height of the cone (y-coordinate)
+                double rCutHeight2,   //!< Upper clipping plane defined by the height of the cone (y-coordinate)
+                double rConeAngle,    //!< Angle of the cone.
+                double rPrimeMeridian //!< Offset of the prime Meridian. Defines the cutting position of the cone.
+) {
+	UnrollBatch unrollBatch( UNROLL_CONE );
+	unrollBatch.mPrimeMeridian        = rPrimeMeridian;
+	unrollBatch.mHeightMin            = std::min( rCutHeight1, rCutHeight2 );
+	unrollBatch.mHeightMax            = std::max( rCutHeight1, rCutHeight2 );
+	unrollBatch.mHalfPiMinusConeAngle = M_PI/2.0 - rConeAngle;
+	unrollBatch.mSinConeAngle         = sin( rConeAngle );
+	return( unrollBatch );
+}
+
+//! Infinite cylinder around the y-axis - see Vertex::unrollAroundCylinderRadius.
+UnrollBatch UnrollBatch::cylinderRadius(
+                double rRadius,       //!< Radius of the cylinder.
+                double rPrimeMeridian //!< Offset of the prime Meridian. Defines the cutting position of the cylinder.
+) {
+	UnrollBatch unrollBatch( UNROLL_CYLINDER_RADIUS );
+	unrollBatch.mPrimeMeridian = rPrimeMeridian;
+	unrollBatch.mRadius        = rRadius;
+	return( unrollBatch );
+}
+
+//! Sphere centered in the origin - see Vertex::unrollAroundSphere.
+UnrollBatch UnrollBatch::sphere(
+                double rPrimeMeridian, //!< Meridian onto which projection is centered.
+                double rSphereRadius   //!< Radius of fitted sphere.
+) {
+	UnrollBatch unrollBatch( UNROLL_SPHERE );
+	unrollBatch.mPrimeMeridian = rPrimeMeridian;
+	unrollBatch.mRadius        = rSphereRadius;
+	return( unrollBatch );
+}
+
+//! Unrolls the given positions in place.
+//!
+//! @returns the number of positions, which could not be unrolled. Their flags are set to 1, all others to 0.
+uint64_t UnrollBatch::apply(
+                double*      rPosX,       //!< x-coordinates.
+                double*      rPosY,       //!< y-coordinates.
+                double*      rPosZ,       //!< z-coordinates.
+                uint8_t*     rFailed,     //!< Byte mask of positions not unrolled.
+                uint64_t     rCount,      //!< Number of positions.
+                unsigned int rThreadCount //!< Number of threads - zero uses all available cores.
+) const {
+	PROFILE_SCOPE( "UnrollBatch::apply" );
+	if( rCount == 0 ) {
+		return( 0 );
+	}
+	const unsigned int threadCount = ( rThreadCount == 0 ) ? ParallelFor::getThreadCount() : rThreadCount;
+	const uint64_t     chunkCount  = ParallelFor::getChunkCount( rCount, positionsPerChunk );
+	std::vector<uint64_t> failedPerChunk( chunkCount, 0 );
+	ParallelFor::forEachChunk( chunkCount, threadCount, [&]( uint64_t rChunkIdx ) {
+		const uint64_t posIdxStart = rChunkIdx * positionsPerChunk;
+		const uint64_t posIdxEnd   = std::min( posIdxStart + positionsPerChunk, rCount );
+		uint64_t failedCount = 0;
+		switch( mSurface ) {
+			case UNROLL_CONE:
+				for( uint64_t posIdx=posIdxStart; posIdx<posIdxEnd; posIdx++ ) {
+					const bool unrolled = unrollCone( rPosX[posIdx], rPosY[posIdx], rPosZ[posIdx] );
+					rFailed[posIdx] = !unrolled;
+					failedCount += !unrolled;
+				}
+				break;
+			case UNROLL_CYLINDER_RADIUS:
+				for( uint64_t posIdx=posIdxStart; posIdx<posIdxEnd; posIdx++ ) {
+					unrollCylinderRadius( rPosX[posIdx], rPosY[posIdx], rPosZ[posIdx] );
+					rFailed[posIdx] = 0;
+				}
+				break;
+			case UNROLL_SPHERE:
+				for( uint64_t posIdx=posIdxStart; posIdx<posIdxEnd; posIdx++ ) {
+					unrollSphere( rPosX[posIdx], rPosY[posIdx], rPosZ[posIdx] );
+					rFailed[posIdx] = 0;
+				}
+				break;
+		}
+		failedPerChunk[rChunkIdx] = failedCount;
+	} );
+	uint64_t failedCount = 0;
+	for( const uint64_t failedInChunk : failedPerChunk ) {
+		failedCount += failedInChunk;
+	}
+	return( failedCount );
+}
+
+//! Unrolls a position of a truncated cone.
+//! @returns false for positions outside the clipping heights, which remain unchanged.
+bool UnrollBatch::unrollCone( double& rPosX, double& rPosY, double& rPosZ ) const {
+	if( rPosY < mHeightMin || rPosY > mHeightMax ) {
+		return( false );
+	}
+
+	double phi   = atan2( rPosZ, rPosX ); // vertex angle in cylindrical coordinates
+	double r     = sqrt( rPosX*rPosX + rPosY*rPosY + rPosZ*rPosZ ); // vertex distance to origin
+	double beta  = asin( rPosY/r ); // vertex angle of the spherical coordinate system
+	double delta = mHalfPiMinusConeAngle - beta; // 'offset' angle between the cone and the vertex
+
+	phi += mPrimeMeridian; // Offset for the cut
+	if( phi > M_PI ) {
+		phi -= 2.0*M_PI;
+	} else if( phi < -M_PI ) {
+		phi += 2.0*M_PI;
+	}
+
+	const double s = r * cos( delta ); // Distance to cone tip along the cone's surface.
+	const double d = r * sin( delta ); // Orthogonal (minimal) distance of the point to cone's surface.
+
+	// Degenerated case: cone becomes cylinder
+	if( mSinConeAngle == 0.0 ) {
+		rPosX = d * phi;
+		rPosZ = -d;
+		return( true );
+	}
+
+	const double coneCoordAngle = phi * mSinConeAngle;
+	rPosX = s * cos( coneCoordAngle );
+	rPosY = s * sin( coneCoordAngle );
+	rPosZ = d;
+	return( true );
+}
+
+//! Unrolls a position of an infinite cylinder.
+void UnrollBatch::unrollCylinderRadius( double& rPosX, [[maybe_unused]] double& rPosY, double& rPosZ ) const {
+	double phi = atan2( rPosX, rPosZ ); // vertex angle in cylindrical coordinates
+	const double d = sqrt( rPosX*rPosX + rPosZ*rPosZ ); // vertex distance to the axis
+
+	phi += mPrimeMeridian; // Offset for the cut
+	if( phi > M_PI ) {
+		phi -= 2.0*M_PI;
+	} else if( phi < -M_PI ) {
+		phi += 2.0*M_PI;
+	}
+
+	rPosX = mRadius * phi;
+	rPosZ = d;
+}
+
+//! Unrolls a position of a sphere using the equirectangular projection.
+void UnrollBatch::unrollSphere( double& rPosX, double& rPosY, double& rPosZ ) const {
+	const double r = sqrt( rPosX*rPosX + rPosY*rPosY + rPosZ*rPosZ );
+
+	double theta     = atan2( rPosZ, rPosX );
+	const double phi = acos( rPosY / r );
+
+	theta -= mPrimeMeridian;
+	if( theta > M_PI ) {
+		theta -= 2*M_PI;
+	} else if( theta < -M_PI ) {
+		theta += 2*M_PI;
+	}
+
+	rPosX = mRadius * theta;
+	rPosY = mRadius * phi;
+	rPosZ = r;
+}
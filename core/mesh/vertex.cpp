@@ -36,6 +36,7 @@
 
 #include <GigaMesh/mesh/face.h>
 #include <GigaMesh/mesh/edgegeodesic.h>
+#include <GigaMesh/mesh/visitedset.h>
 #include <GigaMesh/logging/Logging.h>
 
 // proper access to the center of gravity / position:
@@ -60,8 +61,9 @@
 	mIdx( _PRIMITIVE_NOT_INDEXED_ ),    \
 	mIdxOri( _PRIMITIVE_NOT_INDEXED_ ), \
 	mLabelNr( 0 ),                      \
-	mFeatureVecLen( 0 ),                \
-	mFeatureVec( NULL )                 \
+	mFeatureVecMatrix( nullptr ),       \
+	mFeatureVecRow( 0 ),                \
+	mFeatureVecOwned( false )           \
 
 using namespace std;
 
@@ -235,11 +237,7 @@ Vertex::~Vertex() {
 	//!
 	//! This is done just in case we referer to an object still in the memory,
 	//! which is already destroyed.
-	if( mFeatureVec != nullptr ) {
-		delete[] mFeatureVec;
-		mFeatureVecLen = 0;
-		mFeatureVec    = nullptr;
-	}
+	releaseFeatureVec();
 }
 
 // Indexing -------------------------------------------------------------------
@@ -301,6 +299,17 @@ bool Vertex::isMarked( const uint64_t* rVertBitArrayVisited ) {
 	return ( rVertBitArrayVisited[bitOffset] & bitPattern ) != 0;
 }
 
+//! Marks this vertex as visited within a VisitedSet.
+//! Returns the old state of the mark;
+bool Vertex::markVisited( VisitedSet& rVertsVisited ) {
+	return rVertsVisited.mark( static_cast<uint64_t>(mIdx) );
+}
+
+//! Returns the mark of the VisitedSet correspond to this vertices' index.
+bool Vertex::isMarked( const VisitedSet& rVertsVisited ) const {
+	return rVertsVisited.isMarked( static_cast<uint64_t>(mIdx) );
+}
+
 // Color managment -------------------------------------------------------------
 
 bool Vertex::setRGB( unsigned char setTexR, unsigned char setTexG, unsigned char setTexB ) {
@@ -759,6 +768,27 @@ bool Vertex::mark1RingVisited( [[maybe_unused]] uint64_t* rVertBitArrayVisited,
 	return true;
 }
 
+//! Relates to Mesh::fetchSphereBitArray using a VisitedSet instead of bit arrays.
+Vertex* Vertex::advanceInSphere( [[maybe_unused]] double*              sphereCenter,  //!< X, y and z-coordinate of the sphere's center
+                                 [[maybe_unused]] double               radius,        //!< Radius of the sphere.
+                                 [[maybe_unused]] VisitedSet&          rVertsVisited, //!< Visited vertices.
+                                 [[maybe_unused]] vector<Vertex*>*     nextArray,     //!< Vertices along the marching front.
+                                 [[maybe_unused]] VisitedSet&          rFacesVisited, //!< Visited faces.
+                                 [[maybe_unused]] bool                 rOrderToFuncVal,
+                                 [[maybe_unused]] double*              rSeqNr
+	) {
+	return nullptr;
+}
+
+//! Relates to Mesh::fetchSphereBitArray1R using a VisitedSet instead of bit arrays.
+bool Vertex::mark1RingVisited( [[maybe_unused]] VisitedSet& rVertsVisited,   //!< Visited vertices.
+                               [[maybe_unused]] VisitedSet& rFacesVisited,   //!< Visited faces.
+                               [[maybe_unused]] bool        rOrderToFuncVal,
+                               [[maybe_unused]] double*     rSeqNr
+	) {
+	return true;
+}
+
 // --- Function Values --------------------------------------------------------
 
 bool Vertex::setFuncValue( double setVal ) {
@@ -993,6 +1023,28 @@ bool Vertex::applyTransfrom( Matrix4D* transMat ) {
 	return( true );
 }
 
+//! Applies (multiplies) a homogenous transformation matrix given as array of
+//! its 16 elements ordered by the columns X, Y, Z and H of Matrix4D i.e.
+//! rTransMat[4*col+row] - with the same result as applyTransfrom.
+//!
+//! In contrast to applyTransfrom, the normal is not estimated, when it is not set.
+//! Therefore it is safe to call for all vertices of a mesh in parallel.
+//! See Mesh::applyTransformationToWholeMesh
+void Vertex::applyTransfromArray( const double* rTransMat ) {
+	const double posX = POS_X;
+	const double posY = POS_Y;
+	const double posZ = POS_Z;
+	POS_X = posX * rTransMat[0] + posY * rTransMat[4] + posZ * rTransMat[8]  + 1.0 * rTransMat[12];
+	POS_Y = posX * rTransMat[1] + posY * rTransMat[5] + posZ * rTransMat[9]  + 1.0 * rTransMat[13];
+	POS_Z = posX * rTransMat[2] + posY * rTransMat[6] + posZ * rTransMat[10] + 1.0 * rTransMat[14];
+	const double normalX = NORMAL_X;
+	const double normalY = NORMAL_Y;
+	const double normalZ = NORMAL_Z;
+	NORMAL_X = normalX * rTransMat[0] + normalY * rTransMat[4] + normalZ * rTransMat[8]  + 0.0 * rTransMat[12];
+	NORMAL_Y = normalX * rTransMat[1] + normalY * rTransMat[5] + normalZ * rTransMat[9]  + 0.0 * rTransMat[13];
+	NORMAL_Z = normalX * rTransMat[2] + normalY * rTransMat[6] + normalZ * rTransMat[10] + 0.0 * rTransMat[14];
+}
+
 bool Vertex::applyMeltingSphere( double rRadius, double rRel ) {
 	//! Applies melting with sqrt(r^2-x^2-y^2).
 	//! Returns false, when the application fails, when
@@ -1085,6 +1137,12 @@ bool Vertex::getAdjacentVerticesExcluding( [[maybe_unused]] vector<Vertex*>* rSo
 	return true;
 }
 
+//! Adds the adjacent vertices of the 1-ring to rSomeVerts, when they have not been marked in rVertsVisited.
+//! Will also mark the vertices added.
+bool Vertex::getAdjacentVerticesExcluding( [[maybe_unused]] vector<Vertex*>* rSomeVerts, [[maybe_unused]] VisitedSet& rVertsVisited ) {
+	return true;
+}
+
 //! Return the reference to next vertex on the border within the 1-ring neighbourhood.
 //! Considers the bit-array for vertices tagged unvisited.
 Vertex* Vertex::getAdjacentNextBorderVertex( [[maybe_unused]] uint64_t* rVertBitArrayUnVisited ) {
@@ -1197,6 +1255,18 @@ bool Vertex::isInverse() {
 	return( false );
 }
 
+//! Performs the checks isBorder, isNonManifold, isDoubleCone, isPartOfZeroFace
+//! and isInverse at once.
+//! @returns false in case of an error. True otherwise.
+bool Vertex::get1RingChecks( s1RingChecks& rChecks ) {
+	rChecks.mBorder         = isBorder();
+	rChecks.mNonManifold    = isNonManifold();
+	rChecks.mDoubleCone     = isDoubleCone();
+	rChecks.mPartOfZeroFace = isPartOfZeroFace();
+	rChecks.mInverse        = isInverse();
+	return( true );
+}
+
 //! Returns the state of a vertex.
 int Vertex::getState() {
 	if( isSolo() ) {
@@ -1555,6 +1625,10 @@ bool Vertex::getGeodesicEdgesSeed( deque<EdgeGeodesic*>* frontEdges, map<Vertex*
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 //! Assign a feature vectore stored in an external table.
+//!
+//! The vector is copied into a matrix owned by this vertex. Use setFeatureVecView
+//! to refer to a row of a matrix shared by all vertices e.g. of a Mesh.
+//!
 //! @returns false in case of an error (e.g. another vector already attached). True otherwise.
 bool Vertex::assignFeatureVec(const double*         rAttachFeatureVec,
         unsigned int rSetFeatureVecLen
@@ -1565,72 +1639,58 @@ bool Vertex::assignFeatureVec(const double*         rAttachFeatureVec,
 		return false;
 	}
 	// Erase existing vector:
-	if( mFeatureVec != nullptr ) {
-		delete[] mFeatureVec;
-		mFeatureVec = nullptr;
-		mFeatureVecLen = 0;
-	}
+	releaseFeatureVec();
 	// Nothing to do - empty vector.
 	if( rSetFeatureVecLen <= 0 ) {
 		return true;
 	}
 	// Create and copy vector:
-	mFeatureVecLen = rSetFeatureVecLen;
-	mFeatureVec    = new double[mFeatureVecLen];
-	// cout << "[Vertex::" << __FUNCTION__ << "] assign FV:";
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		mFeatureVec[i] = rAttachFeatureVec[i];
-		// cout << " " << mFeatureVec[i];
-	}
-	// cout << " to: " << mIdxOri << endl;
-	return true;
+	mFeatureVecMatrix = new FeatureVecMatrix();
+	mFeatureVecRow    = 0;
+	mFeatureVecOwned  = true;
+	return( mFeatureVecMatrix->assign( rAttachFeatureVec, 1, rSetFeatureVecLen ) );
 }
 
 
 bool Vertex::assignFeatureVec(const std::initializer_list<double> featureVectorValues)
 {
+	const std::vector<double> featureVectorCopy( featureVectorValues );
+	return( assignFeatureVec( featureVectorCopy.data(), static_cast<unsigned int>( featureVectorCopy.size() ) ) );
+}
 
-	// Erase existing vector:
-
-	if(mFeatureVec != nullptr)
-	{
-		delete[] mFeatureVec;
-		mFeatureVec = nullptr;
-		mFeatureVecLen = 0;
+//! Refer to a row of a matrix holding the feature vectors of many vertices e.g. owned by a Mesh.
+//! The matrix has to exist as long as this vertex refers to it. An existing vector is removed.
+//!
+//! @returns false in case of an error e.g. row out of range. True otherwise.
+bool Vertex::setFeatureVecView( FeatureVecMatrix* rFeatureVecMatrix, uint64_t rRow ) {
+	if( ( rFeatureVecMatrix != nullptr ) && ( rRow >= rFeatureVecMatrix->getRowCount() ) ) {
+		LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Row " << rRow << " out of range!\n";
+		return( false );
 	}
+	releaseFeatureVec();
+	mFeatureVecMatrix = rFeatureVecMatrix;
+	mFeatureVecRow    = rRow;
+	return( true );
+}
 
-	// Nothing to do - empty vector.
-
-	if(featureVectorValues.size() == 0)
-	{
-		return true;
+//! @returns true, when the feature vector refers to a row of the given matrix.
+//!          The row is returned by the optional rRow.
+bool Vertex::isFeatureVecView( const FeatureVecMatrix* rFeatureVecMatrix, uint64_t* rRow ) const {
+	if( ( rFeatureVecMatrix == nullptr ) || ( mFeatureVecMatrix != rFeatureVecMatrix ) ) {
+		return( false );
 	}
-
-	// Create and copy vector:
-
-	mFeatureVecLen = static_cast<unsigned int>(featureVectorValues.size());
-	mFeatureVec    = new double[mFeatureVecLen];
-
-	if(mFeatureVec != nullptr)
-	{
-		size_t featureVectorElementCount = 0;
-		
-		for(const double featureVectorValue : featureVectorValues)
-		{
-			mFeatureVec[featureVectorElementCount++] = featureVectorValue;
-		}
+	if( rRow != nullptr ) {
+		(*rRow) = mFeatureVecRow;
 	}
-
-	return true;
+	return( true );
 }
 
 //! Copies the feature vector to a given array, which has to be of proper length!
 //! @returns false in case of an error. True otherwise.
 bool Vertex::copyFeatureVecTo( double* rFetchFeatureVec ) const {
-	if(rFetchFeatureVec && mFeatureVec)
+	if( rFetchFeatureVec && mFeatureVecMatrix )
 	{
-		memcpy( rFetchFeatureVec, mFeatureVec, mFeatureVecLen*sizeof(double) );
-		return true;
+		return( mFeatureVecMatrix->getRow( mFeatureVecRow, rFetchFeatureVec ) );
 	}
 	
 	else
@@ -1648,29 +1708,57 @@ bool Vertex::copyFeatureVecTo( double* rFetchFeatureVec ) const {
 //!
 //! @returns false in case of an error. True otherwise.
 bool Vertex::assignFeatureVecValues( const vector<double>& newFeatureVec ) {
-	if( mFeatureVec == nullptr ) {
+	if( mFeatureVecMatrix == nullptr ) {
 		LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Can not write to feature vector - no memory resereved!\n";
 		return( false );
 	}
-	if( newFeatureVec.size() != mFeatureVecLen ) {
+	if( newFeatureVec.size() != getFeatureVecLenFast() ) {
 		LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Feature vector length do not match!\n";
 		return( false );
 	}
-	for( uint64_t i=0; i<mFeatureVecLen; i++ ) {
-		mFeatureVec[i] = newFeatureVec.at( i );
-	}
-	return( true );
+	return( mFeatureVecMatrix->setRow( mFeatureVecRow, newFeatureVec.data(), newFeatureVec.size() ) );
 }
 
 //! Appends the feature vector's elements to a given vector!
 //! @returns false in case of an error. True otherwise.
 bool Vertex::getFeatureVectorElements( vector<double>& rFeatVec ) const {
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		rFeatVec.push_back( mFeatureVec[i] );
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		rFeatVec.push_back( mFeatureVecMatrix->get( mFeatureVecRow, i ) );
 	}
 	return( true );
 }
 
+//! @returns the length of the feature vector - zero, when there is none.
+unsigned int Vertex::getFeatureVecLenFast() const {
+	if( mFeatureVecMatrix == nullptr ) {
+		return( 0 );
+	}
+	return( static_cast<unsigned int>( mFeatureVecMatrix->getColCount() ) );
+}
+
+//! @returns the feature vector in double precision or NULL, when there is none.
+//! For reduced precision the values are converted into the given buffer,
+//! otherwise the row of the matrix is returned directly.
+const double* Vertex::getFeatureVecDouble(
+                vector<double>& rBuffer   //!< Holds the converted values - has to outlive the returned pointer.
+) const {
+	if( mFeatureVecMatrix == nullptr ) {
+		return( nullptr );
+	}
+	return( mFeatureVecMatrix->getRowDouble( mFeatureVecRow, rBuffer ) );
+}
+
+//! Removes the feature vector. The matrix is only destroyed, when owned by this vertex.
+void Vertex::releaseFeatureVec() {
+	if( mFeatureVecOwned ) {
+		delete mFeatureVecMatrix;
+	}
+	mFeatureVecMatrix = nullptr;
+	mFeatureVecRow    = 0;
+	mFeatureVecOwned  = false;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
 // --- Norm of the feature vector ------------------------------------------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1684,24 +1772,27 @@ bool Vertex::getFeatureVecMeanStdDev(
         double* rFeatureVecMean, 
         double* rFeatureVecStdDev 
 ) const {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) ) {
+	if( featureVecLen == 0 ) {
 		return( false );
 	}
 
 	// Compute mean
 	double elementValueMean = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		elementValueMean += mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		elementValueMean += featureVec[i];
 	}
-	elementValueMean /= mFeatureVecLen;
+	elementValueMean /= featureVecLen;
 
 	// Compute standard deviation
 	double elementValueStd = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		elementValueStd += pow( mFeatureVec[i] - elementValueMean, 2.0 );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		elementValueStd += pow( featureVec[i] - elementValueMean, 2.0 );
 	}
-	elementValueMean = sqrt( elementValueMean / ( mFeatureVecLen-1 ) );
+	elementValueMean = sqrt( elementValueMean / ( featureVecLen-1 ) );
 
 	// Done - return values.
 	(*rFeatureVecMean)   = elementValueMean;
@@ -1713,13 +1804,16 @@ bool Vertex::getFeatureVecMeanStdDev(
 //! I.e. 1-Norm
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecLenMan( double* rFeatureVecLenMan ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) ) {
+	if( featureVecLen == 0 ) {
 		return false;
 	}
 	(*rFeatureVecLenMan) = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		(*rFeatureVecLenMan) += mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		(*rFeatureVecLenMan) += featureVec[i];
 	}
 	return true;
 }
@@ -1728,13 +1822,16 @@ bool Vertex::getFeatureVecLenMan( double* rFeatureVecLenMan ) {
 //! I.e. 2-Norm
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecLenEuc( double* rFeatureVecLenEuc ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) ) {
+	if( featureVecLen == 0 ) {
 		return false;
 	}
 	(*rFeatureVecLenEuc) = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		(*rFeatureVecLenEuc) += mFeatureVec[i] * mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		(*rFeatureVecLenEuc) += featureVec[i] * featureVec[i];
 	}
 	(*rFeatureVecLenEuc) = sqrt( (*rFeatureVecLenEuc) );
 	return true;
@@ -1744,14 +1841,17 @@ bool Vertex::getFeatureVecLenEuc( double* rFeatureVecLenEuc ) {
 //!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecMin( double* rFeatureVecMin ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) || ( rFeatureVecMin == nullptr ) ) {
+	if( ( featureVecLen == 0 ) || ( rFeatureVecMin == nullptr ) ) {
 		return( false );
 	}
 	double minValue = +_INFINITE_DBL_;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		if( minValue > mFeatureVec[i] ) {
-			minValue = mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		if( minValue > featureVec[i] ) {
+			minValue = featureVec[i];
 		}
 	}
 	(*rFeatureVecMin) = minValue;
@@ -1763,14 +1863,17 @@ bool Vertex::getFeatureVecMin( double* rFeatureVecMin ) {
 //!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecMax( double* rFeatureVecMax ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) || ( rFeatureVecMax == nullptr ) ) {
+	if( ( featureVecLen == 0 ) || ( rFeatureVecMax == nullptr ) ) {
 		return( false );
 	}
 	double maxValue = -_INFINITE_DBL_;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		if( maxValue < mFeatureVec[i] ) {
-			maxValue = mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		if( maxValue < featureVec[i] ) {
+			maxValue = featureVec[i];
 		}
 	}
 	(*rFeatureVecMax) = maxValue;
@@ -1781,14 +1884,17 @@ bool Vertex::getFeatureVecMax( double* rFeatureVecMax ) {
 //!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecMinSigned( double* rFeatureVecMinSigned ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) || ( rFeatureVecMinSigned == nullptr ) ) {
+	if( ( featureVecLen == 0 ) || ( rFeatureVecMinSigned == nullptr ) ) {
 		return( false );
 	}
 	double minValue = +_INFINITE_DBL_;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		if( abs( minValue ) > abs( mFeatureVec[i] ) ) {
-			minValue = mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		if( abs( minValue ) > abs( featureVec[i] ) ) {
+			minValue = featureVec[i];
 		}
 	}
 	(*rFeatureVecMinSigned) = minValue;
@@ -1799,14 +1905,17 @@ bool Vertex::getFeatureVecMinSigned( double* rFeatureVecMinSigned ) {
 //!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecMaxSigned( double* rFeatureVecMaxSigned ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) || ( rFeatureVecMaxSigned == nullptr ) ) {
+	if( ( featureVecLen == 0 ) || ( rFeatureVecMaxSigned == nullptr ) ) {
 		return( false );
 	}
 	double maxValue = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		if( abs( maxValue ) < abs( mFeatureVec[i] ) ) {
-			maxValue = mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		if( abs( maxValue ) < abs( featureVec[i] ) ) {
+			maxValue = featureVec[i];
 		}
 	}
 	(*rFeatureVecMaxSigned) = maxValue;
@@ -1819,18 +1928,21 @@ bool Vertex::getFeatureVecMaxSigned( double* rFeatureVecMaxSigned ) {
 //! Attention: this function is modified!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecBVFunc( double* rFeatureVecBVFunc ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) ) {
+	if( featureVecLen == 0 ) {
 		return false;
 	}
 
 	double maxVal = 0.0;
-	for( int i=mFeatureVecLen-1; i>0; i-- ) {
-		maxVal = max( abs( mFeatureVec[i] - mFeatureVec[i-1] ), maxVal );
+	for( int i=featureVecLen-1; i>0; i-- ) {
+		maxVal = max( abs( featureVec[i] - featureVec[i-1] ), maxVal );
 	}
 	//(*rFeatureVecBVFunc) = maxVal; // ORIGINAL BV - not used as the following presents more interesting results in combintaion with volume MSII feature vectors.
-	(*rFeatureVecBVFunc) = maxVal + mFeatureVec[mFeatureVecLen-1]; // MODIFIED BV !!!
-	//(*rFeatureVecBVFunc) = maxVal + abs( maxVal + mFeatureVec[mFeatureVecLen-1] ); // Modified BV with less interesting results
+	(*rFeatureVecBVFunc) = maxVal + featureVec[featureVecLen-1]; // MODIFIED BV !!!
+	//(*rFeatureVecBVFunc) = maxVal + abs( maxVal + featureVec[featureVecLen-1] ); // Modified BV with less interesting results
 
 	return true;
 }
@@ -1841,17 +1953,20 @@ bool Vertex::getFeatureVecBVFunc( double* rFeatureVecBVFunc ) {
 //! Attention: this function is modified!
 //! @returns false in case of an error i.e. no feature vector present. True otherwise.
 bool Vertex::getFeatureVecTVSeqn(double* rFeatureVecTVSeqn ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity check
-	if( ( mFeatureVecLen == 0 ) || ( mFeatureVec == nullptr ) ) {
+	if( featureVecLen == 0 ) {
 		return false;
 	}
 
 	//(*rFeatureVecTVSeqn) = 0.0; // Variant without the first element.
-	//(*rFeatureVecTVSeqn) = abs( mFeatureVec[0] ); // |a_1| - assuming that the feature vectors first element is the first of a seqeunce
-	//(*rFeatureVecTVSeqn) = abs( mFeatureVec[mFeatureVecLen-1] ); // |a_1| - as the feature vector typically contains large scales first (inverted sequence)
-	(*rFeatureVecTVSeqn) =  mFeatureVec[mFeatureVecLen-1]; // MODIFICATION: a_1 - as the feature vector typically contains large scales first (inverted sequence)
-	for( int i=mFeatureVecLen-1; i>0; i-- ) {
-		(*rFeatureVecTVSeqn) += abs( mFeatureVec[i] - mFeatureVec[i-1] );
+	//(*rFeatureVecTVSeqn) = abs( featureVec[0] ); // |a_1| - assuming that the feature vectors first element is the first of a seqeunce
+	//(*rFeatureVecTVSeqn) = abs( featureVec[featureVecLen-1] ); // |a_1| - as the feature vector typically contains large scales first (inverted sequence)
+	(*rFeatureVecTVSeqn) =  featureVec[featureVecLen-1]; // MODIFICATION: a_1 - as the feature vector typically contains large scales first (inverted sequence)
+	for( int i=featureVecLen-1; i>0; i-- ) {
+		(*rFeatureVecTVSeqn) += abs( featureVec[i] - featureVec[i-1] );
 	}
 
 	return true;
@@ -1865,9 +1980,12 @@ bool Vertex::getFeatureVecTVSeqn(double* rFeatureVecTVSeqn ) {
 //! I.e. 1-norm
 //! @returns Manhattan distance
 double Vertex::getFeatureDistManTo( double* rSomeFeatureVec ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	double dist = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		dist += abs( rSomeFeatureVec[i] - mFeatureVec[i] );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		dist += abs( rSomeFeatureVec[i] - featureVec[i] );
 	}
 	return dist;
 }
@@ -1876,9 +1994,12 @@ double Vertex::getFeatureDistManTo( double* rSomeFeatureVec ) {
 //! I.e. 2-norm
 //! @returns Euclidean distance.
 double Vertex::getFeatureDistEucTo( double* rSomeFeatureVec ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	double dist = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		dist += pow( rSomeFeatureVec[i] - mFeatureVec[i], 2.0 );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		dist += pow( rSomeFeatureVec[i] - featureVec[i], 2.0 );
 	}
 	dist = sqrt( dist );
 	return dist;
@@ -1889,9 +2010,12 @@ double Vertex::getFeatureDistEucTo( double* rSomeFeatureVec ) {
 //! I.e. Mahalanobis distance with a diagonal covariance matrix.
 //! @returns Normalized euclidean distance.
 double Vertex::getFeatureDistEucNormTo( double* rSomeFeatureVec, vector<double>* rFeatureVecStdDev ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	double dist = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		dist += pow( rSomeFeatureVec[i] - mFeatureVec[i], 2.0 ) / pow( (*rFeatureVecStdDev)[i], 2.0 );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		dist += pow( rSomeFeatureVec[i] - featureVec[i], 2.0 ) / pow( (*rFeatureVecStdDev)[i], 2.0 );
 	}
 	dist = sqrt( dist );
 	return dist;
@@ -1904,13 +2028,16 @@ double Vertex::getFeatureDistEucNormTo( double* rSomeFeatureVec, vector<double>*
 double Vertex::getFeatureVecCosSim( double* rSomeFeatureVec, //!< Reference feature vector.
                                     bool    rApplyACos       //!< If true the arccosine is returned. Otherwise the cosine is returned.
                                   ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	double nom    = 0.0;
 	double denomA = 0.0;
 	double denomB = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		nom    += rSomeFeatureVec[i] * mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		nom    += rSomeFeatureVec[i] * featureVec[i];
 		denomA += rSomeFeatureVec[i] * rSomeFeatureVec[i];
-		denomB += mFeatureVec[i] * mFeatureVec[i];
+		denomB += featureVec[i] * featureVec[i];
 	}
 	double dist = nom / ( sqrt( denomA ) * sqrt( denomB ) );
 	if( rApplyACos ) {
@@ -1926,13 +2053,16 @@ double Vertex::getFeatureVecCosSim( double* rSomeFeatureVec, //!< Reference feat
 //! \todo Add check or warning for vectors having a euclidean length of ZERO!
 double Vertex::getFeatureVecTanimotoDist( double* rSomeFeatureVec //!< Reference feature vector.
                                         ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	double nom    = 0.0;
 	double denomA = 0.0;
 	double denomB = 0.0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		nom    += rSomeFeatureVec[i] * mFeatureVec[i];
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		nom    += rSomeFeatureVec[i] * featureVec[i];
 		denomA += rSomeFeatureVec[i] * rSomeFeatureVec[i];
-		denomB += mFeatureVec[i] * mFeatureVec[i];
+		denomB += featureVec[i] * featureVec[i];
 	}
 	double dist = nom / ( sqrt( denomA ) + sqrt( denomB ) - nom );
 	//cout << "[Mesh::" << __FUNCTION__ << "] Returns: " << dist << endl;
@@ -1957,6 +2087,9 @@ bool Vertex::getFeatureVecPNorm(
                 const vector<double>* rWeightNum,    //!< optional weight vector as numerator (Zähler)
                 const vector<double>* rWeightDenom   //!< optional weight vector as denominator (Nenner)
 ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
 	// Sanity and range checks
 	if( rResult == nullptr ) {
 		return false;
@@ -1966,22 +2099,22 @@ bool Vertex::getFeatureVecPNorm(
 	}
 	if( ( rReferenceVec != nullptr )
 	    && ( rReferenceVec->size() != 0 )
-	    && ( rReferenceVec->size() != mFeatureVecLen ) ) {
+	    && ( rReferenceVec->size() != featureVecLen ) ) {
 		return false;
 	}
 	if( ( rOffsetVec != nullptr )
 	    && ( rOffsetVec->size() != 0 )
-	    && ( rOffsetVec->size() != mFeatureVecLen ) ) {
+	    && ( rOffsetVec->size() != featureVecLen ) ) {
 		return false;
 	}
 	if( ( rWeightNum != nullptr )
 	    && ( rWeightNum->size() != 0 )
-	    && ( rWeightNum->size() != mFeatureVecLen ) ) {
+	    && ( rWeightNum->size() != featureVecLen ) ) {
 		return false;
 	}
 	if( ( rWeightDenom != nullptr )
 	    && ( rWeightDenom->size() != 0 )
-	    && ( rWeightDenom->size() != mFeatureVecLen ) ) {
+	    && ( rWeightDenom->size() != featureVecLen ) ) {
 		return false;
 	}
 
@@ -1991,25 +2124,27 @@ bool Vertex::getFeatureVecPNorm(
 	double sumElements = 0.0;
 
 	// Compute p-Norm including the non-zero counting "norm"
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		double currElement = mFeatureVec[i];
-		if( ( rReferenceVec != nullptr ) && ( rReferenceVec->size() == mFeatureVecLen ) ){
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		double currElement = featureVec[i];
+		if( ( rReferenceVec != nullptr ) && ( rReferenceVec->size() == featureVecLen ) ){
 			currElement -= rReferenceVec->at( i );
 		}
-		if( ( rOffsetVec != nullptr ) && ( rOffsetVec->size() == mFeatureVecLen ) ) {
+		if( ( rOffsetVec != nullptr ) && ( rOffsetVec->size() == featureVecLen ) ) {
 			currElement -= rOffsetVec->at( i );
 		}
-		if( ( rWeightNum != nullptr ) && ( rWeightNum->size() == mFeatureVecLen ) ) {
+		if( ( rWeightNum != nullptr ) && ( rWeightNum->size() == featureVecLen ) ) {
 			currElement *= rWeightNum->at( i );
 		}
-		if( ( rWeightDenom != nullptr ) && ( rWeightDenom->size() == mFeatureVecLen ) ) {
+		if( ( rWeightDenom != nullptr ) && ( rWeightDenom->size() == featureVecLen ) ) {
 			currElement /= rWeightDenom->at( i );
 		}
 		currElement = abs( currElement );
 		if( maxNorm ) {
 			sumElements = max( sumElements, currElement );
-		} else if( nonZeroCount && ( currElement != 0.0 ) ) {
-			sumElements += 1.0;
+		} else if( nonZeroCount ) {
+			if( currElement != 0.0 ) {
+				sumElements += 1.0;
+			}
 		} else {
 			sumElements += pow( currElement, rPNorm );
 		}
@@ -2030,7 +2165,7 @@ bool Vertex::getFeatureVecPNorm(
 
 //! Retrieves an elemment of the feature vector.
 //! Index here starts at 0 (ZERO!)
-//! Maximum is stored in Vertex::mFeatureVecLen
+//! Maximum is given by Vertex::getFeatureVectorLen
 //! In case of an error the returned value is set to NaN.
 //!
 //! @returns false in case of an error e.g. elementNr > featureVecLen. True otherwise.
@@ -2042,17 +2177,17 @@ bool Vertex::getFeatureElement( unsigned int rElementNr, double* rElementValue )
 		return false;
 	}
 
-	if(  mFeatureVec == nullptr  ) {
+	if(  mFeatureVecMatrix == nullptr  ) {
 
 		(*rElementValue) = _NOT_A_NUMBER_DBL_;
 		return false;
 	}
-	if( rElementNr >= mFeatureVecLen ) {
+	if( rElementNr >= getFeatureVecLenFast() ) {
 		(*rElementValue) = _NOT_A_NUMBER_DBL_;
 		return false;
 	}
 	// Return the requested element.
-	(*rElementValue) = mFeatureVec[rElementNr];
+	(*rElementValue) = mFeatureVecMatrix->get( mFeatureVecRow, rElementNr );
 	return true;
 }
 
@@ -2062,16 +2197,16 @@ bool Vertex::getFeatureElement( unsigned int rElementNr, double* rElementValue )
 //! @returns false, if elementNr is out of range
 bool Vertex::setFeatureElement(unsigned int elementNr, double value)
 {
-	if(elementNr >= mFeatureVecLen)
+	if(elementNr >= getFeatureVecLenFast())
 		return false;
 
-	mFeatureVec[elementNr] = value;
+	mFeatureVecMatrix->set( mFeatureVecRow, elementNr, value );
 	return true;
 }
 
 //! @returns the length of the feature vector.
 unsigned int Vertex::getFeatureVectorLen() {
-	return mFeatureVecLen;
+	return getFeatureVecLenFast();
 }
 
 int Vertex::cutOffFeatureElements( double rMinVal, double rMaxVal, bool rSetToNotANumber ) {
@@ -2082,46 +2217,54 @@ int Vertex::cutOffFeatureElements( double rMinVal, double rMaxVal, bool rSetToNo
 	//! Returns negative value in case of an error.
 	//! Otherwise: returns the number of elements changed.
 	int elementsChanged = 0;
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
-		if( mFeatureVec[i] < rMinVal ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
+		double elementValue = mFeatureVecMatrix->get( mFeatureVecRow, i );
+		if( elementValue < rMinVal ) {
 			if( rSetToNotANumber ) {
-				mFeatureVec[i] = _NOT_A_NUMBER_DBL_;
+				elementValue = _NOT_A_NUMBER_DBL_;
 			} else {
-				mFeatureVec[i] = rMinVal;
+				elementValue = rMinVal;
 			}
 			elementsChanged++;
 		}
-		if( mFeatureVec[i] > rMaxVal ) {
+		if( elementValue > rMaxVal ) {
 			if( rSetToNotANumber ) {
-				mFeatureVec[i] = _NOT_A_NUMBER_DBL_;
+				elementValue = _NOT_A_NUMBER_DBL_;
 			} else {
-				mFeatureVec[i] = rMaxVal;
+				elementValue = rMaxVal;
 			}
 			elementsChanged++;
 		}
+		mFeatureVecMatrix->set( mFeatureVecRow, i, elementValue );
 	}
 	return elementsChanged;
 }
 
 //! resizes the feature-vector of the vertex to fit size
-//! @param size the new size. If size is smaller than the current size, elements get cut. Otherwise, the vector is padded with zeros
+//! A view into a matrix shared with other vertices is replaced by a copy owned by this vertex.
+//! @param size the new size. If size is smaller than the current size, elements get cut. Otherwise, the vector is padded with not-a-number
 void Vertex::resizeFeatureVector(unsigned int size)
 {
-	if(size == mFeatureVecLen)
+	const unsigned int oldlen = getFeatureVecLenFast();
+	if(size == oldlen)
+		return;
+
+	std::vector<double> oldVec( oldlen );
+	copyFeatureVecTo( oldVec.data() );
+	const FeatureVecMatrix::ePrecision precision = ( mFeatureVecMatrix == nullptr ) ?
+	                                               FeatureVecMatrix::PRECISION_DOUBLE : mFeatureVecMatrix->getPrecision();
+	releaseFeatureVec();
+	if( size == 0 )
 		return;
 
-	double* oldVec = mFeatureVec;
-	unsigned int oldlen = mFeatureVecLen;
-	mFeatureVec = new double[size];
-	mFeatureVecLen = size;
+	mFeatureVecMatrix = new FeatureVecMatrix( precision );
+	mFeatureVecRow    = 0;
+	mFeatureVecOwned  = true;
+	mFeatureVecMatrix->allocate( 1, size );
 
 	//copy data
-	for(unsigned int i = 0; i<mFeatureVecLen; ++i)
-	{
-		mFeatureVec[i] = i < oldlen ? oldVec[i] : _NOT_A_NUMBER_DBL_;
-	}
-
-	delete[] oldVec;
+	mFeatureVecMatrix->setRow( 0, oldVec.data(), std::min( oldlen, size ) );
 }
 
 
@@ -2138,9 +2281,12 @@ void Vertex::resizeFeatureVector(unsigned int size)
 //!
 //! @returns false in case of an error. True otherwise.
 bool Vertex::getFeatureVecMedianOneRing( vector<double>& rMedianValues, [[maybe_unused]] double rMinDist   ) {
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
 		try {
-			rMedianValues.at( i ) = mFeatureVec[i];
+			rMedianValues.at( i ) = featureVec[i];
 		} catch (...) {
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Exception!\n";
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "]        Probably some missmatch of array/vector-size.\n";
@@ -2159,9 +2305,12 @@ bool Vertex::getFeatureVecMedianOneRing( vector<double>& rMedianValues, [[maybe_
 //!
 //! @returns false in case of an error. True otherwise.
 bool Vertex::getFeatureVecMeanOneRing( vector<double>& rMeanValues, [[maybe_unused]] double rMinDist   ) {
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
 		try {
-			rMeanValues.at( i ) = mFeatureVec[i];
+			rMeanValues.at( i ) = featureVec[i];
 		} catch (...) {
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Exception!\n";
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "]        Probably some missmatch of array/vector-size.\n";
@@ -2176,9 +2325,12 @@ bool Vertex::getFeatureVecMeanOneRing(
                 [[maybe_unused]] const vector<s1RingSectorPrecomp>& r1RingSecPrecomp ,
                 vector<double>& rMeanValues
 ) {
-	for( unsigned int i=0; i<mFeatureVecLen; i++ ) {
+	const unsigned int featureVecLen = getFeatureVecLenFast();
+	vector<double>     featureVecBuffer;
+	const double*      featureVec    = getFeatureVecDouble( featureVecBuffer );
+	for( unsigned int i=0; i<featureVecLen; i++ ) {
 		try {
-			rMeanValues.at( i ) = mFeatureVec[i];
+			rMeanValues.at( i ) = featureVec[i];
 		} catch (...) {
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: Exception!\n";
 			LOG::error() << "[Vertex::" << __FUNCTION__ << "]        Probably some missmatch of array/vector-size.\n";
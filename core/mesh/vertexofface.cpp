@@ -23,6 +23,7 @@
 #include <GigaMesh/mesh/vertexofface.h>
 
 #include <GigaMesh/mesh/face.h>
+#include <GigaMesh/mesh/visitedset.h>
 
 #include <GigaMesh/logging/Logging.h>
 
@@ -217,6 +218,69 @@ bool VertexOfFace::mark1RingVisited(
 	return true;
 }
 
+//! Relates to Mesh::fetchSphereBitArray passes thru to neighbourfaces to reach the vertices in 1-ring distance.
+//! Same as the bit array variant, but using a VisitedSet.
+Vertex* VertexOfFace::advanceInSphere( double*          sphereCenter,    //!< X, y and z-coordinate of the sphere's center
+                                       double           radius,          //!< Radius of the sphere.
+                                       VisitedSet&      rVertsVisited,   //!< Visited vertices.
+                                       vector<Vertex*>* nextArray,       //!< Vertices along the marching front.
+                                       VisitedSet&      rFacesVisited,   //!< Visited faces.
+                                       bool             rOrderToFuncVal, //!< Flag for visual debuging: will set the faces function value to the sequenze nr.
+                                       double*          rSeqNr           //!< Sequenze number - only used when rOrderToFuncVal is set.
+	) {
+	Vertex* nextVert = nullptr;
+	for( int i=0; i<mAdjacentFacesNr; i++ ) {
+		// sanity check;
+		if( mAdjacentFaces[i] == nullptr ) {
+			continue;
+		}
+		// check if already visited:
+		const uint64_t faceIdx = static_cast<uint64_t>(mAdjacentFaces[i]->getIndex());
+		if( rFacesVisited.isMarked( faceIdx ) ) {
+			continue;
+		}
+		Vertex* tmpVert = mAdjacentFaces[i]->advanceInSphere( this, sphereCenter, radius, rVertsVisited, nextArray );
+		// Set sequenze number, when requested:
+		if( rOrderToFuncVal ) {
+			mAdjacentFaces[i]->setFuncValue( (*rSeqNr) );
+			(*rSeqNr) += 1.0;
+		}
+		// Add face as visited
+		rFacesVisited.mark( faceIdx );
+		if( tmpVert != nullptr ) {
+			nextVert = tmpVert;
+		}
+	}
+	return nextVert;
+}
+
+//! Relates to Mesh::fetchSphereBitArray1R adds vertices and faces in 1-ring distance to the VisitedSets.
+bool VertexOfFace::mark1RingVisited(
+                VisitedSet& rVertsVisited,   //!< Visited vertices.
+                VisitedSet& rFacesVisited,   //!< Visited faces.
+                bool        rOrderToFuncVal, //!< Flag for visual debuging: will set the faces function value to the sequenze nr.
+                double*     rSeqNr           //!< Sequenze number - only used when rOrderToFuncVal is set.
+) {
+	for( int i=0; i<mAdjacentFacesNr; ++i ) {
+		// Sanity check;
+		if( mAdjacentFaces[i] == nullptr ) {
+			continue;
+		}
+		// Check if already visited and add face as visited:
+		if( rFacesVisited.mark( static_cast<uint64_t>(mAdjacentFaces[i]->getIndex()) ) ) {
+			continue;
+		}
+		// When not add vertices as visited too:
+		mAdjacentFaces[i]->markVertsVisited( rVertsVisited );
+		// Set sequenze number, when requested:
+		if( rOrderToFuncVal ) {
+			mAdjacentFaces[i]->setFuncValue( (*rSeqNr) );
+			(*rSeqNr) += 1.0;
+		}
+	}
+	return true;
+}
+
 //! Checks if this Vertex is a local Minimum using the 1-ring
 //! stored in mAdjacentFaces.
 //! 
@@ -497,6 +561,15 @@ bool VertexOfFace::getAdjacentVerticesExcluding( vector<Vertex*>* rSomeVerts, ui
 	return true;
 }
 
+//! Adds the adjacent vertices of the 1-ring to rSomeVerts, when they have not been marked in rVertsVisited.
+//! Will also mark the vertices added.
+bool VertexOfFace::getAdjacentVerticesExcluding( vector<Vertex*>* rSomeVerts, VisitedSet& rVertsVisited ) {
+	for( int i=0; i<mAdjacentFacesNr; i++ ) {
+		mAdjacentFaces[i]->addAndTagUntaggedVerts( rSomeVerts, rVertsVisited );
+	}
+	return true;
+}
+
 //! Return the reference to next vertex on the border within the 1-ring neighbourhood.
 //! Considers the bit-array for vertices tagged unvisited.
 Vertex* VertexOfFace::getAdjacentNextBorderVertex( uint64_t* rVertBitArrayUnVisited ) {
@@ -557,6 +630,22 @@ void VertexOfFace::connectToFace( Face* someFace ) {
 	mAdjacentFacesNr++;
 }
 
+//! Replaces the adjacent faces without checking for duplicates as connectToFace.
+//! Used when a Mesh is loaded from a MeshCache - see Face::Face.
+void VertexOfFace::setAdjacentFaces( Face* const* rFaces, //!< Adjacent faces.
+                                     int rCount           //!< Number of adjacent faces.
+                                   ) {
+	delete[] mAdjacentFaces;
+	mAdjacentFaces   = nullptr;
+	mAdjacentFacesNr = 0;
+	if( rCount <= 0 ) {
+		return;
+	}
+	mAdjacentFaces   = new Face*[rCount];
+	mAdjacentFacesNr = rCount;
+	std::copy( rFaces, rFaces + rCount, mAdjacentFaces );
+}
+
 //! Remove an adjacent Face (e.g. when removed).
 void VertexOfFace::disconnectFace( Face* someFace ) {
 	if( someFace == nullptr ) {
@@ -802,6 +891,73 @@ bool VertexOfFace::isInverse() {
 	return( false );
 }
 
+//! Performs the checks isBorder, isNonManifold, isDoubleCone, isPartOfZeroFace
+//! and isInverse with a single loop over the adjacent faces and a single dance
+//! around the vertex, which is shared by the border and the double cone check.
+//!
+//! Only reads the mesh, so it can be called for different vertices in parallel.
+//!
+//! @returns false in case of an error. True otherwise.
+bool VertexOfFace::get1RingChecks( s1RingChecks& rChecks ) {
+	rChecks = s1RingChecks();
+	int countBorderFaces = 0;
+	for( int i=0; i<mAdjacentFacesNr; i++ ) {
+		Face* adjacentFace = mAdjacentFaces[i];
+		if( adjacentFace->isBorder() ) {
+			countBorderFaces++;
+		}
+		rChecks.mNonManifold    |= adjacentFace->isNonManifold();
+		rChecks.mPartOfZeroFace |= adjacentFace->getFlag( FLAG_FACE_ZERO_AREA );
+		rChecks.mInverse        |= adjacentFace->isInverseOnEdge( this );
+	}
+
+	// Solo vertex and a single face - see isBorder and isDoubleCone
+	if( mAdjacentFacesNr <= 1 ) {
+		rChecks.mBorder = ( mAdjacentFacesNr == 1 );
+		return( true );
+	}
+
+	// do a dance around the Vertex:
+	set<Face*> facesVisited;
+	Face* nextFace    = nullptr;
+	Face* currentFace = mAdjacentFaces[0];
+	Face* firstFace   = currentFace;
+	facesVisited.insert( currentFace );
+	nextFace = currentFace->getNextFaceWith( this, &facesVisited );
+	while( nextFace != nullptr ) {
+		currentFace = nextFace;
+		nextFace = currentFace->getNextFaceWith( this, &facesVisited );
+		facesVisited.insert( currentFace );
+	}
+
+	// Border - same as isBorder:
+	if( mAdjacentFacesNr < 3 ) {
+		rChecks.mBorder = true;
+	} else if( countBorderFaces >= 2 ) {
+		rChecks.mBorder = true;
+		// if we could dance thru around all adjacent faces and the face we startet is the last visitied, then we are not on a border!
+		facesVisited.erase( firstFace );
+		nextFace = currentFace->getNextFaceWith( this, &facesVisited );
+		if( nextFace == firstFace ) {
+			if( mAdjacentFacesNr == static_cast<int>(facesVisited.size())+1 ) {
+				rChecks.mBorder = false;
+			}
+		}
+		facesVisited.insert( firstFace );
+	}
+
+	// Double cone - same as isDoubleCone i.e. dance around in the other direction:
+	currentFace = firstFace;
+	nextFace = currentFace->getNextFaceWith( this, &facesVisited );
+	while( nextFace != nullptr ) {
+		currentFace = nextFace;
+		nextFace = currentFace->getNextFaceWith( this, &facesVisited );
+		facesVisited.insert( currentFace );
+	}
+	rChecks.mDoubleCone = ( mAdjacentFacesNr != static_cast<int>(facesVisited.size()) );
+	return( true );
+}
+
 // DEBUGING --------------------------------------------------------------------
 
 //! Dumps information about the Vertex to stdout.
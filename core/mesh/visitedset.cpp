@@ -0,0 +1,57 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/visitedset.h>
+
+#include <algorithm>
+
+//! Constructor allocating the stamps for the given number of elements.
+VisitedSet::VisitedSet(
+                uint64_t rElementCount
+) {
+	resize( rElementCount );
+}
+
+//! Changes the number of elements and starts a new generation.
+void VisitedSet::resize(
+                uint64_t rElementCount
+) {
+	mStamps.assign( rElementCount, 0 );
+	mMarked.clear();
+	mGeneration = 1;
+}
+
+//! @returns the number of elements, which can be marked.
+uint64_t VisitedSet::size() const {
+	return( mStamps.size() );
+}
+
+//! Unmarks all elements by starting a new generation.
+//! Only when the generation counter wraps around, the stamps are reset.
+void VisitedSet::clear() {
+	mMarked.clear();
+	++mGeneration;
+	if( mGeneration == 0 ) {
+		std::fill( mStamps.begin(), mStamps.end(), 0 );
+		mGeneration = 1;
+	}
+}
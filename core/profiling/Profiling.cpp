@@ -0,0 +1,227 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/profiling/Profiling.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <GigaMesh/logging/Logging.h>
+
+namespace PROFILE {
+	std::atomic<bool> gEnabled( false );
+
+	namespace {
+		//! Single event of a Chrome trace.
+		struct sEvent {
+			const char* mName;      //!< Name - string literal.
+			uint64_t    mStartNs;   //!< Start time.
+			uint64_t    mDurNs;     //!< Duration - only for spans.
+			double      mValue;     //!< Value - only for counters.
+			char        mPhase;     //!< 'X' for complete events i.e. spans and 'C' for counters.
+		};
+
+		//! Events recorded by one thread. The mutex is only contended, while the trace is written.
+		struct sThreadBuffer {
+			uint32_t            mThreadId;
+			std::mutex          mMutex;
+			std::vector<sEvent> mEvents;
+		};
+
+		const std::chrono::steady_clock::time_point gStartTime = std::chrono::steady_clock::now();
+
+		std::mutex                                  gBuffersMutex;
+		std::vector<std::unique_ptr<sThreadBuffer>> gBuffers;      //!< Buffers are kept until the program exits, as threads may finish before the trace is written.
+		std::filesystem::path                       gTraceFileAtExit;
+
+		//! @returns the buffer of the calling thread. Allocated on first use.
+		sThreadBuffer& getThreadBuffer() {
+			thread_local sThreadBuffer* threadBuffer = nullptr;
+			if( threadBuffer == nullptr ) {
+				std::lock_guard<std::mutex> lock( gBuffersMutex );
+				gBuffers.push_back( std::make_unique<sThreadBuffer>() );
+				threadBuffer = gBuffers.back().get();
+				threadBuffer->mThreadId = static_cast<uint32_t>( gBuffers.size() );
+			}
+			return( *threadBuffer );
+		}
+
+		//! Escapes a name for JSON.
+		std::string escapeJSON( const char* rName ) {
+			std::string escaped;
+			for( const char* currChar = rName; *currChar != '\0'; ++currChar ) {
+				if( *currChar == '"' || *currChar == '\\' ) {
+					escaped += '\\';
+				}
+				escaped += *currChar;
+			}
+			return( escaped );
+		}
+
+		//! Called by std::atexit - see setTraceFileAtExit
+		void writeAtExit() {
+			if( gTraceFileAtExit.empty() ) {
+				return;
+			}
+			writeSummary( std::cout );
+			if( writeChromeTrace( gTraceFileAtExit ) ) {
+				std::cout << "[GigaMesh] Profiling trace written to: " << gTraceFileAtExit << std::endl;
+			}
+		}
+	}
+
+	void setEnabled( bool rEnable ) {
+		gEnabled.store( rEnable, std::memory_order_relaxed );
+	}
+
+	uint64_t nowNs() {
+		// Plus one, because zero marks timers started while recording was disabled.
+		return( static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                                   std::chrono::steady_clock::now() - gStartTime ).count() ) + 1 );
+	}
+
+	void addSpan( const char* rName, uint64_t rStartNs, uint64_t rEndNs ) {
+		sThreadBuffer& threadBuffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock( threadBuffer.mMutex );
+		threadBuffer.mEvents.push_back( sEvent{ rName, rStartNs, rEndNs - rStartNs, 0.0, 'X' } );
+	}
+
+	void counter( const char* rName, double rValue ) {
+		if( !isEnabled() ) {
+			return;
+		}
+		const uint64_t timeStamp = nowNs();
+		sThreadBuffer& threadBuffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock( threadBuffer.mMutex );
+		threadBuffer.mEvents.push_back( sEvent{ rName, timeStamp, 0, rValue, 'C' } );
+	}
+
+	void clear() {
+		std::lock_guard<std::mutex> lock( gBuffersMutex );
+		for( auto& threadBuffer : gBuffers ) {
+			std::lock_guard<std::mutex> lockThread( threadBuffer->mMutex );
+			threadBuffer->mEvents.clear();
+		}
+	}
+
+	bool writeChromeTrace( const std::filesystem::path& rFileName ) {
+		std::ofstream traceFile( rFileName );
+		if( !traceFile.is_open() ) {
+			LOG::error() << "[PROFILE::" << __FUNCTION__ << "] ERROR: could not open " << rFileName << " for writing!\n";
+			return( false );
+		}
+		traceFile << std::fixed << std::setprecision( 3 );
+		traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool firstEvent = true;
+		std::lock_guard<std::mutex> lock( gBuffersMutex );
+		for( auto& threadBuffer : gBuffers ) {
+			std::lock_guard<std::mutex> lockThread( threadBuffer->mMutex );
+			for( const sEvent& currEvent : threadBuffer->mEvents ) {
+				traceFile << ( firstEvent ? "\n" : ",\n" );
+				firstEvent = false;
+				// Chrome traces use microseconds.
+				traceFile << "{\"name\":\"" << escapeJSON( currEvent.mName ) << "\""
+				          << ",\"ph\":\"" << currEvent.mPhase << "\""
+				          << ",\"pid\":1,\"tid\":" << threadBuffer->mThreadId
+				          << ",\"ts\":" << static_cast<double>( currEvent.mStartNs ) / 1000.0;
+				if( currEvent.mPhase == 'X' ) {
+					traceFile << ",\"dur\":" << static_cast<double>( currEvent.mDurNs ) / 1000.0;
+				} else {
+					traceFile << ",\"args\":{\"value\":" << currEvent.mValue << "}";
+				}
+				traceFile << "}";
+			}
+		}
+		traceFile << "\n]}\n";
+		return( traceFile.good() );
+	}
+
+	void writeSummary( std::ostream& rOutput ) {
+		struct sSummary {
+			uint64_t mCount   = 0;
+			uint64_t mTotalNs = 0;
+			uint64_t mMaxNs   = 0;
+		};
+		std::map<std::string, sSummary> summaries;
+		{
+			std::lock_guard<std::mutex> lock( gBuffersMutex );
+			for( auto& threadBuffer : gBuffers ) {
+				std::lock_guard<std::mutex> lockThread( threadBuffer->mMutex );
+				for( const sEvent& currEvent : threadBuffer->mEvents ) {
+					if( currEvent.mPhase != 'X' ) {
+						continue;
+					}
+					sSummary& currSummary = summaries[currEvent.mName];
+					currSummary.mCount++;
+					currSummary.mTotalNs += currEvent.mDurNs;
+					currSummary.mMaxNs = std::max( currSummary.mMaxNs, currEvent.mDurNs );
+				}
+			}
+		}
+		rOutput << "[GigaMesh] Profiling summary (wall-clock, all threads):" << std::endl;
+		// The format of the stream of the caller is restored afterwards.
+		const std::ios_base::fmtflags flagsPrev     = rOutput.flags();
+		const std::streamsize         precisionPrev = rOutput.precision();
+		rOutput << std::fixed << std::setprecision( 3 );
+		for( auto const& [name, currSummary] : summaries ) {
+			rOutput << "[GigaMesh]   " << std::left << std::setw( 48 ) << name << std::right
+			        << " count: "    << std::setw( 8 ) << currSummary.mCount
+			        << " total: "    << std::setw( 12 ) << static_cast<double>( currSummary.mTotalNs ) / 1.0e9 << " sec"
+			        << " max: "      << std::setw( 12 ) << static_cast<double>( currSummary.mMaxNs ) / 1.0e9 << " sec" << std::endl;
+		}
+		rOutput.flags( flagsPrev );
+		rOutput.precision( precisionPrev );
+	}
+
+	uint64_t getSpanTotalNs( const char* rName ) {
+		uint64_t totalNs = 0;
+		std::lock_guard<std::mutex> lock( gBuffersMutex );
+		for( auto& threadBuffer : gBuffers ) {
+			std::lock_guard<std::mutex> lockThread( threadBuffer->mMutex );
+			for( const sEvent& currEvent : threadBuffer->mEvents ) {
+				if( ( currEvent.mPhase == 'X' ) && ( std::strcmp( currEvent.mName, rName ) == 0 ) ) {
+					totalNs += currEvent.mDurNs;
+				}
+			}
+		}
+		return( totalNs );
+	}
+
+	void setTraceFileAtExit( const std::filesystem::path& rFileName ) {
+		const bool registerHandler = gTraceFileAtExit.empty();
+		gTraceFileAtExit = rFileName;
+		setEnabled( true );
+		if( registerHandler ) {
+			std::atexit( writeAtExit );
+		}
+	}
+}
@@ -23,11 +23,13 @@
 #include "MeshQtCSVImportExport.h"
 
 // C++ includes
+#include <filesystem>
 #include <iostream>
 
 // GigaMesh includes
 #include <GigaMesh/mesh/vertex.h>
 #include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/numerictable.h>
 
 // Qt includes
 #include <QString>
@@ -91,213 +93,86 @@ bool MeshQtCSVImportExport::importVertexDataFromCSV(const QString& inputFilename
 		return false;
 	}
 
-	QFile vertexCoordinatesInputFile(inputFilenameString);
+	const std::filesystem::path inputFileName(inputFilenameString.toStdWString());
 
-	if(vertexCoordinatesInputFile.open(QFile::ReadOnly | QFile::Text))
-	{
-		std::cout << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-		        << "Opened file "
-		        << vertexCoordinatesInputFile.fileName().toStdString()
-		        << std::endl;
-	}
+	m_showProgressStartFunction("Vertex coordinate import");
 
-	else
+	// Expected columns: index x y z function value.
+	// Parsed by multiple threads from the memory mapped file - see NumericTable
+	NumericTable vertexTable;
+	NumericTable::sParams tableParams;
+	tableParams.mFirstColIsIndex = true;
+
+	if(!vertexTable.read(inputFileName, tableParams))
 	{
 		std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
 		            << "Error: Could not open file "
-		            << vertexCoordinatesInputFile.fileName().toStdString()
+		            << inputFileName.string()
 		            << std::endl;
+		m_showProgressStopFunction("Vertex coordinate import");
 		return false;
 	}
 
-	m_showProgressStartFunction("Vertex coordinate import");
-
-
-	// Bytes per line are not constant (they vary
-	// with the exported data, as double to string
-	// conversion was not set to fixed size), but
-	// this is generally about the average number
-	// of bytes per line
-	constexpr size_t heuristicBytesPerLine = 50;
-	constexpr size_t maximumReadSize = 100;
-
-	const size_t heuristicNumberOfLines =
-	                    vertexCoordinatesInputFile.size()/
-	                                        heuristicBytesPerLine;
+	std::cout << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
+	        << "Read file "
+	        << inputFileName.string()
+	        << std::endl;
 
-	const QRegExp matchDelimitersRegex("(\\ |\\t)");
+	m_showProgressFunction(0.5, "Vertex coordinate import");
 
 	std::vector<std::pair<int, std::array<double, 4>>> vertexIndexPositionFunctionValueVector;
 
-	QStringList matrixRowStringList;
-
-	QByteArray lineBuffer;
-
-	quint64 currentLineCount = 0;
-
 	bool gotReadError = false;
 
-	while(true)
+	if(vertexTable.getInvalidCount() > 0)
 	{
+		gotReadError = true;
+		std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
+		            << ": " << vertexTable.getInvalidCount()
+		            << " argument(s) is/are invalid"
+		            << std::endl;
+	}
 
-		lineBuffer = vertexCoordinatesInputFile.readLine(maximumReadSize);
-
-		if(lineBuffer.size() <= 1)
-		{
-			break;
-		}
-
-		// Remove newline
-		lineBuffer.remove(lineBuffer.size() - 1, 1);
-
-		matrixRowStringList = QString(lineBuffer).split(
-		                                        matchDelimitersRegex);
-
-		// Remove all empty strings
-		matrixRowStringList.removeAll(QString(""));
-
-		++currentLineCount;
+	else if((vertexTable.getColCountMin() != 4) ||
+	        (vertexTable.getColCount() != 4))
+	{
+		gotReadError = true;
+		std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
+		            << "Error: one or more row elements missing"
+		            << std::endl;
+	}
 
-		bool conversionColoumn0SuccessFul = false;
-		bool conversionColoumn1SuccessFul = false;
-		bool conversionColoumn2SuccessFul = false;
-		bool conversionColoumn3SuccessFul = false;
-		bool conversionColoumn4SuccessFul = false;
+	else
+	{
+		vertexIndexPositionFunctionValueVector.resize(vertexTable.getRowCount());
 
-		if(matrixRowStringList.size() == 5)
+		for(uint64_t rowIdx = 0; rowIdx < vertexTable.getRowCount(); rowIdx++)
 		{
+			std::pair<int, std::array<double, 4>>& indexPositionFunctionValuePair =
+			                    vertexIndexPositionFunctionValueVector[rowIdx];
 
-			std::pair<int, std::array<double, 4>> indexPositionFunctionValuePair;
-
-			indexPositionFunctionValuePair.first =
-			                    matrixRowStringList.at(0).toInt(
-			                            &conversionColoumn0SuccessFul);
-
-			indexPositionFunctionValuePair.second.at(0) =
-			                    matrixRowStringList.at(1).toDouble(
-			                            &conversionColoumn1SuccessFul);
+			indexPositionFunctionValuePair.first = static_cast<int>(vertexTable.getIndex(rowIdx));
 
-			indexPositionFunctionValuePair.second.at(1) =
-			                    matrixRowStringList.at(2).toDouble(
-			                            &conversionColoumn2SuccessFul);
-
-			indexPositionFunctionValuePair.second.at(2) =
-			                    matrixRowStringList.at(3).toDouble(
-			                            &conversionColoumn3SuccessFul);
-
-			indexPositionFunctionValuePair.second.at(3) =
-			                    matrixRowStringList.at(4).toDouble(
-			                            &conversionColoumn4SuccessFul);
-
-
-			if(conversionColoumn0SuccessFul &&
-			        conversionColoumn1SuccessFul &&
-			        conversionColoumn2SuccessFul &&
-			        conversionColoumn3SuccessFul &&
-			        conversionColoumn4SuccessFul)
+			for(uint64_t colIdx = 0; colIdx < 4; colIdx++)
 			{
-
-				Vertex* currentVertex = m_meshGLPtr->getVertexByIdxOriginal(indexPositionFunctionValuePair.first);
-
-				if(currentVertex != nullptr)
-				{
-					vertexIndexPositionFunctionValueVector.push_back(indexPositionFunctionValuePair);
-				}
-
-				else
-				{
-					gotReadError = true;
-
-					std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-					            << "Error: No corresponding vertex in the "
-					            << "currently open mesh. The CSV file "
-					            << "from which vertex coordinates are "
-					            << "imported may have been exported from "
-					            << "a differently sized mesh, or the CSV "
-					            << "file is corrupted"
-					            << std::endl;
-					break;
-				}
-
-				if(heuristicBytesPerLine < largeFileSizeThreshold)
-				{
-
-					if(!(currentLineCount % 10))
-					{
-						const double currentStatus =
-						                static_cast<double>(currentLineCount)/
-						                static_cast<double>(heuristicNumberOfLines);
-
-						m_showProgressFunction((currentStatus < 1.0 ? currentStatus : 1.0),
-						                                                "Vertex coordinate import");
-					}
-				}
-
-				else
-				{
-					if(!(currentLineCount % 100000))
-					{
-						const double currentStatus =
-						                static_cast<double>(currentLineCount)/
-						                static_cast<double>(heuristicNumberOfLines);
-
-						m_showProgressFunction((currentStatus < 1.0 ? currentStatus : 1.0),
-						                                                "Vertex coordinate import");
-					}
-				}
+				indexPositionFunctionValuePair.second.at(colIdx) = vertexTable.get(rowIdx, colIdx);
 			}
 
-			else
+			if(m_meshGLPtr->getVertexByIdxOriginal(indexPositionFunctionValuePair.first) == nullptr)
 			{
 				gotReadError = true;
-				std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-				            << ": Argument(s) ";
-
-				if(!conversionColoumn0SuccessFul)
-				{
-					std::clog << matrixRowStringList.at(0).toStdString()
-					            << " in index coloumn ";
-				}
-
-				if(!conversionColoumn1SuccessFul)
-				{
-					std::clog << matrixRowStringList.at(1).toStdString()
-					            << " in x coordinate coloumn ";
-				}
-
-				if(!conversionColoumn2SuccessFul)
-				{
-					std::clog << matrixRowStringList.at(2).toStdString()
-					            << " in y coordinate coloumn ";
-				}
-
-				if(!conversionColoumn3SuccessFul)
-				{
-					std::clog << matrixRowStringList.at(3).toStdString()
-					            << " in z coordinate coloumn ";
-				}
-
-				if(!conversionColoumn4SuccessFul)
-				{
-					std::clog << matrixRowStringList.at(4).toStdString()
-					            << " in feature vector element 0 coloumn ";
-				}
-
-				std::clog << "is/are invalid" << std::endl;
 
+				std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
+				            << "Error: No corresponding vertex in the "
+				            << "currently open mesh. The CSV file "
+				            << "from which vertex coordinates are "
+				            << "imported may have been exported from "
+				            << "a differently sized mesh, or the CSV "
+				            << "file is corrupted"
+				            << std::endl;
 				break;
 			}
 		}
-
-		else
-		{
-			gotReadError = true;
-
-			std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-			            << "Error: one or more row elements missing"
-			            << std::endl;
-			break;
-		}
 	}
 
 	if( vertexIndexPositionFunctionValueVector.size() != m_meshGLPtr->getVertexNr() ) {
@@ -312,26 +187,19 @@ bool MeshQtCSVImportExport::importVertexDataFromCSV(const QString& inputFilename
 	if(!gotReadError)
 	{
 		std::cout << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] Imported "
-		            << currentLineCount - 1
+		            << vertexIndexPositionFunctionValueVector.size()
 		            << " coordinates" << std::endl;
 	}
 
-	else
+	else if(vertexTable.getFirstInvalidLine() > 0)
 	{
 		std::clog << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-		            << "In line " << currentLineCount
+		            << "In line " << vertexTable.getFirstInvalidLine()
 		            << " file: "
-		            << vertexCoordinatesInputFile.fileName().toStdString()
+		            << inputFileName.string()
 		            << std::endl;
 	}
 
-	vertexCoordinatesInputFile.close();
-
-	std::cout << "[MeshQtCSVImportExport::" << __FUNCTION__ << "] "
-	            << "Closed input file "
-	            << vertexCoordinatesInputFile.fileName().toStdString()
-	            << std::endl;
-
 
 	if(!gotReadError)
 	{
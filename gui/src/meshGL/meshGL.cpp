@@ -25,6 +25,7 @@
 
 #include <thread>
 #include <future>
+#include <algorithm>
 #include <QTime>
 #include <QPixmap>
 
@@ -625,314 +626,18 @@ bool MeshGL::selectPositionAt( int rXPixel, int rYPixel, bool rLastPoint ) {
 }
 
 
-//! \brief											This function is used by the threads
-//!													spawned by the function
-//!													runFunctionValueToRGBTransformation to
-//!													perform the actual function value to RGB
-//!													transformation in parallel. The algorithm
-//!													is derived from
-//!													shaders/funcval.vert -> main().
-//! \param colorMapImage							A QImage containing all currently available
-//!													colormaps used to represent function values
-//! \param meshGLColorMapChoiceValue				The currently used colormap
-//! \param showRepeatColorMapValue					The currently used colormap repeat setting
-//! \param invertFunctionValueColorValue			The currently used color invertion setting
-//! \param functionValueMin							The minimum function value currently set by
-//!													the end-user, or if none is set, the minumum
-//!													function value available in the mesh
-//! \param functionValueMax							The maximum function value currently set by
-//!													the end-user, or if none is set, the maximum
-//!													function value available in the mesh
-//! \param functionValueRepetitionIntervalValue		The currently set colormap repetition
-//!													interval value
-//! \param functionValueLogarithmGammaValue			The currently set logarithm gamma value
-//! \param offset									The offset of the dataset of the current
-//!													relative to the beginning of the Vertex
-//!													object vector
-//! \param range									The size of the dataset to be processed by
-//!													The current thread
-//! \return											False of an error occured while retrieving
-//!													the function value or setting the RGB value
-//!													of any Vertex object in the dataset of
-//!													the thread, true of all Vertex objects were
-//!													processed without error
-bool MeshGL::runFunctionValueToRGBTransformation_impl(
-                const QImage& colorMapImage,
-                const int meshGLColorMapChoiceValue,
-                const bool showRepeatColorMapValue,
-                const bool invertFunctionValueColorValue,
-                const double functionValueMin,
-                const double functionValueMax,
-                const double functionValueRepetitionIntervalValue,
-                const double functionValueLogarithmGammaValue,
-                const uint64_t offset,
-                const uint64_t range
-) {
-	constexpr double functionValueToTextureCoordinateXScalingFactor = 511.0/512.0;
-	constexpr double functionValueToTextureCoordinateXOffset = 0.5/512.0;
-
-	const double imageWidth = colorMapImage.width();
-	const double imageHeight = colorMapImage.height();
-
-	Vertex* currVertex = nullptr;
-
-	QColor currentPixelColor;
-
-	double currentFunctionValue = 0.0;
-
-	double textureCoordinateXDouble = 0.0;
-	double textureCoordinateYDouble = 0.0;
-
-	double functionValueForTextureCoordinates = 0.0;
-	double normalizedRange = 0.0;
-
-	int64_t textureCoordinateX = 0;
-	int64_t textureCoordinateY = 0;
-
-	bool allSet = true;
-
-	for(uint64_t vertIdx = 0; vertIdx < range; vertIdx++)
-	{
-		currVertex = getVertexPos(vertIdx + offset);
-
-		if(!currVertex->getFuncValue(&currentFunctionValue))
-		{
-			allSet = false;
-		}
-
-		textureCoordinateYDouble = (1.0 - (20.0*static_cast<double>(
-		                               meshGLColorMapChoiceValue) + 11.0)/1024.0);
-
-		if(showRepeatColorMapValue)
-		{
-			functionValueForTextureCoordinates =
-			        std::fabs(2.0*std::fmod(currentFunctionValue,
-			                                functionValueRepetitionIntervalValue))/
-			                                functionValueRepetitionIntervalValue;
-
-			if(functionValueForTextureCoordinates > 1.0)
-			{
-				functionValueForTextureCoordinates = 2.0 - functionValueForTextureCoordinates;
-			}
-
-			textureCoordinateXDouble = functionValueToTextureCoordinateXScalingFactor*
-			                           functionValueForTextureCoordinates +
-			                           functionValueToTextureCoordinateXOffset;
-		}
-
-		else
-		{
-			normalizedRange = (currentFunctionValue - functionValueMin)/
-			                  (functionValueMax - functionValueMin);
-
-			if(normalizedRange < 0.0)
-			{
-				normalizedRange = 0.0;
-			}
-
-			else if(normalizedRange > 1.0)
-			{
-				normalizedRange = 1.0;
-			}
-
-			normalizedRange = std::pow(normalizedRange, functionValueLogarithmGammaValue);
-
-			textureCoordinateXDouble = functionValueToTextureCoordinateXScalingFactor*
-			                           normalizedRange +
-			                           functionValueToTextureCoordinateXOffset;
-		}
-
-		if(invertFunctionValueColorValue)
-		{
-			textureCoordinateXDouble = 1.0 - textureCoordinateXDouble;
-		}
-
-		textureCoordinateX = std::floor(imageWidth*textureCoordinateXDouble);
-		textureCoordinateY = std::floor(imageHeight*textureCoordinateYDouble);
-
-		currentPixelColor = QColor(colorMapImage.pixel(
-		                               textureCoordinateX, textureCoordinateY));
-
-		if(!currVertex->setRGB(static_cast<unsigned char>(currentPixelColor.red()),
-		                       static_cast<unsigned char>(currentPixelColor.green()),
-		                       static_cast<unsigned char>(currentPixelColor.blue())))
-		{
-			allSet = false;
-		}
-	}
-
-	return allSet;
-
-}
-
-//! \brief											Identical to
-//!													runFunctionValueToRGBTransformation_impl,
-//!													except that it updates the progress bar of
-//!													the GigaMesh GUI. Used by the parent thread
-//!													in runFunctionValueToRGBTransformation. The
-//!													algorithm is derived from
-//!													shaders/funcval.vert -> main().
-//! \param colorMapImage							A QImage containing all currently available
-//!													colormaps used to represent function values
-//! \param meshGLColorMapChoiceValue				The currently used colormap
-//! \param showRepeatColorMapValue					The currently used colormap repeat setting
-//! \param invertFunctionValueColorValue			The currently used color invertion setting
-//! \param functionValueMin							The minimum function value currently set by
-//!													the end-user, or if none is set, the minumum
-//!													function value available in the mesh
-//! \param functionValueMax							The maximum function value currently set by
-//!													the end-user, or if none is set, the maximum
-//!													function value available in the mesh
-//! \param functionValueRepetitionIntervalValue		The currently set colormap repetition
-//!													interval value
-//! \param functionValueLogarithmGammaValue			The currently set logarithm gamma value
-//! \param offset									The offset of the dataset of the current
-//!													relative to the beginning of the Vertex
-//!													object vector
-//! \param range									The size of the dataset to be processed by
-//!													The current thread
-//! \return											False of an error occured while retrieving
-//!													the function value or setting the RGB value
-//!													of any Vertex object in the dataset of
-//!													the thread, true of all Vertex objects were
-//!													processed without error
-bool MeshGL::runFunctionValueToRGBTransformationUpdateProgress_impl(
-                const QImage& colorMapImage,
-                const int meshGLColorMapChoiceValue,
-                const bool showRepeatColorMapValue,
-                const bool invertFunctionValueColorValue,
-                const double functionValueMin,
-                const double functionValueMax,
-                const double functionValueRepetitionIntervalValue,
-                const double functionValueLogarithmGammaValue,
-                const uint64_t offset,
-                const uint64_t range
-) {
-	constexpr double functionValueToTextureCoordinateXScalingFactor = 511.0/512.0;
-	constexpr double functionValueToTextureCoordinateXOffset = 0.5/512.0;
-
-	const double imageWidth = colorMapImage.width();
-	const double imageHeight = colorMapImage.height();
-
-	Vertex* currVertex = nullptr;
-
-	QColor currentPixelColor;
-
-	double currentFunctionValue = 0.0;
-
-	double textureCoordinateXDouble = 0.0;
-	double textureCoordinateYDouble = 0.0;
-
-	double functionValueForTextureCoordinates = 0.0;
-	double normalizedRange = 0.0;
-
-	int64_t textureCoordinateX = 0;
-	int64_t textureCoordinateY = 0;
-
-	bool allSet = true;
-
-	for(uint64_t vertIdx = 0; vertIdx < range; vertIdx++)
-	{
-		currVertex = getVertexPos(vertIdx + offset);
-
-		if(!currVertex->getFuncValue(&currentFunctionValue))
-		{
-			allSet = false;
-		}
-
-		textureCoordinateYDouble = (1.0 - (20.0*static_cast<double>(
-		                                       meshGLColorMapChoiceValue) + 11.0)/1024.0);
-
-		if(showRepeatColorMapValue)
-		{
-			functionValueForTextureCoordinates =
-			        std::fabs(2.0*std::fmod(currentFunctionValue,
-			                                functionValueRepetitionIntervalValue))/
-			        functionValueRepetitionIntervalValue;
-
-			if(functionValueForTextureCoordinates > 1.0)
-			{
-				functionValueForTextureCoordinates = 2.0 - functionValueForTextureCoordinates;
-			}
-
-			textureCoordinateXDouble = functionValueToTextureCoordinateXScalingFactor*
-			                           functionValueForTextureCoordinates +
-			                           functionValueToTextureCoordinateXOffset;
-		}
-
-		else
-		{
-			normalizedRange = (currentFunctionValue - functionValueMin)/
-			                  (functionValueMax - functionValueMin);
-
-			if(normalizedRange < 0.0)
-			{
-				normalizedRange = 0.0;
-			}
-
-			else if(normalizedRange > 1.0)
-			{
-				normalizedRange = 1.0;
-			}
-
-			normalizedRange = std::pow(normalizedRange, functionValueLogarithmGammaValue);
-
-			textureCoordinateXDouble = functionValueToTextureCoordinateXScalingFactor*
-			                           normalizedRange +
-			                           functionValueToTextureCoordinateXOffset;
-		}
-
-		if(invertFunctionValueColorValue)
-		{
-			textureCoordinateXDouble = 1.0 - textureCoordinateXDouble;
-		}
-
-		textureCoordinateX = std::floor(imageWidth*textureCoordinateXDouble);
-		textureCoordinateY = std::floor(imageHeight*textureCoordinateYDouble);
-
-		currentPixelColor = QColor(colorMapImage.pixel(
-		                               textureCoordinateX, textureCoordinateY));
-
-		if(!currVertex->setRGB(static_cast<unsigned char>(currentPixelColor.red()),
-		                       static_cast<unsigned char>(currentPixelColor.green()),
-		                       static_cast<unsigned char>(currentPixelColor.blue())))
-		{
-			allSet = false;
-		}
-
-		showProgress(static_cast<double>(vertIdx)/
-		                        static_cast<double>(range),
-		                        "Vertex function value to "
-		                        "vertex RGB value transformation");
-
-	}
-
-	return allSet;
-
-}
-
-
 //! \brief		This function sets the Vertex color values of
 //!				the current mesh to the color representation of its Vertex
 //!				function values with the current function value color
-//!				representation options, using all available logical processors,
-//!				if more than one is available
+//!				representation options.
 //! \details	This function retrieves the currently used function value color
-//!				representation options, queries the available logical processors
-//!				available in the system. It then sets the Vertex color values of
-//!				the current mesh to the color representation of its Vertex
-//!				function values with the retrieved options, using all available
-//!				logical processors, if more than one is available.
-//!				The spawned threads call the function
-//!				runFunctionValueToRGBTransformation_impl, the thread calling this
-//!				function calls
-//!				runFunctionValueToRGBTransformationUpdateProgress_impl, which in
-//!				addition to performing the function color representation to color
-//!				value transformation updates the GigaMesh GUI progress bar.
-//! \return		True if all threads performed the transformation without error,
-//!				false if an error occured while retrieving a Vertex object
-//!				function value or setting a Vertex object color value in any of
-//!				the threads performing the transformation
+//!				representation options and the row of the chosen colormap
+//!				from the colormap image - see shaders/funcval.vert -> main().
+//!				A ColorMapLut is built once from these and applied to the
+//!				function values of all vertices using all available logical
+//!				processors - see Mesh::setVertRGBFromFuncVal.
+//! \return		True if the transformation was performed without error,
+//!				false if the colormap could not be loaded or applied.
 bool MeshGL::runFunctionValueToRGBTransformation()
 {
 
@@ -967,73 +672,46 @@ bool MeshGL::runFunctionValueToRGBTransformation()
 	getParamFloatMeshGL(MeshGLParams::FUNC_VALUE_LOG_GAMMA,
 	                    &functionValueLogarithmGammaValue);
 
-	const unsigned int availableConcurrentThreads = std::thread::hardware_concurrency();
-
-	bool allSet = true;
-
-	showProgressStart("Vertex function value to vertex RGB value transformation");
-
-	if(availableConcurrentThreads < 2)
+	if(colorMapImage.isNull())
 	{
-		allSet = runFunctionValueToRGBTransformationUpdateProgress_impl(colorMapImage,
-		                                                                  meshGLColorMapChoiceValue,
-		                                                                  showRepeatColorMapValue,
-		                                                                  invertFunctionValueColorValue,
-		                                                                  functionValueMin,
-		                                                                  functionValueMax,
-		                                                                  functionValueRepetitionIntervalValue,
-		                                                                  functionValueLogarithmGammaValue,
-		                                                                  0, getVertexNr());
+		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: Colormap image could not be loaded!" << endl;
+		return false;
 	}
 
-	else
-	{
-
-		const uint64_t offsetPerThread = getVertexNr()/availableConcurrentThreads;
-		const uint64_t verticesPerThread = offsetPerThread;
-		const uint64_t verticesForThisThread = offsetPerThread +
-		                                            getVertexNr() % availableConcurrentThreads;
-
-		std::vector<future<bool>> threadFutureHandlesVector(availableConcurrentThreads - 1);
+	// Row of the chosen colormap within the colormap image:
 
-		for(unsigned int threadCount = 0;
-		    threadCount < (availableConcurrentThreads - 1); threadCount++)
-		{
+	const double textureCoordinateYDouble = (1.0 - (20.0*static_cast<double>(
+	                                             meshGLColorMapChoiceValue) + 11.0)/1024.0);
+	const int textureCoordinateY = std::clamp(static_cast<int>(std::floor(
+	                                              colorMapImage.height()*textureCoordinateYDouble)),
+	                                          0, colorMapImage.height() - 1);
 
-			auto functionCall = std::bind(&MeshGL::runFunctionValueToRGBTransformation_impl,
-			                              this,
-			                              colorMapImage,
-			                              meshGLColorMapChoiceValue,
-			                              showRepeatColorMapValue,
-			                              invertFunctionValueColorValue,
-			                              functionValueMin,
-			                              functionValueMax,
-			                              functionValueRepetitionIntervalValue,
-			                              functionValueLogarithmGammaValue,
-			                              offsetPerThread*threadCount,
-			                              verticesPerThread);
+	std::vector<uint8_t> colorRampRGB(static_cast<size_t>(colorMapImage.width())*3);
+	for(int textureCoordinateX = 0; textureCoordinateX < colorMapImage.width(); textureCoordinateX++)
+	{
+		const QRgb currentPixelColor = colorMapImage.pixel(textureCoordinateX, textureCoordinateY);
+		colorRampRGB[textureCoordinateX*3]   = static_cast<uint8_t>(qRed(currentPixelColor));
+		colorRampRGB[textureCoordinateX*3+1] = static_cast<uint8_t>(qGreen(currentPixelColor));
+		colorRampRGB[textureCoordinateX*3+2] = static_cast<uint8_t>(qBlue(currentPixelColor));
+	}
 
-			threadFutureHandlesVector.at(threadCount) =
-			        std::async(std::launch::async, functionCall);
-		}
+	ColorMapLut::sParams colorMapParams;
+	colorMapParams.mFuncValMin     = functionValueMin;
+	colorMapParams.mFuncValMax     = functionValueMax;
+	colorMapParams.mGamma          = functionValueLogarithmGammaValue;
+	colorMapParams.mInvert         = invertFunctionValueColorValue;
+	colorMapParams.mRepeat         = showRepeatColorMapValue;
+	colorMapParams.mRepeatInterval = functionValueRepetitionIntervalValue;
 
-		allSet = runFunctionValueToRGBTransformationUpdateProgress_impl(colorMapImage,
-		                                                  meshGLColorMapChoiceValue,
-		                                                  showRepeatColorMapValue,
-		                                                  invertFunctionValueColorValue,
-		                                                  functionValueMin,
-		                                                  functionValueMax,
-		                                                  functionValueRepetitionIntervalValue,
-		                                                  functionValueLogarithmGammaValue,
-		                                                  offsetPerThread*(availableConcurrentThreads - 1),
-		                                                  verticesForThisThread);
+	ColorMapLut colorMap;
+	if(!colorMap.build(colorRampRGB.data(), static_cast<uint64_t>(colorMapImage.width()), colorMapParams))
+	{
+		return false;
+	}
 
-		for(std::future<bool>& threadFutureHandle : threadFutureHandlesVector)
-		{
-			allSet &= threadFutureHandle.get();
-		}
+	showProgressStart("Vertex function value to vertex RGB value transformation");
 
-	}
+	const bool allSet = setVertRGBFromFuncVal(colorMap);
 
 	showProgressStop("Vertex function value to vertex RGB value transformation");
 
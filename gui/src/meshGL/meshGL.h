@@ -220,30 +220,6 @@ private:
 			void vboAddBuffer(GLsizeiptr rTotalSize, GLvoid* rData,
 			                  QOpenGLBuffer::UsagePattern rUsage, eVertBufObjs rBufferID, const std::string& rCallingFunc );
 
-			bool runFunctionValueToRGBTransformation_impl(
-			                const QImage& colorMapImage,
-			                const int meshGLColorMapChoiceValue,
-			                const bool showRepeatColorMapValue,
-			                const bool invertFunctionValueColorValue,
-			                const double functionValueMin,
-			                const double functionValueMax,
-			                const double functionValueRepetitionIntervalValue,
-			                const double functionValueLogarithmGammaValue,
-			                const uint64_t offset,
-			                const uint64_t range );
-
-			bool runFunctionValueToRGBTransformationUpdateProgress_impl(
-			                const QImage& colorMapImage,
-			                const int meshGLColorMapChoiceValue,
-			                const bool showRepeatColorMapValue,
-			                const bool invertFunctionValueColorValue,
-			                const double functionValueMin,
-			                const double functionValueMax,
-			                const double functionValueRepetitionIntervalValue,
-			                const double functionValueLogarithmGammaValue,
-			                const uint64_t offset,
-			                const uint64_t range );
-
 			bool runFunctionValueNormalization_impl(const bool showRepeatColorMapValue,
 													  const bool invertFunctionValueColorValue,
 													  const double functionValueMin,
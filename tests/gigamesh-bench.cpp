@@ -0,0 +1,442 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+//! Benchmark of the hot paths of the core library using synthetic meshes.
+//!
+//! Each case is timed several times and the median, 95th percentile and
+//! throughput are written as JSON, so runs can be compared to track
+//! regressions. The meshes are generated, so no test data is required.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _MSC_VER
+#include "../cli/getoptwin.h"
+#else
+#include <getopt.h>
+#endif
+
+#include "../core/mesh/MeshIO/PlyReader.h"
+#include "../core/mesh/MeshIO/PlyWriter.h"
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/compfeaturevecs.h>
+#include <GigaMesh/mesh/voxelfilter25d.h>
+#include <GigaMesh/mesh/meshinfodata.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+#include <GigaMesh/profiling/Profiling.h>
+
+//! Synthetic mesh as properties, as passed from the readers to the Mesh.
+struct sSyntheticMesh {
+	std::string                    mName;
+	std::vector<sVertexProperties> mVertexProps;
+	std::vector<sFaceProperties>   mFaceProps;
+};
+
+//! Timings of one case.
+struct sBenchResult {
+	std::string         mName;            //!< Name of the case.
+	std::string         mMeshName;        //!< Name of the synthetic mesh.
+	uint64_t            mElements = 0;    //!< Number of elements processed per run.
+	std::string         mElementUnit;     //!< Type of the elements e.g. vertices.
+	std::vector<double> mSeconds;         //!< Wall-clock time per run.
+};
+
+//! Adds a vertex of the given position.
+void addVertex( sSyntheticMesh& rMesh, double rX, double rY, double rZ ) {
+	sVertexProperties vertexProps;
+	vertexProps.mCoordX  = rX;
+	vertexProps.mCoordY  = rY;
+	vertexProps.mCoordZ  = rZ;
+	vertexProps.mFuncVal = rZ;
+	rMesh.mVertexProps.push_back( vertexProps );
+}
+
+//! Adds a triangle of the given vertex indices.
+void addFace( sSyntheticMesh& rMesh, uint64_t rVertA, uint64_t rVertB, uint64_t rVertC ) {
+	sFaceProperties faceProps;
+	faceProps.vertexIndices = { rVertA, rVertB, rVertC };
+	rMesh.mFaceProps.push_back( faceProps );
+}
+
+//! Tessellated unit sphere of rings and segments i.e. a closed mesh without borders.
+sSyntheticMesh generateSphere( uint64_t rVertexCount ) {
+	sSyntheticMesh sphere;
+	sphere.mName = "sphere";
+	const uint64_t segments = std::max<uint64_t>( 8, static_cast<uint64_t>( std::sqrt( 2.0 * static_cast<double>( rVertexCount ) ) ) );
+	const uint64_t rings    = std::max<uint64_t>( 4, segments / 2 );
+	addVertex( sphere, 0.0, 0.0, 1.0 );
+	for( uint64_t ring=1; ring<rings; ring++ ) {
+		const double theta = M_PI * static_cast<double>( ring ) / static_cast<double>( rings );
+		for( uint64_t segment=0; segment<segments; segment++ ) {
+			const double phi = 2.0 * M_PI * static_cast<double>( segment ) / static_cast<double>( segments );
+			addVertex( sphere, std::sin( theta ) * std::cos( phi ), std::sin( theta ) * std::sin( phi ), std::cos( theta ) );
+		}
+	}
+	addVertex( sphere, 0.0, 0.0, -1.0 );
+	const uint64_t southPole = sphere.mVertexProps.size() - 1;
+	auto ringVertex = [segments]( uint64_t rRing, uint64_t rSegment ) {
+		return( 1 + ( rRing - 1 ) * segments + ( rSegment % segments ) );
+	};
+	for( uint64_t segment=0; segment<segments; segment++ ) {
+		addFace( sphere, 0, ringVertex( 1, segment ), ringVertex( 1, segment+1 ) );
+		for( uint64_t ring=1; ring+1<rings; ring++ ) {
+			addFace( sphere, ringVertex( ring, segment ), ringVertex( ring+1, segment ), ringVertex( ring+1, segment+1 ) );
+			addFace( sphere, ringVertex( ring, segment ), ringVertex( ring+1, segment+1 ), ringVertex( ring, segment+1 ) );
+		}
+		addFace( sphere, southPole, ringVertex( rings-1, segment+1 ), ringVertex( rings-1, segment ) );
+	}
+	return( sphere );
+}
+
+//! Square height field with a smooth relief plus uniform noise. Optionally with
+//! circular holes, which are removed together with their vertices.
+sSyntheticMesh generateHeightField( uint64_t rVertexCount, bool rWithHoles ) {
+	sSyntheticMesh heightField;
+	heightField.mName = rWithHoles ? "holes" : "heightfield";
+	const uint64_t gridSize = std::max<uint64_t>( 8, static_cast<uint64_t>( std::sqrt( static_cast<double>( rVertexCount ) ) ) );
+	std::mt19937 randomGenerator( 4711 ); // Fixed seed for reproducible meshes.
+	std::uniform_real_distribution<double> noise( -0.05, 0.05 );
+	for( uint64_t row=0; row<gridSize; row++ ) {
+		for( uint64_t col=0; col<gridSize; col++ ) {
+			const double posX = static_cast<double>( col );
+			const double posY = static_cast<double>( row );
+			addVertex( heightField, posX, posY, 2.0 * std::sin( posX * 0.1 ) * std::cos( posY * 0.07 ) + noise( randomGenerator ) );
+		}
+	}
+
+	// Holes on a regular pattern with radii between one and three grid cells.
+	const double holeSpacing = 16.0;
+	auto isInHole = [rWithHoles,holeSpacing,gridSize]( double rX, double rY ) {
+		if( !rWithHoles ) {
+			return( false );
+		}
+		const double cellX = std::floor( rX / holeSpacing );
+		const double cellY = std::floor( rY / holeSpacing );
+		const double centerX = ( cellX + 0.5 ) * holeSpacing;
+		const double centerY = ( cellY + 0.5 ) * holeSpacing;
+		if( ( centerX + holeSpacing > static_cast<double>( gridSize ) ) || ( centerY + holeSpacing > static_cast<double>( gridSize ) ) ) {
+			return( false ); // Keep the holes away from the border of the mesh.
+		}
+		const double radius = 1.0 + std::fmod( cellX + cellY, 3.0 );
+		return( ( rX - centerX ) * ( rX - centerX ) + ( rY - centerY ) * ( rY - centerY ) < radius * radius );
+	};
+	for( uint64_t row=0; row+1<gridSize; row++ ) {
+		for( uint64_t col=0; col+1<gridSize; col++ ) {
+			if( isInHole( static_cast<double>( col ) + 0.5, static_cast<double>( row ) + 0.5 ) ) {
+				continue;
+			}
+			const uint64_t vertIdx = row * gridSize + col;
+			addFace( heightField, vertIdx, vertIdx + 1, vertIdx + gridSize + 1 );
+			addFace( heightField, vertIdx, vertIdx + gridSize + 1, vertIdx + gridSize );
+		}
+	}
+
+	// Remove vertices not referenced by faces:
+	std::vector<uint64_t> newIndex( heightField.mVertexProps.size(), 0 );
+	for( const sFaceProperties& faceProps : heightField.mFaceProps ) {
+		for( const uint64_t vertIdx : faceProps.vertexIndices ) {
+			newIndex[vertIdx] = 1;
+		}
+	}
+	uint64_t vertexCount = 0;
+	for( uint64_t vertIdx=0; vertIdx<newIndex.size(); vertIdx++ ) {
+		if( newIndex[vertIdx] != 0 ) {
+			heightField.mVertexProps[vertexCount] = heightField.mVertexProps[vertIdx];
+			newIndex[vertIdx] = vertexCount++;
+		}
+	}
+	heightField.mVertexProps.resize( vertexCount );
+	for( sFaceProperties& faceProps : heightField.mFaceProps ) {
+		for( uint64_t& vertIdx : faceProps.vertexIndices ) {
+			vertIdx = newIndex[vertIdx];
+		}
+	}
+	return( heightField );
+}
+
+//! Writes the synthetic mesh as PLY.
+bool writeSyntheticMesh( const sSyntheticMesh& rMesh, const std::filesystem::path& rFileName, bool rBinary ) {
+	PlyWriter writer;
+	writer.setExportBinary( rBinary );
+	MeshSeedExt meshSeed;
+	return( writer.writeFile( rFileName, rMesh.mVertexProps, rMesh.mFaceProps, meshSeed ) );
+}
+
+//! Times a case. The preparation is called before each run and is not timed.
+//! The case returns the seconds to report or a negative value to report the wall-clock time of the call.
+sBenchResult runCase( const std::string& rName, const sSyntheticMesh& rMesh, uint64_t rElements, const std::string& rElementUnit,
+                      unsigned int rRepetitions, const std::function<void()>& rPrepare, const std::function<double()>& rCase ) {
+	sBenchResult result;
+	result.mName        = rName;
+	result.mMeshName    = rMesh.mName;
+	result.mElements    = rElements;
+	result.mElementUnit = rElementUnit;
+	for( unsigned int i=0; i<rRepetitions; i++ ) {
+		rPrepare();
+		const auto timeStart = std::chrono::steady_clock::now();
+		double seconds = rCase();
+		if( seconds < 0.0 ) {
+			seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - timeStart ).count();
+		}
+		result.mSeconds.push_back( seconds );
+	}
+	std::cerr << "[GigaMesh] " << rName << " (" << rMesh.mName << "): " << result.mSeconds.size() << " runs done." << std::endl;
+	return( result );
+}
+
+//! @returns the value at the given percentile using the nearest rank of the sorted values.
+double getPercentile( std::vector<double> rValues, double rPercentile ) {
+	if( rValues.empty() ) {
+		return( 0.0 );
+	}
+	std::sort( rValues.begin(), rValues.end() );
+	const double rank = std::ceil( rPercentile / 100.0 * static_cast<double>( rValues.size() ) );
+	const uint64_t index = static_cast<uint64_t>( std::clamp( rank, 1.0, static_cast<double>( rValues.size() ) ) ) - 1;
+	return( rValues[index] );
+}
+
+//! Writes the results as JSON.
+bool writeResults( const std::vector<sBenchResult>& rResults, uint64_t rSize, unsigned int rRepetitions, std::ostream& rOut ) {
+	rOut << "{\n";
+	rOut << "  \"benchmark\": \"gigamesh-bench\",\n";
+	rOut << "  \"version\": \"" << VERSION_PACKAGE << "\",\n";
+	rOut << "  \"threads\": " << ParallelFor::getThreadCount() << ",\n";
+	rOut << "  \"size\": " << rSize << ",\n";
+	rOut << "  \"repetitions\": " << rRepetitions << ",\n";
+	rOut << "  \"results\": [\n";
+	for( uint64_t i=0; i<rResults.size(); i++ ) {
+		const sBenchResult& result = rResults[i];
+		const double median = getPercentile( result.mSeconds, 50.0 );
+		const double throughput = ( median > 0.0 ) ? static_cast<double>( result.mElements ) / median : 0.0;
+		rOut << "    {\n";
+		rOut << "      \"name\": \"" << result.mName << "\",\n";
+		rOut << "      \"mesh\": \"" << result.mMeshName << "\",\n";
+		rOut << "      \"elements\": " << result.mElements << ",\n";
+		rOut << "      \"runs\": " << result.mSeconds.size() << ",\n";
+		rOut << "      \"min_s\": " << getPercentile( result.mSeconds, 0.0 ) << ",\n";
+		rOut << "      \"median_s\": " << median << ",\n";
+		rOut << "      \"p95_s\": " << getPercentile( result.mSeconds, 95.0 ) << ",\n";
+		rOut << "      \"throughput\": " << throughput << ",\n";
+		rOut << "      \"throughput_unit\": \"" << result.mElementUnit << "/s\"\n";
+		rOut << "    }" << ( ( i+1 < rResults.size() ) ? "," : "" ) << "\n";
+	}
+	rOut << "  ]\n";
+	rOut << "}\n";
+	return( rOut.good() );
+}
+
+//! Help i.e. usage of paramters.
+void printHelp( const char* rExecName ) {
+	std::cout << "Usage: " << rExecName << " [options]" << std::endl;
+	std::cout << "GigaMesh Software Framework BENCHMARK of the core library" << std::endl << std::endl;
+	std::cout << "Times parsing, establishing the structure, feature vectors, labeling, borders, hole filling" << std::endl;
+	std::cout << "and mesh information on synthetic meshes: a sphere, a noisy height field and a height field with holes." << std::endl << std::endl;
+	std::cout << "Options:" << std::endl;
+	std::cout << "  -o, --output-json <file>   Write the results to this JSON file. Default: gigamesh-bench.json" << std::endl;
+	std::cout << "  -s, --size <vertices>      Approximate number of vertices per mesh. Default: 100000" << std::endl;
+	std::cout << "  -r, --repetitions <count>  Number of timed runs per case. Default: 5" << std::endl;
+	std::cout << "  -d, --temp-dir <path>      Directory for the generated PLY files. Default: system temp directory" << std::endl;
+	std::cout << "  -h, --help                 Display this help and exit." << std::endl;
+}
+
+int main( int argc, char* argv[] ) {
+	LOG::initLogging();
+	LOG::setLogLevel( LOG::LogLevel::eWarn );
+
+	std::filesystem::path fileNameOut( "gigamesh-bench.json" );
+	std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+	uint64_t     meshSize    = 100000;
+	unsigned int repetitions = 5;
+
+	static struct option longOptions[] = {
+		{ "output-json", required_argument, nullptr, 'o' },
+		{ "size",        required_argument, nullptr, 's' },
+		{ "repetitions", required_argument, nullptr, 'r' },
+		{ "temp-dir",    required_argument, nullptr, 'd' },
+		{ "help",        no_argument,       nullptr, 'h' },
+		{ nullptr, 0, nullptr, 0 }
+	};
+	int character = 0;
+	int optionIndex = 0;
+	while( ( character = getopt_long_only( argc, argv, ":o:s:r:d:h", longOptions, &optionIndex ) ) != -1 ) {
+		switch( character ) {
+			case 'o':
+				fileNameOut = std::filesystem::path( optarg );
+				break;
+			case 's':
+				meshSize = static_cast<uint64_t>( std::max( std::atoll( optarg ), 64LL ) );
+				break;
+			case 'r':
+				repetitions = static_cast<unsigned int>( std::max( std::atoi( optarg ), 1 ) );
+				break;
+			case 'd':
+				tempDir = std::filesystem::path( optarg );
+				break;
+			case 'h':
+				printHelp( argv[0] );
+				std::exit( EXIT_SUCCESS );
+			default:
+				std::cerr << "[GigaMesh] Error: Unknown option '" << static_cast<char>( optopt ) << "'!" << std::endl;
+				printHelp( argv[0] );
+				std::exit( EXIT_FAILURE );
+		}
+	}
+
+	std::vector<sBenchResult> results;
+	const sSyntheticMesh sphere      = generateSphere( meshSize );
+	const sSyntheticMesh heightField = generateHeightField( meshSize, false );
+	const sSyntheticMesh withHoles   = generateHeightField( meshSize, true );
+	std::vector<std::filesystem::path> filesToRemove;
+
+	for( const sSyntheticMesh* syntheticMesh : { &sphere, &heightField, &withHoles } ) {
+		const uint64_t vertexCount = syntheticMesh->mVertexProps.size();
+		const uint64_t primitiveCount = vertexCount + syntheticMesh->mFaceProps.size();
+		const std::filesystem::path fileBinary = tempDir / ( "gigamesh-bench-" + syntheticMesh->mName + "-binary.ply" );
+		const std::filesystem::path fileAscii  = tempDir / ( "gigamesh-bench-" + syntheticMesh->mName + "-ascii.ply" );
+		if( !writeSyntheticMesh( *syntheticMesh, fileBinary, true ) || !writeSyntheticMesh( *syntheticMesh, fileAscii, false ) ) {
+			std::cerr << "[GigaMesh] Error: Could not write the synthetic meshes to " << tempDir << "!" << std::endl;
+			return( EXIT_FAILURE );
+		}
+		filesToRemove.push_back( fileBinary );
+		filesToRemove.push_back( fileAscii );
+
+		// --- Parsing ----------------------------------------------------------------
+		for( const bool binary : { true, false } ) {
+			const std::filesystem::path& fileName = binary ? fileBinary : fileAscii;
+			results.push_back( runCase( binary ? "ply_parse_binary" : "ply_parse_ascii", *syntheticMesh, primitiveCount, "primitives",
+			                            repetitions, [](){}, [&fileName]() {
+				std::vector<sVertexProperties> vertexProps;
+				std::vector<sFaceProperties>   faceProps;
+				MeshSeedExt meshSeed;
+				PlyReader reader;
+				reader.readFile( fileName, vertexProps, faceProps, meshSeed );
+				return( -1.0 );
+			} ) );
+		}
+
+		// --- Mesh::establishStructure i.e. the part of loading after parsing -------
+		results.push_back( runCase( "establish_structure", *syntheticMesh, primitiveCount, "primitives",
+		                            repetitions, [](){}, [&fileBinary]() {
+			PROFILE::clear();
+			PROFILE::setEnabled( true );
+			bool readSuccess = false;
+			Mesh someMesh( fileBinary, readSuccess );
+			PROFILE::setEnabled( false );
+			return( static_cast<double>( PROFILE::getSpanTotalNs( "Mesh::establishStructure" ) ) / 1.0e9 );
+		} ) );
+
+		// --- Algorithms on a freshly loaded mesh per run ----------------------------
+		std::unique_ptr<Mesh> someMesh;
+		auto loadMesh = [&someMesh,&fileBinary]() {
+			bool readSuccess = false;
+			someMesh = std::make_unique<Mesh>( fileBinary, readSuccess );
+		};
+		results.push_back( runCase( "mesh_info", *syntheticMesh, primitiveCount, "primitives", repetitions, loadMesh, [&someMesh]() {
+			MeshInfoData meshInfo;
+			someMesh->getMeshInfoData( meshInfo, true );
+			return( -1.0 );
+		} ) );
+		results.push_back( runCase( "label_vertices", *syntheticMesh, vertexCount, "vertices", repetitions, loadMesh, [&someMesh]() {
+			someMesh->labelVerticesAll();
+			return( -1.0 );
+		} ) );
+		if( syntheticMesh == &sphere ) {
+			continue; // No borders and the curvature is constant.
+		}
+		results.push_back( runCase( "convert_borders_to_polylines", *syntheticMesh, vertexCount, "vertices", repetitions, loadMesh, [&someMesh]() {
+			someMesh->convertBordersToPolylines();
+			return( -1.0 );
+		} ) );
+		if( syntheticMesh == &withHoles ) {
+			results.push_back( runCase( "fill_polylines", *syntheticMesh, vertexCount, "vertices", repetitions, [&]() {
+				loadMesh();
+				someMesh->convertBordersToPolylines();
+			}, [&someMesh]() {
+				uint64_t holesFilled = 0;
+				uint64_t holesFail = 0;
+				uint64_t holesSkipped = 0;
+				someMesh->fillPolyLines( 64, holesFilled, holesFail, holesSkipped ); // Holes only, as the outer border is longer.
+				return( -1.0 );
+			} ) );
+			continue;
+		}
+
+		// --- Multi-Scale Integral Invariants on the height field ---------------------
+		const unsigned int threadCount = ParallelFor::getThreadCount();
+		uint   xyzDim = 64;
+		double radius = 2.0;
+		std::vector<double> multiscaleRadii( 4 );
+		for( uint64_t i=0; i<multiscaleRadii.size(); i++ ) {
+			multiscaleRadii[i] = 1.0 - static_cast<double>( i ) / static_cast<double>( multiscaleRadii.size() );
+		}
+		voxelFilter2DElements* sparseFilters = nullptr;
+		double** voxelFilters = generateVoxelFilters2D( multiscaleRadii.size(), multiscaleRadii.data(), xyzDim, &sparseFilters );
+		std::vector<double> descriptVolume( vertexCount * multiscaleRadii.size() );
+		std::vector<double> descriptSurface( vertexCount * multiscaleRadii.size() );
+		std::vector<MeshIO::grVector3ID> patchNormals( vertexCount );
+		results.push_back( runCase( "feature_vectors", *syntheticMesh, vertexCount, "vertices", repetitions, loadMesh, [&]() {
+			std::vector<sMeshDataStruct> meshData( threadCount );
+			for( unsigned int t=0; t<threadCount; t++ ) {
+				meshData[t].threadID            = t;
+				meshData[t].meshToAnalyze       = someMesh.get();
+				meshData[t].radius              = radius;
+				meshData[t].xyzDim              = xyzDim;
+				meshData[t].multiscaleRadiiSize = multiscaleRadii.size();
+				meshData[t].multiscaleRadii     = multiscaleRadii.data();
+				meshData[t].sparseFilters       = &sparseFilters;
+				meshData[t].mPatchNormal        = &patchNormals;
+				meshData[t].descriptVolume      = descriptVolume.data();
+				meshData[t].descriptSurface     = descriptSurface.data();
+			}
+			compFeatureVectorsMain( meshData.data(), threadCount );
+			return( -1.0 );
+		} ) );
+		for( uint64_t i=0; i<multiscaleRadii.size(); i++ ) {
+			free( voxelFilters[i] );
+			free( sparseFilters[i].elementIndices );
+			free( sparseFilters[i].elementValues );
+		}
+		free( voxelFilters );
+		free( sparseFilters );
+	}
+
+	for( const std::filesystem::path& fileName : filesToRemove ) {
+		std::filesystem::remove( fileName );
+	}
+
+	std::ofstream fileOut( fileNameOut );
+	if( !fileOut.is_open() || !writeResults( results, meshSize, repetitions, fileOut ) ) {
+		std::cerr << "[GigaMesh] Error: Could not write results to " << fileNameOut << "!" << std::endl;
+		return( EXIT_FAILURE );
+	}
+	std::cout << "[GigaMesh] Results written to: " << fileNameOut << std::endl;
+	return( EXIT_SUCCESS );
+}
@@ -20,17 +20,90 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <clocale>
+#include <ctime>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
 #include <catch.hpp>
 #include "../core/mesh/MeshIO/ObjReader.h"
 #include "../core/mesh/MeshIO/PlyReader.h"
 #include "../core/mesh/MeshIO/PlyWriter.h"
 #include "../core/mesh/MeshIO/ObjWriter.h"
+#include "../core/mesh/MeshIO/TxtReader.h"
+#include "../core/mesh/MeshIO/TxtWriter.h"
+#include <GigaMesh/getlocaltime.h>
+#include <GigaMesh/mesh/MeshIO/PlyStreamConverter.h>
 #include <GigaMesh/mesh/meshio.h>
+#include <GigaMesh/mesh/numerictable.h>
+#include <GigaMesh/mesh/parsenumber.h>
 #include <GigaMesh/mesh/vector3d.h>
 #include "../core/mesh/util/triangulation.h"
 
 const std::string gTestFilesPath("testdata/");
 
+//! Small mesh with values, which are formatted differently: negative zero, exponents,
+//! rounding to six digits, not-a-number, large labels and flags, a quad and two textures.
+void getGoldenWriterInput(std::vector<sVertexProperties>& rVertexProperties, std::vector<sFaceProperties>& rFaceProperties)
+{
+	const double coords[6][3] = { { 0.0, 0.0, 0.0 }, { 1.5, -0.25, 1234567.0 }, { -0.0, 0.1, 3.14159265 },
+	                              { 1e-7, -2.5e+20, 100000.0 }, { 123456.0, 0.000123456, -7.125 }, { 10.0, 20.0, 30.0 } };
+	const double funcVals[6] = { std::numeric_limits<double>::quiet_NaN(), 0.5, -1.75, 1e-10, 65535.5, 1e+30 };
+	const double normals[6][3] = { { std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN() },
+	                               { 0.0, 0.0, 1.0 }, { 0.57735, 0.57735, 0.57735 }, { -1.0, 0.0, 0.0 }, { 0.6, -0.8, 0.0 }, { 0.0, 1.0, 0.0 } };
+	const uint64_t labels[6] = { 0, 1, 2, 7, 4294967295ULL, 3 };
+	const uint64_t flags[6]  = { 0, 1, 42, 2147483649ULL, 65536, 3 };
+	rVertexProperties.resize(6);
+	for(uint64_t vertIdx = 0; vertIdx < rVertexProperties.size(); vertIdx++)
+	{
+		sVertexProperties& vertexProps = rVertexProperties[vertIdx];
+		vertexProps.mCoordX   = coords[vertIdx][0];
+		vertexProps.mCoordY   = coords[vertIdx][1];
+		vertexProps.mCoordZ   = coords[vertIdx][2];
+		vertexProps.mNormalX  = normals[vertIdx][0];
+		vertexProps.mNormalY  = normals[vertIdx][1];
+		vertexProps.mNormalZ  = normals[vertIdx][2];
+		vertexProps.mFuncVal  = funcVals[vertIdx];
+		vertexProps.mColorRed = static_cast<unsigned char>(vertIdx * 51);
+		vertexProps.mColorGrn = static_cast<unsigned char>(255 - vertIdx);
+		vertexProps.mColorBle = 128;
+		vertexProps.mLabelId  = labels[vertIdx];
+		vertexProps.mFlags    = flags[vertIdx];
+	}
+	rFaceProperties = {
+		{ { 0, 1, 2 },    { 0.0f, 0.0f, 1.0f, 0.0f, 0.5f, 1.0f }, 0 },
+		{ { 1, 3, 2 },    { 0.125f, 0.3f, 0.75f, 0.3f, 0.5f, 0.9f }, 1 },
+		{ { 2, 3, 4, 5 }, { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f }, 0 },
+		{ { 0, 4, 5 },    { 1.0f, 1.0f, 0.0f, 1.0f, 0.25f, 0.0f }, 1 }
+	};
+}
+
+//! Reads a written file without the lines holding the build information, which start with
+//! the given prefix. Only the header is filtered, so binary payloads stay unchanged.
+std::string readWithoutBuildInfo(const std::filesystem::path& rFileName, const std::string& rBuildInfoPrefix)
+{
+	std::ifstream file(rFileName, std::ios::binary);
+	const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	const size_t headerEnd = std::min(content.find("end_header\n"), content.size());
+	std::string filtered;
+	size_t lineStart = 0;
+	while(lineStart < headerEnd)
+	{
+		const size_t lineEnd = std::min(content.find('\n', lineStart), headerEnd - 1) + 1;
+		if(content.compare(lineStart, rBuildInfoPrefix.size(), rBuildInfoPrefix) != 0)
+		{
+			filtered.append(content, lineStart, lineEnd - lineStart);
+		}
+		lineStart = lineEnd;
+	}
+	filtered.append(content, headerEnd, std::string::npos);
+	return filtered;
+}
+
 //unit test => check if the reader to their work properly
 TEST_CASE("Mesh Reader Tests", "[meshio]")
 {
@@ -242,3 +315,617 @@ TEST_CASE("Mesh Triangulation Test", "[meshio]")
 		}
 	}
 }
+
+TEST_CASE("Numeric Table Reader Tests", "[meshio]")
+{
+	const std::filesystem::path tableFile(gTestFilesPath + "tmpTable.txt");
+
+	SECTION("Comments, index column, missing and invalid values")
+	{
+		{
+			std::ofstream fileOut(tableFile, std::ios::binary);
+			fileOut << "# comment\r\n"
+			        << "0 1.5 -2e3\r\n"
+			        << "\r\n"
+			        << "   # indented comment\n"
+			        << "3\t+0.25,nan\n"
+			        << "1 abc 7\n"
+			        << "9 1 2\n"
+			        << "-1 4 5\n"
+			        << "2 inf";
+		}
+		NumericTable table;
+		NumericTable::sParams params;
+		params.mFirstColIsIndex = true;
+		params.mRowCount        = 5;
+		REQUIRE(table.read(tableFile, params));
+		std::filesystem::remove(tableFile);
+
+		CHECK(table.getLineCount() == 9);
+		CHECK(table.getRowCount() == 5);
+		CHECK(table.getColCount() == 2);
+		CHECK(table.getColCountMin() == 1);
+		CHECK(table.getInvalidCount() == 2);
+		CHECK(table.getFirstInvalidLine() == 6);
+		CHECK(table.getSkippedCount() == 2);
+		CHECK(table.get(0, 0) == 1.5);
+		CHECK(table.get(0, 1) == -2000.0);
+		CHECK(std::isnan(table.get(1, 0)));
+		CHECK(table.get(1, 1) == 7.0);
+		CHECK(table.get(2, 0) == std::numeric_limits<double>::infinity());
+		CHECK(std::isnan(table.get(2, 1)));
+		CHECK(table.get(3, 0) == 0.25);
+		CHECK(std::isnan(table.get(3, 1)));
+		CHECK_FALSE(table.isRowGiven(4));
+		CHECK(table.isRowGiven(3));
+	}
+
+	SECTION("Large file parsed in chunks by multiple threads")
+	{
+		const uint64_t lineCount = 200000;
+		{
+			std::ofstream fileOut(tableFile);
+			for(uint64_t lineIdx = 0; lineIdx < lineCount; lineIdx++)
+			{
+				fileOut << (lineCount - 1 - lineIdx) << " " << lineIdx * 0.5 << " " << lineIdx << "\n";
+				if(lineIdx % 1000 == 0)
+				{
+					fileOut << "# comment " << lineIdx << "\n";
+				}
+			}
+		}
+		NumericTable tableByIndex;
+		NumericTable tableByLine;
+		NumericTable::sParams params;
+		params.mFirstColIsIndex = true;
+		params.mThreadCount     = 4;
+		REQUIRE(tableByLine.read(tableFile, params));
+		params.mRowCount = lineCount;
+		REQUIRE(tableByIndex.read(tableFile, params));
+		std::filesystem::remove(tableFile);
+
+		REQUIRE(tableByLine.getRowCount() == lineCount);
+		REQUIRE(tableByIndex.getRowCount() == lineCount);
+		CHECK(tableByLine.getColCount() == 2);
+		CHECK(tableByLine.getInvalidCount() == 0);
+		uint64_t valuesDiffering = 0;
+		for(uint64_t rowIdx = 0; rowIdx < lineCount; rowIdx++)
+		{
+			valuesDiffering += (tableByLine.getIndex(rowIdx) != lineCount - 1 - rowIdx);
+			valuesDiffering += (tableByLine.get(rowIdx, 0) != rowIdx * 0.5);
+			valuesDiffering += (tableByIndex.get(lineCount - 1 - rowIdx, 1) != static_cast<double>(rowIdx));
+		}
+		CHECK(valuesDiffering == 0);
+	}
+
+	SECTION("Duplicate indices in different chunks")
+	{
+		const uint64_t lineCount = 200000;
+		const uint64_t rowCount  = 1000;
+		{
+			std::ofstream fileOut(tableFile);
+			for(uint64_t lineIdx = 0; lineIdx < lineCount; lineIdx++)
+			{
+				fileOut << (lineIdx % rowCount) << " " << lineIdx << " " << (lineIdx == 7 ? "abc" : "1") << "\n";
+			}
+		}
+		NumericTable table;
+		NumericTable::sParams params;
+		params.mFirstColIsIndex = true;
+		params.mRowCount        = rowCount;
+		params.mThreadCount     = 4;
+		REQUIRE(table.read(tableFile, params));
+		std::filesystem::remove(tableFile);
+
+		REQUIRE(table.getRowCount() == rowCount);
+		CHECK(table.getInvalidCount() == 1);
+		CHECK(table.getFirstInvalidLine() == 8);
+		CHECK(table.getSkippedCount() == 0);
+		uint64_t valuesDiffering = 0;
+		for(uint64_t rowIdx = 0; rowIdx < rowCount; rowIdx++)
+		{
+			valuesDiffering += !table.isRowGiven(rowIdx);
+			valuesDiffering += (table.get(rowIdx, 0) != static_cast<double>(lineCount - rowCount + rowIdx));
+			valuesDiffering += (table.get(rowIdx, 1) != 1.0);
+		}
+		CHECK(valuesDiffering == 0);
+	}
+}
+
+TEST_CASE("PLY Stream Converter Tests", "[meshio]")
+{
+	const std::filesystem::path inFile(gTestFilesPath + "tmpStreamIn.ply");
+	const std::filesystem::path outFile(gTestFilesPath + "tmpStreamOut.ply");
+
+	// Big endian with doubles, a skipped element and a quad.
+	{
+		auto writeBigEndian = [](std::ofstream& rOut, const auto rValue) {
+			char bytes[sizeof(rValue)];
+			std::memcpy(bytes, &rValue, sizeof(rValue));
+			std::reverse(bytes, bytes + sizeof(rValue));
+			rOut.write(bytes, sizeof(rValue));
+		};
+		std::ofstream fileOut(inFile, std::ios::binary);
+		fileOut << "ply\n"
+		        << "format binary_big_endian 1.0\n"
+		        << "comment ModelID TestID\n"
+		        << "element camera 1\n"
+		        << "property float32 view_x\n"
+		        << "element vertex 5\n"
+		        << "property float64 x\n"
+		        << "property float64 y\n"
+		        << "property float64 z\n"
+		        << "property uint16 ignored\n"
+		        << "property float32 quality\n"
+		        << "property uchar red\n"
+		        << "property uchar green\n"
+		        << "property uchar blue\n"
+		        << "element face 2\n"
+		        << "property list uchar uint32 vertex_indices\n"
+		        << "end_header\n";
+		writeBigEndian(fileOut, 1.0f);
+		for(int vertIdx = 0; vertIdx < 5; vertIdx++)
+		{
+			writeBigEndian(fileOut, vertIdx * 1.5);
+			writeBigEndian(fileOut, -vertIdx * 2.0);
+			writeBigEndian(fileOut, 0.25);
+			writeBigEndian(fileOut, static_cast<uint16_t>(vertIdx));
+			writeBigEndian(fileOut, static_cast<float>(vertIdx) * 0.5f);
+			fileOut.put(static_cast<char>(vertIdx * 10)).put(static_cast<char>(20)).put(static_cast<char>(30));
+		}
+		fileOut.put(3);
+		for(uint32_t vertIdx : { 0u, 1u, 2u }) { writeBigEndian(fileOut, vertIdx); }
+		fileOut.put(4);
+		for(uint32_t vertIdx : { 1u, 2u, 3u, 4u }) { writeBigEndian(fileOut, vertIdx); }
+	}
+
+	for(const bool writeBinary : { false, true })
+	{
+		for(const bool threaded : { false, true })
+		{
+			PlyStreamConverter converter;
+			PlyStreamConverter::sParams params;
+			params.mWriteBinary = writeBinary;
+			params.mThreaded    = threaded;
+			params.mChunkSize   = 2;
+			PlyStreamConverter::sStats stats;
+			REQUIRE(converter.convert(inFile, outFile, params, stats));
+			CHECK(stats.mVertexCount == 5);
+			CHECK(stats.mFaceCount == 2);
+			CHECK(stats.mMin[1] == -8.0);
+			CHECK(stats.mMax[0] == 6.0);
+			CHECK(stats.mBytesWritten == std::filesystem::file_size(outFile));
+			CHECK(converter.getModelMetaDataRef().getModelMetaString(ModelMetaData::META_MODEL_ID) == "TestID");
+
+			std::vector<sVertexProperties> vertexProperties;
+			std::vector<sFaceProperties> faceProperties;
+			MeshSeedExt meshSeed;
+			PlyReader reader;
+			REQUIRE(reader.readFile(outFile, vertexProperties, faceProperties, meshSeed));
+			REQUIRE(vertexProperties.size() == 5);
+			REQUIRE(faceProperties.size() == 2);
+			CHECK(vertexProperties[3].mCoordX == 4.5);
+			CHECK(vertexProperties[3].mCoordY == -6.0);
+			CHECK(vertexProperties[3].mFuncVal == 1.5);
+			CHECK(static_cast<int>(vertexProperties[4].mColorRed) == 40);
+			CHECK(faceProperties[1].vertexIndices.size() == 4);
+			CHECK(faceProperties[1].vertexIndices[3] == 4);
+		}
+	}
+
+	SECTION("Normals requested, but not present")
+	{
+		PlyStreamConverter converter;
+		PlyStreamConverter::sParams params;
+		params.mWriteNormals = true;
+		PlyStreamConverter::sStats stats;
+		CHECK_FALSE(converter.convert(inFile, outFile, params, stats));
+	}
+
+	std::filesystem::remove(inFile);
+	std::filesystem::remove(outFile);
+}
+
+TEST_CASE("PLY Stream Converter ASCII values and face indices", "[meshio]")
+{
+	const std::filesystem::path inFile(gTestFilesPath + "tmpStreamAsciiIn.ply");
+	const std::filesystem::path outFile(gTestFilesPath + "tmpStreamAsciiOut.ply");
+	auto writeAscii = [&inFile](const std::string& rFaces) {
+		std::ofstream fileOut(inFile);
+		fileOut << "ply\nformat ascii 1.0\nelement vertex 3\n"
+		        << "property float x\nproperty float y\nproperty float z\nproperty float quality\n"
+		        << "element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+		        << "+1.5 -2.25 1e2 0.125\n0.5 1e-400 -3 7\n3 4 5 6\n"
+		        << rFaces;
+	};
+
+	// Numbers have to be parsed and written independent of a comma-decimal locale, when present.
+	const std::string oldLocale = setlocale(LC_NUMERIC, nullptr);
+	setlocale(LC_NUMERIC, "de_DE.UTF-8");
+
+	SECTION("Values are parsed independent of the locale")
+	{
+		writeAscii("3 0 1 2\n");
+		PlyStreamConverter converter;
+		PlyStreamConverter::sParams params;
+		PlyStreamConverter::sStats stats;
+		REQUIRE(converter.convert(inFile, outFile, params, stats));
+		CHECK(stats.mMin[0] == 0.5);
+		CHECK(stats.mMax[0] == 3.0);
+		CHECK(stats.mMin[1] == -2.25);
+		CHECK(stats.mMin[2] == -3.0);
+
+		setlocale(LC_NUMERIC, oldLocale.c_str());
+		std::vector<sVertexProperties> vertexProperties;
+		std::vector<sFaceProperties> faceProperties;
+		MeshSeedExt meshSeed;
+		PlyReader reader;
+		REQUIRE(reader.readFile(outFile, vertexProperties, faceProperties, meshSeed));
+		REQUIRE(vertexProperties.size() == 3);
+		CHECK(vertexProperties[0].mCoordX == 1.5);
+		CHECK(vertexProperties[0].mCoordZ == 100.0);
+		CHECK(vertexProperties[0].mFuncVal == 0.125);
+		CHECK(vertexProperties[1].mCoordY == 0.0);
+		REQUIRE(faceProperties.size() == 1);
+		CHECK(faceProperties[0].vertexIndices[2] == 2);
+	}
+
+	SECTION("Invalid face indices are rejected")
+	{
+		for(const std::string& faces : { "3 0 1 3\n", "3 0 -1 2\n", "3 0 1.5 2\n", "3 0 1 nan\n", "2.5 0 1\n", "3 0 1x 2\n", "3 0 +-1 2\n" })
+		{
+			writeAscii(faces);
+			PlyStreamConverter converter;
+			PlyStreamConverter::sParams params;
+			PlyStreamConverter::sStats stats;
+			CHECK_FALSE(converter.convert(inFile, outFile, params, stats));
+		}
+	}
+
+	setlocale(LC_NUMERIC, oldLocale.c_str());
+	std::filesystem::remove(inFile);
+	std::filesystem::remove(outFile);
+}
+
+TEST_CASE("Mesh IO without Process-Wide State", "[meshio]")
+{
+	SECTION("Numbers are parsed independent of the locale")
+	{
+		double valueDouble = 0.0;
+		CHECK(parseNumber("+1.5", valueDouble));
+		CHECK(valueDouble == 1.5);
+		CHECK(parseNumber("1e-400", valueDouble));
+		CHECK(valueDouble == 0.0);
+		CHECK(parseNumber("-1e400", valueDouble));
+		CHECK(valueDouble == -std::numeric_limits<double>::infinity());
+		CHECK_FALSE(parseNumber("1,5", valueDouble));
+		CHECK_FALSE(parseNumber("", valueDouble));
+		CHECK_FALSE(parseNumber("+", valueDouble));
+		CHECK_FALSE(parseNumber("+-1", valueDouble));
+		CHECK_FALSE(parseNumber(" 1", valueDouble));
+		CHECK_FALSE(parseNumber("1\r", valueDouble));
+		const char range[] = "2.5e400 7";
+		CHECK(parseNumber(range, range + 7, valueDouble));
+		CHECK(valueDouble == std::numeric_limits<double>::infinity());
+		int valueInt = 0;
+		CHECK_FALSE(parseNumber("0.5", valueInt));
+		CHECK(parseNumberOrZero<float>("x") == 0.0f);
+	}
+
+	SECTION("Reading does not change the locale and the working directory")
+	{
+		const std::filesystem::path outDir(gTestFilesPath + "tmpReaderState");
+		std::filesystem::create_directories(outDir / "materials");
+		{
+			std::ofstream fileOut(outDir / "mesh.obj");
+			fileOut << "mtllib materials/mesh.mtl\nv +1.5 -2.25 1e2\nv 0.5 0 -3\nv 3 4 5\n"
+			        << "vt 0 0\nvt 1 0\nvt 0 1\nusemtl Material_0\nf 1/1 2/2 3/3\n";
+			std::ofstream fileMtl(outDir / "materials" / "mesh.mtl");
+			fileMtl << "newmtl Material_0\nKd 1.0 1.0 1.0\nd 1.0\nmap_Kd texture.png\n";
+			std::ofstream fileTxt(outDir / "points.txt");
+			fileTxt << "1.5 -2.25 100 255 0 0\n0.5 0 -3 0 255 0\n";
+		}
+		const std::string localeNumeric = setlocale(LC_NUMERIC, nullptr);
+		const std::filesystem::path workingDir = std::filesystem::current_path();
+
+		std::vector<sVertexProperties> vertexProperties;
+		std::vector<sFaceProperties> faceProperties;
+		MeshSeedExt meshSeed;
+		ObjReader objReader;
+		REQUIRE(objReader.readFile(outDir / "mesh.obj", vertexProperties, faceProperties, meshSeed));
+		REQUIRE(vertexProperties.size() == 3);
+		CHECK(vertexProperties[0].mCoordX == 1.5);
+		CHECK(vertexProperties[0].mCoordZ == 100.0);
+		CHECK(objReader.getModelMetaDataRef().getTexturefilesRef().size() == 1);
+
+		TxtReader txtReader;
+		REQUIRE(txtReader.readFile(outDir / "points.txt", vertexProperties, faceProperties, meshSeed));
+		REQUIRE(vertexProperties.size() == 2);
+		CHECK(vertexProperties[0].mCoordY == -2.25);
+		CHECK(vertexProperties[1].mColorGrn == 255);
+
+		CHECK(localeNumeric == setlocale(LC_NUMERIC, nullptr));
+		CHECK(std::filesystem::current_path() == workingDir);
+		std::filesystem::remove_all(outDir);
+	}
+
+	SECTION("Local time as text like asctime")
+	{
+		const std::time_t someTime = 1000000000;
+		const std::string expected = std::asctime(std::localtime(&someTime));
+		CHECK(getLocalTimeStr(someTime) == expected);
+	}
+}
+
+TEST_CASE("PLY Writer Chunked Encoding Tests", "[meshio]")
+{
+	const std::filesystem::path outFile(gTestFilesPath + "tmpPlyWriter.ply");
+
+	// Grid with more faces than a single chunk of records and a quad at the end.
+	const uint64_t gridSize = 120;
+	std::vector<sVertexProperties> vertexProperties(gridSize * gridSize);
+	for(uint64_t vertIdx = 0; vertIdx < vertexProperties.size(); vertIdx++)
+	{
+		vertexProperties[vertIdx].mCoordX  = static_cast<double>(vertIdx % gridSize) * 0.5;
+		vertexProperties[vertIdx].mCoordY  = static_cast<double>(vertIdx / gridSize) * -0.25;
+		vertexProperties[vertIdx].mCoordZ  = 1.0;
+		vertexProperties[vertIdx].mFuncVal = static_cast<double>(vertIdx);
+		vertexProperties[vertIdx].mLabelId = vertIdx % 7;
+		vertexProperties[vertIdx].mColorGrn = static_cast<unsigned char>(vertIdx % 256);
+	}
+	std::vector<sFaceProperties> faceProperties;
+	for(uint64_t row = 0; row + 1 < gridSize; row++)
+	{
+		for(uint64_t col = 0; col + 1 < gridSize; col++)
+		{
+			const uint64_t vertIdx = row * gridSize + col;
+			faceProperties.push_back({ { vertIdx, vertIdx + 1, vertIdx + gridSize }, {}, 0 });
+			faceProperties.push_back({ { vertIdx + 1, vertIdx + gridSize + 1, vertIdx + gridSize }, {}, 0 });
+		}
+	}
+	faceProperties.push_back({ { 0, 1, gridSize + 1, gridSize }, {}, 0 });
+	REQUIRE(faceProperties.size() > 16384);
+
+	for(const bool writeBinary : { false, true })
+	{
+		PlyWriter writer;
+		writer.setExportBinary(writeBinary);
+		writer.setExportVertLabel(true);
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+
+		std::vector<sVertexProperties> vertexPropertiesRead;
+		std::vector<sFaceProperties> facePropertiesRead;
+		MeshSeedExt meshSeed;
+		PlyReader reader;
+		REQUIRE(reader.readFile(outFile, vertexPropertiesRead, facePropertiesRead, meshSeed));
+		REQUIRE(vertexPropertiesRead.size() == vertexProperties.size());
+		REQUIRE(facePropertiesRead.size() == faceProperties.size());
+		uint64_t differences = 0;
+		for(uint64_t vertIdx = 0; vertIdx < vertexProperties.size(); vertIdx++)
+		{
+			differences += vertexPropertiesRead[vertIdx].mCoordX != vertexProperties[vertIdx].mCoordX;
+			differences += vertexPropertiesRead[vertIdx].mCoordY != vertexProperties[vertIdx].mCoordY;
+			differences += vertexPropertiesRead[vertIdx].mFuncVal != vertexProperties[vertIdx].mFuncVal;
+			differences += vertexPropertiesRead[vertIdx].mLabelId != vertexProperties[vertIdx].mLabelId;
+			differences += vertexPropertiesRead[vertIdx].mColorGrn != vertexProperties[vertIdx].mColorGrn;
+		}
+		for(uint64_t faceIdx = 0; faceIdx < faceProperties.size(); faceIdx++)
+		{
+			differences += facePropertiesRead[faceIdx].vertexIndices != faceProperties[faceIdx].vertexIndices;
+		}
+		CHECK(differences == 0);
+	}
+
+	std::filesystem::remove(outFile);
+}
+
+// The golden files were written by the PLY writer before the chunked encoding was introduced.
+TEST_CASE("PLY Writer Golden File Tests", "[meshio]")
+{
+	std::vector<sVertexProperties> vertexProperties;
+	std::vector<sFaceProperties> faceProperties;
+	getGoldenWriterInput(vertexProperties, faceProperties);
+
+	for(const bool writeBinary : { false, true })
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpGoldenWriter.ply");
+		const std::filesystem::path goldenFile(gTestFilesPath + (writeBinary ? "golden_writer_binary.ply" : "golden_writer_ascii.ply"));
+		PlyWriter writer;
+		writer.setExportBinary(writeBinary);
+		writer.setExportVertFlags(true);
+		writer.setExportVertColor(true);
+		writer.setExportVertNormal(true);
+		writer.setExportVertLabel(true);
+		writer.setExportTextureCoordinates(true);
+		ModelMetaData modelMetaData;
+		modelMetaData.addTextureName("tex_a.png");
+		modelMetaData.addTextureName("tex_b.png");
+		writer.setModelMetaData(modelMetaData);
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+		CHECK(readWithoutBuildInfo(outFile, "comment | .") == readWithoutBuildInfo(goldenFile, "comment | ."));
+		std::filesystem::remove(outFile);
+	}
+}
+
+TEST_CASE("OBJ and TXT Writer Round Trip Tests", "[meshio]")
+{
+	// Strip of quads split into triangles with more vertices than a single chunk of lines.
+	const uint64_t stripLength = 9000;
+	std::vector<sVertexProperties> vertexProperties(2 * stripLength);
+	for(uint64_t vertIdx = 0; vertIdx < vertexProperties.size(); vertIdx++)
+	{
+		vertexProperties[vertIdx].mCoordX   = static_cast<double>(vertIdx / 2) * 0.5; // At most six significant digits.
+		vertexProperties[vertIdx].mCoordY   = static_cast<double>(vertIdx % 2) * -1.5;
+		vertexProperties[vertIdx].mCoordZ   = 0.25;
+		vertexProperties[vertIdx].mFuncVal  = static_cast<double>(vertIdx % 1000) * 0.5;
+		vertexProperties[vertIdx].mColorRed = static_cast<unsigned char>(vertIdx % 256);
+		vertexProperties[vertIdx].mColorGrn = 20;
+		vertexProperties[vertIdx].mColorBle = 255;
+	}
+	std::vector<sFaceProperties> faceProperties;
+	for(uint64_t quadIdx = 0; quadIdx + 1 < stripLength; quadIdx++)
+	{
+		const uint64_t vertIdx = 2 * quadIdx;
+		faceProperties.push_back({ { vertIdx, vertIdx + 2, vertIdx + 1 }, {}, 0 });
+		faceProperties.push_back({ { vertIdx + 1, vertIdx + 2, vertIdx + 3 }, {}, 0 });
+	}
+
+	auto countVertexDifferences = [&vertexProperties](const std::vector<sVertexProperties>& rVertexPropertiesRead) {
+		uint64_t differences = 0;
+		for(uint64_t vertIdx = 0; vertIdx < vertexProperties.size(); vertIdx++)
+		{
+			differences += rVertexPropertiesRead[vertIdx].mCoordX != vertexProperties[vertIdx].mCoordX;
+			differences += rVertexPropertiesRead[vertIdx].mCoordY != vertexProperties[vertIdx].mCoordY;
+			differences += rVertexPropertiesRead[vertIdx].mCoordZ != vertexProperties[vertIdx].mCoordZ;
+			differences += rVertexPropertiesRead[vertIdx].mColorRed != vertexProperties[vertIdx].mColorRed;
+			differences += rVertexPropertiesRead[vertIdx].mColorGrn != vertexProperties[vertIdx].mColorGrn;
+			differences += rVertexPropertiesRead[vertIdx].mColorBle != vertexProperties[vertIdx].mColorBle;
+		}
+		return differences;
+	};
+
+	SECTION("ObjWriter - ObjReader")
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpObjWriter.obj");
+		ObjWriter writer;
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+
+		std::vector<sVertexProperties> vertexPropertiesRead;
+		std::vector<sFaceProperties> facePropertiesRead;
+		MeshSeedExt meshSeed;
+		ObjReader reader;
+		REQUIRE(reader.readFile(outFile, vertexPropertiesRead, facePropertiesRead, meshSeed));
+		REQUIRE(vertexPropertiesRead.size() == vertexProperties.size());
+		REQUIRE(facePropertiesRead.size() == faceProperties.size());
+		// The reader numbers the vertices in the order of their first reference by a face.
+		std::vector<sVertexProperties> vertexPropertiesReordered(vertexProperties.size());
+		uint64_t differences = 0;
+		for(uint64_t faceIdx = 0; faceIdx < faceProperties.size(); faceIdx++)
+		{
+			if(facePropertiesRead[faceIdx].vertexIndices.size() != 3)
+			{
+				differences++;
+				continue;
+			}
+			for(int corner = 0; corner < 3; corner++)
+			{
+				const sVertexProperties& vertexRead = vertexPropertiesRead[facePropertiesRead[faceIdx].vertexIndices[corner]];
+				vertexPropertiesReordered[faceProperties[faceIdx].vertexIndices[corner]] = vertexRead;
+			}
+		}
+		differences += countVertexDifferences(vertexPropertiesReordered);
+		for(uint64_t vertIdx = 0; vertIdx < vertexProperties.size(); vertIdx++)
+		{
+			differences += vertexPropertiesReordered[vertIdx].mFuncVal != vertexProperties[vertIdx].mFuncVal;
+		}
+		CHECK(differences == 0);
+		std::filesystem::remove(outFile);
+	}
+
+	SECTION("TxtWriter - TxtReader")
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpTxtWriter.txt");
+		TxtWriter writer;
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+
+		std::vector<sVertexProperties> vertexPropertiesRead;
+		std::vector<sFaceProperties> facePropertiesRead;
+		MeshSeedExt meshSeed;
+		TxtReader reader;
+		REQUIRE(reader.readFile(outFile, vertexPropertiesRead, facePropertiesRead, meshSeed));
+		REQUIRE(vertexPropertiesRead.size() == vertexProperties.size());
+		CHECK(facePropertiesRead.empty());
+		CHECK(countVertexDifferences(vertexPropertiesRead) == 0);
+		std::filesystem::remove(outFile);
+	}
+}
+
+// The golden OBJ files were written by the OBJ writer before the chunked formatting, with the
+// texture coordinates written pairwise. The texture index restarts with ONE for each material.
+// The golden TXT file holds X Y Z R G B per vertex as read by TxtReader.
+TEST_CASE("OBJ and TXT Writer Golden File Tests", "[meshio]")
+{
+	std::vector<sVertexProperties> vertexProperties;
+	std::vector<sFaceProperties> faceProperties;
+	getGoldenWriterInput(vertexProperties, faceProperties);
+
+	SECTION("ObjWriter without textures")
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpGolden.obj");
+		ObjWriter writer;
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+		CHECK(readWithoutBuildInfo(outFile, "# .") == readWithoutBuildInfo(gTestFilesPath + "golden_writer.obj", "# ."));
+		std::filesystem::remove(outFile);
+	}
+
+	SECTION("ObjWriter with textures and materials")
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpGoldenTextured.obj");
+		const std::filesystem::path outFileMtl(gTestFilesPath + "tmpGoldenTextured.mtl");
+		ObjWriter writer;
+		writer.setExportTextureCoordinates(true);
+		ModelMetaData modelMetaData;
+		modelMetaData.addTextureName("tex_a.png");
+		modelMetaData.addTextureName("tex_b.png");
+		writer.setModelMetaData(modelMetaData);
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+		CHECK(readWithoutBuildInfo(outFile, "# .") == readWithoutBuildInfo(gTestFilesPath + "golden_writer_textured.obj", "# ."));
+		CHECK(readWithoutBuildInfo(outFileMtl, "# .") == readWithoutBuildInfo(gTestFilesPath + "golden_writer_textured.mtl", "# ."));
+		std::filesystem::remove(outFile);
+		std::filesystem::remove(outFileMtl);
+	}
+
+	SECTION("TxtWriter")
+	{
+		const std::filesystem::path outFile(gTestFilesPath + "tmpGolden.txt");
+		TxtWriter writer;
+		MeshSeedExt meshSeedOut;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeedOut));
+		CHECK(readWithoutBuildInfo(outFile, "# .") == readWithoutBuildInfo(gTestFilesPath + "golden_writer.txt", "# ."));
+		std::filesystem::remove(outFile);
+	}
+}
+
+TEST_CASE("Texture Paths Relative to the Written Mesh", "[meshio]")
+{
+	const std::filesystem::path outDir(std::filesystem::absolute(gTestFilesPath + "tmpTextureOut"));
+	const std::filesystem::path outFile(outDir / "textured.ply");
+	const std::filesystem::path textureFile(std::filesystem::absolute(gTestFilesPath + "texture.png"));
+	std::filesystem::create_directories(outDir);
+
+	SECTION("Absolute and relative texture paths")
+	{
+		CHECK(MeshWriter::getTexturePathRelative(textureFile, outFile) == std::filesystem::path("../texture.png").string());
+		CHECK(MeshWriter::getTexturePathRelative(outDir / "maps" / "texture.png", outFile) == std::filesystem::path("maps/texture.png").string());
+		CHECK(MeshWriter::getTexturePathRelative("texture.png", outFile) == "texture.png");
+	}
+
+	SECTION("Writing does not change the working directory")
+	{
+		const std::vector<sVertexProperties> vertexProperties(3);
+		const std::vector<sFaceProperties> faceProperties{ { { 0, 1, 2 }, {}, 0 } };
+		const std::filesystem::path workingDir = std::filesystem::current_path();
+		PlyWriter writer;
+		writer.getModelMetaDataRef().addTextureName(textureFile);
+		MeshSeedExt meshSeed;
+		REQUIRE(writer.writeFile(outFile, vertexProperties, faceProperties, meshSeed));
+		CHECK(std::filesystem::current_path() == workingDir);
+
+		std::ifstream fileIn(outFile);
+		std::string line;
+		bool textureFound = false;
+		while(std::getline(fileIn, line))
+		{
+			textureFound |= (line == "comment TextureFile " + std::filesystem::path("../texture.png").string());
+		}
+		CHECK(textureFound);
+	}
+
+	std::filesystem::remove_all(outDir);
+}
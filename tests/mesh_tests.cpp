@@ -20,8 +20,15 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <fstream>
+#include <iomanip>
+#include <random>
+
 #include <catch.hpp>
 #include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/renderortho.h>
+#include <GigaMesh/mesh/ambientocclusion.h>
+#include <GigaMesh/mesh/facereduction.h>
 
 //Mock wrapper class for Mesh
 // Goals:
@@ -240,3 +247,1823 @@ SCENARIO("Testing translation of selected vertices", "[mesh]")
 		}
 	}
 }
+
+SCENARIO("Fetching spherical neighbourhoods with a VisitedSet", "[mesh]")
+{
+	GIVEN("A sphere mesh")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		REQUIRE(testMesh.getFaceNr() > 0);
+
+		WHEN("Fetching the same patches with bit arrays and with VisitedSets")
+		{
+			uint64_t* vertBitArrayVisited = nullptr;
+			const uint64_t vertNrLongs = testMesh.getBitArrayVerts( &vertBitArrayVisited );
+			uint64_t* faceBitArrayVisited = nullptr;
+			const uint64_t faceNrLongs = testMesh.getBitArrayFaces( &faceBitArrayVisited );
+
+			VisitedSet vertsVisited;
+			testMesh.getVisitedSetVerts( vertsVisited );
+			VisitedSet facesVisited;
+			testMesh.getVisitedSetFaces( facesVisited );
+
+			const double radius = testMesh.getBoundingBoxRadius() * 0.3;
+
+			THEN("The faces returned are identical")
+			{
+				for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx += 7 ) {
+					Vertex* seedVert = testMesh.getVertexPos( vertIdx );
+
+					std::vector<Face*> facesBitArray;
+					testMesh.fetchSphereBitArray1R( seedVert, facesBitArray, radius,
+					                                vertNrLongs, vertBitArrayVisited,
+					                                faceNrLongs, faceBitArrayVisited );
+					std::vector<Face*> facesVisitedSet;
+					testMesh.fetchSphereBitArray1R( seedVert, facesVisitedSet, radius,
+					                                vertsVisited, facesVisited );
+					CHECK( facesBitArray == facesVisitedSet );
+
+					std::vector<Face*> facesMarchingBitArray;
+					testMesh.fetchSphereBitArray( seedVert, &facesMarchingBitArray, static_cast<float>(radius),
+					                              vertNrLongs, vertBitArrayVisited,
+					                              faceNrLongs, faceBitArrayVisited );
+					std::vector<Face*> facesMarchingVisitedSet;
+					testMesh.fetchSphereBitArray( seedVert, &facesMarchingVisitedSet, static_cast<float>(radius),
+					                              vertsVisited, facesVisited );
+					CHECK( facesMarchingBitArray == facesMarchingVisitedSet );
+				}
+			}
+
+			delete[] vertBitArrayVisited;
+			delete[] faceBitArrayVisited;
+		}
+	}
+}
+
+SCENARIO("Rendering orthographic views without OpenGL", "[mesh]")
+{
+	GIVEN("A sphere mesh")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+
+		Vector3D bbSize;
+		testMesh.getBoundingBoxSize( bbSize );
+		RenderOrtho renderer( &testMesh );
+		RenderOrtho::sParams params;
+		params.mDPI = 128.0 * 25.4 / bbSize.getX(); // about 128 pixels wide
+
+		WHEN("Rendering the front view with different numbers of threads and tile sizes")
+		{
+			const RenderOrtho::sView frontView = RenderOrtho::getSixViews().at( 2 );
+			RenderOrtho::sImage imageSingle;
+			params.mThreadCount = 1;
+			params.mTileSize    = 64;
+			REQUIRE( renderer.render( frontView, params, imageSingle ) );
+			RenderOrtho::sImage imageMulti;
+			params.mThreadCount = 4;
+			params.mTileSize    = 16;
+			REQUIRE( renderer.render( frontView, params, imageMulti ) );
+
+			THEN("The images are identical and the sphere covers the center but not the corners")
+			{
+				REQUIRE( imageSingle.mWidth == imageMulti.mWidth );
+				REQUIRE( imageSingle.mHeight == imageMulti.mHeight );
+				CHECK( imageSingle.mRGB == imageMulti.mRGB );
+				CHECK( imageSingle.mDepth == imageMulti.mDepth );
+				CHECK( imageSingle.mWidth >= 128 );
+				CHECK( imageSingle.mWidth <= 130 );
+				const uint64_t centerIdx = ( imageSingle.mHeight / 2 ) * imageSingle.mWidth + imageSingle.mWidth / 2;
+				CHECK( std::isfinite( imageSingle.mDepth[centerIdx] ) );
+				CHECK( std::isinf( imageSingle.mDepth[0] ) );
+				CHECK( imageSingle.mRGB[0] == params.mBackgroundRGB[0] );
+			}
+		}
+	}
+}
+
+SCENARIO("Computing the mesh information in parallel", "[mesh]")
+{
+	for( const std::string fileName : { "testdata/sphere_ascii.ply", "testdata/flat-vv.obj",
+	                                    "testdata/test_bridging_synthetic_flat.ply", "testdata/selfintersect.obj" } ) {
+		GIVEN("The mesh " + fileName)
+		{
+			bool success = false;
+			MockMesh testMesh(fileName, success);
+			REQUIRE(success == true);
+
+			WHEN("Fetching the mesh information")
+			{
+				MeshInfoData meshInfo;
+				REQUIRE( testMesh.getMeshInfoData( meshInfo, false, false ) );
+
+				THEN("The counters match the checks of the single primitives")
+				{
+					uint64_t countBorder = 0, countNonManifold = 0, countSingular = 0, countZeroFace = 0, countInverse = 0;
+					for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+						Vertex* currVertex = testMesh.getVertexPos( vertIdx );
+						countBorder      += currVertex->isBorder();
+						countNonManifold += currVertex->isNonManifold();
+						countSingular    += currVertex->isDoubleCone();
+						countZeroFace    += currVertex->isPartOfZeroFace();
+						countInverse     += currVertex->isInverse();
+					}
+					uint64_t countThreeBorderVertices = 0, countInverted = 0;
+					double areaSmallest = std::numeric_limits<double>::infinity();
+					for( uint64_t faceIdx = 0; faceIdx < testMesh.getFaceNr(); faceIdx++ ) {
+						Face* currFace = testMesh.getFacePos( faceIdx );
+						unsigned int nrVerticesBorder = 0;
+						currFace->hasBorderVertex( nrVerticesBorder );
+						countThreeBorderVertices += ( nrVerticesBorder == 3 );
+						countInverted            += currFace->isInverse();
+						areaSmallest = std::min( areaSmallest, currFace->getAreaNormal() );
+					}
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_TOTAL] == testMesh.getVertexNr() );
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_BORDER] == countBorder );
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_NONMANIFOLD] == countNonManifold );
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_SINGULAR] == countSingular );
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_PART_OF_ZERO_FACE] == countZeroFace );
+					CHECK( meshInfo.mCountULong[MeshInfoData::VERTICES_ON_INVERTED_EDGE] == countInverse );
+					CHECK( meshInfo.mCountULong[MeshInfoData::FACES_BORDER_THREE_VERTICES] == countThreeBorderVertices );
+					CHECK( meshInfo.mCountULong[MeshInfoData::FACES_INVERTED] == countInverted );
+					CHECK( meshInfo.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] == areaSmallest );
+				}
+			}
+
+			WHEN("Fetching the mesh information with indices not matching the positions")
+			{
+				MeshInfoData meshInfo;
+				REQUIRE( testMesh.getMeshInfoData( meshInfo, false, false ) );
+				const uint64_t vertexCount = testMesh.getVertexNr();
+				for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+					testMesh.getVertexPos( vertIdx )->setIndex( vertexCount - 1 - vertIdx );
+				}
+				MeshInfoData meshInfoReversed;
+				REQUIRE( testMesh.getMeshInfoData( meshInfoReversed, false, false ) );
+
+				THEN("The counters are the same and the indices are kept")
+				{
+					for( int i = 0; i < MeshInfoData::ULONG_COUNT; i++ ) {
+						CHECK( meshInfoReversed.mCountULong[i] == meshInfo.mCountULong[i] );
+					}
+					uint64_t indicesChanged = 0;
+					for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+						indicesChanged += ( testMesh.getVertexPos( vertIdx )->getIndex() != static_cast<int>( vertexCount - 1 - vertIdx ) );
+					}
+					CHECK( indicesChanged == 0 );
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Storing feature vectors in a matrix with reduced precision", "[mesh]")
+{
+	GIVEN("A mesh with feature vectors assigned by the mesh")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+
+		const uint64_t featureVecLen = 5;
+		const uint64_t vertexCount = testMesh.getVertexNr();
+		std::vector<double> featureVecs( vertexCount * featureVecLen );
+		for( uint64_t i = 0; i < featureVecs.size(); i++ ) {
+			featureVecs[i] = std::sin( static_cast<double>( i ) ) * 10.0;
+		}
+		REQUIRE( testMesh.assignFeatureVectors( featureVecs.data(), featureVecLen ) );
+		double referenceVec[featureVecLen] = { 1.0, -2.0, 3.0, -4.0, 5.0 };
+
+		THEN("The vertices refer to the rows of the matrix")
+		{
+			Vertex* lastVertex = testMesh.getVertexPos( vertexCount - 1 );
+			REQUIRE( lastVertex->getFeatureVectorLen() == featureVecLen );
+			double elementValue = 0.0;
+			REQUIRE( lastVertex->getFeatureElement( 2, &elementValue ) );
+			CHECK( elementValue == featureVecs[( vertexCount - 1 ) * featureVecLen + 2] );
+			double distMan = 0.0;
+			for( uint64_t j = 0; j < featureVecLen; j++ ) {
+				distMan += std::abs( referenceVec[j] - featureVecs[( vertexCount - 1 ) * featureVecLen + j] );
+			}
+			CHECK( lastVertex->getFeatureDistManTo( referenceVec ) == Approx( distMan ) );
+		}
+
+		WHEN("Changing the precision to float32 and float16")
+		{
+			Vertex* someVertex = testMesh.getVertexPos( vertexCount / 2 );
+			const double distEucDouble = someVertex->getFeatureDistEucTo( referenceVec );
+			const double cosSimDouble  = someVertex->getFeatureVecCosSim( referenceVec, false );
+
+			REQUIRE( testMesh.setFeatureVecPrecision( FeatureVecMatrix::PRECISION_FLOAT ) );
+			CHECK( testMesh.getFeatureVecPrecision() == FeatureVecMatrix::PRECISION_FLOAT );
+			const double distEucFloat = someVertex->getFeatureDistEucTo( referenceVec );
+
+			REQUIRE( testMesh.setFeatureVecPrecision( FeatureVecMatrix::PRECISION_HALF ) );
+			const double distEucHalf = someVertex->getFeatureDistEucTo( referenceVec );
+			const double cosSimHalf  = someVertex->getFeatureVecCosSim( referenceVec, false );
+
+			THEN("The distances match within the precision")
+			{
+				CHECK( distEucFloat == Approx( distEucDouble ).epsilon( 1e-6 ) );
+				CHECK( distEucHalf  == Approx( distEucDouble ).epsilon( 1e-3 ) );
+				CHECK( cosSimHalf   == Approx( cosSimDouble ).epsilon( 1e-3 ) );
+			}
+
+			THEN("Resizing a vertex' feature vector detaches it from the matrix")
+			{
+				Vertex* firstVertex = testMesh.getVertexPos( 0 );
+				double elementValue = 0.0;
+				testMesh.getVertexPos( 1 )->getFeatureElement( 0, &elementValue );
+				firstVertex->resizeFeatureVector( featureVecLen + 1 );
+				CHECK( firstVertex->getFeatureVectorLen() == featureVecLen + 1 );
+				double paddedValue = 0.0;
+				firstVertex->getFeatureElement( featureVecLen, &paddedValue );
+				CHECK( std::isnan( paddedValue ) );
+				double elementValueAfter = 0.0;
+				testMesh.getVertexPos( 1 )->getFeatureElement( 0, &elementValueAfter );
+				CHECK( elementValueAfter == elementValue );
+			}
+		}
+	}
+
+	GIVEN("Special values converted to float16")
+	{
+		THEN("Zero, infinity, not-a-number, subnormals and rounding are handled")
+		{
+			CHECK( FeatureVecMatrix::floatToHalf( 0.0f ) == 0x0000 );
+			CHECK( FeatureVecMatrix::floatToHalf( 1.0f ) == 0x3C00 );
+			CHECK( FeatureVecMatrix::floatToHalf( -2.0f ) == 0xC000 );
+			CHECK( FeatureVecMatrix::floatToHalf( 65504.0f ) == 0x7BFF );
+			CHECK( FeatureVecMatrix::floatToHalf( 1.0e6f ) == 0x7C00 );
+			CHECK( std::isnan( FeatureVecMatrix::halfToFloat( FeatureVecMatrix::floatToHalf( std::nanf( "" ) ) ) ) );
+			CHECK( FeatureVecMatrix::halfToFloat( FeatureVecMatrix::floatToHalf( 5.9604645e-8f ) ) == 5.9604645e-8f );
+			CHECK( FeatureVecMatrix::halfToFloat( FeatureVecMatrix::floatToHalf( 0.1f ) ) == Approx( 0.1f ).epsilon( 1e-3 ) );
+			uint32_t roundTripsFailed = 0;
+			for( uint32_t halfBits = 0; halfBits < 0x7C00; halfBits++ ) {
+				const uint16_t half = static_cast<uint16_t>( halfBits );
+				roundTripsFailed += ( FeatureVecMatrix::floatToHalf( FeatureVecMatrix::halfToFloat( half ) ) != half );
+			}
+			CHECK( roundTripsFailed == 0 );
+		}
+	}
+}
+
+SCENARIO("Computing feature vector distances with batched kernels", "[mesh]")
+{
+	GIVEN("A feature vector matrix with not-a-number elements and rows not a multiple of four")
+	{
+		const uint64_t rowCount = 37;
+		const uint64_t colCount = 7;
+		std::vector<double> featureVecs( rowCount * colCount );
+		for( uint64_t i = 0; i < featureVecs.size(); i++ ) {
+			featureVecs[i] = std::cos( static_cast<double>( i ) * 0.7 ) * 3.0;
+		}
+		featureVecs[5 * colCount + 2] = std::numeric_limits<double>::quiet_NaN();
+		featureVecs[9 * colCount + 6] = std::numeric_limits<double>::quiet_NaN();
+		featureVecs[11 * colCount + 0] = 0.0;
+		std::vector<double> referenceVec   = { 0.5, -1.0, 2.0, 1.5, -0.5, 0.25, 1.0 };
+		std::vector<double> stdDevVec      = { 1.0, 2.0, 0.5, 1.5, 1.0, 3.0, 0.75 };
+		std::vector<double> weightVec      = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 };
+
+		FeatureVecMatrix featureVecMatrix;
+		REQUIRE( featureVecMatrix.assign( featureVecs.data(), rowCount, colCount ) );
+		std::vector<Vertex> vertices( rowCount );
+		for( uint64_t rowIdx = 0; rowIdx < rowCount; rowIdx++ ) {
+			REQUIRE( vertices[rowIdx].setFeatureVecView( &featureVecMatrix, rowIdx ) );
+		}
+
+		for( const FeatureVecDistance::eMetric metric : { FeatureVecDistance::METRIC_MANHATTAN, FeatureVecDistance::METRIC_EUCLIDEAN,
+		                                                  FeatureVecDistance::METRIC_EUCLIDEAN_NORMALIZED, FeatureVecDistance::METRIC_COSINE_SIMILARITY,
+		                                                  FeatureVecDistance::METRIC_TANIMOTO, FeatureVecDistance::METRIC_PNORM } ) {
+			for( const double pNorm : { 0.0, 1.0, 2.0, 3.0, std::numeric_limits<double>::infinity() } ) {
+				if( ( metric != FeatureVecDistance::METRIC_PNORM ) && ( pNorm != 2.0 ) ) {
+					continue;
+				}
+				WHEN("Computing metric " + std::to_string( metric ) + " with p=" + std::to_string( pNorm ))
+				{
+					FeatureVecDistance::sParams params;
+					params.mMetric       = metric;
+					params.mReference    = referenceVec.data();
+					params.mReferenceLen = referenceVec.size();
+					params.mStdDev       = stdDevVec.data();
+					params.mWeights      = weightVec.data();
+					params.mPNorm        = pNorm;
+					std::vector<double> distancesSIMD( rowCount );
+					std::vector<double> distancesScalar( rowCount );
+					REQUIRE( FeatureVecDistance::compute( featureVecMatrix, params, distancesSIMD.data() ) );
+					params.mAllowSIMD = false;
+					REQUIRE( FeatureVecDistance::compute( featureVecMatrix, params, distancesScalar.data() ) );
+
+					THEN("The results match the functions of the Vertex")
+					{
+						for( uint64_t rowIdx = 0; rowIdx < rowCount; rowIdx++ ) {
+							Vertex& currVertex = vertices[rowIdx];
+							double expected = 0.0;
+							switch( metric ) {
+								case FeatureVecDistance::METRIC_MANHATTAN:
+									expected = currVertex.getFeatureDistManTo( referenceVec.data() );
+									break;
+								case FeatureVecDistance::METRIC_EUCLIDEAN:
+									expected = currVertex.getFeatureDistEucTo( referenceVec.data() );
+									break;
+								case FeatureVecDistance::METRIC_EUCLIDEAN_NORMALIZED:
+									expected = currVertex.getFeatureDistEucNormTo( referenceVec.data(), &stdDevVec );
+									break;
+								case FeatureVecDistance::METRIC_COSINE_SIMILARITY:
+									expected = currVertex.getFeatureVecCosSim( referenceVec.data(), true );
+									break;
+								case FeatureVecDistance::METRIC_TANIMOTO:
+									expected = currVertex.getFeatureVecTanimotoDist( referenceVec.data() );
+									break;
+								case FeatureVecDistance::METRIC_PNORM:
+									REQUIRE( currVertex.getFeatureVecPNorm( &expected, pNorm, &referenceVec, nullptr, &weightVec ) );
+									break;
+							}
+							if( std::isnan( expected ) ) {
+								CHECK( std::isnan( distancesScalar[rowIdx] ) );
+								CHECK( std::isnan( distancesSIMD[rowIdx] ) );
+							} else {
+								CHECK( distancesScalar[rowIdx] == expected );
+								CHECK( distancesSIMD[rowIdx] == Approx( expected ).epsilon( 1e-12 ) );
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	GIVEN("A mesh with feature vectors stored as float16")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		const uint64_t featureVecLen = 16;
+		std::vector<double> featureVecs( testMesh.getVertexNr() * featureVecLen );
+		for( uint64_t i = 0; i < featureVecs.size(); i++ ) {
+			featureVecs[i] = std::sin( static_cast<double>( i ) * 0.3 );
+		}
+		REQUIRE( testMesh.assignFeatureVectors( featureVecs.data(), featureVecLen ) );
+		REQUIRE( testMesh.setFeatureVecPrecision( FeatureVecMatrix::PRECISION_HALF ) );
+
+		WHEN("Computing the euclidean distances to the first vertex")
+		{
+			std::vector<double> referenceVec;
+			testMesh.getVertexPos( 0 )->getFeatureVectorElements( referenceVec );
+			int      vertCount  = 0;
+			Vertex** vertices   = nullptr;
+			double*  funcValues = nullptr;
+			REQUIRE( testMesh.estFeatureDistEucToVertex( referenceVec.data(), &funcValues, &vertices, &vertCount ) );
+
+			THEN("The distances match the vertices' functions")
+			{
+				REQUIRE( static_cast<uint64_t>( vertCount ) == testMesh.getVertexNr() );
+				CHECK( funcValues[0] == 0.0 );
+				uint64_t distancesDiffering = 0;
+				for( int vertIdx = 0; vertIdx < vertCount; vertIdx++ ) {
+					const double expected = vertices[vertIdx]->getFeatureDistEucTo( referenceVec.data() );
+					distancesDiffering += ( std::abs( funcValues[vertIdx] - expected ) > 1e-12 );
+				}
+				CHECK( distancesDiffering == 0 );
+			}
+			delete[] vertices;
+			delete[] funcValues;
+		}
+	}
+}
+
+SCENARIO("Searching similar feature vectors with an approximate nearest neighbour index", "[mesh]")
+{
+	GIVEN("Clustered feature vectors with a row containing not-a-number")
+	{
+		const uint64_t rowCount     = 20000;
+		const uint64_t colCount     = 16;
+		const uint64_t clusterCount = 40;
+		std::mt19937_64 random( 42 );
+		std::normal_distribution<double> normal( 0.0, 1.0 );
+		std::vector<double> clusterCenters( clusterCount * colCount );
+		for( double& value : clusterCenters ) {
+			value = normal( random ) * 4.0;
+		}
+		std::vector<double> featureVecs( rowCount * colCount );
+		for( uint64_t rowIdx = 0; rowIdx < rowCount; rowIdx++ ) {
+			const uint64_t clusterIdx = random() % clusterCount;
+			for( uint64_t colIdx = 0; colIdx < colCount; colIdx++ ) {
+				featureVecs[rowIdx * colCount + colIdx] = clusterCenters[clusterIdx * colCount + colIdx] + normal( random );
+			}
+		}
+		featureVecs[17 * colCount + 3] = std::numeric_limits<double>::quiet_NaN();
+		FeatureVecMatrix featureVecMatrix;
+		REQUIRE( featureVecMatrix.assign( featureVecs.data(), rowCount, colCount ) );
+
+		FeatureVecIndex featureVecIndex;
+		REQUIRE( featureVecIndex.build( featureVecMatrix, FeatureVecIndex::sParams() ) );
+		REQUIRE( featureVecIndex.getIndexedRowCount() == rowCount - 1 );
+
+		WHEN("Querying the nearest neighbours and the neighbours within a radius")
+		{
+			const uint64_t queryCount = 50;
+			const uint64_t neighbourCount = 10;
+			const double   radius = 5.0;
+			uint64_t foundKNN = 0;
+			uint64_t expectedKNN = 0;
+			uint64_t foundRadius = 0;
+			uint64_t expectedRadius = 0;
+			uint64_t resultsOutOfRadius = 0;
+			for( uint64_t queryIdx = 0; queryIdx < queryCount; queryIdx++ ) {
+				std::vector<double> referenceVec( colCount );
+				const uint64_t referenceRow = ( queryIdx * 397 ) % rowCount;
+				for( uint64_t colIdx = 0; colIdx < colCount; colIdx++ ) {
+					referenceVec[colIdx] = featureVecs[referenceRow * colCount + colIdx] + normal( random ) * 0.5;
+				}
+
+				// Brute force
+				FeatureVecDistance::sParams params;
+				params.mReference    = referenceVec.data();
+				params.mReferenceLen = colCount;
+				std::vector<double> distances( rowCount );
+				REQUIRE( FeatureVecDistance::compute( featureVecMatrix, params, distances.data() ) );
+				std::vector<std::pair<double,uint64_t>> bruteForce;
+				for( uint64_t rowIdx = 0; rowIdx < rowCount; rowIdx++ ) {
+					if( !std::isnan( distances[rowIdx] ) ) {
+						bruteForce.emplace_back( distances[rowIdx], rowIdx );
+					}
+				}
+				std::sort( bruteForce.begin(), bruteForce.end() );
+				std::set<uint64_t> nearestRows;
+				std::set<uint64_t> radiusRows;
+				for( uint64_t pos = 0; pos < bruteForce.size(); pos++ ) {
+					if( pos < neighbourCount ) {
+						nearestRows.insert( bruteForce[pos].second );
+					}
+					if( bruteForce[pos].first <= radius ) {
+						radiusRows.insert( bruteForce[pos].second );
+					}
+				}
+
+				std::vector<FeatureVecIndex::sResult> results;
+				REQUIRE( featureVecIndex.queryKNN( featureVecMatrix, referenceVec.data(), neighbourCount, 0, results ) );
+				expectedKNN += neighbourCount;
+				for( const FeatureVecIndex::sResult& result : results ) {
+					foundKNN += nearestRows.count( result.mRow );
+				}
+				REQUIRE( featureVecIndex.queryRadius( featureVecMatrix, referenceVec.data(), radius, 0, results ) );
+				expectedRadius += radiusRows.size();
+				for( const FeatureVecIndex::sResult& result : results ) {
+					foundRadius += radiusRows.count( result.mRow );
+					resultsOutOfRadius += ( result.mDistance > radius );
+				}
+			}
+
+			THEN("The recall compared to brute force is high")
+			{
+				const double recallKNN    = static_cast<double>( foundKNN ) / static_cast<double>( expectedKNN );
+				const double recallRadius = static_cast<double>( foundRadius ) / static_cast<double>( expectedRadius );
+				INFO( "Recall@" << neighbourCount << ": " << recallKNN << " recall within radius: " << recallRadius );
+				CHECK( recallKNN >= 0.9 );
+				CHECK( recallRadius >= 0.9 );
+				CHECK( resultsOutOfRadius == 0 );
+			}
+		}
+
+		WHEN("Writing and reading the index")
+		{
+			const std::filesystem::path fileName( "testdata/tmpIndex.fvidx" );
+			REQUIRE( featureVecIndex.writeFile( fileName ) );
+			FeatureVecIndex featureVecIndexRead;
+			const bool readOk = featureVecIndexRead.readFile( fileName, featureVecMatrix );
+			featureVecMatrix.set( 5, 5, 1.0 );
+			const bool readChangedOk = featureVecIndexRead.readFile( fileName, featureVecMatrix );
+			std::filesystem::remove( fileName );
+
+			THEN("The index is only accepted for the same feature vectors")
+			{
+				CHECK( readOk );
+				CHECK_FALSE( readChangedOk );
+				CHECK_FALSE( featureVecIndexRead.isBuilt() );
+			}
+		}
+	}
+
+	GIVEN("A mesh with feature vectors")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		const uint64_t featureVecLen = 16;
+		std::vector<double> featureVecs( testMesh.getVertexNr() * featureVecLen );
+		for( uint64_t i = 0; i < featureVecs.size(); i++ ) {
+			featureVecs[i] = std::sin( static_cast<double>( i ) * 0.3 );
+		}
+		REQUIRE( testMesh.assignFeatureVectors( featureVecs.data(), featureVecLen ) );
+		std::vector<double> referenceVec;
+		testMesh.getVertexPos( 7 )->getFeatureVectorElements( referenceVec );
+
+		WHEN("Selecting the most similar vertices and computing their distance as function value")
+		{
+			REQUIRE( testMesh.selectVertsByFeatureVecSimilarity( referenceVec, 5, std::numeric_limits<double>::infinity() ) );
+			REQUIRE( testMesh.funcVertFeatureVecSimilarity( referenceVec, 5, std::numeric_limits<double>::infinity() ) );
+
+			THEN("The reference vertex is found with distance zero")
+			{
+				std::set<Vertex*> selectedVerts;
+				REQUIRE( testMesh.getSelectedVerts( &selectedVerts ) );
+				CHECK( selectedVerts.size() == 5 );
+				CHECK( selectedVerts.count( testMesh.getVertexPos( 7 ) ) == 1 );
+				double funcValue = _NOT_A_NUMBER_DBL_;
+				REQUIRE( testMesh.getVertexPos( 7 )->getFuncValue( &funcValue ) );
+				CHECK( funcValue == 0.0 );
+			}
+		}
+
+		WHEN("Writing the feature vectors as text with an index like gigamesh-featurevectors and importing them again")
+		{
+			const std::filesystem::path fileNameMat( "testdata/tmpFeatureVecs.mat" );
+			const std::filesystem::path fileNameIndex = FeatureVecIndex::getFileNameFor( fileNameMat );
+			std::ofstream fileOut( fileNameMat );
+			REQUIRE( fileOut.is_open() );
+			fileOut << std::fixed << std::setprecision( 10 );
+			for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+				fileOut << vertIdx;
+				for( uint64_t elementIdx = 0; elementIdx < featureVecLen; elementIdx++ ) {
+					fileOut << " " << featureVecs[vertIdx * featureVecLen + elementIdx];
+				}
+				fileOut << "\n";
+			}
+			fileOut.close();
+			REQUIRE( testMesh.writeFeatureVecIndexFor( fileNameMat, true, FeatureVecIndex::sParams() ) );
+
+			MockMesh testMeshImported("testdata/sphere_ascii.ply", success);
+			REQUIRE(success == true);
+			const bool importOk = testMeshImported.importFeatureVectorsFromFile( fileNameMat );
+			const bool readOk = testMeshImported.readFeatureVecIndex( fileNameIndex );
+			// Index of the values in memory, which differ from those in the file:
+			REQUIRE( testMesh.buildFeatureVecIndex( FeatureVecIndex::sParams() ) );
+			REQUIRE( testMesh.writeFeatureVecIndex( fileNameIndex ) );
+			const bool readInMemoryOk = testMeshImported.readFeatureVecIndex( fileNameIndex );
+			std::filesystem::remove( fileNameMat );
+			std::filesystem::remove( fileNameIndex );
+
+			THEN("The index is accepted for the imported feature vectors")
+			{
+				CHECK( importOk );
+				CHECK( readOk );
+				CHECK_FALSE( readInMemoryOk );
+			}
+		}
+
+		WHEN("Writing the feature vectors as text with an index for float16 and importing them with float16")
+		{
+			const std::filesystem::path fileNameMat( "testdata/tmpFeatureVecsHalf.mat" );
+			const std::filesystem::path fileNameIndex = FeatureVecIndex::getFileNameFor( fileNameMat );
+			std::ofstream fileOut( fileNameMat );
+			REQUIRE( fileOut.is_open() );
+			fileOut << std::fixed << std::setprecision( 10 );
+			for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+				fileOut << vertIdx;
+				for( uint64_t elementIdx = 0; elementIdx < featureVecLen; elementIdx++ ) {
+					fileOut << " " << featureVecs[vertIdx * featureVecLen + elementIdx];
+				}
+				fileOut << "\n";
+			}
+			fileOut.close();
+			REQUIRE( testMesh.setFeatureVecPrecision( FeatureVecMatrix::PRECISION_HALF ) );
+			REQUIRE( testMesh.writeFeatureVecIndexFor( fileNameMat, true, FeatureVecIndex::sParams() ) );
+
+			MockMesh testMeshHalf("testdata/sphere_ascii.ply", success);
+			REQUIRE(success == true);
+			REQUIRE( testMeshHalf.setFeatureVecPrecision( FeatureVecMatrix::PRECISION_HALF ) );
+			const bool importHalfOk = testMeshHalf.importFeatureVectorsFromFile( fileNameMat );
+			const bool readHalfOk = testMeshHalf.readFeatureVecIndex( fileNameIndex );
+			MockMesh testMeshDouble("testdata/sphere_ascii.ply", success);
+			REQUIRE(success == true);
+			const bool importDoubleOk = testMeshDouble.importFeatureVectorsFromFile( fileNameMat );
+			const bool readDoubleOk = testMeshDouble.readFeatureVecIndex( fileNameIndex );
+			std::filesystem::remove( fileNameMat );
+			std::filesystem::remove( fileNameIndex );
+
+			THEN("The values are stored as float16 and the index is accepted for this precision only")
+			{
+				CHECK( importHalfOk );
+				CHECK( importDoubleOk );
+				CHECK( testMeshHalf.getFeatureVecPrecision() == FeatureVecMatrix::PRECISION_HALF );
+				CHECK( testMeshDouble.getFeatureVecPrecision() == FeatureVecMatrix::PRECISION_DOUBLE );
+				CHECK( readHalfOk );
+				CHECK_FALSE( readDoubleOk );
+				uint64_t valuesDiffering = 0;
+				for( uint64_t vertIdx = 0; vertIdx < testMeshHalf.getVertexNr(); vertIdx++ ) {
+					std::vector<double> elements;
+					testMeshHalf.getVertexPos( vertIdx )->getFeatureVectorElements( elements );
+					for( uint64_t elementIdx = 0; elementIdx < featureVecLen; elementIdx++ ) {
+						const double expected = featureVecs[vertIdx * featureVecLen + elementIdx];
+						valuesDiffering += ( elements.size() != featureVecLen ) || ( std::abs( elements[elementIdx] - expected ) > 1e-3 );
+					}
+				}
+				CHECK( valuesDiffering == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO("Extracting multiple isolines within a single pass", "[mesh]")
+{
+	GIVEN("Two instances of a mesh having the z-coordinate as function value")
+	{
+		bool success = false;
+		MockMesh testMeshMulti("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		MockMesh testMeshSingle("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		for( uint64_t vertIdx = 0; vertIdx < testMeshMulti.getVertexNr(); vertIdx++ ) {
+			testMeshMulti.getVertexPos( vertIdx )->setFuncValue( testMeshMulti.getVertexPos( vertIdx )->getZ() );
+			testMeshSingle.getVertexPos( vertIdx )->setFuncValue( testMeshSingle.getVertexPos( vertIdx )->getZ() );
+		}
+		double funcValMin = _NOT_A_NUMBER_DBL_;
+		double funcValMax = _NOT_A_NUMBER_DBL_;
+		REQUIRE( testMeshMulti.getFuncValuesMinMax( funcValMin, funcValMax ) );
+		// Includes the function value of a vertex i.e. an isoline touching vertices.
+		std::vector<double> isoValues;
+		for( int i = 1; i < 8; i++ ) {
+			isoValues.push_back( funcValMin + ( funcValMax - funcValMin ) * static_cast<double>( i ) / 8.0 );
+		}
+		isoValues.push_back( testMeshMulti.getVertexPos( 5 )->getZ() );
+
+		WHEN("Computing the isolines of all isovalues at once and one by one")
+		{
+			REQUIRE( testMeshMulti.isolinesToPolylines( isoValues ) );
+			for( const double isoValue : isoValues ) {
+				REQUIRE( testMeshSingle.isolineToPolyline( isoValue ) );
+			}
+
+			THEN("The polylines are identical")
+			{
+				REQUIRE( testMeshMulti.getPolyLineNr() >= isoValues.size() );
+				REQUIRE( testMeshMulti.getPolyLineNr() == testMeshSingle.getPolyLineNr() );
+				CHECK( testMeshMulti.getVertexNr() == testMeshSingle.getVertexNr() );
+				uint64_t verticesDifferent = 0;
+				for( unsigned int polyIdx = 0; polyIdx < testMeshMulti.getPolyLineNr(); polyIdx++ ) {
+					PolyLine* polyMulti  = testMeshMulti.getPolyLinePos( polyIdx );
+					PolyLine* polySingle = testMeshSingle.getPolyLinePos( polyIdx );
+					REQUIRE( polyMulti->length() == polySingle->length() );
+					for( int elementIdx = 0; elementIdx < polyMulti->length(); elementIdx++ ) {
+						Vector3D posMulti  = polyMulti->getVertexRef( elementIdx )->getPositionVector();
+						Vector3D posSingle = polySingle->getVertexRef( elementIdx )->getPositionVector();
+						if( posMulti != posSingle ) {
+							verticesDifferent++;
+						}
+					}
+				}
+				CHECK( verticesDifferent == 0 );
+			}
+
+			THEN("The polylines match those of the previous isoline extraction")
+			{
+				// Computed with Mesh::isolineToPolyline before the isolines were extracted in a single pass:
+				// number of vertices, length, first and last position of each polyline.
+				// The isovalue touching vertices yields 30 edges and 30 empty polylines.
+				struct sPolyLineRef {
+					int    mLength;
+					double mLineLength;
+					double mFirst[3];
+					double mLast[3];
+				};
+				const std::vector<sPolyLineRef> polyLinesRef {
+				{ 61, 521.8306821, { 33.44444444, 75.75, -95.25 }, { 33.44444444, 75.75, -95.25 } },
+				{ 61, 690.1521096, { 44.10416667, 100.2083333, -63.5 }, { 44.10416667, 100.2083333, -63.5 } },
+				{ 61, 768.7710054, { 49.63461538, 111.5865385, -31.75 }, { 49.63461538, 111.5865385, -31.75 } },
+				{ 61, 793.1530141, { 51, 115, 0 }, { 51, 115, 0 } },
+				{ 61, 767.3973711, { 49.55769231, 111.3942308, 31.75 }, { 49.55769231, 111.3942308, 31.75 } },
+				{ 61, 686.4280931, { 43.85714286, 99.66666667, 63.5 }, { 43.85714286, 99.66666667, 63.5 } },
+				{ 61, 514.9419608, { 33, 74.75, 95.25 }, { 33, 74.75, 95.25 } },
+				{ 2, 5.099019514, { 5, 25, -125 }, { 10, 24, -125 } },
+				{ 2, 5.830951895, { 10, 24, -125 }, { 15, 21, -125 } },
+				{ 2, 5.656854249, { 15, 21, -125 }, { 19, 17, -125 } },
+				{ 2, 5, { 19, 17, -125 }, { 22, 13, -125 } },
+				{ 2, 5.830951895, { 22, 13, -125 }, { 25, 8, -125 } },
+				{ 2, 6.08276253, { 25, 8, -125 }, { 26, 2, -125 } },
+				{ 2, 5, { 26, 2, -125 }, { 26, -3, -125 } },
+				{ 2, 6.08276253, { 26, -3, -125 }, { 25, -9, -125 } },
+				{ 2, 5.830951895, { 25, -9, -125 }, { 22, -14, -125 } },
+				{ 2, 5, { 22, -14, -125 }, { 19, -18, -125 } },
+				{ 2, 5.656854249, { 19, -18, -125 }, { 15, -22, -125 } },
+				{ 2, 5.830951895, { 15, -22, -125 }, { 10, -25, -125 } },
+				{ 2, 5.099019514, { 10, -25, -125 }, { 5, -26, -125 } },
+				{ 2, 5.099019514, { 5, -26, -125 }, { 0, -27, -125 } },
+				{ 2, 6.08276253, { 0, -27, -125 }, { -6, -26, -125 } },
+				{ 2, 5.099019514, { -6, -26, -125 }, { -11, -25, -125 } },
+				{ 2, 5.830951895, { -11, -25, -125 }, { -16, -22, -125 } },
+				{ 2, 5.656854249, { -16, -22, -125 }, { -20, -18, -125 } },
+				{ 2, 5, { -20, -18, -125 }, { -23, -14, -125 } },
+				{ 2, 5.830951895, { -23, -14, -125 }, { -26, -9, -125 } },
+				{ 2, 6.08276253, { -26, -9, -125 }, { -27, -3, -125 } },
+				{ 2, 5, { -27, -3, -125 }, { -27, 2, -125 } },
+				{ 2, 6.08276253, { -27, 2, -125 }, { -26, 8, -125 } },
+				{ 2, 5.830951895, { -26, 8, -125 }, { -23, 13, -125 } },
+				{ 2, 5, { -23, 13, -125 }, { -20, 17, -125 } },
+				{ 2, 5.656854249, { -20, 17, -125 }, { -16, 21, -125 } },
+				{ 2, 5.830951895, { -16, 21, -125 }, { -11, 24, -125 } },
+				{ 2, 5.099019514, { -11, 24, -125 }, { -6, 25, -125 } },
+				{ 2, 5.099019514, { -6, 25, -125 }, { -1, 26, -125 } },
+				{ 2, 6.08276253, { -1, 26, -125 }, { 5, 25, -125 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				{ 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+				};
+				REQUIRE( testMeshMulti.getPolyLineNr() == polyLinesRef.size() );
+				for( unsigned int polyIdx = 0; polyIdx < polyLinesRef.size(); polyIdx++ ) {
+					PolyLine* polyMulti = testMeshMulti.getPolyLinePos( polyIdx );
+					const sPolyLineRef& polyRef = polyLinesRef.at( polyIdx );
+					INFO( "Polyline " << polyIdx );
+					REQUIRE( polyMulti->length() == polyRef.mLength );
+					if( polyRef.mLength == 0 ) {
+						continue;
+					}
+					double lineLength = 0.0;
+					for( int elementIdx = 1; elementIdx < polyMulti->length(); elementIdx++ ) {
+						lineLength += ( polyMulti->getVertexRef( elementIdx )->getPositionVector() -
+						                polyMulti->getVertexRef( elementIdx - 1 )->getPositionVector() ).getLength3();
+					}
+					CHECK( lineLength == Approx( polyRef.mLineLength ).epsilon( 1e-8 ) );
+					const Vector3D posFirst = polyMulti->getVertexRef( 0 )->getPositionVector();
+					const Vector3D posLast  = polyMulti->getVertexRef( polyMulti->length() - 1 )->getPositionVector();
+					CHECK( posFirst.getX() == Approx( polyRef.mFirst[0] ).margin( 1e-7 ) );
+					CHECK( posFirst.getY() == Approx( polyRef.mFirst[1] ).margin( 1e-7 ) );
+					CHECK( posFirst.getZ() == Approx( polyRef.mFirst[2] ).margin( 1e-7 ) );
+					CHECK( posLast.getX()  == Approx( polyRef.mLast[0] ).margin( 1e-7 ) );
+					CHECK( posLast.getY()  == Approx( polyRef.mLast[1] ).margin( 1e-7 ) );
+					CHECK( posLast.getZ()  == Approx( polyRef.mLast[2] ).margin( 1e-7 ) );
+				}
+			}
+		}
+
+		WHEN("Giving a non-finite isovalue")
+		{
+			THEN("It is rejected")
+			{
+				CHECK_FALSE( testMeshMulti.isolinesToPolylines( { _NOT_A_NUMBER_DBL_ } ) );
+				CHECK( testMeshMulti.getPolyLineNr() == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO("Slicing a mesh with multiple planes within a single pass", "[mesh]")
+{
+	GIVEN("Two instances of a mesh and planes parallel, rotated around an axis and arbitrary")
+	{
+		bool success = false;
+		MockMesh testMeshBatch("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		MockMesh testMeshSingle("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+
+		const Vector3D center = testMeshBatch.getBoundingBoxCenter();
+		const double   extent = testMeshBatch.getBoundingBoxRadius();
+		double funcValueBefore = _NOT_A_NUMBER_DBL_;
+		testMeshBatch.getVertexPos( 0 )->getFuncValue( &funcValueBefore );
+		std::vector<Plane> planes;
+		// Parallel:
+		for( int i = -2; i <= 2; i++ ) {
+			planes.emplace_back( center + Vector3D( 0.0, 0.0, extent * 0.2 * i, 0.0 ), Vector3D( 0.0, 0.0, 1.0, 0.0 ) );
+		}
+		// Rotated around an axis, which includes the position of a vertex:
+		const Vector3D axisTop    = center + Vector3D( 0.1 * extent, 0.05 * extent, extent, 0.0 );
+		const Vector3D axisBottom = center - Vector3D( 0.0, 0.0, extent, 0.0 );
+		for( int i = 0; i < 4; i++ ) {
+			Plane planeRotated;
+			Vector3D position = center + Vector3D( std::cos( i * 0.7 + 0.1 ) * extent, std::sin( i * 0.7 + 0.1 ) * extent, 0.0, 0.0 );
+			if( i == 0 ) {
+				position = testMeshBatch.getVertexPos( 11 )->getPositionVector();
+			}
+			REQUIRE( planeRotated.setPlaneByAxisAndPosition( axisTop, axisBottom, position ) );
+			planes.push_back( planeRotated );
+		}
+		// Arbitrary:
+		planes.emplace_back( center, Vector3D( 0.3, -0.5, 0.8, 0.0 ) );
+		std::vector<Plane*> planePtrs;
+		for( Plane& currPlane : planes ) {
+			planePtrs.push_back( &currPlane );
+		}
+
+		WHEN("Slicing with all planes at once and one by one using the distances as function values")
+		{
+			REQUIRE( testMeshBatch.planeIntersectionsToPolylines( planePtrs, &axisTop, &axisBottom ) );
+			for( Plane& currPlane : planes ) {
+				Vector3D planeHNF;
+				REQUIRE( currPlane.getPlaneHNF( &planeHNF ) );
+				REQUIRE( testMeshSingle.funcVertDistanceToPlane( planeHNF, false, true ) );
+				REQUIRE( testMeshSingle.isolineToPolyline( 0.0, &currPlane ) );
+			}
+
+			THEN("The polylines are identical and the function values are unchanged")
+			{
+				REQUIRE( testMeshBatch.getPolyLineNr() >= planes.size() );
+				REQUIRE( testMeshBatch.getPolyLineNr() == testMeshSingle.getPolyLineNr() );
+				uint64_t verticesDifferent = 0;
+				for( unsigned int polyIdx = 0; polyIdx < testMeshBatch.getPolyLineNr(); polyIdx++ ) {
+					PolyLine* polyBatch  = testMeshBatch.getPolyLinePos( polyIdx );
+					PolyLine* polySingle = testMeshSingle.getPolyLinePos( polyIdx );
+					REQUIRE( polyBatch->length() == polySingle->length() );
+					for( int elementIdx = 0; elementIdx < polyBatch->length(); elementIdx++ ) {
+						Vector3D posBatch  = polyBatch->getVertexRef( elementIdx )->getPositionVector();
+						Vector3D posSingle = polySingle->getVertexRef( elementIdx )->getPositionVector();
+						if( posBatch != posSingle ) {
+							verticesDifferent++;
+						}
+					}
+				}
+				CHECK( verticesDifferent == 0 );
+				double funcValue = _NOT_A_NUMBER_DBL_;
+				testMeshBatch.getVertexPos( 0 )->getFuncValue( &funcValue );
+				CHECK( funcValue == funcValueBefore );
+			}
+		}
+	}
+}
+
+SCENARIO("Transforming the whole mesh in parallel", "[Mesh]")
+{
+	GIVEN("Two instances of a mesh and a rotation with translation")
+	{
+		bool success = false;
+		MockMesh testMeshWhole("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		MockMesh testMeshSet("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		REQUIRE( testMeshWhole.resetVertexNormals() );
+		REQUIRE( testMeshSet.resetVertexNormals() );
+		const double angle = 0.3;
+		std::vector<double> transMat = {  std::cos( angle ), std::sin( angle ), 0.0, 0.0,
+		                                 -std::sin( angle ), std::cos( angle ), 0.0, 0.0,
+		                                  0.0,               0.0,               1.0, 0.0,
+		                                  1.5,              -2.0,               0.5, 1.0 };
+		Matrix4D transform( transMat );
+
+		WHEN("Transforming all vertices at once and as set of vertices")
+		{
+			REQUIRE( testMeshWhole.applyTransformationToWholeMesh( transform, true, false ) );
+			std::set<Vertex*> allVertices;
+			for( uint64_t vertIdx = 0; vertIdx < testMeshSet.getVertexNr(); vertIdx++ ) {
+				allVertices.insert( testMeshSet.getVertexPos( vertIdx ) );
+			}
+			REQUIRE( testMeshSet.applyTransformation( transform, &allVertices, true, false ) );
+
+			THEN("Positions, normals and bounding boxes are identical")
+			{
+				REQUIRE( testMeshWhole.getVertexNr() == testMeshSet.getVertexNr() );
+				uint64_t verticesDifferent = 0;
+				for( uint64_t vertIdx = 0; vertIdx < testMeshWhole.getVertexNr(); vertIdx++ ) {
+					Vertex* vertWhole = testMeshWhole.getVertexPos( vertIdx );
+					Vertex* vertSet   = testMeshSet.getVertexPos( vertIdx );
+					Vector3D posWhole = vertWhole->getPositionVector();
+					Vector3D normalWhole = vertWhole->getNormal( false );
+					if( posWhole != vertSet->getPositionVector() || normalWhole != vertSet->getNormal( false ) ) {
+						verticesDifferent++;
+					}
+				}
+				CHECK( verticesDifferent == 0 );
+				uint64_t facesDifferent = 0;
+				for( uint64_t faceIdx = 0; faceIdx < testMeshWhole.getFaceNr(); faceIdx++ ) {
+					Vector3D normalWhole = testMeshWhole.getFacePos( faceIdx )->getNormal( false );
+					if( normalWhole != testMeshSet.getFacePos( faceIdx )->getNormal( false ) ) {
+						facesDifferent++;
+					}
+				}
+				CHECK( facesDifferent == 0 );
+				Vector3D centerWhole = testMeshWhole.getBoundingBoxCenter();
+				CHECK( !( centerWhole != testMeshSet.getBoundingBoxCenter() ) );
+				CHECK( testMeshWhole.getBoundingBoxRadius() == testMeshSet.getBoundingBoxRadius() );
+			}
+		}
+	}
+}
+
+SCENARIO("Function value statistics without sorting", "[Mesh]")
+{
+	GIVEN("A mesh with random function values including not-a-number and infinite values")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+
+		std::mt19937_64 random( 7 );
+		std::uniform_real_distribution<double> distribution( -5.0, 20.0 );
+		std::vector<double> finiteValues;
+		for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+			double funcVal = std::round( distribution( random ) * 8.0 ) / 8.0; // Duplicate values.
+			if( vertIdx % 17 == 3 ) {
+				funcVal = _NOT_A_NUMBER_DBL_;
+			} else if( vertIdx % 23 == 5 ) {
+				funcVal = ( vertIdx % 2 == 0 ) ? _INFINITE_DBL_ : -_INFINITE_DBL_;
+			} else {
+				finiteValues.push_back( funcVal );
+			}
+			testMesh.getVertexPos( vertIdx )->setFuncValue( funcVal );
+		}
+		testMesh.changedVertFuncVal();
+		std::vector<double> sortedValues( finiteValues );
+		std::sort( sortedValues.begin(), sortedValues.end() );
+
+		WHEN("Requesting the range and quantiles")
+		{
+			double minVal = 0.0;
+			double maxVal = 0.0;
+			REQUIRE( testMesh.getFuncValuesMinMax( minVal, maxVal ) );
+
+			THEN("They equal the elements of the sorted values")
+			{
+				CHECK( minVal == sortedValues.front() );
+				CHECK( maxVal == sortedValues.back() );
+				for( double quantile : { 0.0, 0.01, 0.05, 0.5, 0.95, 0.99, 1.0 } ) {
+					double quantileLow  = 0.0;
+					double quantileHigh = 0.0;
+					REQUIRE( testMesh.getFuncValuesMinMaxQuantil( quantile, 1.0 - quantile, quantileLow, quantileHigh ) );
+					CHECK( quantileLow  == sortedValues[std::lround( quantile * ( sortedValues.size() - 1 ) )] );
+					CHECK( quantileHigh == sortedValues[std::lround( ( 1.0 - quantile ) * ( sortedValues.size() - 1 ) )] );
+				}
+			}
+		}
+
+		WHEN("Requesting a histogram of the function values")
+		{
+			std::vector<unsigned int> histogram( 50, 0 );
+			double valMin = 0.0;
+			double valMax = 0.0;
+			REQUIRE( testMesh.getHistogramValues( Mesh::HISTOGRAM_FUNCTION_VALUES_VERTEX, &histogram, &valMin, &valMax ) );
+
+			THEN("The counts of the finite values match")
+			{
+				CHECK( valMin == sortedValues.front() );
+				CHECK( valMax == sortedValues.back() );
+				std::vector<unsigned int> histogramExpected( histogram.size(), 0 );
+				const double intervalLen = ( valMax - valMin ) / histogram.size();
+				for( double funcVal : finiteValues ) {
+					const unsigned int histIndex = std::floor( ( funcVal - valMin ) / intervalLen );
+					histogramExpected[std::min<unsigned int>( histIndex, histogram.size() - 1 )]++;
+				}
+				CHECK( histogram == histogramExpected );
+			}
+		}
+
+		WHEN("Changing the function values after the statistics were used")
+		{
+			double minVal = 0.0;
+			double maxVal = 0.0;
+			REQUIRE( testMesh.getFuncValuesMinMax( minVal, maxVal ) );
+			for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+				testMesh.getVertexPos( vertIdx )->setFuncValue( static_cast<double>( vertIdx ) );
+			}
+			testMesh.changedVertFuncVal();
+
+			THEN("The statistics are rebuilt")
+			{
+				double quantileLow  = 0.0;
+				double quantileHigh = 0.0;
+				REQUIRE( testMesh.getFuncValuesMinMaxQuantil( 0.0, 1.0, quantileLow, quantileHigh ) );
+				CHECK( quantileLow  == 0.0 );
+				CHECK( quantileHigh == static_cast<double>( testMesh.getVertexNr() - 1 ) );
+			}
+		}
+
+		WHEN("Setting function values with a method, which does not call changedVertFuncVal")
+		{
+			double minVal = 0.0;
+			double maxVal = 0.0;
+			REQUIRE( testMesh.getFuncValuesMinMax( minVal, maxVal ) );
+			REQUIRE( testMesh.setParamFlagMesh( MeshParams::LABELING_USE_STEP_AS_FUNCVAL, true ) );
+			REQUIRE( testMesh.labelVerticesAll() );
+			double minValExpected = _INFINITE_DBL_;
+			double maxValExpected = -_INFINITE_DBL_;
+			for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+				double funcVal = _NOT_A_NUMBER_DBL_;
+				testMesh.getVertexPos( vertIdx )->getFuncValue( &funcVal );
+				minValExpected = std::min( minValExpected, funcVal );
+				maxValExpected = std::max( maxValExpected, funcVal );
+			}
+			double minValLabeled = 0.0;
+			double maxValLabeled = 0.0;
+			REQUIRE( testMesh.getFuncValuesMinMax( minValLabeled, maxValLabeled ) );
+
+			THEN("The statistics are rebuilt")
+			{
+				CHECK( maxVal == sortedValues.back() );
+				CHECK( minValLabeled == minValExpected );
+				CHECK( maxValLabeled == maxValExpected );
+				CHECK( maxValLabeled != maxVal );
+			}
+		}
+	}
+}
+
+SCENARIO("Reloading a mesh from its native cache", "[mesh]")
+{
+	const std::filesystem::path sourceFile( "testdata/tmpMeshCache.ply" );
+	const std::filesystem::path cacheFile = MeshCache::getSidecarName( sourceFile );
+	std::filesystem::copy_file( "testdata/sphere_ascii.ply", sourceFile, std::filesystem::copy_options::overwrite_existing );
+	std::filesystem::remove( cacheFile );
+
+	GIVEN("A mesh read with the cache enabled")
+	{
+		MeshCache::setMode( MeshCache::CACHE_READ_WRITE );
+		bool success = false;
+		MockMesh parsedMesh( sourceFile.string(), success );
+		REQUIRE( success == true );
+		REQUIRE( std::filesystem::exists( cacheFile ) );
+		const auto cacheTime = std::filesystem::last_write_time( cacheFile );
+
+		WHEN("The mesh is read again")
+		{
+			MockMesh cachedMesh( sourceFile.string(), success );
+			MeshCache::setMode( MeshCache::CACHE_OFF );
+			REQUIRE( success == true );
+
+			THEN("The cache is used and equals the parsed mesh including its connectivity")
+			{
+				CHECK( std::filesystem::last_write_time( cacheFile ) == cacheTime );
+				CHECK( cachedMesh.getFullName() == parsedMesh.getFullName() );
+				REQUIRE( cachedMesh.getVertexNr() == parsedMesh.getVertexNr() );
+				REQUIRE( cachedMesh.getFaceNr() == parsedMesh.getFaceNr() );
+				CHECK( cachedMesh.getMinX() == parsedMesh.getMinX() );
+				CHECK( cachedMesh.getMaxZ() == parsedMesh.getMaxZ() );
+				uint64_t differences = 0;
+				std::vector<Face*> facesParsed;
+				std::vector<Face*> facesCached;
+				for( uint64_t vertIdx = 0; vertIdx < parsedMesh.getVertexNr(); vertIdx++ ) {
+					Vertex* vertParsed = parsedMesh.getVertexPos( vertIdx );
+					Vertex* vertCached = cachedMesh.getVertexPos( vertIdx );
+					differences += ( vertParsed->getX() != vertCached->getX() );
+					differences += ( vertParsed->getZ() != vertCached->getZ() );
+					differences += ( vertParsed->isBorder() != vertCached->isBorder() );
+					facesParsed.clear();
+					facesCached.clear();
+					vertParsed->getFaces( &facesParsed );
+					vertCached->getFaces( &facesCached );
+					differences += ( facesParsed.size() != facesCached.size() );
+					for( uint64_t i = 0; i < std::min( facesParsed.size(), facesCached.size() ); i++ ) {
+						differences += ( facesParsed[i]->getIndex() != facesCached[i]->getIndex() );
+					}
+				}
+				for( uint64_t faceIdx = 0; faceIdx < parsedMesh.getFaceNr(); faceIdx++ ) {
+					Face* faceParsed = parsedMesh.getFacePos( faceIdx );
+					Face* faceCached = cachedMesh.getFacePos( faceIdx );
+					differences += ( faceParsed->getVertC()->getIndex() != faceCached->getVertC()->getIndex() );
+					faceParsed->getNeighbourFacesAll( facesParsed );
+					faceCached->getNeighbourFacesAll( facesCached );
+					differences += ( facesParsed.size() != facesCached.size() );
+					for( uint64_t i = 0; i < std::min( facesParsed.size(), facesCached.size() ); i++ ) {
+						const int indexParsed = ( facesParsed[i] == nullptr ) ? -1 : facesParsed[i]->getIndex();
+						const int indexCached = ( facesCached[i] == nullptr ) ? -1 : facesCached[i]->getIndex();
+						differences += ( indexParsed != indexCached );
+					}
+				}
+				CHECK( differences == 0 );
+				double areaParsed = 0.0;
+				double areaCached = 0.0;
+				parsedMesh.getFaceSurfSum( &areaParsed );
+				cachedMesh.getFaceSurfSum( &areaCached );
+				CHECK( areaCached == Approx( areaParsed ) );
+			}
+		}
+
+		WHEN("The cache is written with indices not matching the positions")
+		{
+			const uint64_t vertexCount = parsedMesh.getVertexNr();
+			const uint64_t faceCount   = parsedMesh.getFaceNr();
+			for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+				parsedMesh.getVertexPos( vertIdx )->setIndex( vertexCount - 1 - vertIdx );
+			}
+			for( uint64_t faceIdx = 0; faceIdx < faceCount; faceIdx++ ) {
+				parsedMesh.getFacePos( faceIdx )->setIndex( faceCount - 1 - faceIdx );
+			}
+			REQUIRE( parsedMesh.writeMeshCache( cacheFile ) );
+			MockMesh cachedMesh( sourceFile.string(), success );
+			MeshCache::setMode( MeshCache::CACHE_OFF );
+			REQUIRE( success == true );
+
+			THEN("The indices are kept and the cache refers to the positions")
+			{
+				REQUIRE( cachedMesh.getFaceNr() == faceCount );
+				uint64_t differences = 0;
+				for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+					differences += ( parsedMesh.getVertexPos( vertIdx )->getIndex() != static_cast<int>( vertexCount - 1 - vertIdx ) );
+				}
+				std::vector<Face*> facesParsed;
+				std::vector<Face*> facesCached;
+				for( uint64_t faceIdx = 0; faceIdx < faceCount; faceIdx++ ) {
+					Face* faceParsed = parsedMesh.getFacePos( faceIdx );
+					Face* faceCached = cachedMesh.getFacePos( faceIdx );
+					differences += ( faceParsed->getIndex() != static_cast<int>( faceCount - 1 - faceIdx ) );
+					differences += ( vertexCount - 1 - faceParsed->getVertC()->getIndex() != static_cast<uint64_t>( faceCached->getVertC()->getIndex() ) );
+					faceParsed->getNeighbourFacesAll( facesParsed );
+					faceCached->getNeighbourFacesAll( facesCached );
+					differences += ( facesParsed.size() != facesCached.size() );
+					for( uint64_t i = 0; i < std::min( facesParsed.size(), facesCached.size() ); i++ ) {
+						const int64_t indexParsed = ( facesParsed[i] == nullptr ) ? -1 : static_cast<int64_t>( faceCount - 1 - facesParsed[i]->getIndex() );
+						const int64_t indexCached = ( facesCached[i] == nullptr ) ? -1 : facesCached[i]->getIndex();
+						differences += ( indexParsed != indexCached );
+					}
+				}
+				CHECK( differences == 0 );
+			}
+		}
+
+		WHEN("The source changes")
+		{
+			{
+				std::ofstream sourceAppend( sourceFile, std::ios::app );
+				sourceAppend << "\n";
+			}
+			MockMesh reparsedMesh( sourceFile.string(), success );
+			MeshCache::setMode( MeshCache::CACHE_OFF );
+			REQUIRE( success == true );
+
+			THEN("The outdated cache is replaced")
+			{
+				MeshCache meshCache;
+				CHECK( meshCache.open( cacheFile, sourceFile ) );
+				CHECK( meshCache.getVertexCount() == reparsedMesh.getVertexNr() );
+			}
+		}
+		MeshCache::setMode( MeshCache::CACHE_OFF );
+	}
+
+	std::filesystem::remove( sourceFile );
+	std::filesystem::remove( cacheFile );
+}
+
+SCENARIO("Converting borders to polylines in parallel", "[Mesh]")
+{
+	GIVEN("A sphere with holes of different size")
+	{
+		bool success = false;
+		MockMesh testMesh( "testdata/sphere_ascii.ply", success );
+		REQUIRE( success == true );
+
+		// Holes are cut without sharing vertices, which would result in singular vertices:
+		std::set<Vertex*> vertsUsed;
+		std::set<Face*>   facesToRemove;
+		std::vector<Face*> holeFaces;
+		for( uint64_t faceIdx = 0; faceIdx < testMesh.getFaceNr(); faceIdx += 37 ) {
+			holeFaces.clear();
+			if( faceIdx % 3 == 0 ) {
+				// Larger hole from the 1-ring of a vertex:
+				testMesh.getFacePos( faceIdx )->getVertA()->getFaces( &holeFaces );
+			} else {
+				holeFaces.push_back( testMesh.getFacePos( faceIdx ) );
+			}
+			bool isSeparate = true;
+			std::set<Vertex*> vertsHole;
+			for( Face* holeFace : holeFaces ) {
+				for( Vertex* holeVert : { holeFace->getVertA(), holeFace->getVertB(), holeFace->getVertC() } ) {
+					std::vector<Face*> facesOfVert;
+					holeVert->getFaces( &facesOfVert );
+					for( Face* faceOfVert : facesOfVert ) {
+						for( Vertex* neighVert : { faceOfVert->getVertA(), faceOfVert->getVertB(), faceOfVert->getVertC() } ) {
+							isSeparate &= ( vertsUsed.find( neighVert ) == vertsUsed.end() );
+							vertsHole.insert( neighVert );
+						}
+					}
+				}
+			}
+			if( isSeparate ) {
+				vertsUsed.insert( vertsHole.begin(), vertsHole.end() );
+				facesToRemove.insert( holeFaces.begin(), holeFaces.end() );
+			}
+		}
+		REQUIRE( testMesh.removeFaces( &facesToRemove ) );
+
+		WHEN("The borders are converted sequentially and in parallel")
+		{
+			auto fetchPolylines = [&testMesh]() {
+				std::vector<std::vector<int>> polylineVertices;
+				for( unsigned int polyIdx = 0; polyIdx < testMesh.getPolyLineNr(); polyIdx++ ) {
+					std::vector<int> vertIndices;
+					for( unsigned int elementIdx = 0; elementIdx < testMesh.getPolyLineLength( polyIdx ); elementIdx++ ) {
+						vertIndices.push_back( testMesh.getPolyLineVertIdx( polyIdx, elementIdx ) );
+					}
+					polylineVertices.push_back( vertIndices );
+				}
+				return( polylineVertices );
+			};
+			REQUIRE( testMesh.convertBordersToPolylines() );
+			const std::vector<std::vector<int>> polylinesSequential = fetchPolylines();
+			testMesh.removePolylinesAll();
+			REQUIRE( testMesh.convertBordersToPolylinesParallel() );
+			const std::vector<std::vector<int>> polylinesParallel = fetchPolylines();
+			// Small chunks split the loops into chains, which have to be stitched:
+			testMesh.removePolylinesAll();
+			REQUIRE( testMesh.convertBordersToPolylinesParallel( 7 ) );
+			const std::vector<std::vector<int>> polylinesStitched = fetchPolylines();
+
+			THEN("The same closed loops are found in the same order")
+			{
+				REQUIRE( polylinesSequential.size() > 5 );
+				CHECK( std::any_of( polylinesSequential.begin(), polylinesSequential.end(), []( const std::vector<int>& rLoop ) {
+					return( rLoop.size() > 4 );
+				} ) );
+				CHECK( polylinesParallel == polylinesSequential );
+				CHECK( polylinesStitched == polylinesSequential );
+				for( const std::vector<int>& polyline : polylinesParallel ) {
+					CHECK( polyline.front() == polyline.back() );
+				}
+				// At least one loop spans several chunks of 7 vertices:
+				CHECK( std::any_of( polylinesStitched.begin(), polylinesStitched.end(), []( const std::vector<int>& rLoop ) {
+					const auto [minIt, maxIt] = std::minmax_element( rLoop.begin(), rLoop.end() );
+					return( *minIt / 7 != *maxIt / 7 );
+				} ) );
+			}
+		}
+	}
+}
+
+SCENARIO("Unrolling vertices in batches", "[Mesh]")
+{
+	GIVEN("The vertices of a sphere")
+	{
+		bool success = false;
+		MockMesh testMesh( "testdata/sphere_ascii.ply", success );
+		REQUIRE( success == true );
+		const uint64_t vertexCount = testMesh.getVertexNr();
+		std::vector<double> posX( vertexCount );
+		std::vector<double> posY( vertexCount );
+		std::vector<double> posZ( vertexCount );
+		for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+			posX[vertIdx] = testMesh.getVertexPos( vertIdx )->getX();
+			posY[vertIdx] = testMesh.getVertexPos( vertIdx )->getY();
+			posZ[vertIdx] = testMesh.getVertexPos( vertIdx )->getZ();
+		}
+		const double heightMid = ( testMesh.getMinY() + testMesh.getMaxY() ) / 2.0;
+
+		auto compareToVertices = [&]( const UnrollBatch& rUnrollBatch, const std::function<bool(Vertex&)>& rUnrollVertex ) {
+			std::vector<double> batchX( posX );
+			std::vector<double> batchY( posY );
+			std::vector<double> batchZ( posZ );
+			std::vector<uint8_t> failed( vertexCount, 0xFF );
+			const uint64_t failedCount = rUnrollBatch.apply( batchX.data(), batchY.data(), batchZ.data(), failed.data(), vertexCount, 2 );
+			uint64_t differences = 0;
+			uint64_t failedVertices = 0;
+			for( uint64_t vertIdx = 0; vertIdx < vertexCount; vertIdx++ ) {
+				Vertex someVert( Vector3D( posX[vertIdx], posY[vertIdx], posZ[vertIdx], 1.0 ) );
+				const bool unrolled = rUnrollVertex( someVert );
+				failedVertices += !unrolled;
+				differences += ( failed[vertIdx] != !unrolled );
+				differences += ( someVert.getX() != batchX[vertIdx] );
+				differences += ( someVert.getY() != batchY[vertIdx] );
+				differences += ( someVert.getZ() != batchZ[vertIdx] );
+			}
+			CHECK( differences == 0 );
+			CHECK( failedCount == failedVertices );
+			return( failedCount );
+		};
+
+		WHEN("Unrolling around a truncated cone and a cylinder")
+		{
+			const double coneAngle = 0.2;
+			const uint64_t failedCone = compareToVertices( UnrollBatch::cone( testMesh.getMinY(), heightMid, coneAngle, 0.3 ), [&]( Vertex& rVert ) {
+				return( rVert.unrollAroundCone( testMesh.getMinY(), heightMid, coneAngle, 0.3 ) );
+			} );
+			const uint64_t failedDegenerated = compareToVertices( UnrollBatch::cone( heightMid, testMesh.getMaxY(), 0.0, -0.3 ), [&]( Vertex& rVert ) {
+				return( rVert.unrollAroundCone( heightMid, testMesh.getMaxY(), 0.0, -0.3 ) );
+			} );
+			const uint64_t failedCylinder = compareToVertices( UnrollBatch::cylinderRadius( 2.5, 0.1 ), []( Vertex& rVert ) {
+				return( rVert.unrollAroundCylinderRadius( 2.5, 0.1 ) );
+			} );
+			const uint64_t failedSphere = compareToVertices( UnrollBatch::sphere( 0.7, 3.0 ), []( Vertex& rVert ) {
+				return( rVert.unrollAroundSphere( 0.7, 3.0 ) );
+			} );
+
+			THEN("Only vertices beyond the cut heights fail")
+			{
+				CHECK( failedCone > 0 );
+				CHECK( failedCone < vertexCount );
+				CHECK( failedDegenerated > 0 );
+				CHECK( failedCylinder == 0 );
+				CHECK( failedSphere == 0 );
+			}
+		}
+
+		WHEN("Removing the flagged vertices")
+		{
+			std::vector<uint8_t> failed( vertexCount, 0 );
+			std::vector<double> batchX( posX );
+			std::vector<double> batchY( posY );
+			std::vector<double> batchZ( posZ );
+			const uint64_t failedCount = UnrollBatch::cone( testMesh.getMinY(), heightMid, 0.2, 0.0 ).apply( batchX.data(), batchY.data(), batchZ.data(), failed.data(), vertexCount );
+			Vertex* firstKept = testMesh.getVertexPos( std::find( failed.begin(), failed.end(), 0 ) - failed.begin() );
+			REQUIRE( testMesh.removeVerticesMasked( failed ) );
+
+			THEN("The remaining vertices keep their order")
+			{
+				REQUIRE( testMesh.getVertexNr() == vertexCount - failedCount );
+				CHECK( testMesh.getVertexPos( 0 ) == firstKept );
+				uint64_t verticesAboveCut = 0;
+				for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+					verticesAboveCut += ( testMesh.getVertexPos( vertIdx )->getY() > heightMid );
+				}
+				CHECK( verticesAboveCut == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO("Writing labeled components in one pass", "[Mesh]")
+{
+	const std::filesystem::path sourceFile( "testdata/tmpLabeledComponents.ply" );
+	std::filesystem::copy_file( "testdata/sphere_ascii.ply", sourceFile, std::filesystem::copy_options::overwrite_existing );
+
+	GIVEN("A sphere cut into two caps")
+	{
+		bool success = false;
+		MockMesh testMesh( sourceFile.string(), success );
+		REQUIRE( success == true );
+		const double heightMid = ( testMesh.getMinY() + testMesh.getMaxY() ) / 2.0;
+		const double bandWidth = ( testMesh.getMaxY() - testMesh.getMinY() ) / 10.0;
+		std::vector<uint8_t> inBand( testMesh.getVertexNr(), 0 );
+		for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+			inBand[vertIdx] = std::abs( testMesh.getVertexPos( vertIdx )->getY() - heightMid ) < bandWidth;
+		}
+		REQUIRE( testMesh.removeVerticesMasked( inBand ) );
+		REQUIRE( testMesh.labelVerticesAll() );
+
+		WHEN("The components are written with their information")
+		{
+			std::vector<Mesh::sLabeledComponent> components;
+			REQUIRE( testMesh.writeLabeledComponents( components, true ) );
+
+			THEN("Files and information match meshes built per label")
+			{
+				REQUIRE( components.size() >= 2 );
+				for( Mesh::sLabeledComponent& component : components ) {
+					CHECK( component.mWritten );
+					CHECK( std::filesystem::exists( component.mFileName ) );
+					std::set<Face*> facesWithLabel;
+					REQUIRE( testMesh.getFaceHasVertLabelNo( component.mLabelNr, facesWithLabel ) );
+					Mesh componentMesh( &facesWithLabel );
+					MeshInfoData componentInfo;
+					REQUIRE( componentMesh.getMeshInfoData( componentInfo, true ) );
+					CHECK( component.mVertexCount == componentMesh.getVertexNr() );
+					CHECK( component.mFaceCount == componentMesh.getFaceNr() );
+					for( int i = 0; i < MeshInfoData::ULONG_COUNT; i++ ) {
+						CHECK( component.mMeshInfo.mCountULong[i] == componentInfo.mCountULong[i] );
+					}
+					for( int i = 0; i < MeshInfoData::DOUBLE_COUNT; i++ ) {
+						CHECK( component.mMeshInfo.mCountDouble[i] == Approx( componentInfo.mCountDouble[i] ) );
+					}
+
+					bool readSuccess = false;
+					MockMesh writtenMesh( component.mFileName.string(), readSuccess );
+					REQUIRE( readSuccess == true );
+					CHECK( writtenMesh.getVertexNr() == component.mVertexCount );
+					CHECK( writtenMesh.getFaceNr() == component.mFaceCount );
+					std::filesystem::remove( component.mFileName );
+				}
+			}
+		}
+	}
+	std::filesystem::remove( sourceFile );
+}
+
+SCENARIO("Colouring function values with a lookup table", "[Mesh]")
+{
+	GIVEN("A colour ramp encoding the texel index and random function values")
+	{
+		const uint64_t rampWidth = 512;
+		std::vector<uint8_t> rampRGB( rampWidth * 3 );
+		for( uint64_t texelIdx = 0; texelIdx < rampWidth; texelIdx++ ) {
+			rampRGB[texelIdx*3]   = static_cast<uint8_t>( texelIdx & 0xFF );
+			rampRGB[texelIdx*3+1] = static_cast<uint8_t>( texelIdx >> 8 );
+			rampRGB[texelIdx*3+2] = 7;
+		}
+		auto texelOf = []( const uint8_t* rRGBA ) {
+			return( static_cast<int64_t>( rRGBA[0] ) + 256 * static_cast<int64_t>( rRGBA[1] ) );
+		};
+
+		// Formula of the shader and the former per vertex transformation:
+		auto referenceTexel = [&]( double rFuncVal, const ColorMapLut::sParams& rParams ) {
+			double texCoord = 0.0;
+			if( rParams.mRepeat ) {
+				double normalized = std::fabs( 2.0 * std::fmod( rFuncVal, rParams.mRepeatInterval ) ) / rParams.mRepeatInterval;
+				if( normalized > 1.0 ) {
+					normalized = 2.0 - normalized;
+				}
+				texCoord = 511.0/512.0 * normalized + 0.5/512.0;
+			} else {
+				double normalized = ( rFuncVal - rParams.mFuncValMin ) / ( rParams.mFuncValMax - rParams.mFuncValMin );
+				normalized = std::min( std::max( normalized, 0.0 ), 1.0 );
+				texCoord = 511.0/512.0 * std::pow( normalized, rParams.mGamma ) + 0.5/512.0;
+			}
+			if( rParams.mInvert ) {
+				texCoord = 1.0 - texCoord;
+			}
+			return( static_cast<int64_t>( std::floor( static_cast<double>( rampWidth ) * texCoord ) ) );
+		};
+
+		std::mt19937_64 random( 11 );
+		std::uniform_real_distribution<double> distribution( -3.0, 12.0 );
+		std::vector<double> funcValues( 100003 );
+		for( double& funcVal : funcValues ) {
+			funcVal = distribution( random );
+		}
+		funcValues[5]  = _NOT_A_NUMBER_DBL_;
+		funcValues[6]  = _INFINITE_DBL_;
+		funcValues[7]  = -_INFINITE_DBL_;
+		funcValues[8]  = 0.0;
+		funcValues[9]  = 10.0;
+
+		WHEN("The table is built and applied with and without SIMD")
+		{
+			THEN("Both kernels match the single lookup and the formula within one texel")
+			{
+				for( bool repeat : { false, true } ) {
+					for( bool invert : { false, true } ) {
+						ColorMapLut::sParams params;
+						params.mFuncValMin     = 0.0;
+						params.mFuncValMax     = 10.0;
+						params.mGamma          = repeat ? 1.0 : 0.7;
+						params.mInvert         = invert;
+						params.mRepeat         = repeat;
+						params.mRepeatInterval = 2.5;
+
+						ColorMapLut colorMap;
+						REQUIRE( colorMap.build( rampRGB.data(), rampWidth, params ) );
+						std::vector<uint8_t> colorsSIMD( funcValues.size() * 4 );
+						std::vector<uint8_t> colorsScalar( funcValues.size() * 4 );
+						REQUIRE( colorMap.apply( funcValues.data(), funcValues.size(), colorsSIMD.data(), 0, true ) );
+						REQUIRE( colorMap.apply( funcValues.data(), funcValues.size(), colorsScalar.data(), 1, false ) );
+						CHECK( colorsSIMD == colorsScalar );
+
+						uint64_t mismatchCount = 0;
+						uint64_t deviationCount = 0;
+						for( uint64_t valueIdx = 0; valueIdx < funcValues.size(); valueIdx++ ) {
+							uint8_t colorSingle[4];
+							colorMap.getColor( funcValues[valueIdx], colorSingle );
+							if( !std::equal( colorSingle, colorSingle + 4, colorsScalar.data() + valueIdx*4 ) ||
+							    ( colorSingle[2] != 7 ) || ( colorSingle[3] != 255 ) ) {
+								mismatchCount++;
+							}
+							if( !std::isfinite( funcValues[valueIdx] ) ) {
+								continue;
+							}
+							const int64_t texelDiff = texelOf( colorSingle ) - referenceTexel( funcValues[valueIdx], params );
+							if( std::abs( texelDiff ) > 1 ) {
+								deviationCount++;
+							}
+						}
+						CHECK( mismatchCount == 0 );
+						CHECK( deviationCount == 0 );
+						if( !repeat ) {
+							CHECK( texelOf( &colorsScalar[8*4] ) == referenceTexel( 0.0, params ) );
+							CHECK( texelOf( &colorsScalar[9*4] ) == referenceTexel( 10.0, params ) );
+							CHECK( texelOf( &colorsScalar[7*4] ) == texelOf( &colorsScalar[8*4] ) );
+							CHECK( texelOf( &colorsScalar[6*4] ) == texelOf( &colorsScalar[9*4] ) );
+						}
+						CHECK( texelOf( &colorsScalar[5*4] ) == texelOf( &colorsScalar[8*4] ) );
+					}
+				}
+			}
+		}
+
+		WHEN("The table is built with a gamma far below one")
+		{
+			THEN("Values at the low end of the range match the formula within one texel")
+			{
+				for( double gamma : { 0.1, 0.01 } ) {
+					ColorMapLut::sParams params;
+					params.mFuncValMin = 0.0;
+					params.mFuncValMax = 1.0;
+					params.mGamma      = gamma;
+
+					ColorMapLut colorMap;
+					REQUIRE( colorMap.build( rampRGB.data(), rampWidth, params ) );
+					std::vector<double> lowValues;
+					for( double exponent = -12.0; exponent <= 0.0; exponent += 0.25 ) {
+						lowValues.push_back( std::pow( 10.0, exponent ) );
+					}
+					std::vector<uint8_t> colorsSIMD( lowValues.size() * 4 );
+					std::vector<uint8_t> colorsScalar( lowValues.size() * 4 );
+					REQUIRE( colorMap.apply( lowValues.data(), lowValues.size(), colorsSIMD.data(), 0, true ) );
+					REQUIRE( colorMap.apply( lowValues.data(), lowValues.size(), colorsScalar.data(), 1, false ) );
+					CHECK( colorsSIMD == colorsScalar );
+
+					uint64_t deviationCount = 0;
+					for( uint64_t valueIdx = 0; valueIdx < lowValues.size(); valueIdx++ ) {
+						const int64_t texelDiff = texelOf( &colorsScalar[valueIdx*4] ) - referenceTexel( lowValues[valueIdx], params );
+						if( std::abs( texelDiff ) > 1 ) {
+							deviationCount++;
+						}
+					}
+					CHECK( deviationCount == 0 );
+				}
+
+				ColorMapLut::sParams params;
+				params.mGamma = 0.1;
+				ColorMapLut colorMap;
+				REQUIRE( colorMap.build( rampRGB.data(), rampWidth, params ) );
+				uint8_t colorLow[4];
+				colorMap.getColor( 1e-4, colorLow );
+				CHECK( referenceTexel( 1e-4, params ) == 203 );
+				CHECK( std::abs( texelOf( colorLow ) - 203 ) <= 1 );
+			}
+		}
+
+		WHEN("The vertex colours of a mesh are set")
+		{
+			bool success = false;
+			MockMesh testMesh("testdata/sphere_ascii.ply", success);
+			REQUIRE(success == true);
+			for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+				testMesh.getVertexPos( vertIdx )->setFuncValue( funcValues[vertIdx] );
+			}
+			ColorMapLut::sParams params;
+			params.mFuncValMax = 10.0;
+			ColorMapLut colorMap;
+			REQUIRE( colorMap.build( rampRGB.data(), rampWidth, params ) );
+			REQUIRE( testMesh.setVertRGBFromFuncVal( colorMap ) );
+
+			THEN("They equal the colours of the function values")
+			{
+				uint64_t mismatchCount = 0;
+				for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+					uint8_t colorExpected[4];
+					colorMap.getColor( funcValues[vertIdx], colorExpected );
+					unsigned char colorVertex[3];
+					if( !testMesh.getVertexPos( vertIdx )->copyRGBTo( colorVertex ) ||
+					    !std::equal( colorVertex, colorVertex + 3, colorExpected ) ) {
+						mismatchCount++;
+					}
+				}
+				CHECK( mismatchCount == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO("Ambient occlusion without OpenGL", "[Mesh]")
+{
+	GIVEN("A sphere mesh")
+	{
+		bool success = false;
+		MockMesh testMesh("testdata/sphere_ascii.ply", success);
+		REQUIRE(success == true);
+		AmbientOcclusion occlusion( &testMesh );
+		AmbientOcclusion::sParams params;
+		params.mResolution   = 256;
+		params.mSubdivisions = 2;
+		const double directionCount = static_cast<double>( AmbientOcclusion::getDirections( params.mSubdivisions ).size() );
+
+		WHEN("Computing the ambient occlusion with different numbers of threads and tile sizes")
+		{
+			std::vector<double> valuesSingle;
+			params.mThreadCount = 1;
+			params.mTileSize    = 64;
+			REQUIRE( occlusion.compute( params, valuesSingle ) );
+			std::vector<double> valuesMulti;
+			params.mThreadCount = 4;
+			params.mTileSize    = 16;
+			REQUIRE( occlusion.compute( params, valuesMulti ) );
+
+			THEN("The values are identical and no vertex of the convex mesh is occluded")
+			{
+				CHECK( directionCount == 162.0 );
+				CHECK( valuesSingle == valuesMulti );
+				REQUIRE( valuesSingle.size() == testMesh.getVertexNr() );
+				const auto [minIt, maxIt] = std::minmax_element( valuesSingle.begin(), valuesSingle.end() );
+				CHECK( *minIt > directionCount / 4.0 * 0.9 );
+				CHECK( *maxIt < directionCount / 4.0 * 1.1 );
+			}
+		}
+	}
+
+	GIVEN("A floor partially covered by a roof")
+	{
+		const std::filesystem::path fileName( "testdata/tmpAmbientOcclusion.ply" );
+		{
+			std::ofstream filePLY( fileName );
+			filePLY << "ply\nformat ascii 1.0\nelement vertex " << 11*11+4 << "\nproperty float x\nproperty float y\nproperty float z\n"
+			        << "element face " << 10*10*2+2 << "\nproperty list uchar int vertex_indices\nend_header\n";
+			for( int row = 0; row <= 10; row++ ) {
+				for( int col = 0; col <= 10; col++ ) {
+					filePLY << col - 5 << " " << row - 5 << " 0\n";
+				}
+			}
+			filePLY << "-2 -2 1\n2 -2 1\n2 2 1\n-2 2 1\n";
+			for( int row = 0; row < 10; row++ ) {
+				for( int col = 0; col < 10; col++ ) {
+					const int vertIdx = row * 11 + col;
+					filePLY << "3 " << vertIdx << " " << vertIdx + 1 << " " << vertIdx + 12 << "\n";
+					filePLY << "3 " << vertIdx << " " << vertIdx + 12 << " " << vertIdx + 11 << "\n";
+				}
+			}
+			filePLY << "3 121 122 123\n3 121 123 124\n";
+		}
+		bool success = false;
+		MockMesh testMesh( fileName.string(), success );
+		REQUIRE(success == true);
+
+		WHEN("Computing the ambient occlusion")
+		{
+			AmbientOcclusion occlusion( &testMesh );
+			AmbientOcclusion::sParams params;
+			params.mResolution   = 256;
+			params.mSubdivisions = 3;
+			std::vector<double> values;
+			REQUIRE( occlusion.compute( params, values ) );
+
+			THEN("The floor below the roof is darker than the uncovered corner")
+			{
+				const double directionCount = static_cast<double>( AmbientOcclusion::getDirections( params.mSubdivisions ).size() );
+				const double valueCenter = values[5*11+5];
+				const double valueCorner = values[0];
+				CHECK( valueCorner > directionCount / 4.0 * 0.8 );
+				CHECK( valueCenter < valueCorner * 0.5 );
+				CHECK( values[121] > directionCount / 4.0 * 0.8 ); // Roof
+			}
+		}
+		std::filesystem::remove( fileName );
+	}
+}
+
+SCENARIO("Deterministic parallel face reductions", "[Mesh]")
+{
+	GIVEN("Values of different magnitudes for more faces than one chunk")
+	{
+		const uint64_t faceCount = FaceReduction::CHUNK_SIZE * 5 + 123;
+		std::vector<double> values( faceCount );
+		std::mt19937 generator( 42 );
+		std::uniform_real_distribution<double> exponent( -8.0, 8.0 );
+		for( double& value : values ) {
+			value = std::pow( 10.0, exponent( generator ) );
+		}
+		auto faceFunc = [&values]( uint64_t rFaceIdx, double* rValues ) {
+			if( rFaceIdx % 1000 == 0 ) {
+				return( FaceReduction::FACE_DEGENERATE );
+			}
+			rValues[0] = values[rFaceIdx];
+			rValues[1] = -values[rFaceIdx];
+			return( FaceReduction::FACE_VALID );
+		};
+
+		WHEN("Summing with one and with several threads")
+		{
+			const FaceReduction::sResult resultSingle = FaceReduction::reduce( faceCount, 2, faceFunc, 1 );
+			const FaceReduction::sResult resultMulti  = FaceReduction::reduce( faceCount, 2, faceFunc, 3 );
+
+			THEN("The sums are identical and the degenerate faces are counted")
+			{
+				REQUIRE( resultSingle.mSums.size() == 2 );
+				CHECK( resultSingle.mSums == resultMulti.mSums );
+				CHECK( resultSingle.mSums[0] == -resultSingle.mSums[1] );
+				const uint64_t degenerateCount = ( faceCount + 999 ) / 1000;
+				CHECK( resultSingle.mFacesDegenerate == degenerateCount );
+				CHECK( resultSingle.mFacesValid == faceCount - degenerateCount );
+				CHECK( resultMulti.mFacesDegenerate == degenerateCount );
+			}
+		}
+
+		WHEN("Summing into bins with one and with several threads")
+		{
+			auto binFunc = [&values]( uint64_t rFaceIdx, uint64_t* rBins, unsigned int& rBinNr, double& rValue ) {
+				rBins[rBinNr++] = rFaceIdx % 7;
+				rBins[rBinNr++] = 7 + rFaceIdx % 3;
+				rValue = values[rFaceIdx];
+				return( FaceReduction::FACE_VALID );
+			};
+			const FaceReduction::sResult resultSingle = FaceReduction::reduceBinned( faceCount, 10, binFunc, 1 );
+			const FaceReduction::sResult resultMulti  = FaceReduction::reduceBinned( faceCount, 10, binFunc, 3 );
+
+			THEN("The sums of the bins are identical and match the plain sums")
+			{
+				REQUIRE( resultSingle.mSums.size() == 10 );
+				CHECK( resultSingle.mSums == resultMulti.mSums );
+				std::vector<double> binSums( 10, 0.0 );
+				for( uint64_t faceIdx = 0; faceIdx < faceCount; faceIdx++ ) {
+					binSums[faceIdx % 7] += values[faceIdx];
+					binSums[7 + faceIdx % 3] += values[faceIdx];
+				}
+				for( int binIdx = 0; binIdx < 10; binIdx++ ) {
+					CHECK( resultSingle.mSums[binIdx] == Approx( binSums[binIdx] ) );
+				}
+			}
+		}
+	}
+
+	GIVEN("Values cancelling each other")
+	{
+		CompensatedSum sum;
+		sum.add( 1.0e16 );
+		sum.add( 1.0 );
+		sum.add( -1.0e16 );
+		THEN("The compensated sum keeps the small value")
+		{
+			CHECK( sum.getSum() == 1.0 );
+		}
+	}
+
+	GIVEN("A tetrahedron with an additional zero area face")
+	{
+		const std::filesystem::path fileName( "testdata/tmpFaceReduction.ply" );
+		{
+			std::ofstream filePLY( fileName );
+			filePLY << "ply\nformat ascii 1.0\nelement vertex 5\nproperty float x\nproperty float y\nproperty float z\n"
+			        << "element face 5\nproperty list uchar int vertex_indices\nend_header\n"
+			        << "0 0 0\n6 0 0\n0 6 0\n0 0 6\n3 0 0\n"
+			        << "3 0 2 1\n3 0 1 3\n3 0 3 2\n3 1 2 3\n3 0 4 1\n";
+		}
+		bool success = false;
+		MockMesh testMesh( fileName.string(), success );
+		REQUIRE( success == true );
+
+		WHEN("Computing volume and area")
+		{
+			double volumeDXYZ[3];
+			uint64_t facesDegenerate = 0;
+			const bool volumeValid = testMesh.getMeshVolumeDivergence( volumeDXYZ[0], volumeDXYZ[1], volumeDXYZ[2], &facesDegenerate );
+			double area = 0.0;
+			REQUIRE( testMesh.getFaceSurfSum( &area ) );
+
+			THEN("The zero area face is counted and skipped")
+			{
+				CHECK( volumeValid == false );
+				CHECK( facesDegenerate == 1 );
+				CHECK( volumeDXYZ[0] == Approx( 36.0 ) );
+				CHECK( volumeDXYZ[1] == Approx( 36.0 ) );
+				CHECK( volumeDXYZ[2] == Approx( 36.0 ) );
+				CHECK( area == Approx( 3.0 * 18.0 + std::sqrt( 3.0 ) / 4.0 * 72.0 ) );
+			}
+		}
+		std::filesystem::remove( fileName );
+	}
+
+	GIVEN("A sphere cut into two labeled caps")
+	{
+		bool success = false;
+		MockMesh testMesh( "testdata/sphere_ascii.ply", success );
+		REQUIRE( success == true );
+		const double heightMid = ( testMesh.getMinY() + testMesh.getMaxY() ) / 2.0;
+		const double bandWidth = ( testMesh.getMaxY() - testMesh.getMinY() ) / 10.0;
+		std::vector<uint8_t> inBand( testMesh.getVertexNr(), 0 );
+		for( uint64_t vertIdx = 0; vertIdx < testMesh.getVertexNr(); vertIdx++ ) {
+			inBand[vertIdx] = std::abs( testMesh.getVertexPos( vertIdx )->getY() - heightMid ) < bandWidth;
+		}
+		REQUIRE( testMesh.removeVerticesMasked( inBand ) );
+		REQUIRE( testMesh.labelVerticesAll() );
+
+		WHEN("Summing the area per label")
+		{
+			std::vector<double> labelAreas;
+			REQUIRE( testMesh.labelFacesVertArea( labelAreas ) );
+			double area = 0.0;
+			REQUIRE( testMesh.getFaceSurfSum( &area ) );
+			double areaNormals = 0.0;
+			REQUIRE( testMesh.resetFaceNormals( &areaNormals ) );
+
+			THEN("The areas of the labels match the faces of each label and add up to the total area")
+			{
+				REQUIRE( labelAreas.size() >= 2 );
+				double labelAreaSum = 0.0;
+				for( uint64_t labelIdx = 0; labelIdx < labelAreas.size(); labelIdx++ ) {
+					std::set<Face*> facesWithLabel;
+					REQUIRE( testMesh.getFaceHasVertLabelNo( labelIdx + 1, facesWithLabel ) );
+					double labelArea = 0.0;
+					for( Face* face : facesWithLabel ) {
+						labelArea += face->getAreaNormal();
+					}
+					CHECK( labelAreas[labelIdx] == Approx( labelArea ) );
+					labelAreaSum += labelAreas[labelIdx];
+				}
+				CHECK( labelAreaSum == Approx( area ) );
+				CHECK( areaNormals == area );
+			}
+		}
+	}
+}